@@ -240,6 +240,9 @@ static int mdio_write(device_t *dev, uint16_t phy_addr, uint16_t reg_addr, uint1
     return -1;
 }
 
+/* Statistics block and RQDPC 0..3, clear on read (REQ-F-STATISTICS-004) */
+static const intel_hw_stats_map_t e82576_hw_stats = INTEL_HW_STATS_MAP_IGB_INIT;
+
 /**
  * @brief 82576 device operations structure - CORRECTED: No PTP support
  * 82576 (2009) still predates solid IEEE 1588 implementation in Intel hardware
@@ -252,6 +255,7 @@ const intel_device_ops_t e82576_ops = {
     .init = init,
     .cleanup = cleanup,
     .get_info = get_info,
+    .hw_stats = &e82576_hw_stats,
     
     // PTP operations - NOT RELIABLY SUPPORTED on 82576
     .set_systime = NULL,          // Unreliable PTP hardware
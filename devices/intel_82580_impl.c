@@ -242,6 +242,9 @@ static int set_systime(device_t *dev, uint64_t systime)
     return 0;
 }
 
+/* 82580 SYSTIM is flat with a fixed left shift (IGB_82580_TSYNC_SHIFT). */
+static const intel_systim_conv_t e82580_systim_conv = INTEL_SYSTIM_CONV_FLAT_INIT(IGB_82580_TSYNC_SHIFT);
+
 /**
  * @brief Get 82580 system time using SYSTIM registers with shift adjustment
  * @param dev Device handle
@@ -266,10 +269,8 @@ static int get_systime(device_t *dev, uint64_t *systime)
     result = ndis_platform_ops.mmio_read(dev, E1000_SYSTIMH, &ts_high);
     if (result != 0) return result;
     
-    *systime = ((uint64_t)ts_high << 32) | ts_low;
-    
-    // 82580 requires timestamp shift adjustment
-    *systime = *systime << IGB_82580_TSYNC_SHIFT;
+    // 82580 requires timestamp shift adjustment (folded into the FLAT decode)
+    *systime = intel_systim_decode(&e82580_systim_conv, ts_high, ts_low);
     
     DEBUGP(DL_TRACE, "<==82580_get_systime: 0x%llx\n", *systime);
     return 0;
@@ -458,6 +459,9 @@ static int enable_packet_timestamping(device_t *dev, int enable)
     return 0;
 }
 
+/* Statistics block and RQDPC 0..3, clear on read (REQ-F-STATISTICS-004) */
+static const intel_hw_stats_map_t e82580_hw_stats = INTEL_HW_STATS_MAP_IGB_INIT;
+
 /**
  * @brief 82580 device operations structure using clean generic function names
  */
@@ -469,10 +473,12 @@ const intel_device_ops_t e82580_ops = {
     .init = init,
     .cleanup = cleanup,
     .get_info = get_info,
+    .hw_stats = &e82580_hw_stats,
     
     // PTP operations - enhanced PTP support with better precision
     .set_systime = set_systime,
     .get_systime = get_systime,
+    .systim_conv = &e82580_systim_conv,
     .init_ptp = init_ptp,
     .enable_packet_timestamping = enable_packet_timestamping,
     
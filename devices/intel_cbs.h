@@ -0,0 +1,206 @@
+/*++
+
+Module Name:
+
+    intel_cbs.h
+
+Abstract:
+
+    Credit-based shaper (IEEE 802.1Q §8.6.8.2, formerly 802.1Qav) register
+    encoding shared by the I210 and I225/I226 implementations, plus the
+    802.1Q Annex L credit bounds used to derive hiCredit / loCredit.
+
+    Both families shape the two SR queues (0 and 1) only:
+
+      TQAVCCn   0x03004 + 0x40n  IdleSlope [15:0] (+ I210 QueueMode bit 31,
+                                 I225 KeepCredits bit 30)
+      TQAVHCn   0x0300C + 0x40n  0x80000000 + hiCredit(bytes) * credit scale
+      TQAVCTRL  0x03570          I210: TransmitMode / DataTranARB
+                                 (I225/I226 TSN-mode bits and TXQCTL QAV_SEL
+                                 live with the other Qbv registers in
+                                 intel_i226_impl.c)
+
+    IdleSlope units (I210 datasheet §7.2.7.5, I225 datasheet §7.5.2.7; same
+    derivation as the Linux igb/igc drivers):
+
+      I210   61034 units per 1 Gb/s   (one unit ~ 16.384 kb/s)
+      I225   61036 units per 2.5 Gb/s (one unit ~ 40.959 kb/s)
+
+    The register value is independent of the link speed.  A requested rate is
+    rounded UP to the next unit so the shaper never reserves less than asked
+    (Annex L: idleSlope >= reserved bandwidth); the effective rate is reported
+    back rounded down to whole bytes/s, which is still >= the request.
+
+    Pure C99 (stdint only) so tests/unit/hal/test_cbs_units.c can check the
+    encoding without hardware.
+
+    Implements: REQ-F-QAV-001 (Credit-Based Shaper Configuration)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#define INTEL_CBS_QUEUE_COUNT             2u     /* SR queues 0/1 (Class A/B) */
+
+/* Register offsets (I210 / I225 / I226) */
+#define INTEL_CBS_REG_STATUS              0x00008u
+#define INTEL_CBS_REG_TQAVCC(q)           (0x03004u + 0x40u * (q))
+#define INTEL_CBS_REG_TQAVHC(q)           (0x0300Cu + 0x40u * (q))
+#define INTEL_CBS_REG_TQAVCTRL            0x03570u
+
+/* TQAVCC */
+#define INTEL_CBS_TQAVCC_IDLESLOPE_MASK   0x0000FFFFu
+#define INTEL_CBS_TQAVCC_I225_KEEP_CREDITS 0x40000000u
+#define INTEL_CBS_TQAVCC_I210_QUEUE_MODE_SR 0x80000000u  /* queue is stream reservation */
+
+/* TQAVHC */
+#define INTEL_CBS_TQAVHC_BASE             0x80000000u
+
+/* I210 TQAVCTRL */
+#define INTEL_CBS_I210_TQAVCTRL_XMIT_MODE   0x00000001u  /* Qav transmit mode */
+#define INTEL_CBS_I210_TQAVCTRL_DATATRANARB 0x00000100u  /* credit-based arbitration */
+
+/* STATUS: link state and speed */
+#define INTEL_CBS_STATUS_LU               0x00000002u
+#define INTEL_CBS_STATUS_SPEED_SHIFT      6u
+#define INTEL_CBS_STATUS_SPEED_MASK       0x000000C0u
+#define INTEL_CBS_STATUS_I225_SPEED_2500  0x00400000u
+
+typedef enum _intel_cbs_family {
+    INTEL_CBS_FAMILY_I210 = 0,
+    INTEL_CBS_FAMILY_I225 = 1      /* I225 and I226 */
+} intel_cbs_family_t;
+
+#define INTEL_CBS_I210_SLOPE_UNITS        61034ull
+#define INTEL_CBS_I210_SLOPE_RATE_BPS     1000000000ull
+#define INTEL_CBS_I210_CREDIT_SCALE       0x7735u
+#define INTEL_CBS_I225_SLOPE_UNITS        61036ull
+#define INTEL_CBS_I225_SLOPE_RATE_BPS     2500000000ull
+#define INTEL_CBS_I225_CREDIT_SCALE       0x7736u
+
+/**
+ * @brief Shaper request / result for intel_device_ops_t::setup_qav
+ *
+ * idle_slope_Bps == 0 disables shaping on the queue.
+ */
+struct intel_cbs_config {
+    uint32_t idle_slope_Bps;    /* in: requested bytes/s  out: effective bytes/s    */
+    uint32_t hi_credit_bytes;   /* in/out: hiCredit programmed                       */
+    uint32_t port_rate_Bps;     /* out: link rate in bytes/s, 0 when link is down    */
+    uint32_t idle_slope_reg;    /* out: TQAVCC.IdleSlope value written               */
+};
+
+static __inline uint64_t intel_cbs_slope_units(intel_cbs_family_t family)
+{
+    return (family == INTEL_CBS_FAMILY_I210) ? INTEL_CBS_I210_SLOPE_UNITS : INTEL_CBS_I225_SLOPE_UNITS;
+}
+
+static __inline uint64_t intel_cbs_slope_rate_bps(intel_cbs_family_t family)
+{
+    return (family == INTEL_CBS_FAMILY_I210) ? INTEL_CBS_I210_SLOPE_RATE_BPS : INTEL_CBS_I225_SLOPE_RATE_BPS;
+}
+
+/**
+ * @brief TQAVCC.IdleSlope for a rate in bytes/s (rounded up, 0 stays 0)
+ * @return register value, or 0x10000 or more if the rate does not fit
+ */
+static __inline uint32_t intel_cbs_idle_slope_reg(intel_cbs_family_t family, uint32_t idle_slope_Bps)
+{
+    uint64_t rate = intel_cbs_slope_rate_bps(family);
+    uint64_t reg  = ((uint64_t)idle_slope_Bps * 8u * intel_cbs_slope_units(family) + rate - 1u) / rate;
+
+    return (reg > 0xFFFFFFFFull) ? 0xFFFFFFFFu : (uint32_t)reg;
+}
+
+/**
+ * @brief Effective rate in bytes/s of a TQAVCC.IdleSlope value (rounded down)
+ */
+static __inline uint32_t intel_cbs_idle_slope_Bps(intel_cbs_family_t family, uint32_t reg)
+{
+    return (uint32_t)(((uint64_t)reg * intel_cbs_slope_rate_bps(family)) /
+                      (intel_cbs_slope_units(family) * 8u));
+}
+
+/**
+ * @brief TQAVHC value for hiCredit in bytes
+ * @return 0 on success, -1 if hi_credit_bytes does not fit the register
+ */
+static __inline int intel_cbs_hicredit_reg(intel_cbs_family_t family, uint32_t hi_credit_bytes, uint32_t *reg)
+{
+    uint64_t scale = (family == INTEL_CBS_FAMILY_I210) ? INTEL_CBS_I210_CREDIT_SCALE : INTEL_CBS_I225_CREDIT_SCALE;
+    uint64_t v = (uint64_t)hi_credit_bytes * scale;
+
+    if (v > 0x7FFFFFFFull) {
+        return -1;
+    }
+    *reg = INTEL_CBS_TQAVHC_BASE + (uint32_t)v;
+    return 0;
+}
+
+/**
+ * @brief Link speed in Mb/s from the STATUS register, 0 when link is down
+ */
+static __inline uint32_t intel_cbs_link_mbps(intel_cbs_family_t family, uint32_t status)
+{
+    if (!(status & INTEL_CBS_STATUS_LU)) {
+        return 0;
+    }
+    if (family == INTEL_CBS_FAMILY_I225 && (status & INTEL_CBS_STATUS_I225_SPEED_2500)) {
+        return 2500;
+    }
+    switch ((status & INTEL_CBS_STATUS_SPEED_MASK) >> INTEL_CBS_STATUS_SPEED_SHIFT) {
+    case 0:  return 10;
+    case 1:  return 100;
+    default: return 1000;
+    }
+}
+
+/*
+ * IEEE 802.1Q-2018 Annex L credit bounds.  Rates in bits/s, sizes in bytes;
+ * results rounded away from zero so the programmed bound is never tighter
+ * than the standard's.
+ *
+ *   Class A:  hiCredit = maxInterferenceSize * idleSlope_A / portTransmitRate
+ *   Class B:  hiCredit = idleSlope_B * (maxInterferenceSize + maxFrameSize_A)
+ *                        / (portTransmitRate - idleSlope_A)
+ *   any:      loCredit = maxFrameSize * sendSlope / portTransmitRate
+ *                      = -maxFrameSize * (portTransmitRate - idleSlope) / portTransmitRate
+ *
+ * maxInterferenceSize is the largest frame of a lower-priority (non-SR)
+ * class, i.e. the frame that may have just started when the SR frame
+ * becomes eligible.
+ */
+static __inline uint32_t intel_cbs_annexl_hicredit_a(uint32_t max_interference_bytes,
+                                                     uint64_t idle_slope_a_bps, uint64_t port_rate_bps)
+{
+    if (port_rate_bps == 0) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)max_interference_bytes * idle_slope_a_bps + port_rate_bps - 1u) / port_rate_bps);
+}
+
+static __inline uint32_t intel_cbs_annexl_hicredit_b(uint32_t max_interference_bytes, uint32_t max_frame_a_bytes,
+                                                     uint64_t idle_slope_a_bps, uint64_t idle_slope_b_bps,
+                                                     uint64_t port_rate_bps)
+{
+    uint64_t den;
+
+    if (port_rate_bps <= idle_slope_a_bps) {
+        return 0;
+    }
+    den = port_rate_bps - idle_slope_a_bps;
+    return (uint32_t)((((uint64_t)max_interference_bytes + max_frame_a_bytes) * idle_slope_b_bps + den - 1u) / den);
+}
+
+/** loCredit as a positive magnitude (the bound itself is -result) */
+static __inline uint32_t intel_cbs_annexl_locredit(uint32_t max_frame_bytes, uint64_t idle_slope_bps,
+                                                   uint64_t port_rate_bps)
+{
+    if (port_rate_bps == 0 || idle_slope_bps >= port_rate_bps) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)max_frame_bytes * (port_rate_bps - idle_slope_bps) + port_rate_bps - 1u) /
+                      port_rate_bps);
+}
@@ -15,6 +15,11 @@ Abstract:
 
 #include "precomp.h"
 #include "external/intel_avb/lib/intel_private.h"
+#include "intel_systim_decode.h"
+#include "intel_sdp_perout.h"
+#include "intel_cbs.h"
+#include "intel_fp_stats.h"
+#include "intel_hw_stats.h"
 
 // Forward declarations
 typedef struct _device_t device_t;
@@ -46,6 +51,7 @@ typedef struct _intel_device_ops {
     // PTP/IEEE 1588 operations
     int (*set_systime)(device_t *dev, uint64_t systime);
     int (*get_systime)(device_t *dev, uint64_t *systime);
+    const intel_systim_conv_t *systim_conv;  // Raw SYSTIMH/L → ns decode (optional - can be NULL)
     int (*init_ptp)(device_t *dev);
     int (*enable_packet_timestamping)(device_t *dev, int enable);  // Enable TSYNCRXCTL/TSYNCTXCTL
     
@@ -68,11 +74,33 @@ typedef struct _intel_device_ops {
     int (*get_aux_timestamp)(device_t *dev, uint8_t aux_index, uint64_t *aux_timestamp_ns);
     int (*clear_aux_timestamp_flag)(device_t *dev, uint8_t aux_index);  // Clear AUTT flag for aux timestamp
     
+    // Periodic SDP output (REQ-F-PTP-PEROUT-001) - optional, NULL when the device has no SDP time-sync block
+    // freqout=1: FREQOUT<channel> clock started at start_ns; freqout=0: single TRGTTIM<channel> compare at start_ns
+    // measure_pin: second SDP routed into AUXSTMP<channel> for edge capture, INTEL_SDP_PIN_NONE to skip
+    int (*perout_configure)(device_t *dev, uint8_t channel, uint8_t sdp_pin, uint8_t measure_pin,
+                            int freqout, uint64_t start_ns, uint32_t half_cycle_ns);
+    int (*perout_disable)(device_t *dev, uint8_t channel, uint8_t sdp_pin, uint8_t measure_pin);
+    int (*perout_arm_edge)(device_t *dev, uint8_t channel, uint64_t edge_ns);    // Re-arm TRGTTIM<channel> and EN_TT<channel>
+    int (*perout_read_aux)(device_t *dev, uint8_t channel, uint64_t *aux_ns);    // AUXSTMP<channel> (split decode), also AUX streaming
+    
+    // AUX input capture (REQ-F-PTP-AUXSTREAM-001) - route SDP input into AUXSTMP<channel> and set/clear EN_TS<channel>
+    int (*aux_capture_configure)(device_t *dev, uint8_t channel, uint8_t sdp_pin, int enable);
+    
     // TSN operations (optional - can be NULL for basic devices)
     int (*setup_tas)(device_t *dev, struct tsn_tas_config *config);
+    int (*apply_tas_switch)(device_t *dev);     // Stop the running list, arm the one setup_tas staged (REQ-F-TAS-003)
     int (*setup_frame_preemption)(device_t *dev, struct tsn_fp_config *config);
+    int (*read_fp_stats)(device_t *dev, struct intel_fp_sample *sample);  // MAC merge counters, clear on read (devices/intel_fp_stats.h)
     int (*setup_ptm)(device_t *dev, struct ptm_config *config);
     
+    // Credit-based shaper (REQ-F-QAV-001) - SR queue 0/1; cfg->idle_slope_Bps == 0 disables
+    // Returns the effective rate / register value in cfg (see devices/intel_cbs.h)
+    int (*setup_qav)(device_t *dev, uint8_t queue, struct intel_cbs_config *cfg);
+    
+    // NIC statistics registers (REQ-F-STATISTICS-004) - counters this MAC has (devices/intel_hw_stats.h),
+    // NULL when not described; read and cleared only by the driver's sampler
+    const intel_hw_stats_map_t *hw_stats;
+    
     // Device-specific register access (optional overrides)
     int (*read_register)(device_t *dev, uint32_t offset, uint32_t *value);
     int (*write_register)(device_t *dev, uint32_t offset, uint32_t value);
@@ -109,4 +137,13 @@ extern const intel_device_ops_t i219_ops;
 extern const intel_device_ops_t i225_ops;
 extern const intel_device_ops_t i226_ops;
 extern const intel_device_ops_t i350_ops;
-extern const intel_device_ops_t e810_ops;
\ No newline at end of file
+extern const intel_device_ops_t e810_ops;
+
+// Shared SDP periodic output / AUX capture for the I210 and I225/I226 time-sync block
+// (intel_sdp_perout.c) - the perout_* and aux_capture_configure ops of both families
+int intel_sdp_perout_configure(device_t *dev, uint8_t channel, uint8_t sdp_pin, uint8_t measure_pin,
+                               int freqout, uint64_t start_ns, uint32_t half_cycle_ns);
+int intel_sdp_perout_disable(device_t *dev, uint8_t channel, uint8_t sdp_pin, uint8_t measure_pin);
+int intel_sdp_perout_arm_edge(device_t *dev, uint8_t channel, uint64_t edge_ns);
+int intel_sdp_perout_read_aux(device_t *dev, uint8_t channel, uint64_t *aux_ns);
+int intel_sdp_aux_capture_configure(device_t *dev, uint8_t channel, uint8_t sdp_pin, int enable);
\ No newline at end of file
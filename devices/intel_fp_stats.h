@@ -0,0 +1,176 @@
+/*++
+
+Module Name:
+
+    intel_fp_stats.h
+
+Abstract:
+
+    IEEE 802.3br MAC merge statistics of the I225/I226 (frame preemption set
+    up by IOCTL_AVB_SETUP_FP), and the accumulator that turns the hardware
+    counters into 64-bit totals and per-interval deltas.
+
+    Counters (statistics block, clear on read; same registers the Linux igc
+    driver reports through ethtool --show-mm):
+
+      PRMPTDTCNT  0x04280  preemptible frames transmitted in more than one
+                           fragment (a hold / release of the pMAC)
+      PRMPTDRCNT  0x04284  frames reassembled without error
+      PRMEVNTTCNT 0x04298  additional fragments transmitted (preemption events)
+      PRMEVNTRCNT 0x042A0  additional fragments received
+      PRMEXPRCNT  0x042A8  exception counters, 8 bits each:
+                           [7:0]   out-of-order fragment (assembly error)
+                           [15:8]  out-of-order frame    (assembly error)
+                           [23:16] SMD error (unknown / unexpected SMD)
+
+    An 8-bit exception field stops at 0xFF until the register is read; a
+    sample that finds one there is counted in 'saturated' so the caller
+    knows the total may be low.
+
+    The hardware keeps no verify state.  The MAC only sends preemptible
+    fragments once verification succeeded (or was disabled), so the
+    verify status is inferred: fragments transmitted since preemption was
+    enabled mean SUCCEEDED, none yet means VERIFYING.  A failed verification
+    therefore shows as VERIFYING that never completes.
+
+    Pure C99 (stdint only) so tests/unit/hal/test_fp_stats.c can check the
+    decode and the delta arithmetic without hardware.
+
+    Implements: REQ-F-FP-002 (Frame preemption statistics)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+/* Register offsets (I225 / I226) */
+#define INTEL_FP_REG_PRMPTDTCNT           0x04280u
+#define INTEL_FP_REG_PRMPTDRCNT           0x04284u
+#define INTEL_FP_REG_PRMEVNTTCNT          0x04298u
+#define INTEL_FP_REG_PRMEVNTRCNT          0x042A0u
+#define INTEL_FP_REG_PRMEXPRCNT           0x042A8u
+
+/* PRMEXPRCNT fields */
+#define INTEL_FP_PRMEXPR_OOO_FRAG_MASK    0x000000FFu
+#define INTEL_FP_PRMEXPR_OOO_FRAG_SHIFT   0u
+#define INTEL_FP_PRMEXPR_OOO_FRAME_MASK   0x0000FF00u
+#define INTEL_FP_PRMEXPR_OOO_FRAME_SHIFT  8u
+#define INTEL_FP_PRMEXPR_SMD_MASK         0x00FF0000u
+#define INTEL_FP_PRMEXPR_SMD_SHIFT        16u
+#define INTEL_FP_PRMEXPR_FIELD_MAX        0xFFu
+
+/* Verify status (values match ethtool_mm_verify_status where they overlap) */
+#define INTEL_FP_VERIFY_UNKNOWN           0u    /* never sampled */
+#define INTEL_FP_VERIFY_VERIFYING         2u    /* enabled, no fragment sent yet */
+#define INTEL_FP_VERIFY_SUCCEEDED         3u    /* fragments sent since enable */
+#define INTEL_FP_VERIFY_DISABLED          5u    /* verification turned off (sends without it) */
+#define INTEL_FP_VERIFY_OFF               6u    /* preemption not enabled */
+
+/* Counter index in intel_fp_counters_t */
+#define INTEL_FP_CNT_TX_FRAGMENTS         0u    /* PRMEVNTTCNT */
+#define INTEL_FP_CNT_RX_FRAGMENTS         1u    /* PRMEVNTRCNT */
+#define INTEL_FP_CNT_TX_HOLDS             2u    /* PRMPTDTCNT: frames preempted at least once */
+#define INTEL_FP_CNT_RX_ASSEMBLY_OK       3u    /* PRMPTDRCNT */
+#define INTEL_FP_CNT_RX_ASSEMBLY_ERRORS   4u    /* PRMEXPRCNT out-of-order fragment + frame */
+#define INTEL_FP_CNT_RX_SMD_ERRORS        5u    /* PRMEXPRCNT SMD */
+#define INTEL_FP_CNT_COUNT                6u
+
+/**
+ * @brief One read of the MAC merge registers (intel_device_ops_t::read_fp_stats)
+ */
+struct intel_fp_sample {
+    uint32_t tx_holds;          /* PRMPTDTCNT  */
+    uint32_t rx_assembly_ok;    /* PRMPTDRCNT  */
+    uint32_t tx_fragments;      /* PRMEVNTTCNT */
+    uint32_t rx_fragments;      /* PRMEVNTRCNT */
+    uint32_t exceptions;        /* PRMEXPRCNT  */
+    uint8_t  fp_enabled;        /* preemption enabled in the FP configuration */
+    uint8_t  verify_disabled;   /* verification turned off */
+    uint8_t  reserved[2];
+};
+
+typedef struct _intel_fp_counters {
+    uint64_t c[INTEL_FP_CNT_COUNT];
+} intel_fp_counters_t;
+
+/**
+ * @brief Running totals and the baseline deltas are reported against
+ */
+typedef struct _intel_fp_stats {
+    intel_fp_counters_t total;      /* since the adapter came up / last reset */
+    intel_fp_counters_t baseline;   /* total at the last reported delta */
+    uint64_t samples;
+    uint64_t saturated;             /* samples with an exception field at 0xFF */
+    uint64_t tx_fragments_enabled;  /* TX fragments since preemption was last enabled */
+    uint64_t sample_ns;             /* clock of the last sample */
+    uint64_t baseline_ns;           /* clock when the baseline was taken */
+    uint32_t verify_status;         /* INTEL_FP_VERIFY_* */
+    uint32_t fp_enabled;
+} intel_fp_stats_t;
+
+static __inline void intel_fp_stats_reset(intel_fp_stats_t *s, uint64_t now_ns)
+{
+    memset(s, 0, sizeof(*s));
+    s->sample_ns   = now_ns;
+    s->baseline_ns = now_ns;
+}
+
+/** Add one clear-on-read sample taken at now_ns to the totals */
+static __inline void intel_fp_stats_accumulate(intel_fp_stats_t *s, const struct intel_fp_sample *r,
+                                               uint64_t now_ns)
+{
+    uint32_t frag  = (r->exceptions & INTEL_FP_PRMEXPR_OOO_FRAG_MASK)  >> INTEL_FP_PRMEXPR_OOO_FRAG_SHIFT;
+    uint32_t frame = (r->exceptions & INTEL_FP_PRMEXPR_OOO_FRAME_MASK) >> INTEL_FP_PRMEXPR_OOO_FRAME_SHIFT;
+    uint32_t smd   = (r->exceptions & INTEL_FP_PRMEXPR_SMD_MASK)       >> INTEL_FP_PRMEXPR_SMD_SHIFT;
+
+    s->total.c[INTEL_FP_CNT_TX_FRAGMENTS]       += r->tx_fragments;
+    s->total.c[INTEL_FP_CNT_RX_FRAGMENTS]       += r->rx_fragments;
+    s->total.c[INTEL_FP_CNT_TX_HOLDS]           += r->tx_holds;
+    s->total.c[INTEL_FP_CNT_RX_ASSEMBLY_OK]     += r->rx_assembly_ok;
+    s->total.c[INTEL_FP_CNT_RX_ASSEMBLY_ERRORS] += (uint64_t)frag + frame;
+    s->total.c[INTEL_FP_CNT_RX_SMD_ERRORS]      += smd;
+    if (frag == INTEL_FP_PRMEXPR_FIELD_MAX || frame == INTEL_FP_PRMEXPR_FIELD_MAX ||
+        smd == INTEL_FP_PRMEXPR_FIELD_MAX) {
+        s->saturated++;
+    }
+    s->samples++;
+    s->sample_ns = now_ns;
+
+    /* Verify status, inferred from the transmit side */
+    if (!r->fp_enabled) {
+        s->tx_fragments_enabled = 0;
+        s->verify_status = INTEL_FP_VERIFY_OFF;
+    } else {
+        if (!s->fp_enabled) {
+            s->tx_fragments_enabled = 0;
+        }
+        s->tx_fragments_enabled += r->tx_fragments;
+        if (r->verify_disabled) {
+            s->verify_status = INTEL_FP_VERIFY_DISABLED;
+        } else {
+            s->verify_status = s->tx_fragments_enabled ? INTEL_FP_VERIFY_SUCCEEDED : INTEL_FP_VERIFY_VERIFYING;
+        }
+    }
+    s->fp_enabled = r->fp_enabled ? 1u : 0u;
+}
+
+/**
+ * @brief Counts since the baseline; *interval_ns receives the time covered.
+ * advance != 0 moves the baseline to the current totals.
+ */
+static __inline void intel_fp_stats_delta(intel_fp_stats_t *s, intel_fp_counters_t *delta,
+                                          uint64_t *interval_ns, int advance)
+{
+    uint32_t i;
+
+    for (i = 0; i < INTEL_FP_CNT_COUNT; i++) {
+        delta->c[i] = s->total.c[i] - s->baseline.c[i];
+    }
+    *interval_ns = (s->sample_ns > s->baseline_ns) ? s->sample_ns - s->baseline_ns : 0;
+    if (advance) {
+        s->baseline    = s->total;
+        s->baseline_ns = s->sample_ns;
+    }
+}
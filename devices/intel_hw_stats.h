@@ -0,0 +1,277 @@
+/*++
+
+Module Name:
+
+    intel_hw_stats.h
+
+Abstract:
+
+    MAC statistics registers of the supported Intel controllers (the block at
+    0x04000 plus the per-queue drop counters), the accumulator that turns
+    them into 64-bit totals, and the seqlock-protected page the totals are
+    published on (IOCTL_AVB_HW_STATS maps it read-only into user mode).
+
+    The registers clear on read - except RQDPC on the I210 / I225 / I226,
+    which clears only when written with 0 - so every read must be added
+    to a running total.  The octet counters are 64 bits wide in two
+    registers; reading the high half clears both.
+
+    The miniport owns these registers: it reads the block for its own
+    statistics (and writes RQDPC to 0 after reading it), and whatever one
+    reader takes the other never sees.  The sampler therefore reads a
+    clear-on-read counter only when the caller selected it, accepting that
+    the miniport's statistics then miss those counts.  Counters that clear
+    only on a write (intel_hw_stats_map_t::write_clear) are read without
+    writing: the sample carries the register value (running), and the
+    accumulator adds its growth since the previous read, or the whole value
+    after the miniport cleared it meanwhile.
+
+    Which counters a MAC has is described per device by an
+    intel_hw_stats_map_t (intel_device_ops_t::hw_stats):
+
+      E1000E  I217 / I219           base block
+      IGB     82575 / 82576 / 82580 base block, RQDPC 0..3
+      I350    I350 / I354           base block, RQDPC 0..3, LPI counters
+      I210    I210 / I225 / I226    as I350, RQDPC cleared by writing 0
+
+    The page has one writer (the sampler, under its lock).  It makes seq
+    odd, stores the header and counters, then makes seq even again; a
+    reader copies the page between two reads of an even, unchanged seq
+    (intel_hw_stats_page_read) and so never sees half a sample.
+
+    Pure C99 (stdint only) so tests/unit/hal/test_hw_stats.c and the
+    avb_hwstats tool use the same table, accumulator and reader.
+
+    Implements: REQ-F-STATISTICS-004 (NIC hardware statistics sampling)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/* Counter index (bit n of the present / write_clear masks) */
+#define INTEL_HW_STAT_CRC_ERRORS          0u    /* CRCERRS  0x04000 */
+#define INTEL_HW_STAT_ALIGN_ERRORS        1u    /* ALGNERRC 0x04004 */
+#define INTEL_HW_STAT_RX_ERRORS           2u    /* RXERRC   0x0400C */
+#define INTEL_HW_STAT_MISSED_PACKETS      3u    /* MPC      0x04010 */
+#define INTEL_HW_STAT_SINGLE_COLLISIONS   4u    /* SCC      0x04014 */
+#define INTEL_HW_STAT_EXCESS_COLLISIONS   5u    /* ECOL     0x04018 */
+#define INTEL_HW_STAT_MULTI_COLLISIONS    6u    /* MCC      0x0401C */
+#define INTEL_HW_STAT_LATE_COLLISIONS     7u    /* LATECOL  0x04020 */
+#define INTEL_HW_STAT_COLLISIONS          8u    /* COLC     0x04028 */
+#define INTEL_HW_STAT_DEFERRED            9u    /* DC       0x04030 */
+#define INTEL_HW_STAT_TX_NO_CRS           10u   /* TNCRS    0x04034 */
+#define INTEL_HW_STAT_RX_LENGTH_ERRORS    11u   /* RLEC     0x04040 */
+#define INTEL_HW_STAT_XON_RX              12u   /* XONRXC   0x04048 */
+#define INTEL_HW_STAT_XON_TX              13u   /* XONTXC   0x0404C */
+#define INTEL_HW_STAT_XOFF_RX             14u   /* XOFFRXC  0x04050 */
+#define INTEL_HW_STAT_XOFF_TX             15u   /* XOFFTXC  0x04054 */
+#define INTEL_HW_STAT_FC_UNSUPPORTED      16u   /* FCRUC    0x04058 */
+#define INTEL_HW_STAT_GOOD_RX_PACKETS     17u   /* GPRC     0x04074 */
+#define INTEL_HW_STAT_BCAST_RX_PACKETS    18u   /* BPRC     0x04078 */
+#define INTEL_HW_STAT_MCAST_RX_PACKETS    19u   /* MPRC     0x0407C */
+#define INTEL_HW_STAT_GOOD_TX_PACKETS     20u   /* GPTC     0x04080 */
+#define INTEL_HW_STAT_GOOD_RX_OCTETS      21u   /* GORCL/H  0x04088 / 0x0408C */
+#define INTEL_HW_STAT_GOOD_TX_OCTETS      22u   /* GOTCL/H  0x04090 / 0x04094 */
+#define INTEL_HW_STAT_RX_NO_BUFFERS       23u   /* RNBC     0x040A0 */
+#define INTEL_HW_STAT_RX_UNDERSIZE        24u   /* RUC      0x040A4 */
+#define INTEL_HW_STAT_RX_FRAGMENTS        25u   /* RFC      0x040A8 */
+#define INTEL_HW_STAT_RX_OVERSIZE         26u   /* ROC      0x040AC */
+#define INTEL_HW_STAT_RX_JABBER           27u   /* RJC      0x040B0 */
+#define INTEL_HW_STAT_TOTAL_RX_OCTETS     28u   /* TORL/H   0x040C0 / 0x040C4 */
+#define INTEL_HW_STAT_TOTAL_TX_OCTETS     29u   /* TOTL/H   0x040C8 / 0x040CC */
+#define INTEL_HW_STAT_TOTAL_RX_PACKETS    30u   /* TPR      0x040D0 */
+#define INTEL_HW_STAT_TOTAL_TX_PACKETS    31u   /* TPT      0x040D4 */
+#define INTEL_HW_STAT_MCAST_TX_PACKETS    32u   /* MPTC     0x040F0 */
+#define INTEL_HW_STAT_BCAST_TX_PACKETS    33u   /* BPTC     0x040F4 */
+#define INTEL_HW_STAT_RX_LPI              34u   /* RLPIC    0x04148: LPI entries, receive */
+#define INTEL_HW_STAT_TX_LPI              35u   /* TLPIC    0x0414C: LPI entries, transmit */
+#define INTEL_HW_STAT_RX_QUEUE_DROPS_0    36u   /* RQDPC(0) 0x0C030; queue n at + 0x40 * n */
+#define INTEL_HW_STAT_RX_QUEUE_DROPS_1    37u
+#define INTEL_HW_STAT_RX_QUEUE_DROPS_2    38u
+#define INTEL_HW_STAT_RX_QUEUE_DROPS_3    39u
+#define INTEL_HW_STAT_COUNT               40u
+
+#define INTEL_HW_STAT_BIT(i)              (1ull << (i))
+
+/* Counter groups */
+#define INTEL_HW_STATS_BASE               (INTEL_HW_STAT_BIT(INTEL_HW_STAT_BCAST_TX_PACKETS + 1u) - 1u)
+#define INTEL_HW_STATS_LPI                (INTEL_HW_STAT_BIT(INTEL_HW_STAT_RX_LPI) | INTEL_HW_STAT_BIT(INTEL_HW_STAT_TX_LPI))
+#define INTEL_HW_STATS_QDROP              (0xFull << INTEL_HW_STAT_RX_QUEUE_DROPS_0)
+
+/**
+ * @brief Counters a MAC has (intel_device_ops_t::hw_stats)
+ */
+typedef struct _intel_hw_stats_map {
+    uint64_t present;       /* INTEL_HW_STAT_BIT() of every counter the MAC has */
+    uint64_t write_clear;   /* counters that clear when written with 0, not on read */
+} intel_hw_stats_map_t;
+
+#define INTEL_HW_STATS_MAP_E1000E_INIT    { INTEL_HW_STATS_BASE, 0u }
+#define INTEL_HW_STATS_MAP_IGB_INIT       { INTEL_HW_STATS_BASE | INTEL_HW_STATS_QDROP, 0u }
+#define INTEL_HW_STATS_MAP_I350_INIT      { INTEL_HW_STATS_BASE | INTEL_HW_STATS_QDROP | INTEL_HW_STATS_LPI, 0u }
+#define INTEL_HW_STATS_MAP_I210_INIT      { INTEL_HW_STATS_BASE | INTEL_HW_STATS_QDROP | INTEL_HW_STATS_LPI, \
+                                            INTEL_HW_STATS_QDROP }
+
+/**
+ * @brief Register of counter i: *hi receives the high half of a 64-bit
+ * counter, 0 for a 32-bit one.  Returns 0 for an index out of range.
+ */
+static __inline uint32_t intel_hw_stats_reg(uint32_t i, uint32_t *hi)
+{
+    static const uint32_t lo_reg[INTEL_HW_STAT_COUNT] = {
+        0x04000u, 0x04004u, 0x0400Cu, 0x04010u, 0x04014u, 0x04018u, 0x0401Cu, 0x04020u,
+        0x04028u, 0x04030u, 0x04034u, 0x04040u, 0x04048u, 0x0404Cu, 0x04050u, 0x04054u,
+        0x04058u, 0x04074u, 0x04078u, 0x0407Cu, 0x04080u, 0x04088u, 0x04090u, 0x040A0u,
+        0x040A4u, 0x040A8u, 0x040ACu, 0x040B0u, 0x040C0u, 0x040C8u, 0x040D0u, 0x040D4u,
+        0x040F0u, 0x040F4u, 0x04148u, 0x0414Cu, 0x0C030u, 0x0C070u, 0x0C0B0u, 0x0C0F0u
+    };
+
+    *hi = 0;
+    if (i >= INTEL_HW_STAT_COUNT) {
+        return 0;
+    }
+    if (i == INTEL_HW_STAT_GOOD_RX_OCTETS || i == INTEL_HW_STAT_GOOD_TX_OCTETS ||
+        i == INTEL_HW_STAT_TOTAL_RX_OCTETS || i == INTEL_HW_STAT_TOTAL_TX_OCTETS) {
+        *hi = lo_reg[i] + 4u;
+    }
+    return lo_reg[i];
+}
+
+/**
+ * @brief One read of the statistics registers; v[i] = (hi << 32) | lo
+ */
+struct intel_hw_stats_sample {
+    uint64_t present;                       /* counters read */
+    uint64_t running;                       /* of those, not cleared by the read: v is the register value */
+    uint64_t v[INTEL_HW_STAT_COUNT];
+};
+
+/**
+ * @brief Running 64-bit totals
+ */
+typedef struct _intel_hw_stats {
+    uint64_t total[INTEL_HW_STAT_COUNT];
+    uint64_t present;           /* counters ever read */
+    uint64_t samples;
+    uint64_t read_errors;       /* samples cut short by a failed register read */
+    uint64_t sample_ns;         /* clock of the last sample */
+    uint64_t last[INTEL_HW_STAT_COUNT];     /* running counters: value at the previous read */
+} intel_hw_stats_t;
+
+static __inline void intel_hw_stats_reset(intel_hw_stats_t *s)
+{
+    memset(s, 0, sizeof(*s));
+}
+
+/** Counters of map whose read takes the counts away from the miniport */
+static __inline uint64_t intel_hw_stats_clear_on_read(const intel_hw_stats_map_t *map)
+{
+    return map->present & ~map->write_clear;
+}
+
+/**
+ * @brief Add one sample taken at now_ns to the totals.  A sample cut short
+ * by a failed read still carries the counters read (and cleared) before
+ * the failure; the rest are picked up by the next one.  A running counter
+ * adds its growth since the previous read; one that went down was cleared
+ * by someone else and adds its whole value.
+ */
+static __inline void intel_hw_stats_accumulate(intel_hw_stats_t *s, const struct intel_hw_stats_sample *r,
+                                               uint64_t now_ns)
+{
+    uint32_t i;
+
+    for (i = 0; i < INTEL_HW_STAT_COUNT; i++) {
+        if (!(r->present & INTEL_HW_STAT_BIT(i))) {
+            continue;
+        }
+        if (r->running & INTEL_HW_STAT_BIT(i)) {
+            s->total[i] += (r->v[i] >= s->last[i]) ? r->v[i] - s->last[i] : r->v[i];
+            s->last[i]   = r->v[i];
+        } else {
+            s->total[i] += r->v[i];
+        }
+    }
+    s->present |= r->present;
+    s->samples++;
+    s->sample_ns = now_ns;
+}
+
+/* ---------------------------------------------------------------------------
+ * Published page (same layout as AVB_HW_STATS_PAGE in include/avb_ioctl.h)
+ * --------------------------------------------------------------------------- */
+#define INTEL_HW_STATS_PAGE_VERSION       1u
+
+#if defined(_MSC_VER)
+#if defined(_M_ARM64)
+#define INTEL_HW_STATS_FENCE()            __dmb(_ARM64_BARRIER_ISH)
+#else
+#define INTEL_HW_STATS_FENCE()            _ReadWriteBarrier()     /* x86 / x64 keep store and load order */
+#endif
+#else
+#define INTEL_HW_STATS_FENCE()            __atomic_thread_fence(__ATOMIC_ACQ_REL)
+#endif
+
+typedef struct _intel_hw_stats_page {
+    volatile uint32_t seq;          /* odd while the writer updates the page */
+    uint32_t version;               /* INTEL_HW_STATS_PAGE_VERSION */
+    uint32_t counter_count;         /* INTEL_HW_STAT_COUNT */
+    uint32_t interval_ms;           /* sampling interval, 0 = stopped */
+    uint64_t present;
+    uint64_t samples;
+    uint64_t sample_ns;
+    uint64_t read_errors;
+    uint64_t reserved[2];
+    uint64_t counters[INTEL_HW_STAT_COUNT];
+} intel_hw_stats_page_t;
+
+/** Publish the totals on the page (single writer) */
+static __inline void intel_hw_stats_publish(intel_hw_stats_page_t *p, const intel_hw_stats_t *s,
+                                            uint32_t interval_ms)
+{
+    uint32_t seq = p->seq;
+
+    p->seq = seq | 1u;
+    INTEL_HW_STATS_FENCE();
+    p->version       = INTEL_HW_STATS_PAGE_VERSION;
+    p->counter_count = INTEL_HW_STAT_COUNT;
+    p->interval_ms   = interval_ms;
+    p->present       = s->present;
+    p->samples       = s->samples;
+    p->sample_ns     = s->sample_ns;
+    p->read_errors   = s->read_errors;
+    memcpy(p->counters, s->total, sizeof(p->counters));
+    INTEL_HW_STATS_FENCE();
+    p->seq = (seq | 1u) + 1u;
+}
+
+/**
+ * @brief Copy a consistent page into out; gives up after tries attempts
+ * that all overlapped an update.  Returns 1 on success, 0 otherwise.
+ */
+static __inline int intel_hw_stats_page_read(const volatile intel_hw_stats_page_t *p, intel_hw_stats_page_t *out,
+                                             uint32_t tries)
+{
+    while (tries-- != 0) {
+        uint32_t s1 = p->seq, s2;
+
+        if (s1 & 1u) {
+            continue;
+        }
+        INTEL_HW_STATS_FENCE();
+        memcpy(out, (const void *)p, sizeof(*out));
+        INTEL_HW_STATS_FENCE();
+        s2 = p->seq;
+        if (s1 == s2) {
+            out->seq = s1;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -142,6 +142,9 @@ static int set_systime(device_t *dev, uint64_t systime)
     return 0;
 }
 
+/* I210 SYSTIM is split sec/ns (same layout as I225/I226). */
+static const intel_systim_conv_t i210_systim_conv = INTEL_SYSTIM_CONV_SPLIT_INIT;
+
 /**
  * @brief Get I210 system time (SYSTIM registers)
  * @param dev Device handle
@@ -175,7 +178,7 @@ static int get_systime(device_t *dev, uint64_t *systime)
 
     // I210 SYSTIM: SYSTIMH = seconds, SYSTIML = nanoseconds (0-999,999,999)
     // Convert to full nanoseconds (same as I225/I226 split format)
-    *systime = (uint64_t)ts_high * 1000000000ULL + (uint64_t)ts_low;
+    *systime = intel_systim_decode(&i210_systim_conv, ts_high, ts_low);
 
     DEBUGP(DL_TRACE, "<==i210_get_systime: sec=%u ns=%u -> 0x%llx\n", ts_high, ts_low, *systime);
     return 0;
@@ -599,6 +602,75 @@ static int i210_set_target_time(device_t *dev, uint8_t timer_index,
     return 0;
 }
 
+/**
+ * @brief Program the credit-based shaper of SR queue 0 or 1 (802.1Qav)
+ *
+ * I210 DS §7.2.7.5: the queue is switched to stream-reservation mode with the
+ * idle slope in TQAVCC and hiCredit in TQAVHC; TQAVCTRL selects Qav transmit
+ * mode and credit-based data arbitration while at least one queue is SR.
+ * sendSlope and loCredit are derived by the hardware from the link rate.
+ */
+static int i210_setup_qav(device_t *dev, uint8_t queue, struct intel_cbs_config *cfg)
+{
+    uint32_t status, cc, cc_other, hc, ctrl, reg = 0;
+    uint32_t mbps;
+
+    if (queue >= INTEL_CBS_QUEUE_COUNT || cfg == NULL) {
+        return -EINVAL;
+    }
+
+    if (ndis_platform_ops.mmio_read(dev, INTEL_CBS_REG_STATUS, &status) != 0) {
+        return -EIO;
+    }
+    mbps = intel_cbs_link_mbps(INTEL_CBS_FAMILY_I210, status);
+    cfg->port_rate_Bps = mbps * 125000u;
+
+    if (cfg->idle_slope_Bps) {
+        if (cfg->port_rate_Bps && cfg->idle_slope_Bps >= cfg->port_rate_Bps) {
+            return -EINVAL;
+        }
+        reg = intel_cbs_idle_slope_reg(INTEL_CBS_FAMILY_I210, cfg->idle_slope_Bps);
+        if (reg > INTEL_CBS_TQAVCC_IDLESLOPE_MASK) {
+            return -EINVAL;
+        }
+    }
+    if (intel_cbs_hicredit_reg(INTEL_CBS_FAMILY_I210, reg ? cfg->hi_credit_bytes : 0, &hc) != 0) {
+        return -EINVAL;
+    }
+
+    if (ndis_platform_ops.mmio_read(dev, INTEL_CBS_REG_TQAVCC(queue), &cc) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_CBS_REG_TQAVCC(queue ^ 1u), &cc_other) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_CBS_REG_TQAVCTRL, &ctrl) != 0) {
+        return -EIO;
+    }
+
+    cc &= ~(INTEL_CBS_TQAVCC_IDLESLOPE_MASK | INTEL_CBS_TQAVCC_I210_QUEUE_MODE_SR);
+    if (reg) {
+        cc |= reg | INTEL_CBS_TQAVCC_I210_QUEUE_MODE_SR;
+        ctrl |= INTEL_CBS_I210_TQAVCTRL_XMIT_MODE | INTEL_CBS_I210_TQAVCTRL_DATATRANARB;
+    } else if (!(cc_other & INTEL_CBS_TQAVCC_I210_QUEUE_MODE_SR)) {
+        ctrl &= ~(INTEL_CBS_I210_TQAVCTRL_XMIT_MODE | INTEL_CBS_I210_TQAVCTRL_DATATRANARB);
+    }
+
+    /* hiCredit before the slope so the queue never runs with a stale bound */
+    if (ndis_platform_ops.mmio_write(dev, INTEL_CBS_REG_TQAVHC(queue), hc) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_CBS_REG_TQAVCC(queue), cc) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_CBS_REG_TQAVCTRL, ctrl) != 0) {
+        return -EIO;
+    }
+
+    cfg->idle_slope_reg  = reg;
+    cfg->idle_slope_Bps  = reg ? intel_cbs_idle_slope_Bps(INTEL_CBS_FAMILY_I210, reg) : 0;
+    cfg->hi_credit_bytes = reg ? cfg->hi_credit_bytes : 0;
+
+    DEBUGP(DL_INFO, "I210: qav q%u idle=%u B/s (reg %u) hi=%u link=%u Mb/s TQAVCC=0x%08X TQAVCTRL=0x%08X\n",
+           queue, cfg->idle_slope_Bps, reg, cfg->hi_credit_bytes, mbps, cc, ctrl);
+    return 0;
+}
+
+/* Statistics block, LPI counters; RQDPC 0..3 clear only when written (REQ-F-STATISTICS-004) */
+static const intel_hw_stats_map_t i210_hw_stats = INTEL_HW_STATS_MAP_I210_INIT;
+
 /**
  * @brief I210 device operations structure - CORRECTED: No TSN support
  * I210 (2013) has excellent IEEE 1588 PTP but NO TSN features (TSN standard finalized 2015-2016)
@@ -617,10 +689,12 @@ const intel_device_ops_t i210_ops = {
     .init = init,
     .cleanup = cleanup,
     .get_info = get_info,
+    .hw_stats = &i210_hw_stats,
     
     // PTP operations - I210 has excellent IEEE 1588 support
     .set_systime = set_systime,
     .get_systime = get_systime,
+    .systim_conv = &i210_systim_conv,
     .init_ptp = init_ptp,
     .enable_packet_timestamping = enable_packet_timestamping,
     
@@ -642,10 +716,18 @@ const intel_device_ops_t i210_ops = {
     .get_aux_timestamp = NULL,            // No auxiliary timestamp FIFO on I210
     .clear_aux_timestamp_flag = NULL,     // No auxiliary timestamp FIFO on I210
     
+    // Periodic SDP output - same TSAUXC/TSSDP/FREQOUT block as I225/I226 (I210 DS §8.16)
+    .perout_configure = intel_sdp_perout_configure,
+    .perout_disable = intel_sdp_perout_disable,
+    .perout_arm_edge = intel_sdp_perout_arm_edge,
+    .perout_read_aux = intel_sdp_perout_read_aux,
+    .aux_capture_configure = intel_sdp_aux_capture_configure,
+    
     // TSN operations - NOT SUPPORTED (I210 predates TSN hardware implementation)
     .setup_tas = NULL,                    // No TSN hardware
     .setup_frame_preemption = NULL,       // No TSN hardware
     .setup_ptm = NULL,                    // No PCIe PTM hardware
+    .setup_qav = i210_setup_qav,          // 802.1Qav CBS on SR queues 0/1 (I210 DS §7.2.7.5)
     
     // Register access - I210 supports both generic and device-specific
     .read_register = NULL,  // Use generic platform implementation
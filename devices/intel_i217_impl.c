@@ -161,6 +161,9 @@ static int set_systime(device_t *dev, uint64_t systime)
     return -ENOTSUP;
 }
 
+/* I217 SYSTIM is a flat 64-bit nanosecond counter. */
+static const intel_systim_conv_t i217_systim_conv = INTEL_SYSTIM_CONV_FLAT_INIT(0);
+
 /**
  * @brief Get I217 system time using SSOT register definitions
  * @param dev Device handle
@@ -191,7 +194,7 @@ static int get_systime(device_t *dev, uint64_t *systime)
         return result;
     }
     
-    *systime = ((uint64_t)ts_high << 32) | ts_low;
+    *systime = intel_systim_decode(&i217_systim_conv, ts_high, ts_low);
     
     DEBUGP(DL_TRACE, "<==i217_get_systime: 0x%llx\n", *systime);
     return 0;
@@ -664,6 +667,9 @@ static int i217_write_tsauxc(device_t *dev, uint32_t tsauxc_value)
     return 0;
 }
 
+/* Statistics block only: no per-queue drop or MAC LPI counters (REQ-F-STATISTICS-004) */
+static const intel_hw_stats_map_t i217_hw_stats = INTEL_HW_STATS_MAP_E1000E_INIT;
+
 /**
  * @brief I217 device operations structure
  *
@@ -687,10 +693,12 @@ const intel_device_ops_t i217_ops = {
     .init    = init,
     .cleanup = cleanup,
     .get_info = get_info,
+    .hw_stats = &i217_hw_stats,
 
     /* set_systime returns -ENOTSUP (SYSTIM is read-only on I217) */
     .set_systime = set_systime,
     .get_systime = get_systime,
+    .systim_conv = &i217_systim_conv,
     .init_ptp = init_ptp,
     .enable_packet_timestamping = enable_packet_timestamping,
 
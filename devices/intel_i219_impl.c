@@ -45,6 +45,10 @@ static volatile uint32_t i219_tsauxc_shadow = 0x00000000U;
  * NOTE: single static; a multi-I219 system would need per-device storage. */
 static volatile uint64_t i219_systim_offset = 0;
 
+/* raw / 200000 via exact reciprocal multiply (no 64-bit divide on the read path).
+ * See intel_systim_decode.h for the derivation and exactness bound. */
+static const intel_systim_conv_t i219_systim_conv = INTEL_SYSTIM_CONV_I219_INIT;
+
 /**
  * @brief Initialize I219 device with enhanced PTP setup
  * @param dev Device handle
@@ -230,9 +234,9 @@ static int init_ptp(device_t *dev)
         ndis_platform_ops.mmio_read(dev, I219_SYSTIMH, &ts_hi);  /* SECOND: latched value */
         raw = ((uint64_t)ts_hi << 32) | ts_lo;
         InterlockedExchange64((volatile LONG64 *)&i219_systim_offset,
-                              (LONG64)(now_tai_ns - raw / 200000ULL));
+                              (LONG64)(now_tai_ns - intel_systim_scaled_to_ns(&i219_systim_conv, raw)));
         DEBUGP(DL_INFO, "I219 init_ptp: offset=0x%llx (TAI_epoch=0x%llx, raw_ns=0x%llx)\n",
-               i219_systim_offset, now_tai_ns, raw / 200000ULL);
+               i219_systim_offset, now_tai_ns, intel_systim_scaled_to_ns(&i219_systim_conv, raw));
     }
 
     DEBUGP(DL_TRACE, "<==i219_init_ptp: Success\n");
@@ -289,10 +293,10 @@ static int set_systime(device_t *dev, uint64_t systime)
      * InterlockedExchange64 provides an explicit memory barrier so the write is
      * visible on all cores before the function returns. */
     InterlockedExchange64((volatile LONG64 *)&i219_systim_offset,
-                          (LONG64)(systime - raw / 200000ULL));
+                          (LONG64)(systime - intel_systim_scaled_to_ns(&i219_systim_conv, raw)));
 
     DEBUGP(DL_WARN, "[I219-DIAG] SET: target=0x%llx offset=0x%llx raw=0x%llx raw/200k=%llu\n",
-           systime, i219_systim_offset, raw, raw / 200000ULL);
+           systime, i219_systim_offset, raw, intel_systim_scaled_to_ns(&i219_systim_conv, raw));
     return 0;
 }
 
@@ -382,9 +386,10 @@ static int get_systime(device_t *dev, uint64_t *systime)
             return 0;
         }
         uint64_t offset_snap = i219_systim_offset;  /* volatile read; ring-3→0 entry provides fence */
-        *systime = offset_snap + raw2 / 200000ULL;
+        uint64_t raw_ns = intel_systim_scaled_to_ns(&i219_systim_conv, raw2);
+        *systime = offset_snap + raw_ns;
         DEBUGP(DL_WARN, "[I219-DIAG] GET: result=0x%llx raw=0x%llx raw/200k=%llu offset=0x%llx\n",
-               *systime, raw2, raw2 / 200000ULL, offset_snap);
+               *systime, raw2, raw_ns, offset_snap);
     }
     return 0;
 
@@ -862,6 +867,9 @@ static int i219_write_tsauxc(device_t *dev, uint32_t tsauxc_value)
     return 0;
 }
 
+/* Statistics block only: no per-queue drop or MAC LPI counters (REQ-F-STATISTICS-004) */
+static const intel_hw_stats_map_t i219_hw_stats = INTEL_HW_STATS_MAP_E1000E_INIT;
+
 /**
  * @brief I219 device operations structure using clean generic function names
  *
@@ -885,10 +893,12 @@ const intel_device_ops_t i219_ops = {
     .init    = init,
     .cleanup = cleanup,
     .get_info = get_info,
+    .hw_stats = &i219_hw_stats,
 
     /* PTP clock operations */
     .set_systime  = set_systime,
     .get_systime  = get_systime,
+    .systim_conv  = &i219_systim_conv,
     .init_ptp     = init_ptp,
     .enable_packet_timestamping = enable_packet_timestamping,
 
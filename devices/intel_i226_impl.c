@@ -19,6 +19,7 @@ Abstract:
 #include "external/intel_avb/lib/intel_windows.h"  // Required for platform_ops struct definition
 #include "external/intel_avb/lib/intel_private.h"  // Required for struct intel_private definition
 #include "intel-ethernet-regs/gen/i226_regs.h"  // SSOT register definitions
+#include "intel_qbv.h"                        // compiled GCL -> STQT/ENDQT encoding
 
 // Application-specific constants
 #define I226_FREQOUT0_1MHZ      1000        // 1 µs half-cycle (1 MHz clock) - application value
@@ -37,9 +38,11 @@ Abstract:
 #define I226_BASET_H            0x3318  // Base time high
 #define I226_QBVCYCLET          0x331C  // Cycle time register
 #define I226_QBVCYCLET_S        0x3320  // Cycle time shadow register
-#define I226_STQT(i)            (0x3340 + (i)*4)  // Start time for queue i
-#define I226_ENDQT(i)           (0x3380 + (i)*4)  // End time for queue i  
-#define I226_TXQCTL(i)          (0x3300 + (i)*4)  // Queue control for queue i
+#define I226_STQT(i)            (0x3324 + (i)*4)  // Start time for queue i (igc_regs.h IGC_STQT)
+#define I226_ENDQT(i)           (0x3334 + (i)*4)  // End time for queue i (igc_regs.h IGC_ENDQT)
+#define I226_TXQCTL(i)          (0x3344 + (i)*4)  // Queue control for queue i (igc_regs.h IGC_TXQCTL)
+#define I226_QUEUE_COUNT        4
+#define I226_QBV_START_LEAD_NS  1000000     // earliest schedule start after the PHC read (1 ms)
 
 // I226 TSN Control Bits - Evidence-Based from Linux IGC Driver
 // TODO: Add these to i226.yaml and regenerate SSOT header
@@ -51,6 +54,9 @@ Abstract:
 // TODO: Add these to i226.yaml and regenerate SSOT header
 #define I226_TXQCTL_QUEUE_MODE_LAUNCHT   0x00000001  // Launch time mode
 #define I226_TXQCTL_STRICT_CYCLE         0x00000002  // Strict cycle mode
+#define I226_TXQCTL_QAV_SEL_MASK         0x000000C0  // Credit shaper select
+#define I226_TXQCTL_QAV_SEL_CBS0         0x00000080  // Queue shaped by CBS0
+#define I226_TXQCTL_QAV_SEL_CBS1         0x000000C0  // Queue shaped by CBS1
 
 // I226 EtherType Queue Filter (ETQF) - Evidence from Linux IGB driver (igb_ptp.c:806-811)
 // Required for hardware PTP packet timestamping in continuous operation
@@ -123,8 +129,11 @@ static VOID AvbTimerDpcRoutine(
     device_t *dev = &context->intel_device;
     uint32_t tsicr = 0;
     
+    /* Register accesses below count as this DPC's (IOCTL_AVB_MMIO_ACCT) */
+    AVB_MMIO_SCOPE_BEGIN(context, AVB_MMIO_CALLER_TT_DPC);
     if (ndis_platform_ops.mmio_read(dev, I226_TSICR, &tsicr) != 0) {
         DEBUGP(DL_TRACE, "!!! DPC: Failed to read TSICR\n");
+        AVB_MMIO_SCOPE_END(context, AVB_MMIO_CALLER_TT_DPC);
         return;
     }
     
@@ -233,6 +242,7 @@ static VOID AvbTimerDpcRoutine(
         ndis_platform_ops.mmio_write(dev, I226_TSICR, clear_val);
         DEBUGP(DL_TRACE, "!!! DPC: Cleared TSICR.TT1 interrupt\n");
     }
+    AVB_MMIO_SCOPE_END(context, AVB_MMIO_CALLER_TT_DPC);
 }
 
 /**
@@ -372,6 +382,9 @@ static int set_systime(device_t *dev, uint64_t systime)
     return 0;
 }
 
+/* I226/I225 SYSTIM is split sec/ns: decode is a single multiply-add. */
+static const intel_systim_conv_t i226_systim_conv = INTEL_SYSTIM_CONV_SPLIT_INIT;
+
 /**
  * @brief Get I226 system time (SYSTIM registers)
  * @param dev Device handle
@@ -400,7 +413,7 @@ static int get_systime(device_t *dev, uint64_t *systime)
     
     // Reconstruct 64-bit nanosecond timestamp: seconds * 1e9 + nanoseconds
     // NOT ((high << 32) | low) -- that would be the I210 flat format
-    *systime = (uint64_t)ts_high * 1000000000ULL + (uint64_t)ts_low;
+    *systime = intel_systim_decode(&i226_systim_conv, ts_high, ts_low);
     
     DEBUGP(DL_TRACE, "<==i226_get_systime: sec=%u nsec=%u total=0x%llx\n", ts_high, ts_low, *systime);
     return 0;
@@ -519,18 +532,136 @@ static int init_ptp(device_t *dev)
     return 0;
 }
 
+/**
+ * @brief Compile and encode a TAS configuration for the I226
+ *
+ * Compiles the gate control list with avb_tas_compile (src/tas_gcl.c, the
+ * I225/I226 capabilities from AvbGetTasCaps) and encodes it into the
+ * per-queue STQT/ENDQT windows (intel_qbv.h), rolling the base time forward
+ * by whole cycles to no earlier than earliest_ns.
+ *
+ * @return 0, or -EINVAL for a schedule the hardware cannot run
+ */
+static int i226_qbv_build(PAVB_DEVICE_CONTEXT context, const struct tsn_tas_config *config,
+                          uint64_t earliest_ns, avb_tas_schedule_t *tas, struct intel_qbv_regs *sched,
+                          uint64_t *base_ns)
+{
+    avb_tas_caps_t caps;
+    avb_tas_diag_t diag;
+    avb_tas_result_t rc;
+    uint64_t cycle_ns;
+    uint32_t entries;
+
+    // Compile the GCL (it ends at the first zero duration), then encode the windows
+    if (!NT_SUCCESS(AvbGetTasCaps(context->intel_device.pci_device_id, &caps))) {
+        return -EINVAL;
+    }
+    entries = 0;
+    while (entries < RTL_NUMBER_OF(config->gate_durations) && config->gate_durations[entries] != 0) {
+        entries++;
+    }
+    *base_ns = config->base_time_s * 1000000000ULL + config->base_time_ns;
+    cycle_ns = (uint64_t)config->cycle_time_s * 1000000000ULL + config->cycle_time_ns;
+    rc = avb_tas_compile(&caps, NULL, config->gate_states, config->gate_durations, entries, cycle_ns,
+                         tas, &diag);
+    if (rc != AVB_TAS_OK) {
+        DEBUGP(DL_ERROR, "I226 TAS: schedule rejected: %s (entry %d, queue %d, %llu vs limit %llu)\n",
+               avb_tas_result_str(rc),
+               diag.entry == AVB_TAS_NO_ENTRY ? -1 : (int)diag.entry,
+               diag.queue == AVB_TAS_NO_QUEUE ? -1 : (int)diag.queue,
+               diag.value, diag.limit);
+        return -EINVAL;
+    }
+    if (intel_qbv_encode(tas, *base_ns, earliest_ns, sched) != INTEL_QBV_OK) {
+        DEBUGP(DL_ERROR, "I226 TAS: schedule rejected: a queue needs more than one window per cycle\n");
+        return -EINVAL;
+    }
+    return 0;
+}
+
+/**
+ * @brief Take the I226 gate list down: TSN mode off, BASET cleared
+ *
+ * @param tqavctrl in: TQAVCTRL as read, out: as written
+ */
+static int i226_qbv_stop(device_t *dev, uint32_t *tqavctrl)
+{
+    *tqavctrl &= ~(I226_TQAVCTRL_TRANSMIT_MODE_TSN | I226_TQAVCTRL_FUTSCDDIS);
+    if (ndis_platform_ops.mmio_write(dev, I226_TQAVCTRL, *tqavctrl) != 0 ||
+        ndis_platform_ops.mmio_write(dev, I226_BASET_H, 0) != 0 ||
+        ndis_platform_ops.mmio_write(dev, I226_BASET_L, 0) != 0) {
+        return -EIO;
+    }
+    return 0;
+}
+
+/**
+ * @brief Arm an encoded schedule as a first start at sched->base_ns
+ *
+ * igc order: TSN mode with future-schedule start, cycle, per-queue windows,
+ * BASET_H, then BASET_L (0, then the value arms it).
+ */
+static int i226_qbv_arm(device_t *dev, uint32_t tqavctrl, const struct intel_qbv_regs *sched)
+{
+    uint32_t i;
+
+    tqavctrl |= I226_TQAVCTRL_TRANSMIT_MODE_TSN | I226_TQAVCTRL_ENHANCED_QAV | I226_TQAVCTRL_FUTSCDDIS;
+    if (ndis_platform_ops.mmio_write(dev, I226_TQAVCTRL, tqavctrl) != 0 ||
+        ndis_platform_ops.mmio_write(dev, I226_QBVCYCLET_S, sched->cycle_ns) != 0 ||
+        ndis_platform_ops.mmio_write(dev, I226_QBVCYCLET, sched->cycle_ns) != 0) {
+        return -EIO;
+    }
+    for (i = 0; i < I226_QUEUE_COUNT; i++) {
+        uint32_t txqctl;
+        if (ndis_platform_ops.mmio_write(dev, I226_STQT(i), sched->stqt[i]) != 0 ||
+            ndis_platform_ops.mmio_write(dev, I226_ENDQT(i), sched->endqt[i]) != 0 ||
+            ndis_platform_ops.mmio_read(dev, I226_TXQCTL(i), &txqctl) != 0 ||
+            ndis_platform_ops.mmio_write(dev, I226_TXQCTL(i), txqctl | I226_TXQCTL_STRICT_CYCLE) != 0) {
+            return -EIO;
+        }
+    }
+    if (ndis_platform_ops.mmio_write(dev, I226_BASET_H, sched->baset_h) != 0 ||
+        ndis_platform_ops.mmio_write(dev, I226_BASET_L, 0) != 0 ||
+        ndis_platform_ops.mmio_write(dev, I226_BASET_L, sched->baset_l) != 0) {
+        return -EIO;
+    }
+    return 0;
+}
+
 /**
  * @brief Setup I226 Time Aware Shaper (TAS)
- * Implementation matches ChatGPT5 validation sequence
+ *
+ * Compiles and encodes the admin schedule (i226_qbv_build).  On success
+ * config is rewritten with the schedule that will run: the base time it
+ * starts at (the config-change time), the cycle, and the normalized gate
+ * list.
+ *
+ * Only the cycle time has a shadow register (QBVCYCLET_S); the windows do
+ * not, so a running list is never rewritten in place (REQ-F-TAS-003).  With
+ * no list running the schedule is armed at once as a first start.  With one
+ * running, nothing is written: the admin list is staged in
+ * context->tas_admin, its config-change time placed at least
+ * I226_QBV_START_LEAD_NS after the next operational cycle boundary, and
+ * context->tas_switch records the stop time - the last operational boundary
+ * that leaves the lead before the config change.  The caller sets a timer
+ * for the stop time, which calls apply_tas_switch; the running list keeps
+ * its gates until then, and the only gap without a gate list is the lead.
+ * Caller holds context->tas_lock.
+ *
  * @param dev Device handle
- * @param config TAS configuration
- * @return 0 on success, <0 on error
+ * @param config TAS configuration (in: admin schedule, out: schedule at the config change)
+ * @return 0 on success, -EINVAL for a schedule the hardware cannot run,
+ *         -EBUSY if the PHC is not running, <0 on register access failure
  */
 static int setup_tas(device_t *dev, struct tsn_tas_config *config)
 {
     PAVB_DEVICE_CONTEXT context;
-    uint32_t regValue;
-    int result;
+    avb_tas_switch_t *sw;
+    avb_tas_schedule_t tas;
+    struct intel_qbv_regs sched;
+    uint64_t systim_current, systim_stop, systim_done, base_ns;
+    uint32_t regValue, i, lost;
+    int result, staged;
     
     DEBUGP(DL_TRACE, "==>i226_setup_tas (I226-specific implementation)\n");
     
@@ -544,43 +675,84 @@ static int setup_tas(device_t *dev, struct tsn_tas_config *config)
         DEBUGP(DL_TRACE, "i226_setup_tas: No device context\n");
         return -1;
     }
+    sw = &context->tas_switch;
     
     // Log device identification
     DEBUGP(DL_TRACE, "I226 TAS Setup: VID:DID = 0x%04X:0x%04X\n", 
            context->intel_device.pci_vendor_id, context->intel_device.pci_device_id);
     
     // Verify PHC is running
-    uint64_t systim_current;
     result = get_systime(dev, &systim_current);
     if (result != 0 || systim_current == 0) {
         DEBUGP(DL_TRACE, "I226 PHC not running - TAS requires active PTP clock\n");
-        return -1;
+        return -EBUSY;
     }
+    avb_tas_switch_poll(sw, systim_current);
     
-    DEBUGP(DL_TRACE, "? I226 PHC verified: SYSTIM=0x%llx\n", systim_current);
+    // A running list keeps its current cycle: the earliest switch is the
+    // next operational boundary plus the lead (now + lead if none runs)
+    result = i226_qbv_build(context, config,
+                            avb_tas_switch_next_boundary(sw, systim_current) + I226_QBV_START_LEAD_NS,
+                            &tas, &sched, &base_ns);
+    if (result != 0) {
+        return result;
+    }
     
-    // Program TQAVCTRL register (I226-specific address)
     result = ndis_platform_ops.mmio_read(dev, I226_TQAVCTRL, &regValue);
     if (result != 0) return result;
     
-    // Set TSN mode and enhanced QAV
-    regValue |= I226_TQAVCTRL_TRANSMIT_MODE_TSN | I226_TQAVCTRL_ENHANCED_QAV;
-    
-    result = ndis_platform_ops.mmio_write(dev, I226_TQAVCTRL, regValue);
-    if (result != 0) return result;
-    
-    DEBUGP(DL_TRACE, "? I226 TQAVCTRL programmed: 0x%08X\n", regValue);
-    
-    // Program cycle time
-    uint32_t cycle_time_ns = config->cycle_time_s * 1000000000UL + config->cycle_time_ns;
-    if (cycle_time_ns == 0) {
-        cycle_time_ns = 1000000;  // Default 1ms cycle
+    staged = avb_tas_switch_running(sw) && (regValue & I226_TQAVCTRL_TRANSMIT_MODE_TSN);
+    if (staged) {
+        // Leave the running list alone; the switch timer stops it (apply_tas_switch)
+        context->tas_admin = *config;
+        avb_tas_switch_stage(sw, base_ns, sched.cycle_ns, sched.base_ns,
+                             avb_tas_switch_stop_time(sw, sched.base_ns, I226_QBV_START_LEAD_NS));
+    } else {
+        // Nothing runs: an armed list that has not started yet is replaced at once
+        systim_stop = systim_current;
+        if (regValue & I226_TQAVCTRL_TRANSMIT_MODE_TSN) {
+            if (i226_qbv_stop(dev, &regValue) != 0) {
+                avb_tas_switch_fail(sw, -EIO, 1);
+                return -EIO;
+            }
+            (void)get_systime(dev, &systim_stop);
+        }
+        if (i226_qbv_arm(dev, regValue, &sched) != 0) {
+            avb_tas_switch_fail(sw, -EIO, 1);
+            return -EIO;
+        }
+        
+        // Armed: a PHC already past the config-change time starts it a cycle later
+        if (get_systime(dev, &systim_done) != 0) {
+            systim_done = systim_stop;
+        }
+        lost = avb_tas_switch_commit(sw, base_ns, sched.cycle_ns, sched.base_ns, systim_stop, systim_done);
+        if (lost != 0) {
+            DEBUGP(DL_WARN, "I226 TAS: %u cycle(s) lost, no gate list for %llu ns up to the config change\n",
+                   lost, sched.base_ns - systim_stop);
+        }
     }
     
-    result = ndis_platform_ops.mmio_write(dev, I226_QBVCYCLET, cycle_time_ns);
-    if (result != 0) return result;
+    DEBUGP(DL_INFO, "I226 TAS: cycle=%u ns base=%u.%09u (rolled %llu cycles) entries=%u %s "
+           "q0=[%u,%u) q1=[%u,%u) q2=[%u,%u) q3=[%u,%u)\n",
+           sched.cycle_ns, sched.baset_h, sched.baset_l, sched.cycles_rolled, tas.count,
+           staged ? "staged" : "start",
+           sched.stqt[0], sched.endqt[0], sched.stqt[1], sched.endqt[1],
+           sched.stqt[2], sched.endqt[2], sched.stqt[3], sched.endqt[3]);
+    if (staged) {
+        DEBUGP(DL_INFO, "I226 TAS: running list stops at %llu ns, %llu ns before the config change\n",
+               sw->stop_ns, sched.base_ns - sw->stop_ns);
+    }
     
-    DEBUGP(DL_TRACE, "? I226 cycle time programmed: %lu ns\n", cycle_time_ns);
+    // Report the schedule as it will run
+    config->base_time_s   = sched.baset_h;
+    config->base_time_ns  = sched.baset_l;
+    config->cycle_time_s  = sched.cycle_ns / 1000000000u;
+    config->cycle_time_ns = sched.cycle_ns % 1000000000u;
+    for (i = 0; i < RTL_NUMBER_OF(config->gate_durations); i++) {
+        config->gate_states[i]    = (i < tas.count) ? tas.entries[i].gates : 0;
+        config->gate_durations[i] = (i < tas.count) ? tas.entries[i].interval_ns : 0;
+    }
     
     // Final verification
     result = ndis_platform_ops.mmio_read(dev, I226_TQAVCTRL, &regValue);
@@ -593,6 +765,149 @@ static int setup_tas(device_t *dev, struct tsn_tas_config *config)
     }
 }
 
+/**
+ * @brief Switch to the staged TAS schedule (REQ-F-TAS-003)
+ *
+ * Called from the switch timer at the stop time setup_tas recorded, with
+ * context->tas_lock held (DISPATCH_LEVEL).  Takes the running list down and
+ * arms the staged one as a first start at the config-change time - or, if
+ * the timer ran late and the lead no longer fits, at the first admin cycle
+ * boundary it does fit before - and commits the switch with the cycles lost.
+ *
+ * @return 0 on success or with nothing staged, <0 on failure
+ */
+static int apply_tas_switch(device_t *dev)
+{
+    PAVB_DEVICE_CONTEXT context;
+    avb_tas_switch_t *sw;
+    avb_tas_schedule_t tas;
+    struct intel_qbv_regs sched;
+    uint64_t systim_stop, systim_done, base_ns;
+    uint32_t regValue, lost;
+    int result;
+    
+    if (dev == NULL || dev->private_data == NULL) {
+        return -1;
+    }
+    context = (PAVB_DEVICE_CONTEXT)dev->private_data;
+    sw = &context->tas_switch;
+    if (!sw->staged) {
+        return 0;
+    }
+    
+    result = ndis_platform_ops.mmio_read(dev, I226_TQAVCTRL, &regValue);
+    if (result != 0) return result;
+    if (i226_qbv_stop(dev, &regValue) != 0) {
+        avb_tas_switch_fail(sw, -EIO, 1);
+        return -EIO;
+    }
+    if (get_systime(dev, &systim_stop) != 0) {
+        systim_stop = sw->stop_ns;
+    }
+    
+    // Same schedule SETUP_TAS validated; the CCT only moves if the stop ran late
+    result = i226_qbv_build(context, &context->tas_admin, systim_stop + I226_QBV_START_LEAD_NS,
+                            &tas, &sched, &base_ns);
+    if (result == 0) {
+        result = i226_qbv_arm(dev, regValue, &sched);
+    }
+    if (result != 0) {
+        avb_tas_switch_fail(sw, result, 1);
+        return result;
+    }
+    
+    if (get_systime(dev, &systim_done) != 0) {
+        systim_done = systim_stop;
+    }
+    lost = avb_tas_switch_commit(sw, base_ns, sched.cycle_ns, sched.base_ns, systim_stop, systim_done);
+    
+    DEBUGP(DL_INFO, "I226 TAS: switch at %llu ns, cycle=%u ns base=%u.%09u, %u cycle(s) lost\n",
+           systim_stop, sched.cycle_ns, sched.baset_h, sched.baset_l, lost);
+    return 0;
+}
+
+/**
+ * @brief Program the credit-based shaper of SR queue 0 or 1 (802.1Qav)
+ *
+ * I225/I226 shape through CBS0/CBS1, selected per queue by TXQCTL.QAV_SEL and
+ * only active in TSN transmit mode (I225 DS §7.5.2.7).  When TSN mode is not
+ * yet on (no TAS schedule), it is enabled with one always-open 1 s window per
+ * queue - the same default the Linux igc driver uses - so enabling CBS does not
+ * gate traffic.  sendSlope and loCredit are derived by the hardware.
+ */
+static int i226_setup_qav(device_t *dev, uint8_t queue, struct intel_cbs_config *cfg)
+{
+    uint32_t status, ctrl, txqctl, hc, reg = 0;
+    uint32_t mbps;
+    uint8_t i;
+
+    if (queue >= INTEL_CBS_QUEUE_COUNT || cfg == NULL) {
+        return -EINVAL;
+    }
+
+    if (ndis_platform_ops.mmio_read(dev, INTEL_CBS_REG_STATUS, &status) != 0) {
+        return -EIO;
+    }
+    mbps = intel_cbs_link_mbps(INTEL_CBS_FAMILY_I225, status);
+    cfg->port_rate_Bps = mbps * 125000u;
+
+    if (cfg->idle_slope_Bps) {
+        if (cfg->port_rate_Bps && cfg->idle_slope_Bps >= cfg->port_rate_Bps) {
+            return -EINVAL;
+        }
+        reg = intel_cbs_idle_slope_reg(INTEL_CBS_FAMILY_I225, cfg->idle_slope_Bps);
+        if (reg > INTEL_CBS_TQAVCC_IDLESLOPE_MASK) {
+            return -EINVAL;
+        }
+    }
+    if (intel_cbs_hicredit_reg(INTEL_CBS_FAMILY_I225, reg ? cfg->hi_credit_bytes : 0, &hc) != 0) {
+        return -EINVAL;
+    }
+
+    if (ndis_platform_ops.mmio_read(dev, I226_TQAVCTRL, &ctrl) != 0 ||
+        ndis_platform_ops.mmio_read(dev, I226_TXQCTL(queue), &txqctl) != 0) {
+        return -EIO;
+    }
+
+    if (reg && !(ctrl & I226_TQAVCTRL_TRANSMIT_MODE_TSN)) {
+        if (ndis_platform_ops.mmio_write(dev, I226_QBVCYCLET_S, 1000000000u) != 0 ||
+            ndis_platform_ops.mmio_write(dev, I226_QBVCYCLET, 1000000000u) != 0) {
+            return -EIO;
+        }
+        for (i = 0; i < I226_QUEUE_COUNT; i++) {
+            if (ndis_platform_ops.mmio_write(dev, I226_STQT(i), 0) != 0 ||
+                ndis_platform_ops.mmio_write(dev, I226_ENDQT(i), 1000000000u) != 0) {
+                return -EIO;
+            }
+        }
+        ctrl |= I226_TQAVCTRL_TRANSMIT_MODE_TSN | I226_TQAVCTRL_ENHANCED_QAV;
+        if (ndis_platform_ops.mmio_write(dev, I226_TQAVCTRL, ctrl) != 0) {
+            return -EIO;
+        }
+    }
+
+    txqctl &= ~I226_TXQCTL_QAV_SEL_MASK;
+    if (reg) {
+        txqctl |= (queue == 0) ? I226_TXQCTL_QAV_SEL_CBS0 : I226_TXQCTL_QAV_SEL_CBS1;
+    }
+
+    /* hiCredit before the slope so the queue never runs with a stale bound */
+    if (ndis_platform_ops.mmio_write(dev, INTEL_CBS_REG_TQAVHC(queue), hc) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_CBS_REG_TQAVCC(queue),
+                                     reg | INTEL_CBS_TQAVCC_I225_KEEP_CREDITS) != 0 ||
+        ndis_platform_ops.mmio_write(dev, I226_TXQCTL(queue), txqctl) != 0) {
+        return -EIO;
+    }
+
+    cfg->idle_slope_reg  = reg;
+    cfg->idle_slope_Bps  = reg ? intel_cbs_idle_slope_Bps(INTEL_CBS_FAMILY_I225, reg) : 0;
+    cfg->hi_credit_bytes = reg ? cfg->hi_credit_bytes : 0;
+
+    DEBUGP(DL_INFO, "I226: qav q%u idle=%u B/s (reg %u) hi=%u link=%u Mb/s TXQCTL=0x%08X TQAVCTRL=0x%08X\n",
+           queue, cfg->idle_slope_Bps, reg, cfg->hi_credit_bytes, mbps, txqctl, ctrl);
+    return 0;
+}
+
 /* PCIe Extended Capability List constants (PCIe spec §7.6.2) */
 /* TODO: add to intel-ethernet-regs/devices/pcie_common.yaml when reggen supports PCIe arch constants */
 #define PCIE_EXT_CAP_BASE       0x100       /* First extended cap at config offset 256 */
@@ -685,6 +1000,45 @@ static int setup_frame_preemption(device_t *dev, struct tsn_fp_config *config)
     return result;
 }
 
+/**
+ * @brief Read the I226 MAC merge counters (IEEE 802.3br statistics)
+ *
+ * The counters clear on read; the caller accumulates them (intel_fp_stats.h).
+ * fp_enabled / verify_disabled come from I226_FP_CONFIG.
+ *
+ * @param dev    Device handle
+ * @param sample Raw counters and FP configuration bits
+ * @return 0 on success, <0 on error
+ */
+static int i226_read_fp_stats(device_t *dev, struct intel_fp_sample *sample)
+{
+    uint32_t fp_cfg = 0;
+    int result;
+
+    if (dev == NULL || sample == NULL) {
+        return -EINVAL;
+    }
+
+    result = ndis_platform_ops.mmio_read(dev, I226_FP_CONFIG, &fp_cfg);
+    if (result == 0) result = ndis_platform_ops.mmio_read(dev, INTEL_FP_REG_PRMPTDTCNT,  &sample->tx_holds);
+    if (result == 0) result = ndis_platform_ops.mmio_read(dev, INTEL_FP_REG_PRMPTDRCNT,  &sample->rx_assembly_ok);
+    if (result == 0) result = ndis_platform_ops.mmio_read(dev, INTEL_FP_REG_PRMEVNTTCNT, &sample->tx_fragments);
+    if (result == 0) result = ndis_platform_ops.mmio_read(dev, INTEL_FP_REG_PRMEVNTRCNT, &sample->rx_fragments);
+    if (result == 0) result = ndis_platform_ops.mmio_read(dev, INTEL_FP_REG_PRMEXPRCNT,  &sample->exceptions);
+    if (result != 0) {
+        DEBUGP(DL_ERROR, "i226_read_fp_stats: mmio_read failed: %d\n", result);
+        return result;
+    }
+
+    sample->fp_enabled = (fp_cfg & (uint32_t)I226_FP_CONFIG_SET(0, I226_FP_CONFIG_EN_MASK,
+                                                                 I226_FP_CONFIG_EN_SHIFT, 1)) ? 1u : 0u;
+    sample->verify_disabled = (fp_cfg & (uint32_t)I226_FP_CONFIG_SET(0, I226_FP_CONFIG_VERIFY_DIS_MASK,
+                                                                      I226_FP_CONFIG_VERIFY_DIS_SHIFT, 1)) ? 1u : 0u;
+    sample->reserved[0] = 0;
+    sample->reserved[1] = 0;
+    return 0;
+}
+
 /**
  * @brief Setup I226 PCIe PTM (Precision Time Measurement, IEEE 1588 Annex B)
  *
@@ -1524,6 +1878,9 @@ static int i226_write_tsauxc(device_t *dev, uint32_t tsauxc_value)
 }
 
 // I226 device operations structure - using generic function names
+/* Same statistics layout as the I210, RQDPC cleared by writing 0 (REQ-F-STATISTICS-004) */
+static const intel_hw_stats_map_t i226_hw_stats = INTEL_HW_STATS_MAP_I210_INIT;
+
 const intel_device_ops_t i226_ops = {
     /* Capabilities per Intel I226 datasheet:
      * I226 is MMIO-only (like I225); no MDIO interface exposed to driver.
@@ -1538,10 +1895,12 @@ const intel_device_ops_t i226_ops = {
     .init = init,
     .cleanup = cleanup,
     .get_info = get_info,
+    .hw_stats = &i226_hw_stats,
     
     // PTP operations - clean generic names
     .set_systime = set_systime,
     .get_systime = get_systime,
+    .systim_conv = &i226_systim_conv,
     .init_ptp = init_ptp,
     .enable_packet_timestamping = enable_packet_timestamping,
     
@@ -1562,10 +1921,20 @@ const intel_device_ops_t i226_ops = {
     .get_aux_timestamp = i226_get_aux_timestamp,
     .clear_aux_timestamp_flag = i226_clear_aux_timestamp_flag,
     
+    // Periodic SDP output (REQ-F-PTP-PEROUT-001)
+    .perout_configure = intel_sdp_perout_configure,
+    .perout_disable = intel_sdp_perout_disable,
+    .perout_arm_edge = intel_sdp_perout_arm_edge,
+    .perout_read_aux = intel_sdp_perout_read_aux,
+    .aux_capture_configure = intel_sdp_aux_capture_configure,
+    
     // TSN operations - clean generic names
     .setup_tas = setup_tas,
+    .apply_tas_switch = apply_tas_switch,
     .setup_frame_preemption = setup_frame_preemption,
+    .read_fp_stats = i226_read_fp_stats,
     .setup_ptm = setup_ptm,
+    .setup_qav = i226_setup_qav,
     
     // Register access (uses default implementation)
     .read_register = NULL,
@@ -234,6 +234,9 @@ static int set_systime(device_t *dev, uint64_t systime)
     return 0;
 }
 
+/* I350 SYSTIM is a flat 64-bit nanosecond counter. */
+static const intel_systim_conv_t i350_systim_conv = INTEL_SYSTIM_CONV_FLAT_INIT(0);
+
 /**
  * @brief Get I350 system time using SYSTIM registers
  * @param dev Device handle
@@ -258,7 +261,7 @@ static int get_systime(device_t *dev, uint64_t *systime)
     result = ndis_platform_ops.mmio_read(dev, E1000_SYSTIMH, &ts_high);
     if (result != 0) return result;
     
-    *systime = ((uint64_t)ts_high << 32) | ts_low;
+    *systime = intel_systim_decode(&i350_systim_conv, ts_high, ts_low);
     
     DEBUGP(DL_TRACE, "<==i350_get_systime: 0x%llx\n", *systime);
     return 0;
@@ -447,6 +450,9 @@ static int enable_packet_timestamping(device_t *dev, int enable)
     return 0;
 }
 
+/* Statistics block, RQDPC 0..3 and LPI counters, clear on read (REQ-F-STATISTICS-004) */
+static const intel_hw_stats_map_t i350_hw_stats = INTEL_HW_STATS_MAP_I350_INIT;
+
 /**
  * @brief I350 device operations structure - CORRECTED: No TSN support  
  * I350 (2012) has standard IEEE 1588 PTP but NO TSN features (TSN standard didn't exist yet)
@@ -459,10 +465,12 @@ const intel_device_ops_t i350_ops = {
     .init = init,
     .cleanup = cleanup,
     .get_info = get_info,
+    .hw_stats = &i350_hw_stats,
     
     // PTP operations - I350 has good IEEE 1588 support
     .set_systime = set_systime,
     .get_systime = get_systime,
+    .systim_conv = &i350_systim_conv,
     .init_ptp = init_ptp,
     .enable_packet_timestamping = enable_packet_timestamping,
     
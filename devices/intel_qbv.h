@@ -0,0 +1,118 @@
+/*++
+
+Module Name:
+
+    intel_qbv.h
+
+Abstract:
+
+    IEEE 802.1Qbv register encoding for the I225/I226 Qbv engine.
+
+    The I225/I226 has no gate control list in hardware.  Each of the four
+    transmit queues gets exactly one transmission window per cycle:
+
+      BASET_H / BASET_L   0x3318 / 0x3314   schedule start, PHC seconds / ns
+      QBVCYCLET(_S)       0x331C / 0x3320   cycle length in ns (<= 1 s)
+      STQT(i)             0x3324 + 4i       window start, ns from cycle start
+      ENDQT(i)            0x3334 + 4i       window end,   ns from cycle start
+                                            (STQT == ENDQT: queue never open)
+
+    The gate list itself is compiled and validated by src/tas_gcl.c
+    (avb_tas_compile with avb_tas_caps_i225: four queues, one window per
+    queue, no window across the cycle end).  This header only turns such an
+    operational schedule into the register image: each queue's window
+    becomes STQT/ENDQT, and a base time that is not ahead of now is rolled
+    forward by whole cycles, so the schedule keeps its phase relative to the
+    requested base time.
+
+    Pure C99 (stdint only) so tests/unit/hal/test_qbv_gcl.c can check the
+    register image without hardware.
+
+    Implements: REQ-F-TAS-001 (Time-Aware Shaper Configuration)
+
+--*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tas_gcl.h"
+
+#define INTEL_QBV_QUEUE_COUNT       4u
+#define INTEL_QBV_NSEC_PER_SEC      1000000000ull
+
+/* intel_qbv_encode results */
+#define INTEL_QBV_OK                0
+#define INTEL_QBV_E_WINDOWS         (-1)    /* schedule not compiled for one window per queue */
+
+/**
+ * @brief I225/I226 register image of a compiled schedule
+ */
+struct intel_qbv_regs {
+    uint64_t base_ns;                               /* operational base time, PHC ns */
+    uint64_t cycles_rolled;                         /* whole cycles added to the requested base */
+    uint32_t cycle_ns;                              /* QBVCYCLET */
+    uint32_t baset_h;                               /* BASET_H: seconds */
+    uint32_t baset_l;                               /* BASET_L: nanoseconds */
+    uint32_t stqt[INTEL_QBV_QUEUE_COUNT];
+    uint32_t endqt[INTEL_QBV_QUEUE_COUNT];
+};
+
+/**
+ * @brief Next cycle boundary at or after now_ns, in phase with base_ns
+ */
+static __inline uint64_t intel_qbv_roll_forward(uint64_t base_ns, uint64_t cycle_ns, uint64_t now_ns,
+                                                uint64_t *cycles)
+{
+    uint64_t n = 0;
+
+    if (base_ns < now_ns && cycle_ns != 0) {
+        n = (now_ns - base_ns + cycle_ns - 1u) / cycle_ns;
+        base_ns += n * cycle_ns;
+    }
+    if (cycles != NULL) {
+        *cycles = n;
+    }
+    return base_ns;
+}
+
+/**
+ * @brief Encode a schedule compiled by avb_tas_compile into the register image
+ *
+ * @param s       operational schedule (I225/I226 capabilities)
+ * @param base_ns requested base time, PHC ns
+ * @param now_ns  earliest time the schedule may start (PHC now + lead)
+ * @return INTEL_QBV_OK, or INTEL_QBV_E_WINDOWS if a queue has more than one
+ *         window or one across the cycle end; *r is complete only on success
+ */
+static __inline int intel_qbv_encode(const avb_tas_schedule_t *s, uint64_t base_ns, uint64_t now_ns,
+                                     struct intel_qbv_regs *r)
+{
+    avb_tas_window_t w;
+    uint32_t q;
+
+    for (q = 0; q < INTEL_QBV_QUEUE_COUNT; q++) {
+        switch (avb_tas_queue_windows(s, q, &w, 1)) {
+        case 0:
+            r->stqt[q]  = 0;
+            r->endqt[q] = 0;
+            break;
+        case 1:
+            if (w.start_ns + (uint64_t)w.length_ns > s->cycle_ns) {
+                return INTEL_QBV_E_WINDOWS;
+            }
+            r->stqt[q]  = w.start_ns;
+            r->endqt[q] = w.start_ns + w.length_ns;
+            break;
+        default:
+            return INTEL_QBV_E_WINDOWS;
+        }
+    }
+
+    r->cycle_ns = s->cycle_ns;
+    r->base_ns  = intel_qbv_roll_forward(base_ns, s->cycle_ns, now_ns, &r->cycles_rolled);
+    r->baset_h  = (uint32_t)(r->base_ns / INTEL_QBV_NSEC_PER_SEC);
+    r->baset_l  = (uint32_t)(r->base_ns % INTEL_QBV_NSEC_PER_SEC);
+    return INTEL_QBV_OK;
+}
@@ -0,0 +1,242 @@
+﻿/*++
+
+Module Name:
+
+    intel_sdp_perout.c
+
+Abstract:
+
+    SDP periodic output and AUX capture for the I210 and I225/I226, which
+    share the time-sync auxiliary block described in intel_sdp_perout.h.
+    Both implementations point their perout_* and aux_capture_configure
+    ops here.
+
+    Implements: REQ-F-PTP-PEROUT-001 (Periodic SDP output)
+
+--*/
+
+#include "precomp.h"
+#include "intel_device_interface.h"
+#include "external/intel_avb/lib/intel_windows.h"  // Required for platform_ops struct definition
+
+// External platform operations
+extern const struct platform_ops ndis_platform_ops;
+
+/**
+ * @brief Configure periodic output on an SDP pin (REQ-F-PTP-PEROUT-001)
+ * @param dev           Device context
+ * @param channel       TT/FREQOUT/AUX channel (0 or 1)
+ * @param sdp_pin       Output pin (SDP0-3)
+ * @param measure_pin   Loopback input pin for AUXSTMP<channel>, INTEL_SDP_PIN_NONE to skip
+ * @param freqout       1 = FREQOUT clock started at start_ns, 0 = single TRGTTIM toggle at start_ns
+ * @param start_ns      First edge, PHC time
+ * @param half_cycle_ns FREQOUT half cycle (ignored when freqout == 0)
+ * @return 0 on success, <0 on error
+ *
+ * Same sequence as the Linux igc/igb PTP perout path: stop the channel,
+ * set SDP direction, route TSSDP, program TRGTTIM (seconds/nanoseconds split)
+ * and FREQOUT, then enable.  See intel_sdp_perout.h for bit layouts.
+ */
+int intel_sdp_perout_configure(device_t *dev, uint8_t channel, uint8_t sdp_pin, uint8_t measure_pin,
+                               int freqout, uint64_t start_ns, uint32_t half_cycle_ns)
+{
+    uint32_t ctrl, ctrl_ext, tssdp, tsauxc, aux, sec, nsec;
+    const int measure = (measure_pin != INTEL_SDP_PIN_NONE);
+
+    if (channel >= INTEL_SDP_CHANNEL_COUNT || sdp_pin >= INTEL_SDP_PIN_COUNT ||
+        (measure && (measure_pin >= INTEL_SDP_PIN_COUNT || measure_pin == sdp_pin)) ||
+        (freqout && !intel_freqout_half_ok(half_cycle_ns))) {
+        return -EINVAL;
+    }
+
+    if (ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_TSAUXC, &tsauxc) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_TSSDP, &tssdp) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_CTRL, &ctrl) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_CTRL_EXT, &ctrl_ext) != 0) {
+        return -EIO;
+    }
+
+    /* Stop the channel while it is reprogrammed.  EN_TSn is only ours when
+     * measuring; otherwise AUXSTMPn may be streaming another input. */
+    tsauxc &= ~(INTEL_SDP_TSAUXC_EN_TT(channel) | INTEL_SDP_TSAUXC_EN_CLK(channel) |
+                INTEL_SDP_TSAUXC_ST(channel) | (measure ? INTEL_SDP_TSAUXC_EN_TS(channel) : 0u));
+    if (ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TSAUXC, tsauxc) != 0) {
+        return -EIO;
+    }
+
+    intel_sdp_set_direction(sdp_pin, 1, &ctrl, &ctrl_ext);
+    tssdp = intel_tssdp_route_output(tssdp, sdp_pin, channel, freqout);
+    if (measure) {
+        intel_sdp_set_direction(measure_pin, 0, &ctrl, &ctrl_ext);
+        tssdp = intel_tssdp_route_aux(tssdp, measure_pin, channel);
+    }
+
+    intel_systim_ns_to_split(start_ns, &sec, &nsec);
+    if (ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_CTRL, ctrl) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_CTRL_EXT, ctrl_ext) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TSSDP, tssdp) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TRGTTIML(channel), nsec) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TRGTTIMH(channel), sec) != 0) {
+        return -EIO;
+    }
+
+    if (freqout) {
+        if (ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_FREQOUT(channel), half_cycle_ns) != 0) {
+            return -EIO;
+        }
+        tsauxc |= INTEL_SDP_TSAUXC_EN_CLK(channel) | INTEL_SDP_TSAUXC_ST(channel);
+    } else {
+        tsauxc |= INTEL_SDP_TSAUXC_EN_TT(channel);
+    }
+
+    if (measure) {
+        /* Release any stale capture so the first edge latches */
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_AUXSTMPL(channel), &aux);
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_AUXSTMPH(channel), &aux);
+        tsauxc |= INTEL_SDP_TSAUXC_EN_TS(channel);
+    }
+
+    if (ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TSAUXC, tsauxc) != 0) {
+        return -EIO;
+    }
+
+    DEBUGP(DL_INFO, "SDP: perout ch%u SDP%u %s start=%llu half=%u measure=%u TSAUXC=0x%08X TSSDP=0x%08X\n",
+           channel, sdp_pin, freqout ? "FREQOUT" : "TT", (unsigned long long)start_ns,
+           half_cycle_ns, measure_pin, tsauxc, tssdp);
+    return 0;
+}
+
+/**
+ * @brief Stop periodic output and release the SDP pins (pins revert to input)
+ */
+int intel_sdp_perout_disable(device_t *dev, uint8_t channel, uint8_t sdp_pin, uint8_t measure_pin)
+{
+    uint32_t ctrl, ctrl_ext, tssdp, tsauxc;
+
+    if (channel >= INTEL_SDP_CHANNEL_COUNT || sdp_pin >= INTEL_SDP_PIN_COUNT) {
+        return -EINVAL;
+    }
+
+    if (ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_TSAUXC, &tsauxc) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_TSSDP, &tssdp) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_CTRL, &ctrl) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_CTRL_EXT, &ctrl_ext) != 0) {
+        return -EIO;
+    }
+
+    tsauxc &= ~(INTEL_SDP_TSAUXC_EN_TT(channel) | INTEL_SDP_TSAUXC_EN_CLK(channel) |
+                INTEL_SDP_TSAUXC_ST(channel));
+    tssdp = intel_tssdp_release_output(tssdp, sdp_pin);
+    if (measure_pin < INTEL_SDP_PIN_COUNT) {
+        tsauxc &= ~INTEL_SDP_TSAUXC_EN_TS(channel);
+        tssdp = intel_tssdp_release_aux(tssdp, channel);
+    }
+    intel_sdp_set_direction(sdp_pin, 0, &ctrl, &ctrl_ext);
+
+    if (ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TSAUXC, tsauxc) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TSSDP, tssdp) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_CTRL, ctrl) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_CTRL_EXT, ctrl_ext) != 0) {
+        return -EIO;
+    }
+    return 0;
+}
+
+/**
+ * @brief Re-arm TRGTTIM<channel> for the next SW_REARM edge
+ *
+ * Hot path of the periodic-output timer.  The hardware clears EN_TTn once the
+ * compare fires, so it is set again after the new target is written (same as
+ * the igb TT interrupt handler).  The seconds / nanoseconds split is the
+ * reciprocal multiply of intel_systim_ns_to_split, not a 64-bit divide.
+ */
+int intel_sdp_perout_arm_edge(device_t *dev, uint8_t channel, uint64_t edge_ns)
+{
+    uint32_t tsauxc, sec, nsec;
+
+    if (channel >= INTEL_SDP_CHANNEL_COUNT) {
+        return -EINVAL;
+    }
+    intel_systim_ns_to_split(edge_ns, &sec, &nsec);
+    if (ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TRGTTIML(channel), nsec) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TRGTTIMH(channel), sec) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_TSAUXC, &tsauxc) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TSAUXC, tsauxc | INTEL_SDP_TSAUXC_EN_TT(channel)) != 0) {
+        return -EIO;
+    }
+    return 0;
+}
+
+/**
+ * @brief Read AUXSTMP<channel> as PHC nanoseconds (reading the high word releases the latch)
+ */
+int intel_sdp_perout_read_aux(device_t *dev, uint8_t channel, uint64_t *aux_ns)
+{
+    uint32_t nsec, sec;
+
+    if (channel >= INTEL_SDP_CHANNEL_COUNT || aux_ns == NULL) {
+        return -EINVAL;
+    }
+    if (ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_AUXSTMPL(channel), &nsec) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_AUXSTMPH(channel), &sec) != 0) {
+        return -EIO;
+    }
+    *aux_ns = intel_systim_split_to_ns(sec, nsec);
+    return 0;
+}
+
+/**
+ * @brief Route an SDP input into AUXSTMP<channel> and enable/disable capture
+ * @param enable 1 = pin to input, TSSDP AUXn select, EN_TSn set;
+ *               0 = EN_TSn and the TSSDP AUXn enable cleared (pin left as input)
+ *
+ * The latch is drained once after enabling so the first edge after this call
+ * is captured rather than a value held from earlier use of the channel.
+ */
+int intel_sdp_aux_capture_configure(device_t *dev, uint8_t channel, uint8_t sdp_pin, int enable)
+{
+    uint32_t ctrl, ctrl_ext, tssdp, tsauxc, aux;
+
+    if (channel >= INTEL_SDP_CHANNEL_COUNT || (enable && sdp_pin >= INTEL_SDP_PIN_COUNT)) {
+        return -EINVAL;
+    }
+
+    if (ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_TSAUXC, &tsauxc) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_TSSDP, &tssdp) != 0) {
+        return -EIO;
+    }
+
+    tsauxc &= ~INTEL_SDP_TSAUXC_EN_TS(channel);
+    if (ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TSAUXC, tsauxc) != 0) {
+        return -EIO;
+    }
+
+    if (!enable) {
+        tssdp = intel_tssdp_release_aux(tssdp, channel);
+        return ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TSSDP, tssdp) != 0 ? -EIO : 0;
+    }
+
+    if (ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_CTRL, &ctrl) != 0 ||
+        ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_CTRL_EXT, &ctrl_ext) != 0) {
+        return -EIO;
+    }
+    intel_sdp_set_direction(sdp_pin, 0, &ctrl, &ctrl_ext);
+    tssdp = intel_tssdp_route_aux(tssdp, sdp_pin, channel);
+
+    if (ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_CTRL, ctrl) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_CTRL_EXT, ctrl_ext) != 0 ||
+        ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TSSDP, tssdp) != 0) {
+        return -EIO;
+    }
+
+    ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_AUXSTMPL(channel), &aux);
+    ndis_platform_ops.mmio_read(dev, INTEL_SDP_REG_AUXSTMPH(channel), &aux);
+    tsauxc |= INTEL_SDP_TSAUXC_EN_TS(channel);
+    if (ndis_platform_ops.mmio_write(dev, INTEL_SDP_REG_TSAUXC, tsauxc) != 0) {
+        return -EIO;
+    }
+
+    DEBUGP(DL_INFO, "SDP: aux capture ch%u SDP%u TSAUXC=0x%08X TSSDP=0x%08X\n",
+           channel, sdp_pin, tsauxc, tssdp);
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*++
+
+Module Name:
+
+    intel_sdp_perout.h
+
+Abstract:
+
+    SDP (software-definable pin) routing and periodic-output register helpers
+    shared by the I210 and I225/I226 implementations.
+
+    Both families use the same time-sync auxiliary block:
+
+      TSAUXC    0x0B640   EN_TTn / EN_CLKn / EN_TSn enables
+      TRGTTIMLn 0x0B644 + 8n  target time, nanoseconds field
+      TRGTTIMHn 0x0B648 + 8n  target time, seconds field
+      FREQOUTn  0x0B654 + 4n  clock-out half-cycle time (ns)
+      AUXSTMPLn 0x0B65C + 8n  aux capture, nanoseconds field
+      AUXSTMPHn 0x0B660 + 8n  aux capture, seconds field (read releases latch)
+      TSSDP     0x0003C   SDP <-> TT/FREQOUT/AUX routing
+      CTRL      0x00000   SDP0/SDP1 direction (bits 22/23)
+      CTRL_EXT  0x00018   SDP2/SDP3 direction (bits 10/11)
+
+    Bit layouts are taken from the I210 datasheet v3.7 §8.16.8 (TSAUXC),
+    §8.16.16 (TSSDP) and §8.2.1/§8.2.3 (CTRL/CTRL_EXT) and match the I225/I226
+    datasheets.  The SSOT headers define addresses only for a subset of these,
+    so the helpers below carry their own offsets (same approach as the
+    I210_TSAUXC_* masks in intel_i210_impl.c).
+
+    TRGTTIM and AUXSTMP follow the SPLIT SYSTIM layout on these devices
+    (seconds / nanoseconds), see intel_systim_decode.h.
+
+    Pure C99 (stdint only) so tests/unit/ptp/test_sdp_perout.c can check the
+    TSSDP encoding without hardware.
+
+    Implements: REQ-F-PTP-PEROUT-001 (Periodic SDP output)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#define INTEL_SDP_PIN_COUNT           4u
+#define INTEL_SDP_CHANNEL_COUNT       2u      /* TT0/TT1, FREQOUT0/1, AUX0/1 */
+#define INTEL_SDP_PIN_NONE            0xFFu   /* no loopback measurement pin */
+
+/* Register offsets (I210 / I225 / I226) */
+#define INTEL_SDP_REG_CTRL            0x00000u
+#define INTEL_SDP_REG_CTRL_EXT        0x00018u
+#define INTEL_SDP_REG_TSSDP           0x0003Cu
+#define INTEL_SDP_REG_TSAUXC          0x0B640u
+#define INTEL_SDP_REG_TRGTTIML(n)     (0x0B644u + 8u * (n))
+#define INTEL_SDP_REG_TRGTTIMH(n)     (0x0B648u + 8u * (n))
+#define INTEL_SDP_REG_FREQOUT(n)      (0x0B654u + 4u * (n))
+#define INTEL_SDP_REG_AUXSTMPL(n)     (0x0B65Cu + 8u * (n))
+#define INTEL_SDP_REG_AUXSTMPH(n)     (0x0B660u + 8u * (n))
+
+/* CTRL / CTRL_EXT: SDP direction (1 = output) */
+#define INTEL_SDP_CTRL_SDP0_DIR       0x00400000u
+#define INTEL_SDP_CTRL_SDP1_DIR       0x00800000u
+#define INTEL_SDP_CTRL_EXT_SDP2_DIR   0x00000400u
+#define INTEL_SDP_CTRL_EXT_SDP3_DIR   0x00000800u
+
+/* TSAUXC */
+#define INTEL_SDP_TSAUXC_EN_TT(n)     ((n) ? 0x00000002u : 0x00000001u)
+#define INTEL_SDP_TSAUXC_EN_CLK(n)    ((n) ? 0x00000020u : 0x00000004u)
+#define INTEL_SDP_TSAUXC_ST(n)        ((n) ? 0x00000080u : 0x00000010u)   /* start clock at TRGTTIMn */
+#define INTEL_SDP_TSAUXC_EN_TS(n)     ((n) ? 0x00000400u : 0x00000100u)
+
+/* TSSDP: AUX capture source select */
+#define INTEL_TSSDP_AUX0_SEL_MASK     0x00000003u
+#define INTEL_TSSDP_AUX0_TS_SDP_EN    0x00000004u
+#define INTEL_TSSDP_AUX1_SEL_SHIFT    3u
+#define INTEL_TSSDP_AUX1_SEL_MASK     0x00000018u
+#define INTEL_TSSDP_AUX1_TS_SDP_EN    0x00000020u
+
+/* TSSDP: per-pin output select.  Pin p uses a 2-bit SEL field at 6 + 3p and
+ * an enable bit at 8 + 3p.  SEL: 0 = TT0, 1 = TT1, 2 = FREQOUT0, 3 = FREQOUT1 */
+#define INTEL_TSSDP_SDP_SEL_SHIFT(p)  (6u + 3u * (p))
+#define INTEL_TSSDP_SDP_SEL_MASK(p)   (0x3u << INTEL_TSSDP_SDP_SEL_SHIFT(p))
+#define INTEL_TSSDP_SDP_EN(p)         (0x1u << (8u + 3u * (p)))
+#define INTEL_TSSDP_SEL_TT(n)         (n)
+#define INTEL_TSSDP_SEL_FREQOUT(n)    (2u + (n))
+
+/* FREQOUT half-cycle limits: any value up to 70 ms, or exactly 125/250/500 ms */
+#define INTEL_FREQOUT_MIN_HALF_NS     8u
+#define INTEL_FREQOUT_MAX_HALF_NS     70000000u
+
+/**
+ * @brief Non-zero if FREQOUT can produce a 50 % clock with this half cycle
+ */
+static __inline int intel_freqout_half_ok(uint64_t half_ns)
+{
+    return (half_ns >= INTEL_FREQOUT_MIN_HALF_NS && half_ns <= INTEL_FREQOUT_MAX_HALF_NS) ||
+           half_ns == 125000000u || half_ns == 250000000u || half_ns == 500000000u;
+}
+
+/**
+ * @brief Route SDP pin to TT/FREQOUT channel as an output (TSSDP value)
+ *
+ * Disables AUX capture from the same pin - a pin cannot be both timestamp
+ * input and clock output.
+ */
+static __inline uint32_t intel_tssdp_route_output(uint32_t tssdp, uint8_t pin, uint8_t channel, int freqout)
+{
+    uint32_t sel = freqout ? INTEL_TSSDP_SEL_FREQOUT(channel) : INTEL_TSSDP_SEL_TT(channel);
+
+    if ((tssdp & INTEL_TSSDP_AUX0_SEL_MASK) == pin) {
+        tssdp &= ~INTEL_TSSDP_AUX0_TS_SDP_EN;
+    }
+    if (((tssdp & INTEL_TSSDP_AUX1_SEL_MASK) >> INTEL_TSSDP_AUX1_SEL_SHIFT) == pin) {
+        tssdp &= ~INTEL_TSSDP_AUX1_TS_SDP_EN;
+    }
+    tssdp &= ~INTEL_TSSDP_SDP_SEL_MASK(pin);
+    tssdp |= (sel << INTEL_TSSDP_SDP_SEL_SHIFT(pin)) | INTEL_TSSDP_SDP_EN(pin);
+    return tssdp;
+}
+
+/**
+ * @brief Release SDP pin from time-sync output (TSSDP value)
+ */
+static __inline uint32_t intel_tssdp_release_output(uint32_t tssdp, uint8_t pin)
+{
+    return tssdp & ~(INTEL_TSSDP_SDP_SEL_MASK(pin) | INTEL_TSSDP_SDP_EN(pin));
+}
+
+/**
+ * @brief Route SDP pin into AUXSTMP<channel> capture (TSSDP value)
+ */
+static __inline uint32_t intel_tssdp_route_aux(uint32_t tssdp, uint8_t pin, uint8_t channel)
+{
+    if (channel == 0) {
+        tssdp = (tssdp & ~INTEL_TSSDP_AUX0_SEL_MASK) | pin | INTEL_TSSDP_AUX0_TS_SDP_EN;
+    } else {
+        tssdp = (tssdp & ~INTEL_TSSDP_AUX1_SEL_MASK) |
+                ((uint32_t)pin << INTEL_TSSDP_AUX1_SEL_SHIFT) | INTEL_TSSDP_AUX1_TS_SDP_EN;
+    }
+    return tssdp;
+}
+
+/**
+ * @brief Stop routing any SDP into AUXSTMP<channel> (TSSDP value)
+ */
+static __inline uint32_t intel_tssdp_release_aux(uint32_t tssdp, uint8_t channel)
+{
+    return tssdp & ~(channel ? INTEL_TSSDP_AUX1_TS_SDP_EN : INTEL_TSSDP_AUX0_TS_SDP_EN);
+}
+
+/**
+ * @brief Set SDP direction bit (1 = output) in CTRL or CTRL_EXT
+ * @param ctrl     CTRL value, updated for SDP0/SDP1
+ * @param ctrl_ext CTRL_EXT value, updated for SDP2/SDP3
+ */
+static __inline void intel_sdp_set_direction(uint8_t pin, int output, uint32_t *ctrl, uint32_t *ctrl_ext)
+{
+    static const uint32_t dir_bit[INTEL_SDP_PIN_COUNT] = {
+        INTEL_SDP_CTRL_SDP0_DIR, INTEL_SDP_CTRL_SDP1_DIR,
+        INTEL_SDP_CTRL_EXT_SDP2_DIR, INTEL_SDP_CTRL_EXT_SDP3_DIR
+    };
+    uint32_t *reg = (pin < 2) ? ctrl : ctrl_ext;
+
+    if (output) {
+        *reg |= dir_bit[pin];
+    } else {
+        *reg &= ~dir_bit[pin];
+    }
+}
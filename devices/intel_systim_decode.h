@@ -0,0 +1,165 @@
+/*++
+
+Module Name:
+
+    intel_systim_decode.h
+
+Abstract:
+
+    Division-free SYSTIM register decode shared by the device implementations.
+
+    Every PHC read ends in a raw (SYSTIMH, SYSTIML) pair that has to be turned
+    into nanoseconds.  The hardware uses three layouts:
+
+      SPLIT   I210 / I225 / I226   SYSTIMH = seconds, SYSTIML = ns (0..999,999,999)
+                                   ns = sec * 1e9 + ns         (one 32x64 multiply)
+      FLAT    I217 / 82580         ns = ((H << 32) | L) << shift
+      SCALED  I219                 ns = ((H << 32) | L) / 200000 (5 fs counts)
+
+    The SCALED case used to be a 64-bit hardware divide on every read
+    (~40-90 cycles on x64).  It is replaced by an exact reciprocal multiply:
+
+      raw / 200000 == (raw >> 6) / 3125                    (200000 = 2^6 * 3125)
+      (y)  / 3125  == umulh(y, M) >> 11   for all y < 2^58
+      M = ceil(2^75 / 3125) = 0xA7C5AC471B478424,  e = M*3125 - 2^75 = 2932
+
+    Exactness: floor(y*M / 2^75) == floor(y/3125) whenever e * y < 2^75.
+    With y < 2^58, e * y < 2932 * 2^58 < 2^70, so the identity holds over the
+    full 2^64 raw range.  Verified bit-exact by tests/unit/hal/test_systim_decode.c.
+
+    The SPLIT target registers (TRGTTIM) need the reverse, ns -> seconds and
+    nanoseconds, and get the same treatment:
+
+      ns / 1e9 == (ns >> 9) / 5^9 == umulh(ns >> 9, M) >> 17
+      M = ceil(2^81 / 5^9) = 0x112E0BE826D694B3,  e = M*5^9 - 2^81 = 197023
+
+    exact while e * 2^55 < 2^81, i.e. for every 64-bit ns.
+
+    This header is pure C99 (stdint only) so the same code is compiled into the
+    driver and into the host unit test / micro-benchmark.
+
+    Implements: REQ-NF-PERF-PHC-001 (Division-free PHC read path)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Raw SYSTIM layout of a device family
+ */
+typedef enum _intel_systim_format {
+    INTEL_SYSTIM_FMT_SPLIT  = 0,    /* SYSTIMH = seconds, SYSTIML = nanoseconds */
+    INTEL_SYSTIM_FMT_FLAT   = 1,    /* 64-bit nanosecond counter, optional left shift */
+    INTEL_SYSTIM_FMT_SCALED = 2     /* 64-bit sub-ns counter, reciprocal divide */
+} intel_systim_format_t;
+
+/**
+ * @brief Precomputed raw→ns conversion exposed by each device (ops->systim_conv)
+ *
+ * For SCALED: ns = umulh(raw >> pre_shift, mult) >> post_shift
+ * For FLAT:   ns = raw << pre_shift
+ * For SPLIT:  ns = hi * 1e9 + lo (mult/shift unused)
+ */
+typedef struct _intel_systim_conv {
+    intel_systim_format_t format;
+    uint8_t  pre_shift;     /* SCALED: right shift before multiply; FLAT: left shift */
+    uint8_t  post_shift;    /* SCALED: right shift of the high product word */
+    uint16_t reserved;
+    uint32_t counts_per_ns; /* SCALED: raw counts per nanosecond (reference value) */
+    uint64_t mult;          /* SCALED: reciprocal multiplier */
+} intel_systim_conv_t;
+
+#define INTEL_SYSTIM_NS_PER_SEC         1000000000ULL
+
+/* I219: 200,000 counts/ns (TIMINCA IP=2, IV=16,000,000 @ 25 MHz PCH clock) */
+#define INTEL_SYSTIM_I219_COUNTS_PER_NS 200000u
+#define INTEL_SYSTIM_I219_PRE_SHIFT     6u                      /* 200000 = 2^6 * 3125 */
+#define INTEL_SYSTIM_I219_POST_SHIFT    11u                     /* 2^75 = 2^64 * 2^11 */
+#define INTEL_SYSTIM_I219_MULT          0xA7C5AC471B478424ULL   /* ceil(2^75 / 3125) */
+
+/* ns -> seconds: 1e9 = 2^9 * 5^9 */
+#define INTEL_SYSTIM_SEC_PRE_SHIFT      9u
+#define INTEL_SYSTIM_SEC_POST_SHIFT     17u                     /* 2^81 = 2^64 * 2^17 */
+#define INTEL_SYSTIM_SEC_MULT           0x112E0BE826D694B3ULL   /* ceil(2^81 / 5^9) */
+
+/**
+ * @brief High 64 bits of a 64x64→128 unsigned multiply
+ */
+static __inline uint64_t intel_systim_umulh(uint64_t a, uint64_t b)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    return __umulh(a, b);
+#elif defined(__SIZEOF_INT128__)
+    return (uint64_t)(((unsigned __int128)a * b) >> 64);
+#else
+    /* 32-bit targets: schoolbook 4 x (32x32→64) partial products */
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+    return hi_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/**
+ * @brief SPLIT layout: seconds/nanoseconds register pair to nanoseconds
+ */
+static __inline uint64_t intel_systim_split_to_ns(uint32_t sec, uint32_t nsec)
+{
+    return (uint64_t)sec * INTEL_SYSTIM_NS_PER_SEC + nsec;
+}
+
+/**
+ * @brief SPLIT layout: nanoseconds to the seconds/nanoseconds register pair, no divide
+ */
+static __inline void intel_systim_ns_to_split(uint64_t ns, uint32_t *sec, uint32_t *nsec)
+{
+    uint64_t s = intel_systim_umulh(ns >> INTEL_SYSTIM_SEC_PRE_SHIFT, INTEL_SYSTIM_SEC_MULT) >>
+                 INTEL_SYSTIM_SEC_POST_SHIFT;
+
+    *sec  = (uint32_t)s;
+    *nsec = (uint32_t)(ns - s * INTEL_SYSTIM_NS_PER_SEC);
+}
+
+/**
+ * @brief SCALED layout: raw sub-ns counter to nanoseconds (floor), no divide
+ */
+static __inline uint64_t intel_systim_scaled_to_ns(const intel_systim_conv_t *conv, uint64_t raw)
+{
+    return intel_systim_umulh(raw >> conv->pre_shift, conv->mult) >> conv->post_shift;
+}
+
+/**
+ * @brief Decode a raw SYSTIMH/SYSTIML pair using the device's conversion
+ */
+static __inline uint64_t intel_systim_decode(const intel_systim_conv_t *conv, uint32_t hi, uint32_t lo)
+{
+    uint64_t raw = ((uint64_t)hi << 32) | lo;
+
+    switch (conv->format) {
+    case INTEL_SYSTIM_FMT_SPLIT:
+        return intel_systim_split_to_ns(hi, lo);
+    case INTEL_SYSTIM_FMT_SCALED:
+        return intel_systim_scaled_to_ns(conv, raw);
+    case INTEL_SYSTIM_FMT_FLAT:
+    default:
+        return raw << conv->pre_shift;
+    }
+}
+
+/* Descriptor initializers for ops->systim_conv (each impl owns its const instance) */
+#define INTEL_SYSTIM_CONV_SPLIT_INIT        { INTEL_SYSTIM_FMT_SPLIT, 0, 0, 0, 0, 0 }
+#define INTEL_SYSTIM_CONV_FLAT_INIT(shift)  { INTEL_SYSTIM_FMT_FLAT, (uint8_t)(shift), 0, 0, 0, 0 }
+#define INTEL_SYSTIM_CONV_I219_INIT                                             \
+    { INTEL_SYSTIM_FMT_SCALED, INTEL_SYSTIM_I219_PRE_SHIFT,                     \
+      INTEL_SYSTIM_I219_POST_SHIFT, 0, INTEL_SYSTIM_I219_COUNTS_PER_NS,         \
+      INTEL_SYSTIM_I219_MULT }
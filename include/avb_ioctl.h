@@ -137,7 +137,7 @@ typedef struct _IOCTL_VERSION {
 /* Driver statistics query — implements #270 (TEST-STATISTICS-001) */
 /* Function 0x808 → value 0x00172020: 0x170000 | (0x808 << 2) */
 #define IOCTL_AVB_GET_STATISTICS        _NDIS_CONTROL_CODE(0x808, METHOD_BUFFERED)  /* 0x00172020 */
-/* Function 0x80A → value 0x00172028 */
+/* Function 0x80A → value 0x00172028; counters only, the Outstanding* gauges stay live */
 #define IOCTL_AVB_RESET_STATISTICS      _NDIS_CONTROL_CODE(0x80A, METHOD_BUFFERED)  /* 0x00172028 */
 
 /* Request/response structures (mirror of avb_integration.h) */
@@ -431,6 +431,19 @@ typedef struct AVB_TIMESTAMP_EVENT {
     avb_i64  correction_field;  /* [24-31] PTP correctionField from packet header (0 if N/A) */
 } AVB_TIMESTAMP_EVENT, *PAVB_TIMESTAMP_EVENT;
 
+/* TS_EVENT_AUX_TIMESTAMP records (see IOCTL_AVB_AUX_CAPTURE) reuse the packet
+ * fields, so the layout above is unchanged:
+ *   timestamp_ns      SDP edge latched in AUXSTMPn (PHC ns)
+ *   queue             AUX channel (0/1), trigger_source = SDP pin
+ *   correction_field  edge number on the channel since capture was enabled;
+ *                     edges inferred lost are counted, so numbering has gaps
+ *   packet_length     edges lost immediately before this one (saturates 0xFFFF)
+ * vlan_id is INTEL_MASK_16BIT and pcp 0xFF (not applicable), as for
+ * TS_EVENT_TARGET_TIME. */
+#define AVB_TS_EVENT_AUX_CHANNEL(_e_)   ((_e_).queue)
+#define AVB_TS_EVENT_AUX_EDGE(_e_)      ((avb_u64)(_e_).correction_field)
+#define AVB_TS_EVENT_AUX_OVERRUN(_e_)   ((_e_).packet_length)
+
 /* Ring buffer header (lock-free producer/consumer) 
  * 
  * Layout in memory:
@@ -498,6 +511,17 @@ typedef struct AVB_PORT_LATENCY_REQUEST {
  * Structure size MUST be 24 × 8 = 192 bytes with 8-byte packing.
  * Tests assert sizeof(AVB_DRIVER_STATISTICS) == 192.
  *
+ * IOCTL_AVB_RESET_STATISTICS zeroes the counters.  The three Outstanding*
+ * fields (OutstandingSendNBLs, OutstandingReceiveNBLs, OutstandingOids) are
+ * live gauges - NBLs and OIDs in flight now - and are NOT zeroed by a reset.
+ * This changed with the per-processor counters (REQ-F-STATISTICS-001): a
+ * reset used to zero them too, so a gauge read after a reset with traffic in
+ * flight was the in-flight count minus what was in flight at the reset
+ * (clamped at 0), and drifted back only as those NBLs/OIDs completed.  A tool
+ * that reset and then expected the gauges at 0 must read them as absolute.
+ * IOCTL_AVB_STATS_SNAPSHOT returns the same fields generation-tagged, or
+ * their change since an earlier snapshot.
+ *
  * ABI history:
  *   v1.0 (ABI 0x00010000): 13 fields, 104 bytes — basic traffic + IOCTL counters
  *   v2.0 (ABI 0x00020000): 24 fields, 192 bytes — + lifecycle/datapath coverage fields
@@ -640,20 +664,43 @@ typedef struct AVB_PFC_REQUEST {
  * IOCTLs:
  *   IOCTL_AVB_SRP_REGISTER_STREAM   (60) — reserve bandwidth for a stream
  *   IOCTL_AVB_SRP_DEREGISTER_STREAM (61) — release a stream reservation
+ *   IOCTL_AVB_SRP_ENUM_STREAMS      (70) — page through active reservations
+ *
+ * Reservations are keyed by stream_id (REQ-F-SRP-004).  Registering a
+ * stream_id that is already reserved returns its existing handle; if the
+ * TSpec (class, bandwidth, frame size) changed, the reservation is
+ * re-admitted with the new values or left unchanged when they do not fit.
+ * The per-port number of reservations is bounded (default 512, at most
+ * 4096, settable through IOCTL_AVB_SRP_ENUM_STREAMS).
+ *
+ * Admission (REQ-F-SRP-003): a stream is charged
+ *   ceil(bandwidth_bps / (max_frame_size * 8 * intervals/s))
+ *     * (max_frame_size + 42) * 8 * intervals/s
+ * i.e. whole max-size frames per class interval plus 42 octets of 802.3/VLAN
+ * framing each.  Class A alone, and Class A + B together, may use at most
+ * 75% of the link rate (802.1Q deltaBandwidth; the device's nominal rate
+ * while the link is down).  reserved_bw_bps returns the charged bandwidth.
+ * A request over the limit fails with status
+ * AVB_SRP_STATUS_BANDWIDTH_EXCEEDED (Win32 ERROR_NOT_ENOUGH_QUOTA), distinct
+ * from NDIS_STATUS_RESOURCES (reservation table full).  Every
+ * register/deregister reprograms the class queue's credit-based shaper
+ * (tc 0 = Class A, tc 1 = Class B) on devices that have one.
  *============================================================================*/
 #define SRP_CLASS_A  0u   /* max latency <2ms,  observation interval 125us */
 #define SRP_CLASS_B  1u   /* max latency <50ms, observation interval 250us */
 
+#define AVB_SRP_STATUS_BANDWIDTH_EXCEEDED  0xE0020001u  /* customer-defined error status */
+
 typedef struct AVB_SRP_REGISTER_REQUEST {
     avb_u64 stream_id;          /* in:  IEEE 802.1Qat 64-bit stream identifier */
     avb_u32 bandwidth_bps;      /* in:  required bandwidth in bits per second */
     avb_u16 vlan_id;            /* in:  802.1Q VLAN ID for the stream */
     avb_u8  priority;           /* in:  802.1p PCP (5=SR Class A, 4=SR Class B) */
     avb_u8  latency_class;      /* in:  SRP_CLASS_A or SRP_CLASS_B */
-    avb_u16 max_frame_size;     /* in:  maximum frame size in bytes */
+    avb_u16 max_frame_size;     /* in:  maximum frame size in bytes (1-1500, no framing) */
     avb_u8  reserved[2];        /* padding */
     avb_u32 reservation_handle; /* out: opaque 1-based handle for deregistration */
-    avb_u32 reserved_bw_bps;    /* out: actual bandwidth reserved by driver */
+    avb_u32 reserved_bw_bps;    /* out: wire bandwidth charged incl. per-frame overhead */
     avb_u32 status;             /* out: NDIS_STATUS */
 } AVB_SRP_REGISTER_REQUEST, *PAVB_SRP_REGISTER_REQUEST;
 
@@ -665,6 +712,32 @@ typedef struct AVB_SRP_DEREGISTER_REQUEST {
 #define IOCTL_AVB_SRP_REGISTER_STREAM    _NDIS_CONTROL_CODE(60, METHOD_BUFFERED)
 #define IOCTL_AVB_SRP_DEREGISTER_STREAM  _NDIS_CONTROL_CODE(61, METHOD_BUFFERED)
 
+#define AVB_SRP_ENUM_PAGE  16u   /* entries per IOCTL_AVB_SRP_ENUM_STREAMS call */
+
+typedef struct AVB_SRP_STREAM_ENTRY {
+    avb_u64 stream_id;
+    avb_u32 reservation_handle;
+    avb_u32 bandwidth_bps;      /* requested payload bandwidth */
+    avb_u32 reserved_bw_bps;    /* wire bandwidth charged */
+    avb_u16 max_frame_size;
+    avb_u8  latency_class;      /* SRP_CLASS_A / SRP_CLASS_B */
+    avb_u8  reserved;
+} AVB_SRP_STREAM_ENTRY, *PAVB_SRP_STREAM_ENTRY;
+
+typedef struct AVB_SRP_ENUM_REQUEST {
+    avb_u32 cursor;             /* in:  0 = first page, else next_cursor of the previous call */
+    avb_u32 set_max_streams;    /* in:  nonzero = new per-port bound (active count..4096) */
+    avb_u32 next_cursor;        /* out: pass back for the next page; 0 = enumeration complete */
+    avb_u32 count;              /* out: valid entries[] in this page */
+    avb_u32 active;             /* out: active reservations on the port */
+    avb_u32 max_streams;        /* out: per-port bound in force */
+    avb_u32 status;             /* out: NDIS_STATUS */
+    avb_u32 reserved;
+    AVB_SRP_STREAM_ENTRY entries[AVB_SRP_ENUM_PAGE];
+} AVB_SRP_ENUM_REQUEST, *PAVB_SRP_ENUM_REQUEST;
+
+#define IOCTL_AVB_SRP_ENUM_STREAMS       _NDIS_CONTROL_CODE(70, METHOD_BUFFERED)
+
 /*==============================================================================
  * PHC ↔ System Cross-Timestamp (Issue #48 / REQ-F-IOCTL-PHC-004)
  * IOCTL:
@@ -725,6 +798,980 @@ typedef struct AVB_LAUNCH_TIME_REQUEST {
     avb_u32 status;                  /* out: NDIS_STATUS value */
 } AVB_LAUNCH_TIME_REQUEST, *PAVB_LAUNCH_TIME_REQUEST;
 
+/*==============================================================================
+ * Multi-Adapter PHC Snapshot (REQ-F-IOCTL-PHC-005)
+ * IOCTL:
+ *   IOCTL_AVB_PHC_MULTI_SNAPSHOT (65) — read SYSTIM of every attached adapter
+ *   back to back in one kernel pass (g_AvbContextListLock held, DISPATCH_LEVEL)
+ *   so user-mode can compare PHCs of several ports without per-handle IOCTL
+ *   round-trip skew.
+ *
+ * Each PHC read is bracketed by two KeQueryPerformanceCounter samples:
+ *   qpc_before <= (PHC latch instant) <= qpc_after
+ * The window (qpc_after - qpc_before) bounds the uncertainty of that entry.
+ * Offsets between adapters i and j can then be estimated as
+ *   (phc_i - phc_j) - (mid_i - mid_j) * 1e9 / qpc_frequency
+ * where mid_x = (qpc_before_x + qpc_after_x) / 2.
+ *
+ * Output entries are in g_AvbContextList order; match them to ENUM_ADAPTERS
+ * results by vendor_id/device_id.  Adapters that are not PTP-ready or have no
+ * get_systime op are still listed with valid = 0.
+ *
+ * HAL compliance: PHC read via ops->get_systime() — no register addresses in src/.
+ *============================================================================*/
+#define AVB_PHC_SNAPSHOT_MAX_ADAPTERS  8u
+
+typedef struct AVB_PHC_SNAPSHOT_ENTRY {
+    avb_u16 vendor_id;     /* out: PCI vendor ID                                */
+    avb_u16 device_id;     /* out: PCI device ID                                */
+    avb_u32 valid;         /* out: 1 = phc_time_ns holds a good SYSTIM read     */
+    avb_u64 phc_time_ns;   /* out: PHC time in nanoseconds (ops->get_systime)   */
+    avb_u64 qpc_before;    /* out: QPC tick sampled immediately before the read */
+    avb_u64 qpc_after;     /* out: QPC tick sampled immediately after the read  */
+} AVB_PHC_SNAPSHOT_ENTRY, *PAVB_PHC_SNAPSHOT_ENTRY;
+
+typedef struct AVB_PHC_MULTI_SNAPSHOT_REQUEST {
+    avb_u32 count;         /* out: number of entries filled (<= MAX_ADAPTERS)   */
+    avb_u32 total_adapters;/* out: adapters on the list (may exceed count)      */
+    avb_u64 qpc_frequency; /* out: QPC ticks per second                         */
+    AVB_PHC_SNAPSHOT_ENTRY entries[AVB_PHC_SNAPSHOT_MAX_ADAPTERS];
+    avb_u32 status;        /* out: NDIS_STATUS value                            */
+    avb_u32 reserved;      /* padding — keeps sizeof a multiple of 8            */
+} AVB_PHC_MULTI_SNAPSHOT_REQUEST, *PAVB_PHC_MULTI_SNAPSHOT_REQUEST;
+
+#define IOCTL_AVB_PHC_MULTI_SNAPSHOT     _NDIS_CONTROL_CODE(65, METHOD_BUFFERED)
+
+/*==============================================================================
+ * PHC Drift Estimation and Holdover (REQ-F-PTP-HOLDOVER-001)
+ * IOCTL:
+ *   IOCTL_AVB_PHC_HOLDOVER (66) — query / configure / force holdover
+ *
+ * Every successful IOCTL_AVB_ADJUST_FREQUENCY is fed to a per-adapter
+ * estimator that keeps an EWMA of the requested increment and its variance.
+ * In holdover the driver writes the filtered increment to TIMINCA so the PHC
+ * keeps the frequency the servo last disciplined it to.
+ *
+ * Holdover is entered:
+ *   - on AVB_HOLDOVER_CMD_ENTER (needs >= 8 observed adjustments), or
+ *   - automatically when auto_timeout_ms != 0 and no ADJUST_FREQUENCY arrived
+ *     for that long (driver polls every AVB_HOLDOVER_POLL_MS).
+ * Holdover is left on AVB_HOLDOVER_CMD_EXIT or the next ADJUST_FREQUENCY.
+ *
+ * est_error_ns = est_stddev_ppb * holdover_elapsed_ms / 1000: the time error
+ * a frequency off by one standard deviation accumulates since entry.
+ *
+ * Every command returns the current estimator snapshot.
+ *============================================================================*/
+#define AVB_HOLDOVER_CMD_QUERY       0u  /* snapshot only                           */
+#define AVB_HOLDOVER_CMD_CONFIGURE   1u  /* set auto_timeout_ms (0 = disable)       */
+#define AVB_HOLDOVER_CMD_ENTER       2u  /* force holdover now                      */
+#define AVB_HOLDOVER_CMD_EXIT        3u  /* leave holdover (TIMINCA left as is)     */
+#define AVB_HOLDOVER_CMD_RESET       4u  /* discard estimate, leave holdover        */
+
+#define AVB_HOLDOVER_STATE_FREE_RUN  0u  /* fewer than 8 adjustments observed       */
+#define AVB_HOLDOVER_STATE_LOCKED    1u  /* servo active, estimator tracking        */
+#define AVB_HOLDOVER_STATE_HOLDOVER  2u  /* estimate applied to TIMINCA             */
+
+#define AVB_HOLDOVER_REASON_NONE     0u
+#define AVB_HOLDOVER_REASON_MANUAL   1u  /* AVB_HOLDOVER_CMD_ENTER                  */
+#define AVB_HOLDOVER_REASON_TIMEOUT  2u  /* auto_timeout_ms elapsed                 */
+
+#define AVB_HOLDOVER_POLL_MS         100u
+
+typedef struct AVB_PHC_HOLDOVER_REQUEST {
+    avb_u32 command;              /* in:  AVB_HOLDOVER_CMD_*                           */
+    avb_u32 auto_timeout_ms;      /* in (CONFIGURE) / out: 0 = auto holdover disabled  */
+    avb_u32 state;                /* out: AVB_HOLDOVER_STATE_*                         */
+    avb_u32 reason;               /* out: AVB_HOLDOVER_REASON_*                        */
+    avb_u32 sample_count;         /* out: ADJUST_FREQUENCY calls observed              */
+    avb_u32 applied_timinca;      /* out: TIMINCA written at holdover entry (0 if none)*/
+    avb_u64 est_increment_q32;    /* out: filtered increment, 2^-32 ns per cycle       */
+    avb_u64 est_stddev_q32;       /* out: increment standard deviation, 2^-32 ns       */
+    avb_u64 est_stddev_ppb;       /* out: stddev relative to the mean, ppb             */
+    avb_u64 ms_since_last_adjust; /* out: age of the last ADJUST_FREQUENCY             */
+    avb_u64 holdover_elapsed_ms;  /* out: time in holdover (0 when not in holdover)    */
+    avb_u64 est_error_ns;         /* out: estimated time error accumulated in holdover */
+    avb_u32 status;               /* out: NDIS_STATUS value                            */
+    avb_u32 reserved;             /* padding — keeps sizeof a multiple of 8            */
+} AVB_PHC_HOLDOVER_REQUEST, *PAVB_PHC_HOLDOVER_REQUEST;
+
+#define IOCTL_AVB_PHC_HOLDOVER           _NDIS_CONTROL_CODE(66, METHOD_BUFFERED)
+
+/*==============================================================================
+ * Periodic SDP Output (REQ-F-PTP-PEROUT-001)
+ * IOCTLs:
+ *   IOCTL_AVB_SET_PERIODIC_OUTPUT       (67) — start / stop a PPS or clock on an SDP pin
+ *   IOCTL_AVB_GET_PERIODIC_OUTPUT_STATS (68) — edge counters and measured jitter
+ *
+ * Each channel (0/1) owns TRGTTIMn, FREQOUTn and AUXSTMPn.  While a channel
+ * is running IOCTL_AVB_SET_TARGET_TIME on the same timer index is refused.
+ *
+ * Delivery (mode out):
+ *   AVB_PEROUT_MODE_FREQOUT  - hardware clock-out; 50 % duty and a half period
+ *                              of 8 ns..70 ms or exactly 125/250/500 ms (so
+ *                              1 PPS qualifies).  No driver involvement per edge.
+ *   AVB_PEROUT_MODE_SW_REARM - every edge is a TRGTTIM compare re-armed by a
+ *                              1 ms driver timer.  Arbitrary duty, but high and
+ *                              low time must each be >= 50 ms.  Edges the timer
+ *                              could not re-arm in time are skipped in pairs
+ *                              (polarity kept) and counted in missed_edges.
+ * mode in: 0 = pick FREQOUT when possible, else SW_REARM; or force either.
+ *
+ * start_time_ns is the first rising edge in PHC time; if it is less than
+ * 100 us ahead it is moved forward by whole periods (returned in the request).
+ *
+ * Jitter: wire measure_sdp_pin to sdp_pin externally.  The driver routes it
+ * into AUXSTMPn and folds each capture onto the nearest scheduled edge
+ * (error = capture - edge).  Captures are sampled by the 1 ms timer, so at
+ * high output rates jitter_samples < edges.
+ */
+#define AVB_PEROUT_MODE_NONE         0u  /* out: channel idle / in: automatic     */
+#define AVB_PEROUT_MODE_FREQOUT      1u
+#define AVB_PEROUT_MODE_SW_REARM     2u
+
+#define AVB_PEROUT_NO_MEASURE        0xFFFFFFFFu  /* measure_sdp_pin: no loopback */
+#define AVB_PEROUT_POLL_MS           1u
+
+typedef struct AVB_PERIODIC_OUTPUT_REQUEST {
+    avb_u32 channel;          /* in:  0 or 1 (TRGTTIM/FREQOUT/AUXSTMP index)          */
+    avb_u32 sdp_pin;          /* in:  output pin, SDP0..SDP3                           */
+    avb_u32 enable;           /* in:  1 = (re)start, 0 = stop and release the pins     */
+    avb_u32 measure_sdp_pin;  /* in:  loopback input pin or AVB_PEROUT_NO_MEASURE      */
+    avb_u64 start_time_ns;    /* in/out: first rising edge (PHC), after roll-forward   */
+    avb_u64 period_ns;        /* in:  period                                          */
+    avb_u64 pulse_width_ns;   /* in/out: high time, 0 = 50 % duty                     */
+    avb_u32 mode;             /* in:  AVB_PEROUT_MODE_* (0 = auto) / out: mode chosen  */
+    avb_u32 status;           /* out: NDIS_STATUS value                                */
+} AVB_PERIODIC_OUTPUT_REQUEST, *PAVB_PERIODIC_OUTPUT_REQUEST;
+
+typedef struct AVB_PERIODIC_OUTPUT_STATS_REQUEST {
+    avb_u32 channel;              /* in:  0 or 1                                       */
+    avb_u32 reset;                /* in:  non-zero clears counters after the snapshot  */
+    avb_u32 mode;                 /* out: AVB_PEROUT_MODE_* (NONE = idle)              */
+    avb_u32 sdp_pin;              /* out */
+    avb_u32 measure_sdp_pin;      /* out: AVB_PEROUT_NO_MEASURE if none                */
+    avb_u32 reserved0;
+    avb_u64 start_time_ns;        /* out: configured schedule                          */
+    avb_u64 period_ns;            /* out */
+    avb_u64 pulse_width_ns;       /* out */
+    avb_u64 edges;                /* out: edges emitted since start / reset            */
+    avb_u64 missed_edges;         /* out: SW_REARM edges skipped (late re-arm)         */
+    avb_u64 next_edge_ns;         /* out: next scheduled edge                          */
+    avb_u64 max_rearm_latency_ns; /* out: SW_REARM worst edge -> re-arm delay          */
+    avb_u64 jitter_samples;       /* out: AUX captures folded into the error stats     */
+    avb_i64 last_error_ns;        /* out: capture - nearest edge                       */
+    avb_i64 min_error_ns;         /* out: (0 when jitter_samples == 0)                 */
+    avb_i64 max_error_ns;         /* out */
+    avb_u64 mean_abs_error_ns;    /* out */
+    avb_u32 status;               /* out: NDIS_STATUS value                            */
+    avb_u32 reserved;             /* padding — keeps sizeof a multiple of 8            */
+} AVB_PERIODIC_OUTPUT_STATS_REQUEST, *PAVB_PERIODIC_OUTPUT_STATS_REQUEST;
+
+#define IOCTL_AVB_SET_PERIODIC_OUTPUT        _NDIS_CONTROL_CODE(67, METHOD_BUFFERED)
+#define IOCTL_AVB_GET_PERIODIC_OUTPUT_STATS  _NDIS_CONTROL_CODE(68, METHOD_BUFFERED)
+
+/*==============================================================================
+ * Streamed AUX Capture (REQ-F-PTP-AUXSTREAM-001)
+ * IOCTL: IOCTL_AVB_AUX_CAPTURE (69)
+ *
+ * ENABLE routes sdp_pin (input) into AUXSTMPn and sets EN_TSn.  Every latch is
+ * then posted as a TS_EVENT_AUX_TIMESTAMP record to the adapter's timestamp
+ * subscriptions (field usage above AVB_TS_EVENT_AUX_EDGE).
+ *
+ * AUXSTMPn holds a single capture until the driver reads it; the driver
+ * samples it every AVB_PEROUT_POLL_MS.  Edges arriving faster than that
+ * overwrite nothing - they are simply not latched.  The captures of such a
+ * reference are one poll apart, so its interval cannot be learned from them:
+ * ENABLE takes the nominal edge interval in period_ns.  Once two consecutive
+ * intervals matched a multiple of it, a gap of k intervals is reported as
+ * k-1 lost edges: counted in overruns and carried in the next record.  An
+ * interval off the grid (the reference is not at that rate) drops the lock;
+ * no loss is inferred until two intervals matched again.  With period_ns 0
+ * edges are numbered in arrival order and overruns stays 0.
+ *
+ * A channel used for periodic-output jitter measurement (measure_sdp_pin) is
+ * busy here and vice versa.  QUERY returns counters without side effects.
+ */
+#define AVB_AUX_CAPTURE_CMD_QUERY    0u
+#define AVB_AUX_CAPTURE_CMD_ENABLE   1u  /* (re)start, counters reset */
+#define AVB_AUX_CAPTURE_CMD_DISABLE  2u
+
+typedef struct AVB_AUX_CAPTURE_REQUEST {
+    avb_u32 channel;            /* in:  0 or 1 (AUXSTMP index)                         */
+    avb_u32 sdp_pin;            /* in:  ENABLE input pin SDP0..SDP3 / out: active pin   */
+    avb_u32 command;            /* in:  AVB_AUX_CAPTURE_CMD_*                          */
+    avb_u32 active;             /* out: 1 while capture is streaming                   */
+    avb_u64 edges;              /* out: edges seen since ENABLE, including lost ones   */
+    avb_u64 records;            /* out: TS_EVENT_AUX_TIMESTAMP records produced        */
+    avb_u64 overruns;           /* out: edges inferred lost (edges - records)          */
+    avb_u64 period_ns;          /* in:  ENABLE nominal interval / out: tracked, 0 = not locked */
+    avb_u64 last_timestamp_ns;  /* out: most recent capture                            */
+    avb_u32 status;             /* out: NDIS_STATUS value                              */
+    avb_u32 reserved;           /* padding — keeps sizeof a multiple of 8              */
+} AVB_AUX_CAPTURE_REQUEST, *PAVB_AUX_CAPTURE_REQUEST;
+
+#define IOCTL_AVB_AUX_CAPTURE                _NDIS_CONTROL_CODE(69, METHOD_BUFFERED)
+
+/*==============================================================================
+ * Qbv Schedule Switch State (REQ-F-TAS-003)
+ * IOCTL: IOCTL_AVB_TAS_GET_STATE (71)
+ *
+ * The I225/I226 shadows only the cycle time, not the gate windows, so
+ * IOCTL_AVB_SETUP_TAS on a port that already runs a gate list is not a
+ * seamless switch.  SETUP_TAS only stages the new (admin) list and returns
+ * with state PENDING and the config-change time as the returned base time:
+ * the admin base time rolled forward by whole admin cycles past the next
+ * operational cycle boundary plus the programming lead (1 ms).  The running
+ * (operational) list keeps its gates until the last of its cycle boundaries
+ * that leaves the lead before the config change; a driver timer then stops
+ * it and arms the admin list.  Only from that stop to the config-change time
+ * does no gate list govern the port.  A SETUP_TAS while a list is staged
+ * replaces it; with no list running the new one is armed at once.
+ *
+ * cycles_lost counts operational cycles that did not run: every cycle that
+ * would have started in the gap, the cycle cut at the stop if the timer ran
+ * late, and the extra gap when programming finished after the config-change
+ * time or an armed switch was re-armed for a later one.  A first start loses
+ * nothing.  A schedule the hardware rejected leaves the
+ * state unchanged and sets last_error; a register failure part-way leaves the
+ * gates in an unknown state (ERROR) until the next successful SETUP_TAS.
+ */
+#define AVB_TAS_STATE_IDLE       0u  /* no gate list programmed */
+#define AVB_TAS_STATE_PENDING    1u  /* admin list staged (the operational list still runs) or armed (no list runs) until config_change_time_ns */
+#define AVB_TAS_STATE_ACTIVE     2u  /* operational list running, nothing staged */
+#define AVB_TAS_STATE_ERROR      3u  /* register writes failed (SETUP_TAS or the staged switch) */
+
+typedef struct AVB_TAS_STATE_REQUEST {
+    avb_u64 phc_time_ns;            /* out: PHC when the state was sampled              */
+    avb_u64 config_change_time_ns;  /* out: pending switch, or when the last one happened */
+    avb_u64 oper_base_time_ns;      /* out: operational list (PENDING: running or stopped) */
+    avb_u64 admin_base_time_ns;     /* out: base time requested by the last SETUP_TAS   */
+    avb_u64 config_change_count;    /* out: switches completed, first start included    */
+    avb_u64 cycles_lost;            /* out: cycles lost over all switches               */
+    avb_u32 oper_cycle_time_ns;     /* out: 0 = no operational list                     */
+    avb_u32 admin_cycle_time_ns;    /* out */
+    avb_u32 state;                  /* out: AVB_TAS_STATE_*                             */
+    avb_u32 last_cycles_lost;       /* out: cycles lost by the most recent switch       */
+    avb_u32 last_error;             /* out: NTSTATUS of the last failed SETUP_TAS or switch, 0 = none */
+    avb_u32 status;                 /* out: NDIS_STATUS value                           */
+    avb_u32 reserved[2];            /* padding — keeps sizeof a multiple of 8           */
+} AVB_TAS_STATE_REQUEST, *PAVB_TAS_STATE_REQUEST;
+
+#define IOCTL_AVB_TAS_GET_STATE              _NDIS_CONTROL_CODE(71, METHOD_BUFFERED)
+
+/*==============================================================================
+ * Per-Frame Launch Time (REQ-F-LAUNCH-002)
+ * IOCTL: IOCTL_AVB_LAUNCH_TIME_CONFIG (72)
+ *
+ * A sender sets the absolute PHC launch time of each frame in the NBL itself
+ * (AVB_LAUNCH_TIME_SLOT, see src/filter.h); no IOCTL per frame.  That slot is
+ * MediaSpecificInformation, which other protocols may use for something
+ * else, so the send path only reads it for the 802.1Q priorities set in
+ * pcp_mask (SET; 0, the default, turns launch times off) - enabling a
+ * priority asserts that its senders put launch times there.  The slot is
+ * never modified.
+ *
+ * The miniport builds the TX descriptors and takes no launch time from a
+ * filter, so the software pacer (IOCTL_AVB_LAUNCH_PACER) is the only path
+ * that sends a frame at its launch time.  A frame of the paced priority is
+ * handed to it (accepted); any other frame carrying a launch time - another
+ * priority, the pacer disabled, or the PHC unreadable - is completed with
+ * NDIS_STATUS_NOT_SUPPORTED (no_hw) instead of being sent early.  Enable
+ * launch times only for the priority the pacer paces.
+ *
+ * format and horizon_ns describe the window the adapter's LaunchTime
+ * descriptor field could express, for reference:
+ *
+ *   format I210  launch <= PHC + 0.5 s (field is an offset in the 1 s cycle)
+ *   format IGC   launch before the end of the Qbv cycle after the current one
+ *                (I225/I226; the default cycle is 1 s without a gate list)
+ *
+ * and every format needs launch >= PHC + min_lead_ns.
+ *
+ * QUERY returns the current horizon and counters; SET also sets min_lead_ns
+ * (0 = default 20 us) and pcp_mask.
+ */
+#define AVB_LAUNCH_FMT_NONE      0u  /* no LaunchTime in the TX descriptor */
+#define AVB_LAUNCH_FMT_I210      1u  /* 25-bit, 32 ns units, offset in the 1 s Qav cycle */
+#define AVB_LAUNCH_FMT_IGC       2u  /* 30-bit ns offset from the current Qbv cycle start */
+
+#define AVB_LAUNCH_CMD_QUERY     0u
+#define AVB_LAUNCH_CMD_SET       1u
+
+typedef struct AVB_LAUNCH_TIME_CONFIG_REQUEST {
+    avb_u32 command;            /* in:  AVB_LAUNCH_CMD_*                               */
+    avb_u32 min_lead_ns;        /* in:  SET lead (<= 0.5 s) / out: lead in effect      */
+    avb_u32 format;             /* out: AVB_LAUNCH_FMT_*                               */
+    avb_u32 pcp_mask;           /* in:  SET priorities with launch times / out: in effect */
+    avb_u64 phc_time_ns;        /* out: PHC the horizon was computed at                */
+    avb_u64 horizon_ns;         /* out: latest launch time accepted now, minus PHC     */
+    avb_u64 frames;             /* out: frames that carried a launch time              */
+    avb_u64 accepted;           /* out: handed to the pacer                            */
+    avb_u64 late;               /* out: 0; the send path has no window check           */
+    avb_u64 beyond_horizon;     /* out: 0; the send path has no window check           */
+    avb_u64 no_hw;              /* out: rejected, NDIS_STATUS_NOT_SUPPORTED (not paced) */
+    avb_u32 status;             /* out: NDIS_STATUS value                              */
+    avb_u32 reserved;           /* padding — keeps sizeof a multiple of 8              */
+} AVB_LAUNCH_TIME_CONFIG_REQUEST, *PAVB_LAUNCH_TIME_CONFIG_REQUEST;
+
+#define IOCTL_AVB_LAUNCH_TIME_CONFIG         _NDIS_CONTROL_CODE(72, METHOD_BUFFERED)
+
+/*==============================================================================
+ * Software Launch-Time Pacing (REQ-F-LAUNCH-003)
+ * IOCTL: IOCTL_AVB_LAUNCH_PACER (73)
+ *
+ * Works on every adapter; it is the only path that sends a frame at its
+ * launch time (see IOCTL_AVB_LAUNCH_TIME_CONFIG).  While enabled, frames
+ * whose 802.1p priority (NBL 802.1Q OOB info) equals traffic_class and that
+ * carry AVB_LAUNCH_TIME_SLOT (read only for the priorities in
+ * IOCTL_AVB_LAUNCH_TIME_CONFIG's pcp_mask) are held in a
+ * per-adapter queue ordered by launch time and handed to the miniport from a
+ * high-resolution timer when the PHC reaches launch - early_ns.  A frame more
+ * than max_hold_ns ahead, or arriving with queue_limit frames held, is
+ * completed with NDIS_STATUS_INVALID_PARAMETER / NDIS_STATUS_RESOURCES.
+ *
+ * error_* describe "PHC at hand-down - launch time" (negative = early) over the
+ * frames released since ENABLE / RESET_STATS; error_hist[k] counts |error| in
+ * [2^(k-1), 2^k) us (bucket 0: < 1 us, bucket 15: >= 16.384 ms).  The timer
+ * granularity (~0.5 ms) dominates the error; the miniport's own queuing comes
+ * on top and is not measured.
+ *
+ * DISABLE sends the held frames at once; a filter pause completes them with
+ * NDIS_STATUS_PAUSED and stops the pacer (re-enable after restart).
+ */
+#define AVB_PACER_CMD_QUERY          0u
+#define AVB_PACER_CMD_ENABLE         1u
+#define AVB_PACER_CMD_DISABLE        2u
+#define AVB_PACER_CMD_RESET_STATS    3u
+
+#define AVB_PACER_QUEUE_DEFAULT      256u
+#define AVB_PACER_QUEUE_MAX          4096u
+#define AVB_PACER_HOLD_DEFAULT_NS    1000000000ull  /* 1 s */
+#define AVB_PACER_ERROR_BUCKETS      16u
+
+typedef struct AVB_LAUNCH_PACER_REQUEST {
+    avb_u32 command;            /* in:  AVB_PACER_CMD_*                                */
+    avb_u32 traffic_class;      /* in:  ENABLE, 802.1p priority 0-7 / out: in effect   */
+    avb_u32 queue_limit;        /* in:  ENABLE, 0 = 256, <= 4096 / out: in effect      */
+    avb_u32 early_ns;           /* in:  ENABLE, release this much ahead / out          */
+    avb_u64 max_hold_ns;        /* in:  ENABLE, 0 = 1 s / out: in effect               */
+    avb_u32 active;             /* out: 1 while pacing                                 */
+    avb_u32 queued;             /* out: frames held now                                */
+    avb_u32 max_queued;         /* out: high-water mark                                */
+    avb_u32 reserved0;
+    avb_u64 held;               /* out: frames queued                                  */
+    avb_u64 released;           /* out: frames handed down at their launch time        */
+    avb_u64 dropped_full;       /* out: completed with NDIS_STATUS_RESOURCES           */
+    avb_u64 dropped_horizon;    /* out: completed with NDIS_STATUS_INVALID_PARAMETER   */
+    avb_u64 flushed;            /* out: sent or completed early by DISABLE / pause     */
+    avb_i64 error_min_ns;       /* out: valid when released != 0                       */
+    avb_i64 error_max_ns;       /* out */
+    avb_u64 error_mean_abs_ns;  /* out: mean |error|                                   */
+    avb_u64 error_hist[AVB_PACER_ERROR_BUCKETS]; /* out: log2 |error| buckets          */
+    avb_u32 status;             /* out: NDIS_STATUS value                              */
+    avb_u32 reserved;           /* padding — keeps sizeof a multiple of 8              */
+} AVB_LAUNCH_PACER_REQUEST, *PAVB_LAUNCH_PACER_REQUEST;
+
+#define IOCTL_AVB_LAUNCH_PACER               _NDIS_CONTROL_CODE(73, METHOD_BUFFERED)
+
+/*==============================================================================
+ * Frame Preemption Statistics (REQ-F-FP-002)
+ * IOCTL: IOCTL_AVB_GET_FP_STATS (74)
+ *
+ * IEEE 802.3br MAC merge counters of the I225/I226 after IOCTL_AVB_SETUP_FP.
+ * Each call reads the clear-on-read hardware counters once (6 MMIO reads, no
+ * polling) into 64-bit per-adapter totals and returns both the totals and the
+ * counts since the previous DELTA call, over interval_ns (interrupt time).
+ * SETUP_FP also samples before reprogramming, so counts are not lost across
+ * a reconfiguration.
+ *
+ *   tx_fragments / rx_fragments  additional fragments caused by preemption
+ *   tx_holds                     preemptible frames interrupted at least once
+ *                                (one pMAC hold / release each)
+ *   rx_assembly_ok / _errors     reassembly results (errors: out-of-order
+ *                                fragment or frame)
+ *   rx_smd_errors                unknown / unexpected SMD
+ *
+ * verify_status is inferred - the MAC keeps no verify state: SUCCEEDED once
+ * fragments were sent since preemption was enabled, VERIFYING before that.
+ * saturated counts samples in which an 8-bit exception counter had stopped
+ * at 255; sample more often if it is non-zero.
+ */
+#define AVB_FP_STATS_CMD_DELTA       0u  /* sample; delta since the last DELTA, then move the baseline */
+#define AVB_FP_STATS_CMD_PEEK        1u  /* sample; delta since the last DELTA, baseline kept */
+#define AVB_FP_STATS_CMD_RESET       2u  /* sample and discard; totals and baseline to zero */
+
+#define AVB_FP_VERIFY_UNKNOWN        0u
+#define AVB_FP_VERIFY_VERIFYING      2u
+#define AVB_FP_VERIFY_SUCCEEDED      3u
+#define AVB_FP_VERIFY_DISABLED       5u  /* verification turned off by SETUP_FP */
+#define AVB_FP_VERIFY_OFF            6u  /* preemption not enabled */
+
+typedef struct AVB_FP_STATS_REQUEST {
+    avb_u32 command;                /* in:  AVB_FP_STATS_CMD_*                          */
+    avb_u32 verify_status;          /* out: AVB_FP_VERIFY_*                             */
+    avb_u32 fp_enabled;             /* out: 1 if preemption is enabled                  */
+    avb_u32 reserved0;
+    avb_u64 interval_ns;            /* out: time covered by the delta                   */
+    avb_u64 samples;                /* out: hardware reads since reset                  */
+    avb_u64 saturated;              /* out: reads with an exception counter at 255      */
+    avb_u64 tx_fragments;           /* out: delta */
+    avb_u64 rx_fragments;           /* out: delta */
+    avb_u64 tx_holds;               /* out: delta */
+    avb_u64 rx_assembly_ok;         /* out: delta */
+    avb_u64 rx_assembly_errors;     /* out: delta */
+    avb_u64 rx_smd_errors;          /* out: delta */
+    avb_u64 total_tx_fragments;     /* out: since reset */
+    avb_u64 total_rx_fragments;
+    avb_u64 total_tx_holds;
+    avb_u64 total_rx_assembly_ok;
+    avb_u64 total_rx_assembly_errors;
+    avb_u64 total_rx_smd_errors;
+    avb_u32 status;                 /* out: NDIS_STATUS value                           */
+    avb_u32 reserved;               /* padding — keeps sizeof a multiple of 8           */
+} AVB_FP_STATS_REQUEST, *PAVB_FP_STATS_REQUEST;
+
+#define IOCTL_AVB_GET_FP_STATS               _NDIS_CONTROL_CODE(74, METHOD_BUFFERED)
+
+/*==============================================================================
+ * Latency Histograms (REQ-F-STATISTICS-002)
+ * IOCTL: IOCTL_AVB_GET_LAT_HIST (75)
+ *
+ * Always-on log-linear latency histograms of the adapter's hot paths and of
+ * IOCTL dispatch (src/lat_hist.h).  Bucket i covers [low(i), high(i)) ns:
+ *
+ *   i <  64         exactly i ns
+ *   i >= 64         octave o = (i - 64) / 32, sub-bucket s = (i - 64) % 32:
+ *                   low = (32 + s) << (o + 1), width 1 << (o + 1)
+ *
+ * i.e. 32 sub-buckets per power of two, at most 3.1 % wide, 1 ns to 17 s;
+ * the last bucket also holds anything longer.  tools/lat_hist/lat_decode
+ * prints percentiles from a reply (live, or saved with --save).
+ *
+ * The hot-path histograms are summed over the per-processor copies.
+ * AVB_LAT_HIST_IOCTL selects the histogram of one IOCTL code (ioctl_code);
+ * every reply lists the codes that have one.  AVB_LAT_HIST_TX_RESIDENCE
+ * selects the send -> send-complete histogram of one 802.1Q priority
+ * (ioctl_code 0..7), filled while IOCTL_AVB_TX_RESIDENCE sampling is on;
+ * it is empty until sampling was first configured.  RESET zeroes the histogram
+ * while reading it, bucket by bucket, so a sample recorded meanwhile lands
+ * either in this reply or in the next - never in neither.
+ */
+#define AVB_LAT_HIST_RX_CLASSIFY     0u  /* PTP event frame classified -> RX timestamp event posted */
+#define AVB_LAT_HIST_TX_TS_POST      1u  /* TX timestamp read from the FIFO -> event posted */
+#define AVB_LAT_HIST_DPC             2u  /* TX timestamp poll DPC, whole run */
+#define AVB_LAT_HIST_MMIO_READ       3u  /* one BAR0 register read */
+#define AVB_LAT_HIST_IOCTL           4u  /* AvbHandleDeviceIoControl, one IOCTL code */
+#define AVB_LAT_HIST_TX_RESIDENCE    5u  /* sampled frame to miniport -> send-complete, one priority */
+
+#define AVB_LAT_HIST_FLAG_RESET      0x1u /* zero the histogram as it is read */
+
+#define AVB_LAT_HIST_BUCKETS         960u
+#define AVB_LAT_HIST_SUB_BITS        5u
+#define AVB_LAT_HIST_MAX_IOCTLS      32u
+
+typedef struct AVB_LAT_HIST_REQUEST {
+    avb_u32 hist;                   /* in:  AVB_LAT_HIST_*                              */
+    avb_u32 ioctl_code;             /* in:  IOCTL code, or priority for TX_RESIDENCE    */
+    avb_u32 flags;                  /* in:  AVB_LAT_HIST_FLAG_*                         */
+    avb_u32 sub_bucket_bits;        /* out: AVB_LAT_HIST_SUB_BITS                       */
+    avb_u32 bucket_count;           /* out: AVB_LAT_HIST_BUCKETS                        */
+    avb_u32 ioctl_code_count;       /* out: valid entries of ioctl_codes                */
+    avb_u32 ioctl_codes[AVB_LAT_HIST_MAX_IOCTLS]; /* out: codes with a histogram       */
+    avb_u64 total;                  /* out: samples in counts                           */
+    avb_u64 counts[AVB_LAT_HIST_BUCKETS]; /* out: samples per bucket                   */
+    avb_u32 status;                 /* out: NDIS_STATUS value                           */
+    avb_u32 reserved;               /* padding — keeps sizeof a multiple of 8           */
+} AVB_LAT_HIST_REQUEST, *PAVB_LAT_HIST_REQUEST;
+
+#define IOCTL_AVB_GET_LAT_HIST               _NDIS_CONTROL_CODE(75, METHOD_BUFFERED)
+
+/*==============================================================================
+ * Binary Datapath Trace (REQ-NF-DIAG-TRACE-001)
+ * IOCTL: IOCTL_AVB_TRACE (76)
+ *
+ * Per-processor rings of fixed 48-byte records written by trace points in
+ * the receive and send paths, timestamp event posting, the TX timestamp
+ * poll DPC and IOCTL dispatch (src/trace_ring.h).  Nothing is formatted
+ * in the driver; tools/avb_trace/avb_trace decodes the records to text or
+ * Chrome-trace JSON.
+ *
+ *   STATUS  report the state below, change nothing.
+ *   ENABLE  switch on the categories given (0 switches tracing off).  The
+ *           first ENABLE allocates records_per_cpu records per processor
+ *           (0 = default); later ones keep the size.  Enabling from off
+ *           discards records left from the previous session.
+ *   DRAIN   copy as many completed records as fit after the request into
+ *           the output buffer (at most 4096 per call), oldest first per
+ *           processor; record_count says how many.  lost counts records overwritten before they
+ *           were drained since the last ENABLE.
+ *
+ * ticks are AVB_LAT_TICKS() (TSC on x86/x64, QPC elsewhere); tick_hz
+ * converts them.  Records from different processors are ordered by ticks.
+ */
+#define AVB_TRACE_CMD_STATUS         0u
+#define AVB_TRACE_CMD_ENABLE         1u
+#define AVB_TRACE_CMD_DRAIN          2u
+
+#define AVB_TRACE_CAT_RX             0x01u /* receive indications, PTP event frames */
+#define AVB_TRACE_CAT_TX             0x02u /* send chains, TX timestamp FIFO entries */
+#define AVB_TRACE_CAT_EVENT          0x04u /* timestamp events posted to subscribers */
+#define AVB_TRACE_CAT_POLL           0x08u /* TX timestamp poll DPC, target time */
+#define AVB_TRACE_CAT_IOCTL          0x10u /* IOCTL dispatch */
+#define AVB_TRACE_CAT_ALL            0x1Fu
+
+typedef struct AVB_TRACE_RECORD {
+    avb_u64 seq;                    /* position in its processor's ring, + 1            */
+    avb_u64 ticks;                  /* AVB_LAT_TICKS() at the trace point               */
+    avb_u16 id;                     /* event id; category = 1 << (id >> 8)              */
+    avb_u16 cpu;                    /* processor (ring) index                           */
+    avb_u32 arg32;
+    avb_u64 arg[3];
+} AVB_TRACE_RECORD, *PAVB_TRACE_RECORD;
+
+typedef struct AVB_TRACE_REQUEST {
+    avb_u32 command;                /* in:  AVB_TRACE_CMD_*                             */
+    avb_u32 categories;             /* in:  ENABLE; out: AVB_TRACE_CAT_* enabled        */
+    avb_u32 records_per_cpu;        /* in:  first ENABLE; out: ring size                */
+    avb_u32 rings;                  /* out: per-processor rings (0 = never enabled)     */
+    avb_u32 record_count;           /* out: DRAIN - records after this header           */
+    avb_u32 record_size;            /* out: sizeof(AVB_TRACE_RECORD)                    */
+    avb_u64 tick_hz;                /* out: ticks per second                            */
+    avb_u64 lost;                   /* out: records overwritten before draining         */
+    avb_u32 status;                 /* out: NDIS_STATUS value                           */
+    avb_u32 reserved;               /* padding — keeps sizeof a multiple of 8           */
+    /* DRAIN: AVB_TRACE_RECORD records[record_count] follow */
+} AVB_TRACE_REQUEST, *PAVB_TRACE_REQUEST;
+
+#define IOCTL_AVB_TRACE                      _NDIS_CONTROL_CODE(76, METHOD_BUFFERED)
+
+/*==============================================================================
+ * Statistics Snapshots (REQ-F-STATISTICS-003)
+ * IOCTL: IOCTL_AVB_STATS_SNAPSHOT (77)
+ *
+ * The counters of AVB_DRIVER_STATISTICS taken in one pass over the
+ * per-processor slots (at DISPATCH_LEVEL, serialised with RESET), tagged
+ * with a generation number and the QPC time of the pass.
+ *
+ *   ABSOLUTE  counters since the last IOCTL_AVB_RESET_STATISTICS, as GET
+ *             returns them; reset_count tells a reset in between apart.
+ *   DELTA     counters changed since the snapshot base_generation (an
+ *             earlier reply's generation), over interval_ns.  Nothing is
+ *             reset and RESET does not disturb deltas, so several monitors
+ *             can each keep their own base.  The driver remembers the last
+ *             32 snapshots; an older base sets BASE_MISSING and the reply
+ *             falls back to ABSOLUTE.
+ *
+ * Gauges (Outstanding*) are always the live value.  ALL_ADAPTERS sums every
+ * bound adapter; its generations are separate from the per-adapter ones,
+ * and ADAPTERS_CHANGED marks a delta across an adapter coming or going.
+ */
+#define AVB_STATS_SNAP_ABSOLUTE             0u
+#define AVB_STATS_SNAP_DELTA                1u
+
+#define AVB_STATS_SNAP_ALL_ADAPTERS         0x1u /* flags: sum every adapter */
+
+#define AVB_STATS_SNAP_BASE_MISSING         0x1u /* result_flags: base_generation no longer held */
+#define AVB_STATS_SNAP_ADAPTERS_CHANGED     0x2u /* result_flags: adapter set differs from the base's */
+
+typedef struct AVB_STATS_SNAPSHOT_REQUEST {
+    avb_u32 mode;                   /* in:  AVB_STATS_SNAP_ABSOLUTE / _DELTA            */
+    avb_u32 flags;                  /* in:  AVB_STATS_SNAP_ALL_ADAPTERS                 */
+    avb_u64 base_generation;        /* in:  DELTA - generation of an earlier reply      */
+    avb_u64 generation;             /* out: this snapshot                               */
+    avb_u64 time_ns;                /* out: QPC time of the pass, ns                    */
+    avb_u64 window_ns;              /* out: duration of the pass                        */
+    avb_u64 interval_ns;            /* out: DELTA - time since the base snapshot        */
+    avb_u32 reset_count;            /* out: RESET_STATISTICS calls so far               */
+    avb_u32 adapter_count;          /* out: adapters summed                             */
+    avb_u32 result_flags;           /* out: AVB_STATS_SNAP_BASE_MISSING | ...           */
+    avb_u32 reserved0;
+    AVB_DRIVER_STATISTICS stats;    /* out: counters (ABSOLUTE) or their change (DELTA) */
+    avb_u32 status;                 /* out: NDIS_STATUS value                           */
+    avb_u32 reserved;               /* padding — keeps sizeof a multiple of 8           */
+} AVB_STATS_SNAPSHOT_REQUEST, *PAVB_STATS_SNAPSHOT_REQUEST;
+
+#define IOCTL_AVB_STATS_SNAPSHOT             _NDIS_CONTROL_CODE(77, METHOD_BUFFERED)
+
+/*==============================================================================
+ * NIC Hardware Statistics (REQ-F-STATISTICS-004)
+ * IOCTL: IOCTL_AVB_HW_STATS (78)
+ *
+ * An optional per-adapter sampler reads the MAC statistics registers
+ * (CRC / alignment errors, missed packets, RNBC, per-queue drops, LPI and
+ * flow-control counters, good / total packets and octets) every
+ * interval_ms.  The registers clear on read; the driver adds each read to
+ * 64-bit totals that only ever grow, and publishes them on one page:
+ *
+ *   START   start sampling, or change the interval (interval_ms, 0 = 1000)
+ *           and the counters taken (counter_mask); takes effect only if
+ *           the first sample succeeds, otherwise a running sampler keeps
+ *           its interval and counters
+ *   STOP    stop sampling; the totals stay on the page
+ *   SAMPLE  sample now (also while stopped) and publish; sets counter_mask
+ *   MAP     map the page read-only into the calling process; page_address
+ *           is valid until UNMAP or until the handle is closed
+ *   UNMAP   undo MAP (page_address in)
+ *   QUERY   interval, samples, counters present
+ *
+ * Reading the page takes no IOCTL and no MMIO.  It is a seqlock: read seq,
+ * retry while it is odd, copy the page, and keep the copy only if seq is
+ * unchanged (devices/intel_hw_stats.h: intel_hw_stats_page_read).  Rates
+ * are differences of two copies over their sample_time_ns, which is
+ * interrupt time in ns (QueryInterruptTime() * 100 in user mode).
+ *
+ * The miniport owns these registers.  It reads the whole block for its own
+ * statistics (OID_GEN_STATISTICS), and a clear-on-read register gives each
+ * count to whichever reader comes first: every counter the sampler reads
+ * goes missing from the miniport's statistics, and what the miniport reads
+ * goes missing from the totals.  The sampler therefore reads a
+ * clear-on-read counter only if START / SAMPLE set its bit in counter_mask
+ * (none by default); use it for runs where the miniport's numbers do not
+ * matter.  RQDPC on the I210 / I225 / I226 clears only on a write and is
+ * always read - without the write, so the miniport's count stays intact;
+ * the totals miss at most what arrived between the last sample and the
+ * miniport's clear.  counter_mask returns the counters read.
+ *
+ * Counters the MAC lacks are absent from present_mask and stay 0.
+ * IOCTL_AVB_READ_REGISTER on them takes counts away from both.
+ */
+#define AVB_HW_STATS_CMD_QUERY              0u
+#define AVB_HW_STATS_CMD_START              1u
+#define AVB_HW_STATS_CMD_STOP               2u
+#define AVB_HW_STATS_CMD_SAMPLE             3u
+#define AVB_HW_STATS_CMD_MAP                4u
+#define AVB_HW_STATS_CMD_UNMAP              5u
+
+#define AVB_HW_STATS_INTERVAL_DEFAULT_MS    1000u
+#define AVB_HW_STATS_INTERVAL_MIN_MS        10u
+#define AVB_HW_STATS_INTERVAL_MAX_MS        60000u
+#define AVB_HW_STATS_MAX_MAPS               8u      /* mappings per adapter */
+#define AVB_HW_STATS_PAGE_VERSION           1u
+
+/* Counter index in AVB_HW_STATS_PAGE.counters (bit n of present_mask) */
+#define AVB_HW_STAT_CRC_ERRORS              0u   /* CRCERRS */
+#define AVB_HW_STAT_ALIGN_ERRORS            1u   /* ALGNERRC */
+#define AVB_HW_STAT_RX_ERRORS               2u   /* RXERRC */
+#define AVB_HW_STAT_MISSED_PACKETS          3u   /* MPC */
+#define AVB_HW_STAT_SINGLE_COLLISIONS       4u   /* SCC */
+#define AVB_HW_STAT_EXCESS_COLLISIONS       5u   /* ECOL */
+#define AVB_HW_STAT_MULTI_COLLISIONS        6u   /* MCC */
+#define AVB_HW_STAT_LATE_COLLISIONS         7u   /* LATECOL */
+#define AVB_HW_STAT_COLLISIONS              8u   /* COLC */
+#define AVB_HW_STAT_DEFERRED                9u   /* DC */
+#define AVB_HW_STAT_TX_NO_CRS               10u  /* TNCRS */
+#define AVB_HW_STAT_RX_LENGTH_ERRORS        11u  /* RLEC */
+#define AVB_HW_STAT_XON_RX                  12u  /* XONRXC */
+#define AVB_HW_STAT_XON_TX                  13u  /* XONTXC */
+#define AVB_HW_STAT_XOFF_RX                 14u  /* XOFFRXC */
+#define AVB_HW_STAT_XOFF_TX                 15u  /* XOFFTXC */
+#define AVB_HW_STAT_FC_UNSUPPORTED          16u  /* FCRUC */
+#define AVB_HW_STAT_GOOD_RX_PACKETS         17u  /* GPRC */
+#define AVB_HW_STAT_BCAST_RX_PACKETS        18u  /* BPRC */
+#define AVB_HW_STAT_MCAST_RX_PACKETS        19u  /* MPRC */
+#define AVB_HW_STAT_GOOD_TX_PACKETS         20u  /* GPTC */
+#define AVB_HW_STAT_GOOD_RX_OCTETS          21u  /* GORC */
+#define AVB_HW_STAT_GOOD_TX_OCTETS          22u  /* GOTC */
+#define AVB_HW_STAT_RX_NO_BUFFERS           23u  /* RNBC */
+#define AVB_HW_STAT_RX_UNDERSIZE            24u  /* RUC */
+#define AVB_HW_STAT_RX_FRAGMENTS            25u  /* RFC */
+#define AVB_HW_STAT_RX_OVERSIZE             26u  /* ROC */
+#define AVB_HW_STAT_RX_JABBER               27u  /* RJC */
+#define AVB_HW_STAT_TOTAL_RX_OCTETS         28u  /* TOR */
+#define AVB_HW_STAT_TOTAL_TX_OCTETS         29u  /* TOT */
+#define AVB_HW_STAT_TOTAL_RX_PACKETS        30u  /* TPR */
+#define AVB_HW_STAT_TOTAL_TX_PACKETS        31u  /* TPT */
+#define AVB_HW_STAT_MCAST_TX_PACKETS        32u  /* MPTC */
+#define AVB_HW_STAT_BCAST_TX_PACKETS        33u  /* BPTC */
+#define AVB_HW_STAT_RX_LPI                  34u  /* RLPIC */
+#define AVB_HW_STAT_TX_LPI                  35u  /* TLPIC */
+#define AVB_HW_STAT_RX_QUEUE_DROPS_0        36u  /* RQDPC(0) */
+#define AVB_HW_STAT_RX_QUEUE_DROPS_1        37u  /* RQDPC(1) */
+#define AVB_HW_STAT_RX_QUEUE_DROPS_2        38u  /* RQDPC(2) */
+#define AVB_HW_STAT_RX_QUEUE_DROPS_3        39u  /* RQDPC(3) */
+#define AVB_HW_STAT_COUNT                   40u
+
+typedef struct AVB_HW_STATS_PAGE {
+    volatile avb_u32 seq;           /* odd while the driver updates the page            */
+    avb_u32 version;                /* AVB_HW_STATS_PAGE_VERSION                        */
+    avb_u32 counter_count;          /* AVB_HW_STAT_COUNT                                */
+    avb_u32 interval_ms;            /* sampling interval, 0 = stopped                   */
+    avb_u64 present_mask;           /* counters this MAC has                            */
+    avb_u64 samples;                /* samples taken                                    */
+    avb_u64 sample_time_ns;         /* interrupt time of the last sample, ns            */
+    avb_u64 read_errors;            /* samples cut short by a failed register read      */
+    avb_u64 reserved[2];
+    avb_u64 counters[AVB_HW_STAT_COUNT];  /* 64-bit totals since the adapter came up   */
+} AVB_HW_STATS_PAGE, *PAVB_HW_STATS_PAGE;
+
+typedef struct AVB_HW_STATS_REQUEST {
+    avb_u32 command;                /* in:  AVB_HW_STATS_CMD_*                          */
+    avb_u32 interval_ms;            /* in:  START; out: current interval, 0 = stopped   */
+    avb_u64 page_address;           /* out: MAP - page in this process; in: UNMAP       */
+    avb_u64 present_mask;           /* out: counters this MAC has                       */
+    avb_u64 samples;                /* out: samples taken                               */
+    avb_u64 read_errors;            /* out: samples cut short by a failed register read */
+    avb_u64 counter_mask;           /* in:  START / SAMPLE counters taken / out: read   */
+    avb_u32 page_size;              /* out: sizeof(AVB_HW_STATS_PAGE)                   */
+    avb_u32 counter_count;          /* out: AVB_HW_STAT_COUNT                           */
+    avb_u32 status;                 /* out: NDIS_STATUS value                           */
+    avb_u32 reserved;               /* padding — keeps sizeof a multiple of 8           */
+} AVB_HW_STATS_REQUEST, *PAVB_HW_STATS_REQUEST;
+
+#define IOCTL_AVB_HW_STATS                   _NDIS_CONTROL_CODE(78, METHOD_BUFFERED)
+
+/*==============================================================================
+ * MMIO Access Accounting (REQ-NF-DIAG-MMIO-001)
+ * IOCTL: IOCTL_AVB_MMIO_ACCT (79)
+ *
+ * BAR0 register reads and writes and the clock ticks spent in them, per
+ * register block and per calling subsystem, summed over the processors
+ * (src/mmio_acct.h).  Ticks cover the register access itself: a read is the
+ * PCIe round trip, a write only its posting.
+ *
+ * Only drivers built with AVB_MMIO_ACCT=1 (msbuild /p:AvbMmioAcct=1)
+ * count; otherwise the IOCTL fails with STATUS_NOT_SUPPORTED and the
+ * register access paths carry no accounting code at all.  RESET zeroes the
+ * counts while reading them, cell by cell, so an access counted meanwhile
+ * lands either in this reply or in the next.
+ *
+ * Callers: PASSIVE is everything below DISPATCH_LEVEL (IOCTL dispatch,
+ * bring-up); OTHER is DISPATCH_LEVEL code that does not name itself
+ * (datapath, spinlock-held IOCTL paths); the rest are the driver's DPCs
+ * and timer callbacks.  tools/avb_mmio/avb_mmio prints the table.
+ */
+#define AVB_MMIO_ACCT_FLAG_RESET     0x1u /* zero the counts as they are read */
+
+#define AVB_MMIO_ACCT_READ           0u   /* first index of count / ticks */
+#define AVB_MMIO_ACCT_WRITE          1u
+
+#define AVB_MMIO_ACCT_BLOCK_MAC      0u   /* all other registers */
+#define AVB_MMIO_ACCT_BLOCK_PTP      1u   /* 0x0B600-0x0B7FF, I225/I226 SYSTIM read 0x0C0C8 */
+#define AVB_MMIO_ACCT_BLOCK_TSN      2u   /* 0x03000-0x035FF Qav / Qbv / launch time */
+#define AVB_MMIO_ACCT_BLOCK_STATS    3u   /* 0x04000-0x04FFF, RQDPC(n) */
+#define AVB_MMIO_ACCT_BLOCKS         4u
+
+#define AVB_MMIO_ACCT_CALLER_OTHER       0u  /* DISPATCH_LEVEL, untagged */
+#define AVB_MMIO_ACCT_CALLER_PASSIVE     1u  /* IOCTL dispatch, bring-up */
+#define AVB_MMIO_ACCT_CALLER_TX_POLL     2u  /* TX timestamp poll DPC */
+#define AVB_MMIO_ACCT_CALLER_TARGET_TIME 3u  /* target time check in the poll DPC */
+#define AVB_MMIO_ACCT_CALLER_TT_DPC      4u  /* I226 target time DPC */
+#define AVB_MMIO_ACCT_CALLER_HOLDOVER    5u  /* PHC holdover watchdog */
+#define AVB_MMIO_ACCT_CALLER_PEROUT      6u  /* periodic output / AUX capture poll */
+#define AVB_MMIO_ACCT_CALLER_PACER       7u  /* launch-time pacer timer */
+#define AVB_MMIO_ACCT_CALLER_HW_STATS    8u  /* NIC statistics sampler */
+#define AVB_MMIO_ACCT_CALLERS            9u
+
+typedef struct AVB_MMIO_ACCT_REQUEST {
+    avb_u32 flags;                  /* in:  AVB_MMIO_ACCT_FLAG_*                        */
+    avb_u32 slots;                  /* out: processor slots summed                      */
+    avb_u64 tick_hz;                /* out: rate of ticks                               */
+    avb_u64 count[2][AVB_MMIO_ACCT_CALLERS][AVB_MMIO_ACCT_BLOCKS]; /* out: accesses     */
+    avb_u64 ticks[2][AVB_MMIO_ACCT_CALLERS][AVB_MMIO_ACCT_BLOCKS]; /* out: time in them */
+    avb_u32 status;                 /* out: NDIS_STATUS value                           */
+    avb_u32 reserved;               /* padding — keeps sizeof a multiple of 8           */
+} AVB_MMIO_ACCT_REQUEST, *PAVB_MMIO_ACCT_REQUEST;
+
+#define IOCTL_AVB_MMIO_ACCT                  _NDIS_CONTROL_CODE(79, METHOD_BUFFERED)
+
+/*==============================================================================
+ * SEND_PTP Slot Pool (REQ-NF-PERF-TXPOOL-001)
+ * IOCTL: IOCTL_AVB_TEST_POOL (80)
+ *
+ * IOCTL_AVB_TEST_SEND_PTP sends from pre-built NBL slots.  minimum slots are
+ * built when the adapter attaches; when every built slot is in flight the
+ * pool builds another, up to limit, and slots beyond minimum are freed after
+ * a second without sends.  A send that finds limit slots in flight (or
+ * cannot build one) fails with NDIS_STATUS_RESOURCES and counts in
+ * exhausted.  Counters run from attach.
+ *
+ * GET reads the pool.  SET_LIMITS changes limit (1..capacity) and minimum
+ * (clamped to limit); slots above a lowered limit are freed as they come
+ * back, and a raised minimum is reached through growth, not built at once.
+ */
+#define AVB_TEST_POOL_CMD_GET        0u
+#define AVB_TEST_POOL_CMD_SET_LIMITS 1u
+
+typedef struct AVB_TEST_POOL_REQUEST {
+    avb_u32 command;                /* in:  AVB_TEST_POOL_CMD_*                         */
+    avb_u32 limit;                  /* in (SET_LIMITS) / out: growth bound              */
+    avb_u32 minimum;                /* in (SET_LIMITS) / out: kept built when idle      */
+    avb_u32 capacity;               /* out: slots there is storage for                  */
+    avb_u32 built;                  /* out: slots holding an NBL now                    */
+    avb_u32 in_flight;              /* out: sent, not yet completed                     */
+    avb_u32 peak_in_flight;         /* out: highest in_flight since attach              */
+    avb_u32 reserved0;
+    avb_u64 acquired;               /* out: sends that got a slot                       */
+    avb_u64 grown;                  /* out: of those, on a slot built for them          */
+    avb_u64 trimmed;                /* out: slots freed while idle or over the limit    */
+    avb_u64 exhausted;              /* out: sends refused for want of a slot            */
+    avb_u64 build_failures;         /* out: of those, because an allocation failed      */
+    avb_u32 status;                 /* out: NDIS_STATUS value                           */
+    avb_u32 reserved;               /* padding — keeps sizeof a multiple of 8           */
+} AVB_TEST_POOL_REQUEST, *PAVB_TEST_POOL_REQUEST;
+
+#define IOCTL_AVB_TEST_POOL                  _NDIS_CONTROL_CODE(80, METHOD_BUFFERED)
+
+/*==============================================================================
+ * Kernel Packet Generator (REQ-NF-TEST-PKTGEN-001)
+ * IOCTL: IOCTL_AVB_PKTGEN (81)
+ *
+ * START sends count frames (0: until STOP) from the driver's own timer, so
+ * load tests measure the datapath rather than one IOCTL per frame.  Every
+ * frame is built from the template: dst_mac, the adapter's source address,
+ * ethertype, then payload_len template bytes, zero-padded to frame_size
+ * (without FCS).  With AVB_PKTGEN_FLAG_VLAN the miniport inserts an 802.1Q
+ * tag of vlan_id / pcp.  With seq_width 1, 2 or 4, frame k carries
+ * seq_start + k big-endian at seq_offset (44 / 2 is the PTP sequenceId,
+ * 16 / 1 the AVTP sequence_num without a VLAN tag).
+ *
+ * Frame k is due at start + k * interval_ns, or with pps set at
+ * start + ceil(k * 1e9 / pps).  The timer runs at the frame interval but
+ * not faster than every 125 us and sends every due frame, at most burst per
+ * expiry (frames left over are sent at the next ones and raise max_behind).
+ * depth frames are built at START; a due frame that finds all of them in
+ * flight is skipped.  The schedule runs on interrupt time and frames leave
+ * as soon as the miniport's queue reaches them.
+ *
+ * With AVB_PKTGEN_FLAG_LAUNCH the generator times the frames itself, as the
+ * launch-time pacer does (REQ-F-LAUNCH-003): the schedule runs on the PHC
+ * and starts launch_offset_ns after START, frame k's launch time is its
+ * schedule time, and a one-shot timer re-armed for the next launch time
+ * hands each frame down once the PHC has reached it, never before.  lt_*
+ * describe "PHC at hand-down - launch time" per frame: on time up to
+ * 125 us (one Class A interval), late beyond.  The miniport's own queuing
+ * comes on top and is not measured.  START fails with
+ * STATUS_DEVICE_NOT_READY when the PHC cannot be read.
+ *
+ * STOP ends a run; STATUS reads it, also after it ended, until the next
+ * START.  Results: achieved rate (rate_milli, frames / 1000 s) between the
+ * first and the last send, send -> send-complete latency percentiles, TX
+ * timestamps the poll DPC read from the FIFO since START (ts_captured),
+ * and send-completes that carried a TaggedTransmitHw timestamp (ts_tagged).
+ * The adapter must be running; a START while frames of the previous run
+ * are still in flight fails with STATUS_DEVICE_BUSY.
+ */
+#define AVB_PKTGEN_CMD_STATUS        0u
+#define AVB_PKTGEN_CMD_START         1u
+#define AVB_PKTGEN_CMD_STOP          2u
+
+#define AVB_PKTGEN_FLAG_VLAN         0x1u
+#define AVB_PKTGEN_FLAG_LAUNCH       0x2u
+
+#define AVB_PKTGEN_STATE_IDLE        0u   /* no run since attach */
+#define AVB_PKTGEN_STATE_RUNNING     1u
+#define AVB_PKTGEN_STATE_DONE        2u   /* count frames issued */
+#define AVB_PKTGEN_STATE_STOPPED     3u   /* STOP, or the adapter paused */
+
+#define AVB_PKTGEN_PAYLOAD_MAX       64u
+#define AVB_PKTGEN_DEPTH_DEFAULT     64u
+#define AVB_PKTGEN_DEPTH_MAX         512u
+
+typedef struct AVB_PKTGEN_REQUEST {
+    avb_u32 command;                /* in:  AVB_PKTGEN_CMD_*                            */
+    avb_u32 flags;                  /* in (START): AVB_PKTGEN_FLAG_*                    */
+    avb_u8  dst_mac[6];             /* in (START): frame template ...                   */
+    avb_u16 ethertype;
+    avb_u16 vlan_id;                /* FLAG_VLAN: 0..4095                               */
+    avb_u8  pcp;                    /* FLAG_VLAN: 0..7                                  */
+    avb_u8  seq_width;              /* 0 (none), 1, 2 or 4 bytes                        */
+    avb_u16 frame_size;             /* 60..1514                                         */
+    avb_u16 payload_len;            /* 0..AVB_PKTGEN_PAYLOAD_MAX                        */
+    avb_u8  payload[AVB_PKTGEN_PAYLOAD_MAX]; /* bytes after the EtherType               */
+    avb_u16 seq_offset;             /* from the frame start                             */
+    avb_u16 reserved0;
+    avb_u32 count;                  /* in (START): frames, 0 = until STOP               */
+    avb_u32 pps;                    /* in (START): frames per second, 0: interval_ns    */
+    avb_u32 depth;                  /* in (START): frames built, 0 = default            */
+    avb_u32 burst;                  /* in (START): frames per timer expiry, 0 = 64      */
+    avb_u32 state;                  /* out: AVB_PKTGEN_STATE_*                          */
+    avb_u64 interval_ns;            /* in (START): frame gap when pps is 0              */
+    avb_u64 launch_offset_ns;       /* in (START): FLAG_LAUNCH, frame 0 after START    */
+    avb_u64 seq_start;              /* in (START): sequence of frame 0                  */
+    avb_u64 sent;                   /* out: frames handed to the miniport               */
+    avb_u64 completed;              /* out: of those, send-completed                    */
+    avb_u64 skipped;                /* out: due frames that found depth in flight       */
+    avb_u64 max_behind;             /* out: most due frames left after one expiry       */
+    avb_u64 lt_on_time;             /* out: FLAG_LAUNCH, handed down <= 125 us late     */
+    avb_u64 lt_late;                /* out: FLAG_LAUNCH, handed down later              */
+    avb_u64 lt_error_max_ns;        /* out: FLAG_LAUNCH, worst hand-down - launch       */
+    avb_u64 lt_error_mean_ns;       /* out: FLAG_LAUNCH, mean hand-down - launch        */
+    avb_u64 ts_captured;            /* out: TX timestamps read since START              */
+    avb_u64 ts_tagged;              /* out: send-completes with a TaggedTransmitHw ts   */
+    avb_u64 elapsed_ns;             /* out: first to last send                          */
+    avb_u64 rate_milli;             /* out: achieved frames per 1000 s                  */
+    avb_u64 lat_count;              /* out: send -> send-complete latency ...           */
+    avb_u64 lat_min_ns;
+    avb_u64 lat_p50_ns;
+    avb_u64 lat_p90_ns;
+    avb_u64 lat_p99_ns;
+    avb_u64 lat_p999_ns;
+    avb_u64 lat_max_ns;
+    avb_u64 lat_mean_ns;
+    avb_u32 status;                 /* out: NDIS_STATUS value                           */
+    avb_u32 reserved;               /* padding — keeps sizeof a multiple of 8           */
+} AVB_PKTGEN_REQUEST, *PAVB_PKTGEN_REQUEST;
+
+#define IOCTL_AVB_PKTGEN                     _NDIS_CONTROL_CODE(81, METHOD_BUFFERED)
+
+/*==============================================================================
+ * TX Residence Time per Priority (REQ-F-STATISTICS-005)
+ * IOCTL: IOCTL_AVB_TX_RESIDENCE (82)
+ *
+ * How long frames stay below the filter: from FilterSendNetBufferLists
+ * handing a frame to the miniport to its FilterSendNetBufferListsComplete.
+ * That span holds the credit-based / time-aware shaper's holding time and
+ * any queueing behind other frames, so it shows whether a class is shaped
+ * as configured and where a queue blocks the ones behind it.
+ *
+ * CONFIGURE selects the frames to stamp: priority p when bit p of pcp_mask
+ * is set (the PCP of an in-frame 802.1Q / 802.1ad tag, else the NBL's
+ * 802.1Q priority), only EtherType ethertype if it is nonzero (behind the
+ * tag), and one matching frame in sample_every (0 or 1: all).  pcp_mask 0
+ * turns sampling off; frames stamped before still complete into their
+ * histogram.  Frames the launch-time pacer holds back are not stamped.
+ *
+ * Each priority has a latency histogram (AVB_LAT_HIST_TX_RESIDENCE in
+ * IOCTL_AVB_GET_LAT_HIST for the buckets); every reply summarises all
+ * eight in classes[].  FLAG_RESET zeroes the histograms and counters as
+ * they are read, with either command (in_flight is a level, not reset).
+ */
+#define AVB_TX_RES_CMD_GET           0u
+#define AVB_TX_RES_CMD_CONFIGURE     1u
+
+#define AVB_TX_RES_FLAG_RESET        0x1u
+
+#define AVB_TX_RES_CLASSES           8u
+
+typedef struct AVB_TX_RES_CLASS {
+    avb_u64 count;                  /* out: completed stamped frames of this priority   */
+    avb_u64 min_ns;                 /* out: to-miniport -> send-complete ...            */
+    avb_u64 p50_ns;
+    avb_u64 p90_ns;
+    avb_u64 p99_ns;
+    avb_u64 p999_ns;
+    avb_u64 max_ns;
+    avb_u64 mean_ns;
+} AVB_TX_RES_CLASS, *PAVB_TX_RES_CLASS;
+
+typedef struct AVB_TX_RES_REQUEST {
+    avb_u32 command;                /* in:  AVB_TX_RES_CMD_*                            */
+    avb_u32 flags;                  /* in:  AVB_TX_RES_FLAG_*                           */
+    avb_u32 pcp_mask;               /* in (CONFIGURE) / out: priorities sampled, 0 = off */
+    avb_u32 ethertype;              /* in (CONFIGURE) / out: 0 = any                    */
+    avb_u32 sample_every;           /* in (CONFIGURE) / out: 1 of every N matches       */
+    avb_u32 reserved0;
+    avb_u64 stamped;                /* out: frames stamped on the way down              */
+    avb_u64 completed;              /* out: of those, send-completed and recorded       */
+    avb_u64 no_context;             /* out: matches not stamped (no NBL context space)  */
+    avb_u64 in_flight;              /* out: stamped frames not yet send-completed       */
+    AVB_TX_RES_CLASS classes[AVB_TX_RES_CLASSES]; /* out: by priority                  */
+    avb_u32 status;                 /* out: NDIS_STATUS value                           */
+    avb_u32 reserved;               /* padding — keeps sizeof a multiple of 8           */
+} AVB_TX_RES_REQUEST, *PAVB_TX_RES_REQUEST;
+
+#define IOCTL_AVB_TX_RESIDENCE               _NDIS_CONTROL_CODE(82, METHOD_BUFFERED)
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,86 @@
+/*++
+
+Module Name:
+
+    aux_capture.c
+
+Abstract:
+
+    AUXSTMP latch tracker - implementation.  See aux_capture.h.
+
+--*/
+
+#include "aux_capture.h"
+
+void avb_aux_capture_init(avb_aux_capture_t *a, uint64_t period_ns)
+{
+    a->last_ts_ns  = 0;
+    a->next_edge   = 0;
+    a->records     = 0;
+    a->overruns    = 0;
+    a->nominal_ns  = period_ns;
+    a->period_ns   = period_ns;
+    a->period_hits = 0;
+    a->primed      = 0;
+}
+
+int avb_aux_capture_locked(const avb_aux_capture_t *a)
+{
+    return a->period_ns != 0 && a->period_hits >= AVB_AUX_LOCK_HITS;
+}
+
+int avb_aux_capture_update(avb_aux_capture_t *a, uint64_t ts_ns, uint64_t *edge, uint32_t *lost)
+{
+    uint64_t missed = 0;
+
+    if (!a->primed) {
+        a->primed     = 1;
+        a->last_ts_ns = ts_ns;
+        return 0;
+    }
+    if (ts_ns == a->last_ts_ns) {
+        return 0;
+    }
+
+    if (a->nominal_ns == 0) {
+        /* Nothing to measure the interval against: arrival order only */
+    } else if (ts_ns < a->last_ts_ns) {
+        /* PHC stepped backwards: interval meaningless, start over */
+        a->period_ns   = a->nominal_ns;
+        a->period_hits = 0;
+    } else {
+        uint64_t dt  = ts_ns - a->last_ts_ns;
+        uint64_t k   = (dt + a->period_ns / 2u) / a->period_ns;
+        uint64_t tol = a->period_ns >> AVB_AUX_TOL_SHIFT;
+        uint64_t exp = k * a->period_ns;
+        uint64_t err = (dt > exp) ? dt - exp : exp - dt;
+
+        if (k == 0 || err > tol) {
+            /* Not the configured reference (or a glitch): drop the lock */
+            a->period_ns   = a->nominal_ns;
+            a->period_hits = 0;
+        } else {
+            uint64_t per = dt / k;
+
+            if (avb_aux_capture_locked(a)) {
+                missed = k - 1u;
+            }
+            if (per >= a->period_ns) {
+                a->period_ns += (per - a->period_ns) >> AVB_AUX_EWMA_SHIFT;
+            } else {
+                a->period_ns -= (a->period_ns - per) >> AVB_AUX_EWMA_SHIFT;
+            }
+            if (a->period_hits < AVB_AUX_LOCK_HITS) {
+                a->period_hits++;
+            }
+        }
+    }
+
+    *edge  = a->next_edge + missed;
+    *lost  = (missed > UINT32_MAX) ? UINT32_MAX : (uint32_t)missed;
+    a->next_edge   = *edge + 1u;
+    a->overruns   += missed;
+    a->records++;
+    a->last_ts_ns  = ts_ns;
+    return 1;
+}
@@ -0,0 +1,79 @@
+/*++
+
+Module Name:
+
+    aux_capture.h
+
+Abstract:
+
+    AUXSTMP latch tracker for streaming SDP input timestamps.
+
+    The AUXSTMPn register pair holds one capture.  It stays latched until the
+    driver reads AUXSTMPHn; edges arriving meanwhile are lost without any
+    hardware indication.  The driver polls the latch and feeds every read to
+    avb_aux_capture_update(), which:
+
+      - drops the first read after enable (stale latch from before),
+      - ignores reads that return the value already reported,
+      - checks each interval against the nominal edge interval of the
+        reference (PPS, media clock) given at enable, and tracks the actual
+        interval with an EWMA,
+      - once AVB_AUX_LOCK_HITS intervals in a row matched, turns an interval
+        of ~k periods into k-1 lost edges (overrun), and
+      - numbers every reported edge, counting the lost ones, so consumers see
+        edge numbers with gaps exactly where captures were missed.
+
+    The interval cannot be learned from the captures: with a reference
+    faster than the poll every capture is one poll apart, and that is what
+    a learner locks onto.  Without a nominal interval (0) edges are numbered
+    in arrival order and no loss is inferred.
+
+    An interval that matches no multiple of the tracked period (within
+    period / 2^AVB_AUX_TOL_SHIFT), or a timestamp going backwards (PHC
+    stepped), drops the lock and restarts from the nominal interval.
+
+    Pure C99 (stdint only).  Callers own locking.
+
+    Implements: REQ-F-PTP-AUXSTREAM-001 (Streamed auxiliary timestamps)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_AUX_LOCK_HITS     2u   /* matching intervals before loss is inferred */
+#define AVB_AUX_TOL_SHIFT     3u   /* interval tolerance: period / 8 */
+#define AVB_AUX_EWMA_SHIFT    3u   /* period filter: alpha = 1/8 */
+
+typedef struct _avb_aux_capture {
+    uint64_t last_ts_ns;    /* last latch value seen */
+    uint64_t next_edge;     /* edge number the next capture gets if nothing is lost */
+    uint64_t records;       /* captures reported */
+    uint64_t overruns;      /* edges inferred lost (sum of per-record 'lost') */
+    uint64_t nominal_ns;    /* edge interval given at enable, 0 = unknown */
+    uint64_t period_ns;     /* tracked edge interval, 0 = unknown */
+    uint32_t period_hits;   /* consecutive intervals matching period_ns (saturates) */
+    uint32_t primed;        /* first (stale) latch consumed */
+} avb_aux_capture_t;
+
+/** Start over; period_ns is the reference's nominal edge interval, 0 = unknown */
+void avb_aux_capture_init(avb_aux_capture_t *a, uint64_t period_ns);
+
+/**
+ * Feed one latch read.  Returns 1 when ts_ns is a new capture to report, with
+ * *edge = its edge number and *lost = edges missed just before it; 0 when the
+ * read is the priming read or repeats the previous value.
+ */
+int avb_aux_capture_update(avb_aux_capture_t *a, uint64_t ts_ns, uint64_t *edge, uint32_t *lost);
+
+/** Non-zero once loss inference is active. */
+int avb_aux_capture_locked(const avb_aux_capture_t *a);
+
+#ifdef __cplusplus
+}
+#endif
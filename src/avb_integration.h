@@ -17,6 +17,109 @@ Abstract:
 #include "precomp.h"
 /* Share IOCTL ABI (codes and request structs) with user-mode */
 #include "include/avb_ioctl.h"
+/* PHC frequency estimator / holdover state machine (pure C, host-testable) */
+#include "phc_holdover.h"
+/* Periodic SDP output scheduler / jitter statistics (pure C, host-testable) */
+#include "sdp_perout.h"
+#include "aux_capture.h"
+/* SRP stream admission / CBS derivation (pure C, host-testable) */
+#include "srp_admission.h"
+/* Hashed SRP reservation store (pure C, host-testable) */
+#include "srp_table.h"
+/* Qbv admin/operational schedule switch (pure C, host-testable) */
+#include "tas_switch.h"
+/* Per-frame launch time horizon / descriptor encoding (pure C, host-testable) */
+#include "launch_time.h"
+/* Software launch-time pacer queue (pure C, host-testable) */
+#include "lt_pacer.h"
+/* Per-processor driver statistics (pure C, host-testable) */
+#include "pcpu_stats.h"
+/* NBL chain accounting / PTP classification for the datapath (pure C, host-testable) */
+#include "nbl_chain.h"
+/* Log-linear latency histograms (pure C, host-testable) */
+#include "lat_hist.h"
+/* Per-processor binary trace rings (pure C, host-testable) */
+#include "trace_ring.h"
+/* MMIO access accounting per register block and caller (pure C, host-testable) */
+#include "mmio_acct.h"
+#include "nbl_pool.h"
+/* Kernel packet generator template and schedule (pure C, host-testable) */
+#include "pkt_gen.h"
+/* Send -> send-complete residence sampling rules (pure C, host-testable) */
+#include "tx_residence.h"
+
+/* Driver statistics update (any IRQL <= DISPATCH_LEVEL): the current
+ * processor's slot, so concurrent paths on different cores share no line */
+#define AVB_STAT_ADD(ctx, idx, n) \
+    InterlockedAdd64(&avb_pcpu_slot(&(ctx)->stats, KeGetCurrentProcessorNumberEx(NULL))->v[(idx)], \
+                     (LONGLONG)(n))
+#define AVB_STAT_INC(ctx, idx)  AVB_STAT_ADD((ctx), (idx), 1)
+#define AVB_STAT_DEC(ctx, idx)  AVB_STAT_ADD((ctx), (idx), -1)
+
+/* Latency histogram clock: the invariant TSC on x86 / x64 (tick rate
+ * calibrated against QPC when the context is created), QPC elsewhere */
+#if defined(_M_AMD64) || defined(_M_IX86)
+#define AVB_LAT_TICKS()         __rdtsc()
+#else
+#define AVB_LAT_TICKS()         ((ULONG64)KeQueryPerformanceCounter(NULL).QuadPart)
+#endif
+
+/* One sample of hot-path histogram id (AVB_LAT_*) for the span since
+ * t0 = AVB_LAT_TICKS() (any IRQL <= DISPATCH_LEVEL): the current
+ * processor's copy, one interlocked increment */
+#define AVB_LAT_RECORD(ctx, id, t0) \
+    do { \
+        avb_lat_hist_t *lat_h_ = avb_lat_slot(&(ctx)->lat, KeGetCurrentProcessorNumberEx(NULL), (id)); \
+        if (lat_h_ != NULL) { \
+            InterlockedIncrement64(&lat_h_->b[avb_lat_index(avb_lat_ns(&(ctx)->lat, AVB_LAT_TICKS() - (t0)))]); \
+        } \
+    } while (0)
+
+/* Trace point (any IRQL <= DISPATCH_LEVEL): one 48-byte record of event
+ * id (AVB_TR_*) in the current processor's ring when the event's category
+ * is enabled through IOCTL_AVB_TRACE; otherwise one load and a branch.
+ * Arguments are not evaluated while the category is off. */
+#define AVB_TRACE(ctx, id, a32, a0, a1, a2) \
+    do { \
+        if ((ctx)->trace.categories & AVB_TRACE_CAT_OF(id)) { \
+            avb_trace_emit(&(ctx)->trace, KeGetCurrentProcessorNumberEx(NULL), AVB_LAT_TICKS(), (id), \
+                           (uint32_t)(a32), (uint64_t)(a0), (uint64_t)(a1), (uint64_t)(a2)); \
+        } \
+    } while (0)
+
+/* MMIO accounting (REQ-NF-DIAG-MMIO-001) is compiled in only with
+ * AVB_MMIO_ACCT=1 (msbuild /p:AvbMmioAcct=1).  Otherwise the macros below
+ * are empty and the context has no accounting fields. */
+#ifndef AVB_MMIO_ACCT
+#define AVB_MMIO_ACCT 0
+#endif
+
+#if AVB_MMIO_ACCT
+/* One BAR0 access at offset (dir AVB_MMIO_RD / AVB_MMIO_WR) that began at
+ * t0 = AVB_LAT_TICKS(): charged to the current processor's caller tag, or
+ * to AVB_MMIO_CALLER_PASSIVE below DISPATCH_LEVEL */
+#define AVB_MMIO_ACCT_RECORD(ctx, offset, dir, t0) \
+    do { \
+        avb_mmio_acct_slot_t *mmio_s_ = avb_mmio_acct_slot(&(ctx)->mmio_acct, KeGetCurrentProcessorNumberEx(NULL)); \
+        if (mmio_s_ != NULL) { \
+            uint32_t mmio_c_ = KeGetCurrentIrql() < DISPATCH_LEVEL ? AVB_MMIO_CALLER_PASSIVE : mmio_s_->caller; \
+            uint32_t mmio_b_ = avb_mmio_block(offset); \
+            InterlockedIncrement64(&mmio_s_->count[(dir)][mmio_c_][mmio_b_]); \
+            InterlockedAdd64(&mmio_s_->ticks[(dir)][mmio_c_][mmio_b_], (LONG64)(AVB_LAT_TICKS() - (t0))); \
+        } \
+    } while (0)
+
+/* Charge the accesses between BEGIN and END of the same caller to it
+ * (DISPATCH_LEVEL only; no return in between).  Scopes nest. */
+#define AVB_MMIO_SCOPE_BEGIN(ctx, caller) \
+    uint32_t mmio_prev_##caller = avb_mmio_acct_enter(&(ctx)->mmio_acct, KeGetCurrentProcessorNumberEx(NULL), (caller))
+#define AVB_MMIO_SCOPE_END(ctx, caller) \
+    avb_mmio_acct_leave(&(ctx)->mmio_acct, KeGetCurrentProcessorNumberEx(NULL), mmio_prev_##caller)
+#else
+#define AVB_MMIO_ACCT_RECORD(ctx, offset, dir, t0)  ((void)0)
+#define AVB_MMIO_SCOPE_BEGIN(ctx, caller)           ((void)0)
+#define AVB_MMIO_SCOPE_END(ctx, caller)             ((void)0)
+#endif
 
 // Intel constants
 #define INTEL_VENDOR_ID         0x8086
@@ -83,17 +186,6 @@ typedef struct _ATDECC_SUBSCRIPTION {
     ATDECC_EVENT_ENTRY queue[ATDECC_EVENT_QUEUE_DEPTH];
 } ATDECC_SUBSCRIPTION;
 
-/*=======================================================================
- * SRP Stream Reservations (Issue #211 — IEEE 802.1Qat)
- *=======================================================================*/
-#define MAX_SRP_STREAMS  16
-
-typedef struct _SRP_RESERVATION {
-    avb_u32 handle;         /* 1-based; 0 = unused slot */
-    avb_u64 stream_id;      /* IEEE 802.1Qat stream identifier */
-    avb_u32 bandwidth_bps;  /* reserved bandwidth in bits/sec */
-} SRP_RESERVATION;
-
 /* Timestamp Event Subscription Management (Issue #13)
  * Supports up to 32 concurrent subscriptions per adapter
  * NOTE: Increased from 8 to support full test suite execution
@@ -115,17 +207,35 @@ typedef struct _TS_SUBSCRIPTION {
     PFILE_OBJECT file_object;             // Owning handle (for cleanup on close)
 } TS_SUBSCRIPTION;
 
+/* One read-only user mapping of the hardware statistics page (REQ-F-STATISTICS-004) */
+typedef struct _AVB_HW_STATS_MAPPING {
+    PFILE_OBJECT file_object;             // Owning handle (unmapped on IRP_MJ_CLEANUP)
+    PMDL         mdl;
+    PVOID        user_va;                 // NULL = slot free
+} AVB_HW_STATS_MAPPING;
+
 // AVB device context structure
-/* Pre-allocated NBL ring for fast SEND_PTP path.
+/* Pre-built NBL slots for the fast SEND_PTP path, handed out by a lock-free
+ * pool (src/nbl_pool.h, REQ-NF-PERF-TXPOOL-001).
  * Each slot owns its own packet buffer, MDL, NET_BUFFER, and NET_BUFFER_LIST.
  * Eliminates per-call NdisAllocateNetBuffer/NdisAllocateNetBufferList overhead (~10µs).
- * in_use: 0=free, 1=in-flight (CAS'd on acquire),
+ * AVB_TEST_POOL_MINIMUM slots are built at context creation; when all are in
+ * flight the pool builds more, up to its limit (AVB_TEST_POOL_CAPACITY unless
+ * lowered by IOCTL_AVB_TEST_POOL), and the trim timer frees the extra ones
+ * after AVB_TEST_POOL_IDLE_MS without a send.  The NBL context carries
+ * AVB_TEST_NBL_TAG and the slot index, so send-complete finds the slot
+ * without a search.
+ * in_use: 0=not in flight, 1=in-flight (set on acquire),
  *         2=deferred-cleanup (set by AvbCleanupDevice when slot is in-flight;
  *           FilterSendNetBufferListsComplete sees this and frees the slot instead of
- *           returning it to the ring, then decrements ring_cleanup_deferred).
- * Ring size of 32 supports bursts of up to 32 in-flight test packets simultaneously.
+ *           returning it to the pool, then decrements ring_cleanup_deferred).
  * Implements: Issue #35 (REQ-F-IOCTL-TS-001) - throughput optimization.   */
-#define AVB_TEST_NBL_RING_SIZE  32   /* large enough to absorb ~100µs NIC completion jitter at 150K ops/sec */
+#define TEST_PACKET_SIZE            64      /* PTP Sync frame: Ethernet(14) + Sync(34) + padding */
+#define AVB_TEST_POOL_CAPACITY      1024u   /* slot storage, allocated with the context */
+#define AVB_TEST_POOL_MINIMUM       32u     /* built up front and kept when idle */
+#define AVB_TEST_POOL_IDLE_MS       1000u
+#define AVB_TEST_NBL_CONTEXT_SIZE   16u     /* MEMORY_ALLOCATION_ALIGNMENT multiple */
+#define AVB_TEST_NBL_TAG            'lpTA'  /* NBL context word 0; word 1 is the slot index */
 typedef struct _AVB_TEST_NBL_SLOT {
     PNET_BUFFER_LIST nbl;     /* pre-allocated NBL, never freed until context teardown */
     PNET_BUFFER      nb;      /* pre-allocated NB, linked to this slot's MDL */
@@ -135,6 +245,52 @@ typedef struct _AVB_TEST_NBL_SLOT {
     LONG             _pad;    /* ensure 8-byte alignment */
 } AVB_TEST_NBL_SLOT, *PAVB_TEST_NBL_SLOT;
 
+/* Kernel packet generator run (IOCTL_AVB_PKTGEN, REQ-NF-TEST-PKTGEN-001).
+ * Allocated by START with depth frames - each a SEND_PTP-style slot built
+ * from the template once - followed by the pool's links; freed by the next
+ * START or at context teardown, never while frames are in flight
+ * (outstanding).  pool holds the frames not in flight; the NBL context
+ * carries AVB_PKTGEN_NBL_TAG and the frame index.  sched and release are
+ * written by the timer callback only; the counters are interlocked. */
+#define AVB_PKTGEN_NBL_TAG          'gpTA'
+typedef struct _AVB_PKTGEN_FRAME {
+    AVB_TEST_NBL_SLOT slot;       /* buffer holds frame_size bytes */
+    ULONG64           sent_tick;  /* AVB_LAT_TICKS() at the send */
+} AVB_PKTGEN_FRAME, *PAVB_PKTGEN_FRAME;
+
+/* TX residence sampling (IOCTL_AVB_TX_RESIDENCE, REQ-F-STATISTICS-005).
+ * A stamped frame carries this in NBL context space the filter allocates on
+ * the way down and frees at its send-complete, before the NBL goes up. */
+#define AVB_TXRES_NBL_TAG           'rtTA'
+#define AVB_TXRES_CONTEXT_SIZE      32u
+typedef struct _AVB_TXRES_STAMP {
+    ULONG64           tick;       /* AVB_LAT_TICKS() at the hand-off to the miniport */
+    PNET_BUFFER_LIST  nbl;        /* the stamped NBL, against stale context data */
+    ULONG             tag;        /* AVB_TXRES_NBL_TAG */
+    ULONG             pcp;        /* histogram, 0..7 */
+} AVB_TXRES_STAMP, *PAVB_TXRES_STAMP;
+
+typedef struct _AVB_PKTGEN {
+    avb_pktgen_template_t tmpl;
+    avb_pktgen_sched_t    sched;            /* FLAG_LAUNCH: on the PHC, frame k due at its launch time */
+    avb_pktgen_release_t  release;          /* FLAG_LAUNCH: hand-down - launch time */
+    avb_nbl_pool_t        pool;
+    AVB_PKTGEN_FRAME     *frames;           /* depth entries, then the pool links */
+    ULONG                 depth;
+    ULONG                 flags;            /* AVB_PKTGEN_FLAG_* */
+    ULONG64               seq_start;
+    volatile LONG         state;            /* AVB_PKTGEN_STATE_* */
+    volatile LONG         outstanding;      /* frames sent, not yet completed */
+    ULONG64               first_send_ns;    /* schedule clock; 0 = nothing sent yet */
+    ULONG64               last_send_ns;
+    LONGLONG              ts_polled_base;   /* tx_ts_polled at START */
+    volatile LONGLONG     sent;
+    volatile LONGLONG     completed;
+    volatile LONGLONG     skipped;
+    volatile LONGLONG     ts_tagged;
+    avb_lat_hist_t        lat;              /* send -> send-complete */
+} AVB_PKTGEN, *PAVB_PKTGEN;
+
 typedef struct _AVB_DEVICE_CONTEXT {
     device_t intel_device;
     BOOLEAN initialized;
@@ -175,9 +331,8 @@ typedef struct _AVB_DEVICE_CONTEXT {
     NDIS_HANDLE nb_pool_handle;                           // NET_BUFFER pool for test packets
     PVOID test_packet_buffer;                             // Pre-allocated PTP Sync frame (64 bytes, Non-Paged Pool)
     PMDL test_packet_mdl;                                 // MDL describing test_packet_buffer
-    NDIS_SPIN_LOCK test_send_lock;                        // Protects test packet send operations
     volatile LONG test_packets_pending;                   // Count of outstanding test NBLs (for completion tracking)
-    volatile LONG ring_cleanup_deferred;                  // # of in-flight ring slots deferred for cleanup by FilterSendNetBufferListsComplete
+    volatile LONG ring_cleanup_deferred;                  // # of in-flight pool slots deferred for cleanup by FilterSendNetBufferListsComplete
 
     // Legacy ring (deprecated - kept for compatibility)
     // Timestamp event ring (section-based mapping)
@@ -190,7 +345,7 @@ typedef struct _AVB_DEVICE_CONTEXT {
     HANDLE  ts_ring_section;    // section handle returned to UM
     SIZE_T  ts_ring_view_size;  // mapped system-space view size
 
-    // Qav (Credit-Based Shaper) last request snapshot (placeholder)
+    // Qav (Credit-Based Shaper) last applied configuration (effective values)
     UCHAR   qav_last_tc;
     ULONG   qav_idle_slope;
     ULONG   qav_send_slope;
@@ -203,6 +358,32 @@ typedef struct _AVB_DEVICE_CONTEXT {
      * previous_launch_time_ns for UT-LAUNCH-007 register-integrity verification. */
     ULONGLONG last_launch_time[8];
 
+    /* Per-frame launch time from AVB_LAUNCH_TIME_SLOT (REQ-F-LAUNCH-002).
+     * Counters are bumped in FilterSendNetBufferLists, read by
+     * IOCTL_AVB_LAUNCH_TIME_CONFIG. */
+    volatile LONG     lt_min_lead_ns;       /* 0 = AVB_LT_DEFAULT_LEAD_NS */
+    volatile LONG     lt_pcp_mask;          /* priorities whose slot is read; 0 = none */
+    volatile LONGLONG stats_lt_frames;      /* frames carrying a launch time */
+    volatile LONGLONG stats_lt_accepted;    /* held by the pacer */
+    volatile LONGLONG stats_lt_no_hw;       /* rejected: not paced, nothing times it */
+
+    /* Software launch-time pacer (REQ-F-LAUNCH-003), the only path that
+     * times frames (the miniports take no launch time).  pacer_lock covers
+     * the queue and its statistics; pacer_timer is a high-resolution ExTimer armed for the
+     * head's release time.  Held NBLs stay counted in the outstanding send
+     * gauge until the miniport completes them. */
+    avb_pacer_t     pacer;                  /* heap storage is non-paged pool */
+    NDIS_SPIN_LOCK  pacer_lock;
+    PEX_TIMER       pacer_timer;            /* allocated on ENABLE */
+    volatile LONG   pacer_active;           /* send path diverts pacer_tc frames */
+    UCHAR           pacer_tc;               /* 802.1p priority that is paced */
+
+    /* 802.3br MAC merge counters (REQ-F-FP-002), sampled by IOCTL_AVB_GET_FP_STATS
+     * and before every SETUP_FP.  fp_lock serialises the read-and-accumulate of
+     * the clear-on-read registers. */
+    intel_fp_stats_t fp_stats;
+    NDIS_SPIN_LOCK   fp_lock;
+
     /* IEEE 802.1AS-2020 §11.3 timestampCorrectionPortDS latency calibration.
      * Set via IOCTL_AVB_SET_PORT_LATENCY.  Both default to 0 (no correction). */
     volatile LONG64 ingress_latency_ns;   /* Added to RX hardware timestamps (signed, ns) */
@@ -223,45 +404,107 @@ typedef struct _AVB_DEVICE_CONTEXT {
      * Reinterpreted as ULONG64; LONGLONG declaration satisfies Interlocked ABI. */
     volatile LONGLONG last_ndis_tx_timestamp;
 
-    /* Pre-allocated NBL ring for fast IOCTL_AVB_TEST_SEND_PTP path.
-     * Slots are allocated at context creation (AvbCreateMinimalContext) and
-     * freed at context teardown.  Each slot is independently recycled on
-     * FilterSendNetBufferListsComplete without touching the NDIS pool allocator. */
-    AVB_TEST_NBL_SLOT test_nbl_ring[AVB_TEST_NBL_RING_SIZE];
+    /* Slot pool for the fast IOCTL_AVB_TEST_SEND_PTP path (REQ-NF-PERF-TXPOOL-001).
+     * test_slots (AVB_TEST_POOL_CAPACITY slots, then the pool's links) is
+     * allocated at context creation (AvbCreateMinimalContext) and freed at
+     * context teardown.  Each slot is recycled on
+     * FilterSendNetBufferListsComplete without touching the NDIS pool allocator.
+     * test_pool_timer trims idle slots; armed while more than the minimum are built. */
+    avb_nbl_pool_t     test_pool;
+    PAVB_TEST_NBL_SLOT test_slots;
+    PEX_TIMER          test_pool_timer;
+    volatile LONG      test_pool_timer_armed;
+
+    /* Kernel packet generator (IOCTL_AVB_PKTGEN, REQ-NF-TEST-PKTGEN-001).
+     * pktgen_lock covers swapping pktgen and pktgen_timer; the timer callback
+     * and send-complete read pktgen without it (it is only replaced while
+     * neither can run).  tx_ts_polled counts the TX timestamps the poll DPC
+     * reads, for the runs' capture counts. */
+    PAVB_PKTGEN        pktgen;
+    PEX_TIMER          pktgen_timer;
+    NDIS_SPIN_LOCK     pktgen_lock;
+    volatile LONGLONG  tx_ts_polled;
+
+    /* TX residence sampling (IOCTL_AVB_TX_RESIDENCE, REQ-F-STATISTICS-005).
+     * txres: the match rules the send path reads without a lock.
+     * txres_hist: AVB_TXRES_CLASSES shared histograms, allocated on the first
+     * CONFIGURE that turns sampling on and kept until the context goes.
+     * txres_outstanding lets send-complete skip the context check while no
+     * stamped frame is in flight; the other counters are interlocked. */
+    avb_txres_filter_t txres;
+    avb_lat_hist_t * volatile txres_hist;
+    volatile LONG      txres_outstanding;
+    volatile LONGLONG  txres_stamped;
+    volatile LONGLONG  txres_completed;
+    volatile LONGLONG  txres_no_context;
 
     /*
      * Runtime statistics — queried via IOCTL_AVB_GET_STATISTICS (0x9C40A020).
      * Implements #270 (TEST-STATISTICS-001).
-     * Fields are incremented with InterlockedIncrement64 so they are safe
-     * from concurrent IOCTL dispatch and NDIS send/receive paths.
-     * Layout MUST match AVB_DRIVER_STATISTICS in avb_ioctl.h (192 bytes, ABI 2.0).
-     * Original 13 fields (ABI 1.0, 104 bytes) + 11 extended fields (ABI 2.0).
+     * Kept per processor (src/pcpu_stats.h) and summed only by GET; update
+     * with AVB_STAT_INC / AVB_STAT_ADD.  Index order matches
+     * AVB_DRIVER_STATISTICS in avb_ioctl.h (24 fields, ABI 2.0).
+     * stats_lock serialises GET, RESET and snapshots; updates take no lock.
+     * stats_history: the last snapshots of IOCTL_AVB_STATS_SNAPSHOT, the
+     * bases of its delta reads (REQ-F-STATISTICS-003).
      */
-    volatile LONGLONG stats_tx_packets;
-    volatile LONGLONG stats_rx_packets;
-    volatile LONGLONG stats_tx_bytes;
-    volatile LONGLONG stats_rx_bytes;
-    volatile LONGLONG stats_phc_query_count;
-    volatile LONGLONG stats_phc_adjust_count;
-    volatile LONGLONG stats_phc_set_count;
-    volatile LONGLONG stats_timestamp_count;
-    volatile LONGLONG stats_ioctl_count;
-    volatile LONGLONG stats_error_count;
-    volatile LONGLONG stats_memory_alloc_failures;
-    volatile LONGLONG stats_hardware_faults;
-    volatile LONGLONG stats_filter_attach_count;
-    /* --- Extended fields (ABI 2.0) — lifecycle and datapath coverage --- */
-    volatile LONGLONG stats_filter_pause_count;       /* FilterPause entry count */
-    volatile LONGLONG stats_filter_restart_count;     /* FilterRestart entry count */
-    volatile LONGLONG stats_filter_detach_count;      /* FilterDetach entry count */
-    volatile LONGLONG stats_outstanding_send_nbls;    /* Outstanding send NBL gauge */
-    volatile LONGLONG stats_outstanding_receive_nbls; /* Outstanding receive NBL gauge */
-    volatile LONGLONG stats_oid_request_count;        /* FilterOidRequest entry count */
-    volatile LONGLONG stats_oid_complete_count;       /* FilterOidRequestComplete entry count */
-    volatile LONGLONG stats_outstanding_oids;         /* Outstanding OID gauge */
-    volatile LONGLONG stats_filter_status_count;      /* FilterStatus entry count */
-    volatile LONGLONG stats_filter_net_pnp_count;     /* FilterNetPnPEvent entry count */
-    volatile LONGLONG stats_pause_restart_generation; /* Incremented at each FilterPause entry */
+    avb_pcpu_stats_t    stats;
+    PVOID               stats_storage;  /* per-CPU slots, non-paged pool; NULL = single shared slot */
+    NDIS_SPIN_LOCK      stats_lock;
+    avb_stats_history_t stats_history;
+
+    /*
+     * Latency histograms — IOCTL_AVB_GET_LAT_HIST (REQ-F-STATISTICS-002).
+     * lat: hot paths, per processor (src/lat_hist.h), recorded with
+     * AVB_LAT_RECORD; recording is off when lat_storage could not be
+     * allocated.  lat_ioctl_hist: one shared histogram per IOCTL code,
+     * allocated on the code's first dispatch (slot claimed through
+     * lat_ioctl_code, pointer published after the code; the claim is
+     * released again when the allocation fails).
+     */
+    avb_lat_set_t     lat;
+    PVOID             lat_storage;      /* non-paged pool */
+    volatile LONG     lat_ioctl_code[AVB_LAT_HIST_MAX_IOCTLS];
+    avb_lat_hist_t * volatile lat_ioctl_hist[AVB_LAT_HIST_MAX_IOCTLS];
+
+    /*
+     * Binary trace — IOCTL_AVB_TRACE (REQ-NF-DIAG-TRACE-001).
+     * trace: per-processor rings (src/trace_ring.h) written by AVB_TRACE.
+     * trace_storage is allocated on the first ENABLE and kept until the
+     * context goes; trace.categories stays 0 until it exists.  trace_lock
+     * serialises ENABLE and DRAIN; trace points take no lock.
+     */
+    avb_trace_set_t   trace;
+    PVOID             trace_storage;    /* non-paged pool */
+    NDIS_SPIN_LOCK    trace_lock;
+
+    /*
+     * NIC statistics registers — IOCTL_AVB_HW_STATS (REQ-F-STATISTICS-004).
+     * hw_stats_timer samples the registers every hw_stats_interval_ms -
+     * clear-on-read ones only if in hw_stats_take, since the miniport reads
+     * them too - into hw_stats and publishes the totals on
+     * hw_stats_page (one non-paged page, allocated on the first START, SAMPLE
+     * or MAP and kept until the context goes).  hw_stats_lock covers all of
+     * it; the page itself is read by user mode without a lock (seqlock).
+     */
+    intel_hw_stats_t      hw_stats;
+    intel_hw_stats_page_t *hw_stats_page;
+    PEX_TIMER             hw_stats_timer;         /* allocated on START */
+    ULONG                 hw_stats_interval_ms;   /* 0 = not sampling */
+    ULONG64               hw_stats_take;          /* clear-on-read counters taken from the miniport */
+    AVB_HW_STATS_MAPPING  hw_stats_maps[AVB_HW_STATS_MAX_MAPS];
+    NDIS_SPIN_LOCK        hw_stats_lock;
+
+#if AVB_MMIO_ACCT
+    /*
+     * MMIO accounting — IOCTL_AVB_MMIO_ACCT (REQ-NF-DIAG-MMIO-001).
+     * mmio_acct: per-processor counts (src/mmio_acct.h) recorded by
+     * AvbMmioReadReal / AvbMmioWriteReal; off when mmio_acct_storage could
+     * not be allocated.  Only in AVB_MMIO_ACCT=1 builds.
+     */
+    avb_mmio_acct_t       mmio_acct;
+    PVOID                 mmio_acct_storage;      /* non-paged pool */
+#endif
 
     /* ATDECC Entity Event Subscriptions (Issue #236) */
     ATDECC_SUBSCRIPTION atdecc_subscriptions[MAX_ATDECC_SUBSCRIPTIONS];
@@ -286,9 +529,43 @@ typedef struct _AVB_DEVICE_CONTEXT {
     avb_u8  pfc_pad[2];
 
     /* SRP stream reservations (Issue #211 — IEEE 802.1Qat) */
-    SRP_RESERVATION srp_reservations[MAX_SRP_STREAMS];
+    avb_srp_table_t srp_table;        /* keyed by stream_id (REQ-F-SRP-004); storage is non-paged pool */
     NDIS_SPIN_LOCK  srp_lock;
-    volatile LONG   next_srp_handle;  /* 1-based monotonic allocator */
+    avb_srp_admission_t srp_admission;  /* per-class aggregates (REQ-F-SRP-003), under srp_lock */
+
+    /* Qbv admin -> operational schedule switch (REQ-F-TAS-003).  SETUP_TAS
+     * with a list running stages the admin list in tas_admin; tas_timer, a
+     * high-resolution ExTimer armed for tas_switch.stop_ns, takes the running
+     * list down and arms it (apply_tas_switch).  tas_lock serialises SETUP_TAS,
+     * the timer and TAS_GET_STATE, and covers swapping tas_timer. */
+    avb_tas_switch_t       tas_switch;
+    struct tsn_tas_config  tas_admin;
+    PEX_TIMER              tas_timer;       /* allocated on the first SETUP_TAS */
+    NDIS_SPIN_LOCK         tas_lock;
+
+    /* PHC drift estimator and holdover (REQ-F-PTP-HOLDOVER-001).
+     * holdover_lock serialises the estimator with every TIMINCA write made by
+     * ADJUST_FREQUENCY, IOCTL_AVB_PHC_HOLDOVER and the holdover watchdog DPC. */
+    avb_holdover_t  holdover;
+    NDIS_SPIN_LOCK  holdover_lock;
+    NDIS_TIMER      holdover_timer;         /* auto-holdover watchdog (AVB_HOLDOVER_POLL_MS) */
+    BOOLEAN         holdover_poll_active;   /* watchdog armed; cleared to stop re-arming */
+    ULONG           holdover_timinca;       /* TIMINCA programmed at holdover entry */
+
+    /* Periodic SDP output (REQ-F-PTP-PEROUT-001), one entry per TRGTTIM/FREQOUT
+     * channel.  perout_lock serialises the IOCTLs with the re-arm DPC. */
+    avb_perout_t    perout[2];
+    UCHAR           perout_pin[2];          /* output SDP */
+    UCHAR           perout_measure_pin[2];  /* loopback SDP, INTEL_SDP_PIN_NONE if none */
+    ULONGLONG       perout_last_aux[2];     /* last AUXSTMP value seen (new capture detection) */
+    NDIS_SPIN_LOCK  perout_lock;
+    NDIS_TIMER      perout_timer;           /* re-arm / capture poll (AVB_PEROUT_POLL_MS) */
+    BOOLEAN         perout_poll_active;     /* any channel running; cleared to stop re-arming */
+
+    /* Streamed AUX capture (REQ-F-PTP-AUXSTREAM-001).  Shares perout_lock and
+     * perout_timer: the AUXSTMP channels are the same hardware. */
+    avb_aux_capture_t aux_capture[2];
+    UCHAR           aux_capture_pin[2];     /* input SDP, INTEL_SDP_PIN_NONE = not streaming */
 
     // Per-adapter list linkage — protected by g_AvbContextListLock
     struct _AVB_DEVICE_CONTEXT *next_context;
@@ -422,6 +699,20 @@ NTSTATUS AvbSendPtpCore(
     _Inout_ PAVB_TEST_SEND_PTP_REQUEST test_req
 );
 
+/* SEND_PTP slot pool (REQ-NF-PERF-TXPOOL-001), <= DISPATCH_LEVEL.
+ * Acquire returns a slot ready to stamp and send (in_use = 1), building a
+ * new one if the pool may grow; NULL when exhausted.  Complete takes a
+ * send-completed NBL back; FALSE if it is not a pool slot. */
+PAVB_TEST_NBL_SLOT AvbTestSlotAcquire(_In_ PAVB_DEVICE_CONTEXT Ctx);
+BOOLEAN AvbTestSlotComplete(_In_ PAVB_DEVICE_CONTEXT Ctx, _In_ PNET_BUFFER_LIST Nbl);
+// Kernel packet generator (REQ-NF-TEST-PKTGEN-001): TRUE when Nbl is a generator frame, taken back
+BOOLEAN AvbPktGenComplete(_In_ PAVB_DEVICE_CONTEXT Ctx, _In_ PNET_BUFFER_LIST Nbl);
+/* TX residence sampling (REQ-F-STATISTICS-005), <= DISPATCH_LEVEL: Stamp a
+ * frame the filter hands to the miniport if it matches; Complete records a
+ * stamped frame's residence and frees its NBL context (no-op otherwise). */
+VOID AvbTxResStamp(_In_ PAVB_DEVICE_CONTEXT Ctx, _In_ PNET_BUFFER_LIST Nbl);
+VOID AvbTxResComplete(_In_ PAVB_DEVICE_CONTEXT Ctx, _In_ PNET_BUFFER_LIST Nbl);
+
 NTSTATUS AvbHandleDeviceIoControl(
     _In_ PAVB_DEVICE_CONTEXT AvbContext,
     _In_ PIRP Irp
@@ -678,4 +969,12 @@ NTSTATUS AvbI210EnsureSystimRunning(PAVB_DEVICE_CONTEXT context);
 BOOLEAN AvbVerifyHardwareContext(PAVB_DEVICE_CONTEXT context);
 NTSTATUS AvbForceContextReinitialization(PAVB_DEVICE_CONTEXT context);
 
+// Per-frame launch time (REQ-F-LAUNCH-002): AVB_LT_FMT_* of the adapter's TX descriptor
+ULONG AvbLaunchTimeFormat(PAVB_DEVICE_CONTEXT context);
+
+// Software launch-time pacer (REQ-F-LAUNCH-003), called from FilterSendNetBufferLists
+NDIS_STATUS AvbPacerHold(PAVB_DEVICE_CONTEXT context, PNET_BUFFER_LIST nbl, NDIS_PORT_NUMBER port,
+                         ULONG64 now_ns, ULONG64 launch_ns);
+PNET_BUFFER_LIST AvbPacerTakeDue(PAVB_DEVICE_CONTEXT context, NDIS_PORT_NUMBER port, ULONG64 now_ns, ULONG *count);
+
 #endif // _AVB_INTEGRATION_H_
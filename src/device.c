@@ -197,7 +197,6 @@ IntelAvbFilterFastIoDeviceControl(
         return TRUE;
     }
 
-    volatile BOOLEAN lock_held = FALSE;  /* tracked for exception-safe release */
     __try {
         PAVB_TEST_SEND_PTP_REQUEST req = (PAVB_TEST_SEND_PTP_REQUEST)OutputBuffer;
         ProbeForWrite(req, sizeof(*req), sizeof(avb_u32));
@@ -205,48 +204,20 @@ IntelAvbFilterFastIoDeviceControl(
 
         avb_u32 seq_id = ((PAVB_TEST_SEND_PTP_REQUEST)InputBuffer)->sequence_id;
 
-        /* Acquire a pre-allocated ring slot (same logic as IRP path). */
-        int ring_slot = -1;
-        for (int _ri = 0; _ri < AVB_TEST_NBL_RING_SIZE; _ri++) {
-            if (ctx->test_nbl_ring[_ri].nbl != NULL &&
-                InterlockedCompareExchange(&ctx->test_nbl_ring[_ri].in_use, 1, 0) == 0) {
-                ring_slot = _ri;
-                break;
-            }
+        /* Take a pre-built slot from the lock-free pool (same as the IRP path).
+         * Exhausted (limit slots in flight): refuse, the caller retries. */
+        PAVB_TEST_NBL_SLOT slot = AvbTestSlotAcquire(ctx);
+        if (slot == NULL) {
+            req->packets_sent     = 0;
+            req->status           = (avb_u32)NDIS_STATUS_RESOURCES;
+            IoStatus->Status      = STATUS_INSUFFICIENT_RESOURCES;
+            IoStatus->Information = sizeof(*req);
+            IoReleaseRemoveLock(&ctx->ioctl_remove_lock, FileObject);
+            return TRUE;
         }
 
-        PNET_BUFFER_LIST nbl;
-        PUCHAR pkt;
-
-        if (ring_slot >= 0) {
-            /* Fast path: ring slot owned exclusively via CAS — no spinlock needed. */
-            nbl = ctx->test_nbl_ring[ring_slot].nbl;
-            ctx->test_nbl_ring[ring_slot].nb->DataOffset = 0;
-            nbl->Next = NULL;
-            pkt = (PUCHAR)ctx->test_nbl_ring[ring_slot].buffer;
-        } else {
-            /* Slow path: ring exhausted — allocate on demand under spinlock. */
-            NdisAcquireSpinLock(&ctx->test_send_lock);
-            lock_held = TRUE;
-            PNET_BUFFER nb = NdisAllocateNetBuffer(ctx->nb_pool_handle,
-                                                    ctx->test_packet_mdl, 0, 64);
-            if (!nb) { NdisReleaseSpinLock(&ctx->test_send_lock); lock_held = FALSE;
-                       IoStatus->Status = STATUS_INSUFFICIENT_RESOURCES;
-                       IoStatus->Information = 0;
-                       IoReleaseRemoveLock(&ctx->ioctl_remove_lock, FileObject);
-                       return TRUE; }
-            nbl = NdisAllocateNetBufferList(ctx->nbl_pool_handle, 0, 0);
-            if (!nbl) { NdisFreeNetBuffer(nb);
-                        NdisReleaseSpinLock(&ctx->test_send_lock); lock_held = FALSE;
-                        IoStatus->Status = STATUS_INSUFFICIENT_RESOURCES;
-                        IoStatus->Information = 0;
-                        IoReleaseRemoveLock(&ctx->ioctl_remove_lock, FileObject);
-                        return TRUE; }
-            NdisReleaseSpinLock(&ctx->test_send_lock);
-            lock_held = FALSE;
-            nbl->FirstNetBuffer = nb; nbl->Next = NULL;
-            pkt = (PUCHAR)ctx->test_packet_buffer;
-        }
+        PNET_BUFFER_LIST nbl = slot->nbl;
+        PUCHAR pkt = (PUCHAR)slot->buffer;
 
         /* Stamp PTP sequence ID (Big Endian, offset 44-45). These are kernel buffers — safe. */
         pkt[44] = (UCHAR)((seq_id >> 8) & 0xFF);
@@ -284,8 +255,8 @@ IntelAvbFilterFastIoDeviceControl(
         }
         InterlockedExchange64(&ctx->last_ndis_tx_timestamp, (LONGLONG)captureTs);
 
-        /* NdisFSendNetBufferLists MUST NOT be called while holding a spinlock.
-         * Ring fast path: lock-free. Fallback: lock released above. */
+        /* NdisFSendNetBufferLists MUST NOT be called while holding a spinlock;
+         * the slot pool takes none. */
         NdisFSendNetBufferLists(ctx->filter_instance->FilterHandle, nbl, 0, 0);
 
         /* Write back to user buffer (we are at PASSIVE_LEVEL, user buffer is accessible). */
@@ -297,9 +268,6 @@ IntelAvbFilterFastIoDeviceControl(
         IoStatus->Information = sizeof(*req);
     }
     __except(EXCEPTION_EXECUTE_HANDLER) {
-        if (lock_held) {
-            NdisReleaseSpinLock(&ctx->test_send_lock);
-        }
         IoStatus->Status      = GetExceptionCode();
         IoStatus->Information = 0;
     }
@@ -684,7 +652,25 @@ IntelAvbFilterDeviceIoControl(
         case IOCTL_AVB_PFC_ENABLE:                // Implements #219 (REQ-F-PFC-001; req.enable field selects enable/disable)
         case IOCTL_AVB_SRP_REGISTER_STREAM:       // Implements #211 (REQ-F-SRP-001)
         case IOCTL_AVB_SRP_DEREGISTER_STREAM:     // Implements #211 (REQ-F-SRP-002)
+        case IOCTL_AVB_SRP_ENUM_STREAMS:          // Implements REQ-F-SRP-004: paged reservation enumeration
         case IOCTL_AVB_PHC_CROSSTIMESTAMP:        // Implements #48 (REQ-F-IOCTL-PHC-004: PHC↔System Cross-Timestamp)
+        case IOCTL_AVB_PHC_MULTI_SNAPSHOT:        // Implements REQ-F-IOCTL-PHC-005: all-adapter PHC snapshot
+        case IOCTL_AVB_PHC_HOLDOVER:              // Implements REQ-F-PTP-HOLDOVER-001: drift estimate / holdover
+        case IOCTL_AVB_SET_PERIODIC_OUTPUT:       // Implements REQ-F-PTP-PEROUT-001: periodic SDP output
+        case IOCTL_AVB_GET_PERIODIC_OUTPUT_STATS: // Implements REQ-F-PTP-PEROUT-001: edge / jitter statistics
+        case IOCTL_AVB_AUX_CAPTURE:               // Implements REQ-F-PTP-AUXSTREAM-001: streamed AUX timestamps
+        case IOCTL_AVB_TAS_GET_STATE:             // Implements REQ-F-TAS-003: admin/operational schedule switch
+        case IOCTL_AVB_LAUNCH_TIME_CONFIG:        // Implements REQ-F-LAUNCH-002: per-frame launch time horizon / counters
+        case IOCTL_AVB_LAUNCH_PACER:              // Implements REQ-F-LAUNCH-003: software launch-time pacing
+        case IOCTL_AVB_GET_FP_STATS:              // Implements REQ-F-FP-002: 802.3br MAC merge counters
+        case IOCTL_AVB_GET_LAT_HIST:              // Implements REQ-F-STATISTICS-002: latency histograms
+        case IOCTL_AVB_TRACE:                     // Implements REQ-NF-DIAG-TRACE-001: binary datapath trace
+        case IOCTL_AVB_STATS_SNAPSHOT:            // Implements REQ-F-STATISTICS-003: statistics snapshots
+        case IOCTL_AVB_HW_STATS:                  // Implements REQ-F-STATISTICS-004: NIC statistics register sampler
+        case IOCTL_AVB_MMIO_ACCT:                 // Implements REQ-NF-DIAG-MMIO-001: MMIO access accounting
+        case IOCTL_AVB_TEST_POOL:                 // Implements REQ-NF-PERF-TXPOOL-001: SEND_PTP slot pool
+        case IOCTL_AVB_PKTGEN:                    // Implements REQ-NF-TEST-PKTGEN-001: kernel packet generator
+        case IOCTL_AVB_TX_RESIDENCE:              // Implements REQ-F-STATISTICS-005: TX residence per priority
         {
             // MULTI-ADAPTER: Use the adapter context stored in FsContext (set by OPEN_ADAPTER)
             // This ensures IOCTLs are routed to the correct adapter in multi-adapter scenarios
@@ -611,8 +611,8 @@ N.B.:  FILTER can use NdisRegisterDeviceEx to create a device, so the upper
                     // Don't override the state - let the initialization set it correctly
                     DEBUGP(DL_TRACE, "*** AVB CONTEXT INITIALIZED SUCCESSFULLY *** %wZ HW_STATE=%s IfIndex=%u Context=%p\n", 
                            &pFilter->MiniportFriendlyName, AvbHwStateName(avbCtx->hw_state), pFilter->MiniportIfIndex, avbCtx);
-                    /* BUG FIX: stats_filter_attach_count was declared but never incremented (ABI 2.0) */
-                    InterlockedIncrement64(&avbCtx->stats_filter_attach_count);
+                    /* BUG FIX: filter_attach_count was declared but never incremented (ABI 2.0) */
+                    AVB_STAT_INC(avbCtx, AVB_STAT_FILTER_ATTACH);
                 } else {
                     DEBUGP(DL_TRACE, "*** AVB CONTEXT IS NULL *** after successful init for %wZ\n", 
                            &pFilter->MiniportFriendlyName);
@@ -702,8 +702,8 @@ N.B.: When the filter is in Pausing state, it can still process OID requests,
     DEBUGP(DL_TRACE, "===>IntelAvbFilter FilterPause: FilterInstance %p\n", FilterModuleContext);
     if (pFilter->AvbContext != NULL) {
         PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
-        InterlockedIncrement64(&avbCtx->stats_filter_pause_count);
-        InterlockedIncrement64(&avbCtx->stats_pause_restart_generation);
+        AVB_STAT_INC(avbCtx, AVB_STAT_FILTER_PAUSE);
+        AVB_STAT_INC(avbCtx, AVB_STAT_PAUSE_RESTART_GENERATION);
     }
 
     //
@@ -831,7 +831,7 @@ FilterRestart(
     DEBUGP(DL_TRACE, "===>FilterRestart:   FilterModuleContext %p\n", FilterModuleContext);
     if (pFilter->AvbContext != NULL) {
         PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
-        InterlockedIncrement64(&avbCtx->stats_filter_restart_count);
+        AVB_STAT_INC(avbCtx, AVB_STAT_FILTER_RESTART);
     }
 
     FILTER_ASSERT(pFilter->State == FilterPaused);
@@ -1044,7 +1044,7 @@ NOTE: Called at PASSIVE_LEVEL and the filter is in paused state
     DEBUGP(DL_TRACE, "===>FilterDetach:    FilterInstance %p\n", FilterModuleContext);
     if (pFilter->AvbContext != NULL) {
         PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
-        InterlockedIncrement64(&avbCtx->stats_filter_detach_count);
+        AVB_STAT_INC(avbCtx, AVB_STAT_FILTER_DETACH);
     }
 
 
@@ -1202,8 +1202,8 @@ NOTE: Called at <= DISPATCH_LEVEL  (unlike a miniport's MiniportOidRequest)
     DEBUGP(DL_TRACE, "===>FilterOidRequest: Request %p.\n", Request);
     if (pFilter->AvbContext != NULL) {
         PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
-        InterlockedIncrement64(&avbCtx->stats_oid_request_count);
-        InterlockedIncrement64(&avbCtx->stats_outstanding_oids);
+        AVB_STAT_INC(avbCtx, AVB_STAT_OID_REQUEST);
+        AVB_STAT_INC(avbCtx, AVB_STAT_OUTSTANDING_OIDS);
     }
 
     //
@@ -1402,14 +1402,8 @@ Arguments:
     DEBUGP(DL_TRACE, "===>FilterOidRequestComplete, Request %p.\n", Request);
     if (pFilter->AvbContext != NULL) {
         PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
-        InterlockedIncrement64(&avbCtx->stats_oid_complete_count);
-        {
-            /* UNDERFLOW GUARD: RESET may zero this gauge while an OID is in-flight. */
-            LONGLONG result = InterlockedDecrement64(&avbCtx->stats_outstanding_oids);
-            if (result < 0) {
-                InterlockedCompareExchange64(&avbCtx->stats_outstanding_oids, 0LL, result);
-            }
-        }
+        AVB_STAT_INC(avbCtx, AVB_STAT_OID_COMPLETE);
+        AVB_STAT_DEC(avbCtx, AVB_STAT_OUTSTANDING_OIDS);
     }
 
     Context = (PFILTER_REQUEST_CONTEXT)(&Request->SourceReserved[0]);
@@ -1509,7 +1503,7 @@ NOTE: called at <= DISPATCH_LEVEL
     DEBUGP(DL_TRACE, "===>FilterStatus, IndicateStatus = %8x.\n", StatusIndication->StatusCode);
     if (pFilter->AvbContext != NULL) {
         PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
-        InterlockedIncrement64(&avbCtx->stats_filter_status_count);
+        AVB_STAT_INC(avbCtx, AVB_STAT_FILTER_STATUS);
     }
 
 
@@ -1648,7 +1642,7 @@ NOTE: called at PASSIVE_LEVEL
 
     if (pFilter->AvbContext != NULL) {
         PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
-        InterlockedIncrement64(&avbCtx->stats_filter_net_pnp_count);
+        AVB_STAT_INC(avbCtx, AVB_STAT_FILTER_NET_PNP);
     }
 
     //
@@ -1722,49 +1716,16 @@ Return Value:
     // list, and the scratch fields are don't-care).
     //
 
-    if (pFilter->TrackSends)
-    {
-        CurrNbl = NetBufferLists;
-        while (CurrNbl)
-        {
-            NumOfSendCompletes++;
-            CurrNbl = NET_BUFFER_LIST_NEXT_NBL(CurrNbl);
-
-        }
-        DispatchLevel = NDIS_TEST_SEND_AT_DISPATCH_LEVEL(SendCompleteFlags);
-        FILTER_ACQUIRE_LOCK(&pFilter->Lock, DispatchLevel);
-        pFilter->OutstandingSends -= NumOfSendCompletes;
-        FILTER_LOG_SEND_REF(2, pFilter, PrevNbl, pFilter->OutstandingSends);
-        FILTER_RELEASE_LOCK(&pFilter->Lock, DispatchLevel);
-    }
-
     // Send complete the NBLs.  If you removed any NBLs from the chain, make
     // sure the chain isn't empty (i.e., NetBufferLists!=NULL).
 
     // Step 8b: Handle test packet injection completions (kernel-originated NBLs)
     // Remove test NBLs from chain and free resources (do NOT send complete up to protocol)
+    // The same walk counts the NBLs that complete upward for the TrackSends
+    // reference and the outstanding send gauge (REQ-F-STATISTICS-001).
+    // Injected test NBLs never passed FilterSendNetBufferLists, so they are
+    // not counted.
     PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
-    if (avbCtx != NULL) {
-        /* FIX: Count the batch being completed. FilterSendNetBufferLists increments
-         * per-NBL; a single InterlockedDecrement underflows when the completion
-         * batch is smaller than the original send batch (NDIS may split batches). */
-        LONGLONG nCompleted = 0;
-        {
-            PNET_BUFFER_LIST _n = NetBufferLists;
-            while (_n) { nCompleted++; _n = NET_BUFFER_LIST_NEXT_NBL(_n); }
-        }
-        {
-            /* UNDERFLOW GUARD: IOCTL_AVB_RESET_STATISTICS may zero this gauge while
-             * sends are in-flight. If the decrement races with a reset, the result
-             * goes negative (LONGLONG) which casts to ~UINT64_MAX in GET_STATISTICS.
-             * CAS-clamp to 0: if we produced a negative value, replace it with 0.
-             * The CAS fails harmlessly if another thread already fixed or incremented. */
-            LONGLONG result = InterlockedAdd64(&avbCtx->stats_outstanding_send_nbls, -nCompleted);
-            if (result < 0) {
-                InterlockedCompareExchange64(&avbCtx->stats_outstanding_send_nbls, 0LL, result);
-            }
-        }
-    }
     PNET_BUFFER_LIST PrevNbl = NULL;
     CurrNbl = NetBufferLists;
     while (CurrNbl) {
@@ -1836,53 +1797,18 @@ Return Value:
                 }
             }
 
-            // Return NBL to ring (fast path) or free from pool (fallback slow path).
-            if (avbCtx) {
-                BOOLEAN returned_to_ring = FALSE;
-                for (int _ri = 0; _ri < AVB_TEST_NBL_RING_SIZE; _ri++) {
-                    if (avbCtx->test_nbl_ring[_ri].nbl == CurrNbl) {
-                        // Ring-allocated: clear OOB timestamp slot.
-                        CurrNbl->NetBufferListInfo[AVB_TX_TIMESTAMP_SLOT] = NULL;
-                        // Atomically swap in_use back; check old value for deferred-cleanup.
-                        LONG old_in_use = InterlockedExchange(&avbCtx->test_nbl_ring[_ri].in_use, 0);
-                        if (old_in_use == 2) {
-                            // BUGFIX (UAF/BSOD): Cleanup deferred this slot because it was
-                            // in-flight when AvbCleanupDevice ran.  Free slot resources now so
-                            // the pools (which cleanup kept alive) can be released safely.
-                            // MUST set returned_to_ring=TRUE to prevent the pool-free fallback
-                            // below from reading NET_BUFFER_LIST_FIRST_NB(CurrNbl) after free
-                            // (UAF) and calling NdisFreeNetBuffer a second time (double-free),
-                            // which caused the PAGE_FAULT_IN_NONPAGED_AREA (0x50) BSOD at
-                            // ndis!NdisFreeNetBuffer+0x54 when the freed page was unmapped.
-                            PNET_BUFFER      to_free_nb  = avbCtx->test_nbl_ring[_ri].nb;
-                            PMDL             to_free_mdl = avbCtx->test_nbl_ring[_ri].mdl;
-                            PVOID            to_free_buf = avbCtx->test_nbl_ring[_ri].buffer;
-                            avbCtx->test_nbl_ring[_ri].nb     = NULL;
-                            avbCtx->test_nbl_ring[_ri].nbl    = NULL;
-                            avbCtx->test_nbl_ring[_ri].mdl    = NULL;
-                            avbCtx->test_nbl_ring[_ri].buffer = NULL;
-                            NdisFreeNetBufferList(CurrNbl);
-                            if (to_free_nb)  NdisFreeNetBuffer(to_free_nb);
-                            if (to_free_mdl) IoFreeMdl(to_free_mdl);
-                            if (to_free_buf) ExFreePoolWithTag(to_free_buf, FILTER_ALLOC_TAG);
-                            InterlockedDecrement(&avbCtx->ring_cleanup_deferred);
-                            returned_to_ring = TRUE;  // slot handled; skip pool-free fallback
-                        } else {
-                            // Normal completion: return slot for reuse.
-                            returned_to_ring = TRUE;
-                        }
-                        break;
-                    }
+            // Return the slot to its pool (O(1): the NBL context names it) - a packet
+            // generator frame (REQ-NF-TEST-PKTGEN-001) or a SEND_PTP slot (REQ-NF-PERF-TXPOOL-001).
+            // AvbTestSlotComplete also frees slots whose free AvbCleanupDevice deferred;
+            // after TRUE, CurrNbl must not be touched (UAF / double-free, BSOD 0x50).
+            if (avbCtx && !AvbPktGenComplete(avbCtx, CurrNbl) && !AvbTestSlotComplete(avbCtx, CurrNbl)) {
+                // Not a pool slot: free normally.
+                PNET_BUFFER test_nb = NET_BUFFER_LIST_FIRST_NB(CurrNbl);
+                if (test_nb && avbCtx->nb_pool_handle) {
+                    NdisFreeNetBuffer(test_nb);
                 }
-                if (!returned_to_ring) {
-                    // Pool-allocated (ring-full fallback): free normally.
-                    PNET_BUFFER test_nb = NET_BUFFER_LIST_FIRST_NB(CurrNbl);
-                    if (test_nb && avbCtx->nb_pool_handle) {
-                        NdisFreeNetBuffer(test_nb);
-                    }
-                    if (avbCtx->nbl_pool_handle) {
-                        NdisFreeNetBufferList(CurrNbl);
-                    }
+                if (avbCtx->nbl_pool_handle) {
+                    NdisFreeNetBufferList(CurrNbl);
                 }
             }
 
@@ -1899,13 +1825,33 @@ Return Value:
             
             // Note: Do NOT advance PrevNbl (we removed CurrNbl from chain)
         } else {
-            // Normal packet - keep in chain
+            // Normal packet - keep in chain; a TX residence sample (REQ-F-STATISTICS-005)
+            // is recorded and its NBL context freed before the NBL goes up
+            if (avbCtx && avbCtx->txres_outstanding != 0) {
+                AvbTxResComplete(avbCtx, CurrNbl);
+            }
             PrevNbl = CurrNbl;
+            NumOfSendCompletes++;
         }
         
         CurrNbl = NextNbl;
     }
 
+    if (pFilter->TrackSends && NumOfSendCompletes != 0)
+    {
+        DispatchLevel = NDIS_TEST_SEND_AT_DISPATCH_LEVEL(SendCompleteFlags);
+        FILTER_ACQUIRE_LOCK(&pFilter->Lock, DispatchLevel);
+        pFilter->OutstandingSends -= NumOfSendCompletes;
+        FILTER_LOG_SEND_REF(2, pFilter, NetBufferLists, pFilter->OutstandingSends);
+        FILTER_RELEASE_LOCK(&pFilter->Lock, DispatchLevel);
+    }
+    if (avbCtx != NULL && NumOfSendCompletes != 0) {
+        /* Per-CPU slot: the completing core may differ from the sending one,
+         * so a single slot can go negative; only the sum is meaningful.
+         * Counted per NBL: NDIS may complete a send batch in smaller pieces. */
+        AVB_STAT_ADD(avbCtx, AVB_STAT_OUTSTANDING_SEND_NBLS, -(LONGLONG)NumOfSendCompletes);
+    }
+
     // Send complete remaining NBLs (test NBLs were removed)
     // Safety check: only call if chain not empty
     if (NetBufferLists != NULL) {
@@ -1915,6 +1861,186 @@ Return Value:
 }
 
 
+//
+// FilterPrepareSendChain
+//
+// The one walk of a send chain.  Counts the NBLs, frames and bytes that go
+// down (or to the pacer) into *Acct for the statistics and the outstanding
+// send gauge, and *NblsDown receives the NBLs in the returned chain for the
+// TrackSends reference, so neither needs a walk of its own.
+//
+// Per-frame launch time (REQ-F-LAUNCH-002).  Reads AVB_LAUNCH_TIME_SLOT of the
+// NBLs whose 802.1Q priority is in lt_pcp_mask (nothing is read while it is
+// 0) and leaves the slot as the sender set it.  Frames of the paced priority
+// are handed to the software pacer (REQ-F-LAUNCH-003) with PortNumber, the
+// port the pacer later sends them on; any already due for PortNumber are
+// appended to the chain.  The pacer is the only path that sends a frame at
+// its launch time - the miniport builds the descriptors and takes no launch
+// time from a filter - so every other frame carrying one (another priority,
+// pacer stopped, PHC unreadable) is unlinked and completed with
+// NDIS_STATUS_NOT_SUPPORTED rather than sent early.  The PHC is read at most
+// once per chain, and only if a frame of the paced priority carries a launch
+// time.  Rejected frames are completed here and counted nowhere.
+// While TX residence sampling is on (REQ-F-STATISTICS-005), every NBL that
+// goes down from here is offered to AvbTxResStamp; frames the pacer holds
+// are not (it completes them itself on stop).
+// Returns the chain to send, NULL when every NBL was rejected or held.
+//
+static PNET_BUFFER_LIST
+FilterPrepareSendChain(
+    _In_ PMS_FILTER pFilter,
+    _In_ PNET_BUFFER_LIST NetBufferLists,
+    _In_ NDIS_PORT_NUMBER PortNumber,
+    _In_ BOOLEAN DispatchLevel,
+    _Out_ avb_chain_acct_t *Acct,
+    _Out_ ULONG *NblsDown
+    )
+{
+    PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
+    PNET_BUFFER_LIST    CurrNbl = NetBufferLists;
+    PNET_BUFFER_LIST    PrevNbl = NULL;
+    PNET_BUFFER_LIST    Rejected = NULL;
+    PNET_BUFFER_LIST    RejectedTail = NULL;
+    uint64_t            now = 0;
+    BOOLEAN             haveNow = FALSE;
+    BOOLEAN             held = FALSE;
+    BOOLEAN             sample = avbCtx->txres.pcp_mask != 0;
+    ULONG               ltMask = (ULONG)avbCtx->lt_pcp_mask;
+
+    avb_chain_acct_init(Acct);
+    *NblsDown = 0;
+    while (CurrNbl)
+    {
+        PNET_BUFFER_LIST NextNbl = NET_BUFFER_LIST_NEXT_NBL(CurrNbl);
+        ULONG64 launch = 0;
+        ULONG pcp = 0;
+        NDIS_STATUS status;
+        BOOLEAN paced = FALSE;
+        PNET_BUFFER nb;
+        ULONG frames = 0;
+        ULONG64 bytes = 0;
+
+        // Sized before the pacer can own (and complete) the NBL
+        for (nb = NET_BUFFER_LIST_FIRST_NB(CurrNbl); nb != NULL; nb = NET_BUFFER_NEXT_NB(nb))
+        {
+            frames++;
+            bytes += NET_BUFFER_DATA_LENGTH(nb);
+        }
+
+        // The slot is the sender's: only read where launch times were enabled
+        if (ltMask != 0)
+        {
+            NDIS_NET_BUFFER_LIST_8021Q_INFO q;
+            q.Value = NET_BUFFER_LIST_INFO(CurrNbl, Ieee8021QNetBufferListInfo);
+            pcp = (ULONG)q.TagHeader.UserPriority;
+            if ((ltMask & (1u << pcp)) != 0)
+            {
+                launch = (ULONG64)(ULONG_PTR)NET_BUFFER_LIST_INFO(CurrNbl, AVB_LAUNCH_TIME_SLOT);
+            }
+        }
+
+        if (launch == 0)
+        {
+            if (sample)
+            {
+                AvbTxResStamp(avbCtx, CurrNbl);
+            }
+            avb_chain_acct_add(Acct, frames, bytes);
+            (*NblsDown)++;
+            PrevNbl = CurrNbl;
+            CurrNbl = NextNbl;
+            continue;
+        }
+        InterlockedIncrement64(&avbCtx->stats_lt_frames);
+
+        // Only the pacer sends a frame at its launch time: the miniport builds
+        // the TX descriptors and takes no launch time from a filter
+        if (!haveNow && avbCtx->pacer_active && pcp == avbCtx->pacer_tc)
+        {
+            const intel_device_ops_t *ops = intel_get_device_ops(avbCtx->intel_device.device_type);
+            haveNow = TRUE;
+            if (ops == NULL || ops->get_systime == NULL ||
+                ops->get_systime(&avbCtx->intel_device, &now) != 0)
+            {
+                now = 0;
+            }
+        }
+        paced = (now != 0 && avbCtx->pacer_active && pcp == avbCtx->pacer_tc);
+
+        if (PrevNbl)
+        {
+            NET_BUFFER_LIST_NEXT_NBL(PrevNbl) = NextNbl;
+        }
+        else
+        {
+            NetBufferLists = NextNbl;
+        }
+        NET_BUFFER_LIST_NEXT_NBL(CurrNbl) = NULL;
+        status = NDIS_STATUS_NOT_SUPPORTED;
+        if (paced)
+        {
+            // Unlinked first: the pacer timer may send it as soon as it is queued
+            status = AvbPacerHold(avbCtx, CurrNbl, PortNumber, now, launch);
+            if (status == NDIS_STATUS_SUCCESS)
+            {
+                // Counted as sent: the pacer hands it to the miniport later
+                InterlockedIncrement64(&avbCtx->stats_lt_accepted);
+                avb_chain_acct_add(Acct, frames, bytes);
+                held = TRUE;
+                CurrNbl = NextNbl;
+                continue;
+            }
+            if (status == NDIS_STATUS_NOT_ACCEPTED)
+            {
+                status = NDIS_STATUS_NOT_SUPPORTED;     // pacer stopped meanwhile
+            }
+        }
+        if (status == NDIS_STATUS_NOT_SUPPORTED)
+        {
+            // Not sent untimed: the sender asked for a launch time nothing honours
+            InterlockedIncrement64(&avbCtx->stats_lt_no_hw);
+        }
+        NET_BUFFER_LIST_STATUS(CurrNbl) = status;
+        if (RejectedTail)
+        {
+            NET_BUFFER_LIST_NEXT_NBL(RejectedTail) = CurrNbl;
+        }
+        else
+        {
+            Rejected = CurrNbl;
+        }
+        RejectedTail = CurrNbl;
+        CurrNbl = NextNbl;
+    }
+
+    if (held)
+    {
+        // Frames already due go down with this chain; the pacer re-arms its timer
+        ULONG nDue;
+        PNET_BUFFER_LIST Due = AvbPacerTakeDue(avbCtx, PortNumber, now, &nDue);
+        if (Due != NULL)
+        {
+            if (PrevNbl)
+            {
+                NET_BUFFER_LIST_NEXT_NBL(PrevNbl) = Due;
+            }
+            else
+            {
+                NetBufferLists = Due;
+            }
+            *NblsDown += nDue;
+        }
+    }
+
+    if (Rejected != NULL)
+    {
+        // Never reach FilterSendNetBufferListsComplete, and were never counted
+        NdisFSendNetBufferListsComplete(pFilter->FilterHandle, Rejected,
+                    DispatchLevel ? NDIS_SEND_COMPLETE_FLAGS_DISPATCH_LEVEL : 0);
+    }
+    return NetBufferLists;
+}
+
 _Use_decl_annotations_
 VOID
 FilterSendNetBufferLists(
@@ -1948,6 +2074,7 @@ Arguments:
     PNET_BUFFER_LIST    CurrNbl;
     BOOLEAN             DispatchLevel;
     BOOLEAN             bFalse = FALSE;
+    ULONG               NblsDown = 0;
 
     // BUGFIX: GitHub Issue #315 - NULL/invalid pointer check to prevent DRIVER_IRQL_NOT_LESS_OR_EQUAL (0xD1)
     // Race condition: NDIS may call this after FilterDetach if packets are in flight
@@ -1968,18 +2095,6 @@ Arguments:
         return;
     }
 
-    if (pFilter->AvbContext != NULL) {
-        PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
-        /* FIX: Count per-NBL so the gauge correctly tracks outstanding NBLs, not
-         * outstanding calls.  Mirrors the per-NBL decrement in SendComplete. */
-        LONGLONG nSending = 0;
-        {
-            PNET_BUFFER_LIST _n = NetBufferLists;
-            while (_n) { nSending++; _n = NET_BUFFER_LIST_NEXT_NBL(_n); }
-        }
-        InterlockedAdd64(&avbCtx->stats_outstanding_send_nbls, nSending);
-    }
-
     do
     {
 
@@ -2011,17 +2126,41 @@ Arguments:
         }
         FILTER_RELEASE_LOCK(&pFilter->Lock, DispatchLevel);
 #endif
-        if (pFilter->TrackSends)
+        if (pFilter->AvbContext != NULL)
         {
-            FILTER_ACQUIRE_LOCK(&pFilter->Lock, DispatchLevel);
-            CurrNbl = NetBufferLists;
-            while (CurrNbl)
+            PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
+            avb_chain_acct_t acct;
+
+            NetBufferLists = FilterPrepareSendChain(pFilter, NetBufferLists, PortNumber, DispatchLevel,
+                                                    &acct, &NblsDown);
+            // Per NBL: NDIS may complete the batch in pieces.  A held frame the
+            // pacer sends and the miniport completes before this add lands makes
+            // the gauge sum dip for that instant; reads clamp it at 0.
+            if (acct.nbls != 0)
             {
-                pFilter->OutstandingSends++;
-                FILTER_LOG_SEND_REF(1, pFilter, CurrNbl, pFilter->OutstandingSends);
-
-                CurrNbl = NET_BUFFER_LIST_NEXT_NBL(CurrNbl);
+                AVB_STAT_ADD(avbCtx, AVB_STAT_OUTSTANDING_SEND_NBLS, acct.nbls);
+                AVB_STAT_ADD(avbCtx, AVB_STAT_TX_PACKETS, acct.frames);
+                AVB_STAT_ADD(avbCtx, AVB_STAT_TX_BYTES, acct.bytes);
+            }
+            AVB_TRACE(avbCtx, AVB_TR_TX_CHAIN, NblsDown, acct.nbls, acct.frames, acct.bytes);
+            if (NetBufferLists == NULL)
+            {
+                break;
+            }
+        }
+        else if (pFilter->TrackSends)
+        {
+            for (CurrNbl = NetBufferLists; CurrNbl != NULL; CurrNbl = NET_BUFFER_LIST_NEXT_NBL(CurrNbl))
+            {
+                NblsDown++;
             }
+        }
+
+        if (pFilter->TrackSends)
+        {
+            FILTER_ACQUIRE_LOCK(&pFilter->Lock, DispatchLevel);
+            pFilter->OutstandingSends += NblsDown;
+            FILTER_LOG_SEND_REF(1, pFilter, NetBufferLists, pFilter->OutstandingSends);
             FILTER_RELEASE_LOCK(&pFilter->Lock, DispatchLevel);
         }
 
@@ -2034,56 +2173,10 @@ Arguments:
         //
 
         //
-        // STEP 5c: Attach HW timestamp metadata for PTP packets
-        // This tells the Intel miniport to set the 2STEP_1588 bit in the TX descriptor,
-        // which triggers hardware TX timestamp capture into TXSTMPL/TXSTMPH registers.
-        //
-        // Implementation based on German technical guide provided by user.
+        // STEP 5c: PTP TX timestamps need no per-NBL work here.  The Intel
+        // miniport detects PTP by EtherType (ETHERTYPE_PTP) and TSYNCTXCTL;
+        // the hardware latches SYSTIM at SFD without NBL OOB metadata.
         //
-        if (pFilter->HwTimestampEnabled)
-        {
-            CurrNbl = NetBufferLists;
-            while (CurrNbl)
-            {
-                PNET_BUFFER currNb = NET_BUFFER_LIST_FIRST_NB(CurrNbl);
-                
-                if (currNb != NULL)
-                {
-                    // Access Ethernet header to check EtherType at offset 12-13
-                    // PTP packets use ETHERTYPE_PTP (IEEE 1588 over Ethernet Layer 2)
-                    unsigned char headerBuffer[14];  // Ethernet header size
-                    PVOID dataBuffer;
-                    ULONG dataLength;
-                    
-                    // Get pointer to data in first MDL
-                    NdisQueryMdl(
-                        NET_BUFFER_CURRENT_MDL(currNb),
-                        &dataBuffer,
-                        &dataLength,
-                        NormalPagePriority | MdlMappingNoExecute
-                    );
-                    
-                    if (dataBuffer != NULL && dataLength >= 14)
-                    {
-                        // Copy header safely
-                        NdisMoveMemory(headerBuffer, 
-                                      (PUCHAR)dataBuffer + NET_BUFFER_CURRENT_MDL_OFFSET(currNb), 
-                                      14);
-                        
-                        // Extract EtherType (Big Endian at offset 12-13)
-                        USHORT etherType = (headerBuffer[12] << 8) | headerBuffer[13];
-                        
-                        if (etherType == ETHERTYPE_PTP)  // IEEE 1588 PTP EtherType
-                        {
-                            // Intel miniport detects PTP via EtherType= ETHERTYPE_PTP + TSYNCTXCTL register;
-                            // hardware latches SYSTIM at SFD without needing NBL OOB metadata.
-                        }
-                    }
-                }
-                
-                CurrNbl = NET_BUFFER_LIST_NEXT_NBL(CurrNbl);
-            }
-        }
 
         NdisFSendNetBufferLists(pFilter->FilterHandle, NetBufferLists, PortNumber, SendFlags);
 
@@ -2139,23 +2232,6 @@ Arguments:
     }
 
     DEBUGP(DL_TRACE, "===>ReturnNetBufferLists, NetBufferLists is %p.\n", NetBufferLists);
-    if (pFilter->AvbContext != NULL) {
-        PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
-        /* Count actual NBLs being returned — NDIS may return a subset of an original
-         * indication batch, so we cannot assume 1:1 with FilterReceiveNetBufferLists
-         * calls. Decrement by the real chain length to keep the gauge balanced. */
-        PNET_BUFFER_LIST countNbl = NetBufferLists;
-        LONGLONG nblCount = 0;
-        while (countNbl) { nblCount++; countNbl = NET_BUFFER_LIST_NEXT_NBL(countNbl); }
-        {
-            /* UNDERFLOW GUARD: same race as send path — RESET may zero this while
-             * receives are in-flight, causing subsequent returns to go negative. */
-            LONGLONG result = InterlockedAdd64(&avbCtx->stats_outstanding_receive_nbls, -nblCount);
-            if (result < 0) {
-                InterlockedCompareExchange64(&avbCtx->stats_outstanding_receive_nbls, 0LL, result);
-            }
-        }
-    }
 
 
     //
@@ -2173,7 +2249,13 @@ Arguments:
     // list, and the scratch fields are don't-care).
     //
 
-    if (pFilter->TrackReceives)
+    //
+    // One walk counts the chain for both the TrackReceives reference and the
+    // outstanding receive gauge.  NDIS may return a subset of an original
+    // indication batch, so the count is the real chain length, not 1:1 with
+    // FilterReceiveNetBufferLists calls.
+    //
+    if (pFilter->TrackReceives || pFilter->AvbContext != NULL)
     {
         while (CurrNbl)
         {
@@ -2181,6 +2263,11 @@ Arguments:
             CurrNbl = NET_BUFFER_LIST_NEXT_NBL(CurrNbl);
         }
     }
+    if (pFilter->AvbContext != NULL)
+    {
+        PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
+        AVB_STAT_ADD(avbCtx, AVB_STAT_OUTSTANDING_RECEIVE_NBLS, -(LONGLONG)NumOfNetBufferLists);
+    }
 
 
     // Return the received NBLs.  If you removed any NBLs from the chain, make
@@ -2276,7 +2363,7 @@ N.B.: It is important to check the ReceiveFlags in NDIS_TEST_RECEIVE_CANNOT_PEND
         /* Use NumberOfNetBufferLists (batch size) not +1: a single call may carry
          * multiple NBLs, and NDIS may return them in smaller sub-batches via
          * FilterReturnNetBufferLists, causing underflow if we only increment by 1. */
-        InterlockedAdd64(&avbCtx->stats_outstanding_receive_nbls, (LONGLONG)NumberOfNetBufferLists);
+        AVB_STAT_ADD(avbCtx, AVB_STAT_OUTSTANDING_RECEIVE_NBLS, NumberOfNetBufferLists);
     }
     do
     {
@@ -2319,147 +2406,95 @@ N.B.: It is important to check the ReceiveFlags in NDIS_TEST_RECEIVE_CANNOT_PEND
         //
         // FIXED: Use per-adapter context instead of global g_AvbContext
         // This fixes multi-adapter support - each adapter has its own hardware context
+        //
+        // One walk of the chain: RX packet / byte statistics for every NBL,
+        // PTP classification (src/nbl_chain.h) once the BAR is mapped.
         PAVB_DEVICE_CONTEXT avbCtx = (PAVB_DEVICE_CONTEXT)pFilter->AvbContext;
-        if (avbCtx && avbCtx->hw_state >= AVB_HW_BAR_MAPPED) {
-            PNET_BUFFER_LIST nbl = NetBufferLists;
-            while (nbl) {
+        if (avbCtx != NULL) {
+            BOOLEAN classify = (avbCtx->hw_state >= AVB_HW_BAR_MAPPED);
+            avb_chain_acct_t acct;
+            PNET_BUFFER_LIST nbl;
+
+            avb_chain_acct_init(&acct);
+            for (nbl = NetBufferLists; nbl != NULL; nbl = NET_BUFFER_LIST_NEXT_NBL(nbl)) {
                 PNET_BUFFER nb = NET_BUFFER_LIST_FIRST_NB(nbl);
-                if (nb) {
-                    ULONG dataLength = NET_BUFFER_DATA_LENGTH(nb);
-                    if (dataLength >= 14 + 34) {  /* Ethernet (14) + PTP header (34) minimum */
-                        PUCHAR pData = NULL;
-                        __try {
-                            pData = (PUCHAR)NdisGetDataBuffer(nb, 14 + 34, NULL, 1, 0);
-                        } __except(EXCEPTION_EXECUTE_HANDLER) {
-                            pData = NULL;
-                        }
-                        
-                        if (pData) {
-                            /* Parse Ethernet header */
-                            USHORT etherType = ((USHORT)pData[12] << 8) | pData[13];
-                            USHORT vlan_id = FILTER_VLAN_NONE;  /* No VLAN by default */
-                            UCHAR pcp = 0xFF;         /* No PCP by default */
-                            ULONG ptp_offset = 14;    /* PTP header offset after Ethernet */
-                            
-                            /* Debug: Show first few EtherTypes to verify packet parsing */
-                            static int ethertype_count = 0;
-                            if (ethertype_count < 30) {
-                                DEBUGP(DL_TRACE, "!!! PKT #%d: EtherType=0x%04X, len=%u\n", 
-                                       ethertype_count, etherType, dataLength);
-                                ethertype_count++;
-                            }
-                            
-                            /* Check for VLAN tag ETH_P_8021Q */
-                            if (etherType == ETH_P_8021Q && dataLength >= 18 + 34) {
-                                vlan_id = ((USHORT)pData[14] << 8) | pData[15];
-                                pcp = (pData[14] >> 5) & 0x07;
-                                vlan_id &= ETH_VLAN_ID_MASK;  /* Mask to 12 bits */
-                                etherType = ((USHORT)pData[16] << 8) | pData[17];
-                                ptp_offset = 18;  /* PTP after VLAN tag */
-                                
-                                if (ethertype_count <= 30) {
-                                    DEBUGP(DL_TRACE, "!!! VLAN FOUND: ID=%u, PCP=%u, RealEtherType=0x%04X\n", 
-                                           vlan_id, pcp, etherType);
-                                }
-                            }
-                            
-                            /* Check for ETHERTYPE_PTP */
-                            if (etherType == ETHERTYPE_PTP) {
-                                UCHAR messageType = pData[ptp_offset] & 0x0F;  /* Low 4 bits of transportSpecific/messageType */
-                                
-                                DEBUGP(DL_TRACE, "!!! PTP DETECTED: EtherType=0x%04X, msgType=0x%X, VLAN=%u, PCP=%u\n",
-                                       etherType, messageType, vlan_id, pcp);
-                                
-                                /* Filter PTP message types (protocol-aware detection) */
-                                /* IEEE 1588-2019 Table 36: "Values of messageType field"          */
-                                /* Only EVENT messages (0x0-0x3) carry hardware RX timestamps.     */
-                                /* General messages (0x8-0xD) do not cause a new RXSTMPL/H latch;  */
-                                /* reading them would return a stale event-message timestamp.       */
-                                BOOLEAN should_post = FALSE;
-                                switch (messageType) {
-                                    case 0x0:  /* Sync (Event) */
-                                    case 0x1:  /* Delay_Req (Event) */
-                                    case 0x2:  /* Pdelay_Req (Event) */
-                                    case 0x3:  /* Pdelay_Resp (Event) */
-                                        should_post = TRUE;
-                                        DEBUGP(DL_TRACE, "!!! PTP MATCHED: msgType=0x%X will post event\n", messageType);
-                                        break;
-                                    case 0x8:  /* Follow_Up (General) - no HW timestamp */
-                                    case 0x9:  /* Delay_Resp (General) - no HW timestamp */
-                                    case 0xA:  /* Pdelay_Resp_Follow_Up (General) - no HW timestamp */
-                                    case 0xB:  /* Announce (General) - no HW timestamp */
-                                        DEBUGP(DL_TRACE, "PTP SKIP (general msg, no HW ts): msgType=0x%X\n", messageType);
-                                        break;
-                                    default:
-                                        DEBUGP(DL_TRACE, "PTP SKIP: msgType=0x%X (Signaling/Management)\n", messageType);
-                                        break;
-                                }
-                                
-                                if (should_post) {
-                                    /* Read RX timestamp from hardware using device HAL */
-                                    avb_u64 timestamp_ns;
-                                    device_t *dev;
-                                    const intel_device_ops_t *ops;
-                                    
-                                    /* Initialize variables */
-                                    timestamp_ns = 0;
-                                    dev = &avbCtx->intel_device;
-                                    ops = intel_get_device_ops(dev->device_type);
-
-                                    /* Extract IEEE 1588 correctionField from PTP header bytes [8-15].
-                                     * Big-endian signed 64-bit fixed-point, units of 2^-16 ns.
-                                     * MUST be stored as INT64 (signed) — correctionField can be negative.
-                                     * §9.5.9 of IEEE 1588-2019: correctionField = syncTimestamp correction
-                                     * To convert to nanoseconds: (INT64)correction_field >> 16 */
-                                    INT64 correction_field = 0;
-                                    if (dataLength >= ptp_offset + 16) {
-                                        /* Read 8 bytes big-endian from ptp_offset+8 */
-                                        UINT64 cf_raw =
-                                            ((UINT64)pData[ptp_offset + 8]  << 56) |
-                                            ((UINT64)pData[ptp_offset + 9]  << 48) |
-                                            ((UINT64)pData[ptp_offset + 10] << 40) |
-                                            ((UINT64)pData[ptp_offset + 11] << 32) |
-                                            ((UINT64)pData[ptp_offset + 12] << 24) |
-                                            ((UINT64)pData[ptp_offset + 13] << 16) |
-                                            ((UINT64)pData[ptp_offset + 14] <<  8) |
-                                            ((UINT64)pData[ptp_offset + 15]);
-                                        correction_field = (INT64)cf_raw;  /* reinterpret as signed */
-                                    }
-                                    
-                                    /* Use device operations for HAL-compliant register access */
-                                    if (ops && ops->read_rx_timestamp && 
-                                        ops->read_rx_timestamp(dev, &timestamp_ns) == 0) {
-
-                                        /* Apply IEEE 802.1AS ingress latency correction (timestampCorrectionPortDS).
-                                         * ingress_latency_ns compensates for the delay between the physical
-                                         * wire arrival and the hardware timestamp latch.  Default = 0. */
-                                        timestamp_ns = (avb_u64)((INT64)timestamp_ns +
-                                                       InterlockedCompareExchange64(
-                                                           &avbCtx->ingress_latency_ns, 0, 0));
-                                        
-                                        DEBUGP(DL_TRACE, "!!! CALLING AvbPostTimestampEvent: ts=0x%llx, msgType=0x%x, cf=0x%llx\n", timestamp_ns, messageType, (UINT64)correction_field);
-                                        
-                                        /* Post event to matching subscriptions */
-                                        /* FIXED: Pass per-adapter context for multi-adapter support */
-                                        AvbPostTimestampEvent(
-                                            avbCtx,  /* Pass THIS adapter's context */
-                                            TS_EVENT_RX_TIMESTAMP,
-                                            timestamp_ns,
-                                            vlan_id,
-                                            pcp,
-                                            0,  /* queue - not easily available in filter driver */
-                                            (avb_u16)dataLength,
-                                            messageType,  /* Store PTP message type in trigger_source */
-                                            correction_field
-                                        );
-                                    }
-                                }
-                            }
-                        }
+                ULONG dataLength;
+                PUCHAR pData = NULL;
+                avb_ptp_frame_t ptp;
+                int kind;
+
+                if (nb == NULL) {
+                    avb_chain_acct_add(&acct, 0, 0);
+                    continue;
+                }
+                /* Ethernet receive: exactly one NET_BUFFER per NBL */
+                dataLength = NET_BUFFER_DATA_LENGTH(nb);
+                avb_chain_acct_add(&acct, 1, dataLength);
+                if (!classify || dataLength < AVB_PTP_PARSE_LEN) {
+                    continue;
+                }
+                __try {
+                    pData = (PUCHAR)NdisGetDataBuffer(nb, AVB_PTP_PARSE_LEN, NULL, 1, 0);
+                } __except(EXCEPTION_EXECUTE_HANDLER) {
+                    pData = NULL;
+                }
+                if (pData == NULL) {
+                    continue;
+                }
+
+                kind = avb_ptp_classify(pData, dataLength, &ptp);
+                if (kind == AVB_PTP_NONE) {
+                    continue;
+                }
+                /* IEEE 1588-2019 Table 36: "Values of messageType field"          */
+                /* Only EVENT messages (0x0-0x3) carry hardware RX timestamps.     */
+                /* General messages (0x8-0xD) do not cause a new RXSTMPL/H latch;  */
+                /* reading them would return a stale event-message timestamp.       */
+                if (kind != AVB_PTP_EVENT) {
+                    continue;
+                }
+
+                {
+                    /* Read RX timestamp from hardware using device HAL */
+                    ULONG64 classified = AVB_LAT_TICKS();
+                    avb_u64 timestamp_ns = 0;
+                    device_t *dev = &avbCtx->intel_device;
+                    const intel_device_ops_t *ops = intel_get_device_ops(dev->device_type);
+
+                    /* Use device operations for HAL-compliant register access */
+                    if (ops && ops->read_rx_timestamp &&
+                        ops->read_rx_timestamp(dev, &timestamp_ns) == 0) {
+
+                        /* Apply IEEE 802.1AS ingress latency correction (timestampCorrectionPortDS).
+                         * ingress_latency_ns compensates for the delay between the physical
+                         * wire arrival and the hardware timestamp latch.  Default = 0. */
+                        timestamp_ns = (avb_u64)((INT64)timestamp_ns +
+                                       InterlockedCompareExchange64(
+                                           &avbCtx->ingress_latency_ns, 0, 0));
+
+                        /* Post event to matching subscriptions.  correctionField
+                         * (IEEE 1588-2019 9.5.9) is signed, 2^-16 ns units. */
+                        AvbPostTimestampEvent(
+                            avbCtx,  /* Pass THIS adapter's context */
+                            TS_EVENT_RX_TIMESTAMP,
+                            timestamp_ns,
+                            ptp.vlan_id,
+                            ptp.pcp,
+                            0,  /* queue - not easily available in filter driver */
+                            (avb_u16)dataLength,
+                            ptp.msg_type,  /* Store PTP message type in trigger_source */
+                            (INT64)ptp.correction
+                        );
+                        AVB_LAT_RECORD(avbCtx, AVB_LAT_RX_CLASSIFY, classified);
+                        AVB_TRACE(avbCtx, AVB_TR_RX_PTP, dataLength,
+                                  ptp.msg_type | ((ULONG)ptp.pcp << 8) | ((ULONG)ptp.vlan_id << 16),
+                                  timestamp_ns, ptp.correction);
                     }
                 }
-                nbl = NET_BUFFER_LIST_NEXT_NBL(nbl);
             }
+            AVB_STAT_ADD(avbCtx, AVB_STAT_RX_PACKETS, acct.frames);
+            AVB_STAT_ADD(avbCtx, AVB_STAT_RX_BYTES, acct.bytes);
+            AVB_TRACE(avbCtx, AVB_TR_RX_CHAIN, 0, acct.nbls, acct.frames, acct.bytes);
         }
 
         //
@@ -76,6 +76,19 @@ Abstract:
 #endif
 // ---- End NDIS 6.82 TaggedTransmitHw backfill ----
 
+// ---- Per-frame launch time (REQ-F-LAUNCH-002) ----
+//
+// A sender above the filter (an AVTP talker's protocol driver) stores the
+// absolute PHC launch time of a frame as a ULONG64 in
+// NetBufferListInfo[AVB_LAUNCH_TIME_SLOT]; 0 = no launch time.  The slot
+// belongs to the sender, and other protocols may use it for their own data,
+// so FilterSendNetBufferLists reads it only for the 802.1Q priorities enabled
+// in IOCTL_AVB_LAUNCH_TIME_CONFIG (pcp_mask, none by default) and never
+// writes it: every NBL comes back with the sender's value.
+// x64/ARM64 only: the slot is pointer-sized.
+//
+#define AVB_LAUNCH_TIME_SLOT   MediaSpecificInformation
+
 // PTP EtherType for packet detection (IEEE 1588)
 #define ETHERTYPE_PTP   0x88F7  // PTP over Ethernet (Layer 2)
 
@@ -0,0 +1,137 @@
+/*++
+
+Module Name:
+
+    lat_hist.c
+
+Abstract:
+
+    Log-linear latency histograms - implementation.  See lat_hist.h.
+
+--*/
+
+#include "lat_hist.h"
+
+uint64_t avb_lat_bucket_low(uint32_t idx)
+{
+    uint32_t octave, sub;
+
+    if (idx < AVB_LAT_EXACT) {
+        return idx;
+    }
+    if (idx >= AVB_LAT_BUCKETS) {
+        idx = AVB_LAT_BUCKETS - 1u;
+    }
+    octave = (idx - AVB_LAT_EXACT) / AVB_LAT_SUB_COUNT;    /* 0 = [64, 128) */
+    sub    = (idx - AVB_LAT_EXACT) % AVB_LAT_SUB_COUNT;
+    return (uint64_t)(AVB_LAT_SUB_COUNT + sub) << (octave + 1u);
+}
+
+uint64_t avb_lat_bucket_high(uint32_t idx)
+{
+    if (idx < AVB_LAT_EXACT) {
+        return (uint64_t)idx + 1u;
+    }
+    if (idx >= AVB_LAT_BUCKETS) {
+        idx = AVB_LAT_BUCKETS - 1u;
+    }
+    return avb_lat_bucket_low(idx) + (1ull << ((idx - AVB_LAT_EXACT) / AVB_LAT_SUB_COUNT + 1u));
+}
+
+size_t avb_lat_set_bytes(uint32_t cpus)
+{
+    uint32_t slots = cpus < AVB_LAT_MAX_SLOTS ? cpus : AVB_LAT_MAX_SLOTS;
+
+    return (size_t)slots * AVB_LAT_HOT_COUNT * sizeof(avb_lat_hist_t) + AVB_LAT_ALIGN;
+}
+
+void avb_lat_set_init(avb_lat_set_t *s, void *storage, uint32_t cpus, uint64_t tick_hz)
+{
+    if (tick_hz == 0) {
+        tick_hz = 1000000000ull;
+    }
+    s->ns_mult   = (1000000000ull << AVB_LAT_NS_SHIFT) / tick_hz;
+    s->max_ticks = s->ns_mult ? UINT64_MAX / s->ns_mult : UINT64_MAX;
+    s->reserved  = 0;
+    if (storage == NULL || cpus == 0) {
+        s->slots      = NULL;
+        s->slot_count = 0;
+        return;
+    }
+    s->slots = (avb_lat_hist_t *)(((uintptr_t)storage + (AVB_LAT_ALIGN - 1u)) &
+                                  ~(uintptr_t)(AVB_LAT_ALIGN - 1u));
+    s->slot_count = cpus < AVB_LAT_MAX_SLOTS ? cpus : AVB_LAT_MAX_SLOTS;
+}
+
+void avb_lat_sum(const avb_lat_set_t *s, uint32_t id, uint64_t out[AVB_LAT_BUCKETS])
+{
+    uint32_t c, i;
+
+    for (i = 0; i < AVB_LAT_BUCKETS; i++) {
+        out[i] = 0;
+    }
+    for (c = 0; c < s->slot_count; c++) {
+        const avb_lat_hist_t *h = &s->slots[c * AVB_LAT_HOT_COUNT + id];
+        for (i = 0; i < AVB_LAT_BUCKETS; i++) {
+            out[i] += (uint64_t)h->b[i];
+        }
+    }
+}
+
+uint64_t avb_lat_percentile(const uint64_t counts[AVB_LAT_BUCKETS], uint32_t permille)
+{
+    uint64_t total = 0, rank, seen = 0;
+    uint32_t i;
+
+    for (i = 0; i < AVB_LAT_BUCKETS; i++) {
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    /* Smallest rank covering permille / 1000 of the samples, at least 1 */
+    rank = (total * permille + 999u) / 1000u;
+    if (rank == 0) {
+        rank = 1;
+    }
+    for (i = 0; i < AVB_LAT_BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return avb_lat_bucket_high(i);
+        }
+    }
+    return avb_lat_bucket_high(AVB_LAT_BUCKETS - 1u);
+}
+
+void avb_lat_summarize(const uint64_t counts[AVB_LAT_BUCKETS], avb_lat_summary_t *sum)
+{
+    uint64_t weighted = 0;
+    uint32_t i, first = AVB_LAT_BUCKETS, last = 0;
+
+    sum->count = 0;
+    for (i = 0; i < AVB_LAT_BUCKETS; i++) {
+        if (counts[i] == 0) {
+            continue;
+        }
+        if (first == AVB_LAT_BUCKETS) {
+            first = i;
+        }
+        last = i;
+        sum->count += counts[i];
+        /* Midpoint; the exact buckets are their own value */
+        weighted += counts[i] * (i < AVB_LAT_EXACT ? (uint64_t)i :
+                                 (avb_lat_bucket_low(i) + avb_lat_bucket_high(i)) / 2u);
+    }
+    if (sum->count == 0) {
+        sum->min_ns = sum->max_ns = sum->mean_ns = 0;
+        sum->p50_ns = sum->p90_ns = sum->p99_ns = sum->p999_ns = 0;
+        return;
+    }
+    sum->min_ns  = avb_lat_bucket_low(first);
+    sum->max_ns  = avb_lat_bucket_high(last);
+    sum->mean_ns = weighted / sum->count;
+    sum->p50_ns  = avb_lat_percentile(counts, 500u);
+    sum->p90_ns  = avb_lat_percentile(counts, 900u);
+    sum->p99_ns  = avb_lat_percentile(counts, 990u);
+    sum->p999_ns = avb_lat_percentile(counts, 999u);
+}
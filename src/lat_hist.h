@@ -0,0 +1,169 @@
+/*++
+
+Module Name:
+
+    lat_hist.h
+
+Abstract:
+
+    Log-linear latency histograms for the driver's hot paths (the
+    distributions behind IOCTL_AVB_GET_LAT_HIST).
+
+    Bucketing (HDR style): values below 64 ns have a bucket each; above,
+    every power-of-two octave [2^e, 2^(e+1)) is split into 32 equal
+    sub-buckets, so a bucket is at most 1/32 (3.1 %) of its lower bound
+    wide.  34 octaves of range - 1 ns to 17 s - in AVB_LAT_BUCKETS (960)
+    64-bit counts; longer spans land in the last bucket.  The index is a
+    bit scan, a shift and an add - no division, no table.
+
+    Recording: one slot of AVB_LAT_HOT_COUNT histograms per processor (at
+    most AVB_LAT_MAX_SLOTS; further processors share slots modulo), so a
+    sample is an interlocked increment on a line the local processor
+    owns.  Spans are taken in raw clock ticks (the TSC on x86 / x64) and
+    scaled to ns by a multiply and a shift.  Readers sum the slots.
+
+    Pure C99 (stdint only); the caller supplies the processor index, the
+    clock and the atomic increment.  tests/performance/test_lat_hist_bench.c
+    checks the bucket bounds and measures the per-sample cost;
+    tools/lat_hist/lat_decode.c prints percentiles from the counts.
+
+    Implements: REQ-F-STATISTICS-002 (Driver latency histograms)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Hot-path histograms, one set per processor slot (AVB_LAT_HIST_* in avb_ioctl.h) */
+#define AVB_LAT_RX_CLASSIFY     0u  /* PTP event frame classified -> RX timestamp event posted */
+#define AVB_LAT_TX_TS_POST      1u  /* TX timestamp read from the FIFO -> event posted */
+#define AVB_LAT_DPC             2u  /* TX timestamp poll DPC, whole run */
+#define AVB_LAT_MMIO_READ       3u  /* one BAR0 register read */
+#define AVB_LAT_HOT_COUNT       4u
+
+#define AVB_LAT_SUB_BITS        5u
+#define AVB_LAT_SUB_COUNT       (1u << AVB_LAT_SUB_BITS)            /* 32 per octave */
+#define AVB_LAT_EXACT           (2u * AVB_LAT_SUB_COUNT)            /* 0..63 ns: one bucket each */
+#define AVB_LAT_MAX_BITS        34u                                 /* top octave [2^33, 2^34) ns */
+#define AVB_LAT_BUCKETS         (AVB_LAT_EXACT + (AVB_LAT_MAX_BITS - AVB_LAT_SUB_BITS - 1u) * AVB_LAT_SUB_COUNT)
+
+#define AVB_LAT_MAX_SLOTS       16u
+#define AVB_LAT_ALIGN           64u
+#define AVB_LAT_NS_SHIFT        24u
+
+typedef struct _avb_lat_hist {
+    volatile int64_t b[AVB_LAT_BUCKETS];
+} avb_lat_hist_t;
+
+typedef struct _avb_lat_set {
+    avb_lat_hist_t *slots;      /* slot_count x AVB_LAT_HOT_COUNT, slot-major, AVB_LAT_ALIGN aligned */
+    uint32_t        slot_count; /* 0: no storage, nothing is recorded */
+    uint32_t        reserved;
+    uint64_t        ns_mult;    /* ns = (ticks * ns_mult) >> AVB_LAT_NS_SHIFT */
+    uint64_t        max_ticks;  /* longer spans are clamped before the multiply */
+} avb_lat_set_t;
+
+/** Index of the highest set bit; v != 0 */
+static __inline uint32_t avb_lat_msb(uint64_t v)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long i;
+    _BitScanReverse64(&i, v);
+    return (uint32_t)i;
+#elif defined(__GNUC__)
+    return 63u - (uint32_t)__builtin_clzll(v);
+#else
+    uint32_t i = 0;
+    while (v >>= 1) {
+        i++;
+    }
+    return i;
+#endif
+}
+
+/** Bucket of a span of ns nanoseconds */
+static __inline uint32_t avb_lat_index(uint64_t ns)
+{
+    uint32_t e, idx;
+
+    if (ns < AVB_LAT_EXACT) {
+        return (uint32_t)ns;
+    }
+    e = avb_lat_msb(ns);
+    if (e >= AVB_LAT_MAX_BITS) {
+        return AVB_LAT_BUCKETS - 1u;
+    }
+    /* The top AVB_LAT_SUB_BITS + 1 bits, leading one dropped, pick the sub-bucket */
+    idx = AVB_LAT_EXACT + (e - AVB_LAT_SUB_BITS - 1u) * AVB_LAT_SUB_COUNT +
+          (uint32_t)(ns >> (e - AVB_LAT_SUB_BITS)) - AVB_LAT_SUB_COUNT;
+    return idx;
+}
+
+/** Clock ticks to ns; a negative span (clock read on two processors) counts as 0 */
+static __inline uint64_t avb_lat_ns(const avb_lat_set_t *s, uint64_t ticks)
+{
+    if ((int64_t)ticks < 0) {
+        return 0;
+    }
+    if (ticks > s->max_ticks) {
+        ticks = s->max_ticks;
+    }
+    return (ticks * s->ns_mult) >> AVB_LAT_NS_SHIFT;
+}
+
+/** Histogram id of processor cpu; NULL when recording is off */
+static __inline avb_lat_hist_t *avb_lat_slot(avb_lat_set_t *s, uint32_t cpu, uint32_t id)
+{
+    if (s->slot_count == 0) {
+        return NULL;
+    }
+    return &s->slots[(cpu % s->slot_count) * AVB_LAT_HOT_COUNT + id];
+}
+
+/** First ns value of bucket idx */
+uint64_t avb_lat_bucket_low(uint32_t idx);
+
+/** First ns value past bucket idx (the last bucket is open-ended; its nominal end is returned) */
+uint64_t avb_lat_bucket_high(uint32_t idx);
+
+/** Bytes of storage avb_lat_set_init needs for cpus processors (alignment slack included) */
+size_t avb_lat_set_bytes(uint32_t cpus);
+
+/**
+ * storage: avb_lat_set_bytes(cpus) zeroed bytes, any alignment, owned by the
+ * caller; NULL turns recording off.  tick_hz: frequency of the clock the
+ * spans are taken with.
+ */
+void avb_lat_set_init(avb_lat_set_t *s, void *storage, uint32_t cpus, uint64_t tick_hz);
+
+/** Sum of histogram id over every slot (plain reads) */
+void avb_lat_sum(const avb_lat_set_t *s, uint32_t id, uint64_t out[AVB_LAT_BUCKETS]);
+
+typedef struct _avb_lat_summary {
+    uint64_t count;
+    uint64_t min_ns;            /* low end of the first non-empty bucket */
+    uint64_t max_ns;            /* high end of the last non-empty bucket */
+    uint64_t mean_ns;           /* from bucket midpoints */
+    uint64_t p50_ns;            /* percentiles: high end of the bucket holding the rank */
+    uint64_t p90_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+} avb_lat_summary_t;
+
+/** Value at or below which permille / 1000 of the samples fall (bucket high end); 0 if empty */
+uint64_t avb_lat_percentile(const uint64_t counts[AVB_LAT_BUCKETS], uint32_t permille);
+
+void avb_lat_summarize(const uint64_t counts[AVB_LAT_BUCKETS], avb_lat_summary_t *sum);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,68 @@
+/*++
+
+Module Name:
+
+    launch_time.c
+
+Abstract:
+
+    Per-frame launch time window check - implementation.  See
+    launch_time.h.
+
+--*/
+
+#include "launch_time.h"
+
+/* Start of the cycle containing now_ns */
+static uint64_t cycle_start(const avb_lt_params_t *p, uint64_t now_ns)
+{
+    if (now_ns <= p->cycle_base_ns) {
+        return p->cycle_base_ns;
+    }
+    return now_ns - (now_ns - p->cycle_base_ns) % p->cycle_ns;
+}
+
+uint64_t avb_lt_horizon(const avb_lt_params_t *p, uint64_t now_ns)
+{
+    switch (p->format) {
+    case AVB_LT_FMT_I210:
+        return now_ns + AVB_LT_I210_HORIZON_NS - 1u;
+    case AVB_LT_FMT_IGC:
+        /* End of the next cycle (exclusive) */
+        return cycle_start(p, now_ns) + 2u * (uint64_t)p->cycle_ns - 1u;
+    default:
+        return 0;
+    }
+}
+
+int avb_lt_check(const avb_lt_params_t *p, uint64_t now_ns, uint64_t launch_ns)
+{
+    if (p->format != AVB_LT_FMT_I210 && p->format != AVB_LT_FMT_IGC) {
+        return AVB_LT_NO_HW;
+    }
+    if (launch_ns < now_ns + p->min_lead_ns) {
+        return AVB_LT_LATE;
+    }
+    if (launch_ns > avb_lt_horizon(p, now_ns)) {
+        return AVB_LT_BEYOND;
+    }
+
+    if (p->format == AVB_LT_FMT_IGC && launch_ns < cycle_start(p, now_ns)) {
+        return AVB_LT_BEYOND;   /* before the first cycle of a schedule not started yet */
+    }
+    return AVB_LT_OK;
+}
+
+void avb_lt_cycle(const avb_tas_switch_t *sw, uint64_t now_ns, uint64_t *base_ns, uint32_t *cycle_ns)
+{
+    if (sw->state == AVB_TAS_SW_PENDING && !sw->staged && now_ns >= sw->config_change_ns) {
+        *base_ns  = sw->config_change_ns;
+        *cycle_ns = sw->admin_cycle_ns;
+    } else if (avb_tas_switch_running(sw)) {
+        *base_ns  = sw->oper_base_ns;
+        *cycle_ns = sw->oper_cycle_ns;
+    } else {
+        *base_ns  = 0;
+        *cycle_ns = AVB_LT_IGC_DEFAULT_CYCLE_NS;
+    }
+}
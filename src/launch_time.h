@@ -0,0 +1,85 @@
+/*++
+
+Module Name:
+
+    launch_time.h
+
+Abstract:
+
+    Per-frame launch time: the window the adapter's LaunchTime descriptor
+    field can express.
+
+    A sender attaches an absolute PHC launch time to a frame (see
+    AVB_LAUNCH_TIME_SLOT in filter.h).  The adapter's advanced context
+    descriptor could express it only inside this window:
+
+      I210       LaunchTime is 25 bits of 32 ns, the offset in the current
+                 1 s Qav cycle.  The MAC compares it modulo 1 s, so a launch
+                 time is only unambiguous less than half a second ahead.
+      I225/I226  LaunchTime is 30 bits of ns, the offset from the start of the
+                 Qbv cycle current at enqueue.  It may fall in that cycle or
+                 the next one (the descriptor's first-flag marks the next
+                 cycle), the same rule the Linux igc driver applies.  Without
+                 a gate list the MAC runs the default 1 s cycle from time 0.
+
+    Every format also needs min_lead_ns between now and the launch time so
+    the descriptor is fetched before it is due.
+
+    The check is all this module does, and the send path does not apply it:
+    a filter cannot write the TX descriptors the miniport builds, and the
+    Intel miniports take no launch time from a filter, so only the software
+    pacer (lt_pacer.h) sends a frame at its launch time and every other frame
+    carrying one is rejected.  IOCTL_AVB_LAUNCH_TIME_CONFIG reports the
+    horizon for reference.
+
+    Pure C99 (stdint only); avb_lt_cycle reads the schedule from tas_switch.
+
+    Implements: REQ-F-LAUNCH-002 (Per-packet launch time)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "tas_switch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Descriptor format, same values as AVB_LAUNCH_FMT_* in avb_ioctl.h */
+#define AVB_LT_FMT_NONE         0u   /* no LaunchTime in the TX descriptor */
+#define AVB_LT_FMT_I210         1u
+#define AVB_LT_FMT_IGC          2u   /* I225 / I226 */
+
+#define AVB_LT_DEFAULT_LEAD_NS  20000u          /* descriptor fetch margin */
+#define AVB_LT_I210_HORIZON_NS  500000000u      /* half the 1 s compare window */
+#define AVB_LT_IGC_DEFAULT_CYCLE_NS 1000000000u /* cycle without a gate list */
+
+/* avb_lt_check results */
+#define AVB_LT_OK               0
+#define AVB_LT_LATE             1    /* closer than min_lead_ns, or in the past */
+#define AVB_LT_BEYOND           2    /* past the descriptor horizon */
+#define AVB_LT_NO_HW            3    /* format NONE */
+
+typedef struct _avb_lt_params {
+    uint32_t format;            /* AVB_LT_FMT_* */
+    uint32_t min_lead_ns;
+    uint64_t cycle_base_ns;     /* IGC: any cycle start of the running schedule */
+    uint32_t cycle_ns;          /* IGC: cycle time, nonzero */
+    uint32_t reserved;
+} avb_lt_params_t;
+
+/** Latest launch time the descriptor can express for a frame enqueued at now_ns */
+uint64_t avb_lt_horizon(const avb_lt_params_t *p, uint64_t now_ns);
+
+/** Check launch_ns for a frame enqueued at now_ns: AVB_LT_* */
+int avb_lt_check(const avb_lt_params_t *p, uint64_t now_ns, uint64_t launch_ns);
+
+/** Qbv cycle the MAC runs at now_ns: operational list (also while a switch is staged), an armed list past its CCT, or the default */
+void avb_lt_cycle(const avb_tas_switch_t *sw, uint64_t now_ns, uint64_t *base_ns, uint32_t *cycle_ns);
+
+#ifdef __cplusplus
+}
+#endif
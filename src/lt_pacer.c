@@ -0,0 +1,191 @@
+/*++
+
+Module Name:
+
+    lt_pacer.c
+
+Abstract:
+
+    Software launch-time pacer - implementation.  See lt_pacer.h.
+
+--*/
+
+#include <stddef.h>
+
+#include "lt_pacer.h"
+
+static int before(const avb_pacer_entry_t *a, const avb_pacer_entry_t *b)
+{
+    return a->launch_ns < b->launch_ns || (a->launch_ns == b->launch_ns && a->seq < b->seq);
+}
+
+static void sift_up(avb_pacer_entry_t *h, uint32_t i)
+{
+    avb_pacer_entry_t e = h[i];
+
+    while (i > 0) {
+        uint32_t parent = (i - 1u) / 2u;
+        if (!before(&e, &h[parent])) {
+            break;
+        }
+        h[i] = h[parent];
+        i = parent;
+    }
+    h[i] = e;
+}
+
+static void sift_down(avb_pacer_entry_t *h, uint32_t n, uint32_t i)
+{
+    avb_pacer_entry_t e = h[i];
+
+    for (;;) {
+        uint32_t c = 2u * i + 1u;
+        if (c >= n) {
+            break;
+        }
+        if (c + 1u < n && before(&h[c + 1u], &h[c])) {
+            c++;
+        }
+        if (!before(&h[c], &e)) {
+            break;
+        }
+        h[i] = h[c];
+        i = c;
+    }
+    h[i] = e;
+}
+
+static void *pop_head(avb_pacer_t *p)
+{
+    void *item = p->heap[0].item;
+
+    p->count--;
+    if (p->count != 0) {
+        p->heap[0] = p->heap[p->count];
+        sift_down(p->heap, p->count, 0);
+    }
+    return item;
+}
+
+static void record_error(avb_pacer_stats_t *st, int64_t err)
+{
+    uint64_t mag = (err < 0) ? (uint64_t)(-err) : (uint64_t)err;
+    uint64_t us = mag / 1000u;
+    uint32_t b = 0;
+
+    while (us != 0 && b < AVB_PACER_HIST_BUCKETS - 1u) {
+        us >>= 1;
+        b++;
+    }
+    st->hist[b]++;
+    if (st->released == 0 || err < st->err_min_ns) st->err_min_ns = err;
+    if (st->released == 0 || err > st->err_max_ns) st->err_max_ns = err;
+    st->err_abs_sum_ns += mag;
+    st->released++;
+}
+
+void avb_pacer_init(avb_pacer_t *p, avb_pacer_entry_t *storage, uint32_t capacity,
+                    uint64_t max_hold_ns, uint32_t early_ns)
+{
+    p->heap        = storage;
+    p->capacity    = (storage != NULL) ? capacity : 0;
+    p->count       = 0;
+    p->next_seq    = 0;
+    p->max_hold_ns = max_hold_ns;
+    p->early_ns    = early_ns;
+    p->reserved    = 0;
+    avb_pacer_reset_stats(p);
+}
+
+void avb_pacer_reset_stats(avb_pacer_t *p)
+{
+    uint32_t i;
+
+    p->st.held            = 0;
+    p->st.released        = 0;
+    p->st.dropped_full    = 0;
+    p->st.dropped_horizon = 0;
+    p->st.flushed         = 0;
+    p->st.err_min_ns      = 0;
+    p->st.err_max_ns      = 0;
+    p->st.err_abs_sum_ns  = 0;
+    for (i = 0; i < AVB_PACER_HIST_BUCKETS; i++) {
+        p->st.hist[i] = 0;
+    }
+    p->st.max_depth = p->count;
+    p->st.reserved  = 0;
+}
+
+int avb_pacer_enqueue(avb_pacer_t *p, uint64_t now_ns, uint64_t launch_ns, void *item, uint32_t tag)
+{
+    if (p->max_hold_ns != 0 && launch_ns > now_ns && launch_ns - now_ns > p->max_hold_ns) {
+        p->st.dropped_horizon++;
+        return AVB_PACER_BEYOND;
+    }
+    if (p->count >= p->capacity) {
+        p->st.dropped_full++;
+        return AVB_PACER_FULL;
+    }
+    p->heap[p->count].launch_ns = launch_ns;
+    p->heap[p->count].seq       = p->next_seq++;
+    p->heap[p->count].item      = item;
+    p->heap[p->count].tag       = tag;
+    p->heap[p->count].reserved  = 0;
+    sift_up(p->heap, p->count);
+    p->count++;
+    p->st.held++;
+    if (p->count > p->st.max_depth) {
+        p->st.max_depth = p->count;
+    }
+    return AVB_PACER_QUEUED;
+}
+
+int avb_pacer_head_tag(const avb_pacer_t *p, uint32_t *tag)
+{
+    if (p->count == 0) {
+        return 0;
+    }
+    *tag = p->heap[0].tag;
+    return 1;
+}
+
+uint64_t avb_pacer_next(const avb_pacer_t *p)
+{
+    return (p->count != 0) ? p->heap[0].launch_ns : AVB_PACER_NONE;
+}
+
+uint64_t avb_pacer_wakeup(const avb_pacer_t *p)
+{
+    uint64_t next = avb_pacer_next(p);
+
+    if (next == AVB_PACER_NONE) {
+        return AVB_PACER_NONE;
+    }
+    return (next > p->early_ns) ? next - p->early_ns : 0;
+}
+
+void *avb_pacer_pop_due(avb_pacer_t *p, uint64_t now_ns)
+{
+    uint64_t launch;
+
+    if (p->count == 0 || avb_pacer_wakeup(p) > now_ns) {
+        return NULL;
+    }
+    launch = p->heap[0].launch_ns;
+    record_error(&p->st, (int64_t)(now_ns - launch));
+    return pop_head(p);
+}
+
+void *avb_pacer_pop_any(avb_pacer_t *p)
+{
+    if (p->count == 0) {
+        return NULL;
+    }
+    p->st.flushed++;
+    return pop_head(p);
+}
+
+uint64_t avb_pacer_mean_abs_error(const avb_pacer_t *p)
+{
+    return (p->st.released != 0) ? p->st.err_abs_sum_ns / p->st.released : 0;
+}
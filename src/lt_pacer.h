@@ -0,0 +1,114 @@
+/*++
+
+Module Name:
+
+    lt_pacer.h
+
+Abstract:
+
+    Software launch-time pacer.  The miniports take no launch time from a
+    filter, so on every adapter this is what sends a frame at its launch
+    time.
+
+    Frames that carry a launch time are held in a time-ordered queue - a
+    binary min-heap on (launch time, arrival order) in caller-provided
+    storage - and handed to the miniport when the clock reaches their launch
+    time.  The driver drives it from a high-resolution timer armed for
+    avb_pacer_next() and reads the PHC on every expiry; the unit test drives
+    it from a simulated clock.  Each item carries a caller tag (the driver:
+    the NDIS port the frame was sent on), readable for the head before it
+    is popped.
+
+    Release error is "clock at hand-down - launch time": positive when late
+    (timer latency), negative when released inside the early_ns window.
+    Its distribution is kept as min / max / mean |error| and a log2 histogram
+    of |error| (bucket 0 < 1 us, bucket k in [2^(k-1), 2^k) us, the last one
+    open-ended).  The wire adds the miniport's own queuing on top.
+
+    Pure C99 (stdint only).  Callers own locking.
+
+    Implements: REQ-F-LAUNCH-003 (Software launch-time pacing)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_PACER_HIST_BUCKETS      16u
+#define AVB_PACER_NONE              0xFFFFFFFFFFFFFFFFull   /* avb_pacer_next: queue empty */
+
+/* avb_pacer_enqueue results */
+#define AVB_PACER_QUEUED            0
+#define AVB_PACER_FULL              1
+#define AVB_PACER_BEYOND            2   /* launch further ahead than max_hold_ns */
+
+typedef struct _avb_pacer_entry {
+    uint64_t launch_ns;
+    uint64_t seq;           /* arrival order, breaks launch-time ties */
+    void    *item;
+    uint32_t tag;           /* caller's, travels with item */
+    uint32_t reserved;
+} avb_pacer_entry_t;
+
+typedef struct _avb_pacer_stats {
+    uint64_t held;              /* frames queued */
+    uint64_t released;          /* frames popped by avb_pacer_pop_due */
+    uint64_t dropped_full;
+    uint64_t dropped_horizon;
+    uint64_t flushed;           /* frames taken out by avb_pacer_pop_any */
+    int64_t  err_min_ns;        /* valid when released != 0 */
+    int64_t  err_max_ns;
+    uint64_t err_abs_sum_ns;
+    uint64_t hist[AVB_PACER_HIST_BUCKETS];
+    uint32_t max_depth;
+    uint32_t reserved;
+} avb_pacer_stats_t;
+
+typedef struct _avb_pacer {
+    avb_pacer_entry_t *heap;    /* capacity entries, owned by the caller */
+    uint32_t capacity;
+    uint32_t count;
+    uint64_t next_seq;
+    uint64_t max_hold_ns;       /* 0 = no limit */
+    uint32_t early_ns;          /* release up to this much before the launch time */
+    uint32_t reserved;
+    avb_pacer_stats_t st;
+} avb_pacer_t;
+
+void avb_pacer_init(avb_pacer_t *p, avb_pacer_entry_t *storage, uint32_t capacity,
+                    uint64_t max_hold_ns, uint32_t early_ns);
+
+void avb_pacer_reset_stats(avb_pacer_t *p);
+
+/** Queue item (with tag) for launch_ns, the clock reading now_ns.  Returns AVB_PACER_* */
+int avb_pacer_enqueue(avb_pacer_t *p, uint64_t now_ns, uint64_t launch_ns, void *item, uint32_t tag);
+
+/** Tag of the item the next pop returns in *tag; 0 (and *tag untouched) when empty */
+int avb_pacer_head_tag(const avb_pacer_t *p, uint32_t *tag);
+
+/** Earliest launch time queued, or AVB_PACER_NONE */
+uint64_t avb_pacer_next(const avb_pacer_t *p);
+
+/** Clock time at which avb_pacer_pop_due releases the head: next - early_ns, or AVB_PACER_NONE */
+uint64_t avb_pacer_wakeup(const avb_pacer_t *p);
+
+/**
+ * Pop the earliest item if its launch time is within early_ns of now_ns and
+ * record its release error; NULL when nothing is due.
+ */
+void *avb_pacer_pop_due(avb_pacer_t *p, uint64_t now_ns);
+
+/** Pop the earliest item regardless of time (flush); NULL when empty */
+void *avb_pacer_pop_any(avb_pacer_t *p);
+
+/** Mean |release error| in ns, 0 before the first release */
+uint64_t avb_pacer_mean_abs_error(const avb_pacer_t *p);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,58 @@
+/*++
+
+Module Name:
+
+    mmio_acct.c
+
+Abstract:
+
+    MMIO access accounting - implementation.  See mmio_acct.h.
+
+--*/
+
+#include "mmio_acct.h"
+
+size_t avb_mmio_acct_bytes(uint32_t cpus)
+{
+    uint32_t slots = cpus < AVB_MMIO_ACCT_MAX_SLOTS ? cpus : AVB_MMIO_ACCT_MAX_SLOTS;
+
+    return (size_t)slots * sizeof(avb_mmio_acct_slot_t) + AVB_MMIO_ACCT_ALIGN;
+}
+
+void avb_mmio_acct_init(avb_mmio_acct_t *a, void *storage, uint32_t cpus)
+{
+    a->reserved = 0;
+    if (storage == NULL || cpus == 0) {
+        a->slots      = NULL;
+        a->slot_count = 0;
+        return;
+    }
+    a->slots = (avb_mmio_acct_slot_t *)(((uintptr_t)storage + (AVB_MMIO_ACCT_ALIGN - 1u)) &
+                                        ~(uintptr_t)(AVB_MMIO_ACCT_ALIGN - 1u));
+    a->slot_count = cpus < AVB_MMIO_ACCT_MAX_SLOTS ? cpus : AVB_MMIO_ACCT_MAX_SLOTS;
+}
+
+void avb_mmio_acct_sum(const avb_mmio_acct_t *a, avb_mmio_acct_totals_t *out)
+{
+    uint32_t c, d, k, b;
+
+    for (d = 0; d < 2u; d++) {
+        for (k = 0; k < AVB_MMIO_CALLER_COUNT; k++) {
+            for (b = 0; b < AVB_MMIO_BLK_COUNT; b++) {
+                out->count[d][k][b] = 0;
+                out->ticks[d][k][b] = 0;
+            }
+        }
+    }
+    for (c = 0; c < a->slot_count; c++) {
+        const avb_mmio_acct_slot_t *s = &a->slots[c];
+        for (d = 0; d < 2u; d++) {
+            for (k = 0; k < AVB_MMIO_CALLER_COUNT; k++) {
+                for (b = 0; b < AVB_MMIO_BLK_COUNT; b++) {
+                    out->count[d][k][b] += (uint64_t)s->count[d][k][b];
+                    out->ticks[d][k][b] += (uint64_t)s->ticks[d][k][b];
+                }
+            }
+        }
+    }
+}
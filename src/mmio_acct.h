@@ -0,0 +1,161 @@
+/*++
+
+Module Name:
+
+    mmio_acct.h
+
+Abstract:
+
+    MMIO access accounting (the counts behind IOCTL_AVB_MMIO_ACCT):
+    register reads and writes and the clock ticks they took, per
+    register block and per calling subsystem.
+
+    Blocks are fixed offset ranges of BAR0 (avb_mmio_block): PTP clock and
+    timestamp registers, TSN scheduling (Qav / Qbv / launch time),
+    statistics, and everything else (MAC).
+
+    Callers: code running at DISPATCH_LEVEL (DPCs, timer callbacks,
+    spinlock-held sections) names itself by setting its processor slot's
+    caller between avb_mmio_acct_enter and avb_mmio_acct_leave, which
+    nest.  Nothing else runs on that processor meanwhile, so an access in
+    between is charged to that caller.  Accesses below DISPATCH_LEVEL are
+    charged to AVB_MMIO_CALLER_PASSIVE (IOCTL dispatch, bring-up) - a
+    thread there may change processors, so it cannot use a slot's tag.
+    Untagged accesses at DISPATCH_LEVEL count as AVB_MMIO_CALLER_OTHER.
+
+    One slot per processor (at most AVB_MMIO_ACCT_MAX_SLOTS; further
+    processors share slots modulo, and may charge each other's caller).
+    The caller supplies the processor index, the clock and the atomic
+    add; readers sum the slots.
+
+    Pure C99 (stdint only) so tests/performance/test_mmio_acct_bench.c
+    compiles the identical code.  The driver records only when built with
+    AVB_MMIO_ACCT=1 (src/avb_integration.h).
+
+    Implements: REQ-NF-DIAG-MMIO-001 (MMIO access accounting)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Register block (AVB_MMIO_ACCT_BLOCK_* in avb_ioctl.h) */
+#define AVB_MMIO_BLK_MAC            0u  /* everything below */
+#define AVB_MMIO_BLK_PTP            1u  /* 0x0B600-0x0B7FF SYSTIM..TSICR, I225/I226 SYSTIM read 0x0C0C8 */
+#define AVB_MMIO_BLK_TSN            2u  /* 0x03000-0x035FF Qav credits, Qbv gate list, TXQCTL, TQAVCTRL */
+#define AVB_MMIO_BLK_STATS          3u  /* 0x04000-0x04FFF statistics, RQDPC(n) 0x0C030 + 0x40 n */
+#define AVB_MMIO_BLK_COUNT          4u
+
+/* Calling subsystem (AVB_MMIO_ACCT_CALLER_* in avb_ioctl.h) */
+#define AVB_MMIO_CALLER_OTHER       0u  /* DISPATCH_LEVEL, no tag: datapath, spinlock-held IOCTL paths */
+#define AVB_MMIO_CALLER_PASSIVE     1u  /* below DISPATCH_LEVEL: IOCTL dispatch, bring-up */
+#define AVB_MMIO_CALLER_TX_POLL     2u  /* TX timestamp poll DPC, FIFO reads */
+#define AVB_MMIO_CALLER_TARGET_TIME 3u  /* AvbCheckTargetTime (from the poll DPC) */
+#define AVB_MMIO_CALLER_TT_DPC      4u  /* I226 target time DPC */
+#define AVB_MMIO_CALLER_HOLDOVER    5u  /* PHC holdover watchdog */
+#define AVB_MMIO_CALLER_PEROUT      6u  /* periodic output / AUX capture poll */
+#define AVB_MMIO_CALLER_PACER       7u  /* launch-time pacer timer */
+#define AVB_MMIO_CALLER_HW_STATS    8u  /* NIC statistics sampler */
+#define AVB_MMIO_CALLER_COUNT       9u
+
+#define AVB_MMIO_RD                 0u
+#define AVB_MMIO_WR                 1u
+
+#define AVB_MMIO_ACCT_MAX_SLOTS     256u
+#define AVB_MMIO_ACCT_ALIGN         64u
+
+typedef struct _avb_mmio_acct_slot {
+    volatile int64_t  count[2][AVB_MMIO_CALLER_COUNT][AVB_MMIO_BLK_COUNT];  /* [AVB_MMIO_RD / WR] */
+    volatile int64_t  ticks[2][AVB_MMIO_CALLER_COUNT][AVB_MMIO_BLK_COUNT];
+    volatile uint32_t caller;       /* tag of the code running on this processor */
+    uint32_t          pad[15];      /* slot is a whole number of AVB_MMIO_ACCT_ALIGN lines */
+} avb_mmio_acct_slot_t;
+
+typedef struct _avb_mmio_acct {
+    avb_mmio_acct_slot_t *slots;    /* slot_count slots, AVB_MMIO_ACCT_ALIGN aligned */
+    uint32_t              slot_count; /* 0: no storage, nothing is recorded */
+    uint32_t              reserved;
+} avb_mmio_acct_t;
+
+/* Summed slots */
+typedef struct _avb_mmio_acct_totals {
+    uint64_t count[2][AVB_MMIO_CALLER_COUNT][AVB_MMIO_BLK_COUNT];
+    uint64_t ticks[2][AVB_MMIO_CALLER_COUNT][AVB_MMIO_BLK_COUNT];
+} avb_mmio_acct_totals_t;
+
+/** Block of BAR0 register offset */
+static __inline uint32_t avb_mmio_block(uint32_t offset)
+{
+    if (offset >= 0x0B600u && offset < 0x0B800u) {
+        return AVB_MMIO_BLK_PTP;
+    }
+    if (offset >= 0x03000u && offset < 0x03600u) {
+        return AVB_MMIO_BLK_TSN;
+    }
+    if (offset >= 0x04000u && offset < 0x05000u) {
+        return AVB_MMIO_BLK_STATS;
+    }
+    if (offset >= 0x0C000u && offset < 0x0D000u) {
+        if (offset == 0x0C0C8u || offset == 0x0C0CCu) {
+            return AVB_MMIO_BLK_PTP;
+        }
+        if ((offset & 0x3Fu) == 0x30u && offset < 0x0C400u) {
+            return AVB_MMIO_BLK_STATS;          /* RQDPC(0..15) */
+        }
+    }
+    return AVB_MMIO_BLK_MAC;
+}
+
+/** Slot of processor cpu; NULL when accounting has no storage */
+static __inline avb_mmio_acct_slot_t *avb_mmio_acct_slot(avb_mmio_acct_t *a, uint32_t cpu)
+{
+    if (a->slot_count == 0) {
+        return NULL;
+    }
+    return &a->slots[cpu % a->slot_count];
+}
+
+/** Charge accesses on processor cpu to caller until avb_mmio_acct_leave; returns the tag to restore */
+static __inline uint32_t avb_mmio_acct_enter(avb_mmio_acct_t *a, uint32_t cpu, uint32_t caller)
+{
+    avb_mmio_acct_slot_t *s = avb_mmio_acct_slot(a, cpu);
+    uint32_t prev;
+
+    if (s == NULL) {
+        return AVB_MMIO_CALLER_OTHER;
+    }
+    prev = s->caller;
+    s->caller = caller;
+    return prev;
+}
+
+static __inline void avb_mmio_acct_leave(avb_mmio_acct_t *a, uint32_t cpu, uint32_t prev)
+{
+    avb_mmio_acct_slot_t *s = avb_mmio_acct_slot(a, cpu);
+
+    if (s != NULL) {
+        s->caller = prev;
+    }
+}
+
+/** Bytes of storage avb_mmio_acct_init needs for cpus processors (alignment slack included) */
+size_t avb_mmio_acct_bytes(uint32_t cpus);
+
+/**
+ * storage: avb_mmio_acct_bytes(cpus) zeroed bytes, any alignment, owned by
+ * the caller; NULL turns recording off.
+ */
+void avb_mmio_acct_init(avb_mmio_acct_t *a, void *storage, uint32_t cpus);
+
+/** Sum of every slot into *out (plain reads; out is overwritten) */
+void avb_mmio_acct_sum(const avb_mmio_acct_t *a, avb_mmio_acct_totals_t *out);
+
+#ifdef __cplusplus
+}
+#endif
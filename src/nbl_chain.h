@@ -0,0 +1,121 @@
+/*++
+
+Module Name:
+
+    nbl_chain.h
+
+Abstract:
+
+    Per-chain accounting and PTP frame classification for the filter's
+    datapath handlers.
+
+    Each of FilterSendNetBufferLists, FilterSendNetBufferListsComplete,
+    FilterReceiveNetBufferLists and FilterReturnNetBufferLists walks its
+    NBL chain once.  That walk adds every NBL to an avb_chain_acct_t
+    (NBLs, frames, bytes), and on receive also classifies the first
+    buffer with avb_ptp_classify; the statistics, the outstanding gauges,
+    the TrackSends / TrackReceives references and the RX timestamp events
+    all come from the one walk, and the counters are updated once per
+    chain rather than once per NBL.
+
+    avb_ptp_classify needs AVB_PTP_PARSE_LEN contiguous bytes (Ethernet
+    header, optional 802.1Q tag, PTP common header up to correctionField).
+
+    Pure C99 (stdint only) so tests/performance/test_nbl_chain_bench.c
+    runs the identical code on mock chains.
+
+    Implements: REQ-F-STATISTICS-001 (Driver statistics)
+                REQ-F-TS-SUB-001 (RX timestamp events)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _avb_chain_acct {
+    uint32_t nbls;
+    uint32_t frames;            /* NET_BUFFERs */
+    uint64_t bytes;             /* NET_BUFFER_DATA_LENGTH summed */
+} avb_chain_acct_t;
+
+static __inline void avb_chain_acct_init(avb_chain_acct_t *a)
+{
+    a->nbls   = 0;
+    a->frames = 0;
+    a->bytes  = 0;
+}
+
+/** One NBL of the chain carrying frames buffers and bytes data bytes */
+static __inline void avb_chain_acct_add(avb_chain_acct_t *a, uint32_t frames, uint64_t bytes)
+{
+    a->nbls++;
+    a->frames += frames;
+    a->bytes  += bytes;
+}
+
+#define AVB_PTP_ETHERTYPE       0x88F7u
+#define AVB_PTP_ETH_P_8021Q     0x8100u
+#define AVB_PTP_ETH_HDR_LEN     14u
+#define AVB_PTP_VLAN_HDR_LEN    18u
+#define AVB_PTP_HDR_LEN         34u
+#define AVB_PTP_PARSE_LEN       (AVB_PTP_ETH_HDR_LEN + AVB_PTP_HDR_LEN)
+#define AVB_PTP_NO_VLAN         0xFFFFu
+#define AVB_PTP_NO_PCP          0xFFu
+
+/* avb_ptp_classify results */
+#define AVB_PTP_NONE            0   /* not PTP over Ethernet (or too short) */
+#define AVB_PTP_EVENT           1   /* Sync / Delay_Req / Pdelay_Req / Pdelay_Resp: RX timestamp latched */
+#define AVB_PTP_GENERAL         2   /* Follow_Up, Announce, Signaling, ...: no timestamp */
+
+typedef struct _avb_ptp_frame {
+    uint16_t vlan_id;           /* AVB_PTP_NO_VLAN when untagged */
+    uint8_t  pcp;               /* AVB_PTP_NO_PCP when untagged */
+    uint8_t  msg_type;          /* IEEE 1588-2019 Table 36 */
+    uint32_t ptp_offset;        /* PTP header offset in the frame */
+    int64_t  correction;        /* correctionField, 2^-16 ns units */
+} avb_ptp_frame_t;
+
+/**
+ * @brief Classify one received frame.
+ * p: the first AVB_PTP_PARSE_LEN bytes of the frame; frame_len: its full
+ * length (NET_BUFFER_DATA_LENGTH).  Only event messages (types 0x0-0x3)
+ * latch RXSTMPL/H; a general message would read a stale timestamp.
+ */
+static __inline int avb_ptp_classify(const uint8_t *p, uint32_t frame_len, avb_ptp_frame_t *f)
+{
+    uint32_t ether = ((uint32_t)p[12] << 8) | p[13];
+    uint32_t off   = AVB_PTP_ETH_HDR_LEN;
+    const uint8_t *cf;
+
+    if (frame_len < AVB_PTP_PARSE_LEN) {
+        return AVB_PTP_NONE;
+    }
+    f->vlan_id = AVB_PTP_NO_VLAN;
+    f->pcp     = AVB_PTP_NO_PCP;
+    if (ether == AVB_PTP_ETH_P_8021Q && frame_len >= AVB_PTP_VLAN_HDR_LEN + AVB_PTP_HDR_LEN) {
+        f->vlan_id = (uint16_t)((((uint32_t)p[14] << 8) | p[15]) & 0x0FFFu);
+        f->pcp     = (uint8_t)((p[14] >> 5) & 0x07u);
+        ether      = ((uint32_t)p[16] << 8) | p[17];
+        off        = AVB_PTP_VLAN_HDR_LEN;
+    }
+    if (ether != AVB_PTP_ETHERTYPE) {
+        return AVB_PTP_NONE;
+    }
+    f->ptp_offset = off;
+    f->msg_type   = (uint8_t)(p[off] & 0x0Fu);
+    cf            = p + off + 8u;
+    f->correction = (int64_t)(((uint64_t)cf[0] << 56) | ((uint64_t)cf[1] << 48) |
+                              ((uint64_t)cf[2] << 40) | ((uint64_t)cf[3] << 32) |
+                              ((uint64_t)cf[4] << 24) | ((uint64_t)cf[5] << 16) |
+                              ((uint64_t)cf[6] <<  8) |  (uint64_t)cf[7]);
+    return (f->msg_type <= 0x3u) ? AVB_PTP_EVENT : AVB_PTP_GENERAL;
+}
+
+#ifdef __cplusplus
+}
+#endif
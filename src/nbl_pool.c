@@ -0,0 +1,197 @@
+/*++
+
+Module Name:
+
+    nbl_pool.c
+
+Abstract:
+
+    Lock-free SEND_PTP slot pool - implementation.  See nbl_pool.h.
+
+--*/
+
+#include "nbl_pool.h"
+
+#define LINK_MASK       0xFFFFFFFFull
+
+/* Head word with the tag bumped and link in the low half (unsigned: the tag wraps) */
+static int64_t head_word(int64_t old, uint32_t link)
+{
+    return (int64_t)((((uint64_t)old & ~LINK_MASK) + ((uint64_t)1 << 32)) | link);
+}
+
+static uint32_t clamp_u32(uint32_t v, uint32_t hi)
+{
+    return v < hi ? v : hi;
+}
+
+static void push(avb_nbl_pool_t *p, volatile int64_t *head, uint32_t index)
+{
+    int64_t old, seen;
+
+    old = *head;
+    for (;;) {
+        p->next[index] = (uint32_t)((uint64_t)old & LINK_MASK);
+        seen = AVB_NBL_POOL_CAS64(head, head_word(old, index + 1u), old);
+        if (seen == old) {
+            return;
+        }
+        old = seen;
+    }
+}
+
+static uint32_t pop(avb_nbl_pool_t *p, volatile int64_t *head)
+{
+    int64_t old, seen;
+    uint32_t link;
+
+    old = *head;
+    for (;;) {
+        link = (uint32_t)((uint64_t)old & LINK_MASK);
+        if (link == 0) {
+            return AVB_NBL_POOL_NONE;
+        }
+        seen = AVB_NBL_POOL_CAS64(head, head_word(old, p->next[link - 1u]), old);
+        if (seen == old) {
+            return link - 1u;
+        }
+        old = seen;
+    }
+}
+
+size_t avb_nbl_pool_bytes(uint32_t capacity)
+{
+    return (size_t)clamp_u32(capacity, AVB_NBL_POOL_MAX_SLOTS) * sizeof(uint32_t);
+}
+
+void avb_nbl_pool_init(avb_nbl_pool_t *p, uint32_t *links, uint32_t capacity, uint32_t limit, uint32_t minimum)
+{
+    uint32_t i;
+
+    p->ready          = 0;
+    p->spare          = 0;
+    p->next           = links;
+    p->capacity       = links != NULL ? clamp_u32(capacity, AVB_NBL_POOL_MAX_SLOTS) : 0;
+    p->built          = 0;
+    p->in_flight      = 0;
+    p->peak_in_flight = 0;
+    p->acquired       = 0;
+    p->grown          = 0;
+    p->trimmed        = 0;
+    p->exhausted      = 0;
+    p->build_failures = 0;
+    p->idle_mark      = 0;
+    avb_nbl_pool_set_limits(p, limit, minimum);
+
+    /* spare stack 0, 1, ... capacity - 1 from the top */
+    for (i = 0; i < p->capacity; i++) {
+        links[i] = (i + 1u < p->capacity) ? i + 2u : 0u;
+    }
+    p->spare = p->capacity != 0 ? 1 : 0;
+}
+
+void avb_nbl_pool_set_limits(avb_nbl_pool_t *p, uint32_t limit, uint32_t minimum)
+{
+    p->limit = clamp_u32(limit, p->capacity);
+    p->minimum = clamp_u32(minimum, p->limit);
+}
+
+uint32_t avb_nbl_pool_take_spare(avb_nbl_pool_t *p)
+{
+    int32_t b, seen;
+    uint32_t index;
+
+    /* reserve a place under the limit, then the index: every reservation has one */
+    b = p->built;
+    for (;;) {
+        if (b < 0 || (uint32_t)b >= p->limit) {
+            return AVB_NBL_POOL_NONE;
+        }
+        seen = AVB_NBL_POOL_CAS32(&p->built, b + 1, b);
+        if (seen == b) {
+            break;
+        }
+        b = seen;
+    }
+    do {
+        index = pop(p, &p->spare);
+    } while (index == AVB_NBL_POOL_NONE);
+    return index;
+}
+
+void avb_nbl_pool_stock(avb_nbl_pool_t *p, uint32_t index)
+{
+    push(p, &p->ready, index);
+}
+
+void avb_nbl_pool_give_spare(avb_nbl_pool_t *p, uint32_t index)
+{
+    push(p, &p->spare, index);
+    (void)AVB_NBL_POOL_ADD32(&p->built, -1);
+}
+
+uint32_t avb_nbl_pool_acquire(avb_nbl_pool_t *p, int *fresh)
+{
+    uint32_t index;
+    int32_t n, peak;
+
+    *fresh = 0;
+    index = pop(p, &p->ready);
+    if (index == AVB_NBL_POOL_NONE) {
+        index = avb_nbl_pool_take_spare(p);
+        if (index == AVB_NBL_POOL_NONE) {
+            (void)AVB_NBL_POOL_ADD64(&p->exhausted, 1);
+            return AVB_NBL_POOL_NONE;
+        }
+        *fresh = 1;
+        (void)AVB_NBL_POOL_ADD64(&p->grown, 1);
+    }
+    (void)AVB_NBL_POOL_ADD64(&p->acquired, 1);
+    n = AVB_NBL_POOL_ADD32(&p->in_flight, 1) + 1;
+    peak = p->peak_in_flight;
+    while (n > peak) {
+        int32_t seen = AVB_NBL_POOL_CAS32(&p->peak_in_flight, n, peak);
+        if (seen == peak) {
+            break;
+        }
+        peak = seen;
+    }
+    return index;
+}
+
+void avb_nbl_pool_release(avb_nbl_pool_t *p, uint32_t index)
+{
+    (void)AVB_NBL_POOL_ADD32(&p->in_flight, -1);
+    push(p, &p->ready, index);
+}
+
+void avb_nbl_pool_discard(avb_nbl_pool_t *p, uint32_t index)
+{
+    (void)AVB_NBL_POOL_ADD32(&p->in_flight, -1);
+    (void)AVB_NBL_POOL_ADD64(&p->exhausted, 1);
+    (void)AVB_NBL_POOL_ADD64(&p->build_failures, 1);
+    avb_nbl_pool_give_spare(p, index);
+}
+
+uint32_t avb_nbl_pool_trim_take(avb_nbl_pool_t *p, uint32_t keep)
+{
+    uint32_t index;
+
+    if (p->built <= (int32_t)keep) {
+        return AVB_NBL_POOL_NONE;
+    }
+    index = pop(p, &p->ready);
+    if (index != AVB_NBL_POOL_NONE) {
+        (void)AVB_NBL_POOL_ADD64(&p->trimmed, 1);
+    }
+    return index;
+}
+
+int avb_nbl_pool_idle(avb_nbl_pool_t *p)
+{
+    int64_t now = p->acquired;
+    int idle = now == p->idle_mark;
+
+    p->idle_mark = now;
+    return idle;
+}
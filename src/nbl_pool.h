@@ -0,0 +1,126 @@
+/*++
+
+Module Name:
+
+    nbl_pool.h
+
+Abstract:
+
+    Lock-free slot pool behind IOCTL_AVB_TEST_SEND_PTP (the bookkeeping of
+    the pre-built NBL / NB / MDL / buffer triples; the triples themselves
+    live in the driver's slot array, indexed like the pool).
+
+    Two LIFO stacks of slot indices: ready (a triple is built, not in
+    flight) and spare (nothing built).  Each stack head is one 64-bit word,
+    tag << 32 | (index + 1), and every push and pop bumps the tag, so a
+    compare-exchange that raced with a pop / push / pop of the same index
+    fails instead of linking a stale next (ABA).  Links are never freed,
+    so reading a link that is being rewritten is harmless.
+
+    Acquire pops ready; when ready is empty it takes a spare index and the
+    caller builds its triple there (growth), as long as fewer than limit
+    slots are built.  Otherwise the acquire fails and counts as exhausted.
+    Release pushes the slot back on ready.  Trimming pops ready slots while
+    more than a given number are built; the caller frees their triples and
+    gives the indices back to spare.  avb_nbl_pool_idle tells the trimmer
+    whether anything was acquired since it last asked.
+
+    Pure C99 (stdint only) so tests/performance/test_nbl_pool_bench.c
+    stresses the identical code.  Acquire, release and the spare calls may
+    run concurrently on any processor; callers serialise trimming.
+    avb_nbl_pool_set_limits may race a trim: it only moves the bound the
+    trim stops at.
+
+    Implements: REQ-NF-PERF-TXPOOL-001 (SEND_PTP slot pool)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_NBL_POOL_NONE           0xFFFFFFFFu     /* no slot */
+#define AVB_NBL_POOL_MAX_SLOTS      4096u
+
+#if defined(_MSC_VER)
+#define AVB_NBL_POOL_CAS64(p, x, c) ((int64_t)_InterlockedCompareExchange64((volatile __int64 *)(p), (x), (c)))
+#define AVB_NBL_POOL_CAS32(p, x, c) ((int32_t)_InterlockedCompareExchange((volatile long *)(p), (x), (c)))
+#define AVB_NBL_POOL_ADD32(p, n)    ((int32_t)_InterlockedExchangeAdd((volatile long *)(p), (n)))
+#define AVB_NBL_POOL_ADD64(p, n)    ((int64_t)_InterlockedExchangeAdd64((volatile __int64 *)(p), (n)))
+#else
+#define AVB_NBL_POOL_CAS64(p, x, c) __sync_val_compare_and_swap((p), (c), (x))
+#define AVB_NBL_POOL_CAS32(p, x, c) __sync_val_compare_and_swap((p), (c), (x))
+#define AVB_NBL_POOL_ADD32(p, n)    __atomic_fetch_add((p), (n), __ATOMIC_SEQ_CST)
+#define AVB_NBL_POOL_ADD64(p, n)    __atomic_fetch_add((p), (n), __ATOMIC_SEQ_CST)
+#endif
+
+typedef struct _avb_nbl_pool {
+    volatile int64_t   ready;       /* built, not in flight: tag << 32 | (index + 1), low half 0 = empty */
+    volatile int64_t   spare;       /* nothing built */
+    volatile uint32_t *next;        /* capacity links (index + 1, 0 = end), owned by the stack holding the slot */
+    uint32_t           capacity;    /* slots there is storage for; 0: no storage, every acquire fails */
+    volatile uint32_t  limit;       /* growth bound, <= capacity */
+    volatile uint32_t  minimum;     /* idle trimming keeps this many built */
+    volatile int32_t   built;       /* slots holding a triple (ready, in flight, or being built) */
+    volatile int32_t   in_flight;
+    volatile int32_t   peak_in_flight;
+    volatile int64_t   acquired;
+    volatile int64_t   grown;       /* acquires that took a spare slot to build */
+    volatile int64_t   trimmed;     /* triples freed by trimming */
+    volatile int64_t   exhausted;   /* acquires that failed: limit reached, or the build failed */
+    volatile int64_t   build_failures;
+    int64_t            idle_mark;   /* acquired at the last avb_nbl_pool_idle */
+} avb_nbl_pool_t;
+
+/** Bytes of link storage for capacity slots */
+size_t avb_nbl_pool_bytes(uint32_t capacity);
+
+/**
+ * links: avb_nbl_pool_bytes(capacity) bytes owned by the caller; NULL or 0
+ * makes a pool whose acquires all fail.  Every index starts spare (0 on
+ * top); limit and minimum are clamped to capacity, minimum to limit.
+ */
+void avb_nbl_pool_init(avb_nbl_pool_t *p, uint32_t *links, uint32_t capacity, uint32_t limit, uint32_t minimum);
+
+/** Change the growth bound and the idle minimum (clamped as in init); built slots above them go at the next trim */
+void avb_nbl_pool_set_limits(avb_nbl_pool_t *p, uint32_t limit, uint32_t minimum);
+
+/**
+ * A slot for one send, or AVB_NBL_POOL_NONE (counted as exhausted).
+ * *fresh = 1: the index came from spare and the caller builds its triple
+ * before use; if that fails, avb_nbl_pool_discard.
+ */
+uint32_t avb_nbl_pool_acquire(avb_nbl_pool_t *p, int *fresh);
+
+/** Return an acquired slot, its triple intact */
+void avb_nbl_pool_release(avb_nbl_pool_t *p, uint32_t index);
+
+/** Return a fresh slot whose triple could not be built (counted as exhausted and as a build failure) */
+void avb_nbl_pool_discard(avb_nbl_pool_t *p, uint32_t index);
+
+/** Take a spare index to build without sending (pre-building), or NONE at the limit */
+uint32_t avb_nbl_pool_take_spare(avb_nbl_pool_t *p);
+
+/** Put a slot built through avb_nbl_pool_take_spare on ready */
+void avb_nbl_pool_stock(avb_nbl_pool_t *p, uint32_t index);
+
+/** Give back an index whose triple was freed (or never built) */
+void avb_nbl_pool_give_spare(avb_nbl_pool_t *p, uint32_t index);
+
+/** Trimmer: a ready slot to free while more than keep slots are built, else NONE */
+uint32_t avb_nbl_pool_trim_take(avb_nbl_pool_t *p, uint32_t keep);
+
+/** Trimmer: 1 when nothing was acquired since the previous call */
+int avb_nbl_pool_idle(avb_nbl_pool_t *p);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,125 @@
+/*++
+
+Module Name:
+
+    pcpu_stats.c
+
+Abstract:
+
+    Per-processor driver statistics - implementation.  See pcpu_stats.h.
+
+--*/
+
+#include "pcpu_stats.h"
+
+size_t avb_pcpu_stats_bytes(uint32_t cpus)
+{
+    return (size_t)cpus * sizeof(avb_pcpu_slot_t) + AVB_PCPU_ALIGN;
+}
+
+void avb_pcpu_stats_init(avb_pcpu_stats_t *s, void *storage, uint32_t cpus)
+{
+    uint32_t i;
+
+    for (i = 0; i < AVB_STAT_COUNT; i++) {
+        s->base[i] = 0;
+        s->fallback.v[i] = 0;
+    }
+    s->resets = 0;
+    if (storage == NULL || cpus == 0) {
+        s->slots = NULL;
+        s->cpus  = 0;
+        return;
+    }
+    s->slots = (avb_pcpu_slot_t *)(((uintptr_t)storage + (AVB_PCPU_ALIGN - 1u)) &
+                                   ~(uintptr_t)(AVB_PCPU_ALIGN - 1u));
+    s->cpus  = cpus;
+}
+
+int avb_pcpu_stat_is_gauge(uint32_t index)
+{
+    return index == AVB_STAT_OUTSTANDING_SEND_NBLS ||
+           index == AVB_STAT_OUTSTANDING_RECEIVE_NBLS ||
+           index == AVB_STAT_OUTSTANDING_OIDS;
+}
+
+void avb_pcpu_stats_raw(const avb_pcpu_stats_t *s, int64_t raw[AVB_STAT_COUNT])
+{
+    uint32_t c, i, n = s->cpus;
+
+    for (i = 0; i < AVB_STAT_COUNT; i++) {
+        raw[i] = s->fallback.v[i];
+    }
+    for (c = 0; c < n; c++) {
+        const avb_pcpu_slot_t *slot = &s->slots[c];
+        for (i = 0; i < AVB_STAT_COUNT; i++) {
+            raw[i] += slot->v[i];
+        }
+    }
+}
+
+void avb_pcpu_stats_values(const avb_pcpu_stats_t *s, const int64_t raw[AVB_STAT_COUNT],
+                           uint64_t out[AVB_STAT_COUNT])
+{
+    uint32_t i;
+
+    for (i = 0; i < AVB_STAT_COUNT; i++) {
+        int64_t v = avb_pcpu_stat_is_gauge(i) ? raw[i] : raw[i] - s->base[i];
+        out[i] = (v > 0) ? (uint64_t)v : 0u;
+    }
+}
+
+void avb_pcpu_stats_sum(const avb_pcpu_stats_t *s, uint64_t out[AVB_STAT_COUNT])
+{
+    int64_t raw[AVB_STAT_COUNT];
+
+    avb_pcpu_stats_raw(s, raw);
+    avb_pcpu_stats_values(s, raw, out);
+}
+
+void avb_pcpu_stats_reset(avb_pcpu_stats_t *s)
+{
+    int64_t raw[AVB_STAT_COUNT];
+    uint32_t i;
+
+    avb_pcpu_stats_raw(s, raw);
+    for (i = 0; i < AVB_STAT_COUNT; i++) {
+        s->base[i] = avb_pcpu_stat_is_gauge(i) ? 0 : raw[i];
+    }
+    s->resets++;
+}
+
+void avb_pcpu_stats_delta(const int64_t cur[AVB_STAT_COUNT], const int64_t base[AVB_STAT_COUNT],
+                          uint64_t out[AVB_STAT_COUNT])
+{
+    uint32_t i;
+
+    for (i = 0; i < AVB_STAT_COUNT; i++) {
+        int64_t v = avb_pcpu_stat_is_gauge(i) ? cur[i] : cur[i] - base[i];
+        out[i] = (v > 0) ? (uint64_t)v : 0u;
+    }
+}
+
+const avb_stats_snap_t *avb_stats_history_add(avb_stats_history_t *h, const int64_t raw[AVB_STAT_COUNT],
+                                              uint64_t time_ns, uint32_t sources)
+{
+    uint64_t gen = ++h->generation;
+    avb_stats_snap_t *snap = &h->snap[gen % AVB_STATS_HISTORY];
+    uint32_t i;
+
+    snap->generation = gen;
+    snap->time_ns    = time_ns;
+    snap->sources    = sources;
+    snap->reserved   = 0;
+    for (i = 0; i < AVB_STAT_COUNT; i++) {
+        snap->raw[i] = raw[i];
+    }
+    return snap;
+}
+
+const avb_stats_snap_t *avb_stats_history_find(const avb_stats_history_t *h, uint64_t generation)
+{
+    const avb_stats_snap_t *snap = &h->snap[generation % AVB_STATS_HISTORY];
+
+    return (generation != 0 && snap->generation == generation) ? snap : NULL;
+}
@@ -0,0 +1,160 @@
+/*++
+
+Module Name:
+
+    pcpu_stats.h
+
+Abstract:
+
+    Per-processor driver statistics (the 24 counters behind
+    IOCTL_AVB_GET_STATISTICS / AVB_DRIVER_STATISTICS).
+
+    Each processor updates its own slot - 24 x 8 bytes, three whole cache
+    lines, slots 64-byte aligned - so the send / receive / OID paths on
+    different cores never write the same line.  The update is still an
+    interlocked add (a thread at PASSIVE_LEVEL may move to another
+    processor between choosing the slot and writing it), but on a line no
+    other processor writes it stays in the local cache.  Readers sum the
+    slots; nothing is aggregated on the update path.
+
+    Counters grow monotonically per slot.  RESET does not write the slots:
+    it records the current sums as a baseline that reads subtract, so an
+    update racing a reset can never produce a negative (wrapped) value.
+
+    Gauges (outstanding send / receive NBLs, outstanding OIDs) are
+    incremented on one processor and decremented on another, so single
+    slots go negative; the sum is the true count.  They have no baseline -
+    resetting a live count only made it drift below zero - and a sum read
+    while updates are in flight is clamped at 0.
+
+    Index order matches the fields of AVB_DRIVER_STATISTICS.
+
+    Snapshots (IOCTL_AVB_STATS_SNAPSHOT) keep the raw slot sums, which no
+    RESET touches, in a short history numbered by generation.  A reader
+    that passes back the generation of its previous snapshot gets the
+    counter deltas between the two without resetting anything, so any
+    number of monitors can sample side by side.
+
+    Pure C99 (stdint only); the caller supplies the processor index and
+    the atomic add.  Callers serialise reset / sum and the history.
+
+    Implements: REQ-F-STATISTICS-001 (Driver statistics)
+                REQ-F-STATISTICS-003 (Statistics snapshots)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_STAT_TX_PACKETS                 0u
+#define AVB_STAT_RX_PACKETS                 1u
+#define AVB_STAT_TX_BYTES                   2u
+#define AVB_STAT_RX_BYTES                   3u
+#define AVB_STAT_PHC_QUERY                  4u
+#define AVB_STAT_PHC_ADJUST                 5u
+#define AVB_STAT_PHC_SET                    6u
+#define AVB_STAT_TIMESTAMP                  7u
+#define AVB_STAT_IOCTL                      8u
+#define AVB_STAT_ERROR                      9u
+#define AVB_STAT_MEMORY_ALLOC_FAILURES      10u
+#define AVB_STAT_HARDWARE_FAULTS            11u
+#define AVB_STAT_FILTER_ATTACH              12u
+#define AVB_STAT_FILTER_PAUSE               13u
+#define AVB_STAT_FILTER_RESTART             14u
+#define AVB_STAT_FILTER_DETACH              15u
+#define AVB_STAT_OUTSTANDING_SEND_NBLS      16u     /* gauge */
+#define AVB_STAT_OUTSTANDING_RECEIVE_NBLS   17u     /* gauge */
+#define AVB_STAT_OID_REQUEST                18u
+#define AVB_STAT_OID_COMPLETE               19u
+#define AVB_STAT_OUTSTANDING_OIDS           20u     /* gauge */
+#define AVB_STAT_FILTER_STATUS              21u
+#define AVB_STAT_FILTER_NET_PNP             22u
+#define AVB_STAT_PAUSE_RESTART_GENERATION   23u
+#define AVB_STAT_COUNT                      24u
+
+#define AVB_PCPU_ALIGN                      64u
+
+typedef struct _avb_pcpu_slot {
+    volatile int64_t v[AVB_STAT_COUNT];
+} avb_pcpu_slot_t;
+
+typedef struct _avb_pcpu_stats {
+    avb_pcpu_slot_t *slots;             /* cpus slots, AVB_PCPU_ALIGN aligned */
+    uint32_t         cpus;
+    uint32_t         resets;            /* avb_pcpu_stats_reset calls */
+    int64_t          base[AVB_STAT_COUNT];  /* counter sums at the last reset */
+    avb_pcpu_slot_t  fallback;          /* used when no per-CPU storage could be allocated */
+} avb_pcpu_stats_t;
+
+/** Bytes of storage avb_pcpu_stats_init needs for cpus processors (alignment slack included) */
+size_t avb_pcpu_stats_bytes(uint32_t cpus);
+
+/**
+ * storage: avb_pcpu_stats_bytes(cpus) zeroed bytes, any alignment, owned by the
+ * caller; NULL (or cpus == 0) shares the single fallback slot.
+ */
+void avb_pcpu_stats_init(avb_pcpu_stats_t *s, void *storage, uint32_t cpus);
+
+/** The slot processor cpu updates */
+static __inline avb_pcpu_slot_t *avb_pcpu_slot(avb_pcpu_stats_t *s, uint32_t cpu)
+{
+    if (s->cpus == 0) {
+        return &s->fallback;
+    }
+    return &s->slots[cpu < s->cpus ? cpu : cpu % s->cpus];
+}
+
+/** 1 for the outstanding-NBL / OID gauges */
+int avb_pcpu_stat_is_gauge(uint32_t index);
+
+/** Aggregate: counters since the last reset, gauges clamped at 0 */
+void avb_pcpu_stats_sum(const avb_pcpu_stats_t *s, uint64_t out[AVB_STAT_COUNT]);
+
+/** Zero the counters as seen by avb_pcpu_stats_sum; gauges keep counting */
+void avb_pcpu_stats_reset(avb_pcpu_stats_t *s);
+
+/** Raw sums over every slot: counters since init (no reset applied), gauges unclamped */
+void avb_pcpu_stats_raw(const avb_pcpu_stats_t *s, int64_t raw[AVB_STAT_COUNT]);
+
+/** avb_pcpu_stats_sum from raw sums taken earlier: counters since the last reset, gauges clamped */
+void avb_pcpu_stats_values(const avb_pcpu_stats_t *s, const int64_t raw[AVB_STAT_COUNT],
+                           uint64_t out[AVB_STAT_COUNT]);
+
+/** Change between two raw sums: counters cur - base (0 if they went backwards), gauges cur clamped */
+void avb_pcpu_stats_delta(const int64_t cur[AVB_STAT_COUNT], const int64_t base[AVB_STAT_COUNT],
+                          uint64_t out[AVB_STAT_COUNT]);
+
+/* -------------------------------------------------------------------------
+ * Snapshot history
+ * ------------------------------------------------------------------------- */
+#define AVB_STATS_HISTORY                   32u     /* snapshots a delta can refer back to */
+
+typedef struct _avb_stats_snap {
+    uint64_t generation;                /* 0: slot unused */
+    uint64_t time_ns;                   /* capture time, caller's clock */
+    uint32_t sources;                   /* statistics sets summed (adapters) */
+    uint32_t reserved;
+    int64_t  raw[AVB_STAT_COUNT];       /* avb_pcpu_stats_raw, summed over the sources */
+} avb_stats_snap_t;
+
+typedef struct _avb_stats_history {
+    uint64_t         generation;        /* last generation handed out */
+    avb_stats_snap_t snap[AVB_STATS_HISTORY];
+} avb_stats_history_t;
+
+/** Store a snapshot under the next generation (overwriting the oldest); returns it */
+const avb_stats_snap_t *avb_stats_history_add(avb_stats_history_t *h, const int64_t raw[AVB_STAT_COUNT],
+                                              uint64_t time_ns, uint32_t sources);
+
+/** The snapshot of generation, or NULL once AVB_STATS_HISTORY later ones have replaced it */
+const avb_stats_snap_t *avb_stats_history_find(const avb_stats_history_t *h, uint64_t generation);
+
+#ifdef __cplusplus
+}
+#endif
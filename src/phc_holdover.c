@@ -0,0 +1,134 @@
+/*++
+
+Module Name:
+
+    phc_holdover.c
+
+Abstract:
+
+    PHC frequency estimator and holdover state machine - implementation.
+    See phc_holdover.h for the model.
+
+--*/
+
+#include "phc_holdover.h"
+
+/* Signed divide by 2^k rounding toward zero (no reliance on >> of negatives) */
+static int64_t ewma_step(int64_t d, uint32_t k)
+{
+    return (d >= 0) ? (int64_t)((uint64_t)d >> k) : -(int64_t)((uint64_t)(-d) >> k);
+}
+
+void avb_holdover_init(avb_holdover_t *h)
+{
+    h->mean_q32          = 0;
+    h->var_q64           = 0;
+    h->last_observe_ms   = 0;
+    h->holdover_start_ms = 0;
+    h->samples           = 0;
+    h->auto_timeout_ms   = 0;
+    h->state             = AVB_HOLDOVER_ST_FREE_RUN;
+    h->reason            = AVB_HOLDOVER_RSN_NONE;
+}
+
+void avb_holdover_observe(avb_holdover_t *h, uint64_t inc_q32, uint64_t now_ms)
+{
+    if (h->samples == 0) {
+        h->mean_q32 = inc_q32;
+        h->var_q64  = 0;
+    } else {
+        int64_t d = (int64_t)(inc_q32 - h->mean_q32);
+        uint64_t d2;
+
+        if (d >  AVB_HOLDOVER_MAX_DEV_Q32) d =  AVB_HOLDOVER_MAX_DEV_Q32;
+        if (d < -AVB_HOLDOVER_MAX_DEV_Q32) d = -AVB_HOLDOVER_MAX_DEV_Q32;
+
+        h->mean_q32 = (uint64_t)((int64_t)h->mean_q32 + ewma_step(d, AVB_HOLDOVER_EWMA_SHIFT));
+
+        d2 = (uint64_t)(d * d);
+        h->var_q64 = (uint64_t)((int64_t)h->var_q64 +
+                                ewma_step((int64_t)(d2 - h->var_q64), AVB_HOLDOVER_EWMA_SHIFT));
+    }
+
+    if (h->samples != UINT32_MAX) {
+        h->samples++;
+    }
+    h->last_observe_ms = now_ms;
+    h->state  = avb_holdover_ready(h) ? AVB_HOLDOVER_ST_LOCKED : AVB_HOLDOVER_ST_FREE_RUN;
+    h->reason = AVB_HOLDOVER_RSN_NONE;
+}
+
+int avb_holdover_ready(const avb_holdover_t *h)
+{
+    return h->samples >= AVB_HOLDOVER_MIN_SAMPLES && h->mean_q32 != 0;
+}
+
+int avb_holdover_timed_out(const avb_holdover_t *h, uint64_t now_ms)
+{
+    return h->auto_timeout_ms != 0 &&
+           h->state == AVB_HOLDOVER_ST_LOCKED &&
+           avb_holdover_ready(h) &&
+           now_ms - h->last_observe_ms >= h->auto_timeout_ms;
+}
+
+uint64_t avb_holdover_enter(avb_holdover_t *h, avb_holdover_reason_t reason, uint64_t now_ms)
+{
+    if (!avb_holdover_ready(h)) {
+        return 0;
+    }
+    if (h->state != AVB_HOLDOVER_ST_HOLDOVER) {
+        h->holdover_start_ms = now_ms;
+    }
+    h->state  = AVB_HOLDOVER_ST_HOLDOVER;
+    h->reason = reason;
+    return h->mean_q32;
+}
+
+void avb_holdover_exit(avb_holdover_t *h)
+{
+    h->state  = avb_holdover_ready(h) ? AVB_HOLDOVER_ST_LOCKED : AVB_HOLDOVER_ST_FREE_RUN;
+    h->reason = AVB_HOLDOVER_RSN_NONE;
+}
+
+uint64_t avb_holdover_isqrt(uint64_t v)
+{
+    uint64_t res = 0;
+    uint64_t bit = 1ull << 62;
+
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= res + bit) {
+            v  -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+uint64_t avb_holdover_stddev_q32(const avb_holdover_t *h)
+{
+    return avb_holdover_isqrt(h->var_q64);
+}
+
+uint64_t avb_holdover_stddev_ppb(const avb_holdover_t *h)
+{
+    /* stddev_q32 < 2^31, so * 1e9 stays below 2^61 */
+    if (h->mean_q32 == 0) {
+        return 0;
+    }
+    return avb_holdover_stddev_q32(h) * 1000000000ull / h->mean_q32;
+}
+
+uint64_t avb_holdover_error_ns(const avb_holdover_t *h, uint64_t now_ms)
+{
+    if (h->state != AVB_HOLDOVER_ST_HOLDOVER) {
+        return 0;
+    }
+    /* ppb == ns per second; elapsed in ms */
+    return avb_holdover_stddev_ppb(h) * (now_ms - h->holdover_start_ms) / 1000u;
+}
@@ -0,0 +1,103 @@
+/*++
+
+Module Name:
+
+    phc_holdover.h
+
+Abstract:
+
+    PHC frequency estimator and holdover state machine.
+
+    Every IOCTL_AVB_ADJUST_FREQUENCY issued by the gPTP servo is fed to
+    avb_holdover_observe() as a clock increment in 2^-32 ns units (the
+    logical increment_ns.increment_frac pair, device independent).  The module
+    keeps an exponentially weighted mean and variance of those increments:
+
+        d     = x - mean
+        mean += d / 2^k
+        var  += (d^2 - var) / 2^k            (k = AVB_HOLDOVER_EWMA_SHIFT)
+
+    When the servo goes quiet (GM lost, stack restarted) the driver enters
+    holdover and writes the filtered mean back to TIMINCA instead of letting
+    the PHC free-run at whatever increment the last servo step left behind.
+
+    Error growth while in holdover is estimated from the frequency spread
+    the servo was applying:  err_ns(t) = sigma_ppb * t_s  (ppb == ns/s).
+
+    Pure C99 (stdint only, no floating point) so the same file builds into the
+    kernel driver and into tests/unit/ptp/test_phc_holdover.c.  Callers own
+    locking and pass a monotonic millisecond clock.
+
+    Implements: REQ-F-PTP-HOLDOVER-001 (PHC holdover on GM loss)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_HOLDOVER_EWMA_SHIFT   3u      /* alpha = 1/8: ~1 s memory at 8 Sync/s */
+#define AVB_HOLDOVER_MIN_SAMPLES  8u      /* estimate is trusted after this many adjustments */
+#define AVB_HOLDOVER_MAX_DEV_Q32  0x7FFFFFFFll  /* |d| clamp (~0.5 ns/cycle) keeps d^2 < 2^62 */
+
+/* States and reasons share values with AVB_HOLDOVER_STATE_* / _REASON_* in avb_ioctl.h */
+typedef enum _avb_holdover_state {
+    AVB_HOLDOVER_ST_FREE_RUN = 0,   /* no (or too few) servo adjustments seen */
+    AVB_HOLDOVER_ST_LOCKED   = 1,   /* servo is adjusting; estimator tracking */
+    AVB_HOLDOVER_ST_HOLDOVER = 2    /* estimate applied, servo absent */
+} avb_holdover_state_t;
+
+typedef enum _avb_holdover_reason {
+    AVB_HOLDOVER_RSN_NONE    = 0,
+    AVB_HOLDOVER_RSN_MANUAL  = 1,   /* user requested via IOCTL */
+    AVB_HOLDOVER_RSN_TIMEOUT = 2    /* no adjustment within auto_timeout_ms */
+} avb_holdover_reason_t;
+
+typedef struct _avb_holdover {
+    uint64_t mean_q32;          /* filtered increment, 2^-32 ns per cycle */
+    uint64_t var_q64;           /* filtered variance, 2^-64 ns^2 */
+    uint64_t last_observe_ms;   /* time of last servo adjustment */
+    uint64_t holdover_start_ms; /* time holdover was entered */
+    uint32_t samples;           /* adjustments observed (saturating) */
+    uint32_t auto_timeout_ms;   /* 0 = automatic entry disabled */
+    avb_holdover_state_t  state;
+    avb_holdover_reason_t reason;
+} avb_holdover_t;
+
+void avb_holdover_init(avb_holdover_t *h);
+
+/** Feed one servo adjustment; leaves holdover if it was active. */
+void avb_holdover_observe(avb_holdover_t *h, uint64_t inc_q32, uint64_t now_ms);
+
+/** Non-zero when the estimate is trusted enough to hold over on. */
+int avb_holdover_ready(const avb_holdover_t *h);
+
+/** Non-zero when auto-holdover is enabled, the servo has been silent for
+ *  auto_timeout_ms, and the estimator is ready. */
+int avb_holdover_timed_out(const avb_holdover_t *h, uint64_t now_ms);
+
+/** Enter holdover; returns the increment (2^-32 ns) to program, 0 if not ready. */
+uint64_t avb_holdover_enter(avb_holdover_t *h, avb_holdover_reason_t reason, uint64_t now_ms);
+
+/** Leave holdover without a new sample (returns to LOCKED or FREE_RUN). */
+void avb_holdover_exit(avb_holdover_t *h);
+
+/** Filtered standard deviation in 2^-32 ns units. */
+uint64_t avb_holdover_stddev_q32(const avb_holdover_t *h);
+
+/** Filtered standard deviation relative to the mean, parts per billion. */
+uint64_t avb_holdover_stddev_ppb(const avb_holdover_t *h);
+
+/** Estimated accumulated time error since holdover entry (0 outside holdover). */
+uint64_t avb_holdover_error_ns(const avb_holdover_t *h, uint64_t now_ms);
+
+/** Integer square root, floor(sqrt(v)). */
+uint64_t avb_holdover_isqrt(uint64_t v);
+
+#ifdef __cplusplus
+}
+#endif
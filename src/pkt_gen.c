@@ -0,0 +1,161 @@
+/*++
+
+Module Name:
+
+    pkt_gen.c
+
+Abstract:
+
+    Kernel packet generator: template and schedule - implementation.  See
+    pkt_gen.h.
+
+--*/
+
+#include "pkt_gen.h"
+
+#include <string.h>
+
+#define NS_PER_S        1000000000ull
+
+int avb_pktgen_template_check(const avb_pktgen_template_t *t)
+{
+    if (t->frame_size < AVB_PKTGEN_MIN_FRAME || t->frame_size > AVB_PKTGEN_MAX_FRAME) {
+        return AVB_PKTGEN_BAD_SIZE;
+    }
+    if (t->payload_len > AVB_PKTGEN_MAX_PAYLOAD ||
+        AVB_PKTGEN_HDR_LEN + (uint32_t)t->payload_len > t->frame_size) {
+        return AVB_PKTGEN_BAD_PAYLOAD;
+    }
+    if (t->seq_width != 0u && t->seq_width != 1u && t->seq_width != 2u && t->seq_width != 4u) {
+        return AVB_PKTGEN_BAD_SEQ;
+    }
+    if (t->seq_width != 0u && (uint32_t)t->seq_offset + t->seq_width > t->frame_size) {
+        return AVB_PKTGEN_BAD_SEQ;
+    }
+    return AVB_PKTGEN_OK;
+}
+
+uint32_t avb_pktgen_build(uint8_t *frame, const avb_pktgen_template_t *t)
+{
+    memset(frame, 0, t->frame_size);
+    memcpy(frame, t->dst, 6);
+    memcpy(frame + 6, t->src, 6);
+    frame[12] = (uint8_t)(t->ethertype >> 8);
+    frame[13] = (uint8_t)t->ethertype;
+    memcpy(frame + AVB_PKTGEN_HDR_LEN, t->payload, t->payload_len);
+    return t->frame_size;
+}
+
+void avb_pktgen_stamp(uint8_t *frame, const avb_pktgen_template_t *t, uint64_t seq)
+{
+    uint32_t i;
+
+    for (i = 0; i < t->seq_width; i++) {
+        frame[t->seq_offset + i] = (uint8_t)(seq >> (8u * (t->seq_width - 1u - i)));
+    }
+}
+
+void avb_pktgen_sched_init(avb_pktgen_sched_t *s, uint64_t start_ns, uint64_t interval_ns,
+                           uint32_t pps, uint64_t count, uint32_t burst)
+{
+    s->start_ns    = start_ns;
+    s->interval_ns = interval_ns;
+    s->pps         = pps;
+    s->count       = count;
+    s->issued      = 0;
+    s->max_behind  = 0;
+    if (burst == 0u) {
+        burst = AVB_PKTGEN_DEFAULT_BURST;
+    }
+    s->burst = burst < AVB_PKTGEN_MAX_BURST ? burst : AVB_PKTGEN_MAX_BURST;
+}
+
+uint64_t avb_pktgen_period_ns(const avb_pktgen_sched_t *s)
+{
+    uint64_t gap = s->pps != 0u ? NS_PER_S / s->pps : s->interval_ns;
+
+    return gap > AVB_PKTGEN_MIN_PERIOD_NS ? gap : AVB_PKTGEN_MIN_PERIOD_NS;
+}
+
+uint64_t avb_pktgen_due_ns(const avb_pktgen_sched_t *s, uint64_t k)
+{
+    if (s->pps != 0u) {
+        /* ceil(k * 1e9 / pps) without the 64-bit overflow of k * 1e9 */
+        uint64_t q = k / s->pps, r = k % s->pps;
+        return s->start_ns + q * NS_PER_S + (r * NS_PER_S + s->pps - 1u) / s->pps;
+    }
+    return s->start_ns + k * s->interval_ns;
+}
+
+uint32_t avb_pktgen_take(avb_pktgen_sched_t *s, uint64_t now_ns, uint64_t *first)
+{
+    uint64_t el, due, n;
+
+    *first = s->issued;
+    if (now_ns < s->start_ns || avb_pktgen_done(s)) {
+        return 0;
+    }
+    /* Frames 0 .. due - 1 have due_ns <= now_ns (the inverse of avb_pktgen_due_ns) */
+    el = now_ns - s->start_ns;
+    if (s->pps != 0u) {
+        due = (el / NS_PER_S) * s->pps + (el % NS_PER_S) * s->pps / NS_PER_S + 1u;
+    } else {
+        due = el / s->interval_ns + 1u;
+    }
+    if (s->count != 0u && due > s->count) {
+        due = s->count;
+    }
+    if (due <= s->issued) {
+        return 0;
+    }
+    n = due - s->issued;
+    if (n > s->burst) {
+        if (n - s->burst > s->max_behind) {
+            s->max_behind = n - s->burst;
+        }
+        n = s->burst;
+    }
+    s->issued += n;
+    return (uint32_t)n;
+}
+
+int avb_pktgen_done(const avb_pktgen_sched_t *s)
+{
+    return s->count != 0u && s->issued >= s->count;
+}
+
+uint64_t avb_pktgen_next_ns(const avb_pktgen_sched_t *s)
+{
+    return avb_pktgen_done(s) ? AVB_PKTGEN_NONE : avb_pktgen_due_ns(s, s->issued);
+}
+
+void avb_pktgen_release_add(avb_pktgen_release_t *r, const avb_pktgen_sched_t *s, uint64_t k, uint64_t now_ns)
+{
+    /* take never issues a frame before its schedule time */
+    uint64_t err = now_ns - avb_pktgen_due_ns(s, k);
+
+    if (err > AVB_PKTGEN_LATE_NS) {
+        r->late++;
+    } else {
+        r->on_time++;
+    }
+    r->error_sum_ns += err;
+    if (err > r->error_max_ns) {
+        r->error_max_ns = err;
+    }
+}
+
+uint64_t avb_pktgen_rate_milli(uint64_t intervals, uint64_t elapsed_ns)
+{
+    uint64_t a = intervals * 1000u;
+
+    if (elapsed_ns == 0u) {
+        return 0;
+    }
+    /* a * 1e9 / elapsed in two steps; halve both while the remainder step could overflow */
+    while (elapsed_ns > (UINT64_MAX / NS_PER_S)) {
+        elapsed_ns >>= 1;
+        a >>= 1;
+    }
+    return (a / elapsed_ns) * NS_PER_S + (a % elapsed_ns) * NS_PER_S / elapsed_ns;
+}
@@ -0,0 +1,132 @@
+/*++
+
+Module Name:
+
+    pkt_gen.h
+
+Abstract:
+
+    Kernel packet generator behind IOCTL_AVB_PKTGEN: frame template,
+    send schedule and rate arithmetic.
+
+    A run sends count frames (or until stopped) built from one template -
+    destination, EtherType, frame size and up to AVB_PKTGEN_MAX_PAYLOAD
+    bytes after the EtherType - optionally stamping each with its sequence
+    number (1, 2 or 4 bytes big-endian at a given offset).  Frame k is due
+    at start + k * interval on the schedule clock, or for a rate in frames
+    per second at start + ceil(k * 1e9 / pps), so long runs do not drift
+    by the rounding of 1e9 / pps.  The driver wakes on a
+    periodic timer (never faster than AVB_PKTGEN_MIN_PERIOD_NS) and sends
+    every frame due, at most burst per expiry; a timer that fires late is
+    caught up at the next expiries, so the run keeps its average rate and
+    never sends a frame before it is due.
+
+    A launch-time run keeps the schedule on the PHC and starts it
+    launch_offset_ns after START, so frame k's schedule time is its launch
+    time.  Its timer is one-shot, re-armed for avb_pktgen_next_ns after each
+    expiry, and avb_pktgen_release_add records how long after its launch
+    time each frame was actually handed down.
+
+    Pure C99 (stdint only) so tests/performance/test_pkt_gen_sim.c runs the
+    identical schedule on a simulated clock.  Callers own locking.
+
+    Implements: REQ-NF-TEST-PKTGEN-001 (Kernel packet generator)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_PKTGEN_MIN_FRAME        60u         /* without FCS */
+#define AVB_PKTGEN_MAX_FRAME        1514u
+#define AVB_PKTGEN_HDR_LEN          14u         /* destination, source, EtherType */
+#define AVB_PKTGEN_MAX_PAYLOAD      64u         /* template bytes after the EtherType */
+#define AVB_PKTGEN_MIN_PERIOD_NS    125000u     /* timer period floor: one Class A interval */
+#define AVB_PKTGEN_DEFAULT_BURST    64u
+#define AVB_PKTGEN_MAX_BURST        1024u
+#define AVB_PKTGEN_LATE_NS          125000u     /* launch-time runs: released later than this is late */
+#define AVB_PKTGEN_NONE             UINT64_MAX  /* avb_pktgen_next_ns: run fully issued */
+
+/* avb_pktgen_template_check results */
+#define AVB_PKTGEN_OK               0
+#define AVB_PKTGEN_BAD_SIZE         1   /* frame_size outside MIN_FRAME..MAX_FRAME */
+#define AVB_PKTGEN_BAD_PAYLOAD      2   /* payload_len > MAX_PAYLOAD or past the frame */
+#define AVB_PKTGEN_BAD_SEQ          3   /* seq_width not 0/1/2/4, or the field past the frame */
+
+typedef struct _avb_pktgen_template {
+    uint8_t  dst[6];
+    uint8_t  src[6];
+    uint16_t ethertype;
+    uint16_t frame_size;
+    uint16_t payload_len;
+    uint16_t seq_offset;        /* from the frame start */
+    uint32_t seq_width;         /* 0 = no stamping */
+    uint8_t  payload[AVB_PKTGEN_MAX_PAYLOAD];
+} avb_pktgen_template_t;
+
+typedef struct _avb_pktgen_sched {
+    uint64_t start_ns;          /* frame 0 due */
+    uint64_t interval_ns;       /* used when pps is 0; then nonzero */
+    uint64_t count;             /* frames in the run, 0 = until stopped */
+    uint64_t issued;            /* frames taken so far (sent or skipped) */
+    uint64_t max_behind;        /* most due frames left over after an expiry's burst */
+    uint32_t burst;             /* frames per expiry, nonzero */
+    uint32_t pps;               /* nonzero: rate mode */
+} avb_pktgen_sched_t;
+
+/* Launch-time runs: release time - launch time of the frames handed down */
+typedef struct _avb_pktgen_release {
+    uint64_t on_time;           /* within AVB_PKTGEN_LATE_NS of the launch time */
+    uint64_t late;
+    uint64_t error_sum_ns;
+    uint64_t error_max_ns;
+} avb_pktgen_release_t;
+
+int avb_pktgen_template_check(const avb_pktgen_template_t *t);
+
+/** Write the template frame to frame (frame_size bytes, the rest zero); returns frame_size */
+uint32_t avb_pktgen_build(uint8_t *frame, const avb_pktgen_template_t *t);
+
+/** Stamp seq into a built frame (no-op when seq_width is 0) */
+void avb_pktgen_stamp(uint8_t *frame, const avb_pktgen_template_t *t, uint64_t seq);
+
+/**
+ * One of interval_ns and pps nonzero (pps wins).  burst 0 means
+ * AVB_PKTGEN_DEFAULT_BURST; larger than AVB_PKTGEN_MAX_BURST is clamped.
+ */
+void avb_pktgen_sched_init(avb_pktgen_sched_t *s, uint64_t start_ns, uint64_t interval_ns,
+                           uint32_t pps, uint64_t count, uint32_t burst);
+
+/** Timer period: the frame interval, but at least AVB_PKTGEN_MIN_PERIOD_NS */
+uint64_t avb_pktgen_period_ns(const avb_pktgen_sched_t *s);
+
+/**
+ * Frames to send at now_ns: those due and not yet issued, at most burst.
+ * They are issued (numbered *first, *first + 1, ...) by this call.
+ */
+uint32_t avb_pktgen_take(avb_pktgen_sched_t *s, uint64_t now_ns, uint64_t *first);
+
+/** Schedule time of frame k */
+uint64_t avb_pktgen_due_ns(const avb_pktgen_sched_t *s, uint64_t k);
+
+/** Schedule time of the next frame to issue; AVB_PKTGEN_NONE when a bounded run is fully issued */
+uint64_t avb_pktgen_next_ns(const avb_pktgen_sched_t *s);
+
+/** Record frame k, taken and handed down at now_ns */
+void avb_pktgen_release_add(avb_pktgen_release_t *r, const avb_pktgen_sched_t *s, uint64_t k, uint64_t now_ns);
+
+/** 1 when every frame of a bounded run is issued */
+int avb_pktgen_done(const avb_pktgen_sched_t *s);
+
+/** Rate in thousandths of a frame per second: intervals frame gaps over elapsed_ns (0 if elapsed is 0) */
+uint64_t avb_pktgen_rate_milli(uint64_t intervals, uint64_t elapsed_ns);
+
+#ifdef __cplusplus
+}
+#endif
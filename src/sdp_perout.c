@@ -0,0 +1,175 @@
+/*++
+
+Module Name:
+
+    sdp_perout.c
+
+Abstract:
+
+    Periodic SDP output scheduler and edge-jitter statistics - implementation.
+    See sdp_perout.h for the edge model.
+
+--*/
+
+#include "sdp_perout.h"
+#include "devices/intel_sdp_perout.h"
+
+void avb_perout_init(avb_perout_t *p)
+{
+    p->start_ns      = 0;
+    p->period_ns     = 0;
+    p->high_ns       = 0;
+    p->next_edge_idx = 0;
+    p->next_edge_ns  = 0;
+    p->mode          = AVB_PEROUT_MD_NONE;
+    avb_perout_reset_stats(p);
+}
+
+void avb_perout_reset_stats(avb_perout_t *p)
+{
+    p->edges                = 0;
+    p->missed               = 0;
+    p->max_rearm_latency_ns = 0;
+    p->jitter_samples       = 0;
+    p->sum_abs_err_ns       = 0;
+    p->last_err_ns          = 0;
+    p->min_err_ns           = INT64_MAX;
+    p->max_err_ns           = INT64_MIN;
+}
+
+int avb_perout_freqout_ok(uint64_t period_ns, uint64_t high_ns)
+{
+    return (period_ns & 1u) == 0 &&
+           high_ns * 2u == period_ns &&
+           intel_freqout_half_ok(high_ns);
+}
+
+uint64_t avb_perout_edge_ns(const avb_perout_t *p, uint64_t k)
+{
+    return p->start_ns + (k >> 1) * p->period_ns + ((k & 1u) ? p->high_ns : 0);
+}
+
+/* Index of the last edge at or before t; t must be >= start_ns */
+static uint64_t last_edge_at(const avb_perout_t *p, uint64_t t)
+{
+    uint64_t q = (t - p->start_ns) / p->period_ns;
+    uint64_t r = (t - p->start_ns) - q * p->period_ns;
+    return 2u * q + (r >= p->high_ns ? 1u : 0u);
+}
+
+avb_perout_result_t avb_perout_configure(avb_perout_t *p, uint64_t start_ns, uint64_t period_ns,
+                                         uint64_t high_ns, int hw_freqout, uint64_t now_ns)
+{
+    uint64_t earliest = now_ns + AVB_PEROUT_REARM_GUARD_NS;
+
+    if (high_ns == 0) {
+        high_ns = period_ns / 2u;
+    }
+    if (period_ns == 0 || high_ns == 0 || high_ns >= period_ns) {
+        return AVB_PEROUT_E_PERIOD;
+    }
+
+    avb_perout_init(p);
+    p->period_ns = period_ns;
+    p->high_ns   = high_ns;
+
+    if (hw_freqout && avb_perout_freqout_ok(period_ns, high_ns)) {
+        p->mode = AVB_PEROUT_MD_FREQOUT;
+    } else if (high_ns >= AVB_PEROUT_SW_MIN_SEGMENT_NS &&
+               period_ns - high_ns >= AVB_PEROUT_SW_MIN_SEGMENT_NS) {
+        p->mode = AVB_PEROUT_MD_SW_REARM;
+    } else {
+        p->period_ns = 0;
+        p->high_ns   = 0;
+        return AVB_PEROUT_E_TOO_FAST;
+    }
+
+    /* Keep the requested phase, move the first rising edge past now + guard */
+    if (start_ns < earliest) {
+        start_ns += ((earliest - start_ns + period_ns - 1u) / period_ns) * period_ns;
+    }
+    p->start_ns      = start_ns;
+    p->next_edge_idx = 0;
+    p->next_edge_ns  = start_ns;
+    return AVB_PEROUT_OK;
+}
+
+int avb_perout_advance(avb_perout_t *p, uint64_t now_ns)
+{
+    uint64_t fired, next, latency;
+
+    if (p->mode == AVB_PEROUT_MD_NONE || now_ns < p->next_edge_ns) {
+        return 0;
+    }
+
+    if (p->mode == AVB_PEROUT_MD_FREQOUT) {
+        /* Hardware generates every edge; just track position */
+        next = last_edge_at(p, now_ns) + 1u;
+        p->edges        += next - p->next_edge_idx;
+        p->next_edge_idx = next;
+        p->next_edge_ns  = avb_perout_edge_ns(p, p->next_edge_idx);
+        return 0;
+    }
+
+    fired   = p->next_edge_idx;
+    latency = now_ns - p->next_edge_ns;
+    if (latency > p->max_rearm_latency_ns) {
+        p->max_rearm_latency_ns = latency;
+    }
+    p->edges++;
+
+    next = fired + 1u;
+    if (avb_perout_edge_ns(p, next) < now_ns + AVB_PEROUT_REARM_GUARD_NS) {
+        /* Re-arm ran late: the next edge that can still be armed, with the
+         * polarity the pin expects (fired + 1 parity) */
+        next = last_edge_at(p, now_ns + AVB_PEROUT_REARM_GUARD_NS) + 1u;
+        if (((next - fired) & 1u) == 0) {
+            next++;
+        }
+        p->missed += next - (fired + 1u);
+    }
+
+    p->next_edge_idx = next;
+    p->next_edge_ns  = avb_perout_edge_ns(p, next);
+    return 1;
+}
+
+int64_t avb_perout_edge_error(const avb_perout_t *p, uint64_t ts_ns)
+{
+    uint64_t r;
+    int64_t e_rise, e_fall, e_next, best;
+
+    if (p->period_ns == 0) {
+        return 0;
+    }
+    if (ts_ns < p->start_ns) {
+        return -(int64_t)(p->start_ns - ts_ns);
+    }
+
+    r = (ts_ns - p->start_ns) % p->period_ns;
+    e_rise = (int64_t)r;
+    e_fall = (int64_t)r - (int64_t)p->high_ns;
+    e_next = (int64_t)r - (int64_t)p->period_ns;
+
+    best = e_rise;
+    if ((e_fall < 0 ? -e_fall : e_fall) < (best < 0 ? -best : best)) best = e_fall;
+    if (-e_next < (best < 0 ? -best : best)) best = e_next;
+    return best;
+}
+
+int64_t avb_perout_record_sample(avb_perout_t *p, uint64_t ts_ns)
+{
+    int64_t err = avb_perout_edge_error(p, ts_ns);
+
+    p->last_err_ns = err;
+    if (err < p->min_err_ns) p->min_err_ns = err;
+    if (err > p->max_err_ns) p->max_err_ns = err;
+    p->sum_abs_err_ns += (uint64_t)(err < 0 ? -err : err);
+    p->jitter_samples++;
+    return err;
+}
+
+uint64_t avb_perout_mean_abs_error(const avb_perout_t *p)
+{
+    return p->jitter_samples ? p->sum_abs_err_ns / p->jitter_samples : 0;
+}
@@ -0,0 +1,120 @@
+/*++
+
+Module Name:
+
+    sdp_perout.h
+
+Abstract:
+
+    Periodic SDP output scheduler and edge-jitter statistics.
+
+    A periodic output is described by its first rising edge (start_ns, PHC
+    time), its period and its high time.  Edges are numbered from the start:
+
+        edge(2q)     = start + q * period            (rising)
+        edge(2q + 1) = start + q * period + high     (falling)
+
+    Two delivery modes exist:
+
+      FREQOUT   - the NIC clock-out block toggles the pin by itself
+                  (FREQOUTn half cycle, started by TRGTTIMn).  Only 50 % duty
+                  and the half-cycle values accepted by intel_freqout_half_ok()
+                  are possible.  The driver never touches the pin again.
+
+      SW_REARM  - each edge is a single TRGTTIMn compare (EN_TTn toggles the
+                  pin).  A driver timer notices the compare has passed and
+                  programs the next edge.  If the timer ran late and edges
+                  were skipped, the next armed edge keeps the same polarity
+                  (an even number of edges is dropped) and the skipped edges
+                  are counted in 'missed'.
+
+    Per-edge jitter is measured by capturing the output on a second SDP
+    (loopback) into AUXSTMPn; avb_perout_record_sample() folds each capture
+    onto the nearest scheduled edge and keeps last/min/max/mean |error|.
+
+    Pure C99 (stdint only).  Callers own locking and supply PHC time in ns.
+
+    Implements: REQ-F-PTP-PEROUT-001 (Periodic SDP output)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_PEROUT_REARM_GUARD_NS     100000ull     /* never arm an edge closer than 100 us */
+#define AVB_PEROUT_SW_MIN_SEGMENT_NS  50000000ull   /* SW_REARM: high and low time >= 50 ms */
+
+/* Modes share values with AVB_PEROUT_MODE_* in avb_ioctl.h */
+typedef enum _avb_perout_mode {
+    AVB_PEROUT_MD_NONE      = 0,
+    AVB_PEROUT_MD_FREQOUT   = 1,
+    AVB_PEROUT_MD_SW_REARM  = 2
+} avb_perout_mode_t;
+
+typedef enum _avb_perout_result {
+    AVB_PEROUT_OK          = 0,
+    AVB_PEROUT_E_PERIOD    = -1,   /* period 0 or high time outside (0, period) */
+    AVB_PEROUT_E_TOO_FAST  = -2    /* not FREQOUT-capable and below SW minimum */
+} avb_perout_result_t;
+
+typedef struct _avb_perout {
+    uint64_t start_ns;              /* first rising edge (rolled into the future) */
+    uint64_t period_ns;
+    uint64_t high_ns;
+    uint64_t next_edge_idx;         /* edge currently armed / next to occur */
+    uint64_t next_edge_ns;
+    uint64_t edges;                 /* edges emitted */
+    uint64_t missed;                /* SW_REARM: edges skipped because re-arm ran late */
+    uint64_t max_rearm_latency_ns;  /* SW_REARM: edge -> next TRGTTIM write */
+    uint64_t jitter_samples;
+    uint64_t sum_abs_err_ns;
+    int64_t  last_err_ns;
+    int64_t  min_err_ns;
+    int64_t  max_err_ns;
+    avb_perout_mode_t mode;
+} avb_perout_t;
+
+void avb_perout_init(avb_perout_t *p);
+
+/** Non-zero when FREQOUT can generate period/high (50 % duty, legal half cycle). */
+int avb_perout_freqout_ok(uint64_t period_ns, uint64_t high_ns);
+
+/**
+ * Configure a new output.  high_ns == 0 selects 50 % duty.  Picks FREQOUT when
+ * hw_freqout is non-zero and the shape allows it, SW_REARM otherwise.  A start
+ * time not at least AVB_PEROUT_REARM_GUARD_NS ahead of now_ns is rolled
+ * forward by whole periods.  Statistics are reset.
+ */
+avb_perout_result_t avb_perout_configure(avb_perout_t *p, uint64_t start_ns, uint64_t period_ns,
+                                         uint64_t high_ns, int hw_freqout, uint64_t now_ns);
+
+/** PHC time of edge k. */
+uint64_t avb_perout_edge_ns(const avb_perout_t *p, uint64_t k);
+
+/**
+ * Account for time passing.  FREQOUT: recomputes edges/next edge from now_ns.
+ * SW_REARM: if the armed edge has passed, counts it, picks the next edge that
+ * is still AVB_PEROUT_REARM_GUARD_NS away (same polarity), and returns 1 -
+ * the caller must then program next_edge_ns.  Returns 0 otherwise.
+ */
+int avb_perout_advance(avb_perout_t *p, uint64_t now_ns);
+
+/** Signed distance from a captured timestamp to the nearest scheduled edge. */
+int64_t avb_perout_edge_error(const avb_perout_t *p, uint64_t ts_ns);
+
+/** Fold an AUX capture into the jitter statistics; returns its error. */
+int64_t avb_perout_record_sample(avb_perout_t *p, uint64_t ts_ns);
+
+uint64_t avb_perout_mean_abs_error(const avb_perout_t *p);
+
+/** Clear counters and jitter statistics; keeps the schedule. */
+void avb_perout_reset_stats(avb_perout_t *p);
+
+#ifdef __cplusplus
+}
+#endif
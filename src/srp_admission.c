@@ -0,0 +1,190 @@
+/*++
+
+Module Name:
+
+    srp_admission.c
+
+Abstract:
+
+    SRP stream admission and CBS derivation - implementation.  See
+    srp_admission.h for the bandwidth model.
+
+--*/
+
+#include "srp_admission.h"
+#include "devices/intel_cbs.h"
+
+/* Class measurement intervals per second: Class A 125 us, Class B 250 us */
+static const uint32_t s_intervals_per_sec[AVB_SRP_CLASS_COUNT] = { 8000u, 4000u };
+
+static uint32_t frame_bucket(uint32_t max_frame_size)
+{
+    return (max_frame_size + AVB_SRP_FRAME_OVERHEAD_BYTES + (1u << AVB_SRP_BUCKET_SHIFT) - 1u) >>
+           AVB_SRP_BUCKET_SHIFT;
+}
+
+void avb_srp_init(avb_srp_admission_t *a, uint64_t port_rate_bps)
+{
+    uint32_t c, b;
+
+    a->port_rate_bps      = port_rate_bps;
+    a->rejected_bandwidth = 0;
+    for (c = 0; c < AVB_SRP_CLASS_COUNT; c++) {
+        a->cls[c].reserved_bps = 0;
+        a->cls[c].streams      = 0;
+        for (b = 0; b < AVB_SRP_BUCKETS; b++) {
+            a->cls[c].frame_buckets[b] = 0;
+        }
+    }
+    a->cls[0].delta_pct = AVB_SRP_DEFAULT_DELTA_A_PCT;
+    a->cls[1].delta_pct = AVB_SRP_DEFAULT_DELTA_B_PCT;
+}
+
+void avb_srp_set_port_rate(avb_srp_admission_t *a, uint64_t port_rate_bps)
+{
+    a->port_rate_bps = port_rate_bps;
+}
+
+uint64_t avb_srp_stream_bps(uint32_t cls, uint64_t bandwidth_bps, uint32_t max_frame_size)
+{
+    uint64_t per_frame_bps, frames;
+
+    if (cls >= AVB_SRP_CLASS_COUNT || bandwidth_bps == 0 ||
+        max_frame_size == 0 || max_frame_size > AVB_SRP_MAX_FRAME_BYTES) {
+        return 0;
+    }
+
+    /* One max-size frame per interval carries this much payload per second */
+    per_frame_bps = (uint64_t)max_frame_size * 8u * s_intervals_per_sec[cls];
+    frames = (bandwidth_bps + per_frame_bps - 1u) / per_frame_bps;
+
+    return frames * (max_frame_size + AVB_SRP_FRAME_OVERHEAD_BYTES) * 8u * s_intervals_per_sec[cls];
+}
+
+/*
+ * Headroom of class cls: the tightest of the cumulative limits of cls and
+ * every lower-priority class (a higher class's bandwidth counts against all
+ * the limits below it).
+ */
+uint64_t avb_srp_available_bps(const avb_srp_admission_t *a, uint32_t cls)
+{
+    uint64_t used = 0, best = UINT64_MAX, limit;
+    uint32_t pct = 0, k;
+
+    if (cls >= AVB_SRP_CLASS_COUNT) {
+        return 0;
+    }
+
+    for (k = 0; k < AVB_SRP_CLASS_COUNT; k++) {
+        used += a->cls[k].reserved_bps;
+        pct  += a->cls[k].delta_pct;
+        if (k < cls) {
+            continue;
+        }
+        limit = a->port_rate_bps / 100u * pct + (a->port_rate_bps % 100u) * pct / 100u;
+        if (used >= limit) {
+            return 0;
+        }
+        if (limit - used < best) {
+            best = limit - used;
+        }
+    }
+    return best;
+}
+
+avb_srp_result_t avb_srp_admit(avb_srp_admission_t *a, uint32_t cls, uint64_t bandwidth_bps,
+                               uint32_t max_frame_size, uint64_t *reserved_bps)
+{
+    uint64_t need = avb_srp_stream_bps(cls, bandwidth_bps, max_frame_size);
+
+    if (need == 0) {
+        return AVB_SRP_E_PARAM;
+    }
+    if (need > avb_srp_available_bps(a, cls)) {
+        a->rejected_bandwidth++;
+        return AVB_SRP_E_BANDWIDTH;
+    }
+
+    a->cls[cls].reserved_bps += need;
+    a->cls[cls].streams++;
+    a->cls[cls].frame_buckets[frame_bucket(max_frame_size)]++;
+    *reserved_bps = need;
+    return AVB_SRP_OK;
+}
+
+avb_srp_result_t avb_srp_readmit(avb_srp_admission_t *a, uint32_t old_cls, uint32_t old_frame_size,
+                                 uint32_t cls, uint64_t bandwidth_bps, uint32_t max_frame_size,
+                                 uint64_t *reserved_bps)
+{
+    uint64_t old_bps = *reserved_bps;
+    avb_srp_result_t r;
+
+    avb_srp_release(a, old_cls, old_frame_size, old_bps);
+    r = avb_srp_admit(a, cls, bandwidth_bps, max_frame_size, reserved_bps);
+    if (r != AVB_SRP_OK) {
+        /* Put the old charge back without a limit check: it was admitted once */
+        a->cls[old_cls].reserved_bps += old_bps;
+        a->cls[old_cls].streams++;
+        a->cls[old_cls].frame_buckets[frame_bucket(old_frame_size)]++;
+    }
+    return r;
+}
+
+void avb_srp_release(avb_srp_admission_t *a, uint32_t cls, uint32_t max_frame_size, uint64_t reserved_bps)
+{
+    avb_srp_class_t *c;
+    uint32_t b;
+
+    if (cls >= AVB_SRP_CLASS_COUNT || max_frame_size == 0 || max_frame_size > AVB_SRP_MAX_FRAME_BYTES) {
+        return;
+    }
+    c = &a->cls[cls];
+    b = frame_bucket(max_frame_size);
+    if (c->streams == 0 || c->frame_buckets[b] == 0) {
+        return;
+    }
+
+    c->reserved_bps = (c->reserved_bps > reserved_bps) ? c->reserved_bps - reserved_bps : 0;
+    c->streams--;
+    c->frame_buckets[b]--;
+}
+
+uint32_t avb_srp_max_frame_bytes(const avb_srp_admission_t *a, uint32_t cls)
+{
+    uint32_t b;
+
+    if (cls >= AVB_SRP_CLASS_COUNT || a->cls[cls].streams == 0) {
+        return 0;
+    }
+    for (b = AVB_SRP_BUCKETS; b-- > 0;) {
+        if (a->cls[cls].frame_buckets[b]) {
+            return b << AVB_SRP_BUCKET_SHIFT;
+        }
+    }
+    return 0;
+}
+
+void avb_srp_class_shaper(const avb_srp_admission_t *a, uint32_t cls,
+                          uint32_t *idle_slope_Bps, uint32_t *hi_credit_bytes)
+{
+    uint64_t idle_bps, idle_a_bps;
+
+    *idle_slope_Bps  = 0;
+    *hi_credit_bytes = 0;
+    if (cls >= AVB_SRP_CLASS_COUNT || a->cls[cls].streams == 0) {
+        return;
+    }
+
+    idle_bps = a->cls[cls].reserved_bps;
+    *idle_slope_Bps = (uint32_t)((idle_bps + 7u) / 8u);
+
+    if (cls == 0) {
+        *hi_credit_bytes = intel_cbs_annexl_hicredit_a(AVB_SRP_MAX_INTERFERENCE_BYTES, idle_bps,
+                                                       a->port_rate_bps);
+    } else {
+        idle_a_bps = a->cls[0].reserved_bps;
+        *hi_credit_bytes = intel_cbs_annexl_hicredit_b(AVB_SRP_MAX_INTERFERENCE_BYTES,
+                                                       avb_srp_max_frame_bytes(a, 0),
+                                                       idle_a_bps, idle_bps, a->port_rate_bps);
+    }
+}
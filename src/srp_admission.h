@@ -0,0 +1,128 @@
+/*++
+
+Module Name:
+
+    srp_admission.h
+
+Abstract:
+
+    SRP (IEEE 802.1Q Clause 34/35) per-port stream admission and the credit
+    shaper parameters that follow from the admitted set.
+
+    A stream asks for bandwidth_bps of payload in frames of at most
+    max_frame_size octets (TSpec MaxFrameSize, i.e. without media framing).
+    The reservation charged against the port is what those frames cost on
+    the wire once per class measurement interval:
+
+      MaxIntervalFrames = ceil(bandwidth_bps / (max_frame_size * 8 * intervals/s))
+      reserved_bps      = MaxIntervalFrames * (max_frame_size + 42) * 8 * intervals/s
+
+    with 42 octets of 802.3 per-frame overhead (preamble+SFD 8, DA/SA 12,
+    VLAN tag 4, EtherType 2, FCS 4, IFG 12) and 8000 (Class A, 125 us) or
+    4000 (Class B, 250 us) intervals per second.
+
+    Admission follows the deltaBandwidth model of 802.1Q §34.3.1: class c
+    and every lower-priority SR class may together use at most the sum of
+    their deltaBandwidth percentages of the port rate.  Defaults are 75% for
+    Class A and 0% for Class B, i.e. A+B <= 75%.  A request that would break
+    any of these limits is refused with AVB_SRP_E_BANDWIDTH and changes
+    nothing.
+
+    After every admit/release the caller reprograms the class queue from
+    avb_srp_class_shaper(): idleSlope = reserved bandwidth, hiCredit from the
+    Annex L bounds (devices/intel_cbs.h) using the largest admitted Class A
+    frame as the Class B interference term.
+
+    Largest-frame tracking uses per-class counts in 32-octet buckets, so
+    release is O(1) in the number of streams and the hiCredit derived from it
+    is never smaller than exact.
+
+    Pure C99 (stdint only).  Callers own locking.
+
+    Implements: REQ-F-SRP-003 (SRP admission control and CBS derivation)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_SRP_CLASS_COUNT             2u      /* SR Class A, SR Class B */
+#define AVB_SRP_FRAME_OVERHEAD_BYTES    42u     /* 802.3 + VLAN per-frame overhead */
+#define AVB_SRP_MAX_FRAME_BYTES         1500u   /* largest TSpec MaxFrameSize accepted */
+#define AVB_SRP_MAX_INTERFERENCE_BYTES  1522u   /* largest best-effort frame (Annex L) */
+#define AVB_SRP_DEFAULT_DELTA_A_PCT     75u
+#define AVB_SRP_DEFAULT_DELTA_B_PCT     0u
+
+#define AVB_SRP_BUCKET_SHIFT            5u      /* 32-octet frame-size buckets */
+#define AVB_SRP_BUCKETS \
+    (((AVB_SRP_MAX_FRAME_BYTES + AVB_SRP_FRAME_OVERHEAD_BYTES) >> AVB_SRP_BUCKET_SHIFT) + 2u)
+
+typedef enum _avb_srp_result {
+    AVB_SRP_OK          = 0,
+    AVB_SRP_E_PARAM     = 1,    /* class, bandwidth or frame size out of range */
+    AVB_SRP_E_BANDWIDTH = 2     /* deltaBandwidth limit would be exceeded */
+} avb_srp_result_t;
+
+typedef struct _avb_srp_class {
+    uint64_t reserved_bps;                  /* sum of admitted wire bandwidth */
+    uint32_t streams;
+    uint32_t delta_pct;                     /* deltaBandwidth of this class */
+    uint32_t frame_buckets[AVB_SRP_BUCKETS];/* admitted streams per wire-size bucket */
+} avb_srp_class_t;
+
+typedef struct _avb_srp_admission {
+    uint64_t port_rate_bps;
+    avb_srp_class_t cls[AVB_SRP_CLASS_COUNT];
+    uint64_t rejected_bandwidth;            /* requests refused for bandwidth */
+} avb_srp_admission_t;
+
+/** Empty table with default deltaBandwidth (75% / 0%) */
+void avb_srp_init(avb_srp_admission_t *a, uint64_t port_rate_bps);
+
+/** New link rate; admitted streams are kept even if they no longer fit */
+void avb_srp_set_port_rate(avb_srp_admission_t *a, uint64_t port_rate_bps);
+
+/** Wire bandwidth charged for a stream, 0 if the parameters are invalid */
+uint64_t avb_srp_stream_bps(uint32_t cls, uint64_t bandwidth_bps, uint32_t max_frame_size);
+
+/**
+ * Admit a stream.  On AVB_SRP_OK *reserved_bps receives the charged wire
+ * bandwidth, which the caller must hand back to avb_srp_release().
+ */
+avb_srp_result_t avb_srp_admit(avb_srp_admission_t *a, uint32_t cls, uint64_t bandwidth_bps,
+                               uint32_t max_frame_size, uint64_t *reserved_bps);
+
+/** Release a stream admitted with the same class, frame size and reserved_bps */
+void avb_srp_release(avb_srp_admission_t *a, uint32_t cls, uint32_t max_frame_size, uint64_t reserved_bps);
+
+/**
+ * Change an admitted stream's TSpec: admit the new values as if the old
+ * charge (old_cls, old_frame_size, *reserved_bps) were already released.
+ * On AVB_SRP_OK *reserved_bps is the new charge; otherwise the old charge
+ * stays exactly as it was, even if it no longer fits after a link rate drop.
+ */
+avb_srp_result_t avb_srp_readmit(avb_srp_admission_t *a, uint32_t old_cls, uint32_t old_frame_size,
+                                 uint32_t cls, uint64_t bandwidth_bps, uint32_t max_frame_size,
+                                 uint64_t *reserved_bps);
+
+/** Bandwidth class cls could still admit right now (bits/s) */
+uint64_t avb_srp_available_bps(const avb_srp_admission_t *a, uint32_t cls);
+
+/** Largest admitted wire frame in cls, rounded up to the bucket size (0 = none) */
+uint32_t avb_srp_max_frame_bytes(const avb_srp_admission_t *a, uint32_t cls);
+
+/**
+ * Shaper parameters for the class queue: idleSlope in bytes/s (rounded up)
+ * and the Annex L hiCredit in bytes.  Both 0 when the class is empty.
+ */
+void avb_srp_class_shaper(const avb_srp_admission_t *a, uint32_t cls,
+                          uint32_t *idle_slope_Bps, uint32_t *hi_credit_bytes);
+
+#ifdef __cplusplus
+}
+#endif
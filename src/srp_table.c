@@ -0,0 +1,238 @@
+/*++
+
+Module Name:
+
+    srp_table.c
+
+Abstract:
+
+    Hashed SRP reservation store - implementation.  See srp_table.h for the
+    layout and handle format.
+
+--*/
+
+#include "srp_table.h"
+
+#define HANDLE_INDEX_MASK   0xFFFFu
+#define HANDLE_GEN_SHIFT    16u
+
+/* splitmix64 finalizer: stream IDs share their MAC prefix, only the low
+ * 16-bit unique ID differs, so the bits need spreading before masking */
+static uint32_t hash_stream_id(uint64_t id)
+{
+    id ^= id >> 30;
+    id *= 0xBF58476D1CE4E5B9ull;
+    id ^= id >> 27;
+    id *= 0x94D049BB133111EBull;
+    id ^= id >> 31;
+    return (uint32_t)id;
+}
+
+static uint32_t index_mask(const avb_srp_table_t *t)
+{
+    return 2u * t->capacity - 1u;
+}
+
+size_t avb_srp_table_storage_bytes(uint32_t capacity)
+{
+    return (size_t)capacity * sizeof(avb_srp_entry_t) + (size_t)capacity * 2u * sizeof(uint32_t);
+}
+
+void avb_srp_table_init(avb_srp_table_t *t, uint32_t limit)
+{
+    t->entries    = NULL;
+    t->index      = NULL;
+    t->storage    = NULL;
+    t->capacity   = 0;
+    t->limit      = (limit == 0 || limit > AVB_SRP_TABLE_MAX_LIMIT) ? AVB_SRP_TABLE_MAX_LIMIT : limit;
+    t->count      = 0;
+    t->free_head  = 0;
+    t->high_water = 0;
+}
+
+uint32_t avb_srp_table_grow_capacity(const avb_srp_table_t *t)
+{
+    if (t->count >= t->limit) {
+        return 0;
+    }
+    if (t->capacity == 0) {
+        return AVB_SRP_TABLE_MIN_CAPACITY;
+    }
+    if (t->free_head != 0 || t->high_water < t->capacity) {
+        return 0;
+    }
+    return t->capacity * 2u;
+}
+
+static void index_put(avb_srp_table_t *t, uint32_t entry_idx)
+{
+    uint32_t mask = index_mask(t);
+    uint32_t b = hash_stream_id(t->entries[entry_idx].stream_id) & mask;
+
+    while (t->index[b] != 0) {
+        b = (b + 1u) & mask;
+    }
+    t->index[b] = entry_idx + 1u;
+}
+
+void *avb_srp_table_grow(avb_srp_table_t *t, void *storage, uint32_t new_capacity)
+{
+    void *old = t->storage;
+    avb_srp_entry_t *entries = (avb_srp_entry_t *)storage;
+    uint32_t *index = (uint32_t *)(entries + new_capacity);
+    uint32_t i;
+
+    for (i = 0; i < new_capacity; i++) {
+        if (i < t->capacity) {
+            entries[i] = t->entries[i];
+        } else {
+            entries[i].stream_id  = 0;
+            entries[i].handle     = 0;
+            entries[i].generation = 0;
+            entries[i].next_free  = 0;
+        }
+    }
+    for (i = 0; i < 2u * new_capacity; i++) {
+        index[i] = 0;
+    }
+
+    t->entries  = entries;
+    t->index    = index;
+    t->storage  = storage;
+    t->capacity = new_capacity;
+
+    for (i = 0; i < t->high_water; i++) {
+        if (entries[i].handle != 0) {
+            index_put(t, i);
+        }
+    }
+    return old;
+}
+
+int avb_srp_table_set_limit(avb_srp_table_t *t, uint32_t limit)
+{
+    if (limit < t->count || limit == 0 || limit > AVB_SRP_TABLE_MAX_LIMIT) {
+        return -1;
+    }
+    t->limit = limit;
+    return 0;
+}
+
+/* Hash bucket holding stream_id, or the empty bucket where it would go */
+static uint32_t index_probe(const avb_srp_table_t *t, uint64_t stream_id)
+{
+    uint32_t mask = index_mask(t);
+    uint32_t b = hash_stream_id(stream_id) & mask;
+
+    while (t->index[b] != 0 && t->entries[t->index[b] - 1u].stream_id != stream_id) {
+        b = (b + 1u) & mask;
+    }
+    return b;
+}
+
+avb_srp_entry_t *avb_srp_table_find(const avb_srp_table_t *t, uint64_t stream_id)
+{
+    uint32_t b;
+
+    if (t->count == 0) {
+        return NULL;
+    }
+    b = index_probe(t, stream_id);
+    return t->index[b] ? &t->entries[t->index[b] - 1u] : NULL;
+}
+
+avb_srp_entry_t *avb_srp_table_find_handle(const avb_srp_table_t *t, uint32_t handle)
+{
+    uint32_t i = handle & HANDLE_INDEX_MASK;
+
+    if (i == 0 || i > t->high_water || t->entries[i - 1u].handle != handle) {
+        return NULL;
+    }
+    return &t->entries[i - 1u];
+}
+
+avb_srp_entry_t *avb_srp_table_insert(avb_srp_table_t *t, uint64_t stream_id)
+{
+    avb_srp_entry_t *e;
+    uint32_t i;
+    uint16_t gen;
+
+    if (t->count >= t->limit) {
+        return NULL;
+    }
+    if (t->free_head != 0) {
+        i = t->free_head - 1u;
+        t->free_head = t->entries[i].next_free;
+    } else if (t->high_water < t->capacity) {
+        i = t->high_water++;
+    } else {
+        return NULL;
+    }
+
+    e = &t->entries[i];
+    gen = (uint16_t)(e->generation + 1u);
+    if (gen == 0) {
+        gen = 1;
+    }
+    e->stream_id      = stream_id;
+    e->reserved_bps   = 0;
+    e->bandwidth_bps  = 0;
+    e->max_frame_size = 0;
+    e->latency_class  = 0;
+    e->pad            = 0;
+    e->pad2           = 0;
+    e->generation     = gen;
+    e->next_free      = 0;
+    e->handle         = ((uint32_t)gen << HANDLE_GEN_SHIFT) | (i + 1u);
+
+    t->index[index_probe(t, stream_id)] = i + 1u;
+    t->count++;
+    return e;
+}
+
+void avb_srp_table_remove(avb_srp_table_t *t, avb_srp_entry_t *e)
+{
+    uint32_t mask = index_mask(t);
+    uint32_t i = (uint32_t)(e - t->entries);
+    uint32_t hole, b, home;
+
+    if (e->handle == 0) {
+        return;
+    }
+
+    /* Backward-shift delete: pull later members of the probe run into the
+     * hole unless that would move them before their home bucket */
+    hole = index_probe(t, e->stream_id);
+    b = hole;
+    for (;;) {
+        b = (b + 1u) & mask;
+        if (t->index[b] == 0) {
+            break;
+        }
+        home = hash_stream_id(t->entries[t->index[b] - 1u].stream_id) & mask;
+        if (((b - home) & mask) >= ((b - hole) & mask)) {
+            t->index[hole] = t->index[b];
+            hole = b;
+        }
+    }
+    t->index[hole] = 0;
+
+    e->handle    = 0;
+    e->stream_id = 0;
+    e->next_free = t->free_head;
+    t->free_head = i + 1u;
+    t->count--;
+}
+
+avb_srp_entry_t *avb_srp_table_next(const avb_srp_table_t *t, uint32_t cursor, uint32_t *next_cursor)
+{
+    uint32_t i;
+
+    for (i = cursor; i < t->high_water; i++) {
+        if (t->entries[i].handle != 0) {
+            *next_cursor = i + 1u;
+            return &t->entries[i];
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,116 @@
+/*++
+
+Module Name:
+
+    srp_table.h
+
+Abstract:
+
+    SRP reservation store: hashed by the 64-bit stream_id, addressed by an
+    opaque 32-bit reservation handle, sized on demand up to a per-port limit.
+
+    Layout (one caller-provided block, see avb_srp_table_storage_bytes):
+
+      entries[capacity]      reservation records; a record never moves while
+                             it is live, so its index is part of the handle
+      index[2 * capacity]    open-addressed hash of stream_id -> entry index + 1
+                             (linear probing, backward-shift delete, load <= 1/2)
+
+    Handle = (generation << 16) | (entry index + 1).  The per-entry generation
+    is bumped every time the entry is reused, so a stale handle never matches
+    a newer reservation in the same slot.  Handles are never 0.
+
+    Register, lookup by stream_id or handle, and deregister are O(1) expected.
+    Growth doubles the capacity into a new block and copies the entries
+    (indices, and therefore handles, are preserved) and rebuilds the hash.
+    The module never allocates: the caller supplies storage, so the same code
+    runs in the driver (non-paged pool) and in host tests.
+
+    Enumeration walks the entry array by cursor (entry index + 1), which stays
+    valid across pages and across growth.
+
+    Pure C99 (stdint only).  Callers own locking.
+
+    Implements: REQ-F-SRP-004 (Scalable SRP reservation store)
+
+--*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_SRP_TABLE_MIN_CAPACITY  16u     /* first allocation */
+#define AVB_SRP_TABLE_MAX_LIMIT     4096u   /* hard ceiling for the per-port bound */
+#define AVB_SRP_TABLE_DEFAULT_LIMIT 512u    /* per-port bound until reconfigured */
+
+typedef struct _avb_srp_entry {
+    uint64_t stream_id;
+    uint64_t reserved_bps;      /* wire bandwidth charged by srp_admission */
+    uint32_t handle;            /* 0 = free */
+    uint32_t bandwidth_bps;     /* requested payload bandwidth */
+    uint16_t max_frame_size;
+    uint8_t  latency_class;
+    uint8_t  pad;
+    uint16_t generation;        /* bumped on reuse, part of the handle */
+    uint16_t pad2;
+    uint32_t next_free;         /* free list: entry index + 1, 0 = end */
+} avb_srp_entry_t;
+
+typedef struct _avb_srp_table {
+    avb_srp_entry_t *entries;
+    uint32_t *index;
+    void     *storage;          /* block passed to init / grow */
+    uint32_t capacity;          /* power of two, 0 before the first grow */
+    uint32_t limit;             /* max live reservations */
+    uint32_t count;
+    uint32_t free_head;         /* entry index + 1 of the first free entry */
+    uint32_t high_water;        /* entries ever handed out (next never-used index) */
+} avb_srp_table_t;
+
+/** Bytes of storage for a table of capacity entries (power of two) */
+size_t avb_srp_table_storage_bytes(uint32_t capacity);
+
+/** Empty table with no storage yet; every insert needs a grow first */
+void avb_srp_table_init(avb_srp_table_t *t, uint32_t limit);
+
+/**
+ * Capacity the next grow should use, or 0 when the table has room or is at
+ * its limit (insert will then fail).
+ */
+uint32_t avb_srp_table_grow_capacity(const avb_srp_table_t *t);
+
+/**
+ * Move the table into storage of new_capacity entries (power of two, larger
+ * than the current capacity).  Returns the previous storage block (NULL on
+ * the first grow) for the caller to free.
+ */
+void *avb_srp_table_grow(avb_srp_table_t *t, void *storage, uint32_t new_capacity);
+
+/** Set the live-reservation bound; fails (-1) below count or above the ceiling */
+int avb_srp_table_set_limit(avb_srp_table_t *t, uint32_t limit);
+
+avb_srp_entry_t *avb_srp_table_find(const avb_srp_table_t *t, uint64_t stream_id);
+avb_srp_entry_t *avb_srp_table_find_handle(const avb_srp_table_t *t, uint32_t handle);
+
+/**
+ * Add stream_id (must not be present).  Returns the zeroed entry with
+ * stream_id and handle set, or NULL when the table is full or at its limit.
+ */
+avb_srp_entry_t *avb_srp_table_insert(avb_srp_table_t *t, uint64_t stream_id);
+
+void avb_srp_table_remove(avb_srp_table_t *t, avb_srp_entry_t *e);
+
+/**
+ * First live entry at or after cursor (0 = start).  Returns NULL at the end;
+ * otherwise *next_cursor resumes after the returned entry.
+ */
+avb_srp_entry_t *avb_srp_table_next(const avb_srp_table_t *t, uint32_t cursor, uint32_t *next_cursor);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,231 @@
+/*++
+
+Module Name:
+
+    tas_gcl.c
+
+Abstract:
+
+    802.1Qbv GCL compiler / validator - implementation.  See tas_gcl.h for
+    the normalization rules and diagnostics.  The offline analyzer
+    (tools/tas_analyzer) links this file too, so it judges a schedule exactly
+    as SETUP_TAS will.
+
+--*/
+
+#include "tas_gcl.h"
+
+#define NSEC_PER_SEC    1000000000ull
+
+void avb_tas_caps_i225(avb_tas_caps_t *caps)
+{
+    caps->queues            = 4;
+    caps->max_entries       = 8;            /* tsn_tas_config gate_states[] / gate_durations[] */
+    caps->min_interval_ns   = 0;
+    caps->max_cycle_ns      = 1000000000u;  /* QBVCYCLET */
+    caps->windows_per_queue = 1;            /* STQT/ENDQT */
+    caps->window_wrap       = 0;
+}
+
+uint32_t avb_tas_frame_ns(uint32_t frame_bytes, uint64_t link_bps)
+{
+    uint64_t bits = (uint64_t)frame_bytes * 8u;
+    uint64_t ns;
+
+    if (frame_bytes == 0 || link_bps == 0) {
+        return 0;
+    }
+    /* Split so bits * 1e9 cannot overflow for links up to 10 Gb/s */
+    ns = (bits / link_bps) * NSEC_PER_SEC + ((bits % link_bps) * NSEC_PER_SEC + link_bps - 1u) / link_bps;
+    return (ns > 0xFFFFFFFFull) ? 0xFFFFFFFFu : (uint32_t)ns;
+}
+
+static avb_tas_result_t fail(avb_tas_diag_t *diag, avb_tas_result_t code, uint32_t entry, uint32_t queue,
+                             uint64_t value, uint64_t limit)
+{
+    if (diag != NULL) {
+        diag->code   = code;
+        diag->entry  = entry;
+        diag->queue  = (uint8_t)queue;
+        diag->value  = value;
+        diag->limit  = limit;
+    }
+    return code;
+}
+
+/* Windows of queue q; first_entry[] (optional) receives each window's first operational entry */
+static uint32_t queue_windows(const avb_tas_schedule_t *s, uint32_t q, avb_tas_window_t *w,
+                              uint32_t *first_entry, uint32_t max)
+{
+    avb_tas_window_t run[AVB_TAS_MAX_ENTRIES];
+    uint32_t run_entry[AVB_TAS_MAX_ENTRIES];
+    uint32_t i, k, t = 0, runs = 0, skip = 0;
+    int open_prev = 0;
+
+    for (i = 0; i < s->count; i++) {
+        int open = (s->entries[i].gates >> q) & 1;
+
+        if (open && !open_prev) {
+            run[runs].start_ns  = t;
+            run[runs].length_ns = 0;
+            run_entry[runs]     = i;
+            runs++;
+        }
+        if (open) {
+            run[runs - 1u].length_ns += s->entries[i].interval_ns;
+        }
+        open_prev = open;
+        t += s->entries[i].interval_ns;
+    }
+
+    /* Open at both ends of the cycle: one window across the boundary */
+    if (s->window_wrap && runs > 1 && run[0].start_ns == 0 && open_prev) {
+        run[runs - 1u].length_ns += run[0].length_ns;
+        skip = 1;
+    }
+    for (k = skip; k < runs && k - skip < max; k++) {
+        w[k - skip] = run[k];
+        if (first_entry) {
+            first_entry[k - skip] = run_entry[k];
+        }
+    }
+    return runs - skip;
+}
+
+uint32_t avb_tas_queue_windows(const avb_tas_schedule_t *s, uint32_t q, avb_tas_window_t *w, uint32_t max)
+{
+    if (s == NULL || q >= s->queues) {
+        return 0;
+    }
+    return queue_windows(s, q, w, NULL, max);
+}
+
+avb_tas_result_t avb_tas_compile(const avb_tas_caps_t *caps, const avb_tas_traffic_t *traffic,
+                                 const uint8_t *gates, const uint32_t *intervals, uint32_t n,
+                                 uint64_t cycle_ns, avb_tas_schedule_t *out, avb_tas_diag_t *diag)
+{
+    avb_tas_window_t win[AVB_TAS_MAX_ENTRIES];
+    uint32_t win_entry[AVB_TAS_MAX_ENTRIES];
+    uint64_t sum = 0;
+    uint32_t i, q, count = 0;
+    uint8_t qmask, ignored = 0;
+
+    (void)fail(diag, AVB_TAS_OK, AVB_TAS_NO_ENTRY, AVB_TAS_NO_QUEUE, 0, 0);
+    if (caps == NULL || out == NULL || (n != 0 && (gates == NULL || intervals == NULL)) ||
+        caps->queues == 0 || caps->queues > AVB_TAS_MAX_QUEUES ||
+        caps->max_entries == 0 || caps->max_entries > AVB_TAS_MAX_ENTRIES) {
+        return fail(diag, AVB_TAS_E_PARAM, AVB_TAS_NO_ENTRY, AVB_TAS_NO_QUEUE, 0, 0);
+    }
+    qmask = (uint8_t)((1u << caps->queues) - 1u);
+
+    /* Drop empty entries, mask absent queues, merge equal neighbours */
+    for (i = 0; i < n; i++) {
+        uint8_t g;
+
+        if (intervals[i] == 0) {
+            continue;
+        }
+        g = gates[i] & qmask;
+        ignored |= (uint8_t)(gates[i] & ~qmask);
+        sum += intervals[i];
+        if (count > 0 && out->entries[count - 1u].gates == g) {
+            /* Saturate: a merged interval this long fails the cycle checks below */
+            uint64_t merged = (uint64_t)out->entries[count - 1u].interval_ns + intervals[i];
+            out->entries[count - 1u].interval_ns = (merged > 0xFFFFFFFFull) ? 0xFFFFFFFFu : (uint32_t)merged;
+            continue;
+        }
+        if (count == AVB_TAS_MAX_ENTRIES) {
+            return fail(diag, AVB_TAS_E_TOO_MANY_ENTRIES, i, AVB_TAS_NO_QUEUE, count + 1u, caps->max_entries);
+        }
+        out->entries[count].interval_ns = intervals[i];
+        out->entries[count].gates       = g;
+        out->entries[count].pad         = 0;
+        out->entries[count].src         = (uint16_t)(i > 0xFFFFu ? 0xFFFFu : i);
+        count++;
+    }
+    if (count == 0) {
+        return fail(diag, AVB_TAS_E_EMPTY, AVB_TAS_NO_ENTRY, AVB_TAS_NO_QUEUE, n, 1);
+    }
+
+    if (cycle_ns == 0) {
+        cycle_ns = sum;
+    }
+    if (cycle_ns > caps->max_cycle_ns) {
+        return fail(diag, AVB_TAS_E_CYCLE_RANGE, AVB_TAS_NO_ENTRY, AVB_TAS_NO_QUEUE, cycle_ns, caps->max_cycle_ns);
+    }
+    if (sum > cycle_ns) {
+        return fail(diag, AVB_TAS_E_CYCLE_SHORT, AVB_TAS_NO_ENTRY, AVB_TAS_NO_QUEUE, cycle_ns, sum);
+    }
+    out->entries[count - 1u].interval_ns += (uint32_t)(cycle_ns - sum);
+
+    for (i = 0; i < count; i++) {
+        if (out->entries[i].interval_ns < caps->min_interval_ns) {
+            return fail(diag, AVB_TAS_E_INTERVAL_SHORT, out->entries[i].src, AVB_TAS_NO_QUEUE,
+                        out->entries[i].interval_ns, caps->min_interval_ns);
+        }
+    }
+    if (count > caps->max_entries) {
+        return fail(diag, AVB_TAS_E_TOO_MANY_ENTRIES, out->entries[caps->max_entries].src, AVB_TAS_NO_QUEUE,
+                    count, caps->max_entries);
+    }
+
+    out->cycle_ns      = (uint32_t)cycle_ns;
+    out->count         = count;
+    out->queues        = caps->queues;
+    out->window_wrap   = caps->window_wrap ? 1u : 0u;
+    out->ignored_gates = ignored;
+    out->pad[0] = out->pad[1] = out->pad[2] = 0;
+
+    for (q = 0; q < AVB_TAS_MAX_QUEUES; q++) {
+        uint32_t frame_ns = 0, k;
+
+        out->open_ns[q] = 0;
+        out->windows[q] = 0;
+        if (q >= caps->queues) {
+            continue;
+        }
+        for (i = 0; i < count; i++) {
+            if ((out->entries[i].gates >> q) & 1u) {
+                out->open_ns[q] += out->entries[i].interval_ns;
+            }
+        }
+        out->windows[q] = queue_windows(out, q, win, win_entry, AVB_TAS_MAX_ENTRIES);
+
+        if (caps->windows_per_queue != 0 && out->windows[q] > caps->windows_per_queue) {
+            return fail(diag, AVB_TAS_E_WINDOWS, out->entries[win_entry[caps->windows_per_queue]].src, q,
+                        out->windows[q], caps->windows_per_queue);
+        }
+        if (traffic == NULL || traffic->max_frame_bytes[q] == 0) {
+            continue;
+        }
+        if (out->open_ns[q] == 0) {
+            return fail(diag, AVB_TAS_E_STARVED, AVB_TAS_NO_ENTRY, q, 0,
+                        avb_tas_frame_ns(traffic->max_frame_bytes[q], traffic->link_bps));
+        }
+        frame_ns = avb_tas_frame_ns(traffic->max_frame_bytes[q], traffic->link_bps);
+        for (k = 0; k < out->windows[q]; k++) {
+            if (win[k].length_ns < frame_ns) {
+                return fail(diag, AVB_TAS_E_GUARD_BAND, out->entries[win_entry[k]].src, q,
+                            win[k].length_ns, frame_ns);
+            }
+        }
+    }
+    return AVB_TAS_OK;
+}
+
+const char *avb_tas_result_str(avb_tas_result_t r)
+{
+    switch (r) {
+    case AVB_TAS_OK:                 return "ok";
+    case AVB_TAS_E_PARAM:            return "invalid argument";
+    case AVB_TAS_E_EMPTY:            return "no entry with a nonzero interval";
+    case AVB_TAS_E_INTERVAL_SHORT:   return "interval shorter than the device minimum";
+    case AVB_TAS_E_CYCLE_RANGE:      return "cycle time above the device maximum";
+    case AVB_TAS_E_CYCLE_SHORT:      return "cycle time shorter than the sum of intervals";
+    case AVB_TAS_E_TOO_MANY_ENTRIES: return "more entries than the device holds";
+    case AVB_TAS_E_WINDOWS:          return "queue opens more often per cycle than the device supports";
+    case AVB_TAS_E_STARVED:          return "queue with traffic never opens";
+    case AVB_TAS_E_GUARD_BAND:       return "window shorter than the queue's largest frame";
+    default:                         return "unknown";
+    }
+}
@@ -0,0 +1,159 @@
+/*++
+
+Module Name:
+
+    tas_gcl.h
+
+Abstract:
+
+    IEEE 802.1Qbv gate control list (GCL) compiler and validator, shared by
+    the driver (AvbValidateTsnConfig, IOCTL_AVB_SETUP_TAS) and host tools.
+
+    Input is an admin GCL: per entry a gate mask (bit q = queue q open) and
+    an interval in ns, plus a cycle time.  Compilation normalizes it into the
+    operational list a port would run:
+
+      1. zero-length entries are dropped
+      2. gate bits above the device's queue count are masked off (reported
+         in ignored_gates, not an error: the AVB_TAS_CONFIG_* templates are
+         written for eight traffic classes)
+      3. adjacent entries with the same gate mask are merged
+      4. cycle time 0 means the sum of the intervals; a longer cycle
+         stretches the last entry to the cycle end (802.1Qbv: the last gate
+         state holds until the cycle restarts)
+
+    and validates it against a device capability descriptor and, optionally,
+    the traffic each queue carries:
+
+      AVB_TAS_E_EMPTY            no entry with a nonzero interval
+      AVB_TAS_E_INTERVAL_SHORT   entry shorter than the device can time
+      AVB_TAS_E_CYCLE_RANGE      cycle above the device maximum
+      AVB_TAS_E_CYCLE_SHORT      cycle shorter than the sum of the intervals
+                                 (the list would overlap the next cycle)
+      AVB_TAS_E_TOO_MANY_ENTRIES more entries (after merging) than the device holds
+      AVB_TAS_E_WINDOWS          a queue opens more often per cycle than the
+                                 device has windows for (I225/I226: one)
+      AVB_TAS_E_STARVED          a queue that carries traffic never opens
+      AVB_TAS_E_GUARD_BAND       a window of a queue is shorter than the wire
+                                 time of that queue's largest frame, so the
+                                 frame can never start in it
+
+    Every failure fills an avb_tas_diag_t naming the input entry and/or queue
+    and the offending value against its limit.
+
+    Pure C99 (stdint only), no allocation, no formatted output: the same
+    source runs in the kernel, in tools and in host tests and fuzzers.  All
+    state is on the caller's side.
+
+    Implements: REQ-F-TAS-002 (TAS schedule compilation and validation)
+
+--*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_TAS_MAX_QUEUES          8u
+#define AVB_TAS_MAX_ENTRIES         32u     /* operational entries after merging */
+#define AVB_TAS_NO_ENTRY            0xFFFFFFFFu
+#define AVB_TAS_NO_QUEUE            0xFFu
+
+typedef enum _avb_tas_result {
+    AVB_TAS_OK = 0,
+    AVB_TAS_E_PARAM,
+    AVB_TAS_E_EMPTY,
+    AVB_TAS_E_INTERVAL_SHORT,
+    AVB_TAS_E_CYCLE_RANGE,
+    AVB_TAS_E_CYCLE_SHORT,
+    AVB_TAS_E_TOO_MANY_ENTRIES,
+    AVB_TAS_E_WINDOWS,
+    AVB_TAS_E_STARVED,
+    AVB_TAS_E_GUARD_BAND
+} avb_tas_result_t;
+
+/** What the port can run */
+typedef struct _avb_tas_caps {
+    uint32_t queues;            /* gate bits honored, 1..AVB_TAS_MAX_QUEUES */
+    uint32_t max_entries;       /* operational entries, <= AVB_TAS_MAX_ENTRIES */
+    uint32_t min_interval_ns;   /* shortest entry, 0 = no limit */
+    uint32_t max_cycle_ns;
+    uint32_t windows_per_queue; /* open windows per queue per cycle, 0 = unlimited */
+    uint32_t window_wrap;       /* nonzero: a window may run across the cycle boundary */
+} avb_tas_caps_t;
+
+/** Optional per-queue traffic description for starvation / guard-band checks */
+typedef struct _avb_tas_traffic {
+    uint64_t link_bps;
+    uint32_t max_frame_bytes[AVB_TAS_MAX_QUEUES];   /* on the wire incl. preamble/IFG, 0 = queue unused */
+} avb_tas_traffic_t;
+
+typedef struct _avb_tas_entry {
+    uint32_t interval_ns;
+    uint8_t  gates;
+    uint8_t  pad;
+    uint16_t src;               /* first input entry merged into this one */
+} avb_tas_entry_t;
+
+/** Operational schedule */
+typedef struct _avb_tas_schedule {
+    uint32_t cycle_ns;
+    uint32_t count;
+    uint32_t queues;
+    uint32_t window_wrap;
+    uint8_t  ignored_gates;     /* gate bits masked off (queues the device lacks) */
+    uint8_t  pad[3];
+    uint32_t open_ns[AVB_TAS_MAX_QUEUES];       /* total open time per cycle */
+    uint32_t windows[AVB_TAS_MAX_QUEUES];       /* open windows per cycle */
+    avb_tas_entry_t entries[AVB_TAS_MAX_ENTRIES];
+} avb_tas_schedule_t;
+
+/** One open window of a queue; start_ns + length_ns may pass the cycle end when wrapping */
+typedef struct _avb_tas_window {
+    uint32_t start_ns;
+    uint32_t length_ns;
+} avb_tas_window_t;
+
+typedef struct _avb_tas_diag {
+    avb_tas_result_t code;
+    uint32_t entry;             /* input entry index, AVB_TAS_NO_ENTRY if not entry-specific */
+    uint8_t  queue;             /* AVB_TAS_NO_QUEUE if not queue-specific */
+    uint8_t  pad[3];
+    uint64_t value;             /* offending value (ns, count, ...) */
+    uint64_t limit;             /* limit it violated */
+} avb_tas_diag_t;
+
+/** Capabilities of the I225/I226 Qbv engine (one STQT/ENDQT window per queue) */
+void avb_tas_caps_i225(avb_tas_caps_t *caps);
+
+/** Wire time of frame_bytes at link_bps, rounded up (0 if either is 0) */
+uint32_t avb_tas_frame_ns(uint32_t frame_bytes, uint64_t link_bps);
+
+/**
+ * Compile and validate n input entries.
+ *
+ * @param traffic NULL skips the starvation and guard-band checks
+ * @param diag    NULL if not wanted; filled on every return (code AVB_TAS_OK on success)
+ * @return AVB_TAS_OK, or the first violation found; *out is complete only on success
+ */
+avb_tas_result_t avb_tas_compile(const avb_tas_caps_t *caps, const avb_tas_traffic_t *traffic,
+                                 const uint8_t *gates, const uint32_t *intervals, uint32_t n,
+                                 uint64_t cycle_ns, avb_tas_schedule_t *out, avb_tas_diag_t *diag);
+
+/**
+ * Open windows of queue q in a compiled schedule, in cycle order (a wrapping
+ * window, if the schedule allows one, is reported last).  Returns the
+ * number of windows, writing at most max of them.
+ */
+uint32_t avb_tas_queue_windows(const avb_tas_schedule_t *s, uint32_t q, avb_tas_window_t *w, uint32_t max);
+
+/** Short constant description of a result code */
+const char *avb_tas_result_str(avb_tas_result_t r);
+
+#ifdef __cplusplus
+}
+#endif
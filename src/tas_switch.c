@@ -0,0 +1,149 @@
+/*++
+
+Module Name:
+
+    tas_switch.c
+
+Abstract:
+
+    Admin/operational Qbv schedule switch - implementation.  See
+    tas_switch.h.
+
+--*/
+
+#include "tas_switch.h"
+
+/* First point base + k * cycle (k >= 0) at or after t */
+static uint64_t roll_forward(uint64_t base, uint64_t cycle, uint64_t t)
+{
+    if (base >= t) {
+        return base;
+    }
+    return base + ((t - base + cycle - 1u) / cycle) * cycle;
+}
+
+void avb_tas_switch_init(avb_tas_switch_t *sw)
+{
+    sw->oper_base_ns     = 0;
+    sw->admin_base_ns    = 0;
+    sw->config_change_ns = 0;
+    sw->config_changes   = 0;
+    sw->cycles_lost      = 0;
+    sw->stop_ns          = 0;
+    sw->oper_cycle_ns    = 0;
+    sw->admin_cycle_ns   = 0;
+    sw->last_cycles_lost = 0;
+    sw->state            = AVB_TAS_SW_IDLE;
+    sw->last_error       = 0;
+    sw->staged           = 0;
+}
+
+int avb_tas_switch_running(const avb_tas_switch_t *sw)
+{
+    return sw->state == AVB_TAS_SW_ACTIVE || (sw->state == AVB_TAS_SW_PENDING && sw->staged);
+}
+
+uint64_t avb_tas_switch_next_boundary(const avb_tas_switch_t *sw, uint64_t now_ns)
+{
+    if (!avb_tas_switch_running(sw)) {
+        return now_ns;
+    }
+    return roll_forward(sw->oper_base_ns, sw->oper_cycle_ns, now_ns);
+}
+
+/* Operational cycles that start before t (none before the base) */
+static uint64_t cycles_before(const avb_tas_switch_t *sw, uint64_t t)
+{
+    if (t <= sw->oper_base_ns) {
+        return 0;
+    }
+    return (t - sw->oper_base_ns + sw->oper_cycle_ns - 1u) / sw->oper_cycle_ns;
+}
+
+uint64_t avb_tas_switch_stop_time(const avb_tas_switch_t *sw, uint64_t cct_ns, uint64_t lead_ns)
+{
+    uint64_t t = (cct_ns > lead_ns) ? cct_ns - lead_ns : 0;
+
+    if (!avb_tas_switch_running(sw) || t <= sw->oper_base_ns) {
+        return t;
+    }
+    return t - (t - sw->oper_base_ns) % sw->oper_cycle_ns;
+}
+
+void avb_tas_switch_poll(avb_tas_switch_t *sw, uint64_t now_ns)
+{
+    /* A staged switch only takes effect once the driver has armed it */
+    if (sw->state != AVB_TAS_SW_PENDING || sw->staged || now_ns < sw->config_change_ns) {
+        return;
+    }
+    sw->oper_base_ns  = sw->config_change_ns;
+    sw->oper_cycle_ns = sw->admin_cycle_ns;
+    sw->config_changes++;
+    sw->state = AVB_TAS_SW_ACTIVE;
+}
+
+void avb_tas_switch_stage(avb_tas_switch_t *sw, uint64_t admin_base_ns, uint32_t admin_cycle_ns,
+                          uint64_t cct_ns, uint64_t stop_ns)
+{
+    sw->admin_base_ns    = admin_base_ns;
+    sw->admin_cycle_ns   = admin_cycle_ns;
+    sw->config_change_ns = cct_ns;
+    sw->stop_ns          = stop_ns;
+    sw->last_error       = 0;
+    sw->staged           = 1;
+    sw->state            = AVB_TAS_SW_PENDING;
+}
+
+uint32_t avb_tas_switch_commit(avb_tas_switch_t *sw, uint64_t admin_base_ns, uint32_t admin_cycle_ns,
+                               uint64_t cct_ns, uint64_t stop_ns, uint64_t done_ns)
+{
+    uint64_t start = roll_forward(cct_ns, admin_cycle_ns, done_ns);
+    uint64_t done  = 0;
+    uint64_t until = 0;
+    uint64_t lost  = 0;
+
+    /*
+     * Lost: operational cycles not completed at the stop that would have
+     * started before the new list does (a staged switch: the list that ran
+     * up to the stop).  An armed pending switch that stopped a
+     * running list already counted the gap up to its own start; re-arming
+     * it only adds the extension.  Nothing is lost when no list ran (first
+     * start, or after ERROR): the first start is just later.
+     */
+    if (avb_tas_switch_running(sw)) {
+        done  = (stop_ns > sw->oper_base_ns) ? (stop_ns - sw->oper_base_ns) / sw->oper_cycle_ns : 0;
+        until = cycles_before(sw, start);
+    } else if (sw->state == AVB_TAS_SW_PENDING && sw->oper_cycle_ns != 0) {
+        done  = cycles_before(sw, sw->config_change_ns);
+        until = cycles_before(sw, start);
+    } else if (sw->state != AVB_TAS_SW_PENDING) {
+        sw->oper_base_ns  = 0;      /* nothing was stopped: no operational list to account */
+        sw->oper_cycle_ns = 0;
+    }
+    if (until > done) {
+        lost = until - done;
+    }
+    if (lost > 0xFFFFFFFFu) {
+        lost = 0xFFFFFFFFu;
+    }
+
+    sw->admin_base_ns    = admin_base_ns;
+    sw->admin_cycle_ns   = admin_cycle_ns;
+    sw->config_change_ns = start;
+    sw->last_cycles_lost = (uint32_t)lost;
+    sw->cycles_lost     += lost;
+    sw->last_error       = 0;
+    sw->staged           = 0;
+    sw->state            = AVB_TAS_SW_PENDING;
+    avb_tas_switch_poll(sw, done_ns);
+    return (uint32_t)lost;
+}
+
+void avb_tas_switch_fail(avb_tas_switch_t *sw, int32_t error, int hw_touched)
+{
+    sw->last_error = error;
+    if (hw_touched) {
+        sw->state  = AVB_TAS_SW_ERROR;
+        sw->staged = 0;
+    }
+}
@@ -0,0 +1,115 @@
+/*++
+
+Module Name:
+
+    tas_switch.h
+
+Abstract:
+
+    Admin/operational state of an 802.1Qbv schedule (802.1Q 8.6.9.1).
+
+    SETUP_TAS hands the driver an *admin* schedule.  The I225/I226 only
+    shadows the cycle time (QBVCYCLET_S), not the window table, so a running
+    gate list cannot be rewritten in place without one cycle mixing old
+    windows with the new cycle.  The switch is therefore not seamless, but
+    the gap is kept to the programming lead:
+
+      1. SETUP_TAS only stages the admin list (avb_tas_switch_stage): the
+         config-change time (CCT) is the admin base time rolled forward by
+         whole admin cycles to no earlier than the next operational boundary
+         plus the programming lead, so the new list keeps the phase the
+         network schedule was computed for.  The running list is left alone;
+      2. a timer set for the stop time - the last operational boundary no
+         later than "CCT - lead" (avb_tas_switch_stop_time) - takes the
+         running list down and arms the admin list as a first start at the
+         CCT;
+      3. from the stop to the CCT the port transmits without a gate list.
+
+    Every operational cycle that did not complete before the stop and would
+    have started before the new list does counts as lost - the lead's worth
+    when the stop is on time; a late timer cuts the cycle in flight.  After
+    the registers are armed the driver re-reads the PHC and commits; if
+    programming finished after the CCT the hardware starts at the next admin
+    cycle boundary instead and the gap grows accordingly (a late first start
+    only starts later).  Re-staging replaces the staged list; re-arming a
+    PENDING switch that already stopped a running list extends the same gap.
+    An armed PENDING switch becomes ACTIVE once the PHC passes the CCT
+    (avb_tas_switch_poll).
+
+    Pure C99 (stdint only).  Callers own locking.
+
+    Implements: REQ-F-TAS-003 (Atomic TAS schedule switch)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Same values as AVB_TAS_STATE_* in avb_ioctl.h */
+#define AVB_TAS_SW_IDLE       0u   /* no schedule programmed */
+#define AVB_TAS_SW_PENDING    1u   /* admin list staged (operational list runs until stop_ns) or
+                                      armed (starts at config_change_ns, no list runs until then) */
+#define AVB_TAS_SW_ACTIVE     2u   /* operational list running, nothing staged */
+#define AVB_TAS_SW_ERROR      3u   /* programming failed part-way; gate state unknown */
+
+typedef struct _avb_tas_switch {
+    uint64_t oper_base_ns;      /* operational (while armed PENDING: last stopped) schedule */
+    uint64_t admin_base_ns;     /* admin base time as requested */
+    uint64_t config_change_ns;  /* CCT of the pending or last switch */
+    uint64_t config_changes;    /* completed switches (first start included) */
+    uint64_t cycles_lost;       /* sum of last_cycles_lost over all switches */
+    uint64_t stop_ns;           /* staged: when the running list is taken down */
+    uint32_t oper_cycle_ns;
+    uint32_t admin_cycle_ns;
+    uint32_t last_cycles_lost;
+    uint32_t state;             /* AVB_TAS_SW_* */
+    int32_t  last_error;        /* status of the last failed request, 0 = none */
+    uint32_t staged;            /* PENDING, admin list not yet in hardware */
+} avb_tas_switch_t;
+
+void avb_tas_switch_init(avb_tas_switch_t *sw);
+
+/** Nonzero while the operational gate list is running in hardware (ACTIVE or staged) */
+int avb_tas_switch_running(const avb_tas_switch_t *sw);
+
+/** First operational cycle boundary at or after now_ns; now_ns if no list runs */
+uint64_t avb_tas_switch_next_boundary(const avb_tas_switch_t *sw, uint64_t now_ns);
+
+/** Last operational cycle boundary at or before cct_ns - lead_ns (the stop time) */
+uint64_t avb_tas_switch_stop_time(const avb_tas_switch_t *sw, uint64_t cct_ns, uint64_t lead_ns);
+
+/** Promote an armed PENDING switch whose CCT is at or before now_ns */
+void avb_tas_switch_poll(avb_tas_switch_t *sw, uint64_t now_ns);
+
+/**
+ * Stage an admin schedule while the operational list runs: PENDING, nothing
+ * lost yet.  The caller takes the running list down at stop_ns and arms the
+ * list, then commits.  Replaces a switch staged earlier.
+ */
+void avb_tas_switch_stage(avb_tas_switch_t *sw, uint64_t admin_base_ns, uint32_t admin_cycle_ns,
+                          uint64_t cct_ns, uint64_t stop_ns);
+
+/**
+ * Record an admin schedule armed with base time cct_ns; stop_ns is when the
+ * running list was taken down (ignored if none ran), done_ns the PHC read
+ * after the last register write.  Ends a staged switch.  Returns the
+ * operational cycles lost by this switch (also added to cycles_lost).
+ */
+uint32_t avb_tas_switch_commit(avb_tas_switch_t *sw, uint64_t admin_base_ns, uint32_t admin_cycle_ns,
+                               uint64_t cct_ns, uint64_t stop_ns, uint64_t done_ns);
+
+/**
+ * Record a failed request.  hw_touched = registers were partly written, so the
+ * running schedule is no longer known and the state becomes ERROR (a staged
+ * switch is dropped); otherwise the state is unchanged.
+ */
+void avb_tas_switch_fail(avb_tas_switch_t *sw, int32_t error, int hw_touched);
+
+#ifdef __cplusplus
+}
+#endif
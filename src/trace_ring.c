@@ -0,0 +1,166 @@
+/*++
+
+Module Name:
+
+    trace_ring.c
+
+Abstract:
+
+    Per-processor binary trace rings - implementation.  See trace_ring.h.
+    The event and argument name table below is also what tools/avb_trace
+    prints, so a new event needs no change to the decoder.
+
+--*/
+
+#include "trace_ring.h"
+
+typedef struct {
+    uint32_t    id;
+    const char *name;
+    const char *args[4];        /* arg32, arg[0], arg[1], arg[2] */
+} trace_event_desc_t;
+
+static const trace_event_desc_t s_events[] = {
+    { AVB_TR_RX_CHAIN,    "rx_chain",    { NULL, "nbls", "frames", "bytes" } },
+    { AVB_TR_RX_PTP,      "rx_ptp",      { "len", "type_pcp_vlan", "ts_ns", "correction" } },
+    { AVB_TR_TX_CHAIN,    "tx_chain",    { "nbls_down", "nbls", "frames", "bytes" } },
+    { AVB_TR_TX_TS,       "tx_ts",       { "fifo_slot", "ts_ns", NULL, NULL } },
+    { AVB_TR_TS_POST,     "ts_post",     { "dropped", "event_type", "ts_ns", "posted" } },
+    { AVB_TR_POLL_DPC,    "poll_dpc",    { "tx_ts", "run_ticks", NULL, NULL } },
+    { AVB_TR_TARGET_TIME, "target_time", { "flags", "systim_ns", NULL, NULL } },
+    { AVB_TR_IOCTL,       "ioctl",       { "ntstatus", "code", "ticks", NULL } },
+};
+
+static const trace_event_desc_t *find_event(uint32_t id)
+{
+    uint32_t i;
+
+    for (i = 0; i < sizeof(s_events) / sizeof(s_events[0]); i++) {
+        if (s_events[i].id == id) {
+            return &s_events[i];
+        }
+    }
+    return NULL;
+}
+
+const char *avb_trace_event_name(uint32_t id)
+{
+    const trace_event_desc_t *d = find_event(id);
+
+    return d ? d->name : NULL;
+}
+
+const char *avb_trace_arg_name(uint32_t id, uint32_t n)
+{
+    const trace_event_desc_t *d = find_event(id);
+
+    return (d && n < 4u) ? d->args[n] : NULL;
+}
+
+uint32_t avb_trace_capacity(uint32_t requested)
+{
+    uint32_t c = AVB_TRACE_MIN_RECORDS;
+
+    if (requested == 0) {
+        return AVB_TRACE_DEFAULT_RECORDS;
+    }
+    while (c < requested && c < AVB_TRACE_MAX_RECORDS) {
+        c <<= 1;
+    }
+    return c;
+}
+
+size_t avb_trace_bytes(uint32_t cpus, uint32_t capacity)
+{
+    uint32_t rings = cpus < AVB_TRACE_MAX_RINGS ? cpus : AVB_TRACE_MAX_RINGS;
+
+    return (size_t)rings * (sizeof(avb_trace_ring_t) + (size_t)capacity * sizeof(avb_trace_rec_t)) +
+           AVB_TRACE_ALIGN;
+}
+
+void avb_trace_init(avb_trace_set_t *t, void *storage, uint32_t cpus, uint32_t capacity)
+{
+    t->categories = 0;
+    t->next_ring  = 0;
+    t->lost       = 0;
+    t->capacity   = capacity;
+    t->stride     = sizeof(avb_trace_ring_t) + (size_t)capacity * sizeof(avb_trace_rec_t);
+    if (storage == NULL || cpus == 0) {
+        t->rings      = NULL;
+        t->ring_count = 0;
+        return;
+    }
+    t->rings = (uint8_t *)(((uintptr_t)storage + (AVB_TRACE_ALIGN - 1u)) & ~(uintptr_t)(AVB_TRACE_ALIGN - 1u));
+    t->ring_count = cpus < AVB_TRACE_MAX_RINGS ? cpus : AVB_TRACE_MAX_RINGS;
+}
+
+/* One ring's completed records from tail on */
+static uint32_t drain_ring(avb_trace_set_t *t, avb_trace_ring_t *r, avb_trace_rec_t *out, uint32_t max)
+{
+    uint64_t head = (uint64_t)r->head;
+    uint64_t pos  = r->tail;
+    uint32_t n = 0;
+
+    AVB_TRACE_FENCE();
+    if (head - pos > t->capacity) {
+        /* Lapped: everything before the last capacity positions is gone */
+        t->lost += head - t->capacity - pos;
+        pos = head - t->capacity;
+    }
+    while (pos < head && n < max) {
+        avb_trace_rec_t *rec = &avb_trace_records(r)[pos & (t->capacity - 1u)];
+        uint64_t s1 = rec->seq, s2;
+
+        if (s1 < pos + 1u) {
+            break;                  /* claimed, not yet complete */
+        }
+        if (s1 == pos + 1u) {
+            AVB_TRACE_FENCE();
+            out[n].ticks  = rec->ticks;
+            out[n].id     = rec->id;
+            out[n].cpu    = rec->cpu;
+            out[n].arg32  = rec->arg32;
+            out[n].arg[0] = rec->arg[0];
+            out[n].arg[1] = rec->arg[1];
+            out[n].arg[2] = rec->arg[2];
+            AVB_TRACE_FENCE();
+            s2 = rec->seq;
+            if (s2 == s1) {
+                out[n].seq = s1;
+                n++;
+            } else {
+                t->lost++;          /* overwritten while copying */
+            }
+        } else {
+            t->lost++;              /* overwritten before this drain */
+        }
+        pos++;
+    }
+    r->tail = pos;
+    return n;
+}
+
+uint32_t avb_trace_drain(avb_trace_set_t *t, avb_trace_rec_t *out, uint32_t max)
+{
+    uint32_t n = 0, k, i;
+
+    for (k = 0; k < t->ring_count && n < max; k++) {
+        i = (t->next_ring + k) % t->ring_count;
+        n += drain_ring(t, avb_trace_ring(t, i), out + n, max - n);
+    }
+    if (t->ring_count != 0) {
+        t->next_ring = (t->next_ring + 1u) % t->ring_count;
+    }
+    return n;
+}
+
+void avb_trace_discard(avb_trace_set_t *t)
+{
+    uint32_t i;
+
+    for (i = 0; i < t->ring_count; i++) {
+        avb_trace_ring_t *r = avb_trace_ring(t, i);
+        r->tail = (uint64_t)r->head;
+    }
+    t->lost = 0;
+}
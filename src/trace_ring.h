@@ -0,0 +1,173 @@
+/*++
+
+Module Name:
+
+    trace_ring.h
+
+Abstract:
+
+    Per-processor binary trace rings for the datapath and poll paths (the
+    records behind IOCTL_AVB_TRACE).
+
+    A trace point writes one fixed 48-byte record - event id, processor,
+    clock ticks, one 32-bit and three 64-bit arguments - into the ring of
+    the processor it runs on.  Nothing is formatted in the driver; the
+    decoder (tools/avb_trace) turns records into text or Chrome-trace JSON.
+
+    Writers claim a position with an interlocked increment of the ring's
+    head, so a writer preempted by a DPC on the same processor, or one
+    that moved processors after choosing the ring, still gets its own
+    record.  A record's seq is zeroed before its fields are written and
+    set to position + 1 after them; the reader keeps a record only when
+    seq matches before and after copying it.  The rings overwrite: a
+    reader that falls a whole ring behind counts the overwritten records
+    as lost rather than stalling the datapath.
+
+    Trace points are switched per category (AVB_TRACE_CAT_*, the high byte
+    of the event id); a disabled point costs one load and a branch.
+
+    Pure C99 (stdint only); the caller supplies the processor index and
+    the clock.  Callers serialise avb_trace_drain.
+
+    Implements: REQ-NF-DIAG-TRACE-001 (Binary datapath trace)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Categories: bit n enables the events with id >> 8 == n */
+#define AVB_TRACE_CAT_RX            0x01u
+#define AVB_TRACE_CAT_TX            0x02u
+#define AVB_TRACE_CAT_EVENT         0x04u
+#define AVB_TRACE_CAT_POLL          0x08u
+#define AVB_TRACE_CAT_IOCTL         0x10u
+#define AVB_TRACE_CAT_ALL           0x1Fu
+
+#define AVB_TRACE_CAT_OF(id)        (1u << ((uint32_t)(id) >> 8))
+
+/* Events: arg32, arg[0], arg[1], arg[2] */
+#define AVB_TR_RX_CHAIN             0x0001u /* receive indication: -, NBLs, frames, bytes */
+#define AVB_TR_RX_PTP               0x0002u /* PTP event frame: length, msgType | pcp << 8 | vlan << 16, RX ts ns, correctionField */
+#define AVB_TR_TX_CHAIN             0x0101u /* send: NBLs handed down, NBLs, frames, bytes */
+#define AVB_TR_TX_TS                0x0102u /* TX timestamp FIFO entry: FIFO slot, ts ns, -, - */
+#define AVB_TR_TS_POST              0x0201u /* timestamp event posted: ring-full drops, event type, ts ns, subs posted */
+#define AVB_TR_POLL_DPC             0x0301u /* TX timestamp poll DPC done: TX timestamps, run ticks, -, - */
+#define AVB_TR_TARGET_TIME          0x0302u /* TT0/TT1 fired: flags, SYSTIM ns, -, - */
+#define AVB_TR_IOCTL                0x0401u /* IOCTL dispatched: NTSTATUS, code, duration ticks, - */
+
+#define AVB_TRACE_MIN_RECORDS       256u
+#define AVB_TRACE_MAX_RECORDS       65536u
+#define AVB_TRACE_DEFAULT_RECORDS   4096u   /* per ring: 192 KB */
+#define AVB_TRACE_MAX_RINGS         16u
+#define AVB_TRACE_ALIGN             64u
+
+#if defined(_MSC_VER)
+#define AVB_TRACE_CLAIM(p)          ((uint64_t)_InterlockedExchangeAdd64((volatile __int64 *)(p), 1))
+#if defined(_M_ARM64)
+#define AVB_TRACE_FENCE()           __dmb(_ARM64_BARRIER_ISH)
+#else
+#define AVB_TRACE_FENCE()           _ReadWriteBarrier()     /* x86 / x64 keep store and load order */
+#endif
+#else
+#define AVB_TRACE_CLAIM(p)          ((uint64_t)__atomic_fetch_add((p), 1, __ATOMIC_RELAXED))
+#define AVB_TRACE_FENCE()           __atomic_thread_fence(__ATOMIC_ACQ_REL)
+#endif
+
+typedef struct _avb_trace_rec {
+    volatile uint64_t seq;      /* ring position + 1 once complete; 0 while being written */
+    uint64_t ticks;
+    uint16_t id;                /* AVB_TR_* */
+    uint16_t cpu;
+    uint32_t arg32;
+    uint64_t arg[3];
+} avb_trace_rec_t;
+
+typedef struct _avb_trace_ring {
+    volatile int64_t head;      /* positions claimed (writers) */
+    uint64_t         tail;      /* first position not yet drained (reader) */
+    uint8_t          pad[AVB_TRACE_ALIGN - 16u];
+    /* records[capacity] follow */
+} avb_trace_ring_t;
+
+typedef struct _avb_trace_set {
+    uint8_t          *rings;        /* ring_count rings of stride bytes, AVB_TRACE_ALIGN aligned */
+    size_t            stride;
+    uint32_t          ring_count;   /* 0: no storage, nothing can be enabled */
+    uint32_t          capacity;     /* records per ring, power of two */
+    volatile uint32_t categories;   /* AVB_TRACE_CAT_* enabled */
+    uint32_t          next_ring;    /* drain starts here (fairness between rings) */
+    uint64_t          lost;         /* overwritten before they were drained */
+} avb_trace_set_t;
+
+static __inline avb_trace_ring_t *avb_trace_ring(const avb_trace_set_t *t, uint32_t i)
+{
+    return (avb_trace_ring_t *)(t->rings + (size_t)i * t->stride);
+}
+
+static __inline avb_trace_rec_t *avb_trace_records(avb_trace_ring_t *r)
+{
+    return (avb_trace_rec_t *)(r + 1);
+}
+
+/** Records per ring for a requested count: a power of two within the limits (0 = default) */
+uint32_t avb_trace_capacity(uint32_t requested);
+
+/** Bytes of storage for cpus processors with capacity records per ring (alignment slack included) */
+size_t avb_trace_bytes(uint32_t cpus, uint32_t capacity);
+
+/**
+ * storage: avb_trace_bytes(cpus, capacity) zeroed bytes, any alignment, owned
+ * by the caller; NULL leaves tracing unavailable.  All categories start off.
+ */
+void avb_trace_init(avb_trace_set_t *t, void *storage, uint32_t cpus, uint32_t capacity);
+
+/** Write one record; only call when the event's category is enabled (see AVB_TRACE in the driver) */
+static __inline void avb_trace_emit(avb_trace_set_t *t, uint32_t cpu, uint64_t ticks, uint32_t id,
+                                    uint32_t arg32, uint64_t a0, uint64_t a1, uint64_t a2)
+{
+    avb_trace_ring_t *r = avb_trace_ring(t, cpu % t->ring_count);
+    uint64_t pos = AVB_TRACE_CLAIM(&r->head);
+    avb_trace_rec_t *rec = &avb_trace_records(r)[pos & (t->capacity - 1u)];
+
+    rec->seq = 0;
+    AVB_TRACE_FENCE();
+    rec->ticks  = ticks;
+    rec->id     = (uint16_t)id;
+    rec->cpu    = (uint16_t)cpu;
+    rec->arg32  = arg32;
+    rec->arg[0] = a0;
+    rec->arg[1] = a1;
+    rec->arg[2] = a2;
+    AVB_TRACE_FENCE();
+    rec->seq = pos + 1u;
+}
+
+/**
+ * Copy up to max completed records, oldest first per ring, rings in turn.
+ * Records still being written end that ring's share until the next drain.
+ * Returns the number copied; overwritten records are added to t->lost.
+ */
+uint32_t avb_trace_drain(avb_trace_set_t *t, avb_trace_rec_t *out, uint32_t max);
+
+/** Forget everything not yet drained (e.g. when tracing is re-enabled) */
+void avb_trace_discard(avb_trace_set_t *t);
+
+/** Event name ("rx_chain", ...) or NULL for an unknown id */
+const char *avb_trace_event_name(uint32_t id);
+
+/** Name of argument n (0 = arg32, 1..3 = arg[0..2]) of event id; NULL when unused */
+const char *avb_trace_arg_name(uint32_t id, uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
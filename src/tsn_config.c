@@ -218,6 +218,24 @@ UINT16 AvbGetMaxGateControlEntries(_In_ UINT16 deviceId)
     }
 }
 
+NTSTATUS AvbGetTasCaps(_In_ UINT16 deviceId, _Out_ avb_tas_caps_t* caps)
+{
+    if (caps == NULL) {
+        return STATUS_INVALID_PARAMETER;
+    }
+
+    if (!AvbSupportsTas(deviceId)) {
+        return STATUS_NOT_SUPPORTED;
+    }
+
+    // I225/I226 are the only TAS controllers: one STQT/ENDQT window per queue
+    avb_tas_caps_i225(caps);
+    if (AvbGetMaxGateControlEntries(deviceId) < caps->max_entries) {
+        caps->max_entries = AvbGetMaxGateControlEntries(deviceId);
+    }
+    return STATUS_SUCCESS;
+}
+
 /**
  * @brief Validate TSN configuration
  */
@@ -226,31 +244,46 @@ NTSTATUS AvbValidateTsnConfig(
     _In_ const struct tsn_tas_config* tasConfig
 )
 {
-    if (tasConfig == NULL) {
-        return STATUS_INVALID_PARAMETER;
-    }
+    return AvbValidateTasSchedule(deviceId, tasConfig, NULL, NULL);
+}
 
-    if (!AvbSupportsTas(deviceId)) {
-        return STATUS_NOT_SUPPORTED;
-    }
+NTSTATUS AvbValidateTasSchedule(
+    _In_ UINT16 deviceId,
+    _In_ const struct tsn_tas_config* tasConfig,
+    _In_opt_ const avb_tas_traffic_t* traffic,
+    _Out_opt_ avb_tas_diag_t* diag
+)
+{
+    avb_tas_caps_t caps;
+    avb_tas_schedule_t sched;
+    avb_tas_diag_t local;
+    avb_tas_result_t rc;
+    UINT32 entries = 0;
 
-    // Validate cycle time (must be > 0)
-    if (tasConfig->cycle_time_ns == 0 && tasConfig->cycle_time_s == 0) {
+    if (tasConfig == NULL) {
         return STATUS_INVALID_PARAMETER;
     }
 
-    // Calculate total cycle time in nanoseconds
-    UINT64 totalCycleTime = (UINT64)tasConfig->cycle_time_s * 1000000000ULL + tasConfig->cycle_time_ns;
+    NTSTATUS status = AvbGetTasCaps(deviceId, &caps);
+    if (!NT_SUCCESS(status)) {
+        return status;
+    }
 
-    // Validate that gate durations don't exceed cycle time
-    UINT64 totalGateTime = 0;
-    for (UINT32 i = 0; i < 8; i++) {
-        if (tasConfig->gate_durations[i] > 0) {
-            totalGateTime += tasConfig->gate_durations[i];
-        }
+    // The gate list ends at the first zero duration (templates pad with zeros)
+    while (entries < 8 && tasConfig->gate_durations[entries] != 0) {
+        entries++;
     }
 
-    if (totalGateTime > totalCycleTime) {
+    UINT64 cycleNs = (UINT64)tasConfig->cycle_time_s * 1000000000ULL + tasConfig->cycle_time_ns;
+    rc = avb_tas_compile(&caps, traffic, tasConfig->gate_states, tasConfig->gate_durations,
+                         entries, cycleNs, &sched, diag ? diag : &local);
+    if (rc != AVB_TAS_OK) {
+        const avb_tas_diag_t *d = diag ? diag : &local;
+        DEBUGP(DL_WARN, "TAS schedule rejected: %s (entry %d, queue %d, %llu vs limit %llu)\n",
+               avb_tas_result_str(rc),
+               d->entry == AVB_TAS_NO_ENTRY ? -1 : (int)d->entry,
+               d->queue == AVB_TAS_NO_QUEUE ? -1 : (int)d->queue,
+               d->value, d->limit);
         return STATUS_INVALID_PARAMETER;
     }
 
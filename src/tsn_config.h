@@ -10,6 +10,7 @@
 #pragma once
 
 #include "precomp.h"
+#include "tas_gcl.h"   /* GCL compiler / validator (pure C, host-testable) */
 
 // Forward declarations for TSN structures (defined in avb_integration.h)
 struct tsn_tas_config;
@@ -52,6 +53,30 @@ NTSTATUS AvbValidateTsnConfig(
     _In_ const struct tsn_tas_config* tasConfig
 );
 
+/**
+ * @brief TAS capability descriptor of a controller (see tas_gcl.h)
+ *
+ * @return STATUS_NOT_SUPPORTED if the controller has no Time-Aware Shaper
+ */
+NTSTATUS AvbGetTasCaps(_In_ UINT16 deviceId, _Out_ avb_tas_caps_t* caps);
+
+/**
+ * @brief Compile and validate a TAS schedule against the controller
+ *
+ * The gate list ends at the first zero duration.  With traffic, queues
+ * carrying frames are also checked for starvation and guard band.
+ *
+ * @param traffic optional per-queue link rate / largest frame
+ * @param diag optional; receives the precise violation on failure
+ * @return STATUS_SUCCESS, STATUS_NOT_SUPPORTED, or STATUS_INVALID_PARAMETER
+ */
+NTSTATUS AvbValidateTasSchedule(
+    _In_ UINT16 deviceId,
+    _In_ const struct tsn_tas_config* tasConfig,
+    _In_opt_ const avb_tas_traffic_t* traffic,
+    _Out_opt_ avb_tas_diag_t* diag
+);
+
 /**
  * @brief Example configurations for different use cases
  */
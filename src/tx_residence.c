@@ -0,0 +1,66 @@
+/*++
+
+Module Name:
+
+    tx_residence.c
+
+Abstract:
+
+    Send -> send-complete residence sampling - implementation.  See
+    tx_residence.h.
+
+--*/
+
+#include "tx_residence.h"
+
+void avb_txres_init(avb_txres_filter_t *f)
+{
+    f->pcp_mask     = 0;
+    f->ethertype    = 0;
+    f->sample_every = 1;
+    f->seq          = 0;
+}
+
+void avb_txres_configure(avb_txres_filter_t *f, uint32_t pcp_mask, uint32_t ethertype, uint32_t sample_every)
+{
+    /* Mask last: the send path reads it first and then the rules it enables */
+    f->pcp_mask     = 0;
+    f->ethertype    = ethertype & 0xFFFFu;
+    f->sample_every = sample_every != 0u ? sample_every : 1u;
+    f->seq          = 0;
+    f->pcp_mask     = pcp_mask & ((1u << AVB_TXRES_CLASSES) - 1u);
+}
+
+uint32_t avb_txres_parse(const uint8_t *hdr, uint32_t len, uint32_t *pcp)
+{
+    uint32_t et;
+
+    if (len < 14u) {
+        return 0;
+    }
+    et = ((uint32_t)hdr[12] << 8) | hdr[13];
+    if ((et == AVB_TXRES_TPID_8021Q || et == AVB_TXRES_TPID_8021AD) && len >= AVB_TXRES_PARSE_LEN) {
+        *pcp = (uint32_t)hdr[14] >> 5;
+        et   = ((uint32_t)hdr[16] << 8) | hdr[17];
+    }
+    return et;
+}
+
+int avb_txres_select(avb_txres_filter_t *f, uint32_t pcp, uint32_t ethertype)
+{
+    uint32_t every, n;
+
+    if ((f->pcp_mask & (1u << (pcp & 7u))) == 0u) {
+        return 0;
+    }
+    if (f->ethertype != 0u && f->ethertype != ethertype) {
+        return 0;
+    }
+    every = f->sample_every;
+    if (every <= 1u) {
+        return 1;
+    }
+    n = f->seq + 1u;
+    f->seq = n;
+    return n % every == 0u;
+}
@@ -0,0 +1,69 @@
+/*++
+
+Module Name:
+
+    tx_residence.h
+
+Abstract:
+
+    Send -> send-complete residence sampling (IOCTL_AVB_TX_RESIDENCE): which
+    frames the send path stamps.
+
+    A frame matches when its 802.1Q priority is in pcp_mask and, with
+    ethertype nonzero, its EtherType (behind one VLAN tag, if the frame
+    carries one) is ethertype.  One matching frame in sample_every is
+    stamped.  The priority is the one the miniport queues the frame by: an
+    in-frame tag's PCP, else the NBL's 802.1Q OOB priority.  Each priority
+    has a lat_hist histogram of the time from the hand-off to the miniport
+    to the send-complete - shaper (CBS / Qbv) holding time, queueing behind
+    other frames, and the completion path.
+
+    The 1-in-N counter is a plain increment: processors racing on it lose
+    counts, which only shifts which frames are sampled.
+
+    Pure C99 (stdint only); tests/performance/test_tx_residence_bench.c
+    checks the matching and times one decision.
+
+    Implements: REQ-F-STATISTICS-005 (TX residence latency per priority)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_TXRES_CLASSES       8u      /* 802.1Q priorities */
+#define AVB_TXRES_PARSE_LEN     18u     /* Ethernet header and one VLAN tag */
+#define AVB_TXRES_TPID_8021Q    0x8100u
+#define AVB_TXRES_TPID_8021AD   0x88A8u
+
+typedef struct _avb_txres_filter {
+    volatile uint32_t pcp_mask;         /* bit p: sample priority p; 0 = sampling off */
+    volatile uint32_t ethertype;        /* 0 = any */
+    volatile uint32_t sample_every;     /* 1 of every N matching frames, nonzero */
+    volatile uint32_t seq;              /* matching frames seen (wraps) */
+} avb_txres_filter_t;
+
+/** Sampling off */
+void avb_txres_init(avb_txres_filter_t *f);
+
+/** New match rules; sample_every 0 means 1.  pcp_mask 0 turns sampling off. */
+void avb_txres_configure(avb_txres_filter_t *f, uint32_t pcp_mask, uint32_t ethertype, uint32_t sample_every);
+
+/**
+ * EtherType of the len header bytes at hdr, behind one 802.1Q / 802.1ad tag
+ * if there is one; that tag's PCP replaces *pcp.  0: shorter than a header.
+ */
+uint32_t avb_txres_parse(const uint8_t *hdr, uint32_t len, uint32_t *pcp);
+
+/** 1 when a frame of priority pcp (0..7) and EtherType ethertype is to be stamped */
+int avb_txres_select(avb_txres_filter_t *f, uint32_t pcp, uint32_t ethertype);
+
+#ifdef __cplusplus
+}
+#endif
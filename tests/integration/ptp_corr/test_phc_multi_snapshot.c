@@ -0,0 +1,192 @@
+/**
+ * @file test_phc_multi_snapshot.c
+ * @brief UT-CORR-010 — IOCTL_AVB_PHC_MULTI_SNAPSHOT (code 65)
+ *
+ * User-mode harness for the all-adapter PHC snapshot.  One IOCTL returns the
+ * SYSTIM of every attached adapter, each read bracketed by two QPC samples,
+ * all taken back to back in the kernel under g_AvbContextListLock.
+ *
+ * Assertions:
+ *   - DeviceIoControl returns TRUE and status == NDIS_STATUS_SUCCESS
+ *   - count >= 1, count <= AVB_PHC_SNAPSHOT_MAX_ADAPTERS, count <= total_adapters
+ *   - qpc_frequency in [1e6, 1e10]
+ *   - every valid entry: phc_time_ns != 0, qpc_before <= qpc_after
+ *   - every valid entry's bracket window < 100 µs (same budget as VV-CORR-003-A)
+ *   - brackets are monotonic across entries (reads really are back to back)
+ *   - two consecutive snapshots: every adapter's PHC advances
+ *
+ * Informational: pairwise PHC offsets relative to entry 0, corrected for
+ * the QPC midpoint difference between reads.
+ *
+ * Implements: REQ-F-IOCTL-PHC-005 (Multi-adapter PHC snapshot)
+ * Traces to:  #48 (REQ-F-IOCTL-PHC-004: Cross-Timestamp IOCTL)
+ */
+
+#include <windows.h>
+#include <winioctl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef NDIS_STATUS_SUCCESS
+#define NDIS_STATUS_SUCCESS  ((NDIS_STATUS)0x00000000L)
+#endif
+typedef ULONG NDIS_STATUS;
+
+#include "../../../include/avb_ioctl.h"
+
+#define DEVICE_PATH_W        L"\\\\.\\IntelAvbFilter"
+#define MAX_BRACKET_WINDOW_US 100.0
+
+static int s_total  = 0;
+static int s_passed = 0;
+static int s_failed = 0;
+
+static void tc_result(const char *name, bool passed)
+{
+    s_total++;
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static bool take_snapshot(HANDLE hDev, AVB_PHC_MULTI_SNAPSHOT_REQUEST *r)
+{
+    DWORD br = 0;
+    ZeroMemory(r, sizeof(*r));
+    BOOL ok = DeviceIoControl(hDev, IOCTL_AVB_PHC_MULTI_SNAPSHOT,
+                              r, sizeof(*r), r, sizeof(*r), &br, NULL);
+    if (!ok) {
+        printf("  DeviceIoControl FALSE (Win32 error %lu)\n", GetLastError());
+        return false;
+    }
+    return r->status == NDIS_STATUS_SUCCESS;
+}
+
+static double ticks_to_us(avb_u64 ticks, avb_u64 freq)
+{
+    return (double)ticks * 1e6 / (double)freq;
+}
+
+/* =========================================================================
+ * UT-CORR-010: snapshot structure and bracket windows
+ * =========================================================================*/
+static void test_snapshot_shape(HANDLE hDev)
+{
+    AVB_PHC_MULTI_SNAPSHOT_REQUEST r;
+    printf("\n[UT-CORR-010a] Snapshot shape and bracket windows\n");
+
+    if (!take_snapshot(hDev, &r)) {
+        printf("  status=0x%08X\n", r.status);
+        tc_result("UT-CORR-010a IOCTL succeeds", false);
+        return;
+    }
+    tc_result("UT-CORR-010a IOCTL succeeds", true);
+
+    tc_result("UT-CORR-010a count in [1, MAX] and <= total_adapters",
+              r.count >= 1 && r.count <= AVB_PHC_SNAPSHOT_MAX_ADAPTERS &&
+              r.count <= r.total_adapters);
+    tc_result("UT-CORR-010a qpc_frequency in [1e6, 1e10]",
+              r.qpc_frequency >= 1000000ULL && r.qpc_frequency <= 10000000000ULL);
+    if (r.qpc_frequency == 0) {
+        return;
+    }
+
+    bool entries_ok = true, windows_ok = true, ordered_ok = true;
+    avb_u64 prev_after = 0;
+    for (avb_u32 i = 0; i < r.count; i++) {
+        const AVB_PHC_SNAPSHOT_ENTRY *e = &r.entries[i];
+        if (!e->valid) {
+            printf("  [%u] VID=0x%04X DID=0x%04X  not PTP-ready (skipped)\n",
+                   i, e->vendor_id, e->device_id);
+            continue;
+        }
+        double win_us = ticks_to_us(e->qpc_after - e->qpc_before, r.qpc_frequency);
+        printf("  [%u] VID=0x%04X DID=0x%04X  phc=%llu ns  window=%.3f us\n",
+               i, e->vendor_id, e->device_id,
+               (unsigned long long)e->phc_time_ns, win_us);
+        if (e->phc_time_ns == 0 || e->qpc_after < e->qpc_before) entries_ok = false;
+        if (win_us >= MAX_BRACKET_WINDOW_US) windows_ok = false;
+        if (e->qpc_before < prev_after) ordered_ok = false;
+        prev_after = e->qpc_after;
+    }
+    tc_result("UT-CORR-010a valid entries have PHC != 0 and qpc_before <= qpc_after", entries_ok);
+    tc_result("UT-CORR-010a bracket windows < 100 us", windows_ok);
+    tc_result("UT-CORR-010a brackets are back to back (monotonic QPC)", ordered_ok);
+
+    /* Informational: offsets relative to the first valid entry */
+    const AVB_PHC_SNAPSHOT_ENTRY *ref = NULL;
+    for (avb_u32 i = 0; i < r.count; i++) {
+        const AVB_PHC_SNAPSHOT_ENTRY *e = &r.entries[i];
+        if (!e->valid) continue;
+        if (!ref) { ref = e; continue; }
+        double mid_ref = ((double)ref->qpc_before + (double)ref->qpc_after) / 2.0;
+        double mid_e   = ((double)e->qpc_before   + (double)e->qpc_after)   / 2.0;
+        double dt_ns   = (mid_e - mid_ref) * 1e9 / (double)r.qpc_frequency;
+        double off_ns  = (double)(int64_t)(e->phc_time_ns - ref->phc_time_ns) - dt_ns;
+        printf("  offset DID=0x%04X vs DID=0x%04X: %.0f ns\n",
+               e->device_id, ref->device_id, off_ns);
+    }
+}
+
+/* =========================================================================
+ * UT-CORR-010b: every adapter's PHC advances between two snapshots
+ * =========================================================================*/
+static void test_snapshot_advances(HANDLE hDev)
+{
+    AVB_PHC_MULTI_SNAPSHOT_REQUEST a, b;
+    printf("\n[UT-CORR-010b] PHC advances between snapshots\n");
+
+    if (!take_snapshot(hDev, &a)) {
+        tc_result("UT-CORR-010b first snapshot", false);
+        return;
+    }
+    Sleep(10);
+    if (!take_snapshot(hDev, &b)) {
+        tc_result("UT-CORR-010b second snapshot", false);
+        return;
+    }
+
+    bool advanced = true;
+    for (avb_u32 i = 0; i < a.count && i < b.count; i++) {
+        if (!a.entries[i].valid || !b.entries[i].valid) continue;
+        if (a.entries[i].device_id != b.entries[i].device_id) continue;  /* list changed */
+        if (b.entries[i].phc_time_ns <= a.entries[i].phc_time_ns) {
+            printf("  DID=0x%04X did not advance (%llu -> %llu)\n",
+                   a.entries[i].device_id,
+                   (unsigned long long)a.entries[i].phc_time_ns,
+                   (unsigned long long)b.entries[i].phc_time_ns);
+            advanced = false;
+        }
+    }
+    tc_result("UT-CORR-010b all valid PHCs advance", advanced);
+}
+
+int main(void)
+{
+    printf("========================================================================\n");
+    printf("TEST-PHC-MULTI-SNAPSHOT: All-adapter PHC snapshot (IOCTL code 65)\n");
+    printf("Tests: UT-CORR-010a, UT-CORR-010b\n");
+    printf("Implements: REQ-F-IOCTL-PHC-005 | Traces to: #48\n");
+    printf("========================================================================\n");
+
+    HANDLE hDev = CreateFileW(DEVICE_PATH_W, GENERIC_READ | GENERIC_WRITE,
+                              0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hDev == INVALID_HANDLE_VALUE) {
+        printf("ERROR: Cannot open device %S (Win32 error %lu)\n",
+               DEVICE_PATH_W, GetLastError());
+        printf("  Is the IntelAvbFilter driver installed and running?\n");
+        return 1;
+    }
+
+    test_snapshot_shape(hDev);
+    test_snapshot_advances(hDev);
+
+    CloseHandle(hDev);
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_total);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    return s_failed ? 1 : 0;
+}
@@ -0,0 +1,347 @@
+/*
+ * TEST-PERF-LAT-HIST-001: latency histogram accuracy and per-sample cost
+ *
+ * Verifies: REQ-F-STATISTICS-002 (Driver latency histograms)
+ *
+ * Purpose:
+ *   The driver records a sample on every PTP event frame, every TX
+ *   timestamp, every poll DPC, every BAR0 read and every IOCTL, and the
+ *   histograms stay on in production builds.  Check the log-linear buckets
+ *   of src/lat_hist.c (contiguous, at most 1/32 relative width, percentiles
+ *   within one bucket of the exact order statistic), check that samples
+ *   recorded from many threads into per-CPU slots add up exactly, and time
+ *   one sample - the tick-to-ns scaling, the bucket index and the
+ *   interlocked increment the driver's AvbLatRecord does.  Runs on the
+ *   host - no driver needed.
+ *
+ * Test Cases:
+ *   TC-PERF-LAT-001: bucket bounds contiguous, index(low) = index(high - 1), width <= 1/32
+ *   TC-PERF-LAT-002: p50 / p90 / p99 / p99.9 within one bucket of the sorted samples
+ *   TC-PERF-LAT-003: exact totals from 1..16 threads into per-CPU slots
+ *   TC-PERF-LAT-004: one sample in less than BUDGET_NS (clock read reported separately)
+ *
+ * Build:
+ *   cl /nologo /O2 -I src tests\performance\test_lat_hist_bench.c src\lat_hist.c
+ *   cc -O2 -pthread -I src -o test_lat_hist_bench tests/performance/test_lat_hist_bench.c src/lat_hist.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "lat_hist.h"
+
+/* -------------------------------------------------------------------------
+ * Test Configuration
+ * ------------------------------------------------------------------------- */
+#define SAMPLES         200000u
+#define MAX_THREADS     16u
+#define PER_THREAD      200000u
+#define REPEATS         5u              /* best-of-N */
+#define BUDGET_NS       15.0            /* TC-004: scale + index + interlocked increment */
+
+static int s_passed = 0;
+static int s_failed = 0;
+static volatile uint64_t s_sink;        /* keeps the timed loops */
+
+static void tc_result(const char *name, int passed)
+{
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static double now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+/* The driver's AVB_LAT_TICKS(): the TSC where there is one */
+static uint64_t ticks(void)
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t)now_ns();
+#endif
+}
+
+/* Tick rate against the monotonic clock (the driver calibrates against QPC) */
+static uint64_t tick_hz(void)
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    double t0 = now_ns();
+    uint64_t c0 = ticks(), c1;
+    while (now_ns() - t0 < 20e6) {
+        /* 20 ms */
+    }
+    c1 = ticks();
+    return (uint64_t)((double)(c1 - c0) * 1e9 / (now_ns() - t0));
+#else
+    return 1000000000ull;
+#endif
+}
+
+/* The driver's InterlockedIncrement64 */
+static void atomic_inc(volatile int64_t *p)
+{
+#ifdef _WIN32
+    InterlockedIncrement64((volatile LONG64 *)p);
+#else
+    __atomic_fetch_add(p, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static uint32_t xorshift(uint32_t *x)
+{
+    *x ^= *x << 13; *x ^= *x >> 17; *x ^= *x << 5;
+    return *x;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-001 / TC-002: bucket arithmetic
+ * ------------------------------------------------------------------------- */
+static int check_buckets(void)
+{
+    uint32_t i;
+    int ok = 1;
+
+    ok &= avb_lat_bucket_low(0) == 0 && avb_lat_index(0) == 0;
+    for (i = 0; i < AVB_LAT_BUCKETS; i++) {
+        uint64_t lo = avb_lat_bucket_low(i), hi = avb_lat_bucket_high(i);
+        ok &= hi > lo;
+        ok &= avb_lat_index(lo) == i && avb_lat_index(hi - 1u) == i;
+        if (i + 1u < AVB_LAT_BUCKETS) {
+            ok &= avb_lat_bucket_low(i + 1u) == hi;
+        }
+        if (i >= AVB_LAT_EXACT) {
+            ok &= (hi - lo) * AVB_LAT_SUB_COUNT <= lo;
+        }
+    }
+    ok &= avb_lat_index(UINT64_MAX) == AVB_LAT_BUCKETS - 1u;
+    ok &= avb_lat_bucket_high(AVB_LAT_BUCKETS - 1u) == 1ull << AVB_LAT_MAX_BITS;
+    return ok;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Percentile reported from the buckets vs. the exact order statistic */
+static int check_percentiles(void)
+{
+    static uint64_t v[SAMPLES];
+    static uint64_t counts[AVB_LAT_BUCKETS];
+    static const uint32_t pm[4] = { 500u, 900u, 990u, 999u };
+    avb_lat_summary_t sum;
+    uint32_t x = 0x2545F491u, i, k;
+    int ok = 1;
+
+    memset(counts, 0, sizeof(counts));
+    for (i = 0; i < SAMPLES; i++) {
+        /* Long-tailed: 300 ns .. ~300 us, mostly short (DPC / MMIO shape) */
+        uint32_t r = xorshift(&x);
+        v[i] = 300u + ((uint64_t)(r & 0xFFFu) << ((r >> 12) % 8u)) / 8u;
+        counts[avb_lat_index(v[i])]++;
+    }
+    qsort(v, SAMPLES, sizeof(v[0]), cmp_u64);
+    avb_lat_summarize(counts, &sum);
+
+    printf("  percentiles of %u long-tailed samples (exact / reported):\n", SAMPLES);
+    for (k = 0; k < 4; k++) {
+        uint64_t exact = v[(SAMPLES * (uint64_t)pm[k] + 999u) / 1000u - 1u];
+        uint64_t rep   = avb_lat_percentile(counts, pm[k]);
+        printf("    p%-5.1f  %8llu ns  %8llu ns\n", pm[k] / 10.0,
+               (unsigned long long)exact, (unsigned long long)rep);
+        /* The high end of the bucket holding the exact value */
+        ok &= rep == avb_lat_bucket_high(avb_lat_index(exact));
+    }
+    ok &= sum.count == SAMPLES;
+    ok &= sum.min_ns == avb_lat_bucket_low(avb_lat_index(v[0]));
+    ok &= sum.max_ns == avb_lat_bucket_high(avb_lat_index(v[SAMPLES - 1u]));
+    ok &= sum.p50_ns == avb_lat_percentile(counts, 500u);
+    printf("    mean %llu ns, min %llu ns, max %llu ns\n\n", (unsigned long long)sum.mean_ns,
+           (unsigned long long)sum.min_ns, (unsigned long long)sum.max_ns);
+    return ok;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-003: per-CPU slots from many threads
+ * ------------------------------------------------------------------------- */
+typedef struct {
+    avb_lat_set_t *set;
+    uint32_t       cpu;
+    volatile int  *go;
+} worker_t;
+
+#ifdef _WIN32
+static DWORD WINAPI worker(LPVOID arg)
+#else
+static void *worker(void *arg)
+#endif
+{
+    worker_t *w = (worker_t *)arg;
+    avb_lat_hist_t *h;
+    uint32_t x = 0x9E3779B9u ^ w->cpu, i;
+
+    while (!*w->go) {
+        /* spin until every thread exists */
+    }
+    h = avb_lat_slot(w->set, w->cpu, AVB_LAT_MMIO_READ);
+    for (i = 0; i < PER_THREAD; i++) {
+        atomic_inc(&h->b[avb_lat_index(xorshift(&x) & 0xFFFFFu)]);
+    }
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+static int check_threads(void)
+{
+    static const uint32_t steps[] = { 1u, 2u, 4u, 8u, 16u };
+    static uint64_t counts[AVB_LAT_BUCKETS];
+    static worker_t w[MAX_THREADS];
+#ifdef _WIN32
+    HANDLE th[MAX_THREADS];
+#else
+    pthread_t th[MAX_THREADS];
+#endif
+    uint32_t k, i;
+    int ok = 1;
+
+    for (k = 0; k < sizeof(steps) / sizeof(steps[0]); k++) {
+        uint32_t n = steps[k];
+        void *storage = calloc(1, avb_lat_set_bytes(n));
+        avb_lat_set_t set;
+        volatile int go = 0;
+        uint64_t total = 0;
+
+        if (storage == NULL) return 0;
+        avb_lat_set_init(&set, storage, n, 1000000000ull);
+        for (i = 0; i < n; i++) {
+            w[i].set = &set;
+            w[i].cpu = i;
+            w[i].go  = &go;
+#ifdef _WIN32
+            th[i] = CreateThread(NULL, 0, worker, &w[i], 0, NULL);
+#else
+            pthread_create(&th[i], NULL, worker, &w[i]);
+#endif
+        }
+        go = 1;
+        for (i = 0; i < n; i++) {
+#ifdef _WIN32
+            WaitForSingleObject(th[i], INFINITE);
+            CloseHandle(th[i]);
+#else
+            pthread_join(th[i], NULL);
+#endif
+        }
+        avb_lat_sum(&set, AVB_LAT_MMIO_READ, counts);
+        for (i = 0; i < AVB_LAT_BUCKETS; i++) {
+            total += counts[i];
+        }
+        ok &= total == (uint64_t)n * PER_THREAD;
+        avb_lat_sum(&set, AVB_LAT_DPC, counts);
+        for (i = 0; i < AVB_LAT_BUCKETS; i++) {
+            ok &= counts[i] == 0;                   /* other histograms untouched */
+        }
+        free(storage);
+    }
+    return ok;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-004: cost of one sample
+ * ------------------------------------------------------------------------- */
+static double time_record(avb_lat_set_t *set)
+{
+    avb_lat_hist_t *h = avb_lat_slot(set, 0, AVB_LAT_RX_CLASSIFY);
+    uint32_t x = 0x6C8E9CF5u, i;
+    double t0 = now_ns();
+
+    for (i = 0; i < SAMPLES; i++) {
+        /* Spans of 0..~1 ms in TSC ticks */
+        atomic_inc(&h->b[avb_lat_index(avb_lat_ns(set, xorshift(&x) >> 10))]);
+    }
+    s_sink += (uint64_t)h->b[0];
+    return (now_ns() - t0) / SAMPLES;
+}
+
+static double time_clock(void)
+{
+    uint64_t acc = 0;
+    uint32_t i;
+    double t0 = now_ns();
+
+    for (i = 0; i < SAMPLES; i++) {
+        acc += ticks();
+    }
+    s_sink += acc;
+    return (now_ns() - t0) / SAMPLES;
+}
+
+int main(void)
+{
+    avb_lat_set_t set;
+    void *storage;
+    uint64_t hz;
+    double rec = 1e300, clk = 1e300;
+    uint32_t rep;
+
+    printf("========================================================================\n");
+    printf("TEST-PERF-LAT-HIST-001: latency histogram accuracy and sample cost\n");
+    printf("Verifies: REQ-F-STATISTICS-002\n");
+    printf("========================================================================\n");
+
+    hz = tick_hz();
+    printf("\n  %u buckets, %u per octave, 1 ns .. %llu s; clock %.3f GHz\n\n",
+           AVB_LAT_BUCKETS, AVB_LAT_SUB_COUNT, (1ull << AVB_LAT_MAX_BITS) / 1000000000ull, hz / 1e9);
+
+    tc_result("TC-PERF-LAT-001 bucket bounds contiguous, width <= 1/32", check_buckets());
+    tc_result("TC-PERF-LAT-002 percentiles within one bucket", check_percentiles());
+    tc_result("TC-PERF-LAT-003 exact totals from per-CPU slots", check_threads());
+
+    storage = calloc(1, avb_lat_set_bytes(1));
+    if (storage == NULL) return 1;
+    avb_lat_set_init(&set, storage, 1, hz);
+    for (rep = 0; rep < REPEATS; rep++) {
+        double r = time_record(&set), c = time_clock();
+        if (r < rec) rec = r;
+        if (c < clk) clk = c;
+    }
+    free(storage);
+    printf("\n  record (scale + index + increment): %.2f ns/sample\n", rec);
+    printf("  clock read:                         %.2f ns (taken twice per sample)\n\n", clk);
+    tc_result("TC-PERF-LAT-004 sample cost within budget", rec < BUDGET_NS);
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_passed + s_failed);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    return s_failed ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * TEST-PERF-LAUNCH-PACER-001: software pacer release error vs. timer resolution
+ *
+ * Verifies: REQ-F-LAUNCH-003 (Software launch-time pacing)
+ *
+ * Purpose:
+ *   The miniports take no launch time, so the filter releases frames from a
+ *   timer, so the release error is set by the timer's granularity and the
+ *   DPC latency.  Drive the pacer with a Class A style stream (one frame
+ *   every 125 us, launch 2 ms ahead) on a simulated clock whose timer fires
+ *   on the next tick boundary plus a random latency, for three timer
+ *   profiles, with and without early release of half a tick.  Prints
+ *   p50 / p99 / max |release error| and checks the bound
+ *   max |error| <= tick - early + latency.  Runs on the host - no driver
+ *   needed.
+ *
+ * Test Cases:
+ *   TC-PERF-PACER-001: 15.625 ms system tick (ExSetTimer without high resolution)
+ *   TC-PERF-PACER-002: 1 ms tick (timeBeginPeriod(1))
+ *   TC-PERF-PACER-003: 0.5 ms high-resolution timer
+ *   (each with early_ns = 0 and early_ns = tick / 2)
+ *
+ * Build:
+ *   cl /nologo /O2 -I src tests\performance\test_lt_pacer_sim.c src\lt_pacer.c
+ *   cc -O2 -I src -o test_lt_pacer_sim tests/performance/test_lt_pacer_sim.c src/lt_pacer.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lt_pacer.h"
+
+/* -------------------------------------------------------------------------
+ * Test Configuration
+ * ------------------------------------------------------------------------- */
+#define FRAMES          20000u
+#define PERIOD_NS       125000ull       /* Class A observation interval */
+#define LEAD_NS         2000000ull      /* launch time ahead of the send call */
+#define LATENCY_NS      100000u         /* DPC latency 0..100 us */
+#define QUEUE           1024u
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+static void tc_result(const char *name, int passed)
+{
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static avb_pacer_entry_t s_heap[QUEUE];
+static uint64_t s_launch[FRAMES];
+static uint64_t s_abs_err[FRAMES];
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Expiry of a timer armed for 'due': the next tick boundary at or after it, plus latency */
+static uint64_t expiry(uint64_t due, uint64_t tick, uint32_t *x)
+{
+    *x ^= *x << 13; *x ^= *x >> 17; *x ^= *x << 5;
+    return (due + tick - 1u) / tick * tick + *x % LATENCY_NS;
+}
+
+/* Returns max |error| in ns; prints the distribution */
+static uint64_t run(uint64_t tick, uint32_t early, int *complete)
+{
+    avb_pacer_t p;
+    uint64_t now = 0, next_send = 0, fire = AVB_PACER_NONE, max;
+    uint32_t x = 0x2545F491u, sent = 0, done = 0;
+    void *f;
+
+    avb_pacer_init(&p, s_heap, QUEUE, 1000000000ull, early);
+
+    while (done < FRAMES) {
+        /* Advance to whichever comes first: the next send call or the timer */
+        if (sent < FRAMES && next_send <= fire) {
+            now = next_send;
+            s_launch[sent] = now + LEAD_NS;
+            if (avb_pacer_enqueue(&p, now, s_launch[sent], &s_launch[sent], 0) != AVB_PACER_QUEUED) {
+                break;
+            }
+            sent++;
+            next_send += PERIOD_NS;
+        } else if (fire != AVB_PACER_NONE) {
+            now = fire;
+            while ((f = avb_pacer_pop_due(&p, now)) != NULL) {
+                uint64_t l = *(uint64_t *)f;
+                s_abs_err[done++] = (now > l) ? now - l : l - now;
+            }
+        } else {
+            break;
+        }
+        /* Re-arm for the head, as the driver does after every enqueue and expiry */
+        fire = (p.count != 0) ? expiry(avb_pacer_wakeup(&p), tick, &x) : AVB_PACER_NONE;
+    }
+
+    *complete = (done == FRAMES && p.st.dropped_full == 0);
+    qsort(s_abs_err, done, sizeof(s_abs_err[0]), cmp_u64);
+    max = done ? s_abs_err[done - 1u] : 0;
+    printf("    tick %8.3f ms  early %7.1f us:  p50 %9.1f us  p99 %9.1f us  max %9.1f us  mean %9.1f us\n",
+           (double)tick / 1e6, early / 1e3,
+           done ? (double)s_abs_err[done / 2u] / 1e3 : 0.0,
+           done ? (double)s_abs_err[(uint64_t)done * 99u / 100u] / 1e3 : 0.0,
+           (double)max / 1e3, (double)avb_pacer_mean_abs_error(&p) / 1e3);
+    return max;
+}
+
+static void profile(const char *name, uint64_t tick)
+{
+    int c0, c1;
+    uint64_t m0 = run(tick, 0, &c0);
+    uint64_t m1 = run(tick, (uint32_t)(tick / 2u), &c1);
+
+    tc_result(name, c0 && c1 &&
+                    m0 <= tick + LATENCY_NS &&
+                    m1 <= tick / 2u + LATENCY_NS);
+}
+
+int main(void)
+{
+    printf("========================================================================\n");
+    printf("TEST-PERF-LAUNCH-PACER-001: software pacer release error (simulated clock)\n");
+    printf("Verifies: REQ-F-LAUNCH-003\n");
+    printf("========================================================================\n\n");
+
+    profile("TC-PERF-PACER-001 15.625 ms tick within tick + latency", 15625000ull);
+    profile("TC-PERF-PACER-002 1 ms tick within tick + latency", 1000000ull);
+    profile("TC-PERF-PACER-003 0.5 ms high-resolution timer within tick + latency", 500000ull);
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_passed + s_failed);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    return s_failed ? 1 : 0;
+}
@@ -0,0 +1,356 @@
+/*
+ * TEST-PERF-MMIO-ACCT-001: MMIO accounting classification, totals and cost
+ *
+ * Verifies: REQ-NF-DIAG-MMIO-001 (MMIO access accounting)
+ *
+ * Purpose:
+ *   AVB_MMIO_ACCT=1 builds charge every BAR0 read and write to a register
+ *   block and a calling subsystem.  Check the block table of
+ *   src/mmio_acct.h against the registers the driver actually touches
+ *   (every statistics register of devices/intel_hw_stats.h must land in
+ *   STATS), check that caller scopes nest and restore, that accesses from
+ *   many threads into per-CPU slots add up exactly - also with processors
+ *   sharing a slot - and time one record: the block lookup, the slot and
+ *   the two interlocked adds AvbMmioReadReal does on top of a register
+ *   read that costs hundreds of ns.  Runs on the host - no driver needed.
+ *
+ * Test Cases:
+ *   TC-PERF-MMIO-001: PTP / TSN / STATS / MAC blocks of known registers; sampler registers all STATS
+ *   TC-PERF-MMIO-002: nested caller scopes restore; exact totals from 1..16 threads, shared slots included
+ *   TC-PERF-MMIO-003: one record in less than BUDGET_NS beyond its two clock reads
+ *
+ * Build:
+ *   cl /nologo /O2 -I . -I src tests\performance\test_mmio_acct_bench.c src\mmio_acct.c
+ *   cc -O2 -pthread -I . -I src -o test_mmio_acct_bench tests/performance/test_mmio_acct_bench.c src/mmio_acct.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "mmio_acct.h"
+#include "devices/intel_hw_stats.h"
+
+/* -------------------------------------------------------------------------
+ * Test Configuration
+ * ------------------------------------------------------------------------- */
+#define RECORDS         1000000u
+#define MAX_THREADS     16u
+#define SLOTS           4u              /* TC-002: threads beyond SLOTS share slots */
+#define PER_THREAD      200000u
+#define REPEATS         5u              /* best-of-N */
+#define BUDGET_NS       60.0            /* TC-003: lookup + two interlocked adds, clock reads excluded */
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+static void tc_result(const char *name, int passed)
+{
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static double now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+/* The driver's AVB_LAT_TICKS() */
+static uint64_t ticks(void)
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t)now_ns();
+#endif
+}
+
+/* The driver's InterlockedAdd64 */
+static void atomic_add(volatile int64_t *p, int64_t n)
+{
+#ifdef _WIN32
+    InterlockedAdd64((volatile LONG64 *)p, n);
+#else
+    __atomic_fetch_add(p, n, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/* The driver's AVB_MMIO_ACCT_RECORD at DISPATCH_LEVEL (passive selects the IRQL branch) */
+static void record(avb_mmio_acct_t *a, uint32_t cpu, int passive, uint32_t offset, uint32_t dir, uint64_t t0)
+{
+    avb_mmio_acct_slot_t *s = avb_mmio_acct_slot(a, cpu);
+
+    if (s != NULL) {
+        uint32_t c = passive ? AVB_MMIO_CALLER_PASSIVE : s->caller;
+        uint32_t b = avb_mmio_block(offset);
+        atomic_add(&s->count[dir][c][b], 1);
+        atomic_add(&s->ticks[dir][c][b], (int64_t)(ticks() - t0));
+    }
+}
+
+static void *new_acct(avb_mmio_acct_t *a, uint32_t cpus)
+{
+    void *storage = calloc(1, avb_mmio_acct_bytes(cpus));
+
+    avb_mmio_acct_init(a, storage, cpus);
+    return storage;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-001: register blocks
+ * ------------------------------------------------------------------------- */
+static int check_blocks(void)
+{
+    static const struct { uint32_t off; uint32_t blk; } known[] = {
+        { 0x00000u, AVB_MMIO_BLK_MAC },     /* CTRL */
+        { 0x00008u, AVB_MMIO_BLK_MAC },     /* STATUS */
+        { 0x00020u, AVB_MMIO_BLK_MAC },     /* MDIC */
+        { 0x0C000u, AVB_MMIO_BLK_MAC },     /* RDBAL(0) */
+        { 0x0C028u, AVB_MMIO_BLK_MAC },     /* RXDCTL(0) */
+        { 0x0E018u, AVB_MMIO_BLK_MAC },     /* TDT(0) */
+        { 0x0B600u, AVB_MMIO_BLK_PTP },     /* SYSTIML */
+        { 0x0B608u, AVB_MMIO_BLK_PTP },     /* TIMINCA */
+        { 0x0B618u, AVB_MMIO_BLK_PTP },     /* TXSTMPL */
+        { 0x0B640u, AVB_MMIO_BLK_PTP },     /* TSAUXC */
+        { 0x0B66Cu, AVB_MMIO_BLK_PTP },     /* TSICR */
+        { 0x0C0C8u, AVB_MMIO_BLK_PTP },     /* I226 SYSTIML read */
+        { 0x0C0CCu, AVB_MMIO_BLK_PTP },     /* I226 SYSTIMH read */
+        { 0x03004u, AVB_MMIO_BLK_TSN },     /* TQAVCC(0) */
+        { 0x03324u, AVB_MMIO_BLK_TSN },     /* STQT(0) */
+        { 0x03344u, AVB_MMIO_BLK_TSN },     /* TXQCTL(0) */
+        { 0x03570u, AVB_MMIO_BLK_TSN },     /* TQAVCTRL */
+        { 0x04000u, AVB_MMIO_BLK_STATS },   /* CRCERRS */
+        { 0x04280u, AVB_MMIO_BLK_STATS },   /* PRMPTDTCNT */
+        { 0x0C030u, AVB_MMIO_BLK_STATS },   /* RQDPC(0) */
+    };
+    uint32_t i, lo, hi;
+    int ok = 1;
+
+    for (i = 0; i < sizeof(known) / sizeof(known[0]); i++) {
+        if (avb_mmio_block(known[i].off) != known[i].blk) {
+            printf("  0x%05X: block %u, expected %u\n", known[i].off, avb_mmio_block(known[i].off), known[i].blk);
+            ok = 0;
+        }
+    }
+    for (i = 0; i < INTEL_HW_STAT_COUNT; i++) {
+        lo = intel_hw_stats_reg(i, &hi);
+        if (avb_mmio_block(lo) != AVB_MMIO_BLK_STATS || (hi != 0 && avb_mmio_block(hi) != AVB_MMIO_BLK_STATS)) {
+            printf("  statistics counter %u at 0x%05X not in STATS\n", i, lo);
+            ok = 0;
+        }
+    }
+    return ok;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-002: scopes and totals
+ * ------------------------------------------------------------------------- */
+static int check_scopes(void)
+{
+    avb_mmio_acct_t a;
+    avb_mmio_acct_totals_t t;
+    void *storage = new_acct(&a, 2);
+    uint32_t outer, inner;
+    int ok = 1;
+
+    if (storage == NULL) return 0;
+    record(&a, 0, 0, 0x0B600u, AVB_MMIO_RD, ticks());                     /* untagged */
+    outer = avb_mmio_acct_enter(&a, 0, AVB_MMIO_CALLER_TX_POLL);
+    record(&a, 0, 0, 0x0B618u, AVB_MMIO_RD, ticks());
+    inner = avb_mmio_acct_enter(&a, 0, AVB_MMIO_CALLER_TARGET_TIME);
+    record(&a, 0, 0, 0x0B66Cu, AVB_MMIO_RD, ticks());
+    record(&a, 0, 0, 0x0B66Cu, AVB_MMIO_WR, ticks());
+    record(&a, 0, 1, 0x0B66Cu, AVB_MMIO_RD, ticks());                     /* PASSIVE ignores the tag */
+    record(&a, 1, 0, 0x04000u, AVB_MMIO_RD, ticks());                     /* other processor: untagged */
+    avb_mmio_acct_leave(&a, 0, inner);
+    record(&a, 0, 0, 0x0B61Cu, AVB_MMIO_RD, ticks());
+    avb_mmio_acct_leave(&a, 0, outer);
+    record(&a, 0, 0, 0x00008u, AVB_MMIO_RD, ticks());
+
+    avb_mmio_acct_sum(&a, &t);
+    ok &= outer == AVB_MMIO_CALLER_OTHER && inner == AVB_MMIO_CALLER_TX_POLL;
+    ok &= t.count[AVB_MMIO_RD][AVB_MMIO_CALLER_OTHER][AVB_MMIO_BLK_PTP] == 1;
+    ok &= t.count[AVB_MMIO_RD][AVB_MMIO_CALLER_TX_POLL][AVB_MMIO_BLK_PTP] == 2;
+    ok &= t.count[AVB_MMIO_RD][AVB_MMIO_CALLER_TARGET_TIME][AVB_MMIO_BLK_PTP] == 1;
+    ok &= t.count[AVB_MMIO_WR][AVB_MMIO_CALLER_TARGET_TIME][AVB_MMIO_BLK_PTP] == 1;
+    ok &= t.count[AVB_MMIO_RD][AVB_MMIO_CALLER_PASSIVE][AVB_MMIO_BLK_PTP] == 1;
+    ok &= t.count[AVB_MMIO_RD][AVB_MMIO_CALLER_OTHER][AVB_MMIO_BLK_STATS] == 1;
+    ok &= t.count[AVB_MMIO_RD][AVB_MMIO_CALLER_OTHER][AVB_MMIO_BLK_MAC] == 1;
+    ok &= a.slots[0].caller == AVB_MMIO_CALLER_OTHER;
+    free(storage);
+
+    /* No storage: nothing recorded, scopes are no-ops */
+    avb_mmio_acct_init(&a, NULL, 8);
+    ok &= avb_mmio_acct_slot(&a, 3) == NULL && avb_mmio_acct_enter(&a, 3, AVB_MMIO_CALLER_PACER) == AVB_MMIO_CALLER_OTHER;
+    record(&a, 3, 0, 0u, AVB_MMIO_RD, 0);
+    return ok;
+}
+
+typedef struct {
+    avb_mmio_acct_t *a;
+    uint32_t         cpu;
+    volatile int    *go;
+} worker_t;
+
+#ifdef _WIN32
+static DWORD WINAPI worker(LPVOID arg)
+#else
+static void *worker(void *arg)
+#endif
+{
+    static const uint32_t offsets[4] = { 0x00008u, 0x0B600u, 0x03570u, 0x04000u };
+    worker_t *w = (worker_t *)arg;
+    uint32_t i;
+
+    while (!*w->go) {
+        /* spin until every thread exists */
+    }
+    for (i = 0; i < PER_THREAD; i++) {
+        record(w->a, w->cpu, 0, offsets[i & 3u], i & 4u ? AVB_MMIO_WR : AVB_MMIO_RD, 0);
+    }
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+static int check_threads(uint32_t threads)
+{
+    static worker_t w[MAX_THREADS];
+#ifdef _WIN32
+    HANDLE th[MAX_THREADS];
+#else
+    pthread_t th[MAX_THREADS];
+#endif
+    avb_mmio_acct_t a;
+    avb_mmio_acct_totals_t t;
+    void *storage = new_acct(&a, SLOTS);
+    volatile int go = 0;
+    uint64_t per_cell = (uint64_t)threads * PER_THREAD / 8u, sum;
+    uint32_t i, d, k, b;
+    int ok = 1;
+
+    if (storage == NULL) return 0;
+    for (i = 0; i < threads; i++) {
+        w[i].a = &a;
+        w[i].cpu = i;
+        w[i].go = &go;
+#ifdef _WIN32
+        th[i] = CreateThread(NULL, 0, worker, &w[i], 0, NULL);
+#else
+        pthread_create(&th[i], NULL, worker, &w[i]);
+#endif
+    }
+    go = 1;
+    for (i = 0; i < threads; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(th[i], INFINITE);
+        CloseHandle(th[i]);
+#else
+        pthread_join(th[i], NULL);
+#endif
+    }
+    avb_mmio_acct_sum(&a, &t);
+    for (d = 0; d < 2u; d++) {
+        for (b = 0; b < AVB_MMIO_BLK_COUNT; b++) {
+            sum = 0;
+            for (k = 0; k < AVB_MMIO_CALLER_COUNT; k++) {
+                sum += t.count[d][k][b];
+            }
+            ok &= sum == per_cell && t.count[d][AVB_MMIO_CALLER_OTHER][b] == per_cell;
+        }
+    }
+    free(storage);
+    return ok;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-003: cost per record
+ * ------------------------------------------------------------------------- */
+static double time_record(avb_mmio_acct_t *a)
+{
+    uint32_t i;
+    double t0 = now_ns();
+
+    for (i = 0; i < RECORDS; i++) {
+        record(a, 0, 0, (i & 1u) ? 0x0B600u : 0x0B604u, AVB_MMIO_RD, ticks());
+    }
+    return (now_ns() - t0) / RECORDS;
+}
+
+static double time_clock(void)
+{
+    volatile uint64_t sink = 0;
+    uint32_t i;
+    double t0 = now_ns();
+
+    for (i = 0; i < RECORDS; i++) {
+        sink += ticks();
+    }
+    (void)sink;
+    return (now_ns() - t0) / RECORDS;
+}
+
+int main(void)
+{
+    avb_mmio_acct_t a;
+    void *storage;
+    double best = 1e300, clock = 1e300;
+    uint32_t rep, n;
+    int threads_ok = 1;
+
+    printf("========================================================================\n");
+    printf("TEST-PERF-MMIO-ACCT-001: MMIO accounting\n");
+    printf("Verifies: REQ-NF-DIAG-MMIO-001\n");
+    printf("========================================================================\n\n");
+
+    tc_result("TC-PERF-MMIO-001 register blocks", check_blocks());
+
+    for (n = 1; n <= MAX_THREADS; n *= 2u) {
+        threads_ok &= check_threads(n);
+    }
+    tc_result("TC-PERF-MMIO-002 nested scopes and exact per-CPU totals", check_scopes() && threads_ok);
+
+    storage = new_acct(&a, 1);
+    if (storage == NULL) return 1;
+    (void)avb_mmio_acct_enter(&a, 0, AVB_MMIO_CALLER_TX_POLL);
+    for (rep = 0; rep < REPEATS; rep++) {
+        double r = time_record(&a);
+        double c = time_clock();
+        if (r < best) best = r;
+        if (c < clock) clock = c;
+    }
+    free(storage);
+    /* a record reads the clock twice: t0 before the access, then the end */
+    printf("\n  one record:  %.2f ns, of which 2 clock reads %.2f ns (budget %.0f ns beyond the clock;"
+           " a BAR0 read is typically 500+ ns)\n\n", best, 2.0 * clock, BUDGET_NS);
+    tc_result("TC-PERF-MMIO-003 record within budget", best - 2.0 * clock < BUDGET_NS);
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_passed + s_failed);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    return s_failed ? 1 : 0;
+}
@@ -0,0 +1,446 @@
+/*
+ * TEST-PERF-NBL-CHAIN-001: NBL chain walks per frame, before and after the
+ * single-pass datapath accounting
+ *
+ * Verifies: REQ-F-STATISTICS-001 (Driver statistics)
+ *           REQ-F-TS-SUB-001 (RX timestamp events)
+ *
+ * Purpose:
+ *   Each datapath handler used to walk its chain once per consumer: send
+ *   counted for the gauge, for launch time, for TrackSends and once more
+ *   looking for PTP; send-complete counted for TrackSends, for the gauge and
+ *   again for injected test frames; return counted for the gauge and for
+ *   TrackReceives.  Model both versions on mock chains (NBL -> NB -> frame,
+ *   scattered over a pool larger than the last-level cache, as the miniport's
+ *   receive ring is), run send + complete and receive + return over the same
+ *   chains, and print ns (and TSC ticks on x86) per NBL at 64 and 256 NBLs
+ *   per chain.  Runs on the host - no driver needed.
+ *
+ * Test Cases:
+ *   TC-PERF-NBL-001: both versions count the same NBLs, frames, bytes and PTP events
+ *   TC-PERF-NBL-002: TX single pass costs less per NBL (median), every chain length
+ *
+ *   The four paths run interleaved REPEATS times and each reports its median,
+ *   so drift hits before and after alike.  RX is printed only: receive kept
+ *   its single classification walk and lost one counting walk, which is
+ *   within run-to-run noise on the host.
+ *
+ * Build:
+ *   cl /nologo /O2 -I src tests\performance\test_nbl_chain_bench.c
+ *   cc -O2 -I src -o test_nbl_chain_bench tests/performance/test_nbl_chain_bench.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <time.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#define HAVE_TSC 1
+#endif
+
+#include "nbl_chain.h"
+
+/* -------------------------------------------------------------------------
+ * Test Configuration
+ * ------------------------------------------------------------------------- */
+#define POOL_NBLS       (1u << 18)      /* 262144 NBLs: NBL + NB + frame ~ 64 MB */
+#define FRAME_BYTES     128u            /* stored; the frame length reported varies */
+#define PTP_EVERY       16u             /* one PTP frame in 16 (half of them events) */
+#define REPEATS         11u             /* median of N, interleaved */
+
+static const uint32_t s_chain_len[] = { 64u, 256u };
+#define CHAIN_STEPS     (sizeof(s_chain_len) / sizeof(s_chain_len[0]))
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+static void tc_result(const char *name, int passed)
+{
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static double now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+static uint64_t ticks(void)
+{
+#ifdef HAVE_TSC
+    return (uint64_t)__rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/* -------------------------------------------------------------------------
+ * Mock NBL / NB, one cache line each like the real structures' hot part
+ * ------------------------------------------------------------------------- */
+typedef struct mock_nb {
+    struct mock_nb *next;
+    uint8_t        *data;
+    uint32_t        len;
+    uint8_t         pad[64 - 2 * sizeof(void *) - sizeof(uint32_t)];
+} mock_nb_t;
+
+typedef struct mock_nbl {
+    struct mock_nbl *next;
+    mock_nb_t       *first;
+    uint64_t         launch;        /* AVB_LAUNCH_TIME_SLOT */
+    uint8_t          pad[64 - 2 * sizeof(void *) - sizeof(uint64_t)];
+} mock_nbl_t;
+
+typedef struct {
+    uint64_t nbls, frames, bytes, ptp_events;
+    uint64_t up;                    /* NBLs completed / returned */
+    int64_t  gauge;                 /* outstanding NBLs */
+    int64_t  track;                 /* TrackSends / TrackReceives reference */
+} tally_t;
+
+static mock_nbl_t *s_nbl;
+static mock_nb_t  *s_nb;
+static uint8_t    *s_frames;
+static uint32_t   *s_order;
+
+static volatile int64_t s_slot[4];  /* per-CPU statistics slot stand-in */
+
+static void stat_add(int i, int64_t n)
+{
+#ifdef _WIN32
+    InterlockedExchangeAdd64((volatile LONG64 *)&s_slot[i], n);
+#else
+    __atomic_fetch_add(&s_slot[i], n, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/* PTP header check both versions make on receive (and the old send path made) */
+static int classify(const mock_nb_t *nb, tally_t *t)
+{
+    avb_ptp_frame_t f;
+    int kind = avb_ptp_classify(nb->data, nb->len, &f);
+    if (kind == AVB_PTP_EVENT) t->ptp_events++;
+    return kind;
+}
+
+/* ---- before: one walk per consumer ------------------------------------ */
+
+static void tx_before(mock_nbl_t *chain, tally_t *t)
+{
+    mock_nbl_t *n;
+    int64_t c = 0;
+
+    for (n = chain; n; n = n->next) c++;                        /* gauge */
+    stat_add(0, c);
+    t->gauge += c;
+    for (n = chain; n; n = n->next) {                           /* launch time */
+        if (n->launch) n->launch = 0;
+        t->nbls++;
+        t->frames++;
+        t->bytes += n->first->len;
+    }
+    for (n = chain; n; n = n->next) t->track++;                 /* TrackSends */
+    for (n = chain; n; n = n->next) {                           /* TX PTP look */
+        volatile uint8_t hdr = n->first->data[12];
+        (void)hdr;
+    }
+    /* completion */
+    c = 0;
+    for (n = chain; n; n = n->next) c++;                        /* TrackSends */
+    t->track -= c;
+    c = 0;
+    for (n = chain; n; n = n->next) c++;                        /* gauge */
+    stat_add(0, -c);
+    t->gauge -= c;
+    c = 0;
+    for (n = chain; n; n = n->next) {                           /* test frames */
+        const uint8_t *d = n->first->data;
+        if (!(d[0] == 0x01 && d[1] == 0x1B && d[2] == 0x19 && d[3] == 0x00 && d[4] == 0x00 && d[5] == 0x00)) {
+            c++;
+        }
+    }
+    t->up += (uint64_t)c;
+}
+
+static void rx_before(mock_nbl_t *chain, uint32_t count, tally_t *t)
+{
+    mock_nbl_t *n;
+    int64_t c = 0;
+
+    stat_add(1, count);                                         /* gauge: NDIS count */
+    t->gauge += count;
+    for (n = chain; n; n = n->next) {                           /* PTP classification */
+        if (n->first->len >= AVB_PTP_PARSE_LEN) classify(n->first, t);
+        t->nbls++;
+        t->frames++;
+        t->bytes += n->first->len;
+    }
+    t->track += count;
+    /* return */
+    for (n = chain; n; n = n->next) c++;                        /* gauge */
+    stat_add(1, -c);
+    t->gauge -= c;
+    c = 0;
+    for (n = chain; n; n = n->next) c++;                        /* TrackReceives */
+    t->track -= c;
+    t->up += (uint64_t)c;
+}
+
+/* ---- after: one walk per handler (src/nbl_chain.h) --------------------- */
+
+static void tx_after(mock_nbl_t *chain, tally_t *t)
+{
+    avb_chain_acct_t a;
+    mock_nbl_t *n;
+    uint32_t done = 0;
+
+    avb_chain_acct_init(&a);
+    for (n = chain; n; n = n->next) {                           /* FilterPrepareSendChain */
+        const mock_nb_t *nb;
+        uint32_t frames = 0;
+        uint64_t bytes = 0;
+        for (nb = n->first; nb; nb = nb->next) { frames++; bytes += nb->len; }
+        if (n->launch) n->launch = 0;
+        avb_chain_acct_add(&a, frames, bytes);
+    }
+    stat_add(0, a.nbls);
+    stat_add(2, a.frames);
+    stat_add(3, (int64_t)a.bytes);
+    t->gauge += a.nbls;
+    t->track += a.nbls;
+    /* completion */
+    for (n = chain; n; n = n->next) {                           /* test frames + count */
+        const uint8_t *d = n->first->data;
+        if (!(d[0] == 0x01 && d[1] == 0x1B && d[2] == 0x19 && d[3] == 0x00 && d[4] == 0x00 && d[5] == 0x00)) {
+            done++;
+        }
+    }
+    t->track -= done;
+    t->up += done;
+    stat_add(0, -(int64_t)done);
+    t->gauge -= done;
+    t->nbls   += a.nbls;
+    t->frames += a.frames;
+    t->bytes  += a.bytes;
+}
+
+static void rx_after(mock_nbl_t *chain, uint32_t count, tally_t *t)
+{
+    avb_chain_acct_t a;
+    mock_nbl_t *n;
+    uint32_t back = 0;
+
+    stat_add(1, count);
+    t->gauge += count;
+    avb_chain_acct_init(&a);
+    for (n = chain; n; n = n->next) {                           /* FilterReceiveNetBufferLists */
+        const mock_nb_t *nb = n->first;
+        avb_chain_acct_add(&a, 1, nb->len);
+        if (nb->len >= AVB_PTP_PARSE_LEN) classify(nb, t);
+    }
+    stat_add(2, a.frames);
+    stat_add(3, (int64_t)a.bytes);
+    t->track += count;
+    /* return */
+    for (n = chain; n; n = n->next) back++;                     /* gauge + TrackReceives */
+    stat_add(1, -(int64_t)back);
+    t->gauge -= back;
+    t->track -= back;
+    t->up += back;
+    t->nbls   += a.nbls;
+    t->frames += a.frames;
+    t->bytes  += a.bytes;
+}
+
+/* -------------------------------------------------------------------------
+ * Pool: NBLs linked in a random order so every hop is a likely cache miss
+ * ------------------------------------------------------------------------- */
+static int build_pool(void)
+{
+    uint32_t i, x = 0x9E3779B9u;
+
+    s_nbl    = (mock_nbl_t *)calloc(POOL_NBLS, sizeof(mock_nbl_t));
+    s_nb     = (mock_nb_t *)calloc(POOL_NBLS, sizeof(mock_nb_t));
+    s_frames = (uint8_t *)calloc(POOL_NBLS, FRAME_BYTES);
+    s_order  = (uint32_t *)malloc(POOL_NBLS * sizeof(uint32_t));
+    if (!s_nbl || !s_nb || !s_frames || !s_order) return 0;
+
+    for (i = 0; i < POOL_NBLS; i++) {
+        uint8_t *d = s_frames + (size_t)i * FRAME_BYTES;
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        s_order[i]       = i;
+        s_nbl[i].first   = &s_nb[i];
+        s_nbl[i].launch  = (x & 7u) == 0 ? 1u : 0u;
+        s_nb[i].data     = d;
+        s_nb[i].len      = 64u + x % 1455u;
+        d[12] = 0x08; d[13] = 0x00;                 /* IPv4 */
+        if (i % PTP_EVERY == 0) {
+            d[12] = 0x81; d[13] = 0x00;             /* 802.1Q, PCP 3, VID 2 */
+            d[14] = 0x60; d[15] = 0x02;
+            d[16] = 0x88; d[17] = 0xF7;
+            d[18] = (uint8_t)((i / PTP_EVERY) & 1u ? 0x0 : 0xB);   /* Sync / Announce */
+        }
+    }
+    for (i = POOL_NBLS - 1u; i > 0; i--) {
+        uint32_t j, tmp;
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        j = x % (i + 1u);
+        tmp = s_order[i]; s_order[i] = s_order[j]; s_order[j] = tmp;
+    }
+    return 1;
+}
+
+/* Link the pool into chains of len NBLs; returns the chain count */
+static uint32_t link_chains(uint32_t len, mock_nbl_t **heads)
+{
+    uint32_t c, k, chains = POOL_NBLS / len;
+
+    for (c = 0; c < chains; c++) {
+        heads[c] = &s_nbl[s_order[c * len]];
+        for (k = 0; k < len; k++) {
+            mock_nbl_t *n = &s_nbl[s_order[c * len + k]];
+            n->next = (k + 1u < len) ? &s_nbl[s_order[c * len + k + 1u]] : NULL;
+        }
+    }
+    return chains;
+}
+
+static void reset_launch(void)
+{
+    uint32_t i, x = 0x9E3779B9u;
+    for (i = 0; i < POOL_NBLS; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        s_nbl[i].launch = (x & 7u) == 0 ? 1u : 0u;
+    }
+}
+
+typedef struct { double ns; double tsc; } cost_t;
+
+#define MODES           4u              /* TX before, TX after, RX before, RX after */
+
+/* One pass of mode over every chain, per NBL */
+static cost_t run_once(uint32_t mode, mock_nbl_t **heads, uint32_t chains, uint32_t len, tally_t *t)
+{
+    cost_t r;
+    double t0;
+    uint64_t k0;
+    uint32_t c;
+
+    memset(t, 0, sizeof(*t));
+    reset_launch();
+    t0 = now_ns();
+    k0 = ticks();
+    for (c = 0; c < chains; c++) {
+        switch (mode) {
+        case 0: tx_before(heads[c], t); break;
+        case 1: tx_after(heads[c], t); break;
+        case 2: rx_before(heads[c], len, t); break;
+        default: rx_after(heads[c], len, t); break;
+        }
+    }
+    r.tsc = (double)(ticks() - k0) / (double)(chains * len);
+    r.ns  = (now_ns() - t0) / (double)(chains * len);
+    return r;
+}
+
+static int cmp_cost(const void *a, const void *b)
+{
+    double x = ((const cost_t *)a)->ns, y = ((const cost_t *)b)->ns;
+    return (x > y) - (x < y);
+}
+
+/* Every mode REPEATS times, interleaved; out[mode] is its median */
+static void run(mock_nbl_t **heads, uint32_t chains, uint32_t len, tally_t *t, cost_t *out)
+{
+    static cost_t samples[MODES][REPEATS];
+    uint32_t rep, mode;
+
+    for (rep = 0; rep < REPEATS; rep++) {
+        for (mode = 0; mode < MODES; mode++) {
+            samples[mode][rep] = run_once(mode, heads, chains, len, &t[mode]);
+        }
+    }
+    for (mode = 0; mode < MODES; mode++) {
+        qsort(samples[mode], REPEATS, sizeof(cost_t), cmp_cost);
+        out[mode] = samples[mode][REPEATS / 2u];
+    }
+}
+
+static int same(const tally_t *a, const tally_t *b)
+{
+    return a->nbls == b->nbls && a->frames == b->frames && a->bytes == b->bytes && a->up == b->up &&
+           a->ptp_events == b->ptp_events && a->gauge == 0 && b->gauge == 0 &&
+           a->track == 0 && b->track == 0;
+}
+
+int main(void)
+{
+    static mock_nbl_t *heads[POOL_NBLS];
+    int equal = 1, cheaper = 1;
+    uint32_t k;
+
+    printf("========================================================================\n");
+    printf("TEST-PERF-NBL-CHAIN-001: chain walks per NBL, multi-pass vs. single pass\n");
+    printf("Verifies: REQ-F-STATISTICS-001, REQ-F-TS-SUB-001\n");
+    printf("========================================================================\n");
+
+    if (!build_pool()) {
+        printf("  pool allocation failed\n");
+        return 1;
+    }
+    printf("\n  %u NBLs scattered over ~%u MB, 1 PTP frame in %u\n\n",
+           POOL_NBLS, (unsigned)((POOL_NBLS * (2u * 64u + FRAME_BYTES)) >> 20), PTP_EVERY);
+    printf("  chain  path   before ns/NBL  after ns/NBL  saved ns  saved TSC ticks/NBL\n");
+
+    for (k = 0; k < CHAIN_STEPS; k++) {
+        uint32_t len = s_chain_len[k];
+        uint32_t chains = link_chains(len, heads);
+        tally_t t[MODES];
+        cost_t m[MODES], txb, txa, rxb, rxa;
+
+        run(heads, chains, len, t, m);
+        txb = m[0]; txa = m[1]; rxb = m[2]; rxa = m[3];
+
+        printf("  %5u  TX     %13.2f  %12.2f  %8.2f  %19.1f\n", len, txb.ns, txa.ns,
+               txb.ns - txa.ns, txb.tsc - txa.tsc);
+        printf("  %5u  RX     %13.2f  %12.2f  %8.2f  %19.1f\n", len, rxb.ns, rxa.ns,
+               rxb.ns - rxa.ns, rxb.tsc - rxa.tsc);
+
+        equal   &= same(&t[0], &t[1]) && same(&t[2], &t[3]) && t[2].ptp_events != 0;
+        cheaper &= txa.ns < txb.ns;
+    }
+#ifndef HAVE_TSC
+    printf("  (no TSC on this host: tick columns are 0)\n");
+#endif
+    printf("  (medians of %u interleaved runs; RX is reported, not checked)\n\n", REPEATS);
+
+    tc_result("TC-PERF-NBL-001 identical accounting and PTP classification", equal);
+    tc_result("TC-PERF-NBL-002 TX single pass cheaper per NBL (median)", cheaper);
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_passed + s_failed);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    free(s_nbl); free(s_nb); free(s_frames); free(s_order);
+    return s_failed ? 1 : 0;
+}
@@ -0,0 +1,430 @@
+/*
+ * TEST-PERF-NBL-POOL-001: SEND_PTP slot pool under concurrent acquire / release
+ *
+ * Verifies: REQ-NF-PERF-TXPOOL-001 (SEND_PTP slot pool)
+ *
+ * Purpose:
+ *   IOCTL_AVB_TEST_SEND_PTP takes a pre-built NBL triple from the lock-free
+ *   pool of src/nbl_pool.h, and the send-complete path gives it back from
+ *   any processor.  Check the pool's rules single-threaded (ready before
+ *   spare, growth stops at the limit, exhaustion and failed builds are
+ *   counted, trimming keeps the minimum), then let many threads acquire,
+ *   hold and release slots - building fresh ones, failing some builds -
+ *   while a trimmer frees idle triples, and verify that no slot is ever
+ *   handed to two owners, that a fresh slot never has a triple and a ready
+ *   one always has, and that every index is accounted for at the end.
+ *   Finally time an uncontended acquire / release pair.  Runs on the host
+ *   - no driver needed.
+ *
+ * Test Cases:
+ *   TC-PERF-NBLPOOL-001: LIFO reuse, growth to the limit, exhaustion, discard, trim, idle, no storage
+ *   TC-PERF-NBLPOOL-002: 2..16 threads, exclusive ownership, build state and final accounting
+ *   TC-PERF-NBLPOOL-003: acquire + release in less than BUDGET_NS uncontended
+ *
+ * Build:
+ *   cl /nologo /O2 -I src tests\performance\test_nbl_pool_bench.c src\nbl_pool.c
+ *   cc -O2 -pthread -I src -o test_nbl_pool_bench tests/performance/test_nbl_pool_bench.c src/nbl_pool.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+#include "nbl_pool.h"
+
+/* -------------------------------------------------------------------------
+ * Test Configuration
+ * ------------------------------------------------------------------------- */
+#define CAPACITY        256u
+#define LIMIT           192u
+#define MINIMUM         32u
+#define MAX_THREADS     16u
+#define OPS_PER_THREAD  200000u
+#define HOLD_MAX        16u             /* slots one thread holds at most */
+#define FAIL_ONE_IN     64u             /* fresh builds that fail */
+#define PAIRS           2000000u
+#define REPEATS         5u              /* best-of-N */
+#define BUDGET_NS       100.0           /* TC-003: two compare-exchanges and the counters */
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+static void tc_result(const char *name, int passed)
+{
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static double now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+static int32_t xchg32(volatile int32_t *p, int32_t v)
+{
+#ifdef _WIN32
+    return (int32_t)InterlockedExchange((volatile LONG *)p, v);
+#else
+    return __atomic_exchange_n(p, v, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static void yield_cpu(void)
+{
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+/* Walk a stack head single-threaded; marks seen[] and returns the length, -1 on a repeat */
+static int walk(const avb_nbl_pool_t *p, int64_t head, uint8_t *seen)
+{
+    uint32_t link = (uint32_t)((uint64_t)head & 0xFFFFFFFFu);
+    int n = 0;
+
+    while (link != 0) {
+        if (link > p->capacity || seen[link - 1u]) return -1;
+        seen[link - 1u] = 1;
+        link = p->next[link - 1u];
+        n++;
+    }
+    return n;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-001: rules
+ * ------------------------------------------------------------------------- */
+static int check_rules(void)
+{
+    static uint32_t links[8];
+    avb_nbl_pool_t p;
+    uint32_t a, b, got[8], i, n;
+    int fresh, ok = 1;
+
+    avb_nbl_pool_init(&p, links, 8, 4, 2);
+
+    /* pre-build the minimum */
+    a = avb_nbl_pool_take_spare(&p);
+    b = avb_nbl_pool_take_spare(&p);
+    avb_nbl_pool_stock(&p, a);
+    avb_nbl_pool_stock(&p, b);
+    ok &= a == 0 && b == 1 && p.built == 2;
+
+    /* ready first, last released first */
+    got[0] = avb_nbl_pool_acquire(&p, &fresh);
+    ok &= got[0] == 1 && !fresh;
+    avb_nbl_pool_release(&p, got[0]);
+    got[0] = avb_nbl_pool_acquire(&p, &fresh);
+    ok &= got[0] == 1 && !fresh;
+    got[1] = avb_nbl_pool_acquire(&p, &fresh);
+    ok &= got[1] == 0 && !fresh;
+
+    /* growth to the limit, then exhaustion */
+    got[2] = avb_nbl_pool_acquire(&p, &fresh);
+    ok &= got[2] == 2 && fresh;
+    got[3] = avb_nbl_pool_acquire(&p, &fresh);
+    ok &= got[3] == 3 && fresh;
+    ok &= avb_nbl_pool_acquire(&p, &fresh) == AVB_NBL_POOL_NONE && p.exhausted == 1;
+    ok &= p.built == 4 && p.in_flight == 4 && p.peak_in_flight == 4 && p.grown == 2;
+
+    /* a failed build gives its place back */
+    avb_nbl_pool_discard(&p, got[3]);
+    ok &= p.built == 3 && p.in_flight == 3 && p.exhausted == 2 && p.build_failures == 1;
+    got[3] = avb_nbl_pool_acquire(&p, &fresh);
+    ok &= got[3] == 3 && fresh;
+    for (i = 0; i < 4; i++) avb_nbl_pool_release(&p, got[i]);
+    ok &= p.in_flight == 0 && p.acquired == 6;
+
+    /* idle: nothing acquired since the last look */
+    ok &= !avb_nbl_pool_idle(&p) && avb_nbl_pool_idle(&p);
+
+    /* trim down to the minimum */
+    n = 0;
+    while ((a = avb_nbl_pool_trim_take(&p, p.minimum)) != AVB_NBL_POOL_NONE) {
+        avb_nbl_pool_give_spare(&p, a);
+        n++;
+    }
+    ok &= n == 2 && p.built == 2 && p.trimmed == 2;
+
+    /* a lower limit stops growth at once; trimming brings built down to it */
+    avb_nbl_pool_set_limits(&p, 1, 5);
+    ok &= p.limit == 1 && p.minimum == 1;
+    got[0] = avb_nbl_pool_acquire(&p, &fresh);
+    got[1] = avb_nbl_pool_acquire(&p, &fresh);
+    got[2] = avb_nbl_pool_acquire(&p, &fresh);
+    ok &= got[0] != AVB_NBL_POOL_NONE && got[1] != AVB_NBL_POOL_NONE && got[2] == AVB_NBL_POOL_NONE;
+    avb_nbl_pool_release(&p, got[0]);
+    avb_nbl_pool_release(&p, got[1]);
+    a = avb_nbl_pool_trim_take(&p, p.limit);
+    ok &= a != AVB_NBL_POOL_NONE;
+    avb_nbl_pool_give_spare(&p, a);
+    ok &= avb_nbl_pool_trim_take(&p, p.limit) == AVB_NBL_POOL_NONE && p.built == 1;
+
+    /* no storage */
+    avb_nbl_pool_init(&p, NULL, 8, 8, 8);
+    ok &= p.capacity == 0 && avb_nbl_pool_acquire(&p, &fresh) == AVB_NBL_POOL_NONE &&
+          avb_nbl_pool_take_spare(&p) == AVB_NBL_POOL_NONE && p.exhausted == 1;
+    return ok;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-002: stress
+ * ------------------------------------------------------------------------- */
+typedef struct {
+    avb_nbl_pool_t   *p;
+    uint32_t          seed;
+    volatile int     *go;
+    volatile int     *stop;
+    uint64_t          acquired;
+    uint64_t          exhausted;
+    int               errors;
+} worker_t;
+
+static volatile int32_t s_owner[CAPACITY];     /* 1 while handed out */
+static volatile int32_t s_built[CAPACITY];     /* 1 while a "triple" exists */
+
+static uint32_t next_rand(uint32_t *s)
+{
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker(LPVOID arg)
+#else
+static void *worker(void *arg)
+#endif
+{
+    worker_t *w = (worker_t *)arg;
+    uint32_t held[HOLD_MAX], nheld = 0, i, idx;
+    int fresh;
+
+    while (!*w->go) {
+        /* spin until every thread exists */
+    }
+    for (i = 0; i < OPS_PER_THREAD; i++) {
+        if (nheld < HOLD_MAX && (nheld == 0 || (next_rand(&w->seed) & 1u))) {
+            idx = avb_nbl_pool_acquire(w->p, &fresh);
+            if (idx == AVB_NBL_POOL_NONE) {
+                w->exhausted++;
+                continue;
+            }
+            if (idx >= CAPACITY || xchg32(&s_owner[idx], 1) != 0) {
+                w->errors++;
+                continue;
+            }
+            if (fresh) {
+                if (s_built[idx] != 0) w->errors++;
+                if (next_rand(&w->seed) % FAIL_ONE_IN == 0) {
+                    xchg32(&s_owner[idx], 0);
+                    avb_nbl_pool_discard(w->p, idx);
+                    continue;
+                }
+                xchg32(&s_built[idx], 1);
+            } else if (s_built[idx] != 1) {
+                w->errors++;
+            }
+            w->acquired++;
+            held[nheld++] = idx;
+        } else {
+            uint32_t k = next_rand(&w->seed) % nheld;
+            idx = held[k];
+            held[k] = held[--nheld];
+            xchg32(&s_owner[idx], 0);
+            avb_nbl_pool_release(w->p, idx);
+        }
+    }
+    while (nheld != 0) {
+        idx = held[--nheld];
+        xchg32(&s_owner[idx], 0);
+        avb_nbl_pool_release(w->p, idx);
+    }
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/* Frees idle "triples" while the workers run, like the driver's trim timer */
+#ifdef _WIN32
+static DWORD WINAPI trimmer(LPVOID arg)
+#else
+static void *trimmer(void *arg)
+#endif
+{
+    worker_t *w = (worker_t *)arg;
+    uint32_t idx;
+
+    while (!*w->stop) {
+        while ((idx = avb_nbl_pool_trim_take(w->p, MINIMUM)) != AVB_NBL_POOL_NONE) {
+            if (idx >= CAPACITY || s_owner[idx] != 0 || s_built[idx] != 1) {
+                w->errors++;
+            }
+            xchg32(&s_built[idx], 0);
+            avb_nbl_pool_give_spare(w->p, idx);
+            w->acquired++;      /* trims */
+        }
+        yield_cpu();
+    }
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+static int check_stress(uint32_t threads, double *ops_per_s)
+{
+    static uint32_t links[CAPACITY];
+    static worker_t w[MAX_THREADS + 1];
+    static uint8_t seen[CAPACITY];
+#ifdef _WIN32
+    HANDLE th[MAX_THREADS + 1];
+#else
+    pthread_t th[MAX_THREADS + 1];
+#endif
+    avb_nbl_pool_t p;
+    volatile int go = 0, stop = 0;
+    uint64_t acquired = 0;
+    uint32_t i, idx, nbuilt = 0;
+    int ready_n, spare_n, errors = 0, ok = 1;
+    double t0;
+
+    avb_nbl_pool_init(&p, links, CAPACITY, LIMIT, MINIMUM);
+    memset((void *)s_owner, 0, sizeof(s_owner));
+    memset((void *)s_built, 0, sizeof(s_built));
+    for (i = 0; i < MINIMUM; i++) {
+        idx = avb_nbl_pool_take_spare(&p);
+        s_built[idx] = 1;
+        avb_nbl_pool_stock(&p, idx);
+    }
+
+    for (i = 0; i <= threads; i++) {
+        memset(&w[i], 0, sizeof(w[i]));
+        w[i].p = &p;
+        w[i].seed = 0x9E3779B9u * (i + 1u);
+        w[i].go = &go;
+        w[i].stop = &stop;
+#ifdef _WIN32
+        th[i] = CreateThread(NULL, 0, i < threads ? worker : trimmer, &w[i], 0, NULL);
+#else
+        pthread_create(&th[i], NULL, i < threads ? worker : trimmer, &w[i]);
+#endif
+    }
+    t0 = now_ns();
+    go = 1;
+    for (i = 0; i <= threads; i++) {
+        if (i == threads) stop = 1;
+#ifdef _WIN32
+        WaitForSingleObject(th[i], INFINITE);
+        CloseHandle(th[i]);
+#else
+        pthread_join(th[i], NULL);
+#endif
+    }
+    *ops_per_s = (double)threads * OPS_PER_THREAD / ((now_ns() - t0) / 1e9);
+
+    for (i = 0; i <= threads; i++) {
+        errors += w[i].errors;
+        if (i < threads) acquired += w[i].acquired;
+    }
+    for (i = 0; i < CAPACITY; i++) {
+        nbuilt += (uint32_t)s_built[i];
+        ok &= s_owner[i] == 0;
+    }
+    memset(seen, 0, sizeof(seen));
+    ready_n = walk(&p, p.ready, seen);
+    spare_n = walk(&p, p.spare, seen);
+    ok &= errors == 0 && p.in_flight == 0 && ready_n >= 0 && spare_n >= 0;
+    /* quiescent: every built slot is ready, every other one spare */
+    ok &= (uint32_t)(ready_n + spare_n) == CAPACITY && (uint32_t)p.built == nbuilt && (uint32_t)ready_n == nbuilt;
+    ok &= (uint64_t)p.acquired == acquired + (uint64_t)p.build_failures;
+    ok &= p.peak_in_flight <= (int32_t)LIMIT && p.built <= (int32_t)LIMIT;
+    if (!ok) {
+        printf("  %u threads: errors %d, in flight %d, ready %d + spare %d, built %d / %u, acquired %lld / %llu\n",
+               threads, errors, p.in_flight, ready_n, spare_n, p.built, nbuilt,
+               (long long)p.acquired, (unsigned long long)acquired);
+    } else {
+        printf("  %2u threads: %10llu acquired, %8lld exhausted, %6lld grown, %6lld trimmed, peak %d in flight\n",
+               threads, (unsigned long long)acquired, (long long)p.exhausted, (long long)p.grown,
+               (long long)p.trimmed, p.peak_in_flight);
+    }
+    return ok;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-003: cost per pair
+ * ------------------------------------------------------------------------- */
+static double time_pairs(avb_nbl_pool_t *p)
+{
+    uint32_t i, idx;
+    int fresh;
+    double t0 = now_ns();
+
+    for (i = 0; i < PAIRS; i++) {
+        idx = avb_nbl_pool_acquire(p, &fresh);
+        avb_nbl_pool_release(p, idx);
+    }
+    return (now_ns() - t0) / PAIRS;
+}
+
+int main(void)
+{
+    static uint32_t links[CAPACITY];
+    avb_nbl_pool_t p;
+    double best = 1e300, rate;
+    uint32_t n, rep;
+    int stress_ok = 1;
+
+    printf("========================================================================\n");
+    printf("TEST-PERF-NBL-POOL-001: SEND_PTP slot pool\n");
+    printf("Verifies: REQ-NF-PERF-TXPOOL-001\n");
+    printf("========================================================================\n\n");
+
+    tc_result("TC-PERF-NBLPOOL-001 pool rules", check_rules());
+
+    for (n = 2; n <= MAX_THREADS; n *= 2u) {
+        stress_ok &= check_stress(n, &rate);
+        printf("             %.1f M operations/s\n", rate / 1e6);
+    }
+    tc_result("TC-PERF-NBLPOOL-002 concurrent acquire / release / trim", stress_ok);
+
+    avb_nbl_pool_init(&p, links, CAPACITY, LIMIT, MINIMUM);
+    avb_nbl_pool_stock(&p, avb_nbl_pool_take_spare(&p));
+    for (rep = 0; rep < REPEATS; rep++) {
+        double r = time_pairs(&p);
+        if (r < best) best = r;
+    }
+    printf("\n  acquire + release: %.2f ns (budget %.0f ns)\n\n", best, BUDGET_NS);
+    tc_result("TC-PERF-NBLPOOL-003 acquire + release within budget", best < BUDGET_NS);
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_passed + s_failed);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    return s_failed ? 1 : 0;
+}
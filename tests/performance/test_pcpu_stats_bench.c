@@ -0,0 +1,328 @@
+/*
+ * TEST-PERF-PCPU-STATS-001: per-CPU vs. shared driver statistics counters
+ *
+ * Verifies: REQ-F-STATISTICS-001 (Driver statistics)
+ *           REQ-F-STATISTICS-003 (Statistics snapshots)
+ *
+ * Purpose:
+ *   The receive path updates rx_packets, rx_bytes and the outstanding receive
+ *   gauge for every indication; with RSS those updates come from many cores
+ *   at once.  Run the same update sequence from 1..64 threads against one
+ *   shared slot (all threads hit the same cache lines, as the driver did
+ *   with one LONGLONG per field) and against one slot per thread (the
+ *   per-CPU layout of src/pcpu_stats.c), and print the counter cost per
+ *   packet.  The totals read back through avb_pcpu_stats_sum must be exact
+ *   in both layouts.  Snapshot deltas (IOCTL_AVB_STATS_SNAPSHOT) are
+ *   checked on the same module.  Runs on the host - no driver needed.
+ *
+ * Test Cases:
+ *   TC-PERF-PCPU-001: exact totals, shared and per-CPU, at every thread count
+ *   TC-PERF-PCPU-002: RESET restarts the counters and leaves the gauges live
+ *   TC-PERF-PCPU-003: per-CPU no slower than shared with one thread per core
+ *                     (needs 2+ host processors; reported only otherwise)
+ *   TC-PERF-PCPU-004: snapshot deltas span a RESET unchanged; evicted bases are reported missing
+ *
+ * Build:
+ *   cl /nologo /O2 -I src tests\performance\test_pcpu_stats_bench.c src\pcpu_stats.c
+ *   cc -O2 -pthread -I src -o test_pcpu_stats_bench tests/performance/test_pcpu_stats_bench.c src/pcpu_stats.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "pcpu_stats.h"
+
+/* -------------------------------------------------------------------------
+ * Test Configuration
+ * ------------------------------------------------------------------------- */
+#define MAX_THREADS     64u
+#define PACKETS         100000u         /* per thread */
+#define FRAME_BYTES     1522u
+#define REPEATS         3u              /* best-of-N */
+#define SLACK           1.25            /* TC-003: per-CPU may be this much slower (noise) */
+
+static const uint32_t s_threads[] = { 1u, 2u, 4u, 8u, 16u, 32u, 64u };
+#define THREAD_STEPS    (sizeof(s_threads) / sizeof(s_threads[0]))
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+static void tc_result(const char *name, int passed)
+{
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static double now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+static uint32_t host_cpus(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (uint32_t)si.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (uint32_t)n : 1u;
+#endif
+}
+
+/* The driver's InterlockedAdd64 */
+static void atomic_add(volatile int64_t *p, int64_t n)
+{
+#ifdef _WIN32
+    InterlockedExchangeAdd64((volatile LONG64 *)p, n);
+#else
+    __atomic_fetch_add(p, n, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/* -------------------------------------------------------------------------
+ * Worker: the receive indicate / return pair, one packet per iteration
+ * ------------------------------------------------------------------------- */
+typedef struct {
+    avb_pcpu_stats_t *stats;
+    uint32_t          cpu;          /* slot this thread stands for */
+    volatile int     *go;
+} worker_t;
+
+#ifdef _WIN32
+static DWORD WINAPI worker(LPVOID arg)
+#else
+static void *worker(void *arg)
+#endif
+{
+    worker_t *w = (worker_t *)arg;
+    avb_pcpu_slot_t *slot;
+    uint32_t i;
+
+    while (!*w->go) {
+        /* spin until every thread exists */
+    }
+    slot = avb_pcpu_slot(w->stats, w->cpu);
+    for (i = 0; i < PACKETS; i++) {
+        atomic_add(&slot->v[AVB_STAT_RX_PACKETS], 1);
+        atomic_add(&slot->v[AVB_STAT_RX_BYTES], FRAME_BYTES);
+        atomic_add(&slot->v[AVB_STAT_OUTSTANDING_RECEIVE_NBLS], 1);
+        atomic_add(&slot->v[AVB_STAT_OUTSTANDING_RECEIVE_NBLS], -1);
+    }
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/* Runs one configuration; returns ns per packet per thread, *exact receives the total check */
+static double run(uint32_t threads, int per_cpu, int *exact)
+{
+    static avb_pcpu_stats_t stats;
+    static worker_t w[MAX_THREADS];
+#ifdef _WIN32
+    HANDLE h[MAX_THREADS];
+#else
+    pthread_t h[MAX_THREADS];
+#endif
+    volatile int go = 0;
+    void *storage = NULL;
+    uint64_t out[AVB_STAT_COUNT];
+    double t0, dt;
+    uint32_t i;
+
+    if (per_cpu) {
+        storage = calloc(1, avb_pcpu_stats_bytes(threads));
+        if (storage == NULL) { *exact = 0; return 0.0; }
+    }
+    avb_pcpu_stats_init(&stats, storage, per_cpu ? threads : 0u);
+
+    for (i = 0; i < threads; i++) {
+        w[i].stats = &stats;
+        w[i].cpu   = i;
+        w[i].go    = &go;
+#ifdef _WIN32
+        h[i] = CreateThread(NULL, 0, worker, &w[i], 0, NULL);
+#else
+        pthread_create(&h[i], NULL, worker, &w[i]);
+#endif
+    }
+    t0 = now_ns();
+    go = 1;
+    for (i = 0; i < threads; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(h[i], INFINITE);
+        CloseHandle(h[i]);
+#else
+        pthread_join(h[i], NULL);
+#endif
+    }
+    dt = now_ns() - t0;
+
+    avb_pcpu_stats_sum(&stats, out);
+    *exact = out[AVB_STAT_RX_PACKETS] == (uint64_t)threads * PACKETS &&
+             out[AVB_STAT_RX_BYTES] == (uint64_t)threads * PACKETS * FRAME_BYTES &&
+             out[AVB_STAT_OUTSTANDING_RECEIVE_NBLS] == 0u;
+    free(storage);
+    return dt / PACKETS;
+}
+
+/* RESET semantics on a fixed update sequence, slots updated from "different CPUs" */
+static int check_reset(void)
+{
+    avb_pcpu_stats_t s;
+    void *storage = calloc(1, avb_pcpu_stats_bytes(4));
+    uint64_t out[AVB_STAT_COUNT];
+    int ok = 1;
+
+    if (storage == NULL) return 0;
+    avb_pcpu_stats_init(&s, storage, 4);
+
+    /* 5 sends on CPU 0; 3 complete on CPU 2 (that slot goes negative) */
+    avb_pcpu_slot(&s, 0)->v[AVB_STAT_OUTSTANDING_SEND_NBLS] += 5;
+    avb_pcpu_slot(&s, 2)->v[AVB_STAT_OUTSTANDING_SEND_NBLS] -= 3;
+    avb_pcpu_slot(&s, 1)->v[AVB_STAT_IOCTL] += 7;
+    avb_pcpu_slot(&s, 3)->v[AVB_STAT_IOCTL] += 2;
+    avb_pcpu_stats_sum(&s, out);
+    ok &= out[AVB_STAT_OUTSTANDING_SEND_NBLS] == 2u && out[AVB_STAT_IOCTL] == 9u;
+
+    avb_pcpu_stats_reset(&s);
+    avb_pcpu_stats_sum(&s, out);
+    ok &= out[AVB_STAT_IOCTL] == 0u;                    /* counter restarts */
+    ok &= out[AVB_STAT_OUTSTANDING_SEND_NBLS] == 2u;    /* gauge stays live */
+
+    /* The two in flight complete after the reset: gauge 0, never wraps */
+    avb_pcpu_slot(&s, 3)->v[AVB_STAT_OUTSTANDING_SEND_NBLS] -= 2;
+    avb_pcpu_slot(&s, 5)->v[AVB_STAT_IOCTL] += 1;       /* CPU beyond the slots folds in */
+    avb_pcpu_stats_sum(&s, out);
+    ok &= out[AVB_STAT_OUTSTANDING_SEND_NBLS] == 0u && out[AVB_STAT_IOCTL] == 1u;
+
+    free(storage);
+    return ok;
+}
+
+/* Snapshot history: generations, deltas across a reset, base eviction */
+static int check_snapshots(void)
+{
+    static avb_stats_history_t h;
+    avb_pcpu_stats_t s;
+    void *storage = calloc(1, avb_pcpu_stats_bytes(2));
+    int64_t raw[AVB_STAT_COUNT];
+    uint64_t out[AVB_STAT_COUNT];
+    const avb_stats_snap_t *a, *b;
+    uint64_t first;
+    uint32_t i;
+    int ok = 1;
+
+    if (storage == NULL) return 0;
+    avb_pcpu_stats_init(&s, storage, 2);
+    memset(&h, 0, sizeof(h));
+
+    avb_pcpu_slot(&s, 0)->v[AVB_STAT_TX_PACKETS] += 10;
+    avb_pcpu_slot(&s, 0)->v[AVB_STAT_OUTSTANDING_SEND_NBLS] += 4;
+    avb_pcpu_stats_raw(&s, raw);
+    a = avb_stats_history_add(&h, raw, 1000u, 1u);
+    first = a->generation;
+    ok &= first == 1u && avb_stats_history_find(&h, 0u) == NULL;
+
+    /* Another monitor resets between the two snapshots */
+    avb_pcpu_slot(&s, 1)->v[AVB_STAT_TX_PACKETS] += 5;
+    avb_pcpu_stats_reset(&s);
+    avb_pcpu_slot(&s, 1)->v[AVB_STAT_TX_PACKETS] += 2;
+    avb_pcpu_slot(&s, 1)->v[AVB_STAT_OUTSTANDING_SEND_NBLS] -= 3;
+    avb_pcpu_stats_raw(&s, raw);
+    a = avb_stats_history_find(&h, first);
+    ok &= a != NULL;
+    if (a != NULL) {
+        avb_pcpu_stats_delta(raw, a->raw, out);
+        ok &= out[AVB_STAT_TX_PACKETS] == 7u;               /* 5 + 2: the reset is invisible */
+        ok &= out[AVB_STAT_OUTSTANDING_SEND_NBLS] == 1u;    /* gauges: the live value */
+    }
+    avb_pcpu_stats_values(&s, raw, out);
+    ok &= out[AVB_STAT_TX_PACKETS] == 2u && s.resets == 1u;
+    b = avb_stats_history_add(&h, raw, 2000u, 1u);
+    ok &= b->generation == first + 1u;
+
+    /* A full history later the first base is gone, the last ones remain */
+    for (i = 0; i < AVB_STATS_HISTORY; i++) {
+        b = avb_stats_history_add(&h, raw, 3000u + i, 1u);
+    }
+    ok &= avb_stats_history_find(&h, first) == NULL && avb_stats_history_find(&h, first + 1u) == NULL;
+    ok &= avb_stats_history_find(&h, b->generation) == b;
+    ok &= avb_stats_history_find(&h, b->generation - (AVB_STATS_HISTORY - 1u)) != NULL;
+    ok &= avb_stats_history_find(&h, b->generation + 1u) == NULL;
+
+    free(storage);
+    return ok;
+}
+
+int main(void)
+{
+    double shared[THREAD_STEPS], pcpu[THREAD_STEPS];
+    uint32_t cpus = host_cpus(), k, rep;
+    int exact = 1, ok, faster = 1, compared = 0;
+
+    printf("========================================================================\n");
+    printf("TEST-PERF-PCPU-STATS-001: shared vs. per-CPU statistics counters\n");
+    printf("Verifies: REQ-F-STATISTICS-001\n");
+    printf("========================================================================\n");
+    printf("\n  host processors: %u, %u packets per thread, 4 counter updates per packet\n\n",
+           cpus, PACKETS);
+    printf("  threads   shared ns/pkt   per-CPU ns/pkt   ratio\n");
+
+    for (k = 0; k < THREAD_STEPS; k++) {
+        shared[k] = pcpu[k] = 1e300;
+        for (rep = 0; rep < REPEATS; rep++) {
+            double a, b;
+            a = run(s_threads[k], 0, &ok);
+            exact &= ok;
+            b = run(s_threads[k], 1, &ok);
+            exact &= ok;
+            if (a < shared[k]) shared[k] = a;
+            if (b < pcpu[k])   pcpu[k]   = b;
+        }
+        printf("  %7u   %13.2f   %14.2f   %5.2fx\n", s_threads[k], shared[k], pcpu[k],
+               pcpu[k] > 0.0 ? shared[k] / pcpu[k] : 0.0);
+        if (cpus >= 2u && s_threads[k] >= 2u && s_threads[k] <= cpus) {
+            compared = 1;
+            faster &= pcpu[k] <= shared[k] * SLACK;
+        }
+    }
+    printf("\n");
+
+    tc_result("TC-PERF-PCPU-001 exact totals at every thread count", exact);
+    tc_result("TC-PERF-PCPU-002 RESET restarts counters, gauges stay live", check_reset());
+    if (compared) {
+        tc_result("TC-PERF-PCPU-003 per-CPU no slower than shared", faster);
+    } else {
+        printf("  [INFO] TC-PERF-PCPU-003 not evaluated: one host processor\n");
+    }
+    tc_result("TC-PERF-PCPU-004 snapshot deltas across RESET, evicted bases missing", check_snapshots());
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_passed + s_failed);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    return s_failed ? 1 : 0;
+}
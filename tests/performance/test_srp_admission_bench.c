@@ -0,0 +1,201 @@
+/*
+ * TEST-PERF-SRP-ADMIT-001: SRP admission register/deregister benchmark
+ *
+ * Verifies: REQ-F-SRP-003 (SRP admission control and CBS derivation)
+ *
+ * Purpose:
+ *   Register and tear down thousands of SR streams through the admission
+ *   module the driver runs under srp_lock, deriving both class shapers after
+ *   every change exactly as the IOCTL path does.  Runs on the host - no
+ *   driver needed.
+ *
+ * Variants (same pseudo-random stream set, 2.5 Gb/s port):
+ *   rescan        recompute class aggregates and largest frame by walking
+ *                 every live stream after each change (what a table scan
+ *                 per IOCTL would cost)
+ *   incremental   avb_srp_admit / avb_srp_release + avb_srp_class_shaper
+ *
+ * Test Cases:
+ *   TC-PERF-SRP-001: both variants admit the same streams and end at zero
+ *   TC-PERF-SRP-002: incremental is faster than rescan at STREAMS live streams
+ *
+ * Build:
+ *   cl /nologo /O2 -I . -I src tests\performance\test_srp_admission_bench.c src\srp_admission.c
+ *   cc -O2 -I . -I src -o test_srp_admission_bench tests/performance/test_srp_admission_bench.c src/srp_admission.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "../../src/srp_admission.h"
+
+/* -------------------------------------------------------------------------
+ * Test Configuration
+ * ------------------------------------------------------------------------- */
+#define STREAMS      4096u           /* streams registered, then torn down */
+#define REPEATS      5u              /* best-of-N */
+#define PORT_BPS     2500000000ull
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+static void tc_result(const char *name, int passed)
+{
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static double now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+static uint32_t s_cls[STREAMS];
+static uint32_t s_frame[STREAMS];
+static uint64_t s_bw[STREAMS];
+static uint64_t s_reserved[STREAMS];
+static volatile uint32_t s_sink;
+
+/* Shaper derivation from a full walk of the live set */
+static void rescan_shapers(uint32_t *idle_a, uint32_t *idle_b, uint32_t *max_a)
+{
+    uint64_t sum[2] = { 0, 0 };
+    uint32_t i, m = 0;
+
+    for (i = 0; i < STREAMS; i++) {
+        if (s_reserved[i]) {
+            sum[s_cls[i]] += s_reserved[i];
+            if (s_cls[i] == 0 && s_frame[i] + AVB_SRP_FRAME_OVERHEAD_BYTES > m) {
+                m = s_frame[i] + AVB_SRP_FRAME_OVERHEAD_BYTES;
+            }
+        }
+    }
+    *idle_a = (uint32_t)((sum[0] + 7u) / 8u);
+    *idle_b = (uint32_t)((sum[1] + 7u) / 8u);
+    *max_a  = m;
+}
+
+/* Returns streams admitted; *leftover receives the aggregate after teardown */
+static uint32_t pass_rescan(uint64_t *leftover)
+{
+    uint64_t used = 0, need;
+    uint32_t i, admitted = 0, a, b, m;
+
+    for (i = 0; i < STREAMS; i++) {
+        need = avb_srp_stream_bps(s_cls[i], s_bw[i], s_frame[i]);
+        s_reserved[i] = 0;
+        if (need && used + need <= PORT_BPS / 100u * 75u) {
+            s_reserved[i] = need;
+            used += need;
+            admitted++;
+        }
+        rescan_shapers(&a, &b, &m);
+        s_sink += a + b + m;
+    }
+    for (i = 0; i < STREAMS; i++) {
+        used -= s_reserved[i];
+        s_reserved[i] = 0;
+        rescan_shapers(&a, &b, &m);
+        s_sink += a + b + m;
+    }
+    *leftover = used;
+    return admitted;
+}
+
+static uint32_t pass_incremental(uint64_t *leftover)
+{
+    avb_srp_admission_t adm;
+    uint32_t i, admitted = 0, idle, hi;
+
+    avb_srp_init(&adm, PORT_BPS);
+    for (i = 0; i < STREAMS; i++) {
+        s_reserved[i] = 0;
+        if (avb_srp_admit(&adm, s_cls[i], s_bw[i], s_frame[i], &s_reserved[i]) == AVB_SRP_OK) {
+            admitted++;
+        }
+        avb_srp_class_shaper(&adm, s_cls[i], &idle, &hi);
+        s_sink += idle + hi;
+    }
+    for (i = 0; i < STREAMS; i++) {
+        if (s_reserved[i]) {
+            avb_srp_release(&adm, s_cls[i], s_frame[i], s_reserved[i]);
+            s_reserved[i] = 0;
+        }
+        avb_srp_class_shaper(&adm, s_cls[i], &idle, &hi);
+        s_sink += idle + hi;
+    }
+    *leftover = adm.cls[0].reserved_bps + adm.cls[1].reserved_bps;
+    return admitted;
+}
+
+typedef uint32_t (*srp_pass_fn)(uint64_t *leftover);
+
+/* Best-of-REPEATS ns per register+deregister pair */
+static double measure(srp_pass_fn fn, uint32_t *admitted, uint64_t *leftover)
+{
+    double best = 1e300;
+    uint32_t rep;
+    for (rep = 0; rep < REPEATS; rep++) {
+        double t0 = now_ns();
+        *admitted = fn(leftover);
+        double dt = (now_ns() - t0) / (double)STREAMS;
+        if (dt < best) best = dt;
+    }
+    return best;
+}
+
+int main(void)
+{
+    uint32_t x = 0x2545F491u, i, n_rs, n_in;
+    uint64_t left_rs, left_in;
+    double t_rs, t_in;
+
+    printf("========================================================================\n");
+    printf("TEST-PERF-SRP-ADMIT-001: SRP admission register/deregister (%u streams)\n", STREAMS);
+    printf("Verifies: REQ-F-SRP-003\n");
+    printf("========================================================================\n");
+
+    /* Small audio-like streams so most of STREAMS fit in 75% of 2.5 Gb/s;
+     * all Class B so the rescan pass's single-sum limit matches the model */
+    for (i = 0; i < STREAMS; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        s_cls[i]   = 1;
+        s_frame[i] = 32u + x % 64u;
+        s_bw[i]    = 1;
+    }
+
+    t_rs = measure(pass_rescan,      &n_rs, &left_rs);
+    t_in = measure(pass_incremental, &n_in, &left_in);
+
+    printf("\n  %-14s %10s %10s %10s\n", "variant", "ns/stream", "admitted", "speedup");
+    printf("  %-14s %10.1f %10u %10s\n",   "rescan",      t_rs, n_rs, "1.00x");
+    printf("  %-14s %10.1f %10u %9.2fx\n", "incremental", t_in, n_in, t_rs / t_in);
+    printf("\n");
+
+    tc_result("TC-PERF-SRP-001 same admissions, aggregates back to zero",
+              n_rs == n_in && n_in > 0 && n_in < STREAMS && left_rs == 0 && left_in == 0);
+    tc_result("TC-PERF-SRP-002 incremental faster than rescan", t_in < t_rs);
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_passed + s_failed);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    return s_failed ? 1 : 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * TEST-PERF-PHC-DECODE-001: SYSTIM decode micro-benchmark
+ *
+ * Verifies: REQ-NF-PERF-PHC-001 (Division-free PHC read path)
+ *
+ * Purpose:
+ *   Measure the per-read cost of turning a raw I219 SYSTIMH/L pair into
+ *   nanoseconds, before and after the reciprocal decode in
+ *   devices/intel_systim_decode.h.  Runs on the host - no driver needed.
+ *
+ * Variants (each over the same pseudo-random SYSTIM sequence):
+ *   div-runtime   raw / d with d opaque to the compiler (the unoptimised /
+ *                 x86 _aulldiv cost the old code paid on debug/x86 builds)
+ *   div-const     raw / 200000 as the old code was written (x64 /O2 may
+ *                 already strength-reduce this)
+ *   reciprocal    intel_systim_scaled_to_ns() - what the driver now runs
+ *
+ * Test Cases:
+ *   TC-PERF-DECODE-001: reciprocal and division results agree (checksum)
+ *   TC-PERF-DECODE-002: reciprocal is not slower than div-runtime
+ *
+ * Build:
+ *   cl /nologo /O2 tests\performance\test_systim_decode_bench.c
+ *   cc -O2 -o test_systim_decode_bench tests/performance/test_systim_decode_bench.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "../../devices/intel_systim_decode.h"
+
+/* -------------------------------------------------------------------------
+ * Test Configuration
+ * ------------------------------------------------------------------------- */
+#define SAMPLES      4096u           /* fits in L1: measures ALU, not memory */
+#define ROUNDS       4000u           /* 16.4M decodes per variant */
+#define REPEATS      5u              /* best-of-N */
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+static void tc_result(const char *name, int passed)
+{
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static double now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+static uint64_t s_raw[SAMPLES];
+static volatile uint64_t s_divisor = INTEL_SYSTIM_I219_COUNTS_PER_NS;
+static volatile uint64_t s_sink;
+static const intel_systim_conv_t s_i219 = INTEL_SYSTIM_CONV_I219_INIT;
+
+typedef uint64_t (*decode_pass_fn)(void);
+
+static uint64_t pass_div_runtime(void)
+{
+    uint64_t d = s_divisor, acc = 0;
+    uint32_t i;
+    for (i = 0; i < SAMPLES; i++) acc += s_raw[i] / d;
+    return acc;
+}
+
+static uint64_t pass_div_const(void)
+{
+    uint64_t acc = 0;
+    uint32_t i;
+    for (i = 0; i < SAMPLES; i++) acc += s_raw[i] / 200000ULL;
+    return acc;
+}
+
+static uint64_t pass_reciprocal(void)
+{
+    uint64_t acc = 0;
+    uint32_t i;
+    for (i = 0; i < SAMPLES; i++) acc += intel_systim_scaled_to_ns(&s_i219, s_raw[i]);
+    return acc;
+}
+
+/* Best-of-REPEATS ns per decode; *checksum receives the last pass sum */
+static double measure(decode_pass_fn fn, uint64_t *checksum)
+{
+    double best = 1e300;
+    uint32_t rep, r;
+    for (rep = 0; rep < REPEATS; rep++) {
+        uint64_t acc = 0;
+        double t0 = now_ns();
+        for (r = 0; r < ROUNDS; r++) acc += fn();
+        double dt = (now_ns() - t0) / ((double)SAMPLES * ROUNDS);
+        s_sink = acc;
+        *checksum = acc;
+        if (dt < best) best = dt;
+    }
+    return best;
+}
+
+int main(void)
+{
+    uint64_t x = 0x9E3779B97F4A7C15ULL, c_rt, c_ct, c_rc;
+    uint32_t i;
+    double t_rt, t_ct, t_rc;
+
+    printf("========================================================================\n");
+    printf("TEST-PERF-PHC-DECODE-001: SYSTIM decode micro-benchmark (I219 scaled)\n");
+    printf("Verifies: REQ-NF-PERF-PHC-001\n");
+    printf("========================================================================\n");
+
+    for (i = 0; i < SAMPLES; i++) {
+        x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+        s_raw[i] = x * 0x2545F4914F6CDD1DULL;
+    }
+
+    t_rt = measure(pass_div_runtime, &c_rt);
+    t_ct = measure(pass_div_const,   &c_ct);
+    t_rc = measure(pass_reciprocal,  &c_rc);
+
+    printf("\n  %-14s %10s %10s\n", "variant", "ns/read", "speedup");
+    printf("  %-14s %10.3f %10s\n",   "div-runtime", t_rt, "1.00x");
+    printf("  %-14s %10.3f %9.2fx\n", "div-const",   t_ct, t_rt / t_ct);
+    printf("  %-14s %10.3f %9.2fx\n", "reciprocal",  t_rc, t_rt / t_rc);
+    printf("\n");
+
+    tc_result("TC-PERF-DECODE-001 reciprocal checksum == division checksum",
+              c_rc == c_rt && c_rc == c_ct);
+    /* 10% slack absorbs timer noise on machines where both are ~1 ns */
+    tc_result("TC-PERF-DECODE-002 reciprocal not slower than div-runtime",
+              t_rc <= t_rt * 1.10);
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_passed + s_failed);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    return s_failed ? 1 : 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * TEST-PERF-TAS-ANALYSIS-001: Qbv schedule analysis throughput
+ *
+ * Verifies: REQ-F-TAS-002 (TAS schedule compilation and validation)
+ *
+ * Purpose:
+ *   A design search with tas_analyze compiles and analyzes thousands of
+ *   candidate schedules per run.  Time compile + analysis of a candidate set
+ *   (8 queues, up to 16 entries, SR classes under CBS, 2.5 Gb/s) and check
+ *   the whole set completes within a few milliseconds.  Runs on the host -
+ *   no driver needed.
+ *
+ * Test Cases:
+ *   TC-PERF-TAS-AN-001: repeated passes give identical reports
+ *   TC-PERF-TAS-AN-002: CANDIDATES schedules in less than BUDGET_MS
+ *
+ * Build:
+ *   cl /nologo /O2 tests\performance\test_tas_analysis_bench.c tools\tas_analyzer\tas_analysis.c src\tas_gcl.c
+ *   cc -O2 -o test_tas_analysis_bench tests/performance/test_tas_analysis_bench.c tools/tas_analyzer/tas_analysis.c src/tas_gcl.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "../../tools/tas_analyzer/tas_analysis.h"
+
+/* -------------------------------------------------------------------------
+ * Test Configuration
+ * ------------------------------------------------------------------------- */
+#define CANDIDATES   4096u           /* schedules per pass */
+#define ENTRIES      16u
+#define REPEATS      5u              /* best-of-N */
+#define BUDGET_MS    50.0
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+static void tc_result(const char *name, int passed)
+{
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static double now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+static uint8_t  s_gates[CANDIDATES][ENTRIES];
+static uint32_t s_dur[CANDIDATES][ENTRIES];
+static uint32_t s_n[CANDIDATES];
+
+/* Returns a checksum over every report; *analyzed receives the schedules that compiled */
+static uint64_t pass(const avb_tas_caps_t *caps, const avb_tas_qos_t *qos, uint32_t *analyzed)
+{
+    avb_tas_schedule_t s;
+    avb_tas_report_t r;
+    uint64_t sum = 0;
+    uint32_t i, q;
+
+    *analyzed = 0;
+    for (i = 0; i < CANDIDATES; i++) {
+        if (avb_tas_compile(caps, NULL, s_gates[i], s_dur[i], s_n[i], 0, &s, NULL) != AVB_TAS_OK) {
+            continue;
+        }
+        avb_tas_analyze(&s, qos, &r);
+        (*analyzed)++;
+        for (q = 0; q < r.queues; q++) {
+            sum = sum * 31u + r.q[q].guaranteed_bps + r.q[q].worst_delay_ns + r.q[q].guard_band_ns;
+        }
+    }
+    return sum;
+}
+
+int main(void)
+{
+    avb_tas_caps_t caps = { AVB_TAS_MAX_QUEUES, AVB_TAS_MAX_ENTRIES, 0, 1000000000u, 0, 1 };
+    avb_tas_qos_t qos;
+    uint32_t x = 0x7F4A7C15u, i, k, analyzed = 0, rep, same = 1;
+    uint64_t first = 0;
+    double best = 1e300;
+
+    printf("========================================================================\n");
+    printf("TEST-PERF-TAS-ANALYSIS-001: compile + analyze %u candidate schedules\n", CANDIDATES);
+    printf("Verifies: REQ-F-TAS-002\n");
+    printf("========================================================================\n");
+
+    memset(&qos, 0, sizeof(qos));
+    qos.link_bps = 2500000000ull;
+    for (k = 0; k < AVB_TAS_MAX_QUEUES; k++) {
+        qos.frame_bytes[k] = (k < 2u) ? 300u + 300u * k : 1542u;
+    }
+    qos.idle_slope_Bps[0] = 25000000u;      /* Class A 200 Mb/s */
+    qos.idle_slope_Bps[1] = 12500000u;      /* Class B 100 Mb/s */
+
+    for (i = 0; i < CANDIDATES; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        s_n[i] = 2u + x % (ENTRIES - 1u);
+        for (k = 0; k < s_n[i]; k++) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            s_gates[i][k] = (uint8_t)x;
+            s_dur[i][k]   = 2000u + (x >> 8) % 60000u;
+        }
+    }
+
+    for (rep = 0; rep < REPEATS; rep++) {
+        double t0 = now_ns(), dt;
+        uint64_t sum = pass(&caps, &qos, &analyzed);
+        dt = (now_ns() - t0) / 1e6;
+        if (rep == 0) {
+            first = sum;
+        } else if (sum != first) {
+            same = 0;
+        }
+        if (dt < best) best = dt;
+    }
+
+    printf("\n  %u schedules analyzed: %.3f ms per pass, %.1f us per schedule\n\n",
+           analyzed, best, best * 1000.0 / CANDIDATES);
+
+    tc_result("TC-PERF-TAS-AN-001 identical reports across passes", same && analyzed == CANDIDATES);
+    tc_result("TC-PERF-TAS-AN-002 candidate set within budget", best < BUDGET_MS);
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_passed + s_failed);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    return s_failed ? 1 : 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * TEST-PERF-TAS-GCL-001: Qbv GCL compile / validate benchmark
+ *
+ * Verifies: REQ-F-TAS-002 (TAS schedule compilation and validation)
+ *
+ * Purpose:
+ *   Compile a large set of pseudo-random 8-entry GCLs through the validator
+ *   the driver runs in IOCTL_AVB_SETUP_TAS (I225/I226 capabilities, SR class
+ *   traffic on queues 0/1 at 2.5 Gb/s), and through the path setup_tas
+ *   takes - the same compiler without a traffic model, then the I225/I226
+ *   register encoding in devices/intel_qbv.h.  Runs on the host - no
+ *   driver needed.
+ *
+ * Test Cases:
+ *   TC-PERF-TAS-001: the validator accepts only schedules intel_qbv_encode can program
+ *   TC-PERF-TAS-002: validation costs less than BUDGET_NS per schedule
+ *
+ * Build:
+ *   cl /nologo /O2 -I . -I src tests\performance\test_tas_gcl_bench.c src\tas_gcl.c
+ *   cc -O2 -I . -I src -o test_tas_gcl_bench tests/performance/test_tas_gcl_bench.c src/tas_gcl.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "../../src/tas_gcl.h"
+#include "../../devices/intel_qbv.h"
+
+/* -------------------------------------------------------------------------
+ * Test Configuration
+ * ------------------------------------------------------------------------- */
+#define SCHEDULES    16384u          /* random GCLs per pass */
+#define ENTRIES      8u
+#define REPEATS      5u              /* best-of-N */
+#define BUDGET_NS    2000.0          /* per schedule; SETUP_TAS runs it once per IOCTL */
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+static void tc_result(const char *name, int passed)
+{
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static double now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+static uint8_t  s_gates[SCHEDULES][ENTRIES];
+static uint32_t s_dur[SCHEDULES][ENTRIES];
+static uint64_t s_cycle[SCHEDULES];
+static uint8_t  s_ok_tas[SCHEDULES];
+static uint8_t  s_ok_qbv[SCHEDULES];
+
+/* Returns schedules accepted */
+static uint32_t pass_tas(void)
+{
+    avb_tas_caps_t caps;
+    avb_tas_traffic_t tr;
+    avb_tas_schedule_t s;
+    uint32_t i, ok = 0;
+
+    avb_tas_caps_i225(&caps);
+    memset(&tr, 0, sizeof(tr));
+    tr.link_bps = 2500000000ull;
+    tr.max_frame_bytes[0] = 300;    /* Class A: small audio frames incl. 42 B framing */
+    tr.max_frame_bytes[1] = 600;
+    for (i = 0; i < SCHEDULES; i++) {
+        s_ok_tas[i] = (uint8_t)(avb_tas_compile(&caps, &tr, s_gates[i], s_dur[i], ENTRIES, s_cycle[i],
+                                                &s, NULL) == AVB_TAS_OK);
+        ok += s_ok_tas[i];
+    }
+    return ok;
+}
+
+static uint32_t pass_qbv(void)
+{
+    avb_tas_caps_t caps;
+    avb_tas_schedule_t s;
+    struct intel_qbv_regs r;
+    uint32_t i, ok = 0;
+
+    avb_tas_caps_i225(&caps);
+    for (i = 0; i < SCHEDULES; i++) {
+        s_ok_qbv[i] = (uint8_t)(avb_tas_compile(&caps, NULL, s_gates[i], s_dur[i], ENTRIES, s_cycle[i],
+                                                &s, NULL) == AVB_TAS_OK &&
+                                intel_qbv_encode(&s, 0, 0, &r) == INTEL_QBV_OK);
+        ok += s_ok_qbv[i];
+    }
+    return ok;
+}
+
+typedef uint32_t (*gcl_pass_fn)(void);
+
+/* Best-of-REPEATS ns per schedule */
+static double measure(gcl_pass_fn fn, uint32_t *accepted)
+{
+    double best = 1e300;
+    uint32_t rep;
+    for (rep = 0; rep < REPEATS; rep++) {
+        double t0 = now_ns();
+        *accepted = fn();
+        double dt = (now_ns() - t0) / (double)SCHEDULES;
+        if (dt < best) best = dt;
+    }
+    return best;
+}
+
+int main(void)
+{
+    uint32_t x = 0x9E3779B9u, i, k, n_tas, n_qbv, agree = 1, tas_only = 0;
+    double t_tas, t_qbv;
+
+    printf("========================================================================\n");
+    printf("TEST-PERF-TAS-GCL-001: Qbv GCL compile / validate (%u schedules)\n", SCHEDULES);
+    printf("Verifies: REQ-F-TAS-002\n");
+    printf("========================================================================\n");
+
+    /* Gate masks from a few run-shaped patterns so a good share is valid on I225 */
+    for (i = 0; i < SCHEDULES; i++) {
+        uint64_t sum = 0;
+        uint32_t shaped;
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        shaped = x & 3u;
+        for (k = 0; k < ENTRIES; k++) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            s_gates[i][k] = (uint8_t)((shaped == 1u) ? (0x0Fu >> (k / 2u)) :
+                                      (shaped != 0u) ? (0x01u << (k / 2u)) : (x & 0x0Fu));
+            s_dur[i][k]   = 200u + x % 8000u;
+            sum += s_dur[i][k];
+        }
+        s_cycle[i] = (x & 0x10000u) ? 0 : sum + x % 4096u;
+    }
+
+    t_tas = measure(pass_tas, &n_tas);
+    t_qbv = measure(pass_qbv, &n_qbv);
+
+    /* setup_tas has no traffic model: it may accept more, never less */
+    for (i = 0; i < SCHEDULES; i++) {
+        if (s_ok_tas[i] && !s_ok_qbv[i]) {
+            agree = 0;
+        }
+        tas_only += (!s_ok_tas[i] && s_ok_qbv[i]);
+    }
+
+    printf("\n  %-22s %10s %10s\n", "variant", "ns/sched", "accepted");
+    printf("  %-22s %10.1f %10u\n", "avb_tas_compile", t_tas, n_tas);
+    printf("  %-22s %10.1f %10u\n", "compile + encode", t_qbv, n_qbv);
+    printf("  rejected by guard band / starvation only: %u\n\n", tas_only);
+
+    tc_result("TC-PERF-TAS-001 validator accepts only what the I225 encoder can program",
+              agree && n_tas > 0 && n_tas < SCHEDULES);
+    tc_result("TC-PERF-TAS-002 validation within budget per schedule", t_tas < BUDGET_NS);
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_passed + s_failed);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    return s_failed ? 1 : 0;
+}
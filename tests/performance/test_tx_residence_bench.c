@@ -0,0 +1,245 @@
+/*
+ * TEST-PERF-TXRES-001: TX residence sampling rules and per-frame cost
+ *
+ * Verifies: REQ-F-STATISTICS-005 (TX residence latency per priority)
+ *
+ * Purpose:
+ *   With IOCTL_AVB_TX_RESIDENCE sampling on, FilterSendNetBufferLists asks
+ *   src/tx_residence.c about every frame it hands to the miniport, and the
+ *   send-complete of a stamped frame records one sample into its
+ *   priority's histogram.  Check the header parse (untagged, 802.1Q and
+ *   802.1ad tags, short buffers), the match rules (priority mask,
+ *   EtherType, exactly one in sample_every), and time one decision plus
+ *   one record against a budget - the per-frame price of leaving sampling
+ *   on while shaping is validated.  Runs on the host - no driver needed.
+ *
+ * Test Cases:
+ *   TC-PERF-TXRES-001: EtherType and PCP from untagged / tagged / short headers
+ *   TC-PERF-TXRES-002: priority mask, EtherType filter, exact 1-in-N, configure resets
+ *   TC-PERF-TXRES-003: parse + select + record in less than BUDGET_NS per frame
+ *
+ * Build:
+ *   cl /nologo /O2 -I src tests\performance\test_tx_residence_bench.c src\tx_residence.c src\lat_hist.c
+ *   cc -O2 -I src -o test_tx_residence_bench tests/performance/test_tx_residence_bench.c src/tx_residence.c src/lat_hist.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "tx_residence.h"
+#include "lat_hist.h"
+
+/* -------------------------------------------------------------------------
+ * Test Configuration
+ * ------------------------------------------------------------------------- */
+#define FRAMES          1000000u
+#define REPEATS         5u              /* best-of-N */
+#define BUDGET_NS       25.0            /* TC-003: parse + select + record, one frame */
+
+static int s_passed = 0;
+static int s_failed = 0;
+static volatile uint64_t s_sink;        /* keeps the timed loops */
+
+static void tc_result(const char *name, int passed)
+{
+    if (passed) { s_passed++; printf("  [PASS] %s\n", name); }
+    else        { s_failed++; printf("  [FAIL] %s\n", name); }
+}
+
+static double now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+/* The driver's InterlockedIncrement64 */
+static void atomic_inc(volatile int64_t *p)
+{
+#ifdef _WIN32
+    InterlockedIncrement64((volatile LONG64 *)p);
+#else
+    __atomic_fetch_add(p, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static uint32_t xorshift(uint32_t *x)
+{
+    *x ^= *x << 13; *x ^= *x >> 17; *x ^= *x << 5;
+    return *x;
+}
+
+/* Ethernet header, optionally with one tag (tpid 0: untagged); returns the length */
+static uint32_t make_hdr(uint8_t *h, uint32_t tpid, uint32_t pcp, uint32_t ethertype)
+{
+    uint32_t n = 12u;
+
+    memset(h, 0xA5, 12);
+    if (tpid != 0u) {
+        h[n++] = (uint8_t)(tpid >> 8);
+        h[n++] = (uint8_t)tpid;
+        h[n++] = (uint8_t)((pcp << 5) | 0x01u);     /* DEI 0, VID 0x1xx */
+        h[n++] = 0x23;
+    }
+    h[n++] = (uint8_t)(ethertype >> 8);
+    h[n++] = (uint8_t)ethertype;
+    return n;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-001: header parse
+ * ------------------------------------------------------------------------- */
+static int check_parse(void)
+{
+    uint8_t h[AVB_TXRES_PARSE_LEN];
+    uint32_t len, pcp;
+    int ok = 1;
+
+    /* Untagged: the OOB priority stands */
+    len = make_hdr(h, 0, 0, 0x88F7u);
+    pcp = 6;
+    ok &= avb_txres_parse(h, len, &pcp) == 0x88F7u && pcp == 6u;
+
+    /* 802.1Q and 802.1ad tags: the in-frame PCP wins */
+    len = make_hdr(h, AVB_TXRES_TPID_8021Q, 3, 0x22F0u);
+    pcp = 0;
+    ok &= avb_txres_parse(h, len, &pcp) == 0x22F0u && pcp == 3u;
+    len = make_hdr(h, AVB_TXRES_TPID_8021AD, 7, 0x0800u);
+    pcp = 0;
+    ok &= avb_txres_parse(h, len, &pcp) == 0x0800u && pcp == 7u;
+
+    /* Tagged but only 14 bytes mapped: the TPID is all there is */
+    make_hdr(h, AVB_TXRES_TPID_8021Q, 5, 0x22F0u);
+    pcp = 1;
+    ok &= avb_txres_parse(h, 14u, &pcp) == AVB_TXRES_TPID_8021Q && pcp == 1u;
+
+    /* Shorter than a header */
+    ok &= avb_txres_parse(h, 13u, &pcp) == 0u;
+    return ok;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-002: match rules
+ * ------------------------------------------------------------------------- */
+static int check_select(void)
+{
+    avb_txres_filter_t f;
+    uint32_t i, hits;
+    int ok = 1;
+
+    avb_txres_init(&f);
+    for (i = 0; i < AVB_TXRES_CLASSES; i++) {
+        ok &= avb_txres_select(&f, i, 0x22F0u) == 0;    /* off */
+    }
+
+    /* Class A / B (PCP 3 and 2), any EtherType, every frame */
+    avb_txres_configure(&f, (1u << 3) | (1u << 2), 0, 0);
+    ok &= f.sample_every == 1u;
+    ok &= avb_txres_select(&f, 3, 0x22F0u) == 1 && avb_txres_select(&f, 2, 0x0800u) == 1;
+    ok &= avb_txres_select(&f, 0, 0x22F0u) == 0 && avb_txres_select(&f, 7, 0x88F7u) == 0;
+
+    /* EtherType filter */
+    avb_txres_configure(&f, 0xFFu, 0x22F0u, 1);
+    ok &= avb_txres_select(&f, 0, 0x22F0u) == 1 && avb_txres_select(&f, 0, 0x0800u) == 0;
+
+    /* Priority bits above 7 dropped */
+    avb_txres_configure(&f, 0x300u, 0, 1);
+    ok &= f.pcp_mask == 0u;
+
+    /* 1 in 7: exactly 1000 of 7000 matching frames, non-matching ones not counted */
+    avb_txres_configure(&f, 1u << 3, 0x22F0u, 7);
+    hits = 0;
+    for (i = 0; i < 7000u; i++) {
+        hits += (uint32_t)avb_txres_select(&f, 3, 0x22F0u);
+        hits += (uint32_t)avb_txres_select(&f, 4, 0x22F0u);
+        hits += (uint32_t)avb_txres_select(&f, 3, 0x0800u);
+    }
+    ok &= hits == 1000u;
+
+    /* Reconfiguring restarts the count */
+    avb_txres_configure(&f, 1u << 3, 0, 2);
+    ok &= avb_txres_select(&f, 3, 0) == 0 && avb_txres_select(&f, 3, 0) == 1;
+    return ok;
+}
+
+/* -------------------------------------------------------------------------
+ * TC-003: cost per frame
+ * ------------------------------------------------------------------------- */
+static double time_frames(avb_txres_filter_t *f, avb_lat_set_t *set, avb_lat_hist_t *hist,
+                          uint8_t (*hdrs)[AVB_TXRES_PARSE_LEN], uint32_t nhdrs)
+{
+    uint32_t x = 0x6C8E9CF5u, i, hits = 0;
+    double t0 = now_ns();
+
+    for (i = 0; i < FRAMES; i++) {
+        uint32_t pcp = 0, et = avb_txres_parse(hdrs[i % nhdrs], AVB_TXRES_PARSE_LEN, &pcp);
+        if (avb_txres_select(f, pcp, et)) {
+            /* The completion side: spans of 0..~1 ms in TSC ticks */
+            atomic_inc(&hist[pcp].b[avb_lat_index(avb_lat_ns(set, xorshift(&x) >> 10))]);
+            hits++;
+        }
+    }
+    s_sink += hits;
+    return (now_ns() - t0) / FRAMES;
+}
+
+int main(void)
+{
+    static uint8_t hdrs[16][AVB_TXRES_PARSE_LEN];
+    avb_lat_hist_t *hist;
+    avb_txres_filter_t f;
+    avb_lat_set_t set;
+    double best = 1e300;
+    uint32_t i, rep;
+
+    printf("========================================================================\n");
+    printf("TEST-PERF-TXRES-001: TX residence sampling rules and per-frame cost\n");
+    printf("Verifies: REQ-F-STATISTICS-005\n");
+    printf("========================================================================\n\n");
+
+    tc_result("TC-PERF-TXRES-001 EtherType / PCP from the frame header", check_parse());
+    tc_result("TC-PERF-TXRES-002 priority mask, EtherType filter, exact 1-in-N", check_select());
+
+    /* Mixed traffic: AVTP class A / B, gPTP, untagged IPv4 */
+    for (i = 0; i < 16u; i++) {
+        switch (i % 4u) {
+        case 0:  make_hdr(hdrs[i], AVB_TXRES_TPID_8021Q, 3, 0x22F0u); break;
+        case 1:  make_hdr(hdrs[i], AVB_TXRES_TPID_8021Q, 2, 0x22F0u); break;
+        case 2:  make_hdr(hdrs[i], 0, 0, 0x88F7u); break;
+        default: make_hdr(hdrs[i], 0, 0, 0x0800u); break;
+        }
+    }
+    hist = (avb_lat_hist_t *)calloc(AVB_TXRES_CLASSES, sizeof(*hist));
+    if (hist == NULL) return 1;
+    avb_lat_set_init(&set, NULL, 0, 3000000000ull);     /* ns scaling only, no per-CPU storage */
+    avb_txres_configure(&f, (1u << 3) | (1u << 2), 0x22F0u, 1);
+    for (rep = 0; rep < REPEATS; rep++) {
+        double t = time_frames(&f, &set, hist, hdrs, 16u);
+        if (t < best) best = t;
+    }
+    free(hist);
+    printf("\n  parse + select (+ record for half the frames): %.2f ns/frame\n\n", best);
+    tc_result("TC-PERF-TXRES-003 per-frame cost within budget", best < BUDGET_NS);
+
+    printf("\n========================================================================\n");
+    printf("Results: %d/%d passed", s_passed, s_passed + s_failed);
+    if (s_failed) printf(", %d FAILED", s_failed);
+    printf("\n========================================================================\n");
+    return s_failed ? 1 : 0;
+}
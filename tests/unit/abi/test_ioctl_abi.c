@@ -25,6 +25,26 @@
  *   TC-ABI-015: sizeof(AVB_TS_SUBSCRIBE_REQUEST) == 16  (uint32 + uint16 + 2 x uint8 + 2 x uint32)
  *   TC-ABI-016: sizeof(AVB_QAV_REQUEST) == 24       (uint8 + uint8[3] + 5 x uint32)
  *   TC-ABI-017: sizeof(AVB_TS_UNSUBSCRIBE_REQUEST) == 8 (2 x uint32)
+ *   TC-ABI-018: sizeof(AVB_DRIVER_STATISTICS) == 192 (24 x uint64)
+ *   TC-ABI-019: sizeof(AVB_PHC_MULTI_SNAPSHOT_REQUEST) == 280 (8 x 32-byte entries)
+ *   TC-ABI-020: sizeof(AVB_PHC_HOLDOVER_REQUEST) == 80
+ *   TC-ABI-021: sizeof(AVB_PERIODIC_OUTPUT_REQUEST) == 48
+ *   TC-ABI-022: sizeof(AVB_PERIODIC_OUTPUT_STATS_REQUEST) == 128
+ *   TC-ABI-023: sizeof(AVB_AUX_CAPTURE_REQUEST) == 64
+ *   TC-ABI-024: sizeof(AVB_SRP_REGISTER_REQUEST) == 32, over-subscription status pinned
+ *   TC-ABI-025: sizeof(AVB_SRP_STREAM_ENTRY) == 24, sizeof(AVB_SRP_ENUM_REQUEST) == 416
+ *   TC-ABI-026: sizeof(AVB_TAS_STATE_REQUEST) == 80
+ *   TC-ABI-027: sizeof(AVB_LAUNCH_TIME_CONFIG_REQUEST) == 80
+ *   TC-ABI-028: sizeof(AVB_LAUNCH_PACER_REQUEST) == 240
+ *   TC-ABI-029: sizeof(AVB_FP_STATS_REQUEST) == 144
+ *   TC-ABI-030: sizeof(AVB_LAT_HIST_REQUEST) == 7848
+ *   TC-ABI-031: sizeof(AVB_TRACE_REQUEST) == 48, sizeof(AVB_TRACE_RECORD) == 48
+ *   TC-ABI-032: sizeof(AVB_STATS_SNAPSHOT_REQUEST) == 264
+ *   TC-ABI-033: sizeof(AVB_HW_STATS_REQUEST) == 64, sizeof(AVB_HW_STATS_PAGE) == 384
+ *   TC-ABI-034: sizeof(AVB_MMIO_ACCT_REQUEST) == 1176
+ *   TC-ABI-035: sizeof(AVB_TEST_POOL_REQUEST) == 80
+ *   TC-ABI-036: sizeof(AVB_PKTGEN_REQUEST) == 304
+ *   TC-ABI-037: sizeof(AVB_TX_RES_REQUEST) == 576, sizeof(AVB_TX_RES_CLASS) == 64
  *
  * CI-safe: No hardware access, no driver device handle, no DeviceIoControl.
  * Requires only: avb_ioctl.h (user-mode) and its dependencies from intel_avb.
@@ -37,6 +57,7 @@
 #include <winioctl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "avb_ioctl.h"
@@ -113,6 +134,26 @@ static void test_ioctl_uniqueness(void)
         IOCTL_AVB_SET_PORT_LATENCY,
         IOCTL_AVB_GET_STATISTICS,
         IOCTL_AVB_RESET_STATISTICS,
+        IOCTL_AVB_PHC_CROSSTIMESTAMP,
+        IOCTL_AVB_SET_LAUNCH_TIME,
+        IOCTL_AVB_PHC_MULTI_SNAPSHOT,
+        IOCTL_AVB_PHC_HOLDOVER,
+        IOCTL_AVB_SET_PERIODIC_OUTPUT,
+        IOCTL_AVB_GET_PERIODIC_OUTPUT_STATS,
+        IOCTL_AVB_AUX_CAPTURE,
+        IOCTL_AVB_SRP_ENUM_STREAMS,
+        IOCTL_AVB_TAS_GET_STATE,
+        IOCTL_AVB_LAUNCH_TIME_CONFIG,
+        IOCTL_AVB_LAUNCH_PACER,
+        IOCTL_AVB_GET_FP_STATS,
+        IOCTL_AVB_GET_LAT_HIST,
+        IOCTL_AVB_TRACE,
+        IOCTL_AVB_STATS_SNAPSHOT,
+        IOCTL_AVB_HW_STATS,
+        IOCTL_AVB_MMIO_ACCT,
+        IOCTL_AVB_TEST_POOL,
+        IOCTL_AVB_PKTGEN,
+        IOCTL_AVB_TX_RESIDENCE,
     };
     int n = (int)(sizeof(codes) / sizeof(codes[0]));
     int duplicates = 0;
@@ -276,6 +317,128 @@ static void test_struct_sizes(void)
     TEST_CASE("TC-ABI-018: sizeof(AVB_DRIVER_STATISTICS) == 192");
     TEST_ASSERT(sizeof(AVB_DRIVER_STATISTICS) == 192,
                 "sizeof(AVB_DRIVER_STATISTICS) == 192  (24 x avb_u64, ABI 2.0)");
+
+    /* TC-ABI-019 ------------------------------------------------------------ */
+    /* entry: 2 x uint16 + uint32 + 3 x uint64 = 32.                         */
+    /* request: 2 x uint32 + uint64 + 8 x entry(32) + 2 x uint32 = 280.     */
+    TEST_CASE("TC-ABI-019: sizeof(AVB_PHC_MULTI_SNAPSHOT_REQUEST) == 280");
+    TEST_ASSERT(sizeof(AVB_PHC_SNAPSHOT_ENTRY) == 32,
+                "sizeof(AVB_PHC_SNAPSHOT_ENTRY) == 32  (vid,did,valid,phc,qpc_before,qpc_after)");
+    TEST_ASSERT(sizeof(AVB_PHC_MULTI_SNAPSHOT_REQUEST) == 280,
+                "sizeof(AVB_PHC_MULTI_SNAPSHOT_REQUEST) == 280  (count,total,freq,entries[8],status,reserved)");
+
+    /* TC-ABI-020 ------------------------------------------------------------ */
+    /* 6 x uint32 (cmd..applied_timinca) + 6 x uint64 + status + reserved = 80 */
+    TEST_CASE("TC-ABI-020: sizeof(AVB_PHC_HOLDOVER_REQUEST) == 80");
+    TEST_ASSERT(sizeof(AVB_PHC_HOLDOVER_REQUEST) == 80,
+                "sizeof(AVB_PHC_HOLDOVER_REQUEST) == 80  (6 x u32, 6 x u64, status, reserved)");
+
+    /* TC-ABI-021 ------------------------------------------------------------ */
+    /* 4 x uint32 (channel..measure_sdp_pin) + 3 x uint64 + mode + status = 48 */
+    TEST_CASE("TC-ABI-021: sizeof(AVB_PERIODIC_OUTPUT_REQUEST) == 48");
+    TEST_ASSERT(sizeof(AVB_PERIODIC_OUTPUT_REQUEST) == 48,
+                "sizeof(AVB_PERIODIC_OUTPUT_REQUEST) == 48  (4 x u32, 3 x u64, mode, status)");
+
+    /* TC-ABI-022 ------------------------------------------------------------ */
+    /* 6 x uint32 + 12 x 64-bit counters/errors + status + reserved = 128 */
+    TEST_CASE("TC-ABI-022: sizeof(AVB_PERIODIC_OUTPUT_STATS_REQUEST) == 128");
+    TEST_ASSERT(sizeof(AVB_PERIODIC_OUTPUT_STATS_REQUEST) == 128,
+                "sizeof(AVB_PERIODIC_OUTPUT_STATS_REQUEST) == 128  (6 x u32, 12 x 64-bit, status, reserved)");
+
+    /* TC-ABI-023 ------------------------------------------------------------ */
+    /* 4 x uint32 (channel..active) + 5 x uint64 + status + reserved = 64 */
+    TEST_CASE("TC-ABI-023: sizeof(AVB_AUX_CAPTURE_REQUEST) == 64");
+    TEST_ASSERT(sizeof(AVB_AUX_CAPTURE_REQUEST) == 64,
+                "sizeof(AVB_AUX_CAPTURE_REQUEST) == 64  (4 x u32, 5 x u64, status, reserved)");
+
+    /* TS_EVENT_AUX_TIMESTAMP reuses AVB_TIMESTAMP_EVENT fields; layout unchanged */
+    TEST_ASSERT(sizeof(AVB_TIMESTAMP_EVENT) == 32,
+                "sizeof(AVB_TIMESTAMP_EVENT) == 32  (AUX edge/overrun accessors add no fields)");
+
+    /* TC-ABI-024 ------------------------------------------------------------ */
+    /* stream_id + bandwidth + vlan/pcp/class/frame/pad + handle/reserved_bw/status */
+    TEST_CASE("TC-ABI-024: sizeof(AVB_SRP_REGISTER_REQUEST) == 32");
+    TEST_ASSERT(sizeof(AVB_SRP_REGISTER_REQUEST) == 32,
+                "sizeof(AVB_SRP_REGISTER_REQUEST) == 32  (admission adds no fields)");
+    TEST_ASSERT(AVB_SRP_STATUS_BANDWIDTH_EXCEEDED == 0xE0020001u,
+                "AVB_SRP_STATUS_BANDWIDTH_EXCEEDED == 0xE0020001");
+
+    /* TC-ABI-025 ------------------------------------------------------------ */
+    /* 8 header u32 + 16 x (u64 id + 3 x u32 + u16 + 2 x u8) */
+    TEST_CASE("TC-ABI-025: SRP enumeration page layout");
+    TEST_ASSERT(sizeof(AVB_SRP_STREAM_ENTRY) == 24,
+                "sizeof(AVB_SRP_STREAM_ENTRY) == 24");
+    TEST_ASSERT(AVB_SRP_ENUM_PAGE == 16u, "AVB_SRP_ENUM_PAGE == 16");
+    TEST_ASSERT(sizeof(AVB_SRP_ENUM_REQUEST) == 416,
+                "sizeof(AVB_SRP_ENUM_REQUEST) == 416  (32-byte header + 16 entries)");
+
+    /* TC-ABI-026 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-026: sizeof(AVB_TAS_STATE_REQUEST) == 80");
+    TEST_ASSERT(sizeof(AVB_TAS_STATE_REQUEST) == 80,
+                "sizeof(AVB_TAS_STATE_REQUEST) == 80  (6 x u64, 5 x u32, status, reserved[2])");
+
+    /* TC-ABI-027 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-027: sizeof(AVB_LAUNCH_TIME_CONFIG_REQUEST) == 80");
+    TEST_ASSERT(sizeof(AVB_LAUNCH_TIME_CONFIG_REQUEST) == 80,
+                "sizeof(AVB_LAUNCH_TIME_CONFIG_REQUEST) == 80  (4 x u32, 7 x u64, status, reserved)");
+
+    /* TC-ABI-028 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-028: sizeof(AVB_LAUNCH_PACER_REQUEST) == 240");
+    TEST_ASSERT(sizeof(AVB_LAUNCH_PACER_REQUEST) == 240,
+                "sizeof(AVB_LAUNCH_PACER_REQUEST) == 240  (8 x u32, 9 x u64, hist[16], status, reserved)");
+
+    /* TC-ABI-029 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-029: sizeof(AVB_FP_STATS_REQUEST) == 144");
+    TEST_ASSERT(sizeof(AVB_FP_STATS_REQUEST) == 144,
+                "sizeof(AVB_FP_STATS_REQUEST) == 144  (4 x u32, 15 x u64, status, reserved)");
+
+    /* TC-ABI-030 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-030: sizeof(AVB_LAT_HIST_REQUEST) == 7848");
+    TEST_ASSERT(sizeof(AVB_LAT_HIST_REQUEST) == 7848,
+                "sizeof(AVB_LAT_HIST_REQUEST) == 7848  (6 x u32, codes[32], total, counts[960], status, reserved)");
+
+    /* TC-ABI-031 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-031: sizeof(AVB_TRACE_REQUEST) == 48, sizeof(AVB_TRACE_RECORD) == 48");
+    TEST_ASSERT(sizeof(AVB_TRACE_REQUEST) == 48,
+                "sizeof(AVB_TRACE_REQUEST) == 48  (6 x u32, tick_hz, lost, status, reserved)");
+    TEST_ASSERT(sizeof(AVB_TRACE_RECORD) == 48,
+                "sizeof(AVB_TRACE_RECORD) == 48  (seq, ticks, id, cpu, arg32, arg[3])");
+
+    /* TC-ABI-032 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-032: sizeof(AVB_STATS_SNAPSHOT_REQUEST) == 264");
+    TEST_ASSERT(sizeof(AVB_STATS_SNAPSHOT_REQUEST) == 264,
+                "sizeof(AVB_STATS_SNAPSHOT_REQUEST) == 264  (2 x u32, 5 x u64, 4 x u32, statistics[192], status, reserved)");
+
+    /* TC-ABI-033 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-033: sizeof(AVB_HW_STATS_REQUEST) == 64, sizeof(AVB_HW_STATS_PAGE) == 384");
+    TEST_ASSERT(sizeof(AVB_HW_STATS_REQUEST) == 64,
+                "sizeof(AVB_HW_STATS_REQUEST) == 64  (2 x u32, 5 x u64, page_size, counter_count, status, reserved)");
+    TEST_ASSERT(sizeof(AVB_HW_STATS_PAGE) == 384,
+                "sizeof(AVB_HW_STATS_PAGE) == 384  (64-byte header + 40 x u64 counters)");
+    TEST_ASSERT(offsetof(AVB_HW_STATS_PAGE, counters) == 64,
+                "offsetof(AVB_HW_STATS_PAGE, counters) == 64  (seqlock header is one cache line)");
+
+    /* TC-ABI-034 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-034: sizeof(AVB_MMIO_ACCT_REQUEST) == 1176");
+    TEST_ASSERT(sizeof(AVB_MMIO_ACCT_REQUEST) == 1176,
+                "sizeof(AVB_MMIO_ACCT_REQUEST) == 1176  (2 x u32, u64, 2 x 2 x 9 x 4 u64 count / ticks, status, reserved)");
+
+    /* TC-ABI-035 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-035: sizeof(AVB_TEST_POOL_REQUEST) == 80");
+    TEST_ASSERT(sizeof(AVB_TEST_POOL_REQUEST) == 80,
+                "sizeof(AVB_TEST_POOL_REQUEST) == 80  (8 x u32, 5 x u64 counters, status, reserved)");
+
+    /* TC-ABI-036 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-036: sizeof(AVB_PKTGEN_REQUEST) == 304");
+    TEST_ASSERT(sizeof(AVB_PKTGEN_REQUEST) == 304,
+                "sizeof(AVB_PKTGEN_REQUEST) == 304  (112-byte template and schedule, 3 x u64 in, 20 x u64 out, status, reserved)");
+
+    /* TC-ABI-037 ------------------------------------------------------------ */
+    TEST_CASE("TC-ABI-037: sizeof(AVB_TX_RES_REQUEST) == 576");
+    TEST_ASSERT(sizeof(AVB_TX_RES_CLASS) == 64,
+                "sizeof(AVB_TX_RES_CLASS) == 64  (count and 7 latency figures, u64)");
+    TEST_ASSERT(sizeof(AVB_TX_RES_REQUEST) == 576,
+                "sizeof(AVB_TX_RES_REQUEST) == 576  (6 x u32, 4 x u64 counters, 8 x 64-byte classes, status, reserved)");
 }
 
 int main(void)
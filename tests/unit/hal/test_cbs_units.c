@@ -0,0 +1,227 @@
+/**
+ * @file test_cbs_units.c
+ * @brief Credit-based shaper register units and 802.1Q Annex L credit bounds
+ *
+ * Test ID: TEST-QAV-UNITS-001
+ * Verifies: REQ-F-QAV-001 (Credit-Based Shaper Configuration)
+ * Unit under test: devices/intel_cbs.h
+ *
+ * Test Cases:
+ *   TC-CBS-UNITS-001: I210 IdleSlope encoding (61034 units per 1 Gb/s), rounded up
+ *   TC-CBS-UNITS-002: I225/I226 IdleSlope encoding (61036 units per 2.5 Gb/s), rounded up
+ *   TC-CBS-UNITS-003: effective rate never below the request across the full range
+ *   TC-CBS-UNITS-004: TQAVHC hiCredit encoding and overflow limit
+ *   TC-CBS-UNITS-005: Annex L bounds at 1 Gb/s (Class A/B 20 Mb/s, 1500-byte frames)
+ *   TC-CBS-UNITS-006: Annex L bounds at 100 Mb/s (Class A 10 Mb/s, Class B 5 Mb/s)
+ *   TC-CBS-UNITS-007: Annex L bounds at 2.5 Gb/s (Class A 500 Mb/s, Class B 250 Mb/s)
+ *   TC-CBS-UNITS-008: STATUS link speed decode
+ *
+ * Expected register values follow the igb/igc derivation:
+ *   value = ceil(idleSlope_bps * 61034 / 1e9)      (I210)
+ *   value = ceil(idleSlope_bps * 61036 / 2.5e9)    (I225/I226)
+ *
+ * Portable C99: builds with cl.exe (Windows) and gcc/clang (Linux):
+ *   cl /nologo /W4 /O2 -I . tests/unit/hal/test_cbs_units.c /Fe:test_cbs_units.exe
+ *   cc -O2 -Wall -Wextra -I . -o test_cbs_units tests/unit/hal/test_cbs_units.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../../../devices/intel_cbs.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define MBPS(x)  ((uint64_t)(x) * 1000000ull)
+#define BPS_TO_BYTES(x) ((uint32_t)((x) / 8u))
+
+static void test_i210_units(void)
+{
+    const intel_cbs_family_t f = INTEL_CBS_FAMILY_I210;
+
+    TEST_CASE("TC-CBS-UNITS-001: I210 IdleSlope encoding");
+    TEST_ASSERT(intel_cbs_idle_slope_reg(f, 0) == 0, "0 bytes/s -> 0 (shaper off)");
+    TEST_ASSERT(intel_cbs_idle_slope_reg(f, BPS_TO_BYTES(MBPS(20))) == 1221,
+                "20 Mb/s -> 1221 (1220.68 rounded up)");
+    TEST_ASSERT(intel_cbs_idle_slope_Bps(f, 1221) == 2500655, "1221 units -> 2 500 655 bytes/s");
+    TEST_ASSERT(intel_cbs_idle_slope_reg(f, BPS_TO_BYTES(MBPS(500))) == 30517,
+                "500 Mb/s -> 30517 (exact)");
+    TEST_ASSERT(intel_cbs_idle_slope_Bps(f, 30517) == 62500000, "30517 units -> 62 500 000 bytes/s");
+    TEST_ASSERT(intel_cbs_idle_slope_reg(f, BPS_TO_BYTES(MBPS(750))) == 45776,
+                "750 Mb/s (75 % of 1 Gb/s) -> 45776");
+    TEST_ASSERT(intel_cbs_idle_slope_reg(f, 1) == 1 && intel_cbs_idle_slope_Bps(f, 1) == 2048,
+                "1 byte/s -> one unit = 2048 bytes/s (16.384 kb/s granularity)");
+    TEST_ASSERT(intel_cbs_idle_slope_Bps(f, 0xFFFF) == 134218222, "full field ~1.07 Gb/s");
+}
+
+static void test_i225_units(void)
+{
+    const intel_cbs_family_t f = INTEL_CBS_FAMILY_I225;
+
+    TEST_CASE("TC-CBS-UNITS-002: I225/I226 IdleSlope encoding");
+    TEST_ASSERT(intel_cbs_idle_slope_reg(f, BPS_TO_BYTES(MBPS(20))) == 489,
+                "20 Mb/s -> 489 (488.29 rounded up)");
+    TEST_ASSERT(intel_cbs_idle_slope_Bps(f, 489) == 2503645, "489 units -> 2 503 645 bytes/s");
+    TEST_ASSERT(intel_cbs_idle_slope_reg(f, BPS_TO_BYTES(MBPS(750))) == 18311,
+                "750 Mb/s -> 18311");
+    TEST_ASSERT(intel_cbs_idle_slope_reg(f, 1) == 1 && intel_cbs_idle_slope_Bps(f, 1) == 5119,
+                "one unit = 5119 bytes/s (40.96 kb/s granularity)");
+    TEST_ASSERT(intel_cbs_idle_slope_reg(f, BPS_TO_BYTES(MBPS(1875))) <= 0xFFFF,
+                "75 % of 2.5 Gb/s fits the 16-bit field");
+    TEST_ASSERT(intel_cbs_idle_slope_Bps(f, 0xFFFF) == 335534561, "full field ~2.68 Gb/s");
+}
+
+static void test_never_below(void)
+{
+    uint32_t bytes, reg;
+    int fam, ok = 1, tight = 1;
+
+    TEST_CASE("TC-CBS-UNITS-003: effective >= requested, within one unit");
+    for (fam = 0; fam < 2; fam++) {
+        intel_cbs_family_t f = (intel_cbs_family_t)fam;
+        uint32_t unit_Bps = intel_cbs_idle_slope_Bps(f, 1) + 1u;
+
+        for (bytes = 1; bytes < 312500000u; bytes += 7919u) {
+            uint32_t eff;
+            reg = intel_cbs_idle_slope_reg(f, bytes);
+            if (reg > 0xFFFF) {
+                break;
+            }
+            eff = intel_cbs_idle_slope_Bps(f, reg);
+            if (eff < bytes) {
+                ok = 0;
+            }
+            if (eff - bytes > unit_Bps) {
+                tight = 0;
+            }
+        }
+    }
+    TEST_ASSERT(ok, "effective rate never below the request (both families)");
+    TEST_ASSERT(tight, "effective rate exceeds the request by less than one unit");
+}
+
+static void test_hicredit(void)
+{
+    uint32_t reg = 0;
+
+    TEST_CASE("TC-CBS-UNITS-004: TQAVHC hiCredit encoding");
+    TEST_ASSERT(intel_cbs_hicredit_reg(INTEL_CBS_FAMILY_I210, 0, &reg) == 0 && reg == 0x80000000u,
+                "hiCredit 0 -> 0x80000000");
+    TEST_ASSERT(intel_cbs_hicredit_reg(INTEL_CBS_FAMILY_I210, 30, &reg) == 0 &&
+                reg == 0x80000000u + 30u * 0x7735u, "I210 hiCredit 30 -> 0x80000000 + 30 * 0x7735");
+    TEST_ASSERT(intel_cbs_hicredit_reg(INTEL_CBS_FAMILY_I225, 62, &reg) == 0 &&
+                reg == 0x80000000u + 62u * 0x7736u, "I225 hiCredit 62 -> 0x80000000 + 62 * 0x7736");
+    TEST_ASSERT(intel_cbs_hicredit_reg(INTEL_CBS_FAMILY_I210, 65535, &reg) == 0,
+                "65535 bytes fits (I210)");
+    TEST_ASSERT(intel_cbs_hicredit_reg(INTEL_CBS_FAMILY_I210, 70370, &reg) == 0 &&
+                intel_cbs_hicredit_reg(INTEL_CBS_FAMILY_I210, 70371, &reg) == -1,
+                "I210 limit is 70370 bytes");
+    TEST_ASSERT(intel_cbs_hicredit_reg(INTEL_CBS_FAMILY_I225, 70367, &reg) == 0 &&
+                intel_cbs_hicredit_reg(INTEL_CBS_FAMILY_I225, 70368, &reg) == -1,
+                "I225 limit is 70367 bytes");
+}
+
+static void test_annexl_1g(void)
+{
+    const uint64_t port = MBPS(1000);
+
+    TEST_CASE("TC-CBS-UNITS-005: Annex L at 1 Gb/s");
+    /* Class A and B 20 Mb/s each, 1500-byte frames: the values used in the
+     * Linux tc-cbs reference configuration (hicredit 30 / 62, locredit -1470) */
+    TEST_ASSERT(intel_cbs_annexl_hicredit_a(1500, MBPS(20), port) == 30, "Class A hiCredit = 30");
+    TEST_ASSERT(intel_cbs_annexl_locredit(1500, MBPS(20), port) == 1470, "Class A loCredit = -1470");
+    TEST_ASSERT(intel_cbs_annexl_hicredit_b(1500, 1500, MBPS(20), MBPS(20), port) == 62,
+                "Class B hiCredit = 62 (61.2 rounded up)");
+    TEST_ASSERT(intel_cbs_annexl_locredit(1500, MBPS(20), port) == 1470, "Class B loCredit = -1470");
+}
+
+static void test_annexl_100m(void)
+{
+    const uint64_t port = MBPS(100);
+
+    TEST_CASE("TC-CBS-UNITS-006: Annex L at 100 Mb/s");
+    TEST_ASSERT(intel_cbs_annexl_hicredit_a(1522, MBPS(10), port) == 153,
+                "Class A 10 Mb/s, 1522-byte interference: hiCredit = 153 (152.2)");
+    TEST_ASSERT(intel_cbs_annexl_locredit(1522, MBPS(10), port) == 1370,
+                "Class A loCredit = -1370 (-1369.8)");
+    TEST_ASSERT(intel_cbs_annexl_hicredit_b(1522, 1522, MBPS(10), MBPS(5), port) == 170,
+                "Class B 5 Mb/s: hiCredit = 170 (169.1)");
+    TEST_ASSERT(intel_cbs_annexl_locredit(1522, MBPS(100), port) == 0,
+                "idleSlope == port rate: no sendSlope, loCredit 0");
+}
+
+static void test_annexl_2g5(void)
+{
+    const uint64_t port = MBPS(2500);
+
+    TEST_CASE("TC-CBS-UNITS-007: Annex L at 2.5 Gb/s");
+    TEST_ASSERT(intel_cbs_annexl_hicredit_a(1522, MBPS(500), port) == 305,
+                "Class A 500 Mb/s: hiCredit = 305 (304.4)");
+    TEST_ASSERT(intel_cbs_annexl_locredit(1522, MBPS(500), port) == 1218,
+                "Class A loCredit = -1218 (-1217.6)");
+    TEST_ASSERT(intel_cbs_annexl_hicredit_b(1522, 1522, MBPS(500), MBPS(250), port) == 381,
+                "Class B 250 Mb/s: hiCredit = 381 (380.5)");
+    TEST_ASSERT(intel_cbs_annexl_hicredit_b(1522, 1522, port, MBPS(250), port) == 0,
+                "Class A at full rate leaves no room: Class B bound 0");
+}
+
+static void test_link_speed(void)
+{
+    TEST_CASE("TC-CBS-UNITS-008: STATUS link speed decode");
+    TEST_ASSERT(intel_cbs_link_mbps(INTEL_CBS_FAMILY_I210, 0x00000080u) == 0, "link down -> 0");
+    TEST_ASSERT(intel_cbs_link_mbps(INTEL_CBS_FAMILY_I210, 0x00000002u) == 10, "SPEED 00 -> 10");
+    TEST_ASSERT(intel_cbs_link_mbps(INTEL_CBS_FAMILY_I210, 0x00000042u) == 100, "SPEED 01 -> 100");
+    TEST_ASSERT(intel_cbs_link_mbps(INTEL_CBS_FAMILY_I210, 0x00000082u) == 1000, "SPEED 10 -> 1000");
+    TEST_ASSERT(intel_cbs_link_mbps(INTEL_CBS_FAMILY_I210, 0x00400082u) == 1000,
+                "I210 ignores the I225 2.5G bit");
+    TEST_ASSERT(intel_cbs_link_mbps(INTEL_CBS_FAMILY_I225, 0x00400082u) == 2500, "I225 SPEED_2500 -> 2500");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-QAV-UNITS-001: CBS register units / Annex L\n");
+    printf("  Verifies: REQ-F-QAV-001\n");
+    printf("=======================================================\n");
+
+    test_i210_units();
+    test_i225_units();
+    test_never_below();
+    test_hicredit();
+    test_annexl_1g();
+    test_annexl_100m();
+    test_annexl_2g5();
+    test_link_speed();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file test_fp_stats.c
+ * @brief 802.3br MAC merge counters: decode, accumulation and deltas
+ *
+ * Test ID: TEST-FP-STATS-001
+ * Verifies: REQ-F-FP-002 (Frame preemption statistics)
+ * Unit under test: devices/intel_fp_stats.h
+ *
+ * Test Cases:
+ *   TC-FP-STATS-001: PRMEXPRCNT field decode (assembly / SMD errors)
+ *   TC-FP-STATS-002: clear-on-read samples add up to 64-bit totals
+ *   TC-FP-STATS-003: delta since baseline - advance vs. peek, interval
+ *   TC-FP-STATS-004: saturated 8-bit exception fields are flagged
+ *   TC-FP-STATS-005: verify status inference across enable / disable
+ *
+ * Portable C99: builds with cl.exe (Windows) and gcc/clang (Linux):
+ *   cl /nologo /W4 /O2 -I . tests/unit/hal/test_fp_stats.c /Fe:test_fp_stats.exe
+ *   cc -O2 -Wall -Wextra -I . -o test_fp_stats tests/unit/hal/test_fp_stats.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../../../devices/intel_fp_stats.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define MS 1000000ull
+
+static struct intel_fp_sample sample(uint32_t txf, uint32_t rxf, uint32_t holds, uint32_t ok,
+                                     uint32_t exc, int enabled, int verify_dis)
+{
+    struct intel_fp_sample r;
+    memset(&r, 0, sizeof(r));
+    r.tx_fragments    = txf;
+    r.rx_fragments    = rxf;
+    r.tx_holds        = holds;
+    r.rx_assembly_ok  = ok;
+    r.exceptions      = exc;
+    r.fp_enabled      = (uint8_t)enabled;
+    r.verify_disabled = (uint8_t)verify_dis;
+    return r;
+}
+
+static void test_decode(void)
+{
+    intel_fp_stats_t s;
+    struct intel_fp_sample r = sample(0, 0, 0, 0, 0x00030201u, 1, 0);
+
+    TEST_CASE("TC-FP-STATS-001: PRMEXPRCNT decode");
+    intel_fp_stats_reset(&s, 0);
+    intel_fp_stats_accumulate(&s, &r, 1);
+    TEST_ASSERT(s.total.c[INTEL_FP_CNT_RX_ASSEMBLY_ERRORS] == 3,
+                "out-of-order fragment (1) + out-of-order frame (2) = 3 assembly errors");
+    TEST_ASSERT(s.total.c[INTEL_FP_CNT_RX_SMD_ERRORS] == 3, "SMD errors from [23:16]");
+    TEST_ASSERT(s.saturated == 0, "no field at 0xFF: not saturated");
+}
+
+static void test_totals(void)
+{
+    intel_fp_stats_t s;
+    struct intel_fp_sample r;
+    uint32_t i;
+
+    TEST_CASE("TC-FP-STATS-002: totals");
+    intel_fp_stats_reset(&s, 0);
+    for (i = 0; i < 1000u; i++) {
+        r = sample(0xF0000000u, 7, 3, 5, 0x00010000u, 1, 0);
+        intel_fp_stats_accumulate(&s, &r, (uint64_t)(i + 1u) * MS);
+    }
+    TEST_ASSERT(s.total.c[INTEL_FP_CNT_TX_FRAGMENTS] == 1000ull * 0xF0000000ull,
+                "TX fragments past 2^32 kept in 64 bits");
+    TEST_ASSERT(s.total.c[INTEL_FP_CNT_RX_FRAGMENTS] == 7000 && s.total.c[INTEL_FP_CNT_TX_HOLDS] == 3000 &&
+                s.total.c[INTEL_FP_CNT_RX_ASSEMBLY_OK] == 5000 && s.total.c[INTEL_FP_CNT_RX_SMD_ERRORS] == 1000,
+                "every counter summed per sample");
+    TEST_ASSERT(s.samples == 1000 && s.sample_ns == 1000 * MS, "sample count and clock");
+}
+
+static void test_delta(void)
+{
+    intel_fp_stats_t s;
+    intel_fp_counters_t d;
+    struct intel_fp_sample r;
+    uint64_t iv;
+
+    TEST_CASE("TC-FP-STATS-003: deltas");
+    intel_fp_stats_reset(&s, 10 * MS);
+    r = sample(100, 50, 10, 40, 0, 1, 0);
+    intel_fp_stats_accumulate(&s, &r, 20 * MS);
+    intel_fp_stats_delta(&s, &d, &iv, 0);
+    TEST_ASSERT(d.c[INTEL_FP_CNT_TX_FRAGMENTS] == 100 && iv == 10 * MS, "peek: 100 fragments over 10 ms");
+
+    r = sample(20, 0, 2, 0, 0, 1, 0);
+    intel_fp_stats_accumulate(&s, &r, 30 * MS);
+    intel_fp_stats_delta(&s, &d, &iv, 1);
+    TEST_ASSERT(d.c[INTEL_FP_CNT_TX_FRAGMENTS] == 120 && d.c[INTEL_FP_CNT_TX_HOLDS] == 12 && iv == 20 * MS,
+                "peek kept the baseline: delta covers both samples");
+
+    r = sample(5, 1, 1, 1, 0, 1, 0);
+    intel_fp_stats_accumulate(&s, &r, 35 * MS);
+    intel_fp_stats_delta(&s, &d, &iv, 1);
+    TEST_ASSERT(d.c[INTEL_FP_CNT_TX_FRAGMENTS] == 5 && d.c[INTEL_FP_CNT_RX_FRAGMENTS] == 1 && iv == 5 * MS,
+                "after advance: only the new sample");
+    TEST_ASSERT(s.total.c[INTEL_FP_CNT_TX_FRAGMENTS] == 125, "totals unaffected by deltas");
+
+    intel_fp_stats_delta(&s, &d, &iv, 1);
+    TEST_ASSERT(d.c[INTEL_FP_CNT_TX_FRAGMENTS] == 0 && iv == 0, "no sample since: zero delta, zero interval");
+}
+
+static void test_saturation(void)
+{
+    intel_fp_stats_t s;
+    struct intel_fp_sample r;
+
+    TEST_CASE("TC-FP-STATS-004: saturation");
+    intel_fp_stats_reset(&s, 0);
+    r = sample(0, 0, 0, 0, 0x000000FFu, 1, 0);
+    intel_fp_stats_accumulate(&s, &r, 1);
+    r = sample(0, 0, 0, 0, 0x00FF0000u, 1, 0);
+    intel_fp_stats_accumulate(&s, &r, 2);
+    r = sample(0, 0, 0, 0, 0x00FEFEFEu, 1, 0);
+    intel_fp_stats_accumulate(&s, &r, 3);
+    TEST_ASSERT(s.saturated == 2, "0xFF in any field flags the sample; 0xFE does not");
+    TEST_ASSERT(s.total.c[INTEL_FP_CNT_RX_ASSEMBLY_ERRORS] == 0xFFu + 0xFEu + 0xFEu &&
+                s.total.c[INTEL_FP_CNT_RX_SMD_ERRORS] == 0xFFu + 0xFEu,
+                "saturated values still counted");
+}
+
+static void test_verify(void)
+{
+    intel_fp_stats_t s;
+    struct intel_fp_sample r;
+
+    TEST_CASE("TC-FP-STATS-005: verify status");
+    intel_fp_stats_reset(&s, 0);
+    TEST_ASSERT(s.verify_status == INTEL_FP_VERIFY_UNKNOWN, "before the first sample: UNKNOWN");
+
+    r = sample(0, 0, 0, 0, 0, 0, 0);
+    intel_fp_stats_accumulate(&s, &r, 1);
+    TEST_ASSERT(s.verify_status == INTEL_FP_VERIFY_OFF, "FP disabled: OFF");
+
+    r = sample(0, 4, 0, 2, 0, 1, 0);
+    intel_fp_stats_accumulate(&s, &r, 2);
+    TEST_ASSERT(s.verify_status == INTEL_FP_VERIFY_VERIFYING, "enabled, nothing sent preempted: VERIFYING");
+
+    r = sample(3, 0, 1, 0, 0, 1, 0);
+    intel_fp_stats_accumulate(&s, &r, 3);
+    r = sample(0, 0, 0, 0, 0, 1, 0);
+    intel_fp_stats_accumulate(&s, &r, 4);
+    TEST_ASSERT(s.verify_status == INTEL_FP_VERIFY_SUCCEEDED, "fragments sent: SUCCEEDED, and stays so");
+
+    r = sample(0, 0, 0, 0, 0, 0, 0);
+    intel_fp_stats_accumulate(&s, &r, 5);
+    r = sample(0, 0, 0, 0, 0, 1, 0);
+    intel_fp_stats_accumulate(&s, &r, 6);
+    TEST_ASSERT(s.verify_status == INTEL_FP_VERIFY_VERIFYING, "disable + re-enable starts over");
+
+    r = sample(0, 0, 0, 0, 0, 1, 1);
+    intel_fp_stats_accumulate(&s, &r, 7);
+    TEST_ASSERT(s.verify_status == INTEL_FP_VERIFY_DISABLED, "verification turned off: DISABLED");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-FP-STATS-001: 802.3br MAC merge statistics\n");
+    printf("  Verifies: REQ-F-FP-002\n");
+    printf("=======================================================\n");
+
+    test_decode();
+    test_totals();
+    test_delta();
+    test_saturation();
+    test_verify();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,330 @@
+/**
+ * @file test_hw_stats.c
+ * @brief NIC statistics registers: table, accumulation and the seqlock page
+ *
+ * Test ID: TEST-HW-STATS-001
+ * Verifies: REQ-F-STATISTICS-004 (NIC hardware statistics sampling)
+ * Unit under test: devices/intel_hw_stats.h
+ *
+ * Test Cases:
+ *   TC-HW-STATS-001: register table - distinct offsets, 64-bit pairs, device maps
+ *   TC-HW-STATS-002: clear-on-read samples add up to 64-bit totals, absent counters stay 0
+ *   TC-HW-STATS-003: a sample cut short keeps the counters read before the failure
+ *   TC-HW-STATS-004: seqlock page - a reader racing the writer never sees a mixed sample
+ *   TC-HW-STATS-005: running (write-clear) counters add their growth, restart after a clear
+ *
+ * Portable C99: builds with cl.exe (Windows) and gcc/clang (Linux):
+ *   cl /nologo /W4 /O2 -I . tests/unit/hal/test_hw_stats.c /Fe:test_hw_stats.exe
+ *   cc -O2 -Wall -Wextra -pthread -I . -o test_hw_stats tests/unit/hal/test_hw_stats.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "../../../devices/intel_hw_stats.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define MS          1000000ull
+#define PUBLISHES   20000u
+#define GAP_SPINS   2000u       /* the driver publishes every >= 10 ms; leave the reader room */
+
+static const intel_hw_stats_map_t s_e1000e = INTEL_HW_STATS_MAP_E1000E_INIT;
+static const intel_hw_stats_map_t s_igb    = INTEL_HW_STATS_MAP_IGB_INIT;
+static const intel_hw_stats_map_t s_i350   = INTEL_HW_STATS_MAP_I350_INIT;
+static const intel_hw_stats_map_t s_i210   = INTEL_HW_STATS_MAP_I210_INIT;
+
+static void test_table(void)
+{
+    uint32_t i, j, lo, hi, lo2, hi2, pairs = 0;
+    int distinct = 1, aligned = 1;
+
+    TEST_CASE("TC-HW-STATS-001: register table");
+    for (i = 0; i < INTEL_HW_STAT_COUNT; i++) {
+        lo = intel_hw_stats_reg(i, &hi);
+        aligned &= lo != 0 && (lo & 3u) == 0;
+        if (hi != 0) {
+            pairs++;
+            aligned &= hi == lo + 4u;
+        }
+        for (j = 0; j < i; j++) {
+            lo2 = intel_hw_stats_reg(j, &hi2);
+            distinct &= lo2 != lo && lo2 != hi && (hi2 == 0 || (hi2 != lo && hi2 != hi));
+        }
+    }
+    TEST_ASSERT(aligned, "every counter has a dword-aligned register; high halves follow their low half");
+    TEST_ASSERT(distinct, "no register is read for two counters");
+    TEST_ASSERT(pairs == 4, "four 64-bit counters: GORC, GOTC, TOR, TOT");
+    lo = intel_hw_stats_reg(INTEL_HW_STAT_RX_NO_BUFFERS, &hi);
+    TEST_ASSERT(lo == 0x040A0u && hi == 0, "RNBC at 0x040A0");
+    lo = intel_hw_stats_reg(INTEL_HW_STAT_RX_QUEUE_DROPS_3, &hi);
+    TEST_ASSERT(lo == 0x0C030u + 3u * 0x40u, "RQDPC(3) at 0x0C030 + 3 * 0x40");
+    lo = intel_hw_stats_reg(INTEL_HW_STAT_COUNT, &hi);
+    TEST_ASSERT(lo == 0 && hi == 0, "index out of range: no register");
+
+    TEST_ASSERT(s_e1000e.present == INTEL_HW_STATS_BASE && !(s_e1000e.present & INTEL_HW_STATS_QDROP),
+                "I217 / I219: base block only");
+    TEST_ASSERT((s_igb.present & INTEL_HW_STATS_QDROP) == INTEL_HW_STATS_QDROP && !(s_igb.present & INTEL_HW_STATS_LPI),
+                "82575..82580: queue drops, no LPI counters");
+    TEST_ASSERT((s_i350.present & INTEL_HW_STATS_LPI) && s_i350.write_clear == 0, "I350: LPI, all clear on read");
+    TEST_ASSERT(s_i210.write_clear == INTEL_HW_STATS_QDROP, "I210 / I226: only RQDPC keeps its value on read");
+    TEST_ASSERT(intel_hw_stats_clear_on_read(&s_i210) == (s_i210.present & ~INTEL_HW_STATS_QDROP) &&
+                intel_hw_stats_clear_on_read(&s_i350) == s_i350.present,
+                "clear-on-read set: present less write_clear");
+    TEST_ASSERT((s_i210.present >> INTEL_HW_STAT_COUNT) == 0, "maps stay within INTEL_HW_STAT_COUNT");
+}
+
+static void test_totals(void)
+{
+    intel_hw_stats_t s;
+    struct intel_hw_stats_sample r;
+    uint32_t i;
+
+    TEST_CASE("TC-HW-STATS-002: totals");
+    intel_hw_stats_reset(&s);
+    memset(&r, 0, sizeof(r));
+    r.present = s_e1000e.present;
+    for (i = 0; i < INTEL_HW_STAT_COUNT; i++) {
+        r.v[i] = 0xDEADu;                   /* garbage outside present must be ignored */
+    }
+    r.v[INTEL_HW_STAT_CRC_ERRORS]     = 2;
+    r.v[INTEL_HW_STAT_RX_NO_BUFFERS]  = 0xF0000000u;
+    r.v[INTEL_HW_STAT_GOOD_RX_OCTETS] = 0x00000001F0000000ull;   /* GORCH = 1 */
+    for (i = 0; i < 1000u; i++) {
+        intel_hw_stats_accumulate(&s, &r, (uint64_t)(i + 1u) * MS);
+    }
+    TEST_ASSERT(s.total[INTEL_HW_STAT_CRC_ERRORS] == 2000, "CRC errors summed per sample");
+    TEST_ASSERT(s.total[INTEL_HW_STAT_RX_NO_BUFFERS] == 1000ull * 0xF0000000ull,
+                "32-bit register totals kept past 2^32");
+    TEST_ASSERT(s.total[INTEL_HW_STAT_GOOD_RX_OCTETS] == 1000ull * 0x1F0000000ull,
+                "64-bit octet pair added as one value");
+    TEST_ASSERT(s.total[INTEL_HW_STAT_RX_LPI] == 0 && s.total[INTEL_HW_STAT_RX_QUEUE_DROPS_0] == 0,
+                "counters the MAC lacks stay 0");
+    TEST_ASSERT(s.samples == 1000 && s.sample_ns == 1000 * MS && s.present == s_e1000e.present,
+                "sample count, clock and present mask");
+}
+
+static void test_partial(void)
+{
+    intel_hw_stats_t s;
+    struct intel_hw_stats_sample r;
+
+    TEST_CASE("TC-HW-STATS-003: sample cut short");
+    intel_hw_stats_reset(&s);
+    memset(&r, 0, sizeof(r));
+
+    /* The read of MPC failed: CRCERRS..RXERRC were read (and cleared) */
+    r.present = INTEL_HW_STAT_BIT(INTEL_HW_STAT_CRC_ERRORS) | INTEL_HW_STAT_BIT(INTEL_HW_STAT_ALIGN_ERRORS) |
+                INTEL_HW_STAT_BIT(INTEL_HW_STAT_RX_ERRORS);
+    r.v[INTEL_HW_STAT_CRC_ERRORS]     = 4;
+    r.v[INTEL_HW_STAT_MISSED_PACKETS] = 99;     /* not read */
+    intel_hw_stats_accumulate(&s, &r, 1 * MS);
+    TEST_ASSERT(s.total[INTEL_HW_STAT_CRC_ERRORS] == 4, "counters read before the failure are kept");
+    TEST_ASSERT(s.total[INTEL_HW_STAT_MISSED_PACKETS] == 0, "the rest are left for the next sample");
+
+    r.present = s_i210.present;
+    r.v[INTEL_HW_STAT_CRC_ERRORS]     = 1;
+    r.v[INTEL_HW_STAT_MISSED_PACKETS] = 99;
+    intel_hw_stats_accumulate(&s, &r, 2 * MS);
+    TEST_ASSERT(s.total[INTEL_HW_STAT_CRC_ERRORS] == 5 && s.total[INTEL_HW_STAT_MISSED_PACKETS] == 99,
+                "next full sample picks up what was left");
+    TEST_ASSERT(s.present == s_i210.present, "present mask is every counter ever read");
+}
+
+/* ---------------------------------------------------------------------------
+ * TC-004: the writer publishes totals whose counters all equal the sample
+ * number; any mix of two samples shows up as unequal counters.
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    intel_hw_stats_page_t *page;
+    volatile int           done;
+} race_t;
+
+#ifdef _WIN32
+static DWORD WINAPI publisher(LPVOID arg)
+#else
+static void *publisher(void *arg)
+#endif
+{
+    race_t *r = (race_t *)arg;
+    intel_hw_stats_t s;
+    volatile uint32_t spin;
+    uint32_t n, i;
+
+    intel_hw_stats_reset(&s);
+    s.present = s_i210.present;
+    for (n = 1; n <= PUBLISHES; n++) {
+        for (i = 0; i < INTEL_HW_STAT_COUNT; i++) {
+            s.total[i] = n;
+        }
+        s.samples   = n;
+        s.sample_ns = (uint64_t)n * MS;
+        intel_hw_stats_publish(r->page, &s, 10u);
+        for (spin = 0; spin < GAP_SPINS; spin++) {
+        }
+    }
+    r->done = 1;
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+static void test_seqlock(void)
+{
+    static intel_hw_stats_page_t page;
+    intel_hw_stats_page_t copy;
+    race_t race;
+    uint64_t reads = 0, mixed = 0, backwards = 0, last = 0;
+    uint32_t i;
+#ifdef _WIN32
+    HANDLE th;
+#else
+    pthread_t th;
+#endif
+
+    TEST_CASE("TC-HW-STATS-004: seqlock page");
+    memset(&page, 0, sizeof(page));
+    race.page = &page;
+    race.done = 0;
+#ifdef _WIN32
+    th = CreateThread(NULL, 0, publisher, &race, 0, NULL);
+#else
+    pthread_create(&th, NULL, publisher, &race);
+#endif
+    while (!race.done) {
+        if (!intel_hw_stats_page_read(&page, &copy, 1000u)) {
+            continue;
+        }
+        reads++;
+        for (i = 0; i < INTEL_HW_STAT_COUNT; i++) {
+            if (copy.counters[i] != copy.samples) {
+                mixed++;
+                break;
+            }
+        }
+        if (copy.sample_ns != copy.samples * MS) {
+            mixed++;
+        }
+        if (copy.samples < last) {
+            backwards++;
+        }
+        last = copy.samples;
+    }
+#ifdef _WIN32
+    WaitForSingleObject(th, INFINITE);
+    CloseHandle(th);
+#else
+    pthread_join(th, NULL);
+#endif
+
+    printf("  %llu consistent copies while %u samples were published\n",
+           (unsigned long long)reads, PUBLISHES);
+    TEST_ASSERT(reads != 0, "reader got copies while the writer ran");
+    TEST_ASSERT(mixed == 0, "no copy mixes two samples");
+    TEST_ASSERT(backwards == 0, "copies never go back in time");
+    TEST_ASSERT(intel_hw_stats_page_read(&page, &copy, 1u) && copy.samples == PUBLISHES &&
+                (copy.seq & 1u) == 0 && copy.seq == 2u * PUBLISHES,
+                "quiet page: last sample, seq even and advanced by 2 per publish");
+    TEST_ASSERT(copy.version == INTEL_HW_STATS_PAGE_VERSION && copy.counter_count == INTEL_HW_STAT_COUNT &&
+                copy.interval_ms == 10u && copy.present == s_i210.present,
+                "header fields published");
+
+    page.seq |= 1u;                         /* writer stuck mid-update */
+    TEST_ASSERT(!intel_hw_stats_page_read(&page, &copy, 100u), "odd seq: reader gives up after its tries");
+}
+
+/* ---------------------------------------------------------------------------
+ * TC-005: RQDPC is read without the write of 0 - the register keeps
+ * counting and the miniport may zero it between two samples.
+ * --------------------------------------------------------------------------- */
+static void test_running(void)
+{
+    intel_hw_stats_t s;
+    struct intel_hw_stats_sample r;
+    const uint32_t q = INTEL_HW_STAT_RX_QUEUE_DROPS_1;
+
+    TEST_CASE("TC-HW-STATS-005: running counters");
+    intel_hw_stats_reset(&s);
+    memset(&r, 0, sizeof(r));
+    r.present = INTEL_HW_STAT_BIT(q) | INTEL_HW_STAT_BIT(INTEL_HW_STAT_CRC_ERRORS);
+    r.running = s_i210.write_clear;
+
+    r.v[q] = 10;
+    r.v[INTEL_HW_STAT_CRC_ERRORS] = 3;
+    intel_hw_stats_accumulate(&s, &r, 1 * MS);
+    TEST_ASSERT(s.total[q] == 10, "first read: the whole register value");
+
+    r.v[q] = 25;
+    intel_hw_stats_accumulate(&s, &r, 2 * MS);
+    r.v[q] = 25;
+    intel_hw_stats_accumulate(&s, &r, 3 * MS);
+    TEST_ASSERT(s.total[q] == 25, "later reads add the growth only");
+    TEST_ASSERT(s.total[INTEL_HW_STAT_CRC_ERRORS] == 9, "clear-on-read counters in the same sample still summed");
+
+    r.v[q] = 4;                                 /* the miniport wrote 0, then 4 more drops */
+    intel_hw_stats_accumulate(&s, &r, 4 * MS);
+    TEST_ASSERT(s.total[q] == 29, "value went down: cleared meanwhile, whole value added");
+    r.v[q] = 6;
+    intel_hw_stats_accumulate(&s, &r, 5 * MS);
+    TEST_ASSERT(s.total[q] == 31, "growth tracked again from the new value");
+
+    intel_hw_stats_reset(&s);
+    r.v[q] = 40;
+    intel_hw_stats_accumulate(&s, &r, 6 * MS);
+    TEST_ASSERT(s.total[q] == 40 && s.last[q] == 40, "reset forgets the previous value");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-HW-STATS-001: NIC statistics registers\n");
+    printf("  Verifies: REQ-F-STATISTICS-004\n");
+    printf("=======================================================\n");
+
+    test_table();
+    test_totals();
+    test_partial();
+    test_seqlock();
+    test_running();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
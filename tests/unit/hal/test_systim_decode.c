@@ -0,0 +1,273 @@
+/**
+ * @file test_systim_decode.c
+ * @brief Bit-exact verification of the division-free SYSTIM decode
+ *
+ * Test ID: TEST-PHC-DECODE-001
+ * Verifies: REQ-NF-PERF-PHC-001 (Division-free PHC read path)
+ * Unit under test: devices/intel_systim_decode.h
+ *
+ * Test Cases:
+ *   TC-DECODE-001: umulh matches a portable 4-partial-product reference
+ *   TC-DECODE-002: I219 SCALED decode == raw / 200000 at structural edges
+ *                  (0, 2^n, 2^n +/- 1, 2^64-1, q*200000 + {0, 1, 199999})
+ *   TC-DECODE-003: I219 SCALED decode == raw / 200000 for random raw values
+ *                  spread uniformly over the full 2^64 range
+ *   TC-DECODE-004: I219 SCALED decode == raw / 200000 at every quotient
+ *                  boundary in a window below 2^64 (largest product terms)
+ *   TC-DECODE-005: Reciprocal exactness bound e * 2^58 < 2^75 holds
+ *   TC-DECODE-006: SPLIT decode == sec * 1e9 + ns over the full 32/32 range
+ *   TC-DECODE-007: FLAT decode == ((H << 32) | L) << shift for shift 0..3
+ *   TC-DECODE-008: ns -> SPLIT == (ns / 1e9, ns % 1e9) at second boundaries,
+ *                  near 2^64 and for random ns; its bound e * 2^55 < 2^81
+ *
+ * Exhaustive 2^64 enumeration is infeasible; TC-DECODE-005 checks the
+ * analytic bound that makes the identity hold for every 64-bit input, and
+ * TC-DECODE-002..004 sample the points where an off-by-one would show first.
+ *
+ * Portable C99: builds with cl.exe (Windows) and gcc/clang (Linux):
+ *   cl /nologo /W4 /O2 tests/unit/hal/test_systim_decode.c /Fe:test_systim_decode.exe
+ *   cc -O2 -Wall -Wextra -o test_systim_decode tests/unit/hal/test_systim_decode.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../../../devices/intel_systim_decode.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define RANDOM_SAMPLES   20000000u
+#define BOUNDARY_WINDOW  2000000u
+
+static const intel_systim_conv_t s_i219 = INTEL_SYSTIM_CONV_I219_INIT;
+
+/* xorshift64* — deterministic, full 64-bit output */
+static uint64_t s_rng = 0x9E3779B97F4A7C15ULL;
+static uint64_t rng_next(void)
+{
+    s_rng ^= s_rng >> 12;
+    s_rng ^= s_rng << 25;
+    s_rng ^= s_rng >> 27;
+    return s_rng * 0x2545F4914F6CDD1DULL;
+}
+
+static uint64_t ref_umulh(uint64_t a, uint64_t b)
+{
+    uint64_t a_lo = a & 0xFFFFFFFFULL, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFFULL, b_hi = b >> 32;
+    uint64_t p0 = a_lo * b_lo;
+    uint64_t p1 = a_lo * b_hi;
+    uint64_t p2 = a_hi * b_lo;
+    uint64_t p3 = a_hi * b_hi;
+    uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFFULL) + (p2 & 0xFFFFFFFFULL);
+    return p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+}
+
+/* Returns number of mismatches; prints the first few */
+static unsigned check_i219(uint64_t raw, unsigned mismatches)
+{
+    uint64_t want = raw / INTEL_SYSTIM_I219_COUNTS_PER_NS;
+    uint64_t got  = intel_systim_scaled_to_ns(&s_i219, raw);
+    if (got != want) {
+        if (mismatches < 5) {
+            printf("    mismatch raw=0x%016llX want=%llu got=%llu\n",
+                   (unsigned long long)raw, (unsigned long long)want,
+                   (unsigned long long)got);
+        }
+        return 1;
+    }
+    return 0;
+}
+
+static void test_umulh(void)
+{
+    unsigned bad = 0;
+    uint32_t i;
+    TEST_CASE("TC-DECODE-001: umulh vs portable reference");
+    for (i = 0; i < 1000000u; i++) {
+        uint64_t a = rng_next(), b = rng_next();
+        if (intel_systim_umulh(a, b) != ref_umulh(a, b)) bad++;
+    }
+    TEST_ASSERT(intel_systim_umulh(~0ULL, ~0ULL) == 0xFFFFFFFFFFFFFFFEULL,
+                "umulh(2^64-1, 2^64-1) == 2^64-2");
+    TEST_ASSERT(intel_systim_umulh(0, ~0ULL) == 0, "umulh(0, x) == 0");
+    TEST_ASSERT(bad == 0, "umulh matches reference for 1M random pairs");
+}
+
+static void test_i219_edges(void)
+{
+    unsigned bad = 0;
+    int n;
+    uint32_t i;
+    const uint64_t d = INTEL_SYSTIM_I219_COUNTS_PER_NS;
+    TEST_CASE("TC-DECODE-002: I219 decode at structural edges");
+
+    bad += check_i219(0, bad);
+    bad += check_i219(~0ULL, bad);
+    bad += check_i219(~0ULL - d, bad);
+    for (n = 0; n < 64; n++) {
+        uint64_t p = 1ULL << n;
+        bad += check_i219(p, bad);
+        bad += check_i219(p - 1, bad);
+        bad += check_i219(p + 1, bad);
+    }
+    for (i = 0; i < 1000000u; i++) {
+        uint64_t q = rng_next() % (~0ULL / d);
+        bad += check_i219(q * d, bad);
+        bad += check_i219(q * d + 1, bad);
+        bad += check_i219(q * d + d - 1, bad);
+        if (q) bad += check_i219(q * d - 1, bad);
+    }
+    TEST_ASSERT(bad == 0, "raw/200000 exact at 0, 2^n+/-1, 2^64-1 and 1M quotient boundaries");
+}
+
+static void test_i219_random(void)
+{
+    unsigned bad = 0;
+    uint32_t i;
+    TEST_CASE("TC-DECODE-003: I219 decode over random full-range raw values");
+    for (i = 0; i < RANDOM_SAMPLES; i++) {
+        bad += check_i219(rng_next(), bad);
+    }
+    printf("  %u samples checked\n", RANDOM_SAMPLES);
+    TEST_ASSERT(bad == 0, "raw/200000 exact for all random samples");
+}
+
+static void test_i219_top_window(void)
+{
+    unsigned bad = 0;
+    uint32_t k;
+    const uint64_t d = INTEL_SYSTIM_I219_COUNTS_PER_NS;
+    uint64_t qmax = ~0ULL / d;
+    TEST_CASE("TC-DECODE-004: I219 decode at every quotient boundary near 2^64");
+    for (k = 0; k < BOUNDARY_WINDOW; k++) {
+        uint64_t q = qmax - k;
+        bad += check_i219(q * d, bad);
+        bad += check_i219(q * d + d - 1 < q * d ? ~0ULL : q * d + d - 1, bad);
+        bad += check_i219(q * d - 1, bad);
+    }
+    TEST_ASSERT(bad == 0, "raw/200000 exact for the top 2M quotients");
+}
+
+static void test_bound(void)
+{
+    /* e = M*3125 - 2^75, computed in 128-bit via hi/lo words */
+    uint64_t m   = INTEL_SYSTIM_I219_MULT;
+    uint64_t lo  = m * 3125u;                       /* low 64 bits */
+    uint64_t hi  = ref_umulh(m, 3125u);             /* high 64 bits */
+    /* 2^75 = hi:lo == 0x800 : 0  →  e = (hi - 0x800) * 2^64 + lo */
+    TEST_CASE("TC-DECODE-005: reciprocal exactness bound");
+    TEST_ASSERT(hi == 0x800u, "M * 3125 lies in [2^75, 2^75 + 2^64)");
+    TEST_ASSERT(lo == 2932u, "e = M*3125 - 2^75 == 2932");
+    /* e * y_max < 2^75 with y_max = 2^58: 2932 < 2^12 → e*2^58 < 2^70 */
+    TEST_ASSERT(lo < (1ULL << 17), "e * 2^58 < 2^75 (identity exact for all 64-bit raw)");
+    TEST_ASSERT((1ULL << INTEL_SYSTIM_I219_PRE_SHIFT) * 3125u == INTEL_SYSTIM_I219_COUNTS_PER_NS,
+                "2^pre_shift * 3125 == 200000");
+}
+
+static void test_split(void)
+{
+    const intel_systim_conv_t conv = INTEL_SYSTIM_CONV_SPLIT_INIT;
+    unsigned bad = 0;
+    uint32_t i;
+    TEST_CASE("TC-DECODE-006: SPLIT sec/ns decode");
+    for (i = 0; i < 1000000u; i++) {
+        uint64_t r = rng_next();
+        uint32_t sec = (uint32_t)(r >> 32), ns = (uint32_t)r;
+        if (intel_systim_decode(&conv, sec, ns) != (uint64_t)sec * 1000000000ULL + ns) bad++;
+    }
+    if (intel_systim_decode(&conv, 0xFFFFFFFFu, 999999999u) !=
+        0xFFFFFFFFULL * 1000000000ULL + 999999999ULL) bad++;
+    if (intel_systim_decode(&conv, 0, 0) != 0) bad++;
+    TEST_ASSERT(bad == 0, "sec*1e9+ns identical for 1M random + edge pairs");
+}
+
+static void test_flat(void)
+{
+    unsigned bad = 0;
+    uint32_t i, s;
+    TEST_CASE("TC-DECODE-007: FLAT decode with shift");
+    for (s = 0; s < 4; s++) {
+        const intel_systim_conv_t conv = INTEL_SYSTIM_CONV_FLAT_INIT(s);
+        for (i = 0; i < 100000u; i++) {
+            uint64_t r = rng_next();
+            if (intel_systim_decode(&conv, (uint32_t)(r >> 32), (uint32_t)r) != (r << s)) bad++;
+        }
+    }
+    TEST_ASSERT(bad == 0, "((H<<32)|L) << shift identical for shift 0..3");
+}
+
+static void test_to_split(void)
+{
+    uint64_t m  = INTEL_SYSTIM_SEC_MULT;
+    uint64_t lo = m * 1953125u;                     /* 5^9; 2^81 = 0x20000 : 0 */
+    uint64_t hi = ref_umulh(m, 1953125u);
+    unsigned bad = 0;
+    uint32_t i, sec, nsec;
+    uint64_t ns;
+
+    TEST_CASE("TC-DECODE-008: ns -> SPLIT sec/ns");
+    TEST_ASSERT(hi == 0x20000u && lo == 197023u && lo < (1ULL << 26),
+                "e = M*5^9 - 2^81 == 197023, e * 2^55 < 2^81");
+    for (i = 0; i < 2000000u; i++) {
+        switch (i & 3u) {
+        case 0:  ns = rng_next(); break;
+        case 1:  ns = (rng_next() >> 34) * 1000000000ULL; break;        /* boundary */
+        case 2:  ns = (rng_next() >> 34) * 1000000000ULL - 1u; break;   /* just below */
+        default: ns = ~0ULL - (rng_next() >> 40); break;                /* near 2^64 */
+        }
+        intel_systim_ns_to_split(ns, &sec, &nsec);
+        if (sec != (uint32_t)(ns / 1000000000ULL) || nsec != (uint32_t)(ns % 1000000000ULL)) bad++;
+    }
+    TEST_ASSERT(bad == 0, "sec and ns identical to / and % for 2M boundary, top and random values");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-PHC-DECODE-001: Division-free SYSTIM decode\n");
+    printf("  Verifies: REQ-NF-PERF-PHC-001\n");
+    printf("=======================================================\n");
+
+    test_umulh();
+    test_i219_edges();
+    test_i219_random();
+    test_i219_top_window();
+    test_bound();
+    test_split();
+    test_flat();
+    test_to_split();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file test_aux_capture.c
+ * @brief Unit tests for the AUXSTMP latch tracker used by streamed AUX capture
+ *
+ * Test ID: TEST-PTP-AUXSTREAM-001
+ * Verifies: REQ-F-PTP-AUXSTREAM-001 (Streamed auxiliary timestamps)
+ * Unit under test: src/aux_capture.c (pure C, compiled unchanged into the driver)
+ *                  devices/intel_sdp_perout.h (AUX routing release)
+ *
+ * Test Cases:
+ *   TC-AUXSTREAM-001: first read after enable is consumed as stale, repeats are ignored
+ *   TC-AUXSTREAM-002: 1 PPS with every edge polled - consecutive edge numbers, no overrun
+ *   TC-AUXSTREAM-003: missed polls after lock - gap reported as lost edges, numbering skips
+ *   TC-AUXSTREAM-004: no loss inferred before the interval is confirmed
+ *   TC-AUXSTREAM-005: reference at another rate never locks; PHC step backwards drops the lock
+ *   TC-AUXSTREAM-006: EWMA follows a slightly off-nominal reference within tolerance
+ *   TC-AUXSTREAM-007: media-clock input faster than the poll - overruns account for all edges
+ *   TC-AUXSTREAM-008: TSSDP AUX release leaves the other channel routed
+ *   TC-AUXSTREAM-009: no nominal interval - arrival order, no loss inferred
+ *
+ * Build (Windows): cl /nologo /W4 /Zi -I . -I src tests/unit/ptp/test_aux_capture.c src/aux_capture.c
+ * Build (Linux):   cc -O2 -Wall -Wextra -I . -I src tests/unit/ptp/test_aux_capture.c src/aux_capture.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../../../src/aux_capture.h"
+#include "../../../devices/intel_sdp_perout.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define NS_PER_US   1000ull
+#define NS_PER_MS   1000000ull
+#define NS_PER_SEC  1000000000ull
+
+/* Feed n consecutive edges spaced by period starting at t0; returns the number
+ * of records with lost != 0 */
+static int feed(avb_aux_capture_t *a, uint64_t t0, uint64_t period, int n)
+{
+    uint64_t edge;
+    uint32_t lost;
+    int i, lossy = 0;
+
+    for (i = 0; i < n; i++) {
+        if (avb_aux_capture_update(a, t0 + (uint64_t)i * period, &edge, &lost) && lost) {
+            lossy++;
+        }
+    }
+    return lossy;
+}
+
+static void test_priming(void)
+{
+    avb_aux_capture_t a;
+    uint64_t edge = 99;
+    uint32_t lost = 99;
+
+    TEST_CASE("TC-AUXSTREAM-001: priming read and repeated values");
+    avb_aux_capture_init(&a, NS_PER_SEC);
+
+    TEST_ASSERT(avb_aux_capture_update(&a, 5 * NS_PER_SEC, &edge, &lost) == 0,
+                "first read is the stale latch, not reported");
+    TEST_ASSERT(a.records == 0 && edge == 99, "no record, outputs untouched");
+    TEST_ASSERT(avb_aux_capture_update(&a, 5 * NS_PER_SEC, &edge, &lost) == 0,
+                "same value again (latch not re-armed yet) is ignored");
+    TEST_ASSERT(avb_aux_capture_update(&a, 6 * NS_PER_SEC, &edge, &lost) == 1,
+                "new value is reported");
+    TEST_ASSERT(edge == 0 && lost == 0, "first reported edge is number 0");
+    TEST_ASSERT(avb_aux_capture_update(&a, 6 * NS_PER_SEC, &edge, &lost) == 0,
+                "repeat of reported value ignored");
+    TEST_ASSERT(a.records == 1, "one record");
+}
+
+static void test_pps_all_edges(void)
+{
+    avb_aux_capture_t a;
+    uint64_t edge = 0;
+    uint32_t lost = 0;
+    int i, ok = 1;
+
+    TEST_CASE("TC-AUXSTREAM-002: 1 PPS, every edge polled");
+    avb_aux_capture_init(&a, NS_PER_SEC);
+    avb_aux_capture_update(&a, 100 * NS_PER_SEC, &edge, &lost);
+
+    for (i = 1; i <= 10; i++) {
+        if (!avb_aux_capture_update(&a, (100 + (uint64_t)i) * NS_PER_SEC, &edge, &lost) ||
+            edge != (uint64_t)(i - 1) || lost != 0) {
+            ok = 0;
+        }
+    }
+    TEST_ASSERT(ok, "edges numbered 0..9 with no loss");
+    TEST_ASSERT(a.records == 10 && a.next_edge == 10 && a.overruns == 0, "counters consistent");
+    TEST_ASSERT(avb_aux_capture_locked(&a), "interval locked");
+    TEST_ASSERT(a.period_ns == NS_PER_SEC, "tracked period is exactly 1 s");
+}
+
+static void test_gap_after_lock(void)
+{
+    avb_aux_capture_t a;
+    uint64_t edge = 0;
+    uint32_t lost = 0;
+
+    TEST_CASE("TC-AUXSTREAM-003: missed polls after lock");
+    avb_aux_capture_init(&a, NS_PER_SEC);
+    feed(&a, 0, NS_PER_SEC, 5);            /* prime + edges 0..3 */
+    TEST_ASSERT(avb_aux_capture_locked(&a), "locked after a few PPS edges");
+
+    /* Edges at 5 s and 6 s never latched (poll stalled); next read is 7 s */
+    TEST_ASSERT(avb_aux_capture_update(&a, 7 * NS_PER_SEC, &edge, &lost) == 1, "record produced");
+    TEST_ASSERT(lost == 2, "two edges reported lost");
+    TEST_ASSERT(edge == 6, "edge number skips the lost ones (4, 5 -> 6)");
+    TEST_ASSERT(a.overruns == 2 && a.records == 5 && a.next_edge == 7, "edges = records + overruns");
+
+    /* Small timing noise on the gapped capture still counts as k periods */
+    TEST_ASSERT(avb_aux_capture_update(&a, 10 * NS_PER_SEC + 40 * NS_PER_US, &edge, &lost) == 1 &&
+                lost == 2 && edge == 9, "gap of 3 periods + 40 us noise -> 2 lost");
+    TEST_ASSERT(a.period_ns > NS_PER_SEC && a.period_ns - NS_PER_SEC < 2 * NS_PER_US,
+                "gapped interval moves the estimate by its per-period share only");
+}
+
+static void test_no_loss_before_lock(void)
+{
+    avb_aux_capture_t a;
+    uint64_t edge = 0;
+    uint32_t lost = 0;
+
+    TEST_CASE("TC-AUXSTREAM-004: no loss inferred before lock");
+    avb_aux_capture_init(&a, NS_PER_SEC);
+    avb_aux_capture_update(&a, 0, &edge, &lost);
+    avb_aux_capture_update(&a, NS_PER_SEC, &edge, &lost);       /* first match */
+    TEST_ASSERT(!avb_aux_capture_locked(&a), "one interval is not a lock");
+
+    TEST_ASSERT(avb_aux_capture_update(&a, 3 * NS_PER_SEC, &edge, &lost) == 1 && lost == 0,
+                "2-period gap before lock is not reported as loss");
+    TEST_ASSERT(a.overruns == 0 && edge == 1, "edge numbering stays consecutive");
+}
+
+static void test_relearn(void)
+{
+    avb_aux_capture_t a;
+    uint64_t edge = 0;
+    uint32_t lost = 0;
+    uint64_t t;
+
+    TEST_CASE("TC-AUXSTREAM-005: other rate never locks, PHC step drops the lock");
+    avb_aux_capture_init(&a, NS_PER_SEC);
+    feed(&a, 0, NS_PER_SEC, 5);
+    TEST_ASSERT(avb_aux_capture_locked(&a), "locked on 1 PPS");
+
+    /* Reference switches to 10 Hz: 100 ms is no multiple of 1 s */
+    t = 4 * NS_PER_SEC + 100 * NS_PER_MS;
+    TEST_ASSERT(avb_aux_capture_update(&a, t, &edge, &lost) == 1 && lost == 0,
+                "off-grid interval reported without loss");
+    TEST_ASSERT(!avb_aux_capture_locked(&a) && a.period_ns == NS_PER_SEC,
+                "lock dropped, period back at the nominal 1 s");
+    TEST_ASSERT(feed(&a, t + 100 * NS_PER_MS, 100 * NS_PER_MS, 30) == 0 && !avb_aux_capture_locked(&a),
+                "10 Hz never locks against a 1 s reference");
+
+    /* Back on 1 PPS, then the PHC is stepped backwards by an adjustment */
+    t = 10 * NS_PER_SEC;
+    feed(&a, t, NS_PER_SEC, 4);
+    TEST_ASSERT(avb_aux_capture_locked(&a), "relocks on 1 PPS");
+    TEST_ASSERT(avb_aux_capture_update(&a, 2 * NS_PER_SEC, &edge, &lost) == 1 && lost == 0,
+                "backwards timestamp reported without loss");
+    TEST_ASSERT(!avb_aux_capture_locked(&a) && a.period_ns == NS_PER_SEC, "lock dropped after step");
+    TEST_ASSERT(a.overruns == 0, "no overruns accumulated");
+}
+
+static void test_ewma(void)
+{
+    avb_aux_capture_t a;
+    uint64_t edge = 0;
+    uint32_t lost = 0;
+    const uint64_t period = 1000 * NS_PER_US + 37;   /* 1 kHz + 37 ns offset */
+    uint64_t t;
+    int i;
+
+    TEST_CASE("TC-AUXSTREAM-006: EWMA tracks off-nominal reference");
+    avb_aux_capture_init(&a, NS_PER_MS);                          /* nominal 1 kHz */
+    avb_aux_capture_update(&a, 0, &edge, &lost);
+
+    t = 0;
+    for (i = 0; i < 200; i++) {
+        t += period;
+        avb_aux_capture_update(&a, t, &edge, &lost);
+    }
+    TEST_ASSERT(a.period_ns >= period - 8 && a.period_ns <= period,
+                "period estimate converges to the true interval (within filter resolution)");
+    TEST_ASSERT(a.overruns == 0, "jittered single intervals never count as loss");
+
+    t += 3 * period;
+    TEST_ASSERT(avb_aux_capture_update(&a, t, &edge, &lost) == 1 && lost == 2,
+                "gap detected against the tracked period");
+}
+
+static void test_fast_input(void)
+{
+    avb_aux_capture_t a;
+    uint64_t edge = 0;
+    uint32_t lost = 0;
+    const uint64_t period = 125 * NS_PER_US;      /* 8 kHz word clock */
+    uint64_t now = 0, capture = 0;
+    int poll;
+
+    TEST_CASE("TC-AUXSTREAM-007: input faster than the 1 ms poll");
+    avb_aux_capture_init(&a, period);
+
+    /* 1 ms polls: the latch holds the first edge after each read, so the
+     * driver only ever sees every 8th edge, 1 ms apart.  Read 0 primes. */
+    for (poll = 0; poll <= 50; poll++) {
+        now = (uint64_t)poll * NS_PER_MS + 7 * NS_PER_US;
+        capture = now - (now % period) + period;
+        avb_aux_capture_update(&a, capture, &edge, &lost);
+    }
+    TEST_ASSERT(avb_aux_capture_locked(&a) && a.period_ns == period,
+                "locked at 125 us, not at the 1 ms poll interval");
+    TEST_ASSERT(a.records == 50, "one record per poll");
+    TEST_ASSERT(a.overruns == 48 * 7, "7 lost edges per poll once the two locking intervals matched");
+    TEST_ASSERT(a.next_edge == a.records + a.overruns, "edges = records + overruns");
+}
+
+static void test_tssdp_release(void)
+{
+    uint32_t tssdp = 0;
+
+    TEST_CASE("TC-AUXSTREAM-008: TSSDP AUX release");
+    tssdp = intel_tssdp_route_aux(tssdp, 2, 0);
+    tssdp = intel_tssdp_route_aux(tssdp, 1, 1);
+    TEST_ASSERT((tssdp & INTEL_TSSDP_AUX0_TS_SDP_EN) && (tssdp & INTEL_TSSDP_AUX1_TS_SDP_EN),
+                "both channels routed");
+
+    tssdp = intel_tssdp_release_aux(tssdp, 0);
+    TEST_ASSERT(!(tssdp & INTEL_TSSDP_AUX0_TS_SDP_EN), "AUX0 capture disabled");
+    TEST_ASSERT((tssdp & INTEL_TSSDP_AUX1_TS_SDP_EN) &&
+                ((tssdp & INTEL_TSSDP_AUX1_SEL_MASK) >> INTEL_TSSDP_AUX1_SEL_SHIFT) == 1,
+                "AUX1 still routed from SDP1");
+    tssdp = intel_tssdp_release_aux(tssdp, 1);
+    TEST_ASSERT((tssdp & (INTEL_TSSDP_AUX0_TS_SDP_EN | INTEL_TSSDP_AUX1_TS_SDP_EN)) == 0,
+                "both channels released");
+}
+
+static void test_no_nominal(void)
+{
+    avb_aux_capture_t a;
+    uint64_t edge = 0;
+    uint32_t lost = 0;
+    int i, ok = 1;
+
+    TEST_CASE("TC-AUXSTREAM-009: no nominal interval");
+    avb_aux_capture_init(&a, 0);
+    avb_aux_capture_update(&a, 0, &edge, &lost);
+
+    /* 8 kHz polled every 1 ms, with a stalled poll in between */
+    for (i = 1; i <= 20; i++) {
+        uint64_t t = (uint64_t)i * NS_PER_MS + (i > 10 ? NS_PER_MS : 0);
+        if (!avb_aux_capture_update(&a, t, &edge, &lost) || edge != (uint64_t)(i - 1) || lost != 0) {
+            ok = 0;
+        }
+    }
+    TEST_ASSERT(ok, "edges numbered in arrival order, nothing reported lost");
+    TEST_ASSERT(!avb_aux_capture_locked(&a) && a.period_ns == 0 && a.overruns == 0,
+                "never locks on the poll interval");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-PTP-AUXSTREAM-001: AUX latch tracker\n");
+    printf("  Verifies: REQ-F-PTP-AUXSTREAM-001\n");
+    printf("=======================================================\n");
+
+    test_priming();
+    test_pps_all_edges();
+    test_gap_after_lock();
+    test_no_loss_before_lock();
+    test_relearn();
+    test_ewma();
+    test_fast_input();
+    test_tssdp_release();
+    test_no_nominal();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
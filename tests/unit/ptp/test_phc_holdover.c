@@ -0,0 +1,238 @@
+/**
+ * @file test_phc_holdover.c
+ * @brief Unit tests for the PHC drift estimator / holdover state machine
+ *
+ * Test ID: TEST-PTP-HOLDOVER-001
+ * Verifies: REQ-F-PTP-HOLDOVER-001 (PHC holdover on GM loss)
+ * Unit under test: src/phc_holdover.c (pure C, compiled unchanged into the driver)
+ *
+ * Test Cases:
+ *   TC-HOLD-001: fresh estimator is FREE_RUN and refuses holdover
+ *   TC-HOLD-002: constant servo input → mean exact, stddev 0, LOCKED after 8 samples
+ *   TC-HOLD-003: mean converges to the centre of a symmetric +/-N ppb dither
+ *   TC-HOLD-004: stddev_ppb tracks the dither amplitude (within 20 %)
+ *   TC-HOLD-005: auto-timeout fires only after auto_timeout_ms of silence
+ *   TC-HOLD-006: manual enter returns the filtered increment; error grows linearly
+ *   TC-HOLD-007: next servo adjustment leaves holdover; exit/reset semantics
+ *   TC-HOLD-008: isqrt exact on squares and neighbours; outlier clamp bounds variance
+ *
+ * Build (Windows): cl /nologo /W4 /Zi -I src tests/unit/ptp/test_phc_holdover.c src/phc_holdover.c
+ * Build (Linux):   cc -O2 -Wall -Wextra -I src tests/unit/ptp/test_phc_holdover.c src/phc_holdover.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../../../src/phc_holdover.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+/* 8 ns nominal increment (I210 @ 125 MHz) in 2^-32 ns units */
+#define NOMINAL_Q32   (8ull << 32)
+/* 1 ppb of 8 ns in 2^-32 ns units: 8 * 2^32 / 1e9 ≈ 34.36 */
+#define PPB_Q32(ppb)  ((int64_t)((double)(ppb) * 8.0 * 4294967296.0 / 1e9))
+
+static void feed(avb_holdover_t *h, uint64_t inc, int n, uint64_t *now_ms, uint32_t step_ms)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+        avb_holdover_observe(h, inc, *now_ms);
+        *now_ms += step_ms;
+    }
+}
+
+static void test_fresh(void)
+{
+    avb_holdover_t h;
+    TEST_CASE("TC-HOLD-001: fresh estimator");
+    avb_holdover_init(&h);
+    TEST_ASSERT(h.state == AVB_HOLDOVER_ST_FREE_RUN, "initial state FREE_RUN");
+    TEST_ASSERT(!avb_holdover_ready(&h), "not ready without samples");
+    TEST_ASSERT(avb_holdover_enter(&h, AVB_HOLDOVER_RSN_MANUAL, 0) == 0, "enter refused (returns 0)");
+    TEST_ASSERT(h.state == AVB_HOLDOVER_ST_FREE_RUN, "state unchanged after refused enter");
+    TEST_ASSERT(avb_holdover_stddev_ppb(&h) == 0 && avb_holdover_error_ns(&h, 1000) == 0,
+                "stddev and error are 0");
+}
+
+static void test_constant(void)
+{
+    avb_holdover_t h;
+    uint64_t now = 1000;
+    uint64_t inc = NOMINAL_Q32 + (uint64_t)PPB_Q32(1500);   /* +1.5 ppm */
+    TEST_CASE("TC-HOLD-002: constant servo input");
+    avb_holdover_init(&h);
+    feed(&h, inc, AVB_HOLDOVER_MIN_SAMPLES - 1, &now, 125);
+    TEST_ASSERT(h.state == AVB_HOLDOVER_ST_FREE_RUN, "FREE_RUN with MIN_SAMPLES-1 samples");
+    feed(&h, inc, 1, &now, 125);
+    TEST_ASSERT(h.state == AVB_HOLDOVER_ST_LOCKED, "LOCKED at MIN_SAMPLES");
+    TEST_ASSERT(h.mean_q32 == inc, "mean == input exactly");
+    TEST_ASSERT(avb_holdover_stddev_q32(&h) == 0, "stddev == 0");
+}
+
+static void dither(avb_holdover_t *h, int64_t centre_ppb, int64_t amp_ppb, int n, uint64_t *now)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+        int64_t off = PPB_Q32(centre_ppb) + ((i & 1) ? PPB_Q32(amp_ppb) : -PPB_Q32(amp_ppb));
+        avb_holdover_observe(h, (uint64_t)((int64_t)NOMINAL_Q32 + off), *now);
+        *now += 125;
+    }
+}
+
+static void test_convergence(void)
+{
+    avb_holdover_t h;
+    uint64_t now = 0;
+    int64_t err_q32;
+    TEST_CASE("TC-HOLD-003: mean converges under dither");
+    avb_holdover_init(&h);
+    /* Start far away (servo pull-in), then settle at -2000 ppb +/- 50 ppb */
+    feed(&h, NOMINAL_Q32 + (uint64_t)PPB_Q32(20000), 4, &now, 125);
+    dither(&h, -2000, 50, 400, &now);
+    err_q32 = (int64_t)(h.mean_q32 - (uint64_t)((int64_t)NOMINAL_Q32 + PPB_Q32(-2000)));
+    printf("  mean error = %lld q32 (%.2f ppb)\n", (long long)err_q32, (double)err_q32 / 34.36);
+    /* alternating +/-A with alpha = 1/8 leaves a +/-A/15 ripple around the centre */
+    TEST_ASSERT(llabs(err_q32) <= PPB_Q32(50) / 7, "mean within A/7 of the dither centre");
+}
+
+static void test_stddev(void)
+{
+    avb_holdover_t h;
+    uint64_t now = 0;
+    uint64_t sd;
+    TEST_CASE("TC-HOLD-004: stddev tracks dither amplitude");
+    avb_holdover_init(&h);
+    dither(&h, 0, 100, 400, &now);
+    sd = avb_holdover_stddev_ppb(&h);
+    printf("  stddev = %llu ppb (dither +/-100 ppb)\n", (unsigned long long)sd);
+    TEST_ASSERT(sd >= 80 && sd <= 120, "stddev_ppb within 20 % of 100");
+}
+
+static void test_timeout(void)
+{
+    avb_holdover_t h;
+    uint64_t now = 5000;
+    TEST_CASE("TC-HOLD-005: auto-timeout");
+    avb_holdover_init(&h);
+    feed(&h, NOMINAL_Q32, 16, &now, 125);
+    now -= 125;                                   /* now == last_observe_ms */
+    TEST_ASSERT(!avb_holdover_timed_out(&h, now + 10000), "disabled when auto_timeout_ms == 0");
+    h.auto_timeout_ms = 2000;
+    TEST_ASSERT(!avb_holdover_timed_out(&h, now + 1999), "not timed out at 1999 ms");
+    TEST_ASSERT(avb_holdover_timed_out(&h, now + 2000), "timed out at 2000 ms");
+    avb_holdover_enter(&h, AVB_HOLDOVER_RSN_TIMEOUT, now + 2000);
+    TEST_ASSERT(h.state == AVB_HOLDOVER_ST_HOLDOVER && h.reason == AVB_HOLDOVER_RSN_TIMEOUT,
+                "HOLDOVER with reason TIMEOUT");
+    TEST_ASSERT(!avb_holdover_timed_out(&h, now + 5000), "does not re-fire while in holdover");
+}
+
+static void test_enter_error(void)
+{
+    avb_holdover_t h;
+    uint64_t now = 0, got, sd, e1, e2;
+    TEST_CASE("TC-HOLD-006: manual enter and error growth");
+    avb_holdover_init(&h);
+    dither(&h, 300, 20, 200, &now);
+    got = avb_holdover_enter(&h, AVB_HOLDOVER_RSN_MANUAL, now);
+    TEST_ASSERT(got == h.mean_q32 && got != 0, "enter returns the filtered mean");
+    TEST_ASSERT(h.holdover_start_ms == now, "holdover_start_ms recorded");
+    sd = avb_holdover_stddev_ppb(&h);
+    e1 = avb_holdover_error_ns(&h, now + 1000);
+    e2 = avb_holdover_error_ns(&h, now + 10000);
+    printf("  stddev=%llu ppb err(1s)=%llu ns err(10s)=%llu ns\n",
+           (unsigned long long)sd, (unsigned long long)e1, (unsigned long long)e2);
+    TEST_ASSERT(e1 == sd, "err(1 s) == stddev_ppb ns");
+    TEST_ASSERT(e2 == 10 * sd, "err(10 s) == 10 x err(1 s)");
+    avb_holdover_enter(&h, AVB_HOLDOVER_RSN_MANUAL, now + 500);
+    TEST_ASSERT(h.holdover_start_ms == now, "re-enter does not restart the error clock");
+}
+
+static void test_exit(void)
+{
+    avb_holdover_t h;
+    uint64_t now = 0;
+    TEST_CASE("TC-HOLD-007: leaving holdover");
+    avb_holdover_init(&h);
+    feed(&h, NOMINAL_Q32, 10, &now, 125);
+    avb_holdover_enter(&h, AVB_HOLDOVER_RSN_MANUAL, now);
+    feed(&h, NOMINAL_Q32, 1, &now, 125);
+    TEST_ASSERT(h.state == AVB_HOLDOVER_ST_LOCKED && h.reason == AVB_HOLDOVER_RSN_NONE,
+                "servo adjustment returns to LOCKED");
+    TEST_ASSERT(avb_holdover_error_ns(&h, now + 1000) == 0, "error is 0 outside holdover");
+    avb_holdover_enter(&h, AVB_HOLDOVER_RSN_MANUAL, now);
+    avb_holdover_exit(&h);
+    TEST_ASSERT(h.state == AVB_HOLDOVER_ST_LOCKED, "exit returns to LOCKED (estimate kept)");
+    TEST_ASSERT(h.samples == 11, "exit keeps the sample count");
+}
+
+static void test_isqrt_clamp(void)
+{
+    avb_holdover_t h;
+    uint64_t now = 0;
+    uint32_t i, bad = 0;
+    TEST_CASE("TC-HOLD-008: isqrt and outlier clamp");
+    for (i = 0; i < 100000u; i++) {
+        uint64_t r = (uint32_t)(i * 2654435761u);      /* < 2^32 so r^2 fits */
+        uint64_t sq = r * r;
+        if (avb_holdover_isqrt(sq) != r) bad++;
+        if (r && avb_holdover_isqrt(sq - 1) != r - 1) bad++;
+    }
+    TEST_ASSERT(bad == 0, "isqrt(r^2) == r and isqrt(r^2-1) == r-1 for 100k r");
+    TEST_ASSERT(avb_holdover_isqrt(UINT64_MAX) == 0xFFFFFFFFu, "isqrt(2^64-1) == 2^32-1");
+
+    avb_holdover_init(&h);
+    feed(&h, NOMINAL_Q32, 10, &now, 125);
+    feed(&h, NOMINAL_Q32 * 4, 1, &now, 125);      /* absurd servo step */
+    TEST_ASSERT(avb_holdover_stddev_q32(&h) <= (uint64_t)AVB_HOLDOVER_MAX_DEV_Q32,
+                "single outlier cannot push stddev past the clamp");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-PTP-HOLDOVER-001: PHC drift estimator / holdover\n");
+    printf("  Verifies: REQ-F-PTP-HOLDOVER-001\n");
+    printf("=======================================================\n");
+
+    test_fresh();
+    test_constant();
+    test_convergence();
+    test_stddev();
+    test_timeout();
+    test_enter_error();
+    test_exit();
+    test_isqrt_clamp();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
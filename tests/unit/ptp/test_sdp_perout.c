@@ -0,0 +1,268 @@
+/**
+ * @file test_sdp_perout.c
+ * @brief Unit tests for the periodic SDP output scheduler and jitter statistics
+ *
+ * Test ID: TEST-PTP-PEROUT-001
+ * Verifies: REQ-F-PTP-PEROUT-001 (Periodic SDP output)
+ * Unit under test: src/sdp_perout.c (pure C, compiled unchanged into the driver)
+ *                  devices/intel_sdp_perout.h (TSSDP / direction encoding)
+ *
+ * Test Cases:
+ *   TC-PEROUT-001: FREQOUT eligibility (50 % duty, 8 ns..70 ms or 125/250/500 ms half cycle)
+ *   TC-PEROUT-002: mode selection and parameter rejection
+ *   TC-PEROUT-003: start time in the past is rolled forward by whole periods (phase kept)
+ *   TC-PEROUT-004: edge numbering for non-50 % duty
+ *   TC-PEROUT-005: SW_REARM on-time re-arm walks every edge, no misses
+ *   TC-PEROUT-006: SW_REARM late re-arm skips an even number of edges (polarity kept)
+ *   TC-PEROUT-007: FREQOUT edge counting survives a statistics reset
+ *   TC-PEROUT-008: capture error folds onto the nearest edge; min/max/mean
+ *   TC-PEROUT-009: TSSDP routing and SDP direction encoding
+ *
+ * Build (Windows): cl /nologo /W4 /Zi -I . -I src tests/unit/ptp/test_sdp_perout.c src/sdp_perout.c
+ * Build (Linux):   cc -O2 -Wall -Wextra -I . -I src tests/unit/ptp/test_sdp_perout.c src/sdp_perout.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../../../src/sdp_perout.h"
+#include "../../../devices/intel_sdp_perout.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define NS_PER_MS   1000000ull
+#define NS_PER_SEC  1000000000ull
+
+static void test_freqout_ok(void)
+{
+    TEST_CASE("TC-PEROUT-001: FREQOUT eligibility");
+    TEST_ASSERT(avb_perout_freqout_ok(NS_PER_SEC, NS_PER_SEC / 2), "1 PPS (500 ms half cycle) uses FREQOUT");
+    TEST_ASSERT(avb_perout_freqout_ok(100, 50), "10 MHz (50 ns half cycle) uses FREQOUT");
+    TEST_ASSERT(avb_perout_freqout_ok(140 * NS_PER_MS, 70 * NS_PER_MS), "70 ms half cycle (upper limit) accepted");
+    TEST_ASSERT(!avb_perout_freqout_ok(200 * NS_PER_MS, 100 * NS_PER_MS), "100 ms half cycle rejected (not 125/250/500)");
+    TEST_ASSERT(avb_perout_freqout_ok(250 * NS_PER_MS, 125 * NS_PER_MS), "125 ms half cycle accepted");
+    TEST_ASSERT(!avb_perout_freqout_ok(14, 7), "7 ns half cycle rejected");
+    TEST_ASSERT(!avb_perout_freqout_ok(NS_PER_SEC, NS_PER_SEC / 4), "25 % duty cannot use FREQOUT");
+    TEST_ASSERT(!avb_perout_freqout_ok(101, 50), "odd period cannot use FREQOUT");
+}
+
+static void test_mode_selection(void)
+{
+    avb_perout_t p;
+    uint64_t now = 5 * NS_PER_SEC;
+
+    TEST_CASE("TC-PEROUT-002: mode selection");
+    TEST_ASSERT(avb_perout_configure(&p, 10 * NS_PER_SEC, NS_PER_SEC, 0, 1, now) == AVB_PEROUT_OK &&
+                p.mode == AVB_PEROUT_MD_FREQOUT && p.high_ns == NS_PER_SEC / 2,
+                "1 PPS, hw FREQOUT available -> FREQOUT, 50 % duty default");
+    TEST_ASSERT(avb_perout_configure(&p, 10 * NS_PER_SEC, NS_PER_SEC, 0, 0, now) == AVB_PEROUT_OK &&
+                p.mode == AVB_PEROUT_MD_SW_REARM,
+                "1 PPS, FREQOUT not requested -> SW_REARM");
+    TEST_ASSERT(avb_perout_configure(&p, 10 * NS_PER_SEC, NS_PER_SEC, 100 * NS_PER_MS, 1, now) == AVB_PEROUT_OK &&
+                p.mode == AVB_PEROUT_MD_SW_REARM,
+                "1 PPS with 100 ms pulse -> SW_REARM (duty not 50 %)");
+    TEST_ASSERT(avb_perout_configure(&p, 10 * NS_PER_SEC, 100000, 0, 0, now) == AVB_PEROUT_E_TOO_FAST &&
+                p.mode == AVB_PEROUT_MD_NONE,
+                "10 kHz without FREQOUT -> E_TOO_FAST, channel idle");
+    TEST_ASSERT(avb_perout_configure(&p, 10 * NS_PER_SEC, NS_PER_SEC, 10 * NS_PER_MS, 0, now) == AVB_PEROUT_E_TOO_FAST,
+                "10 ms pulse below SW minimum segment -> E_TOO_FAST");
+    TEST_ASSERT(avb_perout_configure(&p, 10 * NS_PER_SEC, 0, 0, 1, now) == AVB_PEROUT_E_PERIOD,
+                "period 0 -> E_PERIOD");
+    TEST_ASSERT(avb_perout_configure(&p, 10 * NS_PER_SEC, NS_PER_SEC, NS_PER_SEC, 1, now) == AVB_PEROUT_E_PERIOD,
+                "pulse width == period -> E_PERIOD");
+}
+
+static void test_roll_forward(void)
+{
+    avb_perout_t p;
+    uint64_t now = 10 * NS_PER_SEC + 300 * NS_PER_MS;
+
+    TEST_CASE("TC-PEROUT-003: start roll-forward");
+    avb_perout_configure(&p, 1 * NS_PER_SEC + 250 * NS_PER_MS, NS_PER_SEC, 0, 1, now);
+    TEST_ASSERT(p.start_ns == 11 * NS_PER_SEC + 250 * NS_PER_MS, "past start moved to 11.25 s (phase .25 kept)");
+    TEST_ASSERT(p.next_edge_ns == p.start_ns && p.next_edge_idx == 0, "first armed edge is the rolled start");
+
+    avb_perout_configure(&p, 20 * NS_PER_SEC, NS_PER_SEC, 0, 1, now);
+    TEST_ASSERT(p.start_ns == 20 * NS_PER_SEC, "future start unchanged");
+
+    avb_perout_configure(&p, now + AVB_PEROUT_REARM_GUARD_NS, NS_PER_SEC, 0, 1, now);
+    TEST_ASSERT(p.start_ns == now + AVB_PEROUT_REARM_GUARD_NS, "start exactly at now + guard unchanged");
+
+    avb_perout_configure(&p, now + AVB_PEROUT_REARM_GUARD_NS - 1, NS_PER_SEC, 0, 1, now);
+    TEST_ASSERT(p.start_ns == now + AVB_PEROUT_REARM_GUARD_NS - 1 + NS_PER_SEC, "start 1 ns inside guard moved one period");
+}
+
+static void test_edge_numbering(void)
+{
+    avb_perout_t p;
+
+    TEST_CASE("TC-PEROUT-004: edge numbering");
+    avb_perout_configure(&p, 2 * NS_PER_SEC, NS_PER_SEC, 200 * NS_PER_MS, 0, 0);
+    TEST_ASSERT(avb_perout_edge_ns(&p, 0) == 2000 * NS_PER_MS, "edge 0 rising at start");
+    TEST_ASSERT(avb_perout_edge_ns(&p, 1) == 2200 * NS_PER_MS, "edge 1 falling at start + high");
+    TEST_ASSERT(avb_perout_edge_ns(&p, 2) == 3000 * NS_PER_MS, "edge 2 rising at start + period");
+    TEST_ASSERT(avb_perout_edge_ns(&p, 7) == 5200 * NS_PER_MS, "edge 7 falling at start + 3 periods + high");
+}
+
+static void test_sw_on_time(void)
+{
+    avb_perout_t p;
+    uint64_t k;
+    int ok = 1;
+
+    TEST_CASE("TC-PEROUT-005: SW_REARM on-time re-arm");
+    avb_perout_configure(&p, NS_PER_SEC, NS_PER_SEC, 100 * NS_PER_MS, 0, 0);
+    TEST_ASSERT(avb_perout_advance(&p, NS_PER_SEC - 1) == 0 && p.edges == 0, "no re-arm before the armed edge");
+
+    for (k = 0; k < 20; k++) {
+        uint64_t edge = p.next_edge_ns;
+        uint64_t late = 1000 + 50 * k;                       /* poll latency grows */
+        if (avb_perout_advance(&p, edge + late) != 1 || p.next_edge_idx != k + 1 ||
+            p.next_edge_ns != avb_perout_edge_ns(&p, k + 1)) {
+            ok = 0;
+        }
+    }
+    TEST_ASSERT(ok, "every edge re-armed to its successor");
+    TEST_ASSERT(p.edges == 20 && p.missed == 0, "20 edges, 0 missed");
+    TEST_ASSERT(p.max_rearm_latency_ns == 1000 + 50 * 19, "max re-arm latency tracked");
+    TEST_ASSERT(avb_perout_advance(&p, p.next_edge_ns - 1) == 0, "no double re-arm before the next edge");
+}
+
+static void test_sw_late(void)
+{
+    avb_perout_t p;
+    uint64_t now;
+
+    TEST_CASE("TC-PEROUT-006: SW_REARM late re-arm");
+    avb_perout_configure(&p, NS_PER_SEC, NS_PER_SEC, 100 * NS_PER_MS, 0, 0);
+
+    /* Edge 0 (rising, 1.0 s) fired; poll only runs at 4.6 s */
+    now = 4 * NS_PER_SEC + 600 * NS_PER_MS;
+    TEST_ASSERT(avb_perout_advance(&p, now) == 1, "late poll re-arms");
+    TEST_ASSERT((p.next_edge_idx & 1u) == 1, "next armed edge is a falling edge (pin is high)");
+    TEST_ASSERT(p.next_edge_ns == 5 * NS_PER_SEC + 100 * NS_PER_MS, "next edge 5.1 s (first falling edge after now)");
+    TEST_ASSERT(p.missed == 8 && (p.missed & 1u) == 0, "edges 1..8 skipped (even count)");
+    TEST_ASSERT(p.max_rearm_latency_ns == now - NS_PER_SEC, "latency = poll - armed edge");
+
+    /* Edge 9 (falling, 5.1 s) fired; poll lands inside the guard of edge 10 */
+    now = 6 * NS_PER_SEC - AVB_PEROUT_REARM_GUARD_NS / 2;
+    avb_perout_advance(&p, now);
+    TEST_ASSERT(p.next_edge_idx == 12 && p.missed == 8 + 2,
+                "edge 10 inside guard: skip 10/11, arm rising edge 12");
+    TEST_ASSERT(p.next_edge_ns >= now + AVB_PEROUT_REARM_GUARD_NS, "armed edge honours the guard");
+}
+
+static void test_freqout_count(void)
+{
+    avb_perout_t p;
+
+    TEST_CASE("TC-PEROUT-007: FREQOUT edge counting");
+    avb_perout_configure(&p, NS_PER_SEC, NS_PER_SEC, 0, 1, 0);
+    TEST_ASSERT(avb_perout_advance(&p, 10 * NS_PER_SEC + 600 * NS_PER_MS) == 0, "FREQOUT never asks for a re-arm");
+    TEST_ASSERT(p.edges == 20 && p.next_edge_idx == 20, "1.0..10.5 s: 20 edges");
+    TEST_ASSERT(p.next_edge_ns == 11 * NS_PER_SEC, "next edge 11.0 s");
+    TEST_ASSERT(p.missed == 0, "hardware edges are never missed");
+    avb_perout_reset_stats(&p);
+    avb_perout_advance(&p, 12 * NS_PER_SEC);
+    TEST_ASSERT(p.edges == 3, "after reset only edges 11.0, 11.5, 12.0 s counted");
+}
+
+static void test_jitter(void)
+{
+    avb_perout_t p;
+
+    TEST_CASE("TC-PEROUT-008: capture error statistics");
+    avb_perout_configure(&p, NS_PER_SEC, NS_PER_SEC, 200 * NS_PER_MS, 0, 0);
+    TEST_ASSERT(avb_perout_edge_error(&p, 3 * NS_PER_SEC + 37) == 37, "+37 ns after a rising edge");
+    TEST_ASSERT(avb_perout_edge_error(&p, 3 * NS_PER_SEC + 200 * NS_PER_MS - 12) == -12, "-12 ns before a falling edge");
+    TEST_ASSERT(avb_perout_edge_error(&p, 4 * NS_PER_SEC - 5) == -5, "-5 ns before the next period's rising edge");
+    TEST_ASSERT(avb_perout_edge_error(&p, NS_PER_SEC - 9) == -9, "capture before start is negative");
+
+    TEST_ASSERT(p.jitter_samples == 0 && avb_perout_mean_abs_error(&p) == 0, "no samples yet");
+    avb_perout_record_sample(&p, 2 * NS_PER_SEC + 40);
+    avb_perout_record_sample(&p, 2 * NS_PER_SEC + 200 * NS_PER_MS - 20);
+    avb_perout_record_sample(&p, 3 * NS_PER_SEC + 6);
+    TEST_ASSERT(p.jitter_samples == 3 && p.last_err_ns == 6, "3 samples, last +6 ns");
+    TEST_ASSERT(p.min_err_ns == -20 && p.max_err_ns == 40, "min -20 ns, max +40 ns");
+    TEST_ASSERT(avb_perout_mean_abs_error(&p) == 22, "mean |error| (40+20+6)/3 = 22 ns");
+    avb_perout_reset_stats(&p);
+    TEST_ASSERT(p.jitter_samples == 0 && p.period_ns == NS_PER_SEC, "reset clears stats, keeps schedule");
+}
+
+static void test_tssdp(void)
+{
+    uint32_t v, ctrl = 0, ctrl_ext = 0;
+
+    TEST_CASE("TC-PEROUT-009: TSSDP / direction encoding");
+    v = intel_tssdp_route_output(0, 0, 0, 0);
+    TEST_ASSERT(v == INTEL_TSSDP_SDP_EN(0) && v == 0x100u, "SDP0 <- TT0: TS_SDP0_EN only (igb 0x100)");
+    v = intel_tssdp_route_output(0, 2, 1, 1);
+    TEST_ASSERT(v == ((3u << 12) | 0x4000u), "SDP2 <- FREQOUT1: SEL=3 at bit 12, EN bit 14");
+    v = intel_tssdp_route_output(v, 2, 0, 0);
+    TEST_ASSERT(v == 0x4000u, "re-route SDP2 <- TT0 replaces the select field");
+    v = intel_tssdp_route_aux(v, 3, 1);
+    TEST_ASSERT((v & INTEL_TSSDP_AUX1_SEL_MASK) == (3u << 3) && (v & INTEL_TSSDP_AUX1_TS_SDP_EN),
+                "AUX1 <- SDP3 select and enable");
+    v = intel_tssdp_route_output(v, 3, 1, 0);
+    TEST_ASSERT(!(v & INTEL_TSSDP_AUX1_TS_SDP_EN), "driving SDP3 disables its AUX capture");
+    v = intel_tssdp_release_output(v, 3);
+    TEST_ASSERT((v & ~INTEL_TSSDP_AUX1_SEL_MASK) == 0x4000u, "release SDP3 leaves SDP2 routing intact");
+
+    intel_sdp_set_direction(1, 1, &ctrl, &ctrl_ext);
+    intel_sdp_set_direction(3, 1, &ctrl, &ctrl_ext);
+    TEST_ASSERT(ctrl == INTEL_SDP_CTRL_SDP1_DIR && ctrl_ext == INTEL_SDP_CTRL_EXT_SDP3_DIR,
+                "SDP1 -> CTRL bit 23, SDP3 -> CTRL_EXT bit 11");
+    intel_sdp_set_direction(1, 0, &ctrl, &ctrl_ext);
+    TEST_ASSERT(ctrl == 0 && ctrl_ext == INTEL_SDP_CTRL_EXT_SDP3_DIR, "SDP1 back to input");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-PTP-PEROUT-001: Periodic SDP output scheduler\n");
+    printf("  Verifies: REQ-F-PTP-PEROUT-001\n");
+    printf("=======================================================\n");
+
+    test_freqout_ok();
+    test_mode_selection();
+    test_roll_forward();
+    test_edge_numbering();
+    test_sw_on_time();
+    test_sw_late();
+    test_freqout_count();
+    test_jitter();
+    test_tssdp();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
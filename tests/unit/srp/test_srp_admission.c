@@ -0,0 +1,349 @@
+/**
+ * @file test_srp_admission.c
+ * @brief Unit tests for SRP stream admission and CBS derivation
+ *
+ * Test ID: TEST-SRP-ADMIT-001
+ * Verifies: REQ-F-SRP-003 (SRP admission control and CBS derivation)
+ * Unit under test: src/srp_admission.c (pure C, compiled unchanged into the driver)
+ *
+ * Test Cases:
+ *   TC-SRP-ADMIT-001: wire bandwidth = MaxIntervalFrames * (frame + 42) * 8 * intervals/s
+ *   TC-SRP-ADMIT-002: Class A fills to 75% of 1 Gb/s, next stream refused, table unchanged
+ *   TC-SRP-ADMIT-003: Class B shares the cumulative 75% and constrains Class A in turn
+ *   TC-SRP-ADMIT-004: link rate change - admitted streams kept, headroom recomputed
+ *   TC-SRP-ADMIT-005: largest-frame tracking follows registration and release
+ *   TC-SRP-ADMIT-006: class shaper idleSlope / Annex L hiCredit
+ *   TC-SRP-ADMIT-007: 4096 mixed register/deregister cycles return to an empty port
+ *   TC-SRP-ADMIT-008: invalid parameters and unmatched releases change nothing
+ *   TC-SRP-ADMIT-009: TSpec change - refused re-admission keeps the old charge exactly
+ *
+ * Build (Windows): cl /nologo /W4 /Zi -I . -I src tests/unit/srp/test_srp_admission.c src/srp_admission.c
+ * Build (Linux):   cc -O2 -Wall -Wextra -I . -I src tests/unit/srp/test_srp_admission.c src/srp_admission.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../../../src/srp_admission.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define GBPS        1000000000ull
+#define MBPS        1000000ull
+
+/* 8-channel 48 kHz AAF stream: 224-octet frames, one per interval */
+#define AUDIO_FRAME     224u
+#define AUDIO_A_BPS     17024000ull     /* (224 + 42) * 8 * 8000 */
+#define AUDIO_B_BPS     8512000ull      /* (224 + 42) * 8 * 4000 */
+
+static void test_stream_bps(void)
+{
+    TEST_CASE("TC-SRP-ADMIT-001: per-stream wire bandwidth");
+
+    TEST_ASSERT(avb_srp_stream_bps(0, 1, AUDIO_FRAME) == AUDIO_A_BPS,
+                "Class A, 1 frame/interval of 224 octets = 17.024 Mb/s");
+    TEST_ASSERT(avb_srp_stream_bps(1, 1, AUDIO_FRAME) == AUDIO_B_BPS,
+                "Class B, 1 frame/interval of 224 octets = 8.512 Mb/s");
+    TEST_ASSERT(avb_srp_stream_bps(0, 224ull * 8u * 8000u * 3u, AUDIO_FRAME) == 3u * AUDIO_A_BPS,
+                "payload of exactly 3 frames/interval charges 3 frames");
+    TEST_ASSERT(avb_srp_stream_bps(0, 224ull * 8u * 8000u * 3u + 1u, AUDIO_FRAME) == 4u * AUDIO_A_BPS,
+                "one bit more rounds up to 4 frames/interval");
+    TEST_ASSERT(avb_srp_stream_bps(0, 2 * MBPS, 1500) == 1542ull * 8u * 8000u,
+                "2 Mb/s in 1500-octet frames still costs one full frame per 125 us");
+}
+
+static void test_class_a_limit(void)
+{
+    avb_srp_admission_t a;
+    uint64_t r = 0;
+    int i, admitted = 0;
+
+    TEST_CASE("TC-SRP-ADMIT-002: Class A 75% limit");
+
+    avb_srp_init(&a, GBPS);
+    TEST_ASSERT(avb_srp_available_bps(&a, 0) == 750 * MBPS, "empty port: 750 Mb/s available to Class A");
+
+    for (i = 0; i < 100; i++) {
+        if (avb_srp_admit(&a, 0, 1, AUDIO_FRAME, &r) != AVB_SRP_OK) {
+            break;
+        }
+        admitted++;
+    }
+    TEST_ASSERT(admitted == 44, "44 streams of 17.024 Mb/s fit in 750 Mb/s");
+    TEST_ASSERT(a.cls[0].reserved_bps == 44u * AUDIO_A_BPS && a.cls[0].streams == 44,
+                "refused stream left the aggregate unchanged");
+    TEST_ASSERT(a.rejected_bandwidth == 1, "refusal counted");
+    TEST_ASSERT(avb_srp_available_bps(&a, 0) == 944000, "944 kb/s headroom left");
+    TEST_ASSERT(avb_srp_admit(&a, 0, 1, AUDIO_FRAME, &r) == AVB_SRP_E_BANDWIDTH,
+                "over-subscription reported as AVB_SRP_E_BANDWIDTH");
+}
+
+static void test_cumulative(void)
+{
+    avb_srp_admission_t a;
+    uint64_t r = 0;
+    int i;
+
+    TEST_CASE("TC-SRP-ADMIT-003: cumulative Class A + B limit");
+
+    avb_srp_init(&a, GBPS);
+    for (i = 0; i < 44; i++) {
+        avb_srp_admit(&a, 0, 1, AUDIO_FRAME, &r);
+    }
+    TEST_ASSERT(avb_srp_admit(&a, 1, 1, AUDIO_FRAME, &r) == AVB_SRP_E_BANDWIDTH,
+                "Class B refused: A already holds 749 of the shared 750 Mb/s");
+
+    avb_srp_release(&a, 0, AUDIO_FRAME, AUDIO_A_BPS);
+    TEST_ASSERT(avb_srp_available_bps(&a, 1) == 17968000, "one A stream released: 17.968 Mb/s for B");
+    TEST_ASSERT(avb_srp_admit(&a, 1, 1, AUDIO_FRAME, &r) == AVB_SRP_OK &&
+                avb_srp_admit(&a, 1, 1, AUDIO_FRAME, &r) == AVB_SRP_OK,
+                "two Class B streams admitted");
+    TEST_ASSERT(avb_srp_admit(&a, 1, 1, AUDIO_FRAME, &r) == AVB_SRP_E_BANDWIDTH,
+                "third Class B stream refused");
+    TEST_ASSERT(avb_srp_available_bps(&a, 0) == 944000,
+                "Class A headroom limited by A+B <= 75%, not A <= 75%");
+    TEST_ASSERT(avb_srp_admit(&a, 0, 1, AUDIO_FRAME, &r) == AVB_SRP_E_BANDWIDTH,
+                "Class A refused because of Class B usage");
+}
+
+static void test_port_rate_change(void)
+{
+    avb_srp_admission_t a;
+    uint64_t r = 0;
+    int i, admitted = 0;
+
+    TEST_CASE("TC-SRP-ADMIT-004: link rate change");
+
+    avb_srp_init(&a, 100 * MBPS);
+    for (i = 0; i < 10; i++) {
+        if (avb_srp_admit(&a, 0, 1, AUDIO_FRAME, &r) == AVB_SRP_OK) admitted++;
+    }
+    TEST_ASSERT(admitted == 4, "100 Mb/s: 4 streams fit in 75 Mb/s");
+
+    avb_srp_set_port_rate(&a, GBPS);
+    TEST_ASSERT(avb_srp_admit(&a, 0, 1, AUDIO_FRAME, &r) == AVB_SRP_OK, "1 Gb/s: fifth stream admitted");
+
+    avb_srp_set_port_rate(&a, 10 * MBPS);
+    TEST_ASSERT(a.cls[0].streams == 5, "rate drop keeps admitted streams");
+    TEST_ASSERT(avb_srp_available_bps(&a, 0) == 0 && avb_srp_available_bps(&a, 1) == 0,
+                "no headroom while over the new limit");
+
+    avb_srp_set_port_rate(&a, 0);
+    TEST_ASSERT(avb_srp_admit(&a, 1, 1, AUDIO_FRAME, &r) == AVB_SRP_E_BANDWIDTH,
+                "no link rate: nothing can be admitted");
+}
+
+static void test_max_frame(void)
+{
+    avb_srp_admission_t a;
+    uint64_t r_small = 0, r_big = 0;
+
+    TEST_CASE("TC-SRP-ADMIT-005: largest-frame tracking");
+
+    avb_srp_init(&a, GBPS);
+    TEST_ASSERT(avb_srp_max_frame_bytes(&a, 0) == 0, "empty class: 0");
+
+    avb_srp_admit(&a, 0, 1, AUDIO_FRAME, &r_small);
+    avb_srp_admit(&a, 0, 1, 1500, &r_big);
+    TEST_ASSERT(avb_srp_max_frame_bytes(&a, 0) >= 1542 && avb_srp_max_frame_bytes(&a, 0) < 1542 + 32,
+                "1500-octet stream: >= 1542 wire octets, within one bucket");
+
+    avb_srp_release(&a, 0, 1500, r_big);
+    TEST_ASSERT(avb_srp_max_frame_bytes(&a, 0) >= AUDIO_FRAME + 42 &&
+                avb_srp_max_frame_bytes(&a, 0) < AUDIO_FRAME + 42 + 32,
+                "released: falls back to the 224-octet stream");
+
+    avb_srp_release(&a, 0, AUDIO_FRAME, r_small);
+    TEST_ASSERT(avb_srp_max_frame_bytes(&a, 0) == 0 && a.cls[0].reserved_bps == 0,
+                "all released: class empty");
+}
+
+static void test_shaper(void)
+{
+    avb_srp_admission_t a;
+    uint64_t r = 0;
+    uint32_t idle, hi;
+
+    TEST_CASE("TC-SRP-ADMIT-006: derived class shaper");
+
+    avb_srp_init(&a, GBPS);
+    avb_srp_class_shaper(&a, 0, &idle, &hi);
+    TEST_ASSERT(idle == 0 && hi == 0, "empty class: shaper off");
+
+    avb_srp_admit(&a, 0, 1, AUDIO_FRAME, &r);
+    avb_srp_admit(&a, 0, 1, AUDIO_FRAME, &r);
+    avb_srp_admit(&a, 1, 1, AUDIO_FRAME, &r);
+
+    avb_srp_class_shaper(&a, 0, &idle, &hi);
+    TEST_ASSERT(idle == 4256000, "Class A idleSlope = 34.048 Mb/s = 4256000 B/s");
+    TEST_ASSERT(hi == 52, "Class A hiCredit = ceil(1522 * 34.048M / 1G) = 52");
+
+    avb_srp_class_shaper(&a, 1, &idle, &hi);
+    TEST_ASSERT(idle == 1064000, "Class B idleSlope = 8.512 Mb/s = 1064000 B/s");
+    TEST_ASSERT(hi == 16, "Class B hiCredit = ceil((1522 + 288) * 8.512M / (1G - 34.048M)) = 16");
+
+    avb_srp_admit(&a, 0, 1, 1500, &r);
+    avb_srp_class_shaper(&a, 1, &idle, &hi);
+    TEST_ASSERT(hi > 16, "larger Class A frame raises the Class B hiCredit");
+
+    avb_srp_release(&a, 1, AUDIO_FRAME, AUDIO_B_BPS);
+    avb_srp_class_shaper(&a, 1, &idle, &hi);
+    TEST_ASSERT(idle == 0 && hi == 0, "last Class B stream released: shaper off");
+}
+
+static void test_churn(void)
+{
+    static uint64_t reserved[4096];
+    static uint32_t frame[4096], cls[4096];
+    avb_srp_admission_t a;
+    uint32_t x = 0x12345678u, i, live = 0, admitted = 0, refused = 0;
+    int ok = 1;
+
+    TEST_CASE("TC-SRP-ADMIT-007: register/deregister churn");
+
+    avb_srp_init(&a, 2500 * MBPS);
+    for (i = 0; i < 4096; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        cls[i]   = x & 1u;
+        frame[i] = 64u + (x >> 8) % (AVB_SRP_MAX_FRAME_BYTES - 63u);
+        if (avb_srp_admit(&a, cls[i], 1 + (x >> 20), frame[i], &reserved[i]) == AVB_SRP_OK) {
+            admitted++;
+            live++;
+        } else {
+            reserved[i] = 0;
+            refused++;
+        }
+        /* Retire an older stream every other step */
+        if ((i & 1u) && reserved[i / 2]) {
+            avb_srp_release(&a, cls[i / 2], frame[i / 2], reserved[i / 2]);
+            reserved[i / 2] = 0;
+            live--;
+        }
+        if (avb_srp_available_bps(&a, 0) > 2500 * MBPS / 100 * 75) {
+            ok = 0;
+        }
+    }
+    TEST_ASSERT(admitted > 0 && refused > 0, "churn both admitted and refused streams");
+    TEST_ASSERT(ok, "headroom never exceeded the 75% limit");
+    TEST_ASSERT(a.cls[0].streams + a.cls[1].streams == live, "stream count matches live set");
+
+    for (i = 0; i < 4096; i++) {
+        if (reserved[i]) {
+            avb_srp_release(&a, cls[i], frame[i], reserved[i]);
+        }
+    }
+    TEST_ASSERT(a.cls[0].reserved_bps == 0 && a.cls[1].reserved_bps == 0 &&
+                a.cls[0].streams == 0 && a.cls[1].streams == 0,
+                "all released: aggregates back to zero");
+    TEST_ASSERT(avb_srp_available_bps(&a, 0) == 1875 * MBPS, "full 75% of 2.5 Gb/s available again");
+}
+
+static void test_invalid(void)
+{
+    avb_srp_admission_t a;
+    uint64_t r = 12345;
+
+    TEST_CASE("TC-SRP-ADMIT-008: invalid input");
+
+    avb_srp_init(&a, GBPS);
+    TEST_ASSERT(avb_srp_admit(&a, 2, 1, AUDIO_FRAME, &r) == AVB_SRP_E_PARAM, "class 2 rejected");
+    TEST_ASSERT(avb_srp_admit(&a, 0, 0, AUDIO_FRAME, &r) == AVB_SRP_E_PARAM, "zero bandwidth rejected");
+    TEST_ASSERT(avb_srp_admit(&a, 0, 1, 0, &r) == AVB_SRP_E_PARAM, "zero frame size rejected");
+    TEST_ASSERT(avb_srp_admit(&a, 0, 1, AVB_SRP_MAX_FRAME_BYTES + 1, &r) == AVB_SRP_E_PARAM,
+                "oversized frame rejected");
+    TEST_ASSERT(r == 12345 && a.rejected_bandwidth == 0, "parameter errors leave outputs and counters alone");
+
+    avb_srp_admit(&a, 0, 1, AUDIO_FRAME, &r);
+    avb_srp_release(&a, 0, 1500, r);
+    avb_srp_release(&a, 1, AUDIO_FRAME, r);
+    TEST_ASSERT(a.cls[0].streams == 1 && a.cls[0].reserved_bps == AUDIO_A_BPS && a.cls[1].streams == 0,
+                "releases not matching an admitted stream are ignored");
+}
+
+static void test_readmit(void)
+{
+    avb_srp_admission_t a;
+    uint64_t r = 0, keep;
+    uint32_t max_frame;
+
+    TEST_CASE("TC-SRP-ADMIT-009: TSpec change");
+
+    avb_srp_init(&a, GBPS);
+    avb_srp_admit(&a, 0, 1, AUDIO_FRAME, &r);
+    TEST_ASSERT(avb_srp_readmit(&a, 0, AUDIO_FRAME, 0, 224ull * 8u * 8000u * 2u, AUDIO_FRAME, &r) == AVB_SRP_OK &&
+                r == 2u * AUDIO_A_BPS && a.cls[0].streams == 1 && a.cls[0].reserved_bps == 2u * AUDIO_A_BPS,
+                "two frames per interval: charge doubled, still one stream");
+
+    keep = r;
+    max_frame = avb_srp_max_frame_bytes(&a, 0);
+    TEST_ASSERT(avb_srp_readmit(&a, 0, AUDIO_FRAME, 0, 800u * MBPS, 1500, &r) == AVB_SRP_E_BANDWIDTH &&
+                r == keep && a.cls[0].streams == 1 && a.cls[0].reserved_bps == keep &&
+                avb_srp_max_frame_bytes(&a, 0) == max_frame && a.rejected_bandwidth == 1,
+                "over the limit: refused, old charge and reservation untouched");
+    TEST_ASSERT(avb_srp_readmit(&a, 0, AUDIO_FRAME, 0, 1, 0, &r) == AVB_SRP_E_PARAM &&
+                r == keep && a.cls[0].reserved_bps == keep && a.rejected_bandwidth == 1,
+                "invalid new TSpec: refused, nothing changed");
+
+    avb_srp_set_port_rate(&a, 10 * MBPS);
+    TEST_ASSERT(avb_srp_readmit(&a, 0, AUDIO_FRAME, 0, 1, AUDIO_FRAME, &r) == AVB_SRP_E_BANDWIDTH &&
+                r == keep && a.cls[0].streams == 1 && a.cls[0].reserved_bps == keep &&
+                avb_srp_max_frame_bytes(&a, 0) == max_frame,
+                "after a rate drop the old charge is kept although it no longer fits");
+
+    avb_srp_set_port_rate(&a, GBPS);
+    TEST_ASSERT(avb_srp_readmit(&a, 0, AUDIO_FRAME, 1, 1, AUDIO_FRAME, &r) == AVB_SRP_OK &&
+                r == AUDIO_B_BPS && a.cls[0].streams == 0 && a.cls[0].reserved_bps == 0 &&
+                a.cls[1].streams == 1 && a.cls[1].reserved_bps == AUDIO_B_BPS,
+                "class change A -> B: the charge moves with the stream");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-SRP-ADMIT-001: SRP admission control\n");
+    printf("  Verifies: REQ-F-SRP-003\n");
+    printf("=======================================================\n");
+
+    test_stream_bps();
+    test_class_a_limit();
+    test_cumulative();
+    test_port_rate_change();
+    test_max_frame();
+    test_shaper();
+    test_churn();
+    test_invalid();
+    test_readmit();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file test_launch_time.c
+ * @brief Per-frame launch time: the LaunchTime descriptor window
+ *
+ * Test ID: TEST-LAUNCH-TIME-002
+ * Verifies: REQ-F-LAUNCH-002 (Per-packet launch time)
+ * Unit under test: src/launch_time.c
+ *
+ * Test Cases:
+ *   TC-LT-001: I210 - lead, 0.5 s horizon
+ *   TC-LT-002: I225/I226 default 1 s cycle - current and next cycle
+ *   TC-LT-003: cycle taken from the Qbv switch state (idle, active, staged, armed)
+ *   TC-LT-004: adapters without LaunchTime report NO_HW
+ *   TC-LT-005: randomized - accepted exactly inside lead .. horizon
+ *
+ * Portable C99: builds with cl.exe (Windows) and gcc/clang (Linux):
+ *   cl /nologo /W4 /O2 -I src tests\unit\tsn\test_launch_time.c src\launch_time.c src\tas_switch.c
+ *   cc -O2 -Wall -Wextra -I src -o test_launch_time tests/unit/tsn/test_launch_time.c src/launch_time.c src/tas_switch.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "launch_time.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define US      1000ull
+#define MS      1000000ull
+#define SEC     1000000000ull
+
+static avb_lt_params_t params(uint32_t format, uint64_t base, uint32_t cycle)
+{
+    avb_lt_params_t p;
+    p.format        = format;
+    p.min_lead_ns   = AVB_LT_DEFAULT_LEAD_NS;
+    p.cycle_base_ns = base;
+    p.cycle_ns      = cycle;
+    p.reserved      = 0;
+    return p;
+}
+
+static void test_i210(void)
+{
+    avb_lt_params_t p = params(AVB_LT_FMT_I210, 0, 0);
+    uint64_t now = 3 * SEC - 100 * MS;
+
+    TEST_CASE("TC-LT-001: I210");
+    TEST_ASSERT(avb_lt_check(&p, now, now + 19 * US) == AVB_LT_LATE,
+                "19 us ahead with a 20 us lead: LATE");
+    TEST_ASSERT(avb_lt_check(&p, now, now - 1) == AVB_LT_LATE, "in the past: LATE");
+    TEST_ASSERT(avb_lt_check(&p, now, 3 * SEC + 320) == AVB_LT_OK, "3.000000320 s, across the second: OK");
+    TEST_ASSERT(avb_lt_check(&p, now, now + 500 * MS - 1) == AVB_LT_OK &&
+                avb_lt_check(&p, now, now + 500 * MS) == AVB_LT_BEYOND,
+                "horizon: < now + 0.5 s accepted, now + 0.5 s rejected");
+    TEST_ASSERT(avb_lt_horizon(&p, now) == now + 500 * MS - 1, "avb_lt_horizon = now + 0.5 s - 1");
+}
+
+static void test_igc_default(void)
+{
+    avb_lt_params_t p = params(AVB_LT_FMT_IGC, 0, AVB_LT_IGC_DEFAULT_CYCLE_NS);
+    uint64_t now = 5 * SEC + 200 * MS;
+
+    TEST_CASE("TC-LT-002: I225/I226, default cycle");
+    TEST_ASSERT(avb_lt_check(&p, now, 5 * SEC + 700 * MS) == AVB_LT_OK, "same cycle: OK");
+    TEST_ASSERT(avb_lt_check(&p, now, 6 * SEC + 100 * MS) == AVB_LT_OK, "next cycle: OK");
+    TEST_ASSERT(avb_lt_check(&p, now, 7 * SEC - 1) == AVB_LT_OK &&
+                avb_lt_check(&p, now, 7 * SEC) == AVB_LT_BEYOND,
+                "horizon is the end of the next cycle");
+    TEST_ASSERT(avb_lt_horizon(&p, now) == 7 * SEC - 1, "avb_lt_horizon = 7 s - 1");
+}
+
+static void test_from_switch(void)
+{
+    avb_tas_switch_t sw;
+    uint64_t base = 1;
+    uint32_t cycle = 0;
+
+    TEST_CASE("TC-LT-003: cycle from the Qbv switch state");
+    avb_tas_switch_init(&sw);
+    avb_lt_cycle(&sw, 10 * SEC, &base, &cycle);
+    TEST_ASSERT(base == 0 && cycle == AVB_LT_IGC_DEFAULT_CYCLE_NS, "no gate list: 1 s cycle from 0");
+
+    avb_tas_switch_commit(&sw, 0, 250 * US, 11 * SEC, 10 * SEC, 10 * SEC);
+    avb_lt_cycle(&sw, 10 * SEC + 1, &base, &cycle);
+    TEST_ASSERT(base == 0 && cycle == AVB_LT_IGC_DEFAULT_CYCLE_NS, "first list pending: still the default");
+    avb_lt_cycle(&sw, 11 * SEC + 5, &base, &cycle);
+    TEST_ASSERT(base == 11 * SEC && cycle == 250 * US, "pending list past its CCT: the new cycle");
+
+    avb_tas_switch_poll(&sw, 12 * SEC);
+    avb_tas_switch_stage(&sw, 0, 400 * US, 13 * SEC, 13 * SEC - 1 * MS);
+    avb_lt_cycle(&sw, 12 * SEC + 5, &base, &cycle);
+    TEST_ASSERT(base == 11 * SEC && cycle == 250 * US, "switch staged: the running list until the stop");
+    avb_tas_switch_commit(&sw, 0, 400 * US, 13 * SEC, 13 * SEC - 1 * MS, 13 * SEC - 1 * MS);
+    avb_lt_cycle(&sw, 13 * SEC - 1 * MS + 5, &base, &cycle);
+    TEST_ASSERT(base == 0 && cycle == AVB_LT_IGC_DEFAULT_CYCLE_NS,
+                "stopped at the stop time: default until the CCT");
+    avb_lt_cycle(&sw, 13 * SEC, &base, &cycle);
+    TEST_ASSERT(base == 13 * SEC && cycle == 400 * US, "at the CCT: admin cycle");
+
+    {
+        avb_lt_params_t p = params(AVB_LT_FMT_IGC, base, cycle);
+        TEST_ASSERT(avb_lt_check(&p, 13 * SEC + 100 * US, 13 * SEC + 700 * US) == AVB_LT_OK,
+                    "400 us cycle: 700 us lands in the next cycle");
+        TEST_ASSERT(avb_lt_check(&p, 12 * SEC + 900 * MS, 12 * SEC + 950 * MS) == AVB_LT_BEYOND,
+                    "before the first cycle of the new list: BEYOND");
+        TEST_ASSERT(avb_lt_check(&p, 13 * SEC + 100 * US, 13 * SEC + 800 * US) == AVB_LT_BEYOND,
+                    "two cycles ahead: BEYOND");
+    }
+}
+
+static void test_no_hw(void)
+{
+    avb_lt_params_t p = params(AVB_LT_FMT_NONE, 0, 0);
+
+    TEST_CASE("TC-LT-004: no LaunchTime hardware");
+    TEST_ASSERT(avb_lt_check(&p, SEC, SEC + MS) == AVB_LT_NO_HW, "format NONE: NO_HW");
+    TEST_ASSERT(avb_lt_horizon(&p, SEC) == 0, "no horizon");
+}
+
+static void test_random(void)
+{
+    uint32_t x = 0x6B43A9B5u, i, accepted = 0;
+    int ok = 1;
+
+    TEST_CASE("TC-LT-005: randomized window");
+    for (i = 0; i < 200000u; i++) {
+        avb_lt_params_t p;
+        uint64_t now, launch;
+        int rc;
+
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        p = params((x & 1u) ? AVB_LT_FMT_IGC : AVB_LT_FMT_I210,
+                   (uint64_t)(x % 7u) * SEC + (x >> 3) % 1000u, 10u * (uint32_t)US + (x >> 7) % (900u * (uint32_t)MS));
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        now = 10u * SEC + (uint64_t)x * 17u;
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        launch = now + (uint64_t)x % (2u * SEC);
+
+        rc = avb_lt_check(&p, now, launch);
+        if (launch < now + p.min_lead_ns) {
+            ok &= (rc == AVB_LT_LATE);
+            continue;
+        }
+        ok &= (rc == AVB_LT_OK) == (launch <= avb_lt_horizon(&p, now));
+        accepted += (rc == AVB_LT_OK);
+    }
+    TEST_ASSERT(ok, "accepted iff lead <= launch - now and launch <= horizon");
+    TEST_ASSERT(accepted > 10000u, "a good share of the samples accepted");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-LAUNCH-TIME-002: per-frame launch time window\n");
+    printf("  Verifies: REQ-F-LAUNCH-002\n");
+    printf("=======================================================\n");
+
+    test_i210();
+    test_igc_default();
+    test_from_switch();
+    test_no_hw();
+    test_random();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,295 @@
+/**
+ * @file test_lt_pacer.c
+ * @brief Software launch-time pacer: time-ordered queue and release accounting
+ *
+ * Test ID: TEST-LAUNCH-PACER-001
+ * Verifies: REQ-F-LAUNCH-003 (Software launch-time pacing)
+ * Unit under test: src/lt_pacer.c
+ *
+ * The clock is simulated; the "timer" wakes at avb_pacer_wakeup() plus a
+ * latency, as the driver's high-resolution timer does.
+ *
+ * Test Cases:
+ *   TC-PACER-001: release order - launch time, then arrival order on ties
+ *   TC-PACER-002: nothing released before launch time - early_ns
+ *   TC-PACER-003: queue limit and hold horizon
+ *   TC-PACER-004: release error statistics and histogram buckets
+ *   TC-PACER-005: flush returns every held frame in order
+ *   TC-PACER-006: randomized traffic on a simulated clock - exactly once, in order
+ *   TC-PACER-007: each item's tag (the NDIS port) is reported for the head it travels with
+ *
+ * Portable C99: builds with cl.exe (Windows) and gcc/clang (Linux):
+ *   cl /nologo /W4 /O2 -I src tests\unit\tsn\test_lt_pacer.c src\lt_pacer.c
+ *   cc -O2 -Wall -Wextra -I src -o test_lt_pacer tests/unit/tsn/test_lt_pacer.c src/lt_pacer.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lt_pacer.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define US      1000ull
+#define MS      1000000ull
+#define SEC     1000000000ull
+
+#define CAPACITY    1024u
+
+static avb_pacer_entry_t s_heap[CAPACITY];
+static int s_frames[CAPACITY * 4];
+
+static void test_order(void)
+{
+    avb_pacer_t p;
+    static const uint64_t launch[8] = { 500, 100, 300, 100, 900, 300, 100, 700 };
+    static const int expect[8] = { 1, 3, 6, 2, 5, 0, 7, 4 };
+    int i, ok = 1;
+
+    TEST_CASE("TC-PACER-001: release order");
+    avb_pacer_init(&p, s_heap, CAPACITY, 0, 0);
+    for (i = 0; i < 8; i++) {
+        s_frames[i] = i;
+        avb_pacer_enqueue(&p, 0, launch[i] * US, &s_frames[i], 0);
+    }
+    TEST_ASSERT(avb_pacer_next(&p) == 100 * US && p.count == 8, "head is the earliest launch time");
+    for (i = 0; i < 8; i++) {
+        int *f = (int *)avb_pacer_pop_due(&p, SEC);
+        ok &= (f != NULL && *f == expect[i]);
+    }
+    TEST_ASSERT(ok, "released by launch time; equal launch times keep arrival order");
+    TEST_ASSERT(avb_pacer_pop_due(&p, SEC) == NULL && avb_pacer_next(&p) == AVB_PACER_NONE,
+                "empty queue: nothing due, next = NONE");
+}
+
+static void test_due(void)
+{
+    avb_pacer_t p;
+
+    TEST_CASE("TC-PACER-002: release time");
+    avb_pacer_init(&p, s_heap, CAPACITY, 0, 0);
+    avb_pacer_enqueue(&p, 0, 10 * MS, &s_frames[0], 0);
+    TEST_ASSERT(avb_pacer_pop_due(&p, 10 * MS - 1) == NULL, "1 ns before launch: held");
+    TEST_ASSERT(avb_pacer_pop_due(&p, 10 * MS) == &s_frames[0], "at launch: released");
+
+    avb_pacer_init(&p, s_heap, CAPACITY, 0, 50 * (uint32_t)US);
+    avb_pacer_enqueue(&p, 0, 10 * MS, &s_frames[0], 0);
+    TEST_ASSERT(avb_pacer_wakeup(&p) == 10 * MS - 50 * US, "wakeup = launch - early_ns");
+    TEST_ASSERT(avb_pacer_pop_due(&p, 10 * MS - 51 * US) == NULL &&
+                avb_pacer_pop_due(&p, 10 * MS - 50 * US) == &s_frames[0],
+                "early_ns 50 us: released 50 us ahead, not earlier");
+    TEST_ASSERT(p.st.err_min_ns == -50000 && p.st.err_max_ns == -50000, "early release recorded as -50 us");
+}
+
+static void test_limits(void)
+{
+    avb_pacer_t p;
+    uint32_t i;
+    int ok = 1;
+
+    TEST_CASE("TC-PACER-003: queue limit and hold horizon");
+    avb_pacer_init(&p, s_heap, 4, 100 * MS, 0);
+    for (i = 0; i < 4; i++) {
+        ok &= avb_pacer_enqueue(&p, 0, (i + 1u) * MS, &s_frames[i], 0) == AVB_PACER_QUEUED;
+    }
+    TEST_ASSERT(ok, "four frames fit a four-entry queue");
+    TEST_ASSERT(avb_pacer_enqueue(&p, 0, 5 * MS, &s_frames[4], 0) == AVB_PACER_FULL && p.st.dropped_full == 1,
+                "fifth frame: FULL");
+    avb_pacer_pop_due(&p, 1 * MS);
+    TEST_ASSERT(avb_pacer_enqueue(&p, 1 * MS, 101 * MS + 1, &s_frames[5], 0) == AVB_PACER_BEYOND &&
+                p.st.dropped_horizon == 1,
+                "launch more than max_hold_ns ahead: BEYOND");
+    TEST_ASSERT(avb_pacer_enqueue(&p, 1 * MS, 101 * MS, &s_frames[5], 0) == AVB_PACER_QUEUED,
+                "exactly max_hold_ns ahead: queued");
+    TEST_ASSERT(p.st.held == 5 && p.st.max_depth == 4, "held / max_depth counters");
+}
+
+static void test_stats(void)
+{
+    avb_pacer_t p;
+
+    TEST_CASE("TC-PACER-004: release error statistics");
+    avb_pacer_init(&p, s_heap, CAPACITY, 0, 0);
+    avb_pacer_enqueue(&p, 0, 1 * MS, &s_frames[0], 0);
+    avb_pacer_enqueue(&p, 0, 2 * MS, &s_frames[1], 0);
+    avb_pacer_enqueue(&p, 0, 3 * MS, &s_frames[2], 0);
+    avb_pacer_enqueue(&p, 0, 4 * MS, &s_frames[3], 0);
+    avb_pacer_pop_due(&p, 1 * MS + 500);            /* 0.5 us late */
+    avb_pacer_pop_due(&p, 2 * MS + 3 * US);         /* 3 us */
+    avb_pacer_pop_due(&p, 3 * MS + 600 * US);       /* 600 us */
+    avb_pacer_pop_due(&p, 4 * MS + 100 * MS);       /* 100 ms */
+    TEST_ASSERT(p.st.released == 4 && p.st.err_min_ns == 500 && p.st.err_max_ns == (int64_t)(100 * MS),
+                "min 0.5 us, max 100 ms");
+    TEST_ASSERT(avb_pacer_mean_abs_error(&p) == (500 + 3 * US + 600 * US + 100 * MS) / 4, "mean |error|");
+    TEST_ASSERT(p.st.hist[0] == 1 && p.st.hist[2] == 1 && p.st.hist[10] == 1 &&
+                p.st.hist[AVB_PACER_HIST_BUCKETS - 1u] == 1,
+                "buckets: <1 us, [2,4) us, [512,1024) us, open-ended last");
+
+    avb_pacer_reset_stats(&p);
+    TEST_ASSERT(p.st.released == 0 && p.st.hist[10] == 0 && avb_pacer_mean_abs_error(&p) == 0, "reset clears");
+}
+
+static void test_flush(void)
+{
+    avb_pacer_t p;
+    int i, ok = 1;
+
+    TEST_CASE("TC-PACER-005: flush");
+    avb_pacer_init(&p, s_heap, CAPACITY, 0, 0);
+    for (i = 0; i < 10; i++) {
+        s_frames[i] = i;
+        avb_pacer_enqueue(&p, 0, (uint64_t)(10 - i) * MS, &s_frames[i], 0);
+    }
+    for (i = 9; i >= 0; i--) {
+        int *f = (int *)avb_pacer_pop_any(&p);
+        ok &= (f != NULL && *f == i);
+    }
+    TEST_ASSERT(ok && p.count == 0 && p.st.flushed == 10 && p.st.released == 0,
+                "all ten returned in launch order, counted as flushed, no release error recorded");
+}
+
+/* Ports 0, 3, 0, 5, 3, ... */
+static uint32_t port_of(uint32_t i)
+{
+    return (i % 3u == 1u) ? 3u : (i % 4u == 3u) ? 5u : 0u;
+}
+
+static void test_tags(void)
+{
+    avb_pacer_t p;
+    uint32_t tag = 77, i;
+    int ok = 1;
+
+    TEST_CASE("TC-PACER-007: tags");
+    avb_pacer_init(&p, s_heap, CAPACITY, 0, 0);
+    TEST_ASSERT(!avb_pacer_head_tag(&p, &tag) && tag == 77, "empty queue: no head tag");
+
+    /* Queued out of launch order: frame i launches at (7 i mod 12) ms */
+    for (i = 0; i < 12u; i++) {
+        s_frames[i] = (int)i;
+        avb_pacer_enqueue(&p, 0, (uint64_t)((i * 7u) % 12u) * MS, &s_frames[i], port_of(i));
+    }
+    for (i = 0; i < 12u; i++) {
+        int *f;
+        ok &= avb_pacer_head_tag(&p, &tag);
+        f = (int *)((i % 2u) ? avb_pacer_pop_any(&p) : avb_pacer_pop_due(&p, 1 * SEC));
+        ok &= f != NULL && (uint32_t)((*f * 7) % 12) == i && tag == port_of((uint32_t)*f);
+    }
+    TEST_ASSERT(ok && p.count == 0, "head tag matches the item popped next, through reordering");
+}
+
+static void test_random(void)
+{
+    avb_pacer_t p;
+    uint64_t now = 1 * SEC, last_launch = 0, lost = 0, sent = 0, err_sum = 0;
+    int64_t err_max = INT64_MIN;
+    uint32_t x = 0x1D872B41u, i, n = 0, done = 0;
+    int ok = 1;
+    static uint64_t launch_of[CAPACITY * 4];
+    static uint8_t  seen[CAPACITY * 4];
+
+    TEST_CASE("TC-PACER-006: randomized traffic, simulated clock");
+    avb_pacer_init(&p, s_heap, CAPACITY, 200 * MS, 20 * (uint32_t)US);
+    memset(seen, 0, sizeof(seen));
+
+    for (i = 0; i < 200000u; i++) {
+        uint64_t wake;
+        void *f;
+
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        if ((x & 3u) != 0 && n < CAPACITY * 4u) {
+            /* Sender: a frame for 0..3 ms ahead */
+            s_frames[n] = (int)n;
+            launch_of[n] = now + (x >> 4) % (3u * (uint32_t)MS);
+            if (avb_pacer_enqueue(&p, now, launch_of[n], &s_frames[n], 0) != AVB_PACER_QUEUED) {
+                lost++;
+            }
+            n++;
+            now += (x >> 20) % 50u * US;
+            continue;
+        }
+        /* Timer: wakes at the head's wakeup time plus 0..600 us latency */
+        wake = avb_pacer_wakeup(&p);
+        if (wake == AVB_PACER_NONE) {
+            continue;
+        }
+        if (wake > now) {
+            now = wake;
+        }
+        now += (x >> 8) % 600u * US;
+        while ((f = avb_pacer_pop_due(&p, now)) != NULL) {
+            int id = *(int *)f;
+            ok &= !seen[id] && launch_of[id] >= last_launch && now + p.early_ns >= launch_of[id];
+            seen[id] = 1;
+            last_launch = launch_of[id];
+            err_sum += (now > launch_of[id]) ? now - launch_of[id] : launch_of[id] - now;
+            if ((int64_t)(now - launch_of[id]) > err_max) {
+                err_max = (int64_t)(now - launch_of[id]);
+            }
+            sent++;
+        }
+        if (n == CAPACITY * 4u && p.count == 0) {
+            done = 1;
+            break;
+        }
+    }
+    while (avb_pacer_pop_due(&p, AVB_PACER_NONE - 1u) != NULL) {
+        sent++;
+    }
+
+    TEST_ASSERT(ok, "each frame released once, in launch order, never before launch - early_ns");
+    TEST_ASSERT(done && sent + lost == n && p.st.released == sent && lost == 0,
+                "every queued frame released; none dropped at 1024 entries");
+    TEST_ASSERT(p.st.err_abs_sum_ns == err_sum && p.st.err_max_ns == err_max &&
+                p.st.err_min_ns >= -(int64_t)p.early_ns,
+                "error statistics match the simulated clock; none earlier than early_ns");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-LAUNCH-PACER-001: software launch-time pacer\n");
+    printf("  Verifies: REQ-F-LAUNCH-003\n");
+    printf("=======================================================\n");
+
+    test_order();
+    test_due();
+    test_limits();
+    test_stats();
+    test_flush();
+    test_random();
+    test_tags();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,278 @@
+/**
+ * @file test_tas_analysis.c
+ * @brief Offline 802.1Qbv schedule analysis (tas_analyze)
+ *
+ * Test ID: TEST-TAS-ANALYSIS-001
+ * Verifies: REQ-F-TAS-002 (TAS schedule compilation and validation)
+ * Unit under test: tools/tas_analyzer/tas_analysis.c
+ *
+ * Test Cases:
+ *   TC-TAS-AN-001: queue open all cycle - full rate, delay = one frame
+ *   TC-TAS-AN-002: exclusive windows - guard band, bandwidth, delay, timeline
+ *   TC-TAS-AN-003: strict priority - unshaped higher queue blocks, lower frame blocks
+ *   TC-TAS-AN-004: CBS above - idleSlope share, Annex L hiCredit burst, override
+ *   TC-TAS-AN-005: window across the cycle boundary
+ *   TC-TAS-AN-006: guard band measured to the gate close, not to the blocking queue
+ *   TC-TAS-AN-007: randomized schedules - time accounting and bounds hold
+ *
+ * Portable C99: builds with cl.exe (Windows) and gcc/clang (Linux):
+ *   cl /nologo /W4 /O2 tests\unit\tsn\test_tas_analysis.c tools\tas_analyzer\tas_analysis.c src\tas_gcl.c
+ *   cc -O2 -Wall -Wextra -o test_tas_analysis tests/unit/tsn/test_tas_analysis.c tools/tas_analyzer/tas_analysis.c src/tas_gcl.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../../../tools/tas_analyzer/tas_analysis.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define LINK_1G     1000000000ull
+#define FRAME_10US  1250u           /* 10 us at 1 Gb/s */
+
+static avb_tas_caps_t s_caps;
+static avb_tas_qos_t  s_qos;
+
+static void reset(uint32_t queues)
+{
+    uint32_t q;
+
+    s_caps.queues            = queues;
+    s_caps.max_entries       = AVB_TAS_MAX_ENTRIES;
+    s_caps.min_interval_ns   = 0;
+    s_caps.max_cycle_ns      = 1000000000u;
+    s_caps.windows_per_queue = 0;
+    s_caps.window_wrap       = 1;
+    memset(&s_qos, 0, sizeof(s_qos));
+    s_qos.link_bps = LINK_1G;
+    for (q = 0; q < queues; q++) {
+        s_qos.frame_bytes[q] = FRAME_10US;
+    }
+}
+
+static int run(const uint8_t *g, const uint32_t *t, uint32_t n, avb_tas_schedule_t *s, avb_tas_report_t *r)
+{
+    if (avb_tas_compile(&s_caps, NULL, g, t, n, 0, s, NULL) != AVB_TAS_OK) {
+        return 0;
+    }
+    avb_tas_analyze(s, &s_qos, r);
+    return 1;
+}
+
+static void test_always_open(void)
+{
+    static const uint8_t  g[1] = {0x01};
+    static const uint32_t t[1] = {100000};
+    avb_tas_schedule_t s;
+    avb_tas_report_t r;
+
+    reset(1);
+    TEST_CASE("TC-TAS-AN-001: open all cycle");
+    TEST_ASSERT(run(g, t, 1, &s, &r) && r.q[0].windows == 1 && r.q[0].guard_band_ns == 0 &&
+                r.q[0].usable_ns == 100000 && r.q[0].guaranteed_bps == LINK_1G,
+                "no guard band, full link rate");
+    TEST_ASSERT(r.q[0].worst_delay_ns == 10000, "worst-case delay is the frame's own 10 us");
+}
+
+static void test_exclusive(void)
+{
+    static const uint8_t  g[2] = {0x01, 0x02};
+    static const uint32_t t[2] = {50000, 50000};
+    avb_tas_schedule_t s;
+    avb_tas_report_t r;
+    char row[11];
+
+    reset(2);
+    TEST_CASE("TC-TAS-AN-002: exclusive windows");
+    TEST_ASSERT(run(g, t, 2, &s, &r) && r.q[0].guard_band_ns == 10000 && r.q[0].usable_ns == 40000 &&
+                r.q[0].blocked_ns == 0,
+                "50 us window: last 10 us are guard band");
+    TEST_ASSERT(r.q[0].guaranteed_bps == 400000000ull && r.q[1].guaranteed_bps == 400000000ull,
+                "guaranteed 400 Mb/s each (40 of 100 us)");
+    TEST_ASSERT(r.q[0].worst_delay_ns == 70000,
+                "worst delay 70 us: arrive at 40 us, wait 60 us, send 10 us");
+    avb_tas_timeline(&s, &s_qos, 0, row, 10);
+    TEST_ASSERT(strcmp(row, "####g.....") == 0, "timeline Q0 ####g.....");
+    avb_tas_timeline(&s, &s_qos, 1, row, 10);
+    TEST_ASSERT(strcmp(row, ".....####g") == 0, "timeline Q1 .....####g");
+}
+
+static void test_priority(void)
+{
+    static const uint8_t  g[1] = {0x03};
+    static const uint32_t t[1] = {100000};
+    avb_tas_schedule_t s;
+    avb_tas_report_t r;
+    char row[5];
+
+    reset(2);
+    TEST_CASE("TC-TAS-AN-003: strict priority");
+    TEST_ASSERT(run(g, t, 1, &s, &r) && r.q[1].blocked_ns == 100000 && r.q[1].usable_ns == 0 &&
+                r.q[1].guaranteed_bps == 0 && r.q[1].worst_delay_ns == AVB_TAS_DELAY_UNBOUNDED,
+                "q1 below an unshaped q0 with the same window: no guarantee, unbounded delay");
+    TEST_ASSERT(r.q[0].worst_delay_ns == 20000 && r.q[0].guaranteed_bps == 900000000ull,
+                "q0: one q1 frame already on the wire + own frame = 20 us; 90 of 100 us guaranteed");
+    avb_tas_timeline(&s, &s_qos, 1, row, 4);
+    TEST_ASSERT(strcmp(row, "----") == 0, "timeline Q1 ----");
+    s_qos.frame_bytes[1] = 0;
+    avb_tas_analyze(&s, &s_qos, &r);
+    TEST_ASSERT(r.q[0].worst_delay_ns == 10000 && r.q[0].guaranteed_bps == LINK_1G,
+                "q1 without traffic neither blocks q0 nor costs it bandwidth");
+}
+
+static void test_cbs(void)
+{
+    static const uint8_t  g[1] = {0x03};
+    static const uint32_t t[1] = {100000};
+    avb_tas_schedule_t s;
+    avb_tas_report_t r;
+
+    reset(2);
+    s_qos.idle_slope_Bps[0] = 12500000u;    /* 100 Mb/s */
+    TEST_CASE("TC-TAS-AN-004: CBS on the higher queue");
+    TEST_ASSERT(run(g, t, 1, &s, &r) && r.q[0].guaranteed_bps == 100000000ull && r.q[0].hi_credit_bytes == 125,
+                "q0 capped at idleSlope; hiCredit = 1250 B x 100M/1G = 125 B (Annex L class A)");
+    TEST_ASSERT(r.q[1].blocked_ns == 0 && r.q[1].guaranteed_bps == 900000000ull,
+                "q1 no longer blocked: link minus q0's idleSlope");
+    TEST_ASSERT(r.q[1].worst_delay_ns == 21000,
+                "q1 delay: q0 burst hiCredit + frame (1375 B = 11 us) + own 10 us");
+    s_qos.hi_credit_bytes[0] = 500;
+    avb_tas_analyze(&s, &s_qos, &r);
+    TEST_ASSERT(r.q[0].hi_credit_bytes == 500 && r.q[1].worst_delay_ns == 24000,
+                "explicit hiCredit 500 B: q1 delay 14 + 10 us");
+}
+
+static void test_wrap(void)
+{
+    static const uint8_t  g[3] = {0x01, 0x00, 0x01};
+    static const uint32_t t[3] = {20000, 60000, 20000};
+    avb_tas_schedule_t s;
+    avb_tas_report_t r;
+    char row[11];
+
+    reset(1);
+    TEST_CASE("TC-TAS-AN-005: window across the cycle boundary");
+    TEST_ASSERT(run(g, t, 3, &s, &r) && r.q[0].windows == 1 && r.q[0].guard_band_ns == 10000 &&
+                r.q[0].usable_ns == 30000,
+                "open 80..100 and 0..20 us: one 40 us window, one guard band");
+    TEST_ASSERT(r.q[0].worst_delay_ns == 80000, "worst delay 80 us: arrive at 10 us, next start at 80 us");
+    avb_tas_timeline(&s, &s_qos, 0, row, 10);
+    TEST_ASSERT(strcmp(row, "#g......##") == 0, "timeline Q0 #g......##");
+}
+
+static void test_guard_to_close(void)
+{
+    static const uint8_t  g[3] = {0x02, 0x03, 0x00};
+    static const uint32_t t[3] = {20000, 30000, 50000};
+    avb_tas_schedule_t s;
+    avb_tas_report_t r;
+
+    reset(2);
+    TEST_CASE("TC-TAS-AN-006: guard band up to the gate close");
+    TEST_ASSERT(run(g, t, 3, &s, &r) && r.q[1].usable_ns == 20000 && r.q[1].guard_band_ns == 0 &&
+                r.q[1].blocked_ns == 30000,
+                "q1 eligible 0..20 us, gate open until 50 us: a 10 us frame fits, no guard band");
+    TEST_ASSERT(r.q[0].worst_delay_ns == 110000,
+                "q0: miss at 30 us, next window at 120 us, a q1 frame on the wire + own = 110 us");
+    s_qos.frame_bytes[1] = 4000;            /* 32 us */
+    avb_tas_analyze(&s, &s_qos, &r);
+    TEST_ASSERT(r.q[1].guard_band_ns == 2000 && r.q[1].usable_ns == 18000,
+                "32 us frame: must start by 18 us to end at the 50 us close");
+    TEST_ASSERT(r.q[0].worst_delay_ns == AVB_TAS_DELAY_UNBOUNDED,
+                "q0: a 32 us q1 frame started at 18 us fills q0's 30 us window - unbounded");
+}
+
+static void test_random(void)
+{
+    uint32_t x = 0x5EED1234u, iter, ok = 1, analyzed = 0;
+
+    TEST_CASE("TC-TAS-AN-007: randomized schedules");
+    for (iter = 0; iter < 20000; iter++) {
+        avb_tas_schedule_t s;
+        avb_tas_report_t r;
+        uint8_t g[12];
+        uint32_t t[12], n, i, q;
+
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        reset(1u + x % AVB_TAS_MAX_QUEUES);
+        n = 1u + (x >> 8) % 12u;
+        s_qos.link_bps = (x & 0x10000u) ? 2500000000ull : 100000000ull;
+        for (q = 0; q < s_caps.queues; q++) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            s_qos.frame_bytes[q]    = (x & 7u) ? 64u + x % 1500u : 0;
+            s_qos.idle_slope_Bps[q] = (x & 0x300u) == 0x100u ? 1000000u + (x >> 12) % 10000000u : 0;
+        }
+        for (i = 0; i < n; i++) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            g[i] = (uint8_t)x;
+            t[i] = 1000u + (x >> 8) % 50000u;
+        }
+        if (!run(g, t, n, &s, &r)) {
+            continue;
+        }
+        analyzed++;
+        for (q = 0; q < s.queues; q++) {
+            const avb_tas_queue_report_t *qr = &r.q[q];
+            uint32_t frame = avb_tas_frame_ns(s_qos.frame_bytes[q], s_qos.link_bps);
+
+            if (qr->usable_ns + qr->guard_band_ns + qr->blocked_ns != qr->open_ns ||
+                qr->guaranteed_bps > s_qos.link_bps * qr->usable_ns / s.cycle_ns ||
+                (qr->worst_delay_ns != AVB_TAS_DELAY_UNBOUNDED &&
+                 (qr->worst_delay_ns < frame || qr->worst_delay_ns > 2ull * s.cycle_ns + 64000000ull)) ||
+                (qr->usable_ns == 0 && qr->worst_delay_ns != AVB_TAS_DELAY_UNBOUNDED)) {
+                ok = 0;
+            }
+        }
+    }
+    TEST_ASSERT(ok && analyzed > 1000,
+                "usable + guard + blocked = open; bandwidth within usable time; delay >= one frame");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-TAS-ANALYSIS-001: 802.1Qbv schedule analysis\n");
+    printf("  Verifies: REQ-F-TAS-002\n");
+    printf("=======================================================\n");
+
+    test_always_open();
+    test_exclusive();
+    test_priority();
+    test_cbs();
+    test_wrap();
+    test_guard_to_close();
+    test_random();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
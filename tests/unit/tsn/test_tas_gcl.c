@@ -0,0 +1,442 @@
+/**
+ * @file test_tas_gcl.c
+ * @brief 802.1Qbv GCL compiler / validator
+ *
+ * Test ID: TEST-TAS-GCL-002
+ * Verifies: REQ-F-TAS-002 (TAS schedule compilation and validation)
+ * Unit under test: src/tas_gcl.c
+ *
+ * Test Cases:
+ *   TC-TAS-GCL-001: AVB_TAS_CONFIG_* templates compile for I225/I226 (masked, merged)
+ *   TC-TAS-GCL-002: normalization - zero entries dropped, merge, cycle 0, stretch, src
+ *   TC-TAS-GCL-003: cycle shorter than the intervals / above the device maximum
+ *   TC-TAS-GCL-004: windows per queue, wrap-around windows, window enumeration
+ *   TC-TAS-GCL-005: starvation and guard band against the largest frame
+ *   TC-TAS-GCL-006: entry limits, minimum interval, bad arguments
+ *   TC-TAS-GCL-007: randomized inputs - invariants of every result (fuzz)
+ *
+ * Portable C99: builds with cl.exe (Windows) and gcc/clang (Linux):
+ *   cl /nologo /W4 /O2 -I . -I src tests\unit\tsn\test_tas_gcl.c src\tas_gcl.c
+ *   cc -O2 -Wall -Wextra -I . -I src -o test_tas_gcl tests/unit/tsn/test_tas_gcl.c src/tas_gcl.c
+ *
+ * libFuzzer (Linux, clang): the same invariants on fuzzer-provided input
+ *   clang -g -O1 -fsanitize=fuzzer,address,undefined -DAVB_TAS_GCL_FUZZER \
+ *         -I . -I src tests/unit/tsn/test_tas_gcl.c src/tas_gcl.c -o fuzz_tas_gcl
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../../../src/tas_gcl.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define MAX_INPUT   64u
+
+/* ---------------------------------------------------------------------------
+ * Invariants every compile result must satisfy (shared with the fuzzer)
+ * --------------------------------------------------------------------------- */
+static int check_invariants(const avb_tas_caps_t *caps, const avb_tas_traffic_t *traffic,
+                            const uint8_t *gates, const uint32_t *intervals, uint32_t n,
+                            uint64_t cycle_ns, avb_tas_result_t rc,
+                            const avb_tas_schedule_t *s, const avb_tas_diag_t *d)
+{
+    uint64_t sum = 0, in_sum = 0;
+    uint32_t i, q;
+
+    if (d->code != rc) {
+        return 0;
+    }
+    if (rc != AVB_TAS_OK) {
+        if (d->entry != AVB_TAS_NO_ENTRY && d->entry >= n) {
+            return 0;
+        }
+        if (d->queue != AVB_TAS_NO_QUEUE && d->queue >= caps->queues) {
+            return 0;
+        }
+        return 1;
+    }
+
+    for (i = 0; i < n; i++) {
+        in_sum += intervals[i];
+    }
+    if (s->count == 0 || s->count > caps->max_entries || s->cycle_ns > caps->max_cycle_ns) {
+        return 0;
+    }
+    if (s->cycle_ns != (cycle_ns ? cycle_ns : in_sum)) {
+        return 0;
+    }
+    for (i = 0; i < s->count; i++) {
+        const avb_tas_entry_t *e = &s->entries[i];
+        if (e->interval_ns == 0 || e->interval_ns < caps->min_interval_ns || e->src >= n ||
+            (e->gates >> caps->queues) != 0 || (i > 0 && e->gates == s->entries[i - 1u].gates) ||
+            e->gates != (gates[e->src] & ((1u << caps->queues) - 1u))) {
+            return 0;
+        }
+        sum += e->interval_ns;
+    }
+    if (sum != s->cycle_ns) {
+        return 0;
+    }
+    for (q = 0; q < caps->queues; q++) {
+        avb_tas_window_t w[AVB_TAS_MAX_ENTRIES];
+        uint32_t k, nw = avb_tas_queue_windows(s, q, w, AVB_TAS_MAX_ENTRIES);
+        uint64_t open = 0;
+        uint32_t frame_ns = traffic ? avb_tas_frame_ns(traffic->max_frame_bytes[q], traffic->link_bps) : 0;
+
+        if (nw != s->windows[q] || (caps->windows_per_queue && nw > caps->windows_per_queue)) {
+            return 0;
+        }
+        for (k = 0; k < nw; k++) {
+            open += w[k].length_ns;
+            if (w[k].length_ns == 0 || w[k].start_ns >= s->cycle_ns || w[k].length_ns < frame_ns ||
+                (!caps->window_wrap && w[k].start_ns + w[k].length_ns > s->cycle_ns)) {
+                return 0;
+            }
+        }
+        if (open != s->open_ns[q] || (frame_ns && open == 0)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Decode a byte string into caps, traffic and a GCL; returns entries */
+static uint32_t decode_input(const uint8_t *data, size_t size, avb_tas_caps_t *caps, avb_tas_traffic_t *traffic,
+                             uint8_t *gates, uint32_t *intervals, uint64_t *cycle_ns, int *use_traffic)
+{
+    uint32_t i, n;
+
+    memset(caps, 0, sizeof(*caps));
+    memset(traffic, 0, sizeof(*traffic));
+    if (size < 8) {
+        return 0;
+    }
+    caps->queues            = 1u + data[0] % AVB_TAS_MAX_QUEUES;
+    caps->max_entries       = 1u + data[1] % AVB_TAS_MAX_ENTRIES;
+    caps->min_interval_ns   = (data[2] & 0x80) ? (uint32_t)(data[2] & 0x7F) * 100u : 0;
+    caps->max_cycle_ns      = (data[3] & 1) ? 1000000000u : 100000u + (uint32_t)data[3] * 10000u;
+    caps->windows_per_queue = data[4] % 4u;
+    caps->window_wrap       = data[4] & 0x10;
+    *use_traffic = data[5] & 1;
+    traffic->link_bps = (data[5] & 2) ? 2500000000ull : 100000000ull;
+    for (i = 0; i < AVB_TAS_MAX_QUEUES; i++) {
+        traffic->max_frame_bytes[i] = ((data[6] >> i) & 1) ? 64u + (uint32_t)data[7] * 6u : 0;
+    }
+    *cycle_ns = (data[2] & 0x40) ? 0 : (uint64_t)data[3] * 997u * 13u;
+    data += 8;
+    size -= 8;
+    n = (uint32_t)(size / 3u);
+    if (n > MAX_INPUT) {
+        n = MAX_INPUT;
+    }
+    for (i = 0; i < n; i++) {
+        gates[i]     = data[3u * i];
+        intervals[i] = ((uint32_t)data[3u * i + 1u] << 8 | data[3u * i + 2u]) * ((data[0] & 0x80) ? 1u : 37u);
+    }
+    return n;
+}
+
+#ifdef AVB_TAS_GCL_FUZZER
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    avb_tas_caps_t caps;
+    avb_tas_traffic_t traffic;
+    avb_tas_schedule_t s;
+    avb_tas_diag_t d;
+    uint8_t gates[MAX_INPUT];
+    uint32_t intervals[MAX_INPUT];
+    uint64_t cycle;
+    int use_traffic;
+    uint32_t n = decode_input(data, size, &caps, &traffic, gates, intervals, &cycle, &use_traffic);
+    avb_tas_result_t rc;
+
+    if (caps.queues == 0) {
+        return 0;
+    }
+    rc = avb_tas_compile(&caps, use_traffic ? &traffic : NULL, gates, intervals, n, cycle, &s, &d);
+    if (!check_invariants(&caps, use_traffic ? &traffic : NULL, gates, intervals, n, cycle, rc, &s, &d)) {
+        __builtin_trap();
+    }
+    return 0;
+}
+
+#else
+
+/* src/tsn_config.c */
+static const uint8_t  k_audio_gates[8] = {0xC0, 0xFF, 0x3F};
+static const uint32_t k_audio_dur[8]   = {31250, 62500, 31250};
+static const uint8_t  k_video_gates[8] = {0xE0, 0xFF, 0x1F};
+static const uint32_t k_video_dur[8]   = {125000, 100000, 25000};
+static const uint8_t  k_ind_gates[8]   = {0x80, 0xC0, 0xFF, 0x7F, 0x3F};
+static const uint32_t k_ind_dur[8]     = {12500, 12500, 25000, 6250, 6250};
+static const uint8_t  k_mixed_gates[8] = {0xE0, 0xFF};
+static const uint32_t k_mixed_dur[8]   = {200000, 800000};
+
+static void test_templates(void)
+{
+    avb_tas_caps_t caps;
+    avb_tas_schedule_t s;
+    avb_tas_diag_t d;
+
+    avb_tas_caps_i225(&caps);
+    TEST_CASE("TC-TAS-GCL-001: AVB_TAS_CONFIG_* on I225/I226");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, k_audio_gates, k_audio_dur, 3, 125000, &s, &d) == AVB_TAS_OK &&
+                s.count == 2 && s.entries[0].interval_ns == 31250 && s.entries[0].gates == 0 &&
+                s.entries[1].interval_ns == 93750 && s.entries[1].gates == 0x0F && s.entries[1].src == 1 &&
+                s.ignored_gates == 0xF0 && d.code == AVB_TAS_OK,
+                "AUDIO: TC 4-7 bits masked off, entries 1+2 merged (all four queues open 93.75 us)");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, k_video_gates, k_video_dur, 3, 250000, &s, &d) == AVB_TAS_OK &&
+                s.count == 2 && s.open_ns[0] == 125000 && s.windows[3] == 1,
+                "VIDEO: closed 125 us, then one 125 us window per queue");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, k_ind_gates, k_ind_dur, 5, 62500, &s, &d) == AVB_TAS_OK &&
+                s.count == 2 && s.entries[0].interval_ns == 25000 && s.entries[1].src == 2,
+                "INDUSTRIAL: five entries normalize to two");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, k_mixed_gates, k_mixed_dur, 2, 1000000, &s, &d) == AVB_TAS_OK &&
+                s.open_ns[2] == 800000,
+                "MIXED: queues open 800 us of 1 ms");
+}
+
+static void test_normalize(void)
+{
+    static const uint8_t  g[6] = {0x01, 0x02, 0x03, 0x03, 0x01, 0x01};
+    static const uint32_t t[6] = {1000, 0, 2000, 3000, 0, 4000};
+    avb_tas_caps_t caps = { 8, 32, 0, 1000000000u, 0, 0 };
+    avb_tas_schedule_t s;
+    avb_tas_diag_t d;
+
+    TEST_CASE("TC-TAS-GCL-002: normalization");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 6, 0, &s, &d) == AVB_TAS_OK && s.count == 3 &&
+                s.cycle_ns == 10000,
+                "zero entries dropped, 0x03 pair merged, cycle 0 = 10 us");
+    TEST_ASSERT(s.entries[0].src == 0 && s.entries[1].src == 2 && s.entries[2].src == 5 &&
+                s.entries[1].interval_ns == 5000,
+                "src points at the first input entry of each merged run");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 6, 12000, &s, &d) == AVB_TAS_OK &&
+                s.entries[2].interval_ns == 6000 && s.open_ns[0] == 12000 && s.open_ns[1] == 5000,
+                "cycle 12 us: last entry stretched by 2 us");
+}
+
+static void test_cycle(void)
+{
+    static const uint8_t  g[3] = {0x01, 0x02, 0x04};
+    static const uint32_t t[3] = {40000, 40000, 40000};
+    avb_tas_caps_t caps;
+    avb_tas_schedule_t s;
+    avb_tas_diag_t d;
+
+    avb_tas_caps_i225(&caps);
+    TEST_CASE("TC-TAS-GCL-003: cycle checks");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 3, 100000, &s, &d) == AVB_TAS_E_CYCLE_SHORT &&
+                d.value == 100000 && d.limit == 120000,
+                "120 us of intervals in a 100 us cycle: CYCLE_SHORT (100000 vs 120000)");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 3, 2000000000ull, &s, &d) == AVB_TAS_E_CYCLE_RANGE &&
+                d.value == 2000000000ull && d.limit == 1000000000u,
+                "2 s cycle on I225: CYCLE_RANGE");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 3, 120000, &s, &d) == AVB_TAS_OK,
+                "intervals exactly filling the cycle are accepted");
+}
+
+static void test_windows(void)
+{
+    static const uint8_t  split[4] = {0x01, 0x02, 0x01, 0x02};
+    static const uint8_t  wrap[3]  = {0x01, 0x02, 0x01};
+    static const uint32_t t[4]     = {1000, 2000, 3000, 4000};
+    avb_tas_caps_t caps;
+    avb_tas_schedule_t s;
+    avb_tas_diag_t d;
+    avb_tas_window_t w[4];
+
+    avb_tas_caps_i225(&caps);
+    TEST_CASE("TC-TAS-GCL-004: windows per queue");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, split, t, 4, 0, &s, &d) == AVB_TAS_E_WINDOWS &&
+                d.queue == 0 && d.entry == 2 && d.value == 2 && d.limit == 1,
+                "I225: q0 reopens at entry 2 -> WINDOWS (queue 0, entry 2, 2 vs 1)");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, wrap, t, 3, 0, &s, &d) == AVB_TAS_E_WINDOWS && d.queue == 0,
+                "I225: open at both cycle ends is two windows");
+
+    caps.windows_per_queue = 0;
+    caps.window_wrap = 1;
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, wrap, t, 3, 0, &s, &d) == AVB_TAS_OK && s.windows[0] == 1 &&
+                avb_tas_queue_windows(&s, 0, w, 4) == 1 && w[0].start_ns == 3000 && w[0].length_ns == 4000,
+                "list-driven gates with wrap: one 4 us window from 3 us across the boundary");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, split, t, 4, 0, &s, &d) == AVB_TAS_OK && s.windows[0] == 2 &&
+                avb_tas_queue_windows(&s, 0, w, 4) == 2 && w[0].start_ns == 0 && w[1].start_ns == 3000 &&
+                avb_tas_queue_windows(&s, 1, w, 1) == 2 && w[0].start_ns == 1000,
+                "unlimited windows: q0 at 0 and 3 us; count reported beyond max");
+}
+
+static void test_traffic(void)
+{
+    static const uint8_t  g[3] = {0x01, 0x02, 0x0C};
+    static const uint32_t t[3] = {12000, 13000, 100000};
+    avb_tas_caps_t caps;
+    avb_tas_traffic_t tr;
+    avb_tas_schedule_t s;
+    avb_tas_diag_t d;
+
+    avb_tas_caps_i225(&caps);
+    memset(&tr, 0, sizeof(tr));
+    tr.link_bps = 1000000000ull;
+    tr.max_frame_bytes[0] = 1542;   /* 1500-byte SDU + 42 bytes framing: 12336 ns at 1 Gb/s */
+
+    TEST_CASE("TC-TAS-GCL-005: starvation and guard band");
+    TEST_ASSERT(avb_tas_frame_ns(1542, 1000000000ull) == 12336 && avb_tas_frame_ns(64, 2500000000ull) == 205,
+                "frame wire time rounds up (1542 B @ 1G = 12336 ns, 64 B @ 2.5G = 205 ns)");
+    TEST_ASSERT(avb_tas_compile(&caps, &tr, g, t, 3, 0, &s, &d) == AVB_TAS_E_GUARD_BAND &&
+                d.queue == 0 && d.entry == 0 && d.value == 12000 && d.limit == 12336,
+                "q0 window 12 us < 12.336 us for a full frame: GUARD_BAND");
+    tr.max_frame_bytes[0] = 1400;
+    TEST_ASSERT(avb_tas_compile(&caps, &tr, g, t, 3, 0, &s, &d) == AVB_TAS_OK,
+                "1400-byte frames (11.2 us) fit the same window");
+    tr.max_frame_bytes[1] = 128;
+    tr.max_frame_bytes[3] = 128;
+    tr.max_frame_bytes[2] = 0;
+    TEST_ASSERT(avb_tas_compile(&caps, &tr, g, t, 3, 0, &s, &d) == AVB_TAS_OK,
+                "small frames on q1/q3 accepted");
+    {
+        static const uint8_t g2[2] = {0x01, 0x04};
+        tr.max_frame_bytes[1] = 64;
+        TEST_ASSERT(avb_tas_compile(&caps, &tr, g2, t, 2, 0, &s, &d) == AVB_TAS_E_STARVED && d.queue == 1,
+                    "q1 carries traffic but never opens: STARVED");
+    }
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 3, 0, &s, &d) == AVB_TAS_OK,
+                "without traffic no guard-band check");
+}
+
+static void test_limits(void)
+{
+    uint8_t  g[40];
+    uint32_t t[40], i;
+    avb_tas_caps_t caps;
+    avb_tas_schedule_t s;
+    avb_tas_diag_t d;
+
+    for (i = 0; i < 40; i++) {
+        g[i] = (uint8_t)(i & 1u);
+        t[i] = 1000;
+    }
+    avb_tas_caps_i225(&caps);
+    TEST_CASE("TC-TAS-GCL-006: limits and arguments");
+    caps.windows_per_queue = 0;
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 9, 0, &s, &d) == AVB_TAS_E_TOO_MANY_ENTRIES &&
+                d.value == 9 && d.limit == 8 && d.entry == 8,
+                "9 alternating entries on an 8-entry device (first excess: entry 8)");
+    caps.max_entries = AVB_TAS_MAX_ENTRIES;
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 40, 0, &s, &d) == AVB_TAS_E_TOO_MANY_ENTRIES &&
+                d.entry == 32,
+                "40 distinct entries overflow the 32-entry operational list");
+    memset(g, 0x05, sizeof(g));
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 40, 0, &s, &d) == AVB_TAS_OK && s.count == 1 &&
+                s.cycle_ns == 40000,
+                "40 identical entries merge into one");
+    caps.min_interval_ns = 1500;
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 1, 0, &s, &d) == AVB_TAS_E_INTERVAL_SHORT &&
+                d.entry == 0 && d.value == 1000 && d.limit == 1500,
+                "1 us entry below a 1.5 us minimum: INTERVAL_SHORT");
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 0, 1000, &s, &d) == AVB_TAS_E_EMPTY,
+                "no entries: EMPTY");
+    caps.queues = 9;
+    TEST_ASSERT(avb_tas_compile(&caps, NULL, g, t, 1, 0, &s, &d) == AVB_TAS_E_PARAM &&
+                avb_tas_compile(NULL, NULL, g, t, 1, 0, &s, NULL) == AVB_TAS_E_PARAM,
+                "bad caps / NULL caps: PARAM");
+    TEST_ASSERT(strcmp(avb_tas_result_str(AVB_TAS_E_GUARD_BAND), "window shorter than the queue's largest frame") == 0,
+                "result strings");
+}
+
+static void test_fuzz(void)
+{
+    uint8_t buf[8 + 3 * MAX_INPUT];
+    uint32_t x = 0xC0FFEE11u, iter, ok = 1, accepted = 0;
+    uint32_t seen[AVB_TAS_E_GUARD_BAND + 1];
+
+    memset(seen, 0, sizeof(seen));
+    TEST_CASE("TC-TAS-GCL-007: randomized inputs");
+    for (iter = 0; iter < 200000; iter++) {
+        avb_tas_caps_t caps;
+        avb_tas_traffic_t traffic;
+        avb_tas_schedule_t s;
+        avb_tas_diag_t d;
+        uint8_t gates[MAX_INPUT];
+        uint32_t intervals[MAX_INPUT], n, i;
+        uint64_t cycle;
+        int use_traffic;
+        size_t size = 8u + 3u * (x % 24u);
+        avb_tas_result_t rc;
+
+        for (i = 0; i < size; i++) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            buf[i] = (uint8_t)x;
+        }
+        /* Bias toward few queues and sparse gates so valid schedules are common */
+        buf[0] = (uint8_t)(buf[0] & 0x83);
+        n = decode_input(buf, size, &caps, &traffic, gates, intervals, &cycle, &use_traffic);
+        rc = avb_tas_compile(&caps, use_traffic ? &traffic : NULL, gates, intervals, n, cycle, &s, &d);
+        if (!check_invariants(&caps, use_traffic ? &traffic : NULL, gates, intervals, n, cycle, rc, &s, &d)) {
+            ok = 0;
+        }
+        if ((unsigned)rc <= AVB_TAS_E_GUARD_BAND) {
+            seen[rc]++;
+        }
+        accepted += (rc == AVB_TAS_OK);
+    }
+    printf("  ok=%u empty=%u short=%u range=%u cycle_short=%u entries=%u windows=%u starved=%u guard=%u\n",
+           seen[AVB_TAS_OK], seen[AVB_TAS_E_EMPTY], seen[AVB_TAS_E_INTERVAL_SHORT], seen[AVB_TAS_E_CYCLE_RANGE],
+           seen[AVB_TAS_E_CYCLE_SHORT], seen[AVB_TAS_E_TOO_MANY_ENTRIES], seen[AVB_TAS_E_WINDOWS],
+           seen[AVB_TAS_E_STARVED], seen[AVB_TAS_E_GUARD_BAND]);
+    TEST_ASSERT(ok && accepted > 0, "200000 random inputs: every result satisfies the invariants");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-TAS-GCL-002: Qbv GCL compiler / validator\n");
+    printf("  Verifies: REQ-F-TAS-002\n");
+    printf("=======================================================\n");
+
+    test_templates();
+    test_normalize();
+    test_cycle();
+    test_windows();
+    test_traffic();
+    test_limits();
+    test_fuzz();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
+
+#endif /* AVB_TAS_GCL_FUZZER */
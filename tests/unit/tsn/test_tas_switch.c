@@ -0,0 +1,398 @@
+/**
+ * @file test_tas_switch.c
+ * @brief Qbv admin -> operational schedule switch at the config-change time
+ *
+ * Test ID: TEST-TAS-SWITCH-001
+ * Verifies: REQ-F-TAS-003 (Atomic TAS schedule switch)
+ * Unit under test: src/tas_switch.c
+ *
+ * The PHC is simulated: every SETUP_TAS is modelled the way the I226 path runs
+ * it - poll at the PHC read; with a list running, stage the admin list for
+ * the admin base rolled past "next operational boundary + lead" and stop at
+ * the last operational boundary that leaves the lead; with none running, arm
+ * at once.  The switch timer firing at or after the stop time re-encodes
+ * past "stop + lead" and commits with the PHC read after the registers are
+ * armed.
+ *
+ * Test Cases:
+ *   TC-TAS-SW-001: first start - PENDING until the base time, then ACTIVE
+ *   TC-TAS-SW-002: staged switch - the running list keeps its gates until the stop
+ *   TC-TAS-SW-003: stop time before the CCT, or a late timer cutting a cycle
+ *   TC-TAS-SW-004: programming past the CCT - the gap grows
+ *   TC-TAS-SW-005: a late first start only starts later
+ *   TC-TAS-SW-006: replacing a staged or armed switch
+ *   TC-TAS-SW-007: failures - validation keeps state, register failure -> ERROR
+ *   TC-TAS-SW-008: randomized switch sequence - phase, counters, state hold
+ *
+ * Portable C99: builds with cl.exe (Windows) and gcc/clang (Linux):
+ *   cl /nologo /W4 /O2 -I src tests\unit\tsn\test_tas_switch.c src\tas_switch.c
+ *   cc -O2 -Wall -Wextra -I src -o test_tas_switch tests/unit/tsn/test_tas_switch.c src/tas_switch.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "tas_switch.h"
+
+/* ---------------------------------------------------------------------------
+ * Test framework — matches test_ioctl_abi.c pattern
+ * --------------------------------------------------------------------------- */
+typedef struct {
+    int passed;
+    int failed;
+    int total;
+} TestResults;
+
+static TestResults g_results = {0, 0, 0};
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_results.total++; \
+        if ((condition)) { \
+            printf("  [PASS] %s\n", (message)); \
+            g_results.passed++; \
+        } else { \
+            printf("  [FAIL] %s\n", (message)); \
+            g_results.failed++; \
+        } \
+    } while (0)
+
+#define TEST_CASE(name) printf("\n--- %s ---\n", (name))
+
+#define US          1000ull
+#define MS          1000000ull
+#define LEAD_NS     (1u * MS)       /* I226_QBV_START_LEAD_NS */
+
+static uint64_t roll(uint64_t base, uint64_t cycle, uint64_t t)
+{
+    return (base >= t) ? base : base + ((t - base + cycle - 1u) / cycle) * cycle;
+}
+
+/* One SETUP_TAS at PHC now_ns; returns the CCT.  Arming without a running
+ * list takes prog_ns; staging writes nothing and loses nothing. */
+static uint64_t setup(avb_tas_switch_t *sw, uint64_t now_ns, uint64_t base_ns, uint32_t cycle_ns,
+                      uint64_t prog_ns, uint32_t *lost)
+{
+    uint64_t cct;
+    uint32_t l = 0;
+
+    avb_tas_switch_poll(sw, now_ns);
+    if (avb_tas_switch_running(sw)) {
+        cct = roll(base_ns, cycle_ns, avb_tas_switch_next_boundary(sw, now_ns) + LEAD_NS);
+        avb_tas_switch_stage(sw, base_ns, cycle_ns, cct, avb_tas_switch_stop_time(sw, cct, LEAD_NS));
+    } else {
+        cct = roll(base_ns, cycle_ns, now_ns + LEAD_NS);
+        l = avb_tas_switch_commit(sw, base_ns, cycle_ns, cct, now_ns, now_ns + prog_ns);
+    }
+    if (lost != NULL) {
+        *lost = l;
+    }
+    return cct;
+}
+
+/* The switch timer firing at at_ns: stop, arm past at + lead in prog_ns; returns the CCT */
+static uint64_t apply(avb_tas_switch_t *sw, uint64_t at_ns, uint64_t prog_ns, uint32_t *lost)
+{
+    uint64_t cct = roll(sw->admin_base_ns, sw->admin_cycle_ns, at_ns + LEAD_NS);
+    uint32_t l;
+
+    l = avb_tas_switch_commit(sw, sw->admin_base_ns, sw->admin_cycle_ns, cct, at_ns, at_ns + prog_ns);
+    if (lost != NULL) {
+        *lost = l;
+    }
+    return cct;
+}
+
+static void test_first_start(void)
+{
+    avb_tas_switch_t sw;
+    uint32_t lost = 99;
+
+    TEST_CASE("TC-TAS-SW-001: first start");
+    avb_tas_switch_init(&sw);
+    TEST_ASSERT(sw.state == AVB_TAS_SW_IDLE && !avb_tas_switch_running(&sw), "init: IDLE, nothing running");
+
+    setup(&sw, 5 * MS, 0, 1 * MS, 20 * US, &lost);
+    TEST_ASSERT(sw.state == AVB_TAS_SW_PENDING && sw.config_change_ns == 6 * MS && lost == 0,
+                "base 0 rolled past now + lead: CCT 6 ms, PENDING, nothing lost");
+    TEST_ASSERT(sw.oper_cycle_ns == 0 && sw.config_changes == 0, "no operational list before the CCT");
+
+    avb_tas_switch_poll(&sw, 6 * MS - 1);
+    TEST_ASSERT(sw.state == AVB_TAS_SW_PENDING, "poll 1 ns before the CCT: still PENDING");
+    avb_tas_switch_poll(&sw, 6 * MS);
+    TEST_ASSERT(sw.state == AVB_TAS_SW_ACTIVE && sw.oper_base_ns == 6 * MS &&
+                sw.oper_cycle_ns == 1 * MS && sw.config_changes == 1,
+                "poll at the CCT: ACTIVE, operational = admin, one config change");
+}
+
+static void test_staged_switch(void)
+{
+    avb_tas_switch_t sw;
+    uint32_t lost = 99;
+    uint64_t cct;
+
+    TEST_CASE("TC-TAS-SW-002: staged switch");
+    avb_tas_switch_init(&sw);
+    setup(&sw, 1 * MS, 0, 1 * MS, 20 * US, NULL);
+    avb_tas_switch_poll(&sw, 3 * MS);
+    TEST_ASSERT(avb_tas_switch_next_boundary(&sw, 8500 * US) == 9 * MS &&
+                avb_tas_switch_next_boundary(&sw, 9 * MS) == 9 * MS,
+                "next boundary: 8.5 ms -> 9 ms, a boundary is its own");
+
+    cct = setup(&sw, 5200 * US, 10 * MS, 500 * US, 20 * US, &lost);
+    TEST_ASSERT(cct == 10 * MS && sw.state == AVB_TAS_SW_PENDING && sw.staged && lost == 0,
+                "SETUP_TAS at 5.2 ms for 10 ms: staged, PENDING, nothing lost yet");
+    TEST_ASSERT(sw.stop_ns == 9 * MS, "stop at the last operational boundary 1 ms before the CCT");
+    TEST_ASSERT(avb_tas_switch_running(&sw) && sw.oper_base_ns == 2 * MS && sw.oper_cycle_ns == 1 * MS,
+                "the running list keeps its gates while staged");
+    avb_tas_switch_poll(&sw, 12 * MS);
+    TEST_ASSERT(sw.staged && sw.config_changes == 1,
+                "poll past the CCT does not promote a switch that was never armed");
+
+    apply(&sw, 9 * MS, 20 * US, &lost);
+    TEST_ASSERT(sw.state == AVB_TAS_SW_PENDING && !sw.staged && !avb_tas_switch_running(&sw) && lost == 1,
+                "timer at 9 ms: armed for 10 ms, only the 1 ms lead is lost (one cycle)");
+    avb_tas_switch_poll(&sw, 11 * MS);
+    TEST_ASSERT(sw.state == AVB_TAS_SW_ACTIVE && sw.oper_cycle_ns == 500 * US &&
+                sw.oper_base_ns == 10 * MS && sw.config_changes == 2 && sw.cycles_lost == 1,
+                "after the CCT: new cycle active, two changes, one cycle lost");
+}
+
+static void test_stop_time(void)
+{
+    avb_tas_switch_t sw, late;
+    uint32_t lost = 0;
+    uint64_t cct;
+
+    TEST_CASE("TC-TAS-SW-003: stop time, late timer");
+    avb_tas_switch_init(&sw);
+    setup(&sw, 1 * MS, 0, 1 * MS, 20 * US, NULL);
+    avb_tas_switch_poll(&sw, 2 * MS);
+
+    cct = setup(&sw, 9 * MS + 50 * US, 0, 300 * US, 20 * US, NULL);
+    TEST_ASSERT(cct == 11100 * US && sw.stop_ns == 10 * MS,
+                "at 9.05 ms: CCT = 37 x 300 us = 11.1 ms past 10 ms + lead, stop at 10 ms");
+    TEST_ASSERT(avb_tas_switch_stop_time(&sw, 11 * MS, LEAD_NS) == 10 * MS &&
+                avb_tas_switch_stop_time(&sw, 10999 * US, LEAD_NS) == 9 * MS,
+                "a stop time leaves the whole lead: boundary 10 ms fits 11 ms, not 10.999 ms");
+
+    late = sw;
+    apply(&sw, 10 * MS, 20 * US, &lost);
+    TEST_ASSERT(lost == 2 && sw.config_change_ns == 11100 * US,
+                "on time: [9 ms, 10 ms) completes, [10 ms, 12 ms) starts in the gap: 2 cycles lost");
+
+    apply(&late, 10200 * US, 20 * US, &lost);
+    TEST_ASSERT(late.config_change_ns == 11400 * US && lost == 2,
+                "timer 200 us late: [10 ms, 11 ms) cut at 10.2 ms, CCT moves to 11.4 ms, still 2 lost");
+}
+
+static void test_late_programming(void)
+{
+    avb_tas_switch_t sw;
+    uint32_t lost = 0;
+
+    TEST_CASE("TC-TAS-SW-004: programming finished after the CCT");
+    avb_tas_switch_init(&sw);
+    setup(&sw, 1 * MS, 0, 1 * MS, 20 * US, NULL);
+    avb_tas_switch_poll(&sw, 2 * MS);
+
+    /* Staged at 8.5 ms: stop 9 ms, CCT 10 ms, registers armed at 12.5 ms: hardware starts at 13 ms */
+    setup(&sw, 8500 * US, 0, 1 * MS, 0, NULL);
+    apply(&sw, sw.stop_ns, 3500 * US, &lost);
+    TEST_ASSERT(lost == 4 && sw.config_change_ns == 13 * MS,
+                "2.5 cycles late: start at next boundary 13 ms, gap [9 ms, 13 ms) = 4 cycles lost");
+    TEST_ASSERT(sw.state == AVB_TAS_SW_PENDING, "still PENDING until 13 ms");
+
+    setup(&sw, 20 * MS, 0, 400 * US, 0, NULL);
+    TEST_ASSERT(sw.staged && sw.config_change_ns == 21200 * US && sw.stop_ns == 20 * MS,
+                "staged at 20 ms: CCT 21.2 ms, stop 20 ms");
+    apply(&sw, sw.stop_ns, 1 * MS + 400 * US, &lost);
+    TEST_ASSERT(sw.config_change_ns == 21600 * US && lost == 2,
+                "armed at 21.4 ms: start 21.6 ms, 2 oper cycles lost");
+    TEST_ASSERT(sw.cycles_lost == 6, "cycles_lost accumulates over switches");
+
+    avb_tas_switch_init(&sw);
+    setup(&sw, 1 * MS, 0, 1 * MS, 20 * US, NULL);
+    avb_tas_switch_poll(&sw, 2 * MS);
+    setup(&sw, 8500 * US, 0, 1 * MS, 0, NULL);
+    apply(&sw, sw.stop_ns, 2 * MS, &lost);
+    TEST_ASSERT(sw.state == AVB_TAS_SW_ACTIVE && sw.config_change_ns == 11 * MS && lost == 2,
+                "armed exactly on a later boundary: ACTIVE at once, 2 cycles lost");
+}
+
+static void test_late_first_start(void)
+{
+    avb_tas_switch_t sw;
+    uint32_t lost = 99;
+
+    TEST_CASE("TC-TAS-SW-005: late first start");
+    avb_tas_switch_init(&sw);
+    setup(&sw, 5 * MS, 0, 1 * MS, 3 * MS + 300 * US, &lost);
+    TEST_ASSERT(lost == 0 && sw.cycles_lost == 0 && sw.config_change_ns == 9 * MS,
+                "nothing was running: starts at the next boundary (9 ms), nothing lost");
+}
+
+static void test_replace_pending(void)
+{
+    avb_tas_switch_t sw;
+    uint32_t lost = 99;
+
+    TEST_CASE("TC-TAS-SW-006: replace a staged or armed switch");
+    avb_tas_switch_init(&sw);
+    setup(&sw, 1 * MS, 0, 1 * MS, 20 * US, NULL);
+    avb_tas_switch_poll(&sw, 2 * MS);
+
+    setup(&sw, 5 * MS, 20 * MS, 500 * US, 0, NULL);
+    TEST_ASSERT(sw.staged && sw.config_change_ns == 20 * MS && sw.stop_ns == 19 * MS,
+                "switch staged for 20 ms: the list runs until 19 ms");
+
+    setup(&sw, 6 * MS, 30 * MS, 250 * US, 0, NULL);
+    TEST_ASSERT(sw.staged && sw.config_change_ns == 30 * MS && sw.stop_ns == 29 * MS &&
+                sw.admin_cycle_ns == 250 * US && sw.cycles_lost == 0,
+                "second SETUP_TAS before the stop re-stages for 30 ms: nothing lost by the replacement");
+    avb_tas_switch_poll(&sw, 25 * MS);
+    TEST_ASSERT(sw.state == AVB_TAS_SW_PENDING && sw.oper_cycle_ns == 1 * MS && sw.config_changes == 1,
+                "the replaced switch never takes effect");
+    apply(&sw, 29 * MS, 20 * US, &lost);
+    avb_tas_switch_poll(&sw, 30 * MS);
+    TEST_ASSERT(lost == 1 && sw.oper_cycle_ns == 250 * US && sw.config_changes == 2,
+                "the replacement does, losing only the lead");
+
+    setup(&sw, 40 * MS, 50 * MS, 1 * MS, 0, NULL);
+    setup(&sw, 40 * MS + 10 * US, 0, 1 * MS, 0, NULL);
+    TEST_ASSERT(sw.staged && sw.config_change_ns == 42 * MS && sw.stop_ns == 41 * MS,
+                "re-staged for an earlier start (42 ms instead of 50 ms): the stop moves to 41 ms");
+    apply(&sw, sw.stop_ns, 20 * US, &lost);
+    TEST_ASSERT(lost == 4, "a 1 ms lead over a 250 us cycle: 4 cycles lost");
+
+    /* Armed (stopped) switch re-armed for a later start: the gap grows */
+    setup(&sw, 41500 * US, 0, 1 * MS, 20 * US, &lost);
+    TEST_ASSERT(!sw.staged && sw.config_change_ns == 43 * MS && lost == 4 && sw.cycles_lost == 9,
+                "SETUP_TAS between stop and CCT re-arms for 43 ms: 4 more cycles lost");
+}
+
+static void test_failures(void)
+{
+    avb_tas_switch_t sw;
+    uint32_t lost = 99;
+
+    TEST_CASE("TC-TAS-SW-007: failures");
+    avb_tas_switch_init(&sw);
+    setup(&sw, 1 * MS, 0, 1 * MS, 20 * US, NULL);
+    avb_tas_switch_poll(&sw, 2 * MS);
+
+    avb_tas_switch_fail(&sw, (int32_t)0xC000000Du, 0);   /* STATUS_INVALID_PARAMETER */
+    TEST_ASSERT(sw.state == AVB_TAS_SW_ACTIVE && avb_tas_switch_running(&sw) &&
+                sw.last_error == (int32_t)0xC000000Du,
+                "rejected schedule: state unchanged, last_error set");
+
+    setup(&sw, 5 * MS, 0, 1 * MS, 0, NULL);
+    avb_tas_switch_fail(&sw, (int32_t)0xC000000Du, 0);
+    TEST_ASSERT(sw.staged && sw.state == AVB_TAS_SW_PENDING,
+                "rejected schedule while one is staged: the staged switch stays");
+
+    avb_tas_switch_fail(&sw, -5, 1);
+    TEST_ASSERT(sw.state == AVB_TAS_SW_ERROR && !sw.staged && !avb_tas_switch_running(&sw),
+                "register failure at the switch: ERROR, staged list dropped, no trusted operational list");
+    avb_tas_switch_poll(&sw, 50 * MS);
+    TEST_ASSERT(sw.state == AVB_TAS_SW_ERROR, "poll does not leave ERROR");
+
+    setup(&sw, 10 * MS + 300 * US, 0, 700 * US, 20 * US, &lost);
+    TEST_ASSERT(sw.state == AVB_TAS_SW_PENDING && !sw.staged && lost == 0 && sw.last_error == 0,
+                "next SETUP_TAS is a fresh start: armed at once, nothing counted lost, error cleared");
+}
+
+static void test_random(void)
+{
+    avb_tas_switch_t sw;
+    uint64_t now = 1 * MS, lost_sum = 0, changes = 0, pending_cct = 0;
+    uint32_t x = 0x2545F491u, i, lost, stages = 0;
+    int ok = 1, pending = 0;
+
+    TEST_CASE("TC-TAS-SW-008: randomized switch sequence");
+    avb_tas_switch_init(&sw);
+    for (i = 0; i < 20000u; i++) {
+        uint32_t cycle, prog;
+        uint64_t base, cct;
+
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        cycle = 50u * (uint32_t)US + x % (2u * (uint32_t)MS);
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        base  = (uint64_t)(x % 50u) * MS + x % 997u;
+        prog  = (x >> 8) % 8u == 0 ? (uint32_t)(LEAD_NS + (x >> 11) % (4u * (uint32_t)MS)) : 20u * (uint32_t)US;
+
+        avb_tas_switch_poll(&sw, now);
+        if (pending && now >= pending_cct) {
+            changes++;
+            pending = 0;
+        }
+        cct = setup(&sw, now, base, cycle, prog, &lost);
+        if (sw.staged) {
+            /* Staged: nothing lost, the stop leaves the lead and is an operational boundary */
+            uint64_t stop = sw.stop_ns;
+            stages++;
+            if (lost != 0 || stop < now || stop + LEAD_NS > cct ||
+                (stop - sw.oper_base_ns) % sw.oper_cycle_ns != 0 ||
+                cct - LEAD_NS - stop >= sw.oper_cycle_ns || (cct - base) % cycle != 0) {
+                ok = 0;
+            }
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            now = stop + ((x >> 4) % 4u == 0 ? x % (2u * (uint32_t)MS) : 0u);   /* timer, sometimes late */
+            cct = apply(&sw, now, prog, &lost);
+        }
+        lost_sum += lost;
+        pending = 1;
+        pending_cct = sw.config_change_ns;
+
+        /* Each lost cycle is at least 50 us of gap, plus the one cut at the stop */
+        if (sw.staged || sw.config_change_ns < cct || sw.config_change_ns < now + LEAD_NS ||
+            (sw.config_change_ns - sw.admin_base_ns) % sw.admin_cycle_ns != 0 ||
+            (sw.config_change_ns - now) / (50u * US) + 1u < lost) {
+            ok = 0;
+        }
+        if (now + prog >= sw.config_change_ns) {
+            changes++;
+            pending = 0;
+            if (sw.state != AVB_TAS_SW_ACTIVE || sw.oper_base_ns != sw.config_change_ns) ok = 0;
+        } else if (sw.state != AVB_TAS_SW_PENDING) {
+            ok = 0;
+        }
+
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        now += prog + x % (3u * (uint32_t)MS);
+    }
+    avb_tas_switch_poll(&sw, now + 10u * MS);
+    if (pending) changes++;
+
+    TEST_ASSERT(ok && stages > 1000u, "stop leaves the lead on an operational boundary; CCT in admin phase; state matches the simulated PHC");
+    TEST_ASSERT(sw.cycles_lost == lost_sum, "cycles_lost = sum of per-switch losses");
+    TEST_ASSERT(sw.config_changes == changes && sw.state == AVB_TAS_SW_ACTIVE,
+                "config_changes counts exactly the switches that took effect");
+}
+
+int main(void)
+{
+    printf("=======================================================\n");
+    printf("TEST-TAS-SWITCH-001: Qbv admin/operational schedule switch\n");
+    printf("  Verifies: REQ-F-TAS-003\n");
+    printf("=======================================================\n");
+
+    test_first_start();
+    test_staged_switch();
+    test_stop_time();
+    test_late_programming();
+    test_late_first_start();
+    test_replace_pending();
+    test_failures();
+    test_random();
+
+    printf("\n=======================================================\n");
+    printf("Results: %d/%d passed", g_results.passed, g_results.total);
+    if (g_results.failed > 0) {
+        printf(", %d FAILED", g_results.failed);
+    }
+    printf("\n=======================================================\n");
+
+    return (g_results.failed > 0) ? 1 : 0;
+}
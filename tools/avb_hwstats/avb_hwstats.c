@@ -0,0 +1,220 @@
+/**
+ * avb_hwstats - watch the NIC statistics registers through the mapped page
+ *
+ * The driver's sampler (IOCTL_AVB_HW_STATS) reads the MAC statistics
+ * registers every interval_ms, adds them to 64-bit totals and publishes
+ * them on a page the caller can map read-only.  Clear-on-read counters are
+ * shared with the miniport, so the sampler reads them only with --take,
+ * and the adapter's own statistics then miss what it reads.  This tool starts the
+ * sampler if asked, maps the page once, and then reads it without any
+ * further IOCTL: every period it takes a seqlock copy
+ * (devices/intel_hw_stats.h: intel_hw_stats_page_read) and prints each
+ * counter present with its total and its rate since the previous copy.
+ *
+ * Build:
+ *   cl /nologo /W4 /O2 -I . tools\avb_hwstats\avb_hwstats.c
+ *
+ * Examples:
+ *   avb_hwstats --interval 100 --period 1     sample every 100 ms, print every second
+ *   avb_hwstats --interval 100 --take all     also take the clear-on-read counters
+ *   avb_hwstats --count 1 --all               one copy of every counter, zeros included
+ *   avb_hwstats --stop                        stop the sampler (totals stay on the page)
+ *
+ * Implements: REQ-F-STATISTICS-004 (NIC hardware statistics sampling)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include "../../include/avb_ioctl.h"  // SSOT for IOCTL definitions
+#endif
+
+#include "devices/intel_hw_stats.h"
+
+#define READ_TRIES      1000u
+
+static const char *const s_names[INTEL_HW_STAT_COUNT] = {
+    "crc_errors", "align_errors", "rx_errors", "missed_packets",
+    "single_collisions", "excess_collisions", "multi_collisions", "late_collisions",
+    "collisions", "deferred", "tx_no_crs", "rx_length_errors",
+    "xon_rx", "xon_tx", "xoff_rx", "xoff_tx",
+    "fc_unsupported", "good_rx_packets", "bcast_rx_packets", "mcast_rx_packets",
+    "good_tx_packets", "good_rx_octets", "good_tx_octets", "rx_no_buffers",
+    "rx_undersize", "rx_fragments", "rx_oversize", "rx_jabber",
+    "total_rx_octets", "total_tx_octets", "total_rx_packets", "total_tx_packets",
+    "mcast_tx_packets", "bcast_tx_packets", "rx_lpi", "tx_lpi",
+    "rx_queue_drops_0", "rx_queue_drops_1", "rx_queue_drops_2", "rx_queue_drops_3",
+};
+
+typedef struct {
+    uint32_t interval_ms;       /* 0: leave the sampler as it is */
+    uint64_t take;              /* clear-on-read counters to read (counter_mask) */
+    double   period;            /* seconds between copies */
+    uint32_t count;             /* copies to print, 0 = until Ctrl+C */
+    int      all;
+    int      stop;
+} options_t;
+
+static void usage(void)
+{
+    printf("Usage: avb_hwstats [options]\n"
+           "  --interval MS   start (or re-time) the sampler: %u..%u ms\n"
+           "  --take MASK     with --interval: clear-on-read counters to read (bit n =\n"
+           "                  counter n, or 'all'); the miniport's statistics lose them\n"
+           "  --period S      seconds between printed copies (default 1)\n"
+           "  --count N       print N copies and exit (default: until Ctrl+C)\n"
+           "  --all           print counters that are still 0\n"
+           "  --stop          stop the sampler and exit\n",
+           10u, 60000u);
+}
+
+static int parse_args(int argc, char **argv, options_t *o)
+{
+    int i;
+
+    memset(o, 0, sizeof(*o));
+    o->period = 1.0;
+    for (i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        const char *v = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(a, "--interval") == 0 && v) {
+            o->interval_ms = (uint32_t)strtoul(v, NULL, 0);
+            i++;
+        } else if (strcmp(a, "--take") == 0 && v) {
+            o->take = (strcmp(v, "all") == 0) ? ~0ull : strtoull(v, NULL, 0);
+            i++;
+        } else if (strcmp(a, "--period") == 0 && v) {
+            o->period = atof(v);
+            i++;
+        } else if (strcmp(a, "--count") == 0 && v) {
+            o->count = (uint32_t)strtoul(v, NULL, 0);
+            i++;
+        } else if (strcmp(a, "--all") == 0) {
+            o->all = 1;
+        } else if (strcmp(a, "--stop") == 0) {
+            o->stop = 1;
+        } else {
+            return -1;
+        }
+    }
+    return o->period > 0.0 ? 0 : -1;
+}
+
+/* One copy: totals, and rates against the previous copy when there is one */
+static void print_copy(const intel_hw_stats_page_t *now, const intel_hw_stats_page_t *prev, int all)
+{
+    double dt = 0.0;
+    uint32_t i;
+
+    if (prev != NULL && now->sample_ns > prev->sample_ns) {
+        dt = (double)(now->sample_ns - prev->sample_ns) / 1e9;
+    }
+    printf("\nsamples %llu  interval %u ms%s  read errors %llu\n", (unsigned long long)now->samples,
+           now->interval_ms, now->interval_ms ? "" : " (stopped)", (unsigned long long)now->read_errors);
+    for (i = 0; i < INTEL_HW_STAT_COUNT && i < now->counter_count; i++) {
+        if (!(now->present & INTEL_HW_STAT_BIT(i)) || (!all && now->counters[i] == 0)) {
+            continue;
+        }
+        if (dt > 0.0) {
+            printf("  %-18s %20llu  %14.1f/s\n", s_names[i], (unsigned long long)now->counters[i],
+                   (double)(now->counters[i] - prev->counters[i]) / dt);
+        } else {
+            printf("  %-18s %20llu\n", s_names[i], (unsigned long long)now->counters[i]);
+        }
+    }
+}
+
+#ifdef _WIN32
+static int hw_stats(HANDLE dev, uint32_t cmd, uint32_t interval_ms, uint64_t take, uint64_t page_address,
+                    AVB_HW_STATS_REQUEST *req)
+{
+    DWORD bytes = 0;
+
+    memset(req, 0, sizeof(*req));
+    req->command      = cmd;
+    req->interval_ms  = interval_ms;
+    req->counter_mask = take;
+    req->page_address = page_address;
+    if (!DeviceIoControl(dev, IOCTL_AVB_HW_STATS, req, sizeof(*req), req, sizeof(*req), &bytes, NULL) ||
+        bytes < sizeof(*req)) {
+        fprintf(stderr, "avb_hwstats: IOCTL_AVB_HW_STATS command %u failed (error %lu)\n", cmd, GetLastError());
+        return -1;
+    }
+    return 0;
+}
+
+static int watch(const options_t *o)
+{
+    AVB_HW_STATS_REQUEST req;
+    intel_hw_stats_page_t now, prev;
+    const volatile intel_hw_stats_page_t *page;
+    uint32_t n;
+    int have_prev = 0, rc = 0;
+    HANDLE dev = CreateFileA("\\\\.\\IntelAvbFilter", GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (dev == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "avb_hwstats: cannot open \\\\.\\IntelAvbFilter (error %lu)\n", GetLastError());
+        return 1;
+    }
+    if (o->stop) {
+        rc = hw_stats(dev, AVB_HW_STATS_CMD_STOP, 0, 0, 0, &req);
+        CloseHandle(dev);
+        return rc == 0 ? 0 : 1;
+    }
+    if ((o->interval_ms != 0 && hw_stats(dev, AVB_HW_STATS_CMD_START, o->interval_ms, o->take, 0, &req) != 0) ||
+        hw_stats(dev, AVB_HW_STATS_CMD_MAP, 0, 0, 0, &req) != 0) {
+        CloseHandle(dev);
+        return 1;
+    }
+    if (req.page_size != sizeof(intel_hw_stats_page_t) || req.counter_count != INTEL_HW_STAT_COUNT) {
+        fprintf(stderr, "avb_hwstats: driver page is %u bytes / %u counters, expected %u / %u\n",
+                req.page_size, req.counter_count, (unsigned)sizeof(intel_hw_stats_page_t), INTEL_HW_STAT_COUNT);
+        CloseHandle(dev);       /* closing the handle undoes the mapping */
+        return 1;
+    }
+    if (req.interval_ms == 0) {
+        fprintf(stderr, "avb_hwstats: the sampler is stopped; use --interval to start it\n");
+    }
+    page = (const volatile intel_hw_stats_page_t *)(uintptr_t)req.page_address;
+
+    for (n = 0; o->count == 0 || n < o->count; n++) {
+        if (n != 0) {
+            Sleep((DWORD)(o->period * 1000.0));
+        }
+        if (!intel_hw_stats_page_read(page, &now, READ_TRIES)) {
+            fprintf(stderr, "avb_hwstats: page busy, skipping this copy\n");
+            continue;
+        }
+        print_copy(&now, have_prev ? &prev : NULL, o->all);
+        prev = now;
+        have_prev = 1;
+    }
+
+    (void)hw_stats(dev, AVB_HW_STATS_CMD_UNMAP, 0, 0, req.page_address, &req);
+    CloseHandle(dev);
+    return 0;
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    options_t o;
+
+    if (parse_args(argc, argv, &o) != 0) {
+        usage();
+        return 2;
+    }
+#ifdef _WIN32
+    return watch(&o);
+#else
+    (void)print_copy;
+    fprintf(stderr, "avb_hwstats: needs the Windows driver\n");
+    return 2;
+#endif
+}
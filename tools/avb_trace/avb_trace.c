@@ -0,0 +1,525 @@
+/**
+ * avb_trace - capture and decode the driver's binary datapath trace
+ *
+ * The driver's trace points (receive and send chains, PTP event frames,
+ * timestamp events posted, TX timestamp FIFO entries, the poll DPC, target
+ * time, IOCTL dispatch) write fixed 48-byte records into per-processor
+ * rings (IOCTL_AVB_TRACE).  This tool switches categories on, drains the
+ * rings for a while and prints the records merged by time - as text, or
+ * as Chrome-trace JSON for chrome://tracing / Perfetto.
+ *
+ * Live mode (Windows, driver loaded) issues the IOCTL; --save writes the
+ * raw records so they can be decoded later - on any OS - with --file.
+ * Event and argument names come from src/trace_ring.c, built into this tool.
+ *
+ * Saved format (little-endian): file_header_t, then count records of
+ * sizeof(avb_trace_rec_t) bytes, in the order they were drained.
+ *
+ * Build:
+ *   cl /nologo /W4 /O2 -I src tools\avb_trace\avb_trace.c src\trace_ring.c
+ *   cc -O2 -Wall -I src -o avb_trace tools/avb_trace/avb_trace.c src/trace_ring.c
+ *
+ * Examples:
+ *   avb_trace --categories rx,event --duration 2      two seconds of RX / event records
+ *   avb_trace --categories all --save run1.trc --off  capture, keep a copy, switch off
+ *   avb_trace --file run1.trc --json > run1.json      decode a saved copy for chrome://tracing
+ *   avb_trace --status                                 what is enabled, ring size, records lost
+ *
+ * Implements: REQ-NF-DIAG-TRACE-001 (Binary datapath trace)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include "../../include/avb_ioctl.h"  // SSOT for IOCTL definitions
+#endif
+
+#include "trace_ring.h"
+
+#define FILE_MAGIC      "AVBTRC1"
+#define FILE_VERSION    1u
+#define CATEGORIES      5u
+
+static const char *const s_categories[CATEGORIES] = { "rx", "tx", "event", "poll", "ioctl" };
+
+typedef struct {
+    char     magic[8];          /* FILE_MAGIC */
+    uint32_t version;
+    uint32_t record_size;       /* sizeof(avb_trace_rec_t) */
+    uint64_t tick_hz;
+    uint64_t lost;
+    uint64_t count;
+} file_header_t;
+
+typedef struct {
+    avb_trace_rec_t *rec;
+    size_t           count;
+    size_t           alloc;
+    uint64_t         tick_hz;
+    uint64_t         lost;
+} capture_t;
+
+typedef struct {
+    int         categories;     /* -1: leave as the driver has them */
+    uint32_t    records;        /* per-processor ring size on first enable */
+    double      duration;       /* seconds */
+    int         off;
+    int         status;
+    int         json;
+    const char *save;
+    const char *file;
+} options_t;
+
+static void usage(void)
+{
+    printf("Usage: avb_trace [options]\n"
+           "  --categories LIST  enable rx,tx,event,poll,ioctl | all | none | HEX before capturing\n"
+           "  --records N        records per processor when the rings are first allocated\n"
+           "  --duration SEC     capture for SEC seconds (default 1)\n"
+           "  --off              switch tracing off after capturing\n"
+           "  --status           print the driver's trace state and exit\n"
+           "  --json             Chrome-trace JSON instead of text\n"
+           "  --save FILE        write the records captured to FILE (binary, see --file)\n"
+           "  --file FILE        decode a saved capture instead of asking the driver\n");
+}
+
+static int parse_categories(const char *val)
+{
+    char buf[64], *tok;
+    uint32_t k;
+    int mask = 0;
+
+    if (strcmp(val, "all") == 0) {
+        return AVB_TRACE_CAT_ALL;
+    }
+    if (strcmp(val, "none") == 0) {
+        return 0;
+    }
+    if (strncmp(val, "0x", 2) == 0) {
+        return (int)(strtoul(val, NULL, 16) & AVB_TRACE_CAT_ALL);
+    }
+    strncpy(buf, val, sizeof(buf) - 1u);
+    buf[sizeof(buf) - 1u] = '\0';
+    for (tok = strtok(buf, ","); tok != NULL; tok = strtok(NULL, ",")) {
+        for (k = 0; k < CATEGORIES; k++) {
+            if (strcmp(tok, s_categories[k]) == 0) {
+                mask |= 1 << k;
+                break;
+            }
+        }
+        if (k == CATEGORIES) {
+            fprintf(stderr, "avb_trace: unknown category '%s'\n", tok);
+            return -1;
+        }
+    }
+    return mask;
+}
+
+static int parse_args(int argc, char **argv, options_t *o)
+{
+    int i;
+
+    memset(o, 0, sizeof(*o));
+    o->categories = -1;
+    o->duration = 1.0;
+    for (i = 1; i < argc; i++) {
+        const char *opt = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(opt, "-h") == 0 || strcmp(opt, "--help") == 0) {
+            usage();
+            exit(0);
+        }
+        if (strcmp(opt, "--off") == 0) {
+            o->off = 1;
+            continue;
+        }
+        if (strcmp(opt, "--status") == 0) {
+            o->status = 1;
+            continue;
+        }
+        if (strcmp(opt, "--json") == 0) {
+            o->json = 1;
+            continue;
+        }
+        if (val == NULL) {
+            fprintf(stderr, "avb_trace: %s needs a value\n", opt);
+            return -1;
+        }
+        i++;
+        if (strcmp(opt, "--categories") == 0) {
+            o->categories = parse_categories(val);
+            if (o->categories < 0) {
+                return -1;
+            }
+        } else if (strcmp(opt, "--records") == 0) {
+            o->records = (uint32_t)strtoul(val, NULL, 0);
+        } else if (strcmp(opt, "--duration") == 0) {
+            o->duration = atof(val);
+        } else if (strcmp(opt, "--save") == 0) {
+            o->save = val;
+        } else if (strcmp(opt, "--file") == 0) {
+            o->file = val;
+        } else {
+            fprintf(stderr, "avb_trace: unknown option '%s'\n", opt);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int append(capture_t *c, const avb_trace_rec_t *rec, size_t n)
+{
+    if (c->count + n > c->alloc) {
+        size_t alloc = c->alloc ? c->alloc : 4096u;
+        avb_trace_rec_t *p;
+
+        while (alloc < c->count + n) {
+            alloc *= 2u;
+        }
+        p = (avb_trace_rec_t *)realloc(c->rec, alloc * sizeof(*p));
+        if (p == NULL) {
+            fprintf(stderr, "avb_trace: out of memory after %zu records\n", c->count);
+            return -1;
+        }
+        c->rec = p;
+        c->alloc = alloc;
+    }
+    memcpy(c->rec + c->count, rec, n * sizeof(*rec));
+    c->count += n;
+    return 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Decoding
+ * ------------------------------------------------------------------------- */
+
+/* Rings are drained in turn, so merge processors by time */
+static int by_time(const void *a, const void *b)
+{
+    const avb_trace_rec_t *x = (const avb_trace_rec_t *)a, *y = (const avb_trace_rec_t *)b;
+
+    if (x->ticks != y->ticks) return x->ticks < y->ticks ? -1 : 1;
+    if (x->cpu != y->cpu)     return x->cpu < y->cpu ? -1 : 1;
+    return x->seq < y->seq ? -1 : (x->seq > y->seq);
+}
+
+static uint64_t arg_value(const avb_trace_rec_t *r, uint32_t n)
+{
+    return n == 0 ? r->arg32 : r->arg[n - 1u];
+}
+
+/* Arguments shown in hex rather than decimal */
+static int arg_hex(const char *name)
+{
+    return strcmp(name, "code") == 0 || strcmp(name, "ntstatus") == 0 ||
+           strcmp(name, "event_type") == 0 || strcmp(name, "type_pcp_vlan") == 0 ||
+           strcmp(name, "flags") == 0;
+}
+
+/* Argument holding a duration in ticks (drawn as a span in JSON), or 0 */
+static uint32_t duration_arg(uint32_t id)
+{
+    switch (id) {
+    case AVB_TR_POLL_DPC: return 1u;    /* arg[0] */
+    case AVB_TR_IOCTL:    return 2u;    /* arg[1] */
+    default:              return 0u;
+    }
+}
+
+static double ticks_us(uint64_t ticks, uint64_t tick_hz)
+{
+    return tick_hz ? (double)ticks * 1e6 / (double)tick_hz : (double)ticks;
+}
+
+static void print_text(const capture_t *c)
+{
+    uint64_t t0 = c->count ? c->rec[0].ticks : 0;
+    size_t i;
+    uint32_t n;
+
+    for (i = 0; i < c->count; i++) {
+        const avb_trace_rec_t *r = &c->rec[i];
+        const char *name = avb_trace_event_name(r->id);
+
+        printf("%14.3f us  cpu %-2u  ", ticks_us(r->ticks - t0, c->tick_hz), r->cpu);
+        if (name == NULL) {
+            printf("event_0x%04X  %u %llu %llu %llu\n", r->id, r->arg32, (unsigned long long)r->arg[0],
+                   (unsigned long long)r->arg[1], (unsigned long long)r->arg[2]);
+            continue;
+        }
+        printf("%-12s", name);
+        for (n = 0; n < 4u; n++) {
+            const char *arg = avb_trace_arg_name(r->id, n);
+            if (arg == NULL) {
+                continue;
+            }
+            if (arg_hex(arg)) {
+                printf("  %s=0x%llX", arg, (unsigned long long)arg_value(r, n));
+            } else {
+                printf("  %s=%llu", arg, (unsigned long long)arg_value(r, n));
+            }
+        }
+        printf("\n");
+    }
+    printf("%zu records", c->count);
+    if (c->lost != 0) {
+        printf(", %llu lost (overwritten before they were drained)", (unsigned long long)c->lost);
+    }
+    printf("\n");
+}
+
+/* Chrome trace event format: instant events, spans for the timed ones */
+static void print_json(const capture_t *c)
+{
+    uint64_t t0 = c->count ? c->rec[0].ticks : 0;
+    size_t i;
+    uint32_t n;
+
+    printf("{\"displayTimeUnit\":\"ns\",\"otherData\":{\"lost\":%llu,\"tick_hz\":%llu},\"traceEvents\":[\n",
+           (unsigned long long)c->lost, (unsigned long long)c->tick_hz);
+    for (i = 0; i < c->count; i++) {
+        const avb_trace_rec_t *r = &c->rec[i];
+        const char *name = avb_trace_event_name(r->id);
+        uint32_t cat = (uint32_t)r->id >> 8, dur = duration_arg(r->id);
+        double ts = ticks_us(r->ticks - t0, c->tick_hz);
+        int first = 1;
+
+        printf("%s{\"name\":\"%s\",\"cat\":\"%s\",", i ? ",\n" : "", name ? name : "unknown",
+               cat < CATEGORIES ? s_categories[cat] : "unknown");
+        if (dur != 0) {
+            double d = ticks_us(arg_value(r, dur), c->tick_hz);
+            printf("\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,", ts - d, d);
+        } else {
+            printf("\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,", ts);
+        }
+        printf("\"pid\":0,\"tid\":%u,\"args\":{", r->cpu);
+        for (n = 0; n < 4u; n++) {
+            const char *arg = name ? avb_trace_arg_name(r->id, n) : NULL;
+            if (arg != NULL) {
+                printf("%s\"%s\":%llu", first ? "" : ",", arg, (unsigned long long)arg_value(r, n));
+                first = 0;
+            }
+        }
+        printf("}}");
+    }
+    printf("\n]}\n");
+}
+
+static void decode(capture_t *c, const options_t *o)
+{
+    qsort(c->rec, c->count, sizeof(*c->rec), by_time);
+    if (o->json) {
+        print_json(c);
+    } else {
+        print_text(c);
+    }
+}
+
+/* -------------------------------------------------------------------------
+ * Saved file
+ * ------------------------------------------------------------------------- */
+static int decode_file(const options_t *o)
+{
+    capture_t c;
+    file_header_t h;
+    FILE *f = fopen(o->file, "rb");
+
+    memset(&c, 0, sizeof(c));
+    if (f == NULL) {
+        fprintf(stderr, "avb_trace: cannot open %s\n", o->file);
+        return 1;
+    }
+    if (fread(&h, sizeof(h), 1, f) != 1 || memcmp(h.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        h.version != FILE_VERSION || h.record_size != sizeof(avb_trace_rec_t)) {
+        fprintf(stderr, "avb_trace: %s: not a version %u capture of %u-byte records\n", o->file,
+                FILE_VERSION, (unsigned)sizeof(avb_trace_rec_t));
+        fclose(f);
+        return 1;
+    }
+    c.tick_hz = h.tick_hz;
+    c.lost    = h.lost;
+    while (c.count < h.count) {
+        avb_trace_rec_t batch[256];
+        size_t want = (size_t)(h.count - c.count) < 256u ? (size_t)(h.count - c.count) : 256u;
+        size_t got = fread(batch, sizeof(batch[0]), want, f);
+
+        if (got == 0 || append(&c, batch, got) != 0) {
+            break;
+        }
+    }
+    fclose(f);
+    if (c.count < h.count) {
+        fprintf(stderr, "avb_trace: %s: truncated, %zu of %llu records\n", o->file, c.count,
+                (unsigned long long)h.count);
+    }
+    decode(&c, o);
+    free(c.rec);
+    return 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Live (Windows)
+ * ------------------------------------------------------------------------- */
+#ifdef _WIN32
+#define DRAIN_RECORDS   4096u   /* the driver's per-call limit */
+
+static int save_file(const char *path, const capture_t *c)
+{
+    file_header_t h;
+    FILE *f = fopen(path, "wb");
+
+    if (f == NULL) {
+        fprintf(stderr, "avb_trace: cannot create %s\n", path);
+        return -1;
+    }
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    h.version     = FILE_VERSION;
+    h.record_size = (uint32_t)sizeof(avb_trace_rec_t);
+    h.tick_hz     = c->tick_hz;
+    h.lost        = c->lost;
+    h.count       = c->count;
+    if (fwrite(&h, sizeof(h), 1, f) != 1 ||
+        (c->count != 0 && fwrite(c->rec, sizeof(*c->rec), c->count, f) != c->count)) {
+        fprintf(stderr, "avb_trace: cannot write %s\n", path);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+    return 0;
+}
+
+static int trace_ioctl(HANDLE dev, AVB_TRACE_REQUEST *req, DWORD out_len)
+{
+    DWORD bytes = 0;
+
+    if (!DeviceIoControl(dev, IOCTL_AVB_TRACE, req, sizeof(*req), req, out_len, &bytes, NULL) ||
+        bytes < sizeof(*req)) {
+        fprintf(stderr, "avb_trace: IOCTL_AVB_TRACE failed (error %lu)\n", GetLastError());
+        return -1;
+    }
+    if (req->record_size != sizeof(avb_trace_rec_t)) {
+        fprintf(stderr, "avb_trace: driver records are %u bytes, expected %u\n", req->record_size,
+                (unsigned)sizeof(avb_trace_rec_t));
+        return -1;
+    }
+    return 0;
+}
+
+static int command(HANDLE dev, uint32_t cmd, uint32_t categories, uint32_t records, AVB_TRACE_REQUEST *req)
+{
+    memset(req, 0, sizeof(*req));
+    req->command         = cmd;
+    req->categories      = categories;
+    req->records_per_cpu = records;
+    return trace_ioctl(dev, req, sizeof(*req));
+}
+
+static void print_status(const AVB_TRACE_REQUEST *req)
+{
+    uint32_t k;
+
+    printf("categories:");
+    for (k = 0; k < CATEGORIES; k++) {
+        if (req->categories & (1u << k)) {
+            printf(" %s", s_categories[k]);
+        }
+    }
+    printf("%s\nrings: %u x %u records\ntick rate: %llu Hz\nlost: %llu\n",
+           req->categories ? "" : " (off)", req->rings, req->records_per_cpu,
+           (unsigned long long)req->tick_hz, (unsigned long long)req->lost);
+}
+
+static int decode_live(const options_t *o)
+{
+    static uint8_t buf[sizeof(AVB_TRACE_REQUEST) + DRAIN_RECORDS * sizeof(avb_trace_rec_t)];
+    AVB_TRACE_REQUEST *req = (AVB_TRACE_REQUEST *)buf;
+    capture_t c;
+    ULONGLONG end;
+    int rc = 0;
+    HANDLE dev = CreateFileA("\\\\.\\IntelAvbFilter", GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    memset(&c, 0, sizeof(c));
+    if (dev == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "avb_trace: cannot open \\\\.\\IntelAvbFilter (error %lu)\n", GetLastError());
+        return 1;
+    }
+    if (command(dev, AVB_TRACE_CMD_STATUS, 0, 0, req) != 0) {
+        CloseHandle(dev);
+        return 1;
+    }
+    if (o->status) {
+        print_status(req);
+        CloseHandle(dev);
+        return 0;
+    }
+    if (o->categories >= 0 &&
+        command(dev, AVB_TRACE_CMD_ENABLE, (uint32_t)o->categories, o->records, req) != 0) {
+        CloseHandle(dev);
+        return 1;
+    }
+    if (req->categories == 0) {
+        fprintf(stderr, "avb_trace: tracing is off; use --categories to switch it on\n");
+    }
+
+    /* Drain until the time is up, then once more for the stragglers */
+    end = GetTickCount64() + (ULONGLONG)(o->duration * 1000.0);
+    for (;;) {
+        int last = GetTickCount64() >= end;
+
+        memset(req, 0, sizeof(*req));
+        req->command = AVB_TRACE_CMD_DRAIN;
+        rc = trace_ioctl(dev, req, sizeof(buf));
+        if (rc != 0 || append(&c, (const avb_trace_rec_t *)(req + 1), req->record_count) != 0) {
+            rc = -1;
+            break;
+        }
+        c.tick_hz = req->tick_hz;
+        c.lost    = req->lost;
+        if (last && req->record_count == 0) {
+            break;
+        }
+        if (req->record_count < DRAIN_RECORDS / 2u) {
+            Sleep(10);
+        }
+    }
+    if (o->off) {
+        (void)command(dev, AVB_TRACE_CMD_ENABLE, 0, 0, req);
+    }
+    CloseHandle(dev);
+
+    if (rc == 0 && o->save != NULL) {
+        rc = save_file(o->save, &c);
+    }
+    if (rc == 0) {
+        decode(&c, o);
+    }
+    free(c.rec);
+    return rc == 0 ? 0 : 1;
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    options_t o;
+
+    if (parse_args(argc, argv, &o) != 0) {
+        usage();
+        return 2;
+    }
+    if (o.file != NULL) {
+        return decode_file(&o);
+    }
+#ifdef _WIN32
+    return decode_live(&o);
+#else
+    fprintf(stderr, "avb_trace: live mode needs the Windows driver; use --file with a saved capture\n");
+    return 2;
+#endif
+}
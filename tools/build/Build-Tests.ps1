@@ -367,6 +367,63 @@ $AllTests = @(
         Includes = "-I include -I external/intel_avb/lib -I intel-ethernet-regs/gen"
         Description = "Device Open Diagnostic"
     },
+    @{
+        Name = "tas_analyze"
+        Type = "cl"
+        Source = "tools/tas_analyzer/tas_analyze.c"
+        ExtraSources = "tools/tas_analyzer/tas_analysis.c src/tas_gcl.c"
+        Output = "tas_analyze.exe"
+        Includes = "-I ."
+        CompilerFlags = "/O2"
+        Description = "Offline Qbv schedule analyzer: guaranteed bandwidth, worst-case delay, guard band per queue (REQ-F-TAS-002)"
+    },
+    @{
+        Name = "lat_decode"
+        Type = "cl"
+        Source = "tools/lat_hist/lat_decode.c"
+        ExtraSources = "src/lat_hist.c"
+        Output = "lat_decode.exe"
+        Includes = "-I . -I src"
+        CompilerFlags = "/O2"
+        Description = "Driver latency histograms: percentiles per hot path, per IOCTL code and per TX residence priority, live or from a saved copy (REQ-F-STATISTICS-002, REQ-F-STATISTICS-005)"
+    },
+    @{
+        Name = "avb_trace"
+        Type = "cl"
+        Source = "tools/avb_trace/avb_trace.c"
+        ExtraSources = "src/trace_ring.c"
+        Output = "avb_trace.exe"
+        Includes = "-I . -I src"
+        CompilerFlags = "/O2"
+        Description = "Binary datapath trace: enable categories, drain the per-CPU rings, print text or Chrome-trace JSON (REQ-NF-DIAG-TRACE-001)"
+    },
+    @{
+        Name = "avb_hwstats"
+        Type = "cl"
+        Source = "tools/avb_hwstats/avb_hwstats.c"
+        Output = "avb_hwstats.exe"
+        Includes = "-I ."
+        CompilerFlags = "/O2"
+        Description = "NIC statistics registers: start the sampler, map its page read-only, print totals and rates (REQ-F-STATISTICS-004)"
+    },
+    @{
+        Name = "avb_mmio"
+        Type = "cl"
+        Source = "tools/avb_mmio/avb_mmio.c"
+        Output = "avb_mmio.exe"
+        Includes = "-I ."
+        CompilerFlags = "/O2"
+        Description = "MMIO accounting: register reads and writes per caller and register block, counts and average cost (REQ-NF-DIAG-MMIO-001)"
+    },
+    @{
+        Name = "avb_pktgen"
+        Type = "cl"
+        Source = "tools/avb_pktgen/avb_pktgen.c"
+        Output = "avb_pktgen.exe"
+        Includes = "-I ."
+        CompilerFlags = "/O2"
+        Description = "Kernel packet generator: PTP / AVTP presets, start a run, print achieved rate, completion latency and timestamp counts (REQ-NF-TEST-PKTGEN-001)"
+    },
     # Diagnostic Tests (nmake)
     @{
         Name = "avb_diagnostic"
@@ -593,6 +650,137 @@ $AllTests = @(
         Includes = "-I include -I external/intel_avb/lib -I intel-ethernet-regs/gen"
         Description = "Unit: HAL Performance Metrics Tests (TEST-PORTABILITY-HAL-003, Issue #310)"
     },
+    @{
+        Name = "test_systim_decode"
+        Type = "cl"
+        Source = "tests/unit/hal/test_systim_decode.c"
+        Output = "test_systim_decode.exe"
+        Includes = "-I include -I external/intel_avb/lib -I intel-ethernet-regs/gen"
+        Description = "Unit: Division-free SYSTIM decode, bit-exact vs raw/200000 (TEST-PHC-DECODE-001, REQ-NF-PERF-PHC-001)"
+    },
+    @{
+        Name = "test_phc_holdover"
+        Type = "cl"
+        Source = "tests/unit/ptp/test_phc_holdover.c"
+        ExtraSources = "src/phc_holdover.c"
+        Output = "test_phc_holdover.exe"
+        Includes = "-I include -I src"
+        Description = "Unit: PHC drift estimator and holdover state machine (TEST-PTP-HOLDOVER-001, REQ-F-PTP-HOLDOVER-001)"
+    },
+    @{
+        Name = "test_sdp_perout"
+        Type = "cl"
+        Source = "tests/unit/ptp/test_sdp_perout.c"
+        ExtraSources = "src/sdp_perout.c"
+        Output = "test_sdp_perout.exe"
+        Includes = "-I . -I src"
+        Description = "Unit: periodic SDP output scheduler, re-arm and jitter statistics (TEST-PTP-PEROUT-001, REQ-F-PTP-PEROUT-001)"
+    },
+    @{
+        Name = "test_aux_capture"
+        Type = "cl"
+        Source = "tests/unit/ptp/test_aux_capture.c"
+        ExtraSources = "src/aux_capture.c"
+        Output = "test_aux_capture.exe"
+        Includes = "-I . -I src"
+        Description = "Unit: AUX latch tracker, edge numbering and overrun inference (TEST-PTP-AUXSTREAM-001, REQ-F-PTP-AUXSTREAM-001)"
+    },
+    @{
+        Name = "test_cbs_units"
+        Type = "cl"
+        Source = "tests/unit/hal/test_cbs_units.c"
+        Output = "test_cbs_units.exe"
+        Includes = "-I ."
+        Description = "Unit: CBS idleSlope/hiCredit register units and 802.1Q Annex L bounds (TEST-QAV-UNITS-001, REQ-F-QAV-001)"
+    },
+    @{
+        Name = "test_fp_stats"
+        Type = "cl"
+        Source = "tests/unit/hal/test_fp_stats.c"
+        Output = "test_fp_stats.exe"
+        Includes = "-I ."
+        Description = "Unit: 802.3br MAC merge counters - decode, 64-bit totals, deltas, verify inference (TEST-FP-STATS-001, REQ-F-FP-002)"
+    },
+    @{
+        Name = "test_hw_stats"
+        Type = "cl"
+        Source = "tests/unit/hal/test_hw_stats.c"
+        Output = "test_hw_stats.exe"
+        Includes = "-I ."
+        Description = "Unit: NIC statistics registers - register table, 64-bit totals, seqlock page against a concurrent writer (TEST-HW-STATS-001, REQ-F-STATISTICS-004)"
+    },
+    @{
+        Name = "test_qbv_gcl"
+        Type = "cl"
+        Source = "tests/unit/hal/test_qbv_gcl.c"
+        ExtraSources = "src/tas_gcl.c"
+        Output = "test_qbv_gcl.exe"
+        Includes = "-I . -I src"
+        Description = "Unit: compiled Qbv GCL -> I225/I226 STQT/ENDQT windows, base-time roll-forward, randomized GCLs (TEST-TAS-GCL-001, REQ-F-TAS-001)"
+    },
+    @{
+        Name = "test_srp_admission"
+        Type = "cl"
+        Source = "tests/unit/srp/test_srp_admission.c"
+        ExtraSources = "src/srp_admission.c"
+        Output = "test_srp_admission.exe"
+        Includes = "-I . -I src"
+        Description = "Unit: SRP deltaBandwidth admission, per-frame overhead and derived CBS (TEST-SRP-ADMIT-001, REQ-F-SRP-003)"
+    },
+    @{
+        Name = "test_srp_table"
+        Type = "cl"
+        Source = "tests/unit/srp/test_srp_table.c"
+        ExtraSources = "src/srp_table.c"
+        Output = "test_srp_table.exe"
+        Includes = "-I . -I src"
+        Description = "Unit: hashed SRP reservation store - handles, growth, limit, paging (TEST-SRP-TABLE-001, REQ-F-SRP-004)"
+    },
+    @{
+        Name = "test_tas_gcl"
+        Type = "cl"
+        Source = "tests/unit/tsn/test_tas_gcl.c"
+        ExtraSources = "src/tas_gcl.c"
+        Output = "test_tas_gcl.exe"
+        Includes = "-I . -I src"
+        Description = "Unit: Qbv GCL compiler/validator - normalization, diagnostics, guard band, randomized inputs (TEST-TAS-GCL-002, REQ-F-TAS-002)"
+    },
+    @{
+        Name = "test_tas_analysis"
+        Type = "cl"
+        Source = "tests/unit/tsn/test_tas_analysis.c"
+        ExtraSources = "tools/tas_analyzer/tas_analysis.c src/tas_gcl.c"
+        Output = "test_tas_analysis.exe"
+        Includes = "-I ."
+        Description = "Unit: offline Qbv analysis - guard band, priority blocking, CBS interference, wrap windows (TEST-TAS-ANALYSIS-001, REQ-F-TAS-002)"
+    },
+    @{
+        Name = "test_tas_switch"
+        Type = "cl"
+        Source = "tests/unit/tsn/test_tas_switch.c"
+        ExtraSources = "src/tas_switch.c"
+        Output = "test_tas_switch.exe"
+        Includes = "-I . -I src"
+        Description = "Unit: Qbv admin->oper switch - config-change time, lost cycles, pending/error state (TEST-TAS-SWITCH-001, REQ-F-TAS-003)"
+    },
+    @{
+        Name = "test_launch_time"
+        Type = "cl"
+        Source = "tests/unit/tsn/test_launch_time.c"
+        ExtraSources = "src/launch_time.c src/tas_switch.c"
+        Output = "test_launch_time.exe"
+        Includes = "-I . -I src"
+        Description = "Unit: per-frame launch time - descriptor horizon, I210/I225 LaunchTime encoding (TEST-LAUNCH-TIME-002, REQ-F-LAUNCH-002)"
+    },
+    @{
+        Name = "test_lt_pacer"
+        Type = "cl"
+        Source = "tests/unit/tsn/test_lt_pacer.c"
+        ExtraSources = "src/lt_pacer.c"
+        Output = "test_lt_pacer.exe"
+        Includes = "-I . -I src"
+        Description = "Unit: software launch-time pacer - release order, hold limits, release error stats (TEST-LAUNCH-PACER-001, REQ-F-LAUNCH-003)"
+    },
     
     # Integration Tests - PTP (additional, cl.exe)
     @{
@@ -805,6 +993,14 @@ $AllTests = @(
         Includes = "-I include -I external/intel_avb/lib -I intel-ethernet-regs/gen"
         Description = "Integration: PHC Cross-Timestamp IOCTL (UT-CORR-003, Track B closes #317 / #48)"
     },
+    @{
+        Name = "test_phc_multi_snapshot"
+        Type = "cl"
+        Source = "tests/integration/ptp_corr/test_phc_multi_snapshot.c"
+        Output = "test_phc_multi_snapshot.exe"
+        Includes = "-I include -I external/intel_avb/lib -I intel-ethernet-regs/gen"
+        Description = "Integration: All-adapter PHC snapshot IOCTL (UT-CORR-010, REQ-F-IOCTL-PHC-005)"
+    },
     @{
         Name = "test_ptp_phc_stability"
         Type = "cl"
@@ -1117,6 +1313,199 @@ $AllTests = @(
         Requirement = "#225"
     }
 
+    @{
+        Name = "test_systim_decode_bench"
+        Type = "cl"
+        Source = "tests\performance\test_systim_decode_bench.c"
+        Output = "test_systim_decode_bench.exe"
+        Includes = "-I include"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "SYSTIM decode micro-benchmark: runtime divide vs constant divide vs reciprocal (REQ-NF-PERF-PHC-001)"
+        TestCases = 2
+        Requirement = "REQ-NF-PERF-PHC-001"
+    }
+
+    @{
+        Name = "test_srp_admission_bench"
+        Type = "cl"
+        Source = "tests\performance\test_srp_admission_bench.c"
+        ExtraSources = "src/srp_admission.c"
+        Output = "test_srp_admission_bench.exe"
+        Includes = "-I . -I src"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "SRP admission benchmark: register/deregister 4096 streams, incremental vs rescan (REQ-F-SRP-003)"
+        TestCases = 2
+        Requirement = "REQ-F-SRP-003"
+    }
+
+    @{
+        Name = "test_tas_gcl_bench"
+        Type = "cl"
+        Source = "tests\performance\test_tas_gcl_bench.c"
+        ExtraSources = "src/tas_gcl.c"
+        Output = "test_tas_gcl_bench.exe"
+        Includes = "-I . -I src"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "Qbv GCL validation benchmark: 16384 random schedules, avb_tas_compile vs compile + intel_qbv_encode (REQ-F-TAS-002)"
+        TestCases = 2
+        Requirement = "REQ-F-TAS-002"
+    }
+
+    @{
+        Name = "test_tas_analysis_bench"
+        Type = "cl"
+        Source = "tests\performance\test_tas_analysis_bench.c"
+        ExtraSources = "tools/tas_analyzer/tas_analysis.c src/tas_gcl.c"
+        Output = "test_tas_analysis_bench.exe"
+        Includes = "-I ."
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "Qbv analysis throughput: compile + analyze 4096 candidate schedules (REQ-F-TAS-002)"
+        TestCases = 2
+        Requirement = "REQ-F-TAS-002"
+    }
+
+    @{
+        Name = "test_lt_pacer_sim"
+        Type = "cl"
+        Source = "tests\performance\test_lt_pacer_sim.c"
+        ExtraSources = "src/lt_pacer.c"
+        Output = "test_lt_pacer_sim.exe"
+        Includes = "-I . -I src"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "Software pacer release error on a simulated clock: 15.625 ms / 1 ms / 0.5 ms timer profiles (REQ-F-LAUNCH-003)"
+        TestCases = 3
+        Requirement = "REQ-F-LAUNCH-003"
+    }
+
+    @{
+        Name = "test_pcpu_stats_bench"
+        Type = "cl"
+        Source = "tests\performance\test_pcpu_stats_bench.c"
+        ExtraSources = "src/pcpu_stats.c"
+        Output = "test_pcpu_stats_bench.exe"
+        Includes = "-I . -I src"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "Statistics counter cost per packet, one shared slot vs. per-CPU slots, 1-64 threads; snapshot deltas (REQ-F-STATISTICS-001/003)"
+        TestCases = 4
+        Requirement = "REQ-F-STATISTICS-001"
+    }
+
+    @{
+        Name = "test_nbl_chain_bench"
+        Type = "cl"
+        Source = "tests\performance\test_nbl_chain_bench.c"
+        Output = "test_nbl_chain_bench.exe"
+        Includes = "-I . -I src"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "NBL chain walks per frame: multi-pass vs. single-pass datapath accounting and PTP classification, 64 / 256 NBL chains (REQ-F-STATISTICS-001)"
+        TestCases = 2
+        Requirement = "REQ-F-STATISTICS-001"
+    }
+
+    @{
+        Name = "test_lat_hist_bench"
+        Type = "cl"
+        Source = "tests\performance\test_lat_hist_bench.c"
+        ExtraSources = "src/lat_hist.c"
+        Output = "test_lat_hist_bench.exe"
+        Includes = "-I . -I src"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "Latency histogram bucket bounds, percentile accuracy, per-CPU totals and cost per sample (REQ-F-STATISTICS-002)"
+        TestCases = 4
+        Requirement = "REQ-F-STATISTICS-002"
+    }
+
+    @{
+        Name = "test_trace_ring_bench"
+        Type = "cl"
+        Source = "tests\performance\test_trace_ring_bench.c"
+        ExtraSources = "src/trace_ring.c"
+        Output = "test_trace_ring_bench.exe"
+        Includes = "-I . -I src"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "Trace ring cost per trace point, concurrent writers against a reader, lapped-ring accounting (REQ-NF-DIAG-TRACE-001)"
+        TestCases = 3
+        Requirement = "REQ-NF-DIAG-TRACE-001"
+    }
+
+    @{
+        Name = "test_mmio_acct_bench"
+        Type = "cl"
+        Source = "tests\performance\test_mmio_acct_bench.c"
+        ExtraSources = "src/mmio_acct.c"
+        Output = "test_mmio_acct_bench.exe"
+        Includes = "-I . -I src"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "MMIO accounting register blocks, nested caller scopes, exact per-CPU totals, cost per access (REQ-NF-DIAG-MMIO-001)"
+        TestCases = 3
+        Requirement = "REQ-NF-DIAG-MMIO-001"
+    }
+
+    @{
+        Name = "test_nbl_pool_bench"
+        Type = "cl"
+        Source = "tests\performance\test_nbl_pool_bench.c"
+        ExtraSources = "src/nbl_pool.c"
+        Output = "test_nbl_pool_bench.exe"
+        Includes = "-I src"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "SEND_PTP slot pool growth/limit/trim rules, multi-thread acquire/release with trimming, cost per send (REQ-NF-PERF-TXPOOL-001)"
+        TestCases = 3
+        Requirement = "REQ-NF-PERF-TXPOOL-001"
+    }
+
+    @{
+        Name = "test_pkt_gen_sim"
+        Type = "cl"
+        Source = "tests\performance\test_pkt_gen_sim.c"
+        ExtraSources = "src/pkt_gen.c"
+        Output = "test_pkt_gen_sim.exe"
+        Includes = "-I src"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "Packet generator template/stamping, exact schedule and rate arithmetic, achieved rate on coarse and fine simulated timers (REQ-NF-TEST-PKTGEN-001)"
+        TestCases = 3
+        Requirement = "REQ-NF-TEST-PKTGEN-001"
+    }
+
+    @{
+        Name = "test_tx_residence_bench"
+        Type = "cl"
+        Source = "tests\performance\test_tx_residence_bench.c"
+        ExtraSources = "src/tx_residence.c src/lat_hist.c"
+        Output = "test_tx_residence_bench.exe"
+        Includes = "-I src"
+        CompilerFlags = "/O2"
+        Enabled = $true
+        Priority = "P2"
+        Description = "TX residence sampling: header parse, priority / EtherType / 1-in-N selection, cost per frame with the histogram record (REQ-F-STATISTICS-005)"
+        TestCases = 3
+        Requirement = "REQ-F-STATISTICS-005"
+    }
+
     @{
         Name = "test_event_log"
         Type = "cl"
@@ -1933,8 +2322,9 @@ foreach ($Test in $TestsToBuild) {
             $CompilerFlags = if ($Test.CompilerFlags) { $Test.CompilerFlags } else { "/c" }
             $BuildCmd = "cl /nologo /W4 /Zi $CompilerFlags $($Test.Includes) $($Test.Source)$ExtraSrc /Fo:`"$OutputPath`""
         } else {
-            # Executable: use /Fe for executable output
-            $BuildCmd = "cl /nologo /W4 /Zi $($Test.Includes) $($Test.Source)$ExtraSrc /Fe:`"$OutputPath`""
+            # Executable: /Fe output, optional CompilerFlags (e.g. /O2 for micro-benchmarks)
+            $ExeFlags = if ($Test.CompilerFlags) { " $($Test.CompilerFlags)" } else { "" }
+            $BuildCmd = "cl /nologo /W4 /Zi$ExeFlags $($Test.Includes) $($Test.Source)$ExtraSrc /Fe:`"$OutputPath`""
             if ($Test.Libs) {
                 $BuildCmd += " /link $($Test.Libs)"
             }
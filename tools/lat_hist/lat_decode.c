@@ -0,0 +1,403 @@
+/**
+ * lat_decode - print the driver's latency histograms
+ *
+ * Reads the log-linear histograms behind IOCTL_AVB_GET_LAT_HIST (RX
+ * classify-to-post, TX timestamp FIFO-to-post, poll DPC run time, BAR0 read
+ * cost, one per IOCTL code, and the send -> send-complete residence of
+ * each 802.1Q priority that IOCTL_AVB_TX_RESIDENCE samples) and prints
+ * count, min, mean, p50 / p90 / p99 / p99.9 and max for each, optionally
+ * with the non-empty buckets.
+ *
+ * Live mode (Windows, driver loaded) issues the IOCTL; --save writes the
+ * replies as text so they can be decoded later - on any OS - with --file.
+ * The bucket layout is src/lat_hist.c, built into this tool.
+ *
+ * Saved format, one histogram per block:
+ *   # lat_decode 1 sub_bits 5 buckets 960
+ *   hist NAME CODE TOTAL    (CODE: IOCTL code, or priority for tx_residence)
+ *   BUCKET COUNT            (non-empty buckets only)
+ *   end
+ *
+ * Build:
+ *   cl /nologo /W4 /O2 -I src tools\lat_hist\lat_decode.c src\lat_hist.c
+ *   cc -O2 -Wall -I src -o lat_decode tools/lat_hist/lat_decode.c src/lat_hist.c
+ *
+ * Examples:
+ *   lat_decode                          all histograms of the default adapter
+ *   lat_decode --hist mmio --buckets    BAR0 read cost, every bucket
+ *   lat_decode --reset --save run1.txt  read, zero, and keep a copy
+ *   lat_decode --file run1.txt          decode a saved copy
+ *   lat_decode --hist tx_residence --pcp 3 --buckets
+ *                                       class A residence, every bucket
+ *
+ * Implements: REQ-F-STATISTICS-002 (Driver latency histograms)
+ *             REQ-F-STATISTICS-005 (TX residence latency per priority)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include "../../include/avb_ioctl.h"  // SSOT for IOCTL definitions
+#endif
+
+#include "lat_hist.h"
+
+#define FILE_VERSION    1u
+#define MAX_LINE        256u
+#define HIST_IOCTL      AVB_LAT_HOT_COUNT   /* AVB_LAT_HIST_IOCTL */
+#define HIST_TX_RES     (HIST_IOCTL + 1u)   /* AVB_LAT_HIST_TX_RESIDENCE */
+#define TX_RES_CLASSES  8u
+
+static const char *const s_names[] = { "rx_classify", "tx_ts_post", "dpc", "mmio", "ioctl", "tx_residence" };
+
+typedef struct {
+    uint32_t hist;              /* AVB_LAT_*, HIST_IOCTL or HIST_TX_RES */
+    uint32_t code;              /* IOCTL code for HIST_IOCTL, priority for HIST_TX_RES */
+    uint64_t counts[AVB_LAT_BUCKETS];
+} histogram_t;
+
+typedef struct {
+    int         hist;           /* -1: all */
+    uint32_t    code;           /* 0: every IOCTL code */
+    int         pcp;            /* -1: every priority with samples */
+    int         reset;
+    int         buckets;
+    const char *save;
+    const char *file;
+} options_t;
+
+static void usage(void)
+{
+    printf("Usage: lat_decode [options]\n"
+           "  --hist NAME      rx_classify | tx_ts_post | dpc | mmio | ioctl | tx_residence\n"
+           "                   (default: all)\n"
+           "  --code HEX       with --hist ioctl: one IOCTL code (default: every code seen)\n"
+           "  --pcp N          with --hist tx_residence: one priority 0..7 (default: every\n"
+           "                   priority with samples)\n"
+           "  --reset          zero the histograms as they are read (live mode)\n"
+           "  --buckets        also print every non-empty bucket\n"
+           "  --save FILE      write the histograms read to FILE (text, see --file)\n"
+           "  --file FILE      decode a saved file instead of asking the driver\n");
+}
+
+static int parse_args(int argc, char **argv, options_t *o)
+{
+    int i;
+    uint32_t k;
+
+    memset(o, 0, sizeof(*o));
+    o->hist = -1;
+    o->pcp  = -1;
+    for (i = 1; i < argc; i++) {
+        const char *opt = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(opt, "-h") == 0 || strcmp(opt, "--help") == 0) {
+            usage();
+            exit(0);
+        }
+        if (strcmp(opt, "--reset") == 0) {
+            o->reset = 1;
+            continue;
+        }
+        if (strcmp(opt, "--buckets") == 0) {
+            o->buckets = 1;
+            continue;
+        }
+        if (val == NULL) {
+            fprintf(stderr, "lat_decode: %s needs a value\n", opt);
+            return -1;
+        }
+        i++;
+        if (strcmp(opt, "--hist") == 0) {
+            for (k = 0; k <= HIST_TX_RES; k++) {
+                if (strcmp(val, s_names[k]) == 0) {
+                    o->hist = (int)k;
+                }
+            }
+            if (o->hist < 0) {
+                fprintf(stderr, "lat_decode: unknown histogram '%s'\n", val);
+                return -1;
+            }
+        } else if (strcmp(opt, "--code") == 0) {
+            o->code = (uint32_t)strtoul(val, NULL, 16);
+        } else if (strcmp(opt, "--pcp") == 0) {
+            o->pcp = atoi(val);
+            if (o->pcp < 0 || o->pcp >= (int)TX_RES_CLASSES) {
+                fprintf(stderr, "lat_decode: --pcp must be 0..7\n");
+                return -1;
+            }
+        } else if (strcmp(opt, "--save") == 0) {
+            o->save = val;
+        } else if (strcmp(opt, "--file") == 0) {
+            o->file = val;
+        } else {
+            fprintf(stderr, "lat_decode: unknown option '%s'\n", opt);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* ns with a unit that keeps 3-4 significant digits */
+static const char *fmt_ns(uint64_t ns, char *buf, size_t len)
+{
+    if (ns < 10000u) {
+        snprintf(buf, len, "%llu ns", (unsigned long long)ns);
+    } else if (ns < 10000000u) {
+        snprintf(buf, len, "%.1f us", (double)ns / 1e3);
+    } else if (ns < 10000000000ull) {
+        snprintf(buf, len, "%.1f ms", (double)ns / 1e6);
+    } else {
+        snprintf(buf, len, "%.2f s", (double)ns / 1e9);
+    }
+    return buf;
+}
+
+static void print_hist(const histogram_t *h, int buckets)
+{
+    avb_lat_summary_t s;
+    char b[7][32];
+    uint32_t i;
+
+    avb_lat_summarize(h->counts, &s);
+    if (h->hist == HIST_IOCTL) {
+        printf("%-11s 0x%08X", s_names[HIST_IOCTL], h->code);
+    } else if (h->hist == HIST_TX_RES) {
+        printf("%-17s pcp %u", s_names[HIST_TX_RES], h->code);
+    } else {
+        printf("%-22s", s_names[h->hist]);
+    }
+    if (s.count == 0) {
+        printf("  no samples\n");
+        return;
+    }
+    printf("  n=%-10llu min %-9s mean %-9s p50 %-9s p90 %-9s p99 %-9s p99.9 %-9s max %s\n",
+           (unsigned long long)s.count,
+           fmt_ns(s.min_ns, b[0], sizeof(b[0])), fmt_ns(s.mean_ns, b[1], sizeof(b[1])),
+           fmt_ns(s.p50_ns, b[2], sizeof(b[2])), fmt_ns(s.p90_ns, b[3], sizeof(b[3])),
+           fmt_ns(s.p99_ns, b[4], sizeof(b[4])), fmt_ns(s.p999_ns, b[5], sizeof(b[5])),
+           fmt_ns(s.max_ns, b[6], sizeof(b[6])));
+    if (!buckets) {
+        return;
+    }
+    for (i = 0; i < AVB_LAT_BUCKETS; i++) {
+        if (h->counts[i] != 0) {
+            printf("    [%s, %s)  %llu\n",
+                   fmt_ns(avb_lat_bucket_low(i), b[0], sizeof(b[0])),
+                   fmt_ns(avb_lat_bucket_high(i), b[1], sizeof(b[1])),
+                   (unsigned long long)h->counts[i]);
+        }
+    }
+}
+
+static int selected(const options_t *o, uint32_t hist, uint32_t code)
+{
+    if (o->hist >= 0 && (uint32_t)o->hist != hist) {
+        return 0;
+    }
+    if (hist == HIST_TX_RES) {
+        return o->pcp < 0 || (uint32_t)o->pcp == code;
+    }
+    return hist != HIST_IOCTL || o->code == 0 || o->code == code;
+}
+
+/* -------------------------------------------------------------------------
+ * Saved file
+ * ------------------------------------------------------------------------- */
+static int decode_file(const options_t *o)
+{
+    static histogram_t h;
+    char line[MAX_LINE], name[32];
+    unsigned int version = 0, sub_bits = 0, nbuckets = 0, code;
+    unsigned long long total, count;
+    unsigned int idx;
+    int in_hist = 0, shown = 0;
+    uint32_t k;
+    FILE *f = fopen(o->file, "r");
+
+    if (f == NULL) {
+        fprintf(stderr, "lat_decode: cannot open %s\n", o->file);
+        return 1;
+    }
+    if (fgets(line, sizeof(line), f) == NULL ||
+        sscanf(line, "# lat_decode %u sub_bits %u buckets %u", &version, &sub_bits, &nbuckets) != 3 ||
+        version != FILE_VERSION || sub_bits != AVB_LAT_SUB_BITS || nbuckets != AVB_LAT_BUCKETS) {
+        fprintf(stderr, "lat_decode: %s: not a version %u file with %u buckets\n", o->file,
+                FILE_VERSION, AVB_LAT_BUCKETS);
+        fclose(f);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (!in_hist && sscanf(line, "hist %31s %x %llu", name, &code, &total) == 3) {
+            memset(&h, 0, sizeof(h));
+            h.hist = HIST_TX_RES + 1u;
+            for (k = 0; k <= HIST_TX_RES; k++) {
+                if (strcmp(name, s_names[k]) == 0) {
+                    h.hist = k;
+                }
+            }
+            h.code  = code;
+            in_hist = h.hist <= HIST_TX_RES;
+        } else if (in_hist && strncmp(line, "end", 3) == 0) {
+            if (selected(o, h.hist, h.code)) {
+                print_hist(&h, o->buckets);
+                shown++;
+            }
+            in_hist = 0;
+        } else if (in_hist && sscanf(line, "%u %llu", &idx, &count) == 2 && idx < AVB_LAT_BUCKETS) {
+            h.counts[idx] = count;
+        }
+    }
+    fclose(f);
+    if (shown == 0) {
+        printf("no matching histograms in %s\n", o->file);
+    }
+    return 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Live (Windows)
+ * ------------------------------------------------------------------------- */
+#ifdef _WIN32
+static void save_hist(FILE *f, const histogram_t *h)
+{
+    uint64_t total = 0;
+    uint32_t i;
+
+    for (i = 0; i < AVB_LAT_BUCKETS; i++) {
+        total += h->counts[i];
+    }
+    fprintf(f, "hist %s 0x%08X %llu\n", s_names[h->hist], h->code, (unsigned long long)total);
+    for (i = 0; i < AVB_LAT_BUCKETS; i++) {
+        if (h->counts[i] != 0) {
+            fprintf(f, "%u %llu\n", i, (unsigned long long)h->counts[i]);
+        }
+    }
+    fprintf(f, "end\n");
+}
+
+static int query(HANDLE dev, uint32_t hist, uint32_t code, int reset, AVB_LAT_HIST_REQUEST *req)
+{
+    DWORD bytes = 0;
+
+    memset(req, 0, sizeof(*req));
+    req->hist       = hist;
+    req->ioctl_code = code;
+    req->flags      = reset ? AVB_LAT_HIST_FLAG_RESET : 0u;
+    if (!DeviceIoControl(dev, IOCTL_AVB_GET_LAT_HIST, req, sizeof(*req), req, sizeof(*req), &bytes, NULL) ||
+        bytes < sizeof(*req)) {
+        fprintf(stderr, "lat_decode: IOCTL_AVB_GET_LAT_HIST failed (error %lu)\n", GetLastError());
+        return -1;
+    }
+    if (req->bucket_count != AVB_LAT_BUCKETS || req->sub_bucket_bits != AVB_LAT_SUB_BITS) {
+        fprintf(stderr, "lat_decode: driver reports %u buckets / %u sub-bucket bits, expected %u / %u\n",
+                req->bucket_count, req->sub_bucket_bits, AVB_LAT_BUCKETS, AVB_LAT_SUB_BITS);
+        return -1;
+    }
+    return 0;
+}
+
+static void emit(const options_t *o, FILE *save, const AVB_LAT_HIST_REQUEST *req, uint32_t hist, uint32_t code)
+{
+    static histogram_t h;
+
+    h.hist = hist;
+    h.code = code;
+    memcpy(h.counts, req->counts, sizeof(h.counts));
+    print_hist(&h, o->buckets);
+    if (save != NULL) {
+        save_hist(save, &h);
+    }
+}
+
+static int decode_live(const options_t *o)
+{
+    static AVB_LAT_HIST_REQUEST req;
+    uint32_t codes[AVB_LAT_HIST_MAX_IOCTLS], ncodes, hist, i;
+    FILE *save = NULL;
+    int rc = 0;
+    HANDLE dev = CreateFileA("\\\\.\\IntelAvbFilter", GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (dev == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "lat_decode: cannot open \\\\.\\IntelAvbFilter (error %lu)\n", GetLastError());
+        return 1;
+    }
+    if (o->save != NULL) {
+        save = fopen(o->save, "w");
+        if (save == NULL) {
+            fprintf(stderr, "lat_decode: cannot create %s\n", o->save);
+            CloseHandle(dev);
+            return 1;
+        }
+        fprintf(save, "# lat_decode %u sub_bits %u buckets %u\n", FILE_VERSION, AVB_LAT_SUB_BITS, AVB_LAT_BUCKETS);
+    }
+
+    for (hist = 0; hist < HIST_IOCTL && rc == 0; hist++) {
+        if (!selected(o, hist, 0)) {
+            continue;
+        }
+        rc = query(dev, hist, 0, o->reset, &req);
+        if (rc == 0) {
+            emit(o, save, &req, hist, 0);
+        }
+    }
+
+    /* The reply lists the IOCTL codes that have a histogram */
+    if (rc == 0 && selected(o, HIST_IOCTL, o->code)) {
+        rc = query(dev, HIST_IOCTL, 0, 0, &req);
+        ncodes = (rc == 0 && req.ioctl_code_count <= AVB_LAT_HIST_MAX_IOCTLS) ? req.ioctl_code_count : 0;
+        memcpy(codes, req.ioctl_codes, sizeof(codes));
+        for (i = 0; i < ncodes && rc == 0; i++) {
+            if (!selected(o, HIST_IOCTL, codes[i])) {
+                continue;
+            }
+            rc = query(dev, HIST_IOCTL, codes[i], o->reset, &req);
+            if (rc == 0) {
+                emit(o, save, &req, HIST_IOCTL, codes[i]);
+            }
+        }
+    }
+
+    /* One histogram per priority; those without samples only when asked for */
+    for (i = 0; i < TX_RES_CLASSES && rc == 0; i++) {
+        if (!selected(o, HIST_TX_RES, i)) {
+            continue;
+        }
+        rc = query(dev, HIST_TX_RES, i, o->reset, &req);
+        if (rc == 0 && (req.total != 0 || o->pcp >= 0)) {
+            emit(o, save, &req, HIST_TX_RES, i);
+        }
+    }
+
+    if (save != NULL) {
+        fclose(save);
+    }
+    CloseHandle(dev);
+    return rc == 0 ? 0 : 1;
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    options_t o;
+
+    if (parse_args(argc, argv, &o) != 0) {
+        usage();
+        return 2;
+    }
+    if (o.file != NULL) {
+        return decode_file(&o);
+    }
+#ifdef _WIN32
+    return decode_live(&o);
+#else
+    fprintf(stderr, "lat_decode: live mode needs the Windows driver; use --file with a saved copy\n");
+    return 2;
+#endif
+}
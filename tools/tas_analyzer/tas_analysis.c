@@ -0,0 +1,369 @@
+/*++
+
+Module Name:
+
+    tas_analysis.c
+
+Abstract:
+
+    802.1Qbv schedule analysis - implementation.  See tas_analysis.h for the
+    arbitration model.  Pure C99; compiled together with src/tas_gcl.c.
+
+--*/
+
+#include "tas_analysis.h"
+#include "../../devices/intel_cbs.h"
+
+/* A stretch of the cycle in which a queue's gate is open and no
+ * higher-priority unshaped queue competes; may run across the cycle end */
+typedef struct _tas_run {
+    uint64_t start_ns;
+    uint32_t length_ns;
+    uint32_t guard_ns;          /* end of the run too close to the gate closing for a frame */
+    uint32_t last_entry;
+    uint32_t blocking_ns;       /* largest lower-priority frame open in the run */
+    uint32_t interference_ns;   /* higher-priority CBS burst open in the run */
+    uint64_t shaped_bps;        /* higher-priority CBS rate open in the run */
+} tas_run_t;
+
+typedef struct _tas_ctx {
+    const avb_tas_schedule_t *s;
+    const avb_tas_qos_t *qos;
+    uint32_t frame_ns[AVB_TAS_MAX_QUEUES];
+    uint32_t hi_credit[AVB_TAS_MAX_QUEUES];
+} tas_ctx_t;
+
+static int has_traffic(const tas_ctx_t *c, uint32_t q)
+{
+    return c->qos->frame_bytes[q] != 0;
+}
+
+static int shaped(const tas_ctx_t *c, uint32_t q)
+{
+    return has_traffic(c, q) && c->qos->idle_slope_Bps[q] != 0;
+}
+
+static void ctx_init(tas_ctx_t *c, const avb_tas_schedule_t *s, const avb_tas_qos_t *qos)
+{
+    uint32_t q, h, l;
+
+    c->s = s;
+    c->qos = qos;
+    for (q = 0; q < AVB_TAS_MAX_QUEUES; q++) {
+        c->frame_ns[q]  = (q < s->queues) ? avb_tas_frame_ns(qos->frame_bytes[q], qos->link_bps) : 0;
+        c->hi_credit[q] = 0;
+    }
+
+    /* Annex L: interference is the largest lower-priority frame; the classes
+     * above a queue count as one Class A with their summed idleSlope */
+    for (q = 0; q < s->queues; q++) {
+        uint32_t max_interference = 0, max_frame_above = 0;
+        uint64_t slope_above = 0, slope = (uint64_t)qos->idle_slope_Bps[q] * 8u;
+
+        if (!shaped(c, q)) {
+            continue;
+        }
+        if (qos->hi_credit_bytes[q] != 0) {
+            c->hi_credit[q] = qos->hi_credit_bytes[q];
+            continue;
+        }
+        for (l = q + 1u; l < s->queues; l++) {
+            if (qos->frame_bytes[l] > max_interference) {
+                max_interference = qos->frame_bytes[l];
+            }
+        }
+        for (h = 0; h < q; h++) {
+            if (shaped(c, h)) {
+                slope_above += (uint64_t)qos->idle_slope_Bps[h] * 8u;
+                if (qos->frame_bytes[h] > max_frame_above) {
+                    max_frame_above = qos->frame_bytes[h];
+                }
+            }
+        }
+        c->hi_credit[q] = (slope_above == 0)
+            ? intel_cbs_annexl_hicredit_a(max_interference, slope, qos->link_bps)
+            : intel_cbs_annexl_hicredit_b(max_interference, max_frame_above, slope_above, slope, qos->link_bps);
+    }
+}
+
+static int gate_open(const avb_tas_schedule_t *s, uint32_t e, uint32_t q)
+{
+    return (s->entries[e].gates >> q) & 1u;
+}
+
+/* Open and not blocked by a higher-priority unshaped queue */
+static int eligible(const tas_ctx_t *c, uint32_t e, uint32_t q, int *blocked)
+{
+    uint32_t h;
+
+    *blocked = 0;
+    if (!gate_open(c->s, e, q)) {
+        return 0;
+    }
+    for (h = 0; h < q; h++) {
+        if (has_traffic(c, h) && !shaped(c, h) && gate_open(c->s, e, h)) {
+            *blocked = 1;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void fold_entry(const tas_ctx_t *c, uint32_t e, uint32_t q, tas_run_t *run)
+{
+    uint64_t bps = 0;
+    uint32_t h, l, burst = 0;
+
+    for (l = q + 1u; l < c->s->queues; l++) {
+        if (has_traffic(c, l) && gate_open(c->s, e, l) && c->frame_ns[l] > run->blocking_ns) {
+            run->blocking_ns = c->frame_ns[l];
+        }
+    }
+    for (h = 0; h < q; h++) {
+        if (shaped(c, h) && gate_open(c->s, e, h)) {
+            bps   += (uint64_t)c->qos->idle_slope_Bps[h] * 8u;
+            burst += avb_tas_frame_ns(c->hi_credit[h] + c->qos->frame_bytes[h], c->qos->link_bps);
+        }
+    }
+    if (bps > run->shaped_bps) {
+        run->shaped_bps = bps;
+    }
+    if (burst > run->interference_ns) {
+        run->interference_ns = burst;
+    }
+}
+
+static void merge_runs(tas_run_t *into, const tas_run_t *from)
+{
+    into->length_ns += from->length_ns;
+    if (from->blocking_ns > into->blocking_ns) {
+        into->blocking_ns = from->blocking_ns;
+    }
+    if (from->interference_ns > into->interference_ns) {
+        into->interference_ns = from->interference_ns;
+    }
+    if (from->shaped_bps > into->shaped_bps) {
+        into->shaped_bps = from->shaped_bps;
+    }
+}
+
+/* Gate time left after entry e until queue q's gate closes, 0xFFFFFFFF if it never does */
+static uint32_t gate_left(const avb_tas_schedule_t *s, uint32_t e, uint32_t q)
+{
+    uint64_t left = 0;
+    uint32_t k;
+
+    for (k = 1; k < s->count; k++) {
+        uint32_t j = (e + k) % s->count;
+        if (!gate_open(s, j, q)) {
+            return (uint32_t)left;
+        }
+        left += s->entries[j].interval_ns;
+    }
+    return 0xFFFFFFFFu;
+}
+
+/* Runs of queue q in cycle order; a run across the cycle end is reported last */
+static uint32_t build_runs(const tas_ctx_t *c, uint32_t q, tas_run_t *runs, uint32_t *blocked_ns)
+{
+    const avb_tas_schedule_t *s = c->s;
+    uint32_t e, n = 0, k;
+    uint64_t t = 0;
+    int prev = 0, blocked;
+
+    *blocked_ns = 0;
+    for (e = 0; e < s->count; e++) {
+        int el = eligible(c, e, q, &blocked);
+
+        if (blocked) {
+            *blocked_ns += s->entries[e].interval_ns;
+        }
+        if (el && !prev) {
+            tas_run_t *r = &runs[n++];
+            r->start_ns = t;
+            r->length_ns = r->guard_ns = r->blocking_ns = r->interference_ns = 0;
+            r->shaped_bps = 0;
+        }
+        if (el) {
+            runs[n - 1u].length_ns += s->entries[e].interval_ns;
+            runs[n - 1u].last_entry = e;
+            fold_entry(c, e, q, &runs[n - 1u]);
+        }
+        prev = el;
+        t += s->entries[e].interval_ns;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    /* Open at both ends of the cycle: one run across the boundary */
+    if (n > 1 && prev && runs[0].start_ns == 0) {
+        merge_runs(&runs[n - 1u], &runs[0]);
+        runs[n - 1u].last_entry = runs[0].last_entry;
+        for (k = 1; k < n; k++) {
+            runs[k - 1u] = runs[k];
+        }
+        n--;
+    }
+
+    /* A frame must end before the gate closes, which may be after the run
+     * ends if a higher-priority queue takes over in between */
+    for (k = 0; k < n; k++) {
+        uint32_t left = gate_left(s, runs[k].last_entry, q);
+        uint32_t need = c->frame_ns[q];
+
+        if (left == 0xFFFFFFFFu || need <= left) {
+            continue;
+        }
+        need -= left;
+        runs[k].guard_ns = (runs[k].length_ns < need) ? runs[k].length_ns : need;
+    }
+    return n;
+}
+
+/* Time left in run r for the latest frame arrival that is still served in it, or -1 if none is */
+static int64_t run_slack(const tas_run_t *r)
+{
+    if (r->guard_ns == r->length_ns) {
+        return -1;
+    }
+    return (int64_t)r->length_ns - r->guard_ns - r->blocking_ns - r->interference_ns;
+}
+
+void avb_tas_analyze(const avb_tas_schedule_t *s, const avb_tas_qos_t *qos, avb_tas_report_t *r)
+{
+    tas_ctx_t c;
+    tas_run_t runs[AVB_TAS_MAX_ENTRIES + 1u];
+    uint32_t q, k, n;
+
+    ctx_init(&c, s, qos);
+    r->cycle_ns = s->cycle_ns;
+    r->queues = s->queues;
+
+    for (q = 0; q < AVB_TAS_MAX_QUEUES; q++) {
+        avb_tas_queue_report_t *qr = &r->q[q];
+        uint64_t service_ns = 0, worst = 0;
+        int served = 0;
+
+        qr->open_ns = qr->blocked_ns = qr->guard_band_ns = qr->usable_ns = qr->windows = 0;
+        qr->hi_credit_bytes = c.hi_credit[q];
+        qr->guaranteed_bps = 0;
+        qr->worst_delay_ns = AVB_TAS_DELAY_UNBOUNDED;
+        if (q >= s->queues) {
+            continue;
+        }
+        qr->open_ns = s->open_ns[q];
+        n = build_runs(&c, q, runs, &qr->blocked_ns);
+        qr->windows = n;
+
+        for (k = 0; k < n; k++) {
+            const tas_run_t *run = &runs[k];
+            uint64_t avail;
+
+            qr->guard_band_ns += run->guard_ns;
+            qr->usable_ns += run->length_ns - run->guard_ns;
+
+            /* Backlogged: one lower frame at the start, higher CBS queues take their rate */
+            avail = run->length_ns - run->guard_ns;
+            avail = (avail > run->blocking_ns) ? avail - run->blocking_ns : 0;
+            if (run->shaped_bps >= qos->link_bps) {
+                avail = 0;
+            } else if (run->shaped_bps != 0) {
+                avail = avail * (qos->link_bps - run->shaped_bps) / qos->link_bps;
+            }
+            service_ns += avail;
+        }
+        if (s->cycle_ns != 0) {
+            qr->guaranteed_bps = service_ns * qos->link_bps / s->cycle_ns;
+        }
+        if (shaped(&c, q) && qr->guaranteed_bps > (uint64_t)qos->idle_slope_Bps[q] * 8u) {
+            qr->guaranteed_bps = (uint64_t)qos->idle_slope_Bps[q] * 8u;
+        }
+
+        /* Worst case: the frame arrives just too late for one serving run
+         * and goes out in the next run that has room for it */
+        if (n == 1 && runs[0].length_ns == s->cycle_ns && runs[0].guard_ns == 0 &&
+            run_slack(&runs[0]) >= 0) {
+            qr->worst_delay_ns = (uint64_t)runs[0].blocking_ns + runs[0].interference_ns + c.frame_ns[q];
+            continue;
+        }
+        for (k = 0; k < n; k++) {
+            int64_t slack = run_slack(&runs[k]);
+            uint64_t missed, wait;
+            uint32_t j, next = k;
+
+            if (slack < 0) {
+                continue;
+            }
+            served = 1;
+            missed = runs[k].start_ns + (uint64_t)slack;
+            for (j = 1; j <= n; j++) {
+                next = (k + j) % n;
+                if (run_slack(&runs[next]) >= 0) {
+                    break;
+                }
+            }
+            wait = (runs[next].start_ns + s->cycle_ns - missed % s->cycle_ns) % s->cycle_ns;
+            if (next == k && wait == 0) {
+                wait = s->cycle_ns;
+            }
+            wait += (uint64_t)runs[next].blocking_ns + runs[next].interference_ns + c.frame_ns[q];
+            if (wait > worst) {
+                worst = wait;
+            }
+        }
+        if (served) {
+            qr->worst_delay_ns = worst;
+        }
+    }
+}
+
+void avb_tas_timeline(const avb_tas_schedule_t *s, const avb_tas_qos_t *qos, uint32_t q,
+                      char *buf, uint32_t width)
+{
+    tas_ctx_t c;
+    tas_run_t runs[AVB_TAS_MAX_ENTRIES + 1u];
+    uint32_t col, n = 0, blocked_ns, k;
+
+    if (width == 0) {
+        return;
+    }
+    ctx_init(&c, s, qos);
+    if (q < s->queues) {
+        n = build_runs(&c, q, runs, &blocked_ns);
+    }
+
+    for (col = 0; col < width; col++) {
+        /* Sample the middle of each column */
+        uint64_t t = ((uint64_t)2u * col + 1u) * s->cycle_ns / (2u * (uint64_t)width);
+        uint64_t end = 0;
+        uint32_t e = 0;
+        char ch = '.';
+        int blocked = 0;
+
+        if (q >= s->queues || s->count == 0) {
+            buf[col] = ' ';
+            continue;
+        }
+        while (e + 1u < s->count && t >= end + s->entries[e].interval_ns) {
+            end += s->entries[e].interval_ns;
+            e++;
+        }
+        if (eligible(&c, e, q, &blocked)) {
+            ch = '#';
+            for (k = 0; k < n; k++) {
+                uint64_t off = (t + s->cycle_ns - runs[k].start_ns % s->cycle_ns) % s->cycle_ns;
+                if (off < runs[k].length_ns) {
+                    if (off >= (uint64_t)runs[k].length_ns - runs[k].guard_ns) {
+                        ch = 'g';
+                    }
+                    break;
+                }
+            }
+        } else if (blocked) {
+            ch = '-';
+        }
+        buf[col] = ch;
+    }
+    buf[width] = '\0';
+}
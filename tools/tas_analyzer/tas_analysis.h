@@ -0,0 +1,90 @@
+/*++
+
+Module Name:
+
+    tas_analysis.h
+
+Abstract:
+
+    Offline worst-case analysis of a compiled 802.1Qbv schedule
+    (src/tas_gcl.h) for the traffic each queue carries: guaranteed bandwidth,
+    worst-case queuing delay and guard-band loss per queue, plus an ASCII
+    timeline.  Used by tas_analyze and its tests; not part of the driver.
+
+    Model (I210/I225/I226 transmit arbitration):
+
+      - queue 0 has the highest priority; among open gates the lowest
+        queue with a frame ready sends first
+      - a queue with traffic and no CBS may take the whole link while its
+        gate is open, so lower queues open at the same time are "blocked"
+      - a CBS-shaped queue takes at most idleSlope of the link and can burst
+        at most hiCredit + one frame ahead of a lower queue
+      - transmission is not preempted: a lower-priority frame that already
+        started delays the queue by up to one frame
+      - a frame only starts if it ends before its gate closes, so the last
+        frame time of every window that closes is guard band (lost to that
+        queue); a window shorter than a frame cannot be used at all
+      - gate state carries over the cycle boundary (a queue open at the end
+        and at the start of the cycle has one window)
+
+    The figures are analytic bounds under this model, computed in
+    O(entries x queues) with no allocation, so a design search can evaluate
+    thousands of candidate schedules per second.
+
+    Implements: REQ-F-TAS-002 (TAS schedule compilation and validation)
+
+--*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "../../src/tas_gcl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVB_TAS_DELAY_UNBOUNDED     0xFFFFFFFFFFFFFFFFull
+
+/** Traffic and shaping per queue */
+typedef struct _avb_tas_qos {
+    uint64_t link_bps;                                  /* <= 18 Gb/s */
+    uint32_t frame_bytes[AVB_TAS_MAX_QUEUES];           /* largest frame on the wire, 0 = no traffic */
+    uint32_t idle_slope_Bps[AVB_TAS_MAX_QUEUES];        /* CBS idleSlope, 0 = not shaped */
+    uint32_t hi_credit_bytes[AVB_TAS_MAX_QUEUES];       /* 0 = 802.1Q Annex L bound */
+} avb_tas_qos_t;
+
+typedef struct _avb_tas_queue_report {
+    uint32_t open_ns;           /* gate open per cycle */
+    uint32_t blocked_ns;        /* open while a higher-priority unshaped queue is open */
+    uint32_t guard_band_ns;     /* open and unblocked but too close to gate close to start a frame */
+    uint32_t usable_ns;         /* time a frame of this queue may start */
+    uint32_t windows;           /* service windows per cycle */
+    uint32_t hi_credit_bytes;   /* hiCredit used for the interference of this queue */
+    uint64_t guaranteed_bps;    /* lower bound on the rate a backlogged queue gets */
+    uint64_t worst_delay_ns;    /* enqueue to end of transmission for one frame, or AVB_TAS_DELAY_UNBOUNDED */
+} avb_tas_queue_report_t;
+
+typedef struct _avb_tas_report {
+    uint32_t cycle_ns;
+    uint32_t queues;
+    avb_tas_queue_report_t q[AVB_TAS_MAX_QUEUES];
+} avb_tas_report_t;
+
+/** Analyze every queue of a schedule compiled by avb_tas_compile */
+void avb_tas_analyze(const avb_tas_schedule_t *s, const avb_tas_qos_t *qos, avb_tas_report_t *r);
+
+/**
+ * One timeline row for queue q: width characters sampled across the cycle
+ * plus a terminating NUL (buf holds width + 1 bytes).
+ *
+ *   '#'  a frame may start     'g'  guard band
+ *   '-'  blocked by a higher-priority queue     '.'  gate closed
+ */
+void avb_tas_timeline(const avb_tas_schedule_t *s, const avb_tas_qos_t *qos, uint32_t q,
+                      char *buf, uint32_t width);
+
+#ifdef __cplusplus
+}
+#endif